@@ -0,0 +1,405 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for fulltext index lists
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2015 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2015, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/test/unit_test.hpp>
+
+#include "FulltextIndex/fulltext-list.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief term frequency used for an entry
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t Frequency (TRI_fulltext_list_entry_t entry) {
+  return entry % 7 + 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the list of an index node from entries
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_fulltext_list_t* CreateNodeList (vector<TRI_fulltext_list_entry_t> const& entries) {
+  TRI_fulltext_list_t* list = TRI_CreateNodeListFulltextIndex(0);
+
+  for (auto const& entry : entries) {
+    list = TRI_InsertListFulltextIndex(list, entry, Frequency(entry));
+    BOOST_REQUIRE(list != nullptr);
+  }
+
+  return list;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an uncompressed list from entries, like the lists built by
+/// queries. clones of node lists are never packed
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_fulltext_list_t* CreateList (vector<TRI_fulltext_list_entry_t> const& entries) {
+  TRI_fulltext_list_t* node = CreateNodeList(entries);
+  TRI_fulltext_list_t* list = TRI_CloneListFulltextIndex(node);
+  TRI_FreeListFulltextIndex(node);
+
+  BOOST_REQUIRE(list != nullptr);
+
+  return list;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the entries of a list in ascending order
+////////////////////////////////////////////////////////////////////////////////
+
+static vector<TRI_fulltext_list_entry_t> Contents (TRI_fulltext_list_t const* list) {
+  TRI_fulltext_list_t* copy = TRI_CloneListFulltextIndex(list);
+  BOOST_REQUIRE(copy != nullptr);
+
+  TRI_fulltext_list_entry_t const* start = TRI_StartListFulltextIndex(copy);
+  vector<TRI_fulltext_list_entry_t> result(start, start + TRI_NumEntriesListFulltextIndex(copy));
+  TRI_FreeListFulltextIndex(copy);
+
+  sort(result.begin(), result.end());
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the entries from 1 to n for which the predicate is true
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+static vector<TRI_fulltext_list_entry_t> Range (TRI_fulltext_list_entry_t n,
+                                                T const& predicate) {
+  vector<TRI_fulltext_list_entry_t> result;
+
+  for (TRI_fulltext_list_entry_t i = 1; i <= n; ++i) {
+    if (predicate(i)) {
+      result.push_back(i);
+    }
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check that a node list contains exactly the given entries, and
+/// that its iterator finds them and nothing else up to n
+////////////////////////////////////////////////////////////////////////////////
+
+static void CheckNodeList (TRI_fulltext_list_t const* list,
+                           vector<TRI_fulltext_list_entry_t> const& expected,
+                           TRI_fulltext_list_entry_t n) {
+  BOOST_CHECK_EQUAL(expected.size(), TRI_NumEntriesListFulltextIndex(list));
+
+  vector<TRI_fulltext_list_entry_t> actual = Contents(list);
+  BOOST_CHECK(expected == actual);
+
+  TRI_fulltext_list_iterator_t iterator;
+  TRI_InitIteratorListFulltextIndex(&iterator, list);
+
+  size_t pos = 0;
+  for (TRI_fulltext_list_entry_t i = 1; i <= n; ++i) {
+    uint32_t frequency = 0;
+    bool const found = TRI_SeekIteratorListFulltextIndex(&iterator, i, &frequency);
+    bool const contained = (pos < expected.size() && expected[pos] == i);
+
+    BOOST_CHECK_EQUAL(contained, found);
+
+    if (contained) {
+      ++pos;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 setup / tear-down
+// -----------------------------------------------------------------------------
+
+struct CFulltextListSetup {
+  CFulltextListSetup () {
+    BOOST_TEST_MESSAGE("setup fulltext list");
+  }
+
+  ~CFulltextListSetup () {
+    BOOST_TEST_MESSAGE("tear-down fulltext list");
+  }
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief setup
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE(CFulltextListTest, CFulltextListSetup)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test lists around the size at which they are packed
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_packed_boundary) {
+  uint32_t const sizes[] = { 1, 127, 128, 129, 255, 256, 257, 1000, 5000 };
+
+  for (auto const& n : sizes) {
+    auto entries = Range(n, [] (TRI_fulltext_list_entry_t) { return true; });
+    TRI_fulltext_list_t* list = CreateNodeList(entries);
+
+    CheckNodeList(list, entries, n + 10);
+
+    // frequencies are kept for packed and uncompressed entries
+    TRI_fulltext_list_iterator_t iterator;
+    TRI_InitIteratorListFulltextIndex(&iterator, list);
+
+    for (auto const& entry : entries) {
+      uint32_t frequency = 0;
+      BOOST_CHECK(TRI_SeekIteratorListFulltextIndex(&iterator, entry, &frequency));
+      BOOST_CHECK_EQUAL(Frequency(entry), frequency);
+    }
+
+    // inserting the last value again does not add it
+    list = TRI_InsertListFulltextIndex(list, n, 1);
+    BOOST_CHECK_EQUAL(n, TRI_NumEntriesListFulltextIndex(list));
+
+    TRI_FreeListFulltextIndex(list);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that packed lists are smaller than uncompressed ones
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_packed_memory) {
+  uint32_t const n = 10000;
+
+  auto entries = Range(n, [] (TRI_fulltext_list_entry_t) { return true; });
+  TRI_fulltext_list_t* list = CreateNodeList(entries);
+
+  BOOST_CHECK(TRI_MemoryListFulltextIndex(list) < n * (sizeof(TRI_fulltext_list_entry_t) + sizeof(uint8_t)));
+
+  TRI_FreeListFulltextIndex(list);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test inserting into packed lists out of order, with duplicates
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_packed_unordered) {
+  uint32_t const n = 1000;
+  vector<TRI_fulltext_list_entry_t> entries;
+
+  // a permutation of 1 .. n, as 7919 is a prime
+  for (uint32_t i = 0; i < n; ++i) {
+    entries.push_back((i * 7919) % n + 1);
+  }
+
+  TRI_fulltext_list_t* list = CreateNodeList(entries);
+
+  CheckNodeList(list, Range(n, [] (TRI_fulltext_list_entry_t) { return true; }), n + 10);
+
+  // duplicates of packed values are only removed when the tail is packed,
+  // which the ascending inserts below will do
+  for (TRI_fulltext_list_entry_t i = 1; i <= n; i += 97) {
+    list = TRI_InsertListFulltextIndex(list, i, Frequency(i));
+    BOOST_REQUIRE(list != nullptr);
+  }
+
+  // ascending inserts after unordered ones
+  for (TRI_fulltext_list_entry_t i = n + 1; i <= 2 * n; ++i) {
+    list = TRI_InsertListFulltextIndex(list, i, Frequency(i));
+    BOOST_REQUIRE(list != nullptr);
+  }
+
+  CheckNodeList(list, Range(2 * n, [] (TRI_fulltext_list_entry_t) { return true; }), 2 * n + 10);
+
+  TRI_FreeListFulltextIndex(list);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test compaction of packed lists
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_packed_compaction) {
+  uint32_t const n = 1000;
+
+  auto entries = Range(n, [] (TRI_fulltext_list_entry_t) { return true; });
+  TRI_fulltext_list_t* list = CreateNodeList(entries);
+
+  // delete every third value and all values of the second block, and
+  // renumber the remaining ones like the handle compaction does
+  vector<TRI_fulltext_list_entry_t> map(n + 1, 0);
+  vector<TRI_fulltext_list_entry_t> expected;
+  vector<uint32_t> frequencies;
+
+  auto deleted = [] (TRI_fulltext_list_entry_t i) {
+    return (i % 3 == 0 || (i > TRI_FULLTEXT_LIST_BLOCK_SIZE && i <= 2 * TRI_FULLTEXT_LIST_BLOCK_SIZE));
+  };
+
+  TRI_fulltext_list_entry_t next = 0;
+  for (TRI_fulltext_list_entry_t i = 1; i <= n; ++i) {
+    if (! deleted(i)) {
+      map[i] = ++next;
+      expected.push_back(next);
+      frequencies.push_back(Frequency(i));
+    }
+  }
+
+  uint32_t remain = TRI_RewriteListFulltextIndex(list, map.data());
+
+  BOOST_CHECK_EQUAL(expected.size(), remain);
+  CheckNodeList(list, expected, n + 10);
+
+  // frequencies move with their values
+  TRI_fulltext_list_iterator_t iterator;
+  TRI_InitIteratorListFulltextIndex(&iterator, list);
+
+  for (size_t i = 0; i < expected.size(); ++i) {
+    uint32_t frequency = 0;
+    BOOST_CHECK(TRI_SeekIteratorListFulltextIndex(&iterator, expected[i], &frequency));
+    BOOST_CHECK_EQUAL(frequencies[i], frequency);
+  }
+
+  // the list can still grow after the compaction
+  for (TRI_fulltext_list_entry_t i = next + 1; i <= next + 500; ++i) {
+    list = TRI_InsertListFulltextIndex(list, i, Frequency(i));
+    BOOST_REQUIRE(list != nullptr);
+    expected.push_back(i);
+  }
+
+  CheckNodeList(list, expected, next + 510);
+
+  // delete everything
+  vector<TRI_fulltext_list_entry_t> empty(next + 501, 0);
+  BOOST_CHECK_EQUAL(0, TRI_RewriteListFulltextIndex(list, empty.data()));
+  BOOST_CHECK_EQUAL(0, TRI_NumEntriesListFulltextIndex(list));
+
+  TRI_FreeListFulltextIndex(list);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test intersecting packed with uncompressed lists
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_packed_intersect) {
+  uint32_t const n = 2000;
+
+  auto even = Range(n, [] (TRI_fulltext_list_entry_t i) { return i % 2 == 0; });
+  auto fives = Range(n + 100, [] (TRI_fulltext_list_entry_t i) { return i % 5 == 0; });
+  auto tens = Range(n, [] (TRI_fulltext_list_entry_t i) { return i % 10 == 0; });
+
+  // a query list against the list of an index node
+  TRI_fulltext_list_t* node = CreateNodeList(even);
+  TRI_fulltext_list_t* result = TRI_IntersectNodeListFulltextIndex(CreateList(fives), node);
+
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK(tens == Contents(result));
+  TRI_FreeListFulltextIndex(result);
+
+  // a short query list only hits some of the blocks
+  vector<TRI_fulltext_list_entry_t> few = { 3, 4, 1000, 1001, 1998, 2000, 2002 };
+  result = TRI_IntersectNodeListFulltextIndex(CreateList(few), node);
+
+  BOOST_REQUIRE(result != nullptr);
+  vector<TRI_fulltext_list_entry_t> expected = { 4, 1000, 1998, 2000 };
+  BOOST_CHECK(expected == Contents(result));
+  TRI_FreeListFulltextIndex(result);
+
+  // the node's list is left untouched
+  CheckNodeList(node, even, n + 10);
+
+  // both lists are consumed, in both argument orders
+  result = TRI_IntersectListFulltextIndex(CreateNodeList(even), CreateList(fives));
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK(tens == Contents(result));
+  TRI_FreeListFulltextIndex(result);
+
+  result = TRI_IntersectListFulltextIndex(CreateList(fives), CreateNodeList(even));
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK(tens == Contents(result));
+  TRI_FreeListFulltextIndex(result);
+
+  // two packed lists
+  result = TRI_IntersectListFulltextIndex(CreateNodeList(even), CreateNodeList(fives));
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK(tens == Contents(result));
+  TRI_FreeListFulltextIndex(result);
+
+  TRI_FreeListFulltextIndex(node);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test unionising packed with uncompressed lists
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_packed_union) {
+  uint32_t const n = 2000;
+
+  auto even = Range(n, [] (TRI_fulltext_list_entry_t i) { return i % 2 == 0; });
+  auto fives = Range(n + 100, [] (TRI_fulltext_list_entry_t i) { return i % 5 == 0; });
+  auto expected = Range(n + 100, [] (TRI_fulltext_list_entry_t i) { return (i % 2 == 0 && i <= 2000) || i % 5 == 0; });
+
+  TRI_fulltext_list_t* result = TRI_UnioniseListFulltextIndex(CreateNodeList(even), CreateList(fives));
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK(expected == Contents(result));
+  TRI_FreeListFulltextIndex(result);
+
+  result = TRI_UnioniseListFulltextIndex(CreateList(fives), CreateNodeList(even));
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK(expected == Contents(result));
+  TRI_FreeListFulltextIndex(result);
+
+  // the clone of a packed list, as used by the index for prefix queries
+  TRI_fulltext_list_t* node = CreateNodeList(even);
+  result = TRI_UnioniseListFulltextIndex(TRI_CloneListFulltextIndex(node), CreateList(fives));
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK(expected == Contents(result));
+  TRI_FreeListFulltextIndex(result);
+  TRI_FreeListFulltextIndex(node);
+
+  // a packed list with nothing
+  result = TRI_UnioniseListFulltextIndex(CreateNodeList(even), nullptr);
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK(even == Contents(result));
+  TRI_FreeListFulltextIndex(result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generate tests
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
@@ -423,6 +423,101 @@ BOOST_AUTO_TEST_CASE (tst_crc32_utf8) {
   BOOST_CHECK_EQUAL((uint64_t) 2590070434ULL,   TRI_FinalCrc32(TRI_BlockCrc32(TRI_InitialCrc32(), buffer.c_str(), strlen(buffer.c_str()))));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes a CRC32C using the given block function
+////////////////////////////////////////////////////////////////////////////////
+
+typedef uint32_t (*crc32c_block_t) (uint32_t, char const*, size_t);
+
+static uint32_t Crc32c (crc32c_block_t block, char const* data, size_t length) {
+  return TRI_FinalCrc32(block(TRI_InitialCrc32(), data, length));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks a CRC32C block function against known values
+////////////////////////////////////////////////////////////////////////////////
+
+static void CheckCrc32c (crc32c_block_t block) {
+  std::string buffer;
+
+  buffer = "";
+  BOOST_CHECK_EQUAL((uint64_t) 0ULL, Crc32c(block, buffer.c_str(), buffer.size()));
+
+  buffer = " ";
+  BOOST_CHECK_EQUAL((uint64_t) 1925242255ULL, Crc32c(block, buffer.c_str(), buffer.size()));
+
+  buffer = "a";
+  BOOST_CHECK_EQUAL((uint64_t) 3251651376ULL, Crc32c(block, buffer.c_str(), buffer.size()));
+
+  buffer = "123456789";
+  BOOST_CHECK_EQUAL((uint64_t) 3808858755ULL, Crc32c(block, buffer.c_str(), buffer.size()));
+
+  buffer = "The quick brown fox jumps over the lazy dog";
+  BOOST_CHECK_EQUAL((uint64_t) 576848900ULL, Crc32c(block, buffer.c_str(), buffer.size()));
+
+  // test vectors from RFC 3720
+  char data[32];
+
+  memset(data, 0, sizeof(data));
+  BOOST_CHECK_EQUAL((uint64_t) 0x8A9136AAULL, Crc32c(block, data, sizeof(data)));
+
+  memset(data, 0xFF, sizeof(data));
+  BOOST_CHECK_EQUAL((uint64_t) 0x62A8AB43ULL, Crc32c(block, data, sizeof(data)));
+
+  for (int i = 0; i < 32; ++i) {
+    data[i] = (char) i;
+  }
+  BOOST_CHECK_EQUAL((uint64_t) 0x46DD794EULL, Crc32c(block, data, sizeof(data)));
+
+  // checksums of split and unaligned blocks must be the same
+  for (size_t i = 0; i <= sizeof(data); ++i) {
+    uint32_t crc = TRI_InitialCrc32();
+    crc = block(crc, data, i);
+    crc = block(crc, data + i, sizeof(data) - i);
+
+    BOOST_CHECK_EQUAL((uint64_t) 0x46DD794EULL, TRI_FinalCrc32(crc));
+  }
+
+  char unaligned[sizeof(data) + 8];
+
+  for (size_t i = 1; i < 8; ++i) {
+    memcpy(unaligned + i, data, sizeof(data));
+    BOOST_CHECK_EQUAL((uint64_t) 0x46DD794EULL, Crc32c(block, unaligned + i, sizeof(data)));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test crc32c
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_crc32c) {
+  CheckCrc32c(TRI_BlockCrc32c);
+
+  std::string buffer = "123456789";
+  BOOST_CHECK_EQUAL((uint64_t) 3808858755ULL, TRI_Crc32cHashPointer(buffer.c_str(), buffer.size()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test crc32c software version, which TRI_BlockCrc32c does not use
+/// on CPUs with SSE4.2
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_crc32c_software) {
+  CheckCrc32c(TRI_BlockCrc32cSoftware);
+
+  // larger blocks must give the same values as TRI_BlockCrc32c
+  std::string buffer;
+
+  for (int i = 0; i < 4099; ++i) {
+    buffer.push_back((char) (i * 31 + 7));
+  }
+
+  for (size_t i = 0; i < 16; ++i) {
+    BOOST_CHECK_EQUAL(Crc32c(TRI_BlockCrc32c, buffer.c_str() + i, buffer.size() - i),
+                      Crc32c(TRI_BlockCrc32cSoftware, buffer.c_str() + i, buffer.size() - i));
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
 ////////////////////////////////////////////////////////////////////////////////
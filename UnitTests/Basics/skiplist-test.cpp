@@ -439,6 +439,161 @@ BOOST_AUTO_TEST_CASE (tst_unique_remove_all) {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test bulk loading
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_unique_bulk_load) {
+  triagens::basics::SkipList skiplist(CmpElmElm, CmpKeyElm, nullptr, FreeElm, true);
+
+  std::vector<int*> values; 
+  std::vector<void*> docs; 
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(new int(i * 2));
+    docs.push_back(values[i]);
+  }
+
+  BOOST_CHECK_EQUAL(TRI_ERROR_NO_ERROR, skiplist.bulkLoad(docs));
+  BOOST_CHECK_EQUAL(1000, skiplist.getNrUsed());
+
+  // loading into a non-empty skiplist is not allowed
+  BOOST_CHECK_EQUAL(TRI_ERROR_BAD_PARAMETER, skiplist.bulkLoad(docs));
+  BOOST_CHECK_EQUAL(1000, skiplist.getNrUsed());
+
+  // do a forward iteration
+  triagens::basics::SkipListNode* current = skiplist.startNode()->nextNode();
+  for (int i = 0; i < 1000; ++i) {
+    BOOST_CHECK_EQUAL((void*) values[i], current->document());
+    if (i > 0) {
+      BOOST_CHECK_EQUAL(values[i - 1], current->prevNode()->document());
+    }
+    current = current->nextNode();
+  }
+  BOOST_CHECK_EQUAL((void*) 0, current);
+  BOOST_CHECK_EQUAL(values[999], skiplist.prevNode(nullptr)->document());
+
+  // lookups use the upper levels
+  for (int i = 0; i < 1000; ++i) {
+    BOOST_CHECK_EQUAL(values[i], skiplist.lookup(values[i])->document());
+  }
+
+  // inserts and removals work as usual
+  int* odd = new int(7);
+  BOOST_CHECK_EQUAL(TRI_ERROR_NO_ERROR, skiplist.insert(odd));
+  BOOST_CHECK_EQUAL(values[4], skiplist.lookup(odd)->nextNode()->document());
+  BOOST_CHECK_EQUAL(TRI_ERROR_NO_ERROR, skiplist.remove(odd));
+
+  for (int i = 0; i < 1000; i += 2) {
+    BOOST_CHECK_EQUAL(TRI_ERROR_NO_ERROR, skiplist.remove(values[i]));
+  }
+  BOOST_CHECK_EQUAL(500, skiplist.getNrUsed());
+  for (int i = 1; i < 1000; i += 2) {
+    BOOST_CHECK_EQUAL(values[i], skiplist.lookup(values[i])->document());
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    BOOST_CHECK_EQUAL((void*) 0, skiplist.lookup(values[i]));
+  }
+  
+  // clean up
+  for (auto i : values) {
+    delete i;
+  }
+  delete odd;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test bulk loading invalid input
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_unique_bulk_load_invalid) {
+  triagens::basics::SkipList skiplist(CmpElmElm, CmpKeyElm, nullptr, FreeElm, true);
+
+  int a = 1, b = 2, c = 2;
+
+  // unsorted
+  std::vector<void*> docs = { &b, &a };
+  BOOST_CHECK_EQUAL(TRI_ERROR_BAD_PARAMETER, skiplist.bulkLoad(docs));
+  BOOST_CHECK_EQUAL(0, skiplist.getNrUsed());
+
+  // duplicate
+  docs = { &a, &b, &c };
+  BOOST_CHECK_EQUAL(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED, skiplist.bulkLoad(docs));
+  BOOST_CHECK_EQUAL(0, skiplist.getNrUsed());
+  BOOST_CHECK_EQUAL((void*) 0, skiplist.startNode()->nextNode());
+
+  // empty
+  docs.clear();
+  BOOST_CHECK_EQUAL(TRI_ERROR_NO_ERROR, skiplist.bulkLoad(docs));
+  BOOST_CHECK_EQUAL(0, skiplist.getNrUsed());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test partitioning a range
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_unique_partition) {
+  triagens::basics::SkipList skiplist(CmpElmElm, CmpKeyElm, nullptr, FreeElm, true);
+
+  std::vector<int*> values; 
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(new int(i));
+  }
+  
+  for (int i = 0; i < 1000; ++i) {
+    skiplist.insert(values[i]);
+  }
+
+  int lower = 100;
+  int upper = 899;
+
+  auto left = skiplist.leftKeyLookup(&lower);
+  auto right = skiplist.rightKeyLookup(&upper);
+
+  for (size_t n = 1; n <= 16; ++n) {
+    auto bounds = skiplist.partition(left, right, n);
+
+    BOOST_CHECK(bounds.size() >= 2);
+    BOOST_CHECK(bounds.size() <= n + 1);
+    BOOST_CHECK_EQUAL(left, bounds.front());
+    BOOST_CHECK_EQUAL(right, bounds.back());
+
+    // the sub-ranges must cover the range exactly once
+    int expected = lower;
+    for (size_t j = 0; j + 1 < bounds.size(); ++j) {
+      auto current = bounds[j];
+      int count = 0;
+      do {
+        current = current->nextNode();
+        BOOST_CHECK_EQUAL(expected, *static_cast<int*>(current->document()));
+        ++expected;
+        ++count;
+      }
+      while (current != bounds[j + 1]);
+      BOOST_CHECK(count > 0);
+    }
+    BOOST_CHECK_EQUAL(upper + 1, expected);
+  }
+
+  // the whole list
+  auto bounds = skiplist.partition(skiplist.startNode(), skiplist.prevNode(nullptr), 4);
+  BOOST_CHECK_EQUAL(5, bounds.size());
+
+  // more partitions than nodes
+  bounds = skiplist.partition(skiplist.startNode(), skiplist.startNode()->nextNode()->nextNode(), 10);
+  BOOST_CHECK_EQUAL(3, bounds.size());
+
+  // empty range
+  bounds = skiplist.partition(right, left, 4);
+  BOOST_CHECK_EQUAL(2, bounds.size());
+  BOOST_CHECK_EQUAL(right, bounds[0]);
+  BOOST_CHECK_EQUAL(right, bounds[1]);
+  
+  // clean up
+  for (auto i : values) {
+    delete i;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
 ////////////////////////////////////////////////////////////////////////////////
@@ -472,6 +472,52 @@ describe ArangoDB do
         doc.parsed_response['hasMore'].should eq(false)
         doc.parsed_response['result'].length.should eq(10)
       end
+      
+      it "returns a large result that fits into one batch directly" do
+        cmd = api
+        body = "{ \"query\" : \"FOR i IN 1..5000 RETURN { value: i, text: CONCAT('test', i, '#{'x' * 100}') }\", \"count\" : true, \"batchSize\" : 5000 }"
+        doc = ArangoDB.log_post("#{prefix}-streamed", cmd, :body => body)
+        
+        doc.code.should eq(201)
+        doc.headers['content-type'].should eq("application/json; charset=utf-8")
+        doc.headers['transfer-encoding'].should be_nil
+        doc.headers['content-length'].should_not be_nil
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['code'].should eq(201)
+        doc.parsed_response['id'].should be_nil
+        doc.parsed_response['hasMore'].should eq(false)
+        doc.parsed_response['count'].should eq(5000)
+        doc.parsed_response['result'].length.should eq(5000)
+        doc.parsed_response['result'][4999]['value'].should eq(5000)
+      end
+      
+      it "creates a cursor with streamed batches, multiple runs" do
+        cmd = api
+        body = "{ \"query\" : \"FOR i IN 1..8000 RETURN { value: i, text: CONCAT('test', i, '#{'x' * 100}') }\", \"count\" : true, \"batchSize\" : 5000 }"
+        doc = ArangoDB.log_post("#{prefix}-streamed-multiple", cmd, :body => body)
+        
+        doc.code.should eq(201)
+        doc.headers['transfer-encoding'].should eq("chunked")
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['id'].should be_kind_of(String)
+        doc.parsed_response['hasMore'].should eq(true)
+        doc.parsed_response['count'].should eq(8000)
+        doc.parsed_response['result'].length.should eq(5000)
+
+        id = doc.parsed_response['id']
+
+        cmd = api + "/#{id}"
+        doc = ArangoDB.log_put("#{prefix}-streamed-multiple", cmd)
+        
+        doc.code.should eq(200)
+        doc.headers['transfer-encoding'].should eq("chunked")
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['id'].should be_nil
+        doc.parsed_response['hasMore'].should eq(false)
+        doc.parsed_response['count'].should eq(8000)
+        doc.parsed_response['result'].length.should eq(3000)
+        doc.parsed_response['result'][0]['value'].should eq(5001)
+      end
     end
 
 ################################################################################
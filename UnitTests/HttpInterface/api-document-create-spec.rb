@@ -120,6 +120,42 @@ describe ArangoDB do
 
         ArangoDB.drop_collection(cn)
       end
+      
+      it "returns an error if the JSON body contains a duplicate attribute name" do
+        cn = "UnitTestsCollectionBasics"
+        id = ArangoDB.create_collection(cn)
+
+        cmd = "/_api/document?collection=#{id}"
+        body = "{ \"foo\" : { \"bar\" : 1, \"bar\" : 2 } }"
+        doc = ArangoDB.log_post("#{prefix}-bad-json", cmd, :body => body)
+
+        doc.code.should eq(400)
+        doc.parsed_response['error'].should eq(true)
+        doc.parsed_response['errorNum'].should eq(600)
+        doc.parsed_response['code'].should eq(400)
+
+        ArangoDB.size_collection(cn).should eq(0)
+
+        ArangoDB.drop_collection(cn)
+      end
+      
+      it "returns an error if the _key attribute is not a string" do
+        cn = "UnitTestsCollectionBasics"
+        id = ArangoDB.create_collection(cn)
+
+        cmd = "/_api/document?collection=#{id}"
+        body = "{ \"_key\" : 12, \"foo\" : 1 }"
+        doc = ArangoDB.log_post("#{prefix}-bad-key", cmd, :body => body)
+
+        doc.code.should eq(400)
+        doc.parsed_response['error'].should eq(true)
+        doc.parsed_response['errorNum'].should eq(1221)
+        doc.parsed_response['code'].should eq(400)
+
+        ArangoDB.size_collection(cn).should eq(0)
+
+        ArangoDB.drop_collection(cn)
+      end
     end
 
 ################################################################################
@@ -466,6 +502,25 @@ describe ArangoDB do
         ArangoDB.size_collection(@cn).should eq(0)
       end
 
+      it "creating a document with nested and escaped values" do
+        cmd = "/_api/document?collection=#{@cn}"
+        body = "{ \"_key\" : \"nested\", \"a\" : { \"b\" : [ 1, \"two\", null, true, [ ], { } ] }, \"s\" : \"x\\\"y\\\\z\\u00e4\", \"n\" : -1.5e3, \"_rev\" : \"ignored\" }"
+        doc = ArangoDB.log_post("#{prefix}-nested", cmd, :body => body)
+
+        doc.code.should eq(201)
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['_key'].should eq("nested")
+
+        doc = ArangoDB.get("/_api/document/#{@cn}/nested")
+        doc.code.should eq(200)
+        doc.parsed_response['a'].should eq({ "b" => [ 1, "two", nil, true, [ ], { } ] })
+        doc.parsed_response['s'].should eq("x\"y\\z\u00e4")
+        doc.parsed_response['n'].should eq(-1500)
+        doc.parsed_response['_rev'].should_not eq("ignored")
+
+        ArangoDB.delete("/_api/document/#{@cn}/nested")
+      end
+
       it "creating a document with an existing id" do
         @key = "a_new_key"
 
@@ -0,0 +1,150 @@
+# coding: utf-8
+
+require 'rspec'
+require 'arangodb.rb'
+
+describe ArangoDB do
+  api = "/_api/import"
+  prefix = "api-import"
+
+  context "importing documents:" do
+
+################################################################################
+## import into a sharded collection
+################################################################################
+
+    context "import into a sharded collection:" do
+      before do
+        @cn = "UnitTestsImport"
+        ArangoDB.drop_collection(@cn)
+
+        body = "{ \"name\" : \"#{@cn}\", \"numberOfShards\" : 8 }"
+        doc = ArangoDB.post("/_api/collection", :body => body)
+        doc.code.should eq(200)
+        @cid = doc.parsed_response['id']
+      end
+
+      after do
+        ArangoDB.drop_collection(@cn)
+      end
+
+      it "using a JSON array" do
+        cmd = api + "?collection=#{@cn}&type=array"
+        body = "[ "
+        (0..99).each do |i|
+          body += ", " if i > 0
+          body += "{ \"_key\" : \"test#{i}\", \"value\" : #{i} }"
+        end
+        body += " ]"
+        doc = ArangoDB.log_post("#{prefix}-cluster-array", cmd, :body => body)
+
+        doc.code.should eq(201)
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['created'].should eq(100)
+        doc.parsed_response['errors'].should eq(0)
+        doc.parsed_response['empty'].should eq(0)
+
+        doc = ArangoDB.get("/_api/collection/#{@cn}/count")
+        doc.code.should eq(200)
+        doc.parsed_response['count'].should eq(100)
+
+        doc = ArangoDB.get("/_api/document/#{@cn}/test42")
+        doc.code.should eq(200)
+        doc.parsed_response['value'].should eq(42)
+      end
+
+      it "using individual documents, without keys" do
+        cmd = api + "?collection=#{@cn}&type=documents"
+        body = ""
+        (0..99).each do |i|
+          body += "{ \"value\" : #{i} }\n"
+        end
+        doc = ArangoDB.log_post("#{prefix}-cluster-documents", cmd, :body => body)
+
+        doc.code.should eq(201)
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['created'].should eq(100)
+        doc.parsed_response['errors'].should eq(0)
+
+        doc = ArangoDB.get("/_api/collection/#{@cn}/count")
+        doc.code.should eq(200)
+        doc.parsed_response['count'].should eq(100)
+      end
+
+      it "using key/value lists" do
+        cmd = api + "?collection=#{@cn}"
+        body = "[ \"_key\", \"value\" ]\n"
+        (0..49).each do |i|
+          body += "[ \"test#{i}\", #{i} ]\n"
+        end
+        doc = ArangoDB.log_post("#{prefix}-cluster-lists", cmd, :body => body)
+
+        doc.code.should eq(201)
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['created'].should eq(50)
+        doc.parsed_response['errors'].should eq(0)
+      end
+
+      it "reports errors in input order" do
+        cmd = api + "?collection=#{@cn}&type=documents&details=true"
+        body = "{ \"_key\" : \"test1\" }\n"
+        body += "{ \"_key\" : \"test2\" }\n"
+        body += "[ ]\n"
+        body += "{ \"_key\" : \"test1\" }\n"
+        body += "{ \"_key\" : \"test3\" }\n"
+        body += "{ \"_key\" : \"test2\" }\n"
+        doc = ArangoDB.log_post("#{prefix}-cluster-errors", cmd, :body => body)
+
+        doc.code.should eq(201)
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['created'].should eq(3)
+        doc.parsed_response['errors'].should eq(3)
+        details = doc.parsed_response['details']
+        details.length.should eq(3)
+        details[0].should match(/^at position 3: /)
+        details[1].should match(/^at position 4: .*unique constraint/)
+        details[2].should match(/^at position 6: .*unique constraint/)
+      end
+
+      it "using onDuplicate=update" do
+        cmd = api + "?collection=#{@cn}&type=documents"
+        body = "{ \"_key\" : \"test1\", \"value\" : 1 }\n"
+        doc = ArangoDB.log_post("#{prefix}-cluster-update", cmd, :body => body)
+        doc.code.should eq(201)
+
+        cmd = api + "?collection=#{@cn}&type=documents&onDuplicate=update"
+        body = "{ \"_key\" : \"test1\", \"other\" : 2 }\n"
+        body += "{ \"_key\" : \"test2\", \"other\" : 3 }\n"
+        doc = ArangoDB.log_post("#{prefix}-cluster-update", cmd, :body => body)
+
+        doc.code.should eq(201)
+        doc.parsed_response['created'].should eq(1)
+        doc.parsed_response['updated'].should eq(1)
+        doc.parsed_response['errors'].should eq(0)
+
+        doc = ArangoDB.get("/_api/document/#{@cn}/test1")
+        doc.code.should eq(200)
+        doc.parsed_response['value'].should eq(1)
+        doc.parsed_response['other'].should eq(2)
+      end
+
+      it "using overwrite=true" do
+        cmd = api + "?collection=#{@cn}&type=documents"
+        body = "{ \"_key\" : \"test1\" }\n{ \"_key\" : \"test2\" }\n"
+        doc = ArangoDB.log_post("#{prefix}-cluster-overwrite", cmd, :body => body)
+        doc.code.should eq(201)
+
+        cmd = api + "?collection=#{@cn}&type=documents&overwrite=true"
+        body = "{ \"_key\" : \"test1\" }\n"
+        doc = ArangoDB.log_post("#{prefix}-cluster-overwrite", cmd, :body => body)
+        doc.code.should eq(201)
+        doc.parsed_response['created'].should eq(1)
+
+        doc = ArangoDB.get("/_api/collection/#{@cn}/count")
+        doc.code.should eq(200)
+        doc.parsed_response['count'].should eq(1)
+      end
+    end
+
+  end
+end
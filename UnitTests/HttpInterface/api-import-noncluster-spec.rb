@@ -1,6 +1,8 @@
 # coding: utf-8
 
 require 'rspec'
+require 'stringio'
+require 'zlib'
 require 'arangodb.rb'
 
 describe ArangoDB do
@@ -248,6 +250,37 @@ describe ArangoDB do
         doc.parsed_response['ignored'].should eq(0)
       end
       
+      it "invalid documents, error details" do
+        cmd = api + "?collection=#{@cn}&type=documents&details=true"
+        body =  "{ \"value\" : 1 }\n"
+        body += "{ \"invalid1\" : 1, \"invalid2\" : }\n"
+        body += "[ 1, 2, 3 ]\n"
+        body += "{ \"invalid3\" : 1, \"_key\" : 1 }\n"
+        body += "{ \"invalid4\" : 1, \"_key\" : \"\" }\n"
+        body += "{ \"invalid5\" : { \"invalid6\" : 1 } } garbage\n"
+        body += "{ \"value\" : 2, \"value\" : 3 }\n"
+        doc = ArangoDB.log_post("#{prefix}-self-contained-invalid-details", cmd, :body => body)
+
+        doc.code.should eq(201)
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['created'].should eq(2)
+        doc.parsed_response['errors'].should eq(5)
+        details = doc.parsed_response['details']
+        details.length.should eq(5)
+        details[0].should match(/^at position 2: invalid JSON type \(expecting object, probably parse error\)/)
+        details[1].should match(/^at position 3: invalid JSON type \(expecting object\), offending document: \[ 1, 2, 3 \]/)
+        details[2].should match(/^at position 4: creating document failed with error 'illegal document key'/)
+        details[3].should match(/^at position 5: creating document failed with error 'illegal document key'/)
+        details[4].should match(/^at position 6: invalid JSON type \(expecting object, probably parse error\)/)
+
+        # the invalid lines must not have created any attributes
+        ArangoDB.put("/_admin/wal/flush?waitForSync=true&waitForCollector=true", { })
+
+        doc = ArangoDB.get("/_api/collection/#{@cn}/figures")
+        doc.code.should eq(200)
+        doc.parsed_response['figures']['attributes']['count'].should eq(1)
+      end
+      
       it "empty body" do
         cmd = api + "?collection=#{@cn}&createCollection=true&type=documents"
         body =  "" 
@@ -329,6 +362,66 @@ describe ArangoDB do
       end
     end
 
+################################################################################
+## import with a compressed body
+################################################################################
+
+    context "import with a compressed body:" do
+      before do
+        @cn = "UnitTestsImport"
+        ArangoDB.drop_collection(@cn)
+        @cid = ArangoDB.create_collection(@cn, false)
+        @body = ""
+        (0..99).each do |i|
+          @body += "{ \"_key\" : \"test#{i}\", \"value\" : #{i} }\n"
+        end
+      end
+
+      after do
+        ArangoDB.drop_collection(@cn)
+      end
+
+      it "using deflate" do
+        cmd = api + "?collection=#{@cn}&type=documents"
+        body = Zlib::Deflate.deflate(@body)
+        doc = ArangoDB.post(cmd, :body => body, :headers => { "Content-Encoding" => "deflate" })
+
+        doc.code.should eq(201)
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['created'].should eq(100)
+        doc.parsed_response['errors'].should eq(0)
+
+        doc = ArangoDB.get("/_api/document/#{@cn}/test42")
+        doc.code.should eq(200)
+        doc.parsed_response['value'].should eq(42)
+      end
+
+      it "using gzip" do
+        cmd = api + "?collection=#{@cn}&type=documents"
+        io = StringIO.new
+        gz = Zlib::GzipWriter.new(io)
+        gz.write(@body)
+        gz.close
+        doc = ArangoDB.post(cmd, :body => io.string, :headers => { "Content-Encoding" => "gzip" })
+
+        doc.code.should eq(201)
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['created'].should eq(100)
+        doc.parsed_response['errors'].should eq(0)
+      end
+
+      it "using a corrupt body" do
+        cmd = api + "?collection=#{@cn}&type=documents"
+        doc = ArangoDB.post(cmd, :body => "this is not compressed", :headers => { "Content-Encoding" => "gzip" })
+
+        doc.code.should eq(400)
+        doc.parsed_response['error'].should eq(true)
+        doc.parsed_response['errorNum'].should eq(400)
+
+        ArangoDB.size_collection(@cn).should eq(0)
+      end
+    end
+
 ################################################################################
 ## import attribute names and data
 ################################################################################
@@ -157,6 +157,52 @@ describe ArangoDB, :ssl => true do
         response = read_socket @socket
         response.scan(/HTTP\/1\.1 20[012]/).length.should eq(n * 2)
       end
+
+      it "checks post requests with large bodies" do
+        n = 5
+        value = "x" * 200000
+
+        requests = ""
+        (0...n).each do |i|
+          body = "{ \"_key\" : \"test#{i}\", \"value\" : \"#{value}\" }"
+          requests << "POST /_api/document?collection=#{@cn} HTTP/1.1\r\nContent-Length: "
+          requests << body.length.to_s
+          requests << "\r\n\r\n"
+          requests << body
+        end
+
+        @socket.send requests, 0
+
+        response = read_socket @socket
+        response.scan(/HTTP\/1\.1 20[12]/).length.should eq(n)
+
+        (0...n).each do |i|
+          doc = ArangoDB.get("/_api/document/#{@cn}/test#{i}")
+          doc.code.should eq(200)
+          doc.parsed_response['value'].should eq(value)
+        end
+      end
+
+      it "checks a post request with a large body followed by other requests" do
+        n = 10
+        value = "x" * 200000
+        body = "{ \"_key\" : \"test\", \"value\" : \"#{value}\" }"
+
+        requests = "POST /_api/document?collection=#{@cn} HTTP/1.1\r\nContent-Length: "
+        requests << body.length.to_s
+        requests << "\r\n\r\n"
+        requests << body
+
+        (0...n).each do |i|
+          requests << "GET /_api/document/#{@cn}/test HTTP/1.1\r\n\r\n"
+        end
+
+        @socket.send requests, 0
+
+        response = read_socket @socket
+        response.scan(/HTTP\/1\.1 20[12]/).length.should eq(n + 1)
+        response.scan(value).length.should eq(n)
+      end
       
     end
 
@@ -57,6 +57,78 @@ describe ArangoDB do
       doc.parsed_response['errorNum'].should eq(404)
     end
 
+  end
+
+################################################################################
+## dispatcher queue lanes
+################################################################################
+
+  context "dispatcher queue lanes:" do
+    before do
+      @cn = "UnitTestsStatistics"
+      ArangoDB.drop_collection(@cn)
+      ArangoDB.create_collection(@cn)
+    end
+
+    after do
+      ArangoDB.drop_collection(@cn)
+    end
+
+    def lanes
+      doc = ArangoDB.get("/_admin/statistics")
+      doc.code.should eq(200)
+      doc.parsed_response['client']['queueLanes']
+    end
+
+    # statistics are updated after the response was sent, so wait a bit
+    def wait_for_lane (name, count)
+      tries = 0
+      while tries < 50
+        current = lanes[name]['queueTime']['count']
+        return current if current > count
+        sleep 0.1
+        tries += 1
+      end
+      lanes[name]['queueTime']['count']
+    end
+
+    it "checks the lanes in the statistics" do
+      result = lanes
+      [ "high", "medium", "low" ].each do |name|
+        result[name]['depth'].should be >= 0
+        result[name]['queueTime']['count'].should be >= 0
+        result[name]['queueTime']['counts'].should be_kind_of(Array)
+      end
+    end
+
+    it "checks the lane of regular requests" do
+      before = lanes['medium']['queueTime']['count']
+
+      doc = ArangoDB.get("/_api/collection/#{@cn}/properties")
+      doc.code.should eq(200)
+
+      wait_for_lane('medium', before).should be > before
+    end
+
+    it "checks the lane of cluster-internal requests" do
+      before = lanes['high']['queueTime']['count']
+
+      doc = ArangoDB.get("/_api/collection/#{@cn}/properties", :headers => { "X-Arango-Coordinator" => "CoordinatorUnitTests" })
+      doc.code.should eq(200)
+
+      wait_for_lane('high', before).should be > before
+    end
+
+    it "checks the lane of imports" do
+      before = lanes['low']['queueTime']['count']
+      body = "{ \"value\" : 1 }\n{ \"value\" : 2 }\n"
+
+      doc = ArangoDB.post("/_api/import?collection=#{@cn}&type=documents", :body => body)
+      doc.code.should eq(201)
+      doc.parsed_response['created'].should eq(2)
+
+      wait_for_lane('low', before).should be > before
+    end
 
   end
 end
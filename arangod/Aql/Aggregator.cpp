@@ -0,0 +1,387 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, incremental aggregate functions for COLLECT ... AGGREGATE
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/Aggregator.h"
+#include "Basics/Exceptions.h"
+
+using namespace triagens::aql;
+using Json = triagens::basics::Json;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract the numeric value of an AqlValue for summing up
+/// returns false if the value is not a number
+////////////////////////////////////////////////////////////////////////////////
+
+static inline bool ExtractNumber (AqlValue const& value,
+                                  double& number) {
+  if (! value.isNumber()) {
+    return false;
+  }
+
+  if (value._type == AqlValue::INLINE_NUMBER) {
+    number = value._number;
+  }
+  else {
+    number = value._json->json()->_value._number;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue holding a number, or null if the number is
+/// not finite
+////////////////////////////////////////////////////////////////////////////////
+
+static inline AqlValue NumberValue (double number) {
+  if (std::isnan(number) || ! std::isfinite(number)) {
+    return AqlValue::CreateNull();
+  }
+  return AqlValue::CreateNumber(number);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue holding null
+////////////////////////////////////////////////////////////////////////////////
+
+static inline AqlValue NullValue () {
+  return AqlValue::CreateNull();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  class Aggregator
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an aggregator for the aggregate function name
+////////////////////////////////////////////////////////////////////////////////
+
+Aggregator* Aggregator::fromTypeString (triagens::arango::AqlTransaction* trx,
+                                        std::string const& type) {
+  if (type == "LENGTH" || type == "COUNT") {
+    return new AggregatorLength(trx);
+  }
+  if (type == "MIN") {
+    return new AggregatorMin(trx);
+  }
+  if (type == "MAX") {
+    return new AggregatorMax(trx);
+  }
+  if (type == "SUM") {
+    return new AggregatorSum(trx, false);
+  }
+  if (type == "MERGE_SUM") {
+    return new AggregatorSum(trx, true);
+  }
+  if (type == "AVERAGE") {
+    return new AggregatorAverage(trx);
+  }
+  if (type == "VARIANCE_POPULATION") {
+    return new AggregatorVariance(trx, true, false);
+  }
+  if (type == "VARIANCE_SAMPLE") {
+    return new AggregatorVariance(trx, false, false);
+  }
+  if (type == "STDDEV_POPULATION") {
+    return new AggregatorVariance(trx, true, true);
+  }
+  if (type == "STDDEV_SAMPLE") {
+    return new AggregatorVariance(trx, false, true);
+  }
+
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid aggregator type");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not an aggregate function name is supported
+////////////////////////////////////////////////////////////////////////////////
+
+bool Aggregator::isSupported (std::string const& type) {
+  return (type == "LENGTH" ||
+          type == "COUNT" ||
+          type == "MIN" ||
+          type == "MAX" ||
+          type == "SUM" ||
+          type == "AVERAGE" ||
+          type == "VARIANCE_POPULATION" ||
+          type == "VARIANCE_SAMPLE" ||
+          type == "STDDEV_POPULATION" ||
+          type == "STDDEV_SAMPLE");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief name of the aggregate function that combines partial results
+////////////////////////////////////////////////////////////////////////////////
+
+std::string Aggregator::mergeType (std::string const& type) {
+  if (type == "LENGTH" || type == "COUNT") {
+    // partial counts are summed up
+    return "SUM";
+  }
+  if (type == "MIN" || type == "MAX") {
+    return type;
+  }
+  if (type == "SUM" || type == "MERGE_SUM") {
+    return "MERGE_SUM";
+  }
+
+  // AVERAGE, VARIANCE and STDDEV cannot be computed from their partial
+  // results
+  return "";
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                            class AggregatorLength
+// -----------------------------------------------------------------------------
+
+void AggregatorLength::reset () {
+  count = 0;
+}
+
+void AggregatorLength::reduce (AqlValue const&,
+                               TRI_document_collection_t const*) {
+  ++count;
+}
+
+AqlValue AggregatorLength::stealValue () {
+  uint64_t value = count;
+  reset();
+  return AqlValue::CreateNumber(static_cast<double>(value));
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                               class AggregatorMin
+// -----------------------------------------------------------------------------
+
+AggregatorMin::~AggregatorMin () {
+  value.destroy();
+}
+
+void AggregatorMin::reset () {
+  value.destroy();
+  collection = nullptr;
+}
+
+void AggregatorMin::reduce (AqlValue const& cmpValue,
+                            TRI_document_collection_t const* cmpColl) {
+  if (cmpValue.isNull(true)) {
+    // null values are ignored by MIN()
+    return;
+  }
+
+  if (value.isEmpty() ||
+      AqlValue::Compare(trx, cmpValue, cmpColl, value, collection, true) < 0) {
+    // the new value is the current minimum. store a copy of it that is
+    // independent of the input block
+    value.destroy();
+    value = AqlValue(new Json(cmpValue.toJson(trx, cmpColl, true)));
+    collection = nullptr;
+  }
+}
+
+AqlValue AggregatorMin::stealValue () {
+  if (value.isEmpty()) {
+    return NullValue();
+  }
+  AqlValue copy = value;
+  value.erase();
+  reset();
+  return copy;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                               class AggregatorMax
+// -----------------------------------------------------------------------------
+
+AggregatorMax::~AggregatorMax () {
+  value.destroy();
+}
+
+void AggregatorMax::reset () {
+  value.destroy();
+  collection = nullptr;
+}
+
+void AggregatorMax::reduce (AqlValue const& cmpValue,
+                            TRI_document_collection_t const* cmpColl) {
+  if (cmpValue.isNull(true)) {
+    // null values are ignored by MAX()
+    return;
+  }
+
+  if (value.isEmpty() ||
+      AqlValue::Compare(trx, cmpValue, cmpColl, value, collection, true) > 0) {
+    // the new value is the current maximum. store a copy of it that is
+    // independent of the input block
+    value.destroy();
+    value = AqlValue(new Json(cmpValue.toJson(trx, cmpColl, true)));
+    collection = nullptr;
+  }
+}
+
+AqlValue AggregatorMax::stealValue () {
+  if (value.isEmpty()) {
+    return NullValue();
+  }
+  AqlValue copy = value;
+  value.erase();
+  reset();
+  return copy;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                               class AggregatorSum
+// -----------------------------------------------------------------------------
+
+void AggregatorSum::reset () {
+  sum = 0.0;
+  invalid = false;
+}
+
+void AggregatorSum::reduce (AqlValue const& cmpValue,
+                            TRI_document_collection_t const*) {
+  if (invalid) {
+    return;
+  }
+
+  if (cmpValue.isNull(true)) {
+    if (merge) {
+      // a partial sum was invalid
+      invalid = true;
+    }
+    return;
+  }
+
+  double number;
+  if (! ExtractNumber(cmpValue, number)) {
+    invalid = true;
+    return;
+  }
+  sum += number;
+}
+
+AqlValue AggregatorSum::stealValue () {
+  AqlValue result = invalid ? NullValue() : NumberValue(sum);
+  reset();
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                           class AggregatorAverage
+// -----------------------------------------------------------------------------
+
+void AggregatorAverage::reset () {
+  count = 0;
+  sum = 0.0;
+  invalid = false;
+}
+
+void AggregatorAverage::reduce (AqlValue const& cmpValue,
+                                TRI_document_collection_t const*) {
+  if (invalid || cmpValue.isNull(true)) {
+    return;
+  }
+
+  double number;
+  if (! ExtractNumber(cmpValue, number)) {
+    invalid = true;
+    return;
+  }
+  sum += number;
+  ++count;
+}
+
+AqlValue AggregatorAverage::stealValue () {
+  AqlValue result = (invalid || count == 0) ? NullValue() : NumberValue(sum / static_cast<double>(count));
+  reset();
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                          class AggregatorVariance
+// -----------------------------------------------------------------------------
+
+char const* AggregatorVariance::name () const {
+  if (stddev) {
+    return population ? "STDDEV_POPULATION" : "STDDEV_SAMPLE";
+  }
+  return population ? "VARIANCE_POPULATION" : "VARIANCE_SAMPLE";
+}
+
+void AggregatorVariance::reset () {
+  count = 0;
+  mean = 0.0;
+  m2 = 0.0;
+  invalid = false;
+}
+
+void AggregatorVariance::reduce (AqlValue const& cmpValue,
+                                 TRI_document_collection_t const*) {
+  if (invalid || cmpValue.isNull(true)) {
+    return;
+  }
+
+  double number;
+  if (! ExtractNumber(cmpValue, number)) {
+    invalid = true;
+    return;
+  }
+
+  ++count;
+  double const delta = number - mean;
+  mean += delta / static_cast<double>(count);
+  m2 += delta * (number - mean);
+}
+
+AqlValue AggregatorVariance::stealValue () {
+  uint64_t const minCount = population ? 1 : 2;
+
+  AqlValue result;
+  if (invalid || count < minCount) {
+    result = NullValue();
+  }
+  else {
+    double variance = m2 / static_cast<double>(population ? count : count - 1);
+    if (stddev) {
+      variance = std::sqrt(variance);
+    }
+    result = NumberValue(variance);
+  }
+
+  reset();
+  return result;
+}
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
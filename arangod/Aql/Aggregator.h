@@ -0,0 +1,322 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, incremental aggregate functions for COLLECT ... AGGREGATE
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_AGGREGATOR_H
+#define ARANGODB_AQL_AGGREGATOR_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+
+namespace triagens {
+  namespace aql {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  class Aggregator
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief base class for incremental aggregate functions
+///
+/// an aggregator is fed with the values of one group one by one via reduce(),
+/// and produces the aggregate result for the group via stealValue(), which
+/// also resets it for the next group. this way COLLECT ... AGGREGATE never has
+/// to materialize the members of a group
+////////////////////////////////////////////////////////////////////////////////
+
+    struct Aggregator {
+
+      explicit Aggregator (triagens::arango::AqlTransaction* trx)
+        : trx(trx) {
+      }
+
+      virtual ~Aggregator () {
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief name of the aggregate function
+////////////////////////////////////////////////////////////////////////////////
+
+      virtual char const* name () const = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reset the aggregator for a new group
+////////////////////////////////////////////////////////////////////////////////
+
+      virtual void reset () = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief feed the next value of the current group into the aggregator
+////////////////////////////////////////////////////////////////////////////////
+
+      virtual void reduce (AqlValue const&,
+                           TRI_document_collection_t const*) = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the aggregate result of the current group, the caller
+/// takes ownership of the value. the aggregator is reset afterwards
+////////////////////////////////////////////////////////////////////////////////
+
+      virtual AqlValue stealValue () = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an aggregator for the aggregate function name. throws
+/// if the function is not supported
+////////////////////////////////////////////////////////////////////////////////
+
+      static Aggregator* fromTypeString (triagens::arango::AqlTransaction*,
+                                         std::string const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not an aggregate function name is supported
+////////////////////////////////////////////////////////////////////////////////
+
+      static bool isSupported (std::string const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief name of the aggregate function that combines partial results of
+/// an aggregate function computed on several servers into the final result.
+/// returns an empty string if partial results cannot be combined
+////////////////////////////////////////////////////////////////////////////////
+
+      static std::string mergeType (std::string const&);
+
+      triagens::arango::AqlTransaction* trx;
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a list of aggregators, one per aggregate expression
+////////////////////////////////////////////////////////////////////////////////
+
+    typedef std::vector<Aggregator*> AggregateValuesType;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                       class AggregatorLength
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief LENGTH() / COUNT(), counts the rows of a group
+////////////////////////////////////////////////////////////////////////////////
+
+    struct AggregatorLength final : public Aggregator {
+
+      explicit AggregatorLength (triagens::arango::AqlTransaction* trx)
+        : Aggregator(trx),
+          count(0) {
+      }
+
+      char const* name () const override final {
+        return "LENGTH";
+      }
+
+      void reset () override final;
+      void reduce (AqlValue const&,
+                   TRI_document_collection_t const*) override final;
+      AqlValue stealValue () override final;
+
+      uint64_t count;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                       class AggregatorMin
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief MIN(), smallest non-null value of a group
+////////////////////////////////////////////////////////////////////////////////
+
+    struct AggregatorMin final : public Aggregator {
+
+      explicit AggregatorMin (triagens::arango::AqlTransaction* trx)
+        : Aggregator(trx),
+          value(),
+          collection(nullptr) {
+      }
+
+      ~AggregatorMin ();
+
+      char const* name () const override final {
+        return "MIN";
+      }
+
+      void reset () override final;
+      void reduce (AqlValue const&,
+                   TRI_document_collection_t const*) override final;
+      AqlValue stealValue () override final;
+
+      AqlValue value;
+      TRI_document_collection_t const* collection;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                       class AggregatorMax
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief MAX(), greatest non-null value of a group
+////////////////////////////////////////////////////////////////////////////////
+
+    struct AggregatorMax final : public Aggregator {
+
+      explicit AggregatorMax (triagens::arango::AqlTransaction* trx)
+        : Aggregator(trx),
+          value(),
+          collection(nullptr) {
+      }
+
+      ~AggregatorMax ();
+
+      char const* name () const override final {
+        return "MAX";
+      }
+
+      void reset () override final;
+      void reduce (AqlValue const&,
+                   TRI_document_collection_t const*) override final;
+      AqlValue stealValue () override final;
+
+      AqlValue value;
+      TRI_document_collection_t const* collection;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                       class AggregatorSum
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief SUM(), sum of the non-null values of a group. the result is null
+/// if any value is not numeric
+///
+/// when summing up partial sums (MERGE_SUM), a null value stems from a
+/// partial sum that was invalid, and makes the result invalid as well
+////////////////////////////////////////////////////////////////////////////////
+
+    struct AggregatorSum final : public Aggregator {
+
+      AggregatorSum (triagens::arango::AqlTransaction* trx,
+                     bool merge)
+        : Aggregator(trx),
+          merge(merge),
+          sum(0.0),
+          invalid(false) {
+      }
+
+      char const* name () const override final {
+        return merge ? "MERGE_SUM" : "SUM";
+      }
+
+      void reset () override final;
+      void reduce (AqlValue const&,
+                   TRI_document_collection_t const*) override final;
+      AqlValue stealValue () override final;
+
+      bool const merge;
+      double sum;
+      bool invalid;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                       class AggregatorAverage
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AVERAGE(), average of the non-null values of a group. the result
+/// is null if any value is not numeric or there are no values
+////////////////////////////////////////////////////////////////////////////////
+
+    struct AggregatorAverage final : public Aggregator {
+
+      explicit AggregatorAverage (triagens::arango::AqlTransaction* trx)
+        : Aggregator(trx),
+          count(0),
+          sum(0.0),
+          invalid(false) {
+      }
+
+      char const* name () const override final {
+        return "AVERAGE";
+      }
+
+      void reset () override final;
+      void reduce (AqlValue const&,
+                   TRI_document_collection_t const*) override final;
+      AqlValue stealValue () override final;
+
+      uint64_t count;
+      double sum;
+      bool invalid;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                      class AggregatorVariance
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief VARIANCE_POPULATION(), VARIANCE_SAMPLE(), STDDEV_POPULATION() and
+/// STDDEV_SAMPLE(). the mean and the sum of squared differences are updated
+/// per value (Welford's method), so no values need to be kept
+////////////////////////////////////////////////////////////////////////////////
+
+    struct AggregatorVariance final : public Aggregator {
+
+      AggregatorVariance (triagens::arango::AqlTransaction* trx,
+                          bool population,
+                          bool stddev)
+        : Aggregator(trx),
+          population(population),
+          stddev(stddev),
+          count(0),
+          mean(0.0),
+          m2(0.0),
+          invalid(false) {
+      }
+
+      char const* name () const override final;
+
+      void reset () override final;
+      void reduce (AqlValue const&,
+                   TRI_document_collection_t const*) override final;
+      AqlValue stealValue () override final;
+
+      bool const population;
+      bool const stddev;
+      uint64_t count;
+      double mean;
+      double m2;
+      bool invalid;
+    };
+
+  }  // namespace triagens::aql
+}  // namespace triagens
+
+#endif
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
@@ -144,7 +144,8 @@ AqlItemBlock::AqlItemBlock (Json const& json) {
           else if (n == 1) {
             // a JSON value
             Json x(raw.at(static_cast<int>(posInRaw++)));
-            AqlValue a(new Json(TRI_UNKNOWN_MEM_ZONE, x.copy().steal()));
+            Json value(x.copy());
+            AqlValue a = AqlValue::CreateFromJson(value);
             try {
               setValue(i, column, a);  // if this throws, a is destroyed again
             }
@@ -36,6 +36,109 @@ using namespace triagens::aql;
 using Json = triagens::basics::Json;
 using JsonHelper = triagens::basics::JsonHelper;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue from a JSON value
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue AqlValue::CreateFromJson (Json& json) {
+  AqlValue value;
+
+  if (value.setInline(json.json())) {
+    return value;
+  }
+
+  return AqlValue(new Json(json));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue from a copy of a JSON value
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue AqlValue::CreateFromJson (TRI_json_t const* json) {
+  AqlValue value;
+
+  if (value.setInline(json)) {
+    return value;
+  }
+
+  std::unique_ptr<TRI_json_t> copy(TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, json));
+
+  if (copy == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  auto result = new Json(TRI_UNKNOWN_MEM_ZONE, copy.get());
+  copy.release();
+  return AqlValue(result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue from a string
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue AqlValue::CreateString (char const* data,
+                                 size_t length) {
+  if (length <= MaxInlineStringLength &&
+      memchr(data, '\0', length) == nullptr) {
+    AqlValue value;
+    memcpy(value._string, data, length);
+    value._string[length] = '\0';
+    value._type = INLINE_STRING;
+    return value;
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, data, length));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue from a shaped JSON value
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue AqlValue::CreateFromShapedJson (TRI_shaper_t* shaper,
+                                         TRI_shaped_json_t const* shaped,
+                                         TRI_shape_t const* shape) {
+  char const* data = shaped->_data.data;
+
+  switch (shape->_type) {
+    case TRI_SHAPE_NULL: {
+      return CreateNull();
+    }
+
+    case TRI_SHAPE_BOOLEAN: {
+      TRI_shape_boolean_t value;
+      memcpy(&value, data, sizeof(TRI_shape_boolean_t));
+      return CreateBoolean(value != 0);
+    }
+
+    case TRI_SHAPE_NUMBER: {
+      TRI_shape_number_t value;
+      memcpy(&value, data, sizeof(TRI_shape_number_t));
+      return CreateNumber(value);
+    }
+
+    case TRI_SHAPE_SHORT_STRING:
+    case TRI_SHAPE_LONG_STRING: {
+      char* value;
+      size_t length;
+
+      TRI_StringValueShapedJson(shape, data, &value, &length);
+      return CreateString(value, length);
+    }
+
+    default: {
+      std::unique_ptr<TRI_json_t> json(TRI_JsonShapedJson(shaper, shaped));
+
+      if (json == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
+
+      auto result = new Json(TRI_UNKNOWN_MEM_ZONE, json.get());
+      json.release();
+      return AqlValue(result);
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief a quick method to decide whether a value is true
 ////////////////////////////////////////////////////////////////////////////////
@@ -57,6 +160,15 @@ bool AqlValue::isTrue () const {
       return true;
     }
   }
+  else if (_type == INLINE_BOOL) {
+    return _boolean;
+  }
+  else if (_type == INLINE_NUMBER) {
+    return _number != 0.0;
+  }
+  else if (_type == INLINE_STRING) {
+    return _string[0] != '\0';
+  }
   else if (_type == RANGE || _type == DOCVEC) {
     // a range or a docvec is equivalent to an array
     return true;
@@ -98,7 +210,11 @@ void AqlValue::destroy () {
       // do nothing here, since data pointers need not be freed
       break;
     }
-    case EMPTY: {
+    case EMPTY: 
+    case INLINE_NULL: 
+    case INLINE_BOOL: 
+    case INLINE_NUMBER: 
+    case INLINE_STRING: {
       // do nothing
       break;
     }
@@ -124,6 +240,13 @@ std::string AqlValue::getTypeString () const {
       return "range";
     case EMPTY: 
       return "empty";
+    case INLINE_NULL:
+    case INLINE_BOOL:
+    case INLINE_NUMBER:
+    case INLINE_STRING: {
+      TRI_json_t buffer;
+      return std::string("inline (") + std::string(TRI_GetTypeStringJson(inlineJson(buffer))) + std::string(")");
+    }
   }
 
   THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
@@ -168,6 +291,13 @@ AqlValue AqlValue::clone () const {
     case EMPTY: {
       return AqlValue();
     }
+
+    case INLINE_NULL:
+    case INLINE_BOOL:
+    case INLINE_NUMBER:
+    case INLINE_STRING: {
+      return *this;
+    }
   }
 
   THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
@@ -197,10 +327,17 @@ bool AqlValue::isString () const {
       return TRI_IsStringJson(json);
     }
 
+    case INLINE_STRING: {
+      return true;
+    }
+
     case SHAPED: 
     case DOCVEC: 
     case RANGE: 
-    case EMPTY: {
+    case EMPTY: 
+    case INLINE_NULL: 
+    case INLINE_BOOL: 
+    case INLINE_NUMBER: {
       return false;
     }
   }
@@ -220,10 +357,17 @@ bool AqlValue::isNumber () const {
       return TRI_IsNumberJson(json);
     }
 
+    case INLINE_NUMBER: {
+      return true;
+    }
+
     case SHAPED: 
     case DOCVEC: 
     case RANGE: 
-    case EMPTY: {
+    case EMPTY: 
+    case INLINE_NULL: 
+    case INLINE_BOOL: 
+    case INLINE_STRING: {
       return false;
     }
   }
@@ -243,10 +387,17 @@ bool AqlValue::isBoolean () const {
       return TRI_IsBooleanJson(json);
     }
 
+    case INLINE_BOOL: {
+      return true;
+    }
+
     case SHAPED: 
     case DOCVEC: 
     case RANGE: 
-    case EMPTY: {
+    case EMPTY: 
+    case INLINE_NULL: 
+    case INLINE_NUMBER: 
+    case INLINE_STRING: {
       return false;
     }
   }
@@ -274,7 +425,11 @@ bool AqlValue::isArray () const {
       return true;
     }
 
-    case EMPTY: {
+    case EMPTY: 
+    case INLINE_NULL: 
+    case INLINE_BOOL: 
+    case INLINE_NUMBER: 
+    case INLINE_STRING: {
       return false;
     }
   }
@@ -299,7 +454,11 @@ bool AqlValue::isObject () const {
 
     case DOCVEC: 
     case RANGE: 
-    case EMPTY: {
+    case EMPTY: 
+    case INLINE_NULL: 
+    case INLINE_BOOL: 
+    case INLINE_NUMBER: 
+    case INLINE_STRING: {
       return false;
     }
   }
@@ -323,10 +482,17 @@ bool AqlValue::isNull (bool emptyIsNull) const {
     }
 
     case DOCVEC: 
-    case RANGE: {
+    case RANGE: 
+    case INLINE_BOOL: 
+    case INLINE_NUMBER: 
+    case INLINE_STRING: {
       return false;
     }
 
+    case INLINE_NULL: {
+      return true;
+    }
+
     case EMPTY: {
       return emptyIsNull;
     }
@@ -374,7 +540,11 @@ triagens::basics::Json AqlValue::at (triagens::arango::AqlTransaction* trx,
     }
        
     case SHAPED: 
-    case EMPTY: {
+    case EMPTY: 
+    case INLINE_NULL: 
+    case INLINE_BOOL: 
+    case INLINE_NUMBER: 
+    case INLINE_STRING: {
     }
   }
 
@@ -412,7 +582,11 @@ size_t AqlValue::arraySize () const {
     }
        
     case SHAPED: 
-    case EMPTY: {
+    case EMPTY: 
+    case INLINE_NULL: 
+    case INLINE_BOOL: 
+    case INLINE_NUMBER: 
+    case INLINE_STRING: {
     }
   }
 
@@ -427,6 +601,13 @@ int64_t AqlValue::toInt64 () const {
   switch (_type) {
     case JSON: 
       return TRI_ToInt64Json(_json->json());
+    case INLINE_NULL:
+    case INLINE_BOOL:
+    case INLINE_NUMBER:
+    case INLINE_STRING: {
+      TRI_json_t buffer;
+      return TRI_ToInt64Json(inlineJson(buffer));
+    }
     case RANGE: {
       size_t rangeSize = _range->size();
       if (rangeSize == 1) {  
@@ -456,10 +637,17 @@ std::string AqlValue::toString () const {
       return std::string(json->_value._string.data, json->_value._string.length - 1);
     }
 
+    case INLINE_STRING: {
+      return std::string(_string);
+    }
+
     case SHAPED: 
     case DOCVEC: 
     case RANGE: 
-    case EMPTY: {
+    case EMPTY: 
+    case INLINE_NULL: 
+    case INLINE_BOOL: 
+    case INLINE_NUMBER: {
       // cannot convert these types
     }
   }
@@ -479,10 +667,17 @@ char const* AqlValue::toChar () const {
       return json->_value._string.data;
     }
 
+    case INLINE_STRING: {
+      return _string;
+    }
+
     case SHAPED: 
     case DOCVEC: 
     case RANGE: 
-    case EMPTY: {
+    case EMPTY: 
+    case INLINE_NULL: 
+    case INLINE_BOOL: 
+    case INLINE_NUMBER: {
       // cannot convert these types 
     }
   }
@@ -608,6 +803,22 @@ v8::Handle<v8::Value> AqlValue::toV8 (v8::Isolate* isolate,
       return result;
     }
 
+    case INLINE_NULL: {
+      return v8::Null(isolate);
+    }
+
+    case INLINE_BOOL: {
+      return v8::Boolean::New(isolate, _boolean);
+    }
+
+    case INLINE_NUMBER: {
+      return v8::Number::New(isolate, _number);
+    }
+
+    case INLINE_STRING: {
+      return TRI_V8_STRING(_string);
+    }
+
     case EMPTY: {
       return v8::Undefined(isolate);
     }
@@ -708,6 +919,22 @@ Json AqlValue::toJson (triagens::arango::AqlTransaction* trx,
       return json;
     }
 
+    case INLINE_NULL: {
+      return Json(Json::Null);
+    }
+
+    case INLINE_BOOL: {
+      return Json(_boolean);
+    }
+
+    case INLINE_NUMBER: {
+      return Json(_number);
+    }
+
+    case INLINE_STRING: {
+      return Json(TRI_UNKNOWN_MEM_ZONE, _string, strlen(_string));
+    }
+
     case EMPTY: {
       return triagens::basics::Json();
     }
@@ -727,6 +954,15 @@ uint64_t AqlValue::hash (triagens::arango::AqlTransaction* trx,
       return TRI_FastHashJson(_json->json());
     }
 
+    case INLINE_NULL:
+    case INLINE_BOOL:
+    case INLINE_NUMBER:
+    case INLINE_STRING: {
+      // must produce the same hash values as the equivalent JSON values
+      TRI_json_t buffer;
+      return TRI_FastHashJson(inlineJson(buffer));
+    }
+
     case SHAPED: {
       TRI_ASSERT(document != nullptr);
       TRI_ASSERT(_marker != nullptr);
@@ -915,7 +1151,11 @@ Json AqlValue::extractObjectMember (triagens::arango::AqlTransaction* trx,
 
     case DOCVEC:
     case RANGE:
-    case EMPTY: {
+    case EMPTY: 
+    case INLINE_NULL: 
+    case INLINE_BOOL: 
+    case INLINE_NUMBER: 
+    case INLINE_STRING: {
       break;
     }
   }
@@ -1001,7 +1241,11 @@ Json AqlValue::extractArrayMember (triagens::arango::AqlTransaction* trx,
     }
 
     case SHAPED: 
-    case EMPTY: {
+    case EMPTY: 
+    case INLINE_NULL: 
+    case INLINE_BOOL: 
+    case INLINE_NUMBER: 
+    case INLINE_STRING: {
       break; // fall-through to returning null
     }
   }
@@ -1088,6 +1332,26 @@ int AqlValue::Compare (triagens::arango::AqlTransaction* trx,
                        AqlValue const& right, 
                        TRI_document_collection_t const* rightcoll,
                        bool compareUtf8) {
+  if (left.isInline() || right.isInline()) {
+    if (left._type == AqlValue::EMPTY) {
+      return -1;
+    }
+
+    if (right._type == AqlValue::EMPTY) {
+      return 1;
+    }
+
+    // inline values are compared without allocating memory
+    TRI_json_t lbuffer;
+    TRI_json_t rbuffer;
+    Json lholder;
+    Json rholder;
+
+    return TRI_CompareValuesJson(left.jsonView(trx, leftcoll, lbuffer, lholder),
+                                 right.jsonView(trx, rightcoll, rbuffer, rholder),
+                                 compareUtf8);
+  }
+
   if (left._type != right._type) {
     if (left._type == AqlValue::EMPTY) {
       return -1;
@@ -1239,6 +1503,113 @@ int AqlValue::Compare (triagens::arango::AqlTransaction* trx,
   }
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stores a scalar JSON value inline
+////////////////////////////////////////////////////////////////////////////////
+
+bool AqlValue::setInline (TRI_json_t const* json) {
+  if (json == nullptr) {
+    return false;
+  }
+
+  switch (json->_type) {
+    case TRI_JSON_NULL: {
+      _type = INLINE_NULL;
+      return true;
+    }
+
+    case TRI_JSON_BOOLEAN: {
+      _boolean = json->_value._boolean;
+      _type = INLINE_BOOL;
+      return true;
+    }
+
+    case TRI_JSON_NUMBER: {
+      _number = json->_value._number;
+      _type = INLINE_NUMBER;
+      return true;
+    }
+
+    case TRI_JSON_STRING:
+    case TRI_JSON_STRING_REFERENCE: {
+      // the trailing NUL byte counts, too
+      size_t const length = json->_value._string.length - 1;
+
+      if (length > MaxInlineStringLength ||
+          memchr(json->_value._string.data, '\0', length) != nullptr) {
+        return false;
+      }
+
+      memcpy(_string, json->_value._string.data, length);
+      _string[length] = '\0';
+      _type = INLINE_STRING;
+      return true;
+    }
+
+    default: {
+      return false;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns a JSON view of an inline value
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t const* AqlValue::inlineJson (TRI_json_t& buffer) const {
+  switch (_type) {
+    case INLINE_NULL: {
+      TRI_InitNullJson(&buffer);
+      break;
+    }
+
+    case INLINE_BOOL: {
+      TRI_InitBooleanJson(&buffer, _boolean);
+      break;
+    }
+
+    case INLINE_NUMBER: {
+      TRI_InitNumberJson(&buffer, _number);
+      break;
+    }
+
+    case INLINE_STRING: {
+      TRI_InitStringReferenceJson(&buffer, _string, strlen(_string));
+      break;
+    }
+
+    default: {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+    }
+  }
+
+  return &buffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns a JSON view of any value
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t const* AqlValue::jsonView (triagens::arango::AqlTransaction* trx,
+                                      TRI_document_collection_t const* document,
+                                      TRI_json_t& buffer,
+                                      Json& holder) const {
+  if (isInline()) {
+    return inlineJson(buffer);
+  }
+
+  if (_type == JSON) {
+    return _json->json();
+  }
+
+  holder = toJson(trx, document, false);
+  return holder.json();
+}
+
 // Local Variables:
 // mode: outline-minor
 // outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
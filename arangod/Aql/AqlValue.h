@@ -63,13 +63,23 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
       enum AqlValueType {
-        EMPTY,     // contains no data
-        JSON,      // Json*
-        SHAPED,    // TRI_df_marker_t*
-        DOCVEC,    // a vector of blocks of results coming from a subquery
-        RANGE      // a pointer to a range remembering lower and upper bound
+        EMPTY,          // contains no data
+        JSON,           // Json*
+        SHAPED,         // TRI_df_marker_t*
+        DOCVEC,         // a vector of blocks of results coming from a subquery
+        RANGE,          // a pointer to a range remembering lower and upper bound
+        INLINE_NULL,    // null, stored inline
+        INLINE_BOOL,    // a boolean, stored inline
+        INLINE_NUMBER,  // a number, stored inline
+        INLINE_STRING   // a short string, stored inline
       };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum length of a string that is stored inline
+////////////////////////////////////////////////////////////////////////////////
+
+      static size_t const MaxInlineStringLength = 7;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                        constructors / destructors
 // -----------------------------------------------------------------------------
@@ -105,6 +115,64 @@ namespace triagens {
         _range = new Range(low, high);
       }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief factories for scalar values, these do not allocate any memory
+////////////////////////////////////////////////////////////////////////////////
+
+      static AqlValue CreateNull () {
+        AqlValue value;
+        value._type = INLINE_NULL;
+        return value;
+      }
+
+      static AqlValue CreateBoolean (bool b) {
+        AqlValue value;
+        value._boolean = b;
+        value._type = INLINE_BOOL;
+        return value;
+      }
+
+      static AqlValue CreateNumber (double number) {
+        AqlValue value;
+        value._number = number;
+        value._type = INLINE_NUMBER;
+        return value;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue from a JSON value
+///
+/// scalar values are stored inline, and the Json keeps the ownership of its
+/// value. all other values are stolen from the Json
+////////////////////////////////////////////////////////////////////////////////
+
+      static AqlValue CreateFromJson (triagens::basics::Json&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue from a copy of a JSON value
+///
+/// scalar values are stored inline without allocating any memory
+////////////////////////////////////////////////////////////////////////////////
+
+      static AqlValue CreateFromJson (TRI_json_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue from a string, short strings are stored inline
+////////////////////////////////////////////////////////////////////////////////
+
+      static AqlValue CreateString (char const*, size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue from a shaped JSON value
+///
+/// scalar values are read from the shape data and stored inline, all other
+/// values are converted into JSON
+////////////////////////////////////////////////////////////////////////////////
+
+      static AqlValue CreateFromShapedJson (TRI_shaper_t*,
+                                            TRI_shaped_json_t const*,
+                                            TRI_shape_t const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destructor, doing nothing automatically!
 ////////////////////////////////////////////////////////////////////////////////
@@ -130,7 +198,15 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
       inline bool requiresDestruction () const throw() {
-        return (_type != EMPTY && _type != SHAPED);
+        return (_type == JSON || _type == DOCVEC || _type == RANGE);
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the value is a scalar stored inline
+////////////////////////////////////////////////////////////////////////////////
+
+      inline bool isInline () const throw() {
+        return _type >= INLINE_NULL;
       }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -377,10 +453,41 @@ namespace triagens {
                           TRI_document_collection_t const*,
                           bool compareUtf8);
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stores a scalar JSON value inline, returns false if the value
+/// cannot be stored inline
+////////////////////////////////////////////////////////////////////////////////
+
+        bool setInline (TRI_json_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns a JSON view of an inline value, using the buffer passed
+/// the result points into the AqlValue and must not be modified or freed
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_json_t const* inlineJson (TRI_json_t&) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns a JSON view of any value, using the buffers passed
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_json_t const* jsonView (triagens::arango::AqlTransaction*,
+                                    TRI_document_collection_t const*,
+                                    TRI_json_t&,
+                                    triagens::basics::Json&) const;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                  public variables
 // -----------------------------------------------------------------------------
 
+      public:
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the actual data
 ////////////////////////////////////////////////////////////////////////////////
@@ -390,6 +497,9 @@ namespace triagens {
         TRI_df_marker_t const*      _marker;
         std::vector<AqlItemBlock*>* _vector;
         Range const*                _range;
+        bool                        _boolean;
+        double                      _number;
+        char                        _string[MaxInlineStringLength + 1];
       };
       
 ////////////////////////////////////////////////////////////////////////////////
@@ -431,9 +541,19 @@ namespace std {
         case triagens::aql::AqlValue::RANGE: {
           return res ^ ptrHash(x._range);
         }
-        case triagens::aql::AqlValue::EMPTY: {
+        case triagens::aql::AqlValue::EMPTY: 
+        case triagens::aql::AqlValue::INLINE_NULL: {
           return res;
         }
+        case triagens::aql::AqlValue::INLINE_BOOL: {
+          return res ^ static_cast<size_t>(x._boolean);
+        }
+        case triagens::aql::AqlValue::INLINE_NUMBER: {
+          return res ^ std::hash<double>()(x._number);
+        }
+        case triagens::aql::AqlValue::INLINE_STRING: {
+          return res ^ std::hash<std::string>()(std::string(x._string));
+        }
       }
 
       TRI_ASSERT(false);
@@ -460,6 +580,18 @@ namespace std {
         case triagens::aql::AqlValue::RANGE: {
           return a._range == b._range;
         }
+        case triagens::aql::AqlValue::INLINE_NULL: {
+          return true;
+        }
+        case triagens::aql::AqlValue::INLINE_BOOL: {
+          return a._boolean == b._boolean;
+        }
+        case triagens::aql::AqlValue::INLINE_NUMBER: {
+          return a._number == b._number;
+        }
+        case triagens::aql::AqlValue::INLINE_STRING: {
+          return strcmp(a._string, b._string) == 0;
+        }
         // case triagens::aql::AqlValue::EMPTY intentionally not handled here!
         // (should fall through and fail!)
 
@@ -559,6 +559,32 @@ AstNode* Ast::createNodeCollectCount (AstNode const* list,
   return node;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST collect node, AGGREGATE
+/// the aggregate expressions are wrapped into an aggregations node so they
+/// are not constant-folded by the optimizer
+////////////////////////////////////////////////////////////////////////////////
+
+AstNode* Ast::createNodeCollectAggregate (AstNode const* list,
+                                          AstNode const* aggregates,
+                                          AstNode const* options) {
+  AstNode* node = createNode(NODE_TYPE_COLLECT_AGGREGATE);
+  
+  if (options == nullptr) {
+    // no options given. now use default options
+    options = &NopNode;
+  }
+  node->addMember(options);
+
+  node->addMember(list);
+
+  AstNode* aggregations = createNode(NODE_TYPE_AGGREGATIONS);
+  aggregations->addMember(aggregates);
+  node->addMember(aggregations);
+
+  return node;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create an AST sort node
 ////////////////////////////////////////////////////////////////////////////////
@@ -1278,6 +1304,11 @@ void Ast::validateAndOptimize () {
         ++(static_cast<TraversalContext*>(data)->stopOptimizationRequests);
       }
     }
+    else if (node->type == NODE_TYPE_AGGREGATIONS) {
+      // the aggregate function calls of COLLECT ... AGGREGATE must not be
+      // folded into constants
+      ++(static_cast<TraversalContext*>(data)->stopOptimizationRequests);
+    }
     else if (node->hasFlag(FLAG_BIND_PARAMETER)) {
       return false;
     }
@@ -1306,6 +1337,9 @@ void Ast::validateAndOptimize () {
         --(static_cast<TraversalContext*>(data)->stopOptimizationRequests);
       }
     }
+    else if (node->type == NODE_TYPE_AGGREGATIONS) {
+      --(static_cast<TraversalContext*>(data)->stopOptimizationRequests);
+    }
   };
 
   auto visitor = [&](AstNode* node, void* data) -> AstNode* {
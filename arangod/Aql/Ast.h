@@ -355,6 +355,14 @@ namespace triagens {
                                          char const*,
                                          AstNode const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST collect node, AGGREGATE
+////////////////////////////////////////////////////////////////////////////////
+
+        AstNode* createNodeCollectAggregate (AstNode const*,
+                                             AstNode const*,
+                                             AstNode const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create an AST sort node
 ////////////////////////////////////////////////////////////////////////////////
@@ -37,6 +37,7 @@
 #include "Basics/json-utilities.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/Utf8Helper.h"
+#include "Cluster/ServerState.h"
 
 using namespace triagens::aql;
 using JsonHelper = triagens::basics::JsonHelper;
@@ -148,7 +149,9 @@ std::unordered_map<int, std::string const> const AstNode::TypeNames{
   { static_cast<int>(NODE_TYPE_CALCULATED_OBJECT_ELEMENT),"calculated object element" },
   { static_cast<int>(NODE_TYPE_EXAMPLE),                  "example" },
   { static_cast<int>(NODE_TYPE_PASSTHRU),                 "passthru" },
-  { static_cast<int>(NODE_TYPE_ARRAY_LIMIT),              "array limit" }
+  { static_cast<int>(NODE_TYPE_ARRAY_LIMIT),              "array limit" },
+  { static_cast<int>(NODE_TYPE_COLLECT_AGGREGATE),        "collect aggregate" },
+  { static_cast<int>(NODE_TYPE_AGGREGATIONS),             "aggregations" }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -535,6 +538,8 @@ AstNode::AstNode (Ast* ast,
     case NODE_TYPE_COLLECT:
     case NODE_TYPE_COLLECT_COUNT:
     case NODE_TYPE_COLLECT_EXPRESSION:
+    case NODE_TYPE_COLLECT_AGGREGATE:
+    case NODE_TYPE_AGGREGATIONS:
     case NODE_TYPE_SORT:
     case NODE_TYPE_SORT_ELEMENT:
     case NODE_TYPE_LIMIT:
@@ -1257,11 +1262,36 @@ bool AstNode::isSimple () const {
     auto func = static_cast<Function*>(getData());
     TRI_ASSERT(func != nullptr);
 
-    if (func->implementation == nullptr || ! getMember(0)->isSimple()) {
+    if (func->implementation == nullptr) {
       setFlag(DETERMINED_SIMPLE);
       return false;
     }
 
+    auto args = getMember(0);
+    size_t const n = args->numMembers();
+
+    for (size_t i = 0; i < n; ++i) {
+      auto member = args->getMemberUnchecked(i);
+      auto conversion = func->getArgumentConversion(i);
+
+      if (member->type == NODE_TYPE_COLLECTION &&
+          (conversion == Function::CONVERSION_REQUIRED || conversion == Function::CONVERSION_OPTIONAL)) {
+        // collection parameters are passed to the C++ handler by name. the
+        // collection is only accessible locally outside the coordinator
+        if (triagens::arango::ServerState::instance()->isCoordinator()) {
+          setFlag(DETERMINED_SIMPLE);
+          return false;
+        }
+        continue;
+      }
+
+      if (conversion == Function::CONVERSION_REQUIRED || ! member->isSimple()) {
+        // leave reporting invalid parameters to the JavaScript function call
+        setFlag(DETERMINED_SIMPLE);
+        return false;
+      }
+    }
+
     setFlag(DETERMINED_SIMPLE, VALUE_SIMPLE);
     return true;
   }
@@ -120,7 +120,8 @@ AqlValue AttributeAccessor::get (triagens::arango::AqlTransaction* trx,
       if (result.isShaped()) {
         switch (_attributeType) {
           case ATTRIBUTE_TYPE_KEY: {
-            return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, TRI_EXTRACT_MARKER_KEY(result._marker)));
+            char const* key = TRI_EXTRACT_MARKER_KEY(result._marker);
+            return AqlValue::CreateString(key, strlen(key));
           }
 
           case ATTRIBUTE_TYPE_REV: {
@@ -165,15 +166,7 @@ AqlValue AttributeAccessor::get (triagens::arango::AqlTransaction* trx,
 
           if (i == n) {
             // reached the end
-            std::unique_ptr<TRI_json_t> copy(TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, json));
-            
-            if (copy == nullptr) {
-              THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-            }
-
-            auto result = new Json(TRI_UNKNOWN_MEM_ZONE, copy.get());
-            copy.release();
-            return AqlValue(result);
+            return AqlValue::CreateFromJson(json);
           }
         }
 
@@ -185,7 +178,7 @@ AqlValue AttributeAccessor::get (triagens::arango::AqlTransaction* trx,
     // fall-through intentional
   }
   
-  return AqlValue(new Json(Json::Null));
+  return AqlValue::CreateNull();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -196,9 +189,7 @@ AqlValue AttributeAccessor::extractRev (AqlValue const& src) {
   _buffer.reset();
   _buffer.appendInteger(TRI_EXTRACT_MARKER_RID(src._marker));
 
-  auto json = new Json(TRI_UNKNOWN_MEM_ZONE, _buffer.c_str(), _buffer.length());
-
-  return AqlValue(json);
+  return AqlValue::CreateString(_buffer.c_str(), _buffer.length());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -217,9 +208,7 @@ AqlValue AttributeAccessor::extractId (AqlValue const& src,
   _buffer.appendChar('/');
   _buffer.appendText(TRI_EXTRACT_MARKER_KEY(src._marker));
 
-  auto json = new Json(TRI_UNKNOWN_MEM_ZONE, _buffer.c_str(), _buffer.length());
-
-  return AqlValue(json);
+  return AqlValue::CreateString(_buffer.c_str(), _buffer.length());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -230,7 +219,7 @@ AqlValue AttributeAccessor::extractFrom (AqlValue const& src,
                                          triagens::arango::AqlTransaction* trx) {
   if (src._marker->_type != TRI_DOC_MARKER_KEY_EDGE &&
       src._marker->_type != TRI_WAL_MARKER_EDGE) {
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
   
   auto cid = TRI_EXTRACT_MARKER_FROM_CID(src._marker);
@@ -245,9 +234,7 @@ AqlValue AttributeAccessor::extractFrom (AqlValue const& src,
   _buffer.appendChar('/');
   _buffer.appendText(TRI_EXTRACT_MARKER_FROM_KEY(src._marker));
   
-  auto json = new Json(TRI_UNKNOWN_MEM_ZONE, _buffer.c_str(), _buffer.length());
-
-  return AqlValue(json);
+  return AqlValue::CreateString(_buffer.c_str(), _buffer.length());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -258,7 +245,7 @@ AqlValue AttributeAccessor::extractTo (AqlValue const& src,
                                        triagens::arango::AqlTransaction* trx) {
   if (src._marker->_type != TRI_DOC_MARKER_KEY_EDGE &&
       src._marker->_type != TRI_WAL_MARKER_EDGE) {
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
 
   auto cid = TRI_EXTRACT_MARKER_TO_CID(src._marker);
@@ -273,9 +260,7 @@ AqlValue AttributeAccessor::extractTo (AqlValue const& src,
   _buffer.appendChar('/');
   _buffer.appendText(TRI_EXTRACT_MARKER_TO_KEY(src._marker));
   
-  auto json = new Json(TRI_UNKNOWN_MEM_ZONE, _buffer.c_str(), _buffer.length());
-
-  return AqlValue(json);
+  return AqlValue::CreateString(_buffer.c_str(), _buffer.length());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -303,19 +288,11 @@ AqlValue AttributeAccessor::extractRegular (AqlValue const& src,
     bool ok = TRI_ExtractShapedJsonVocShaper(_shaper, &shapedJson, 0, _pid, &json, &shape);
 
     if (ok && shape != nullptr) {
-      std::unique_ptr<TRI_json_t> extracted(TRI_JsonShapedJson(_shaper, &json));
-
-      if (extracted == nullptr) {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-      }
-
-      auto j = new Json(TRI_UNKNOWN_MEM_ZONE, extracted.get());
-      extracted.release();
-      return AqlValue(j);
+      return AqlValue::CreateFromShapedJson(_shaper, &json, shape);
     }
   }
     
-  return AqlValue(new Json(Json::Null));
+  return AqlValue::CreateNull();
 }
 
 // -----------------------------------------------------------------------------
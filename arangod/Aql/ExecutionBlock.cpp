@@ -28,6 +28,7 @@
 #include "Aql/ExecutionBlock.h"
 #include "Aql/CollectionScanner.h"
 #include "Aql/ExecutionEngine.h"
+#include "Aql/VectorizedExpression.h"
 #include "Basics/ScopeGuard.h"
 #include "Basics/StringUtils.h"
 #include "Basics/StringBuffer.h"
@@ -1182,7 +1183,7 @@ void IndexRangeBlock::buildExpressions () {
           bound = *(a._json);
           a.destroy();  // the TRI_json_t* of a._json has been stolen
         } 
-        else if (a._type == AqlValue::SHAPED || a._type == AqlValue::DOCVEC) {
+        else if (a._type == AqlValue::SHAPED || a._type == AqlValue::DOCVEC || a.isInline()) {
           bound = a.toJson(_trx, myCollection, true);
           a.destroy();  // the TRI_json_t* of a._json has been stolen
         } 
@@ -1252,7 +1253,7 @@ void IndexRangeBlock::buildExpressions () {
             bound = *(a._json);
             a.destroy();  // the TRI_json_t* of a._json has been stolen
           } 
-          else if (a._type == AqlValue::SHAPED || a._type == AqlValue::DOCVEC) {
+          else if (a._type == AqlValue::SHAPED || a._type == AqlValue::DOCVEC || a.isInline()) {
             bound = a.toJson(_trx, myCollection, true);
             a.destroy();  // the TRI_json_t* of a._json has been stolen
           } 
@@ -1798,6 +1799,13 @@ bool IndexRangeBlock::readIndex (size_t atMost) {
   else {
     TRI_ASSERT(false);
   }
+
+  auto document = _collection->documentCollection();
+
+  for (auto const& doc : _documents) {
+    document->touchLookup(doc._fid);
+  }
+
   _flag = false;
   return (! _documents.empty());
   LEAVE_BLOCK;
@@ -2591,7 +2599,12 @@ AqlItemBlock* EnumerateListBlock::getSome (size_t, size_t atMost) {
         throwArrayExpectedException();
       }
 
-      case AqlValue::EMPTY: {
+      case AqlValue::EMPTY:
+      case AqlValue::INLINE_NULL:
+      case AqlValue::INLINE_BOOL:
+      case AqlValue::INLINE_NUMBER:
+      case AqlValue::INLINE_STRING:
+      {
         throwArrayExpectedException();
       }
     }
@@ -2709,7 +2722,12 @@ size_t EnumerateListBlock::skipSome (size_t atLeast, size_t atMost) {
       }
 
       case AqlValue::SHAPED: 
-      case AqlValue::EMPTY: {
+      case AqlValue::EMPTY:
+      case AqlValue::INLINE_NULL:
+      case AqlValue::INLINE_BOOL:
+      case AqlValue::INLINE_NUMBER:
+      case AqlValue::INLINE_STRING:
+      {
         throwArrayExpectedException();
       }
     }
@@ -2750,7 +2768,7 @@ AqlValue EnumerateListBlock::getAqlValue (AqlValue const& inVarReg) {
       return AqlValue(new Json(inVarReg._json->at(static_cast<int>(_index++)).copy()));
     }
     case AqlValue::RANGE: {
-      return AqlValue(new Json(static_cast<double>(inVarReg._range->at(_index++))));
+      return AqlValue::CreateNumber(static_cast<double>(inVarReg._range->at(_index++)));
     }
     case AqlValue::DOCVEC: { // incoming doc vec has a single column
       AqlValue out = inVarReg._vector->at(_thisblock)->getValue(_index -
@@ -2763,7 +2781,12 @@ AqlValue EnumerateListBlock::getAqlValue (AqlValue const& inVarReg) {
     }
 
     case AqlValue::SHAPED:
-    case AqlValue::EMPTY: {
+    case AqlValue::EMPTY:
+    case AqlValue::INLINE_NULL:
+    case AqlValue::INLINE_BOOL:
+    case AqlValue::INLINE_NUMBER:
+    case AqlValue::INLINE_STRING:
+    {
       // error
       break;
     }
@@ -2792,7 +2815,10 @@ CalculationBlock::CalculationBlock (ExecutionEngine* engine,
     _expression(en->expression()),
     _inVars(),
     _inRegs(),
-    _outReg(ExecutionNode::MaxRegisterId) {
+    _outReg(ExecutionNode::MaxRegisterId),
+    _vectorized(nullptr),
+    _selection(),
+    _selectionBlock(nullptr) {
 
   std::unordered_set<Variable*> const& inVars = _expression->variables();
   _inVars.reserve(inVars.size());
@@ -2826,9 +2852,14 @@ CalculationBlock::CalculationBlock (ExecutionEngine* engine,
     _conditionReg = it->second.registerId;
     TRI_ASSERT(_conditionReg < ExecutionNode::MaxRegisterId);
   }
+  else if (! _isReference) {
+    // try to compile the expression for block-at-a-time evaluation
+    _vectorized = VectorizedExpression::compile(_expression->node(), _inVars, _inRegs);
+  }
 }
 
 CalculationBlock::~CalculationBlock () {
+  delete _vectorized;
 }
 
 int CalculationBlock::initialize () {
@@ -2871,6 +2902,12 @@ void CalculationBlock::executeExpression (AqlItemBlock* result) {
 
   bool const hasCondition = (static_cast<CalculationNode const*>(_exeNode)->_conditionVariable != nullptr);
 
+  if (! hasCondition && _expression->isV8()) {
+    // evaluate all rows with a single call into V8
+    executeV8Block(result);
+    return;
+  }
+
   size_t const n = result->size();
 
   for (size_t i = 0; i < n; i++) {
@@ -2882,7 +2919,7 @@ void CalculationBlock::executeExpression (AqlItemBlock* result) {
         TRI_IF_FAILURE("CalculationBlock::executeExpressionWithCondition") {
           THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
         }
-        result->setValue(i, _outReg, AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &Expression::NullJson, Json::NOFREE)));
+        result->setValue(i, _outReg, AqlValue::CreateNull());
         continue;
       }
     }
@@ -2905,6 +2942,64 @@ void CalculationBlock::executeExpression (AqlItemBlock* result) {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute a V8 expression for the whole block with a single call
+////////////////////////////////////////////////////////////////////////////////
+
+void CalculationBlock::executeV8Block (AqlItemBlock* result) {
+  size_t const n = result->size();
+
+  std::vector<AqlValue> values;
+
+  try {
+    values.reserve(n);
+    _expression->executeBlock(_trx, result, _inVars, _inRegs, values);
+    TRI_ASSERT(values.size() == n);
+
+    for (size_t i = 0; i < n; i++) {
+      TRI_IF_FAILURE("CalculationBlock::executeExpression") {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      }
+      result->setValue(i, _outReg, values[i]);
+      // the block is now responsible for the value
+      values[i].erase();
+    }
+  }
+  catch (...) {
+    for (auto& it : values) {
+      it.destroy();
+    }
+    throw;
+  }
+
+  throwIfKilled(); // check if we were aborted
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute the expression for the whole block at once
+////////////////////////////////////////////////////////////////////////////////
+
+void CalculationBlock::executeVectorized (AqlItemBlock* result) {
+  result->setDocumentCollection(_outReg, nullptr);
+
+  _selectionBlock = nullptr;
+  _vectorized->execute(_trx, result, _selection);
+
+  size_t const n = result->size();
+  TRI_ASSERT(_selection.size() == n);
+
+  for (size_t i = 0; i < n; i++) {
+    TRI_IF_FAILURE("CalculationBlock::executeExpression") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    }
+    // boolean values are stored inline, so this cannot leak
+    result->setValue(i, _outReg, AqlValue::CreateBoolean(_selection[i] != 0));
+  }
+
+  _selectionBlock = result;
+  throwIfKilled(); // check if we were aborted
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief doEvaluation, private helper to do the work
 ////////////////////////////////////////////////////////////////////////////////
@@ -2920,6 +3015,12 @@ void CalculationBlock::doEvaluation (AqlItemBlock* result) {
     return;
   }
 
+  if (_vectorized != nullptr) {
+    // a simple predicate that can be evaluated for all rows at once
+    executeVectorized(result);
+    return;
+  }
+
   // non-reference expression
 
   TRI_ASSERT(_expression != nullptr);
@@ -3129,7 +3230,8 @@ void SubqueryBlock::destroySubqueryResults (std::vector<AqlItemBlock*>* results)
 FilterBlock::FilterBlock (ExecutionEngine* engine,
                           FilterNode const* en)
   : ExecutionBlock(engine, en),
-    _inReg(ExecutionNode::MaxRegisterId) {
+    _inReg(ExecutionNode::MaxRegisterId),
+    _calculation(nullptr) {
   
   auto it = en->getRegisterPlan()->varInfo.find(en->_inVariable->id);
   TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
@@ -3141,6 +3243,18 @@ FilterBlock::~FilterBlock () {
 }
 
 int FilterBlock::initialize () {
+  _calculation = nullptr;
+
+  if (! _dependencies.empty()) {
+    auto dependency = _dependencies[0]->getPlanNode();
+
+    if (dependency->getType() == ExecutionNode::CALCULATION &&
+        static_cast<CalculationNode const*>(dependency)->outVariable()->id ==
+        static_cast<FilterNode const*>(_exeNode)->_inVariable->id) {
+      _calculation = static_cast<CalculationBlock const*>(_dependencies[0]);
+    }
+  }
+
   return ExecutionBlock::initialize();
 }
 
@@ -3163,13 +3277,36 @@ bool FilterBlock::getBlock (size_t atLeast, size_t atMost) {
 
     _chosen.clear();
     _chosen.reserve(cur->size());
-    for (size_t i = 0; i < cur->size(); ++i) {
-      if (takeItem(cur, i)) {
-        TRI_IF_FAILURE("FilterBlock::getBlock") {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+
+    std::vector<uint8_t> const* selection = nullptr;
+    if (_calculation != nullptr) {
+      selection = _calculation->selection(cur);
+    }
+
+    if (selection != nullptr) {
+      // the condition was evaluated for the whole block at once
+      TRI_ASSERT(selection->size() == cur->size());
+      uint8_t const* s = selection->data();
+
+      for (size_t i = 0; i < cur->size(); ++i) {
+        if (s[i] != 0) {
+          TRI_IF_FAILURE("FilterBlock::getBlock") {
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+          }
+
+          _chosen.emplace_back(i);
         }
+      }
+    }
+    else {
+      for (size_t i = 0; i < cur->size(); ++i) {
+        if (takeItem(cur, i)) {
+          TRI_IF_FAILURE("FilterBlock::getBlock") {
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+          }
 
-        _chosen.emplace_back(i);
+          _chosen.emplace_back(i);
+        }
       }
     }
 
@@ -3334,6 +3471,8 @@ SortedAggregateBlock::SortedAggregateBlock (ExecutionEngine* engine,
                                             AggregateNode const* en)
   : ExecutionBlock(engine, en),
     _aggregateRegisters(),
+    _aggregatorRegisters(),
+    _aggregators(),
     _currentGroup(en->_count),
     _expressionRegister(ExecutionNode::MaxRegisterId),
     _groupRegister(ExecutionNode::MaxRegisterId),
@@ -3352,6 +3491,18 @@ SortedAggregateBlock::SortedAggregateBlock (ExecutionEngine* engine,
     _aggregateRegisters.emplace_back(make_pair((*itOut).second.registerId, (*itIn).second.registerId));
   }
 
+  for (auto const& p : en->_aggregateFunctions) {
+    auto itOut = en->getRegisterPlan()->varInfo.find(p.first->id);
+    TRI_ASSERT(itOut != en->getRegisterPlan()->varInfo.end());
+
+    auto itIn = en->getRegisterPlan()->varInfo.find(p.second.first->id);
+    TRI_ASSERT(itIn != en->getRegisterPlan()->varInfo.end());
+    TRI_ASSERT((*itIn).second.registerId < ExecutionNode::MaxRegisterId);
+    TRI_ASSERT((*itOut).second.registerId < ExecutionNode::MaxRegisterId);
+    _aggregatorRegisters.emplace_back(make_pair((*itOut).second.registerId, (*itIn).second.registerId));
+    _aggregators.emplace_back(Aggregator::fromTypeString(_trx, p.second.second));
+  }
+
   if (en->_outVariable != nullptr) {
     auto const& registerPlan = en->getRegisterPlan()->varInfo;
     auto it = registerPlan.find(en->_outVariable->id);
@@ -3400,6 +3551,9 @@ SortedAggregateBlock::SortedAggregateBlock (ExecutionEngine* engine,
 }
 
 SortedAggregateBlock::~SortedAggregateBlock () {
+  for (auto& it : _aggregators) {
+    delete it;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3520,6 +3674,9 @@ int SortedAggregateBlock::getOrSkipSome (size_t atLeast,
         _currentGroup.collections[i] = cur->getDocumentCollection((*it).second);
         ++i;
       }
+      for (auto& it : _aggregators) {
+        it->reset();
+      }
       if (! skipping) {
         _currentGroup.setFirstRow(_pos);
       }
@@ -3527,6 +3684,13 @@ int SortedAggregateBlock::getOrSkipSome (size_t atLeast,
 
     if (! skipping) {
       _currentGroup.setLastRow(_pos);
+
+      // feed the row into the aggregate functions of the group
+      size_t j = 0;
+      for (auto& it : _aggregators) {
+        RegisterId const reg = _aggregatorRegisters[j++].second;
+        it->reduce(cur->getValueReference(_pos, reg), cur->getDocumentCollection(reg));
+      }
     }
 
     if (++_pos >= cur->size()) {
@@ -3630,13 +3794,25 @@ void SortedAggregateBlock::emitGroup (AqlItemBlock const* cur,
     ++i;
   }
 
+  i = 0;
+  for (auto& it : _aggregators) {
+    AqlValue value = it->stealValue();
+    try {
+      res->setValue(row, _aggregatorRegisters[i++].first, value);
+    }
+    catch (...) {
+      value.destroy();
+      throw;
+    }
+  }
+
   if (_groupRegister != ExecutionNode::MaxRegisterId) {
     // set the group values
     _currentGroup.addValues(cur, _groupRegister);
 
     if (static_cast<AggregateNode const*>(_exeNode)->_count) {
       // only set group count in result register
-      res->setValue(row, _groupRegister, AqlValue(new Json(static_cast<double>(_currentGroup.groupLength))));
+      res->setValue(row, _groupRegister, AqlValue::CreateNumber(static_cast<double>(_currentGroup.groupLength)));
     }
     else if (static_cast<AggregateNode const*>(_exeNode)->_expressionVariable != nullptr) {
       // copy expression result into result register
@@ -3666,6 +3842,7 @@ HashedAggregateBlock::HashedAggregateBlock (ExecutionEngine* engine,
                                             AggregateNode const* en)
   : ExecutionBlock(engine, en),
     _aggregateRegisters(),
+    _aggregatorRegisters(),
     _groupRegister(ExecutionNode::MaxRegisterId) {
  
   for (auto const& p : en->_aggregateVariables) {
@@ -3681,6 +3858,17 @@ HashedAggregateBlock::HashedAggregateBlock (ExecutionEngine* engine,
     _aggregateRegisters.emplace_back(make_pair((*itOut).second.registerId, (*itIn).second.registerId));
   }
 
+  for (auto const& p : en->_aggregateFunctions) {
+    auto itOut = en->getRegisterPlan()->varInfo.find(p.first->id);
+    TRI_ASSERT(itOut != en->getRegisterPlan()->varInfo.end());
+
+    auto itIn = en->getRegisterPlan()->varInfo.find(p.second.first->id);
+    TRI_ASSERT(itIn != en->getRegisterPlan()->varInfo.end());
+    TRI_ASSERT((*itIn).second.registerId < ExecutionNode::MaxRegisterId);
+    TRI_ASSERT((*itOut).second.registerId < ExecutionNode::MaxRegisterId);
+    _aggregatorRegisters.emplace_back(make_pair((*itOut).second.registerId, (*itIn).second.registerId));
+  }
+
   if (en->_outVariable != nullptr) {
     TRI_ASSERT(static_cast<AggregateNode const*>(_exeNode)->_count);
 
@@ -3744,12 +3932,28 @@ int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
     colls.emplace_back(cur->getDocumentCollection(it.second));
   }
 
-  std::unordered_map<std::vector<AqlValue>, size_t, GroupKeyHash, GroupKeyEqual> allGroups(
+  // the value of each group is its count plus the state of its aggregate
+  // functions (if any)
+  std::unordered_map<std::vector<AqlValue>, std::pair<size_t, AggregateValuesType*>, GroupKeyHash, GroupKeyEqual> allGroups(
     1024, 
     GroupKeyHash(_trx, colls), 
     GroupKeyEqual(_trx, colls)
   );
 
+  auto const& aggregateFunctions = static_cast<AggregateNode const*>(_exeNode)->_aggregateFunctions;
+
+  auto freeAggregators = [&] () {
+    for (auto& it : allGroups) {
+      if (it.second.second != nullptr) {
+        for (auto& it2 : *(it.second.second)) {
+          delete it2;
+        }
+        delete it.second.second;
+        it.second.second = nullptr;
+      }
+    }
+  };
+
   auto buildResult = [&] (AqlItemBlock const* src) {
     auto planNode = static_cast<AggregateNode const*>(getPlanNode());
     auto nrRegs = planNode->getRegisterPlan()->nrRegs[planNode->getDepth()];
@@ -3782,7 +3986,22 @@ int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
     
       if (planNode->_count) {
         // set group count in result register
-        result->setValue(row, _groupRegister, AqlValue(new Json(static_cast<double>(it.second))));
+        result->setValue(row, _groupRegister, AqlValue::CreateNumber(static_cast<double>(it.second.first)));
+      }
+
+      if (it.second.second != nullptr) {
+        // set aggregate function results in result registers
+        i = 0;
+        for (auto& aggregator : *(it.second.second)) {
+          AqlValue value = aggregator->stealValue();
+          try {
+            result->setValue(row, _aggregatorRegisters[i++].first, value);
+          }
+          catch (...) {
+            value.destroy();
+            throw;
+          }
+        }
       }
 
       ++row;
@@ -3821,11 +4040,38 @@ int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
           group.emplace_back(cur->getValueReference(_pos, _aggregateRegisters[i].second).clone());
         }
 
-        allGroups.emplace(group, 1);
+        AggregateValuesType* aggregators = nullptr;
+
+        if (! aggregateFunctions.empty()) {
+          aggregators = new AggregateValuesType();
+          try {
+            for (auto const& f : aggregateFunctions) {
+              aggregators->emplace_back(Aggregator::fromTypeString(_trx, f.second.second));
+            }
+          }
+          catch (...) {
+            for (auto& it2 : *aggregators) {
+              delete it2;
+            }
+            delete aggregators;
+            throw;
+          }
+        }
+
+        it = allGroups.emplace(group, std::make_pair(static_cast<size_t>(1), aggregators)).first;
       }
       else {
         // existing group. simply increase the counter
-        (*it).second++;
+        (*it).second.first++;
+      }
+
+      if ((*it).second.second != nullptr) {
+        // feed the row into the aggregate functions of the group
+        size_t j = 0;
+        for (auto& aggregator : *((*it).second.second)) {
+          RegisterId const reg = _aggregatorRegisters[j++].second;
+          aggregator->reduce(cur->getValueReference(_pos, reg), cur->getDocumentCollection(reg));
+        }
       }
 
       if (++_pos >= cur->size()) {
@@ -3854,6 +4100,7 @@ int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
             returnBlock(cur);         
             _done = true;
     
+            freeAggregators();
             allGroups.clear();  
             groupValues.clear();
 
@@ -3879,10 +4126,12 @@ int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
         const_cast<AqlValue*>(&it2)->destroy();
       }
     }
+    freeAggregators();
     allGroups.clear();
     throw;
   }
   
+  freeAggregators();
   allGroups.clear();  
   groupValues.clear();
 
@@ -4517,8 +4766,6 @@ void ModificationBlock::constructMptr (TRI_doc_mptr_copy_t* dst,
   dst->_rid = TRI_EXTRACT_MARKER_RID(marker);
   dst->_fid = 0;
   dst->_hash = 0;
-  dst->_prev = nullptr;
-  dst->_next = nullptr;
   dst->setDataPtr(marker);
 }
 
@@ -6508,12 +6755,17 @@ bool DistributeBlock::getBlockForClient (size_t atLeast,
   
 TRI_json_t const* DistributeBlock::getInputJson (AqlItemBlock const* cur) const {
   auto const& val = cur->getValueReference(_pos, _regId);
+  TRI_json_t const* json = nullptr;
 
-  if (val._type != AqlValue::JSON) {
+  if (val._type == AqlValue::JSON) {
+    json = val._json->json();
+  }
+  else if (val._type == AqlValue::INLINE_NULL) {
+    json = &Expression::NullJson;
+  }
+  else {
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_FAILED, "DistributeBlock: can only send JSON");
   }
-
-  TRI_json_t const* json = val._json->json();
   
   if (json != nullptr &&
       TRI_IsNullJson(json) && 
@@ -29,6 +29,7 @@
 #define ARANGODB_AQL_EXECUTION_BLOCK_H 1
 
 #include "Basics/JsonHelper.h"
+#include "Aql/Aggregator.h"
 #include "Aql/AqlItemBlock.h"
 #include "Aql/Collection.h"
 #include "Aql/CollectionScanner.h"
@@ -55,6 +56,7 @@ namespace triagens {
     struct CollectionScanner;
 
     class ExecutionEngine;
+    class VectorizedExpression;
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   AggregatorGroup
@@ -997,6 +999,18 @@ namespace triagens {
 
         void executeExpression (AqlItemBlock*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute the expression for the whole block at once
+////////////////////////////////////////////////////////////////////////////////
+
+        void executeVectorized (AqlItemBlock*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute a V8 expression for the whole block with a single call
+////////////////////////////////////////////////////////////////////////////////
+
+        void executeV8Block (AqlItemBlock*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief doEvaluation, private helper to do the work
 ////////////////////////////////////////////////////////////////////////////////
@@ -1012,6 +1026,18 @@ namespace triagens {
         AqlItemBlock* getSome (size_t atLeast,
                                size_t atMost) override final;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the selection bitmap computed for the block, or a nullptr
+/// if the block was not evaluated block-at-a-time
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<uint8_t> const* selection (AqlItemBlock const* block) const {
+          if (block != _selectionBlock) {
+            return nullptr;
+          }
+          return &_selection;
+        }
+
       private:
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1050,6 +1076,25 @@ namespace triagens {
 
         bool _isReference;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the expression compiled for block-at-a-time evaluation, or a
+/// nullptr if the expression must be evaluated row by row
+////////////////////////////////////////////////////////////////////////////////
+
+        VectorizedExpression* _vectorized;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief selection bitmap of the block evaluated last
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<uint8_t> _selection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the block the selection bitmap belongs to
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlItemBlock const* _selectionBlock;
+
     };
 
 // -----------------------------------------------------------------------------
@@ -1186,6 +1231,14 @@ namespace triagens {
 
         std::vector<size_t> _chosen;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the calculation that produces the filter condition, if it is our
+/// direct dependency. its selection bitmap is used instead of the condition
+/// values if available
+////////////////////////////////////////////////////////////////////////////////
+
+        CalculationBlock const* _calculation;
+
     };
 
 // -----------------------------------------------------------------------------
@@ -1227,6 +1280,19 @@ namespace triagens {
 
         std::vector<std::pair<RegisterId, RegisterId>> _aggregateRegisters;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pairs, consisting of out register and in register, for the
+/// aggregate functions
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<RegisterId, RegisterId>> _aggregatorRegisters;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief aggregate function states for the current group
+////////////////////////////////////////////////////////////////////////////////
+
+        AggregateValuesType _aggregators;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief details about the current group
 ////////////////////////////////////////////////////////////////////////////////
@@ -1287,6 +1353,13 @@ namespace triagens {
 
         std::vector<std::pair<RegisterId, RegisterId>> _aggregateRegisters;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pairs, consisting of out register and in register, for the
+/// aggregate functions
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<RegisterId, RegisterId>> _aggregatorRegisters;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the optional register that contains the values for each group
 /// if no values should be returned, then this has a value of MaxRegisterId
@@ -189,6 +189,21 @@ ExecutionNode* ExecutionNode::fromJsonFactory (ExecutionPlan* plan,
         aggregateVariables.emplace_back(std::make_pair(outVar, inVar));
       }
 
+      std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> aggregateFunctions;
+      triagens::basics::Json jsonAggregateFunctions = oneNode.get("aggregateFunctions");
+      if (jsonAggregateFunctions.isArray()) {
+        size_t const n = jsonAggregateFunctions.size();
+        aggregateFunctions.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+          triagens::basics::Json oneJsonAggregate = jsonAggregateFunctions.at(static_cast<int>(i));
+          Variable* outVar = varFromJson(plan->getAst(), oneJsonAggregate, "outVariable");
+          Variable* inVar =  varFromJson(plan->getAst(), oneJsonAggregate, "inVariable");
+          std::string const type = JsonHelper::checkAndGetStringValue(oneJsonAggregate.json(), "type");
+
+          aggregateFunctions.emplace_back(std::make_pair(outVar, std::make_pair(inVar, type)));
+        }
+      }
+
       bool count = JsonHelper::checkAndGetBooleanValue(oneNode.json(), "count");
 
       return new AggregateNode(plan,
@@ -198,6 +213,7 @@ ExecutionNode* ExecutionNode::fromJsonFactory (ExecutionPlan* plan,
                                keepVariables,
                                plan->getAst()->variables()->variables(false),
                                aggregateVariables,  
+                               aggregateFunctions,
                                count);
     }
     case INSERT:
@@ -959,6 +975,15 @@ void ExecutionNode::RegisterPlan::after (ExecutionNode *en) {
                                  VarInfo(depth, totalNrRegs)));
         totalNrRegs++;
       }
+      for (auto const& p : ep->_aggregateFunctions) {
+        // p is std::pair<Variable const*, std::pair<Variable const*, std::string>>
+        // and the first is the to be assigned output variable
+        nrRegsHere[depth]++;
+        nrRegs[depth]++;
+        varInfo.emplace(make_pair(p.first->id,
+                                 VarInfo(depth, totalNrRegs)));
+        totalNrRegs++;
+      }
       if (ep->_outVariable != nullptr) {
         nrRegsHere[depth]++;
         nrRegs[depth]++;
@@ -1320,6 +1345,23 @@ void EnumerateCollectionNode::getIndexesForIndexRangeNode (std::unordered_set<st
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the geo index of the collection
+////////////////////////////////////////////////////////////////////////////////
+
+Index const* EnumerateCollectionNode::getGeoIndex () const {
+  auto const& indexes = _collection->getIndexes();
+
+  for (auto const& idx : indexes) {
+    if (idx->type == triagens::arango::Index::TRI_IDX_TYPE_GEO1_INDEX ||
+        idx->type == triagens::arango::Index::TRI_IDX_TYPE_GEO2_INDEX) {
+      return idx;
+    }
+  }
+
+  return nullptr;
+}
+
 std::vector<EnumerateCollectionNode::IndexMatch> 
     EnumerateCollectionNode::getIndicesOrdered (IndexMatchVec const& attrs) const {
 
@@ -2317,10 +2359,12 @@ AggregateNode::AggregateNode (ExecutionPlan* plan,
                               std::vector<Variable const*> const& keepVariables,
                               std::unordered_map<VariableId, std::string const> const& variableMap,
                               std::vector<std::pair<Variable const*, Variable const*>> const& aggregateVariables,
+                              std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> const& aggregateFunctions,
                               bool count)
   : ExecutionNode(plan, base),
     _options(base),
     _aggregateVariables(aggregateVariables), 
+    _aggregateFunctions(aggregateFunctions), 
     _expressionVariable(expressionVariable),
     _outVariable(outVariable),
     _keepVariables(keepVariables),
@@ -2353,6 +2397,19 @@ void AggregateNode::toJsonHelper (triagens::basics::Json& nodes,
   }
   json("aggregates", values);
 
+  if (! _aggregateFunctions.empty()) {
+    triagens::basics::Json functions(triagens::basics::Json::Array, _aggregateFunctions.size());
+
+    for (auto const& it : _aggregateFunctions) {
+      triagens::basics::Json variable(triagens::basics::Json::Object);
+      variable("outVariable", it.first->toJson())
+              ("inVariable", it.second.first->toJson())
+              ("type", triagens::basics::Json(it.second.second));
+      functions(variable);
+    }
+    json("aggregateFunctions", functions);
+  }
+
   // expression variable might be empty
   if (_expressionVariable != nullptr) {
     json("expressionVariable", _expressionVariable->toJson());
@@ -2391,6 +2448,7 @@ ExecutionNode* AggregateNode::clone (ExecutionPlan* plan,
   auto outVariable = _outVariable;
   auto expressionVariable = _expressionVariable;
   auto aggregateVariables = _aggregateVariables;
+  auto aggregateFunctions = _aggregateFunctions;
 
   if (withProperties) {
     if (expressionVariable != nullptr) {
@@ -2409,12 +2467,21 @@ ExecutionNode* AggregateNode::clone (ExecutionPlan* plan,
       auto in  = plan->getAst()->variables()->createVariable(it.second);
       aggregateVariables.emplace_back(std::make_pair(out, in));
     }
+
+    aggregateFunctions.clear();
+
+    for (auto& it : _aggregateFunctions) {
+      auto out = plan->getAst()->variables()->createVariable(it.first);
+      auto in  = plan->getAst()->variables()->createVariable(it.second.first);
+      aggregateFunctions.emplace_back(std::make_pair(out, std::make_pair(in, it.second.second)));
+    }
   }
 
   auto c = new AggregateNode(plan, 
                              _id,
                              _options, 
                              aggregateVariables, 
+                             aggregateFunctions, 
                              expressionVariable, 
                              outVariable, 
                              _keepVariables, 
@@ -2468,6 +2535,9 @@ std::vector<Variable const*> AggregateNode::getVariablesUsedHere () const {
   for (auto const& p : _aggregateVariables) {
     v.emplace(p.second);
   }
+  for (auto const& p : _aggregateFunctions) {
+    v.emplace(p.second.first);
+  }
 
   if (_expressionVariable != nullptr) {
     v.emplace(_expressionVariable);
@@ -2523,7 +2593,8 @@ double AggregateNode::estimateCost (size_t& nrItems) const {
   // and thus this potential overestimation does not really matter.
 
 
-  if (_count && _aggregateVariables.empty()) {
+  if (_aggregateVariables.empty() && 
+      (_count || ! _aggregateFunctions.empty())) {
     // we are known to only produce a single output row
     nrItems = 1;
   }
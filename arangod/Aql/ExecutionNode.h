@@ -933,6 +933,13 @@ namespace triagens {
 
         std::vector<IndexMatch> getIndicesOrdered (IndexMatchVec const& attrs) const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the geo index of the collection, i.e. the first one, which is
+/// the one the NEAR and WITHIN functions use. returns nullptr if there is none
+////////////////////////////////////////////////////////////////////////////////
+
+        Index const* getGeoIndex () const;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief enable random iteration of documents in collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -1387,6 +1394,30 @@ namespace triagens {
           _fullCount = true;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the node fully counts what it limits
+////////////////////////////////////////////////////////////////////////////////
+
+        bool fullCount () const {
+          return _fullCount;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the offset
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t offset () const {
+          return _offset;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the limit
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t limit () const {
+          return _limit;
+        }
+
       private:
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2020,6 +2051,7 @@ namespace triagens {
                        size_t id,
                        AggregationOptions const& options,
                        std::vector<std::pair<Variable const*, Variable const*>> const& aggregateVariables,
+                       std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> const& aggregateFunctions,
                        Variable const* expressionVariable,
                        Variable const* outVariable,
                        std::vector<Variable const*> const& keepVariables,
@@ -2028,6 +2060,7 @@ namespace triagens {
           : ExecutionNode(plan, id), 
             _options(options),
             _aggregateVariables(aggregateVariables), 
+            _aggregateFunctions(aggregateFunctions), 
             _expressionVariable(expressionVariable),
             _outVariable(outVariable),
             _keepVariables(keepVariables),
@@ -2036,6 +2069,8 @@ namespace triagens {
 
           // outVariable can be a nullptr, but only if _count is not set
           TRI_ASSERT(! _count || _outVariable != nullptr);
+          // aggregate functions cannot be combined with INTO
+          TRI_ASSERT(_aggregateFunctions.empty() || _outVariable == nullptr);
         }
         
         AggregateNode (ExecutionPlan*,
@@ -2045,6 +2080,7 @@ namespace triagens {
                        std::vector<Variable const*> const& keepVariables,
                        std::unordered_map<VariableId, std::string const> const& variableMap,
                        std::vector<std::pair<Variable const*, Variable const*>> const& aggregateVariables,
+                       std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> const& aggregateFunctions,
                        bool count);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2177,6 +2213,14 @@ namespace triagens {
           return _aggregateVariables;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get all aggregate functions (out, (in, function name))
+////////////////////////////////////////////////////////////////////////////////
+        
+        std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> const& aggregateFunctions () const {
+          return _aggregateFunctions;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief getVariablesUsedHere
 ////////////////////////////////////////////////////////////////////////////////
@@ -2189,12 +2233,15 @@ namespace triagens {
 
         std::vector<Variable const*> getVariablesSetHere () const override final {
           std::vector<Variable const*> v;
-          size_t const n = _aggregateVariables.size() + (_outVariable == nullptr ? 0 : 1);
+          size_t const n = _aggregateVariables.size() + _aggregateFunctions.size() + (_outVariable == nullptr ? 0 : 1);
           v.reserve(n);
 
           for (auto const& p : _aggregateVariables) {
             v.emplace_back(p.first);
           }
+          for (auto const& p : _aggregateFunctions) {
+            v.emplace_back(p.first);
+          }
           if (_outVariable != nullptr) {
             v.emplace_back(_outVariable);
           }
@@ -2219,6 +2266,12 @@ namespace triagens {
 
         std::vector<std::pair<Variable const*, Variable const*>> _aggregateVariables;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief aggregate functions computed per group (out, (in, function name))
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> _aggregateFunctions;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief input expression variable (might be null)
 ////////////////////////////////////////////////////////////////////////////////
@@ -33,6 +33,7 @@
 #include "Aql/AstNode.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/Expression.h"
+#include "Aql/Function.h"
 #include "Aql/NodeFinder.h"
 #include "Aql/Optimizer.h"
 #include "Aql/Query.h"
@@ -720,6 +721,7 @@ ExecutionNode* ExecutionPlan::fromNodeCollect (ExecutionNode* previous,
                                            nextId(),
                                            options, 
                                            aggregateVariables, 
+                                           std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>>(),
                                            nullptr, 
                                            outVariable, 
                                            keepVariables, 
@@ -805,6 +807,7 @@ ExecutionNode* ExecutionPlan::fromNodeCollectExpression (ExecutionNode* previous
                                            nextId(), 
                                            options,
                                            aggregateVariables, 
+                                           std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>>(),
                                            expressionVariable, 
                                            outVariable, 
                                            std::vector<Variable const*>(), 
@@ -875,6 +878,7 @@ ExecutionNode* ExecutionPlan::fromNodeCollectCount (ExecutionNode* previous,
                                            nextId(),
                                            options, 
                                            aggregateVariables, 
+                                           std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>>(),
                                            nullptr, 
                                            outVariable, 
                                            std::vector<Variable const*>(), 
@@ -884,6 +888,113 @@ ExecutionNode* ExecutionPlan::fromNodeCollectCount (ExecutionNode* previous,
   return addDependency(previous, en);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an execution plan element from an AST COLLECT node, 
+/// AGGREGATE
+////////////////////////////////////////////////////////////////////////////////
+
+ExecutionNode* ExecutionPlan::fromNodeCollectAggregate (ExecutionNode* previous,
+                                                        AstNode const* node) {
+  TRI_ASSERT(node != nullptr && 
+             node->type == NODE_TYPE_COLLECT_AGGREGATE);
+  TRI_ASSERT(node->numMembers() == 3);
+
+  auto options = createAggregationOptions(node->getMember(0));
+
+  auto list = node->getMember(1);
+  size_t const numVars = list->numMembers();
+  
+  std::vector<std::pair<Variable const*, Variable const*>> aggregateVariables;
+  aggregateVariables.reserve(numVars);
+  for (size_t i = 0; i < numVars; ++i) {
+    auto assigner = list->getMember(i);
+
+    if (assigner == nullptr) {
+      continue;
+    }
+
+    TRI_ASSERT(assigner->type == NODE_TYPE_ASSIGN);
+    auto out = assigner->getMember(0);
+    TRI_ASSERT(out != nullptr);
+    auto v = static_cast<Variable*>(out->getData());
+    TRI_ASSERT(v != nullptr);
+   
+    auto expression = assigner->getMember(1);
+      
+    if (expression->type == NODE_TYPE_REFERENCE) {
+      // operand is a variable
+      auto e = static_cast<Variable*>(expression->getData());
+      aggregateVariables.emplace_back(std::make_pair(v, e));
+    }
+    else {
+      // operand is some misc expression
+      auto calc = createTemporaryCalculation(expression);
+
+      calc->addDependency(previous);
+      previous = calc;
+
+      aggregateVariables.emplace_back(std::make_pair(v, calc->outVariable()));
+    }
+  }
+
+  auto aggregations = node->getMember(2);
+  TRI_ASSERT(aggregations->type == NODE_TYPE_AGGREGATIONS);
+  TRI_ASSERT(aggregations->numMembers() == 1);
+  list = aggregations->getMember(0);
+  size_t const numAggregates = list->numMembers();
+
+  std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> aggregateFunctions;
+  aggregateFunctions.reserve(numAggregates);
+  for (size_t i = 0; i < numAggregates; ++i) {
+    auto assigner = list->getMember(i);
+
+    if (assigner == nullptr) {
+      continue;
+    }
+
+    TRI_ASSERT(assigner->type == NODE_TYPE_ASSIGN);
+    auto out = assigner->getMember(0);
+    TRI_ASSERT(out != nullptr);
+    auto v = static_cast<Variable*>(out->getData());
+    TRI_ASSERT(v != nullptr);
+   
+    // the parser has made sure this is a call of a supported aggregate 
+    // function with exactly one argument
+    auto func = assigner->getMember(1);
+    TRI_ASSERT(func->type == NODE_TYPE_FCALL);
+    auto name = static_cast<Function const*>(func->getData())->externalName;
+    auto expression = func->getMember(0)->getMember(0);
+      
+    if (expression->type == NODE_TYPE_REFERENCE) {
+      // operand is a variable
+      auto e = static_cast<Variable*>(expression->getData());
+      aggregateFunctions.emplace_back(std::make_pair(v, std::make_pair(e, name)));
+    }
+    else {
+      // operand is some misc expression
+      auto calc = createTemporaryCalculation(expression);
+
+      calc->addDependency(previous);
+      previous = calc;
+
+      aggregateFunctions.emplace_back(std::make_pair(v, std::make_pair(calc->outVariable(), name)));
+    }
+  }
+
+  auto en = registerNode(new AggregateNode(this, 
+                                           nextId(),
+                                           options, 
+                                           aggregateVariables, 
+                                           aggregateFunctions,
+                                           nullptr, 
+                                           nullptr, 
+                                           std::vector<Variable const*>(), 
+                                           _ast->variables()->variables(false), 
+                                           false));
+
+  return addDependency(previous, en);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create an execution plan element from an AST LIMIT node
 ////////////////////////////////////////////////////////////////////////////////
@@ -1274,6 +1385,11 @@ ExecutionNode* ExecutionPlan::fromNode (AstNode const* node) {
         en = fromNodeCollectCount(en, member);
         break;
       }
+
+      case NODE_TYPE_COLLECT_AGGREGATE: {
+        en = fromNodeCollectAggregate(en, member);
+        break;
+      }
       
       case NODE_TYPE_LIMIT: {
         en = fromNodeLimit(en, member);
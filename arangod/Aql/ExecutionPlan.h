@@ -404,6 +404,13 @@ namespace triagens {
         ExecutionNode* fromNodeCollectCount (ExecutionNode*,
                                              AstNode const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an execution plan element from an AST COLLECT node, AGGREGATE
+////////////////////////////////////////////////////////////////////////////////
+
+        ExecutionNode* fromNodeCollectAggregate (ExecutionNode*,
+                                                 AstNode const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create an execution plan element from an AST LIMIT node
 ////////////////////////////////////////////////////////////////////////////////
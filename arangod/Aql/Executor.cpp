@@ -43,6 +43,17 @@ using namespace triagens::aql;
 // --SECTION--                                             static initialization
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief JavaScript code for evaluating an expression for a block of rows.
+/// running it returns a function that wraps the compiled expression function
+////////////////////////////////////////////////////////////////////////////////
+
+static char const* const BlockWrapperCode = 
+  "(function (f) { return function (rows, consts) { "
+  "var n = rows.length, results = new Array(n); "
+  "for (var i = 0; i < n; ++i) { results[i] = f(rows[i], consts); } "
+  "return results; }; })";
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief internal functions used in execution
 ////////////////////////////////////////////////////////////////////////////////
@@ -147,6 +158,7 @@ std::unordered_map<std::string, Function const> const Executor::FunctionNames{
   { "INTERSECTION",                Function("INTERSECTION",                "AQL_INTERSECTION", "l,l|+", true, false, true, true, &Functions::Intersection) },
   { "FLATTEN",                     Function("FLATTEN",                     "AQL_FLATTEN", "l|n", true, false, true, true) },
   { "LENGTH",                      Function("LENGTH",                      "AQL_LENGTH", "las", true, false, true, true, &Functions::Length) },
+  { "COUNT",                       Function("COUNT",                       "AQL_LENGTH", "las", true, false, true, true, &Functions::Length) },   // alias for LENGTH()
   { "MIN",                         Function("MIN",                         "AQL_MIN", "l", true, false, true, true, &Functions::Min) },
   { "MAX",                         Function("MAX",                         "AQL_MAX", "l", true, false, true, true, &Functions::Max) },
   { "SUM",                         Function("SUM",                         "AQL_SUM", "l", true, false, true, true, &Functions::Sum) },
@@ -189,13 +201,14 @@ std::unordered_map<std::string, Function const> const Executor::FunctionNames{
   { "ZIP",                         Function("ZIP",                         "AQL_ZIP", "l,l", true, false, true, true) },
 
   // geo functions
-  { "NEAR",                        Function("NEAR",                        "AQL_NEAR", "h,n,n|nz,s", false, true, false, true) },
-  { "WITHIN",                      Function("WITHIN",                      "AQL_WITHIN", "h,n,n,n|s", false, true, false, true) },
+  { "NEAR",                        Function("NEAR",                        "AQL_NEAR", "h,n,n|nz,s", false, true, false, true, &Functions::Near) },
+  { "WITHIN",                      Function("WITHIN",                      "AQL_WITHIN", "h,n,n,n|s", false, true, false, true, &Functions::Within) },
   { "WITHIN_RECTANGLE",            Function("WITHIN_RECTANGLE",            "AQL_WITHIN_RECTANGLE", "h,d,d,d,d", false, true, false, true) },
+  { "DISTANCE",                    Function("DISTANCE",                    "AQL_DISTANCE", "n,n,n,n", true, false, true, true, &Functions::Distance) },
   { "IS_IN_POLYGON",               Function("IS_IN_POLYGON",               "AQL_IS_IN_POLYGON", "l,ln|nb", true, false, true, true) },
 
   // fulltext functions
-  { "FULLTEXT",                    Function("FULLTEXT",                    "AQL_FULLTEXT", "h,s,s|n", false, true, false, true) },
+  { "FULLTEXT",                    Function("FULLTEXT",                    "AQL_FULLTEXT", "h,s,s|n", false, true, false, true, &Functions::Fulltext) },
 
   // graph functions
   { "PATHS",                       Function("PATHS",                       "AQL_PATHS", "c,h|s,ba", false, true, false, false) },
@@ -324,6 +337,22 @@ V8Expression* Executor::generateExpression (AstNode const* node) {
   // exit early if an error occurred
   HandleV8Error(tryCatch, func);
 
+  // wrap the expression into a function that evaluates it for a whole block
+  // of input rows, so executing a block requires only a single call into V8
+  v8::Handle<v8::Script> wrapper = v8::Script::Compile(TRI_V8_ASCII_STRING(BlockWrapperCode),
+                                                       TRI_V8_ASCII_STRING("--script--"));
+  
+  if (wrapper.IsEmpty()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "unable to compile v8 expression");
+  }
+
+  v8::Handle<v8::Value> wrapperFunc(wrapper->Run());
+  HandleV8Error(tryCatch, wrapperFunc);
+
+  v8::Handle<v8::Value> wrapperArgs[] = { func };
+  v8::Handle<v8::Value> blockFunc(v8::Handle<v8::Function>::Cast(wrapperFunc)->Call(v8::Object::New(isolate), 1, wrapperArgs));
+  HandleV8Error(tryCatch, blockFunc);
+
   // a "simple" expression here is any expression that will only return non-cyclic
   // data and will not return any special JavaScript types such as Date, RegExp or
   // Function
@@ -338,7 +367,11 @@ V8Expression* Executor::generateExpression (AstNode const* node) {
   //   whole expression is considered simple
   bool isSimple = (! node->canThrow());
 
-  return new V8Expression(isolate, v8::Handle<v8::Function>::Cast(func), constantValues, isSimple);
+  return new V8Expression(isolate, 
+                          v8::Handle<v8::Function>::Cast(func), 
+                          v8::Handle<v8::Function>::Cast(blockFunc), 
+                          constantValues, 
+                          isSimple);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
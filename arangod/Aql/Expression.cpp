@@ -174,7 +174,8 @@ AqlValue Expression::execute (triagens::arango::AqlTransaction* trx,
   switch (_type) {
     case JSON: {
       TRI_ASSERT(_data != nullptr);
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, _data, Json::NOFREE));
+      Json json(TRI_UNKNOWN_MEM_ZONE, _data, Json::NOFREE);
+      return AqlValue::CreateFromJson(json);
     }
 
     case SIMPLE: {
@@ -216,6 +217,41 @@ AqlValue Expression::execute (triagens::arango::AqlTransaction* trx,
   THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid simple expression");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute a V8 expression for all rows of a block
+////////////////////////////////////////////////////////////////////////////////
+
+void Expression::executeBlock (triagens::arango::AqlTransaction* trx,
+                               AqlItemBlock const* argv,
+                               std::vector<Variable*> const& vars,
+                               std::vector<RegisterId> const& regs,
+                               std::vector<AqlValue>& results) {
+  if (! _built) {
+    buildExpression();
+  }
+
+  TRI_ASSERT(_type == V8);
+  TRI_ASSERT(_built);
+  TRI_ASSERT(_func != nullptr);
+
+  try {
+    ISOLATE;
+    _func->executeBlock(isolate, _ast->query(), trx, argv, vars, regs, results);
+  }
+  catch (triagens::basics::Exception& ex) {
+    if (_ast->query()->verboseErrors()) {
+      ex.addToMessage(" while evaluating expression ");
+      auto json = _node->toJson(TRI_UNKNOWN_MEM_ZONE, false);
+
+      if (json != nullptr) {
+        ex.addToMessage(triagens::basics::JsonHelper::toString(json));
+        TRI_Free(TRI_UNKNOWN_MEM_ZONE, json);
+      }
+    }
+    throw;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief replace variables in the expression with other variables
 ////////////////////////////////////////////////////////////////////////////////
@@ -477,7 +513,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
 
     auto j = result.extractObjectMember(trx, myCollection, name, true, _buffer);
     result.destroy();
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j.steal()));
+    return AqlValue::CreateFromJson(j);
   }
   
   else if (node->type == NODE_TYPE_INDEXED_ACCESS) {
@@ -503,7 +539,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
         auto j = result.extractArrayMember(trx, myCollection, indexResult.toInt64(), true);
         indexResult.destroy();
         result.destroy();
-        return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j.steal()));
+        return AqlValue::CreateFromJson(j);
       }
       else if (indexResult.isString()) {
         auto&& value = indexResult.toString();
@@ -514,7 +550,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
           int64_t position = static_cast<int64_t>(std::stoll(value.c_str()));
           auto j = result.extractArrayMember(trx, myCollection, position, true);
           result.destroy();
-          return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j.steal()));
+          return AqlValue::CreateFromJson(j);
         }
         catch (...) {
           // no number found. 
@@ -531,7 +567,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
         auto j = result.extractObjectMember(trx, myCollection, indexString.c_str(), true, _buffer);
         indexResult.destroy();
         result.destroy();
-        return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j.steal()));
+        return AqlValue::CreateFromJson(j);
       }
       else if (indexResult.isString()) {
         auto&& value = indexResult.toString();
@@ -539,13 +575,13 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
 
         auto j = result.extractObjectMember(trx, myCollection, value.c_str(), true, _buffer);
         result.destroy();
-        return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j.steal()));
+        return AqlValue::CreateFromJson(j);
       }
       // fall-through to returning null
     }
     result.destroy();
       
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &NullJson, Json::NOFREE));
+    return AqlValue::CreateNull();
   }
   
   else if (node->type == NODE_TYPE_ARRAY) {
@@ -613,7 +649,8 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
     }
 
     // we do not own the JSON but the node does!
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, json, Json::NOFREE)); 
+    Json value(TRI_UNKNOWN_MEM_ZONE, json, Json::NOFREE);
+    return AqlValue::CreateFromJson(value);
   }
 
   else if (node->type == NODE_TYPE_REFERENCE) {
@@ -653,8 +690,16 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
 
     try { 
       for (size_t i = 0; i < n; ++i) {
+        auto arg = member->getMemberUnchecked(i);
+
+        if (arg->type == NODE_TYPE_COLLECTION) {
+          // the function expects a collection name here
+          parameters.emplace_back(std::make_pair(AqlValue(new Json(arg->getStringValue())), nullptr));
+          continue;
+        }
+
         TRI_document_collection_t const* myCollection = nullptr;
-        auto value = executeSimpleExpression(member->getMemberUnchecked(i), &myCollection, trx, argv, startPos, vars, regs, false);
+        auto value = executeSimpleExpression(arg, &myCollection, trx, argv, startPos, vars, regs, false);
         parameters.emplace_back(std::make_pair(value, myCollection));
       }
 
@@ -695,7 +740,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
     
     bool const operandIsTrue = operand.isTrue();
     operand.destroy();
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, operandIsTrue ? &FalseJson : &TrueJson, Json::NOFREE));
+    return AqlValue::CreateBoolean(! operandIsTrue);
   }
   
   else if (node->type == NODE_TYPE_OPERATOR_BINARY_AND ||
@@ -752,7 +797,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
         left.destroy();
         right.destroy();
         // do not throw, but return "false" instead
-        return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &FalseJson, Json::NOFREE));
+        return AqlValue::CreateBoolean(false);
       }
    
       bool result = findInArray(left, right, leftCollection, rightCollection, trx, node); 
@@ -765,7 +810,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
       left.destroy();
       right.destroy();
     
-      return AqlValue(new triagens::basics::Json(result));
+      return AqlValue::CreateBoolean(result);
     }
 
     // all other comparison operators...
@@ -778,22 +823,22 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
     right.destroy();
 
     if (node->type == NODE_TYPE_OPERATOR_BINARY_EQ) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, (compareResult == 0) ? &TrueJson : &FalseJson, Json::NOFREE));
+      return AqlValue::CreateBoolean(compareResult == 0);
     }
     else if (node->type == NODE_TYPE_OPERATOR_BINARY_NE) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, (compareResult != 0) ? &TrueJson : &FalseJson, Json::NOFREE));
+      return AqlValue::CreateBoolean(compareResult != 0);
     }
     else if (node->type == NODE_TYPE_OPERATOR_BINARY_LT) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, (compareResult < 0) ? &TrueJson : &FalseJson, Json::NOFREE));
+      return AqlValue::CreateBoolean(compareResult < 0);
     }
     else if (node->type == NODE_TYPE_OPERATOR_BINARY_LE) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, (compareResult <= 0) ? &TrueJson : &FalseJson, Json::NOFREE));
+      return AqlValue::CreateBoolean(compareResult <= 0);
     }
     else if (node->type == NODE_TYPE_OPERATOR_BINARY_GT) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, (compareResult > 0) ? &TrueJson : &FalseJson, Json::NOFREE));
+      return AqlValue::CreateBoolean(compareResult > 0);
     }
     else if (node->type == NODE_TYPE_OPERATOR_BINARY_GE) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, (compareResult >= 0) ? &TrueJson : &FalseJson, Json::NOFREE));
+      return AqlValue::CreateBoolean(compareResult >= 0);
     }
     // fall-through intentional
   }
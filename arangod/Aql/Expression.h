@@ -179,6 +179,18 @@ namespace triagens {
                           std::vector<RegisterId> const&,
                           TRI_document_collection_t const**);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute a V8 expression for all rows of a block with a single call
+/// into V8. the results are appended to the result vector, one per row. the
+/// caller is responsible for destroying them, even if an exception is thrown
+////////////////////////////////////////////////////////////////////////////////
+
+        void executeBlock (triagens::arango::AqlTransaction* trx,
+                           AqlItemBlock const*,
+                           std::vector<Variable*> const&,
+                           std::vector<RegisterId> const&,
+                           std::vector<AqlValue>&);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief check whether this is a JSON expression
 ////////////////////////////////////////////////////////////////////////////////
@@ -35,7 +35,14 @@
 #include "Basics/json-utilities.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/Utf8Helper.h"
+#include "FulltextIndex/fulltext-index.h"
+#include "FulltextIndex/fulltext-query.h"
+#include "FulltextIndex/fulltext-result.h"
+#include "GeoIndex/GeoIndex.h"
+#include "Indexes/FulltextIndex.h"
+#include "Indexes/GeoIndex2.h"
 #include "Rest/SslInterface.h"
+#include "VocBase/document-collection.h"
 
 using namespace triagens::aql;
 using Json = triagens::basics::Json;
@@ -125,6 +132,138 @@ static bool GetBooleanParameter (triagens::arango::AqlTransaction* trx,
   return false;
 }
  
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract a number parameter, using a default value for null
+////////////////////////////////////////////////////////////////////////////////
+
+static double GetNumberParameter (triagens::arango::AqlTransaction* trx,
+                                  FunctionParameters const& parameters,
+                                  size_t position,
+                                  double defaultValue) {
+  if (position >= parameters.size()) {
+    return defaultValue;
+  }
+
+  auto temp = ExtractFunctionParameter(trx, parameters, position, false);
+
+  if (temp.isNull()) {
+    return defaultValue;
+  }
+
+  return TRI_ToDoubleJson(temp.json());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief find the geo index of a collection used in a query
+///
+/// this is the first geo index of the collection, in the same way as the
+/// JavaScript implementations of the geo functions pick it
+////////////////////////////////////////////////////////////////////////////////
+
+static triagens::arango::GeoIndex2* GetGeoIndex (triagens::aql::Query* query,
+                                                 triagens::arango::AqlTransaction* trx,
+                                                 std::string const& name,
+                                                 TRI_transaction_collection_t*& trxCollection,
+                                                 TRI_document_collection_t*& document) {
+  auto collection = query->collections()->get(name);
+
+  if (collection == nullptr) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND, name.c_str());
+  }
+
+  trxCollection = trx->trxCollection(collection->cid());
+
+  if (trxCollection == nullptr) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND, name.c_str());
+  }
+
+  document = trx->documentCollection(collection->cid());
+
+  for (auto const& idx : document->allIndexes()) {
+    if (idx->type() == triagens::arango::Index::TRI_IDX_TYPE_GEO1_INDEX ||
+        idx->type() == triagens::arango::Index::TRI_IDX_TYPE_GEO2_INDEX) {
+      return static_cast<triagens::arango::GeoIndex2*>(idx);
+    }
+  }
+
+  THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_GEO_INDEX_MISSING, name.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the result of NEAR and WITHIN from a geo cursor
+///
+/// reads at most <limit> documents, nearest first, and stops at documents
+/// further away than <radius> if that is not negative. the cursor is freed
+////////////////////////////////////////////////////////////////////////////////
+
+static AqlValue GeoCursorResult (triagens::arango::AqlTransaction* trx,
+                                 TRI_transaction_collection_t* trxCollection,
+                                 TRI_document_collection_t* document,
+                                 GeoCursor* cursor,
+                                 size_t limit,
+                                 double radius,
+                                 char const* distanceAttribute) {
+  if (cursor == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  try {
+    if (trx->orderDitch(trxCollection) == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    Json result(Json::Array);
+
+    while (result.size() < limit) {
+      int const batchSize = static_cast<int>((std::min)(limit - result.size(), static_cast<size_t>(1000)));
+      GeoCoordinates* coordinates = GeoIndex_ReadCursor(cursor, batchSize, radius);
+
+      if (coordinates == nullptr) {
+        // no more documents
+        break;
+      }
+
+      size_t const n = coordinates->length;
+
+      try {
+        for (size_t i = 0; i < n; ++i) {
+          auto mptr = static_cast<TRI_doc_mptr_t const*>(coordinates->coordinates[i].data);
+          AqlValue value(static_cast<TRI_df_marker_t const*>(mptr->getDataPtr()));
+          Json doc(value.toJson(trx, document, true));
+
+          if (distanceAttribute != nullptr) {
+            // overwrites an existing attribute of the same name
+            TRI_json_t distance;
+            TRI_InitNumberJson(&distance, coordinates->distances[i]);
+            TRI_ReplaceObjectJson(TRI_UNKNOWN_MEM_ZONE, doc.json(), distanceAttribute, &distance);
+          }
+
+          result.add(doc);
+        }
+      }
+      catch (...) {
+        GeoIndex_CoordinatesFree(coordinates);
+        throw;
+      }
+
+      GeoIndex_CoordinatesFree(coordinates);
+
+      if (n < static_cast<size_t>(batchSize)) {
+        // the cursor is exhausted or the radius was reached
+        break;
+      }
+    }
+
+    GeoIndex_CursorFree(cursor);
+
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  }
+  catch (...) {
+    GeoIndex_CursorFree(cursor);
+    throw;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief extract attribute names from the arguments
 ////////////////////////////////////////////////////////////////////////////////
@@ -235,7 +374,7 @@ AqlValue Functions::IsNull (triagens::aql::Query*,
                             triagens::arango::AqlTransaction* trx,
                             FunctionParameters const& parameters) {
   auto value = ExtractFunctionParameter(trx, parameters, 0, false);
-  return AqlValue(new Json(value.isNull()));
+  return AqlValue::CreateBoolean(value.isNull());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -246,7 +385,7 @@ AqlValue Functions::IsBool (triagens::aql::Query*,
                             triagens::arango::AqlTransaction* trx,
                             FunctionParameters const& parameters) {
   auto value = ExtractFunctionParameter(trx, parameters, 0, false);
-  return AqlValue(new Json(value.isBoolean()));
+  return AqlValue::CreateBoolean(value.isBoolean());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -257,7 +396,7 @@ AqlValue Functions::IsNumber (triagens::aql::Query*,
                               triagens::arango::AqlTransaction* trx,
                               FunctionParameters const& parameters) {
   auto value = ExtractFunctionParameter(trx, parameters, 0, false);
-  return AqlValue(new Json(value.isNumber()));
+  return AqlValue::CreateBoolean(value.isNumber());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -268,7 +407,7 @@ AqlValue Functions::IsString (triagens::aql::Query*,
                               triagens::arango::AqlTransaction* trx,
                               FunctionParameters const& parameters) {
   auto value = ExtractFunctionParameter(trx, parameters, 0, false);
-  return AqlValue(new Json(value.isString()));
+  return AqlValue::CreateBoolean(value.isString());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -279,7 +418,7 @@ AqlValue Functions::IsArray (triagens::aql::Query*,
                              triagens::arango::AqlTransaction* trx,
                              FunctionParameters const& parameters) {
   auto value = ExtractFunctionParameter(trx, parameters, 0, false);
-  return AqlValue(new Json(value.isArray()));
+  return AqlValue::CreateBoolean(value.isArray());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -290,7 +429,7 @@ AqlValue Functions::IsObject (triagens::aql::Query*,
                               triagens::arango::AqlTransaction* trx,
                               FunctionParameters const& parameters) {
   auto value = ExtractFunctionParameter(trx, parameters, 0, false);
-  return AqlValue(new Json(value.isObject()));
+  return AqlValue::CreateBoolean(value.isObject());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -303,7 +442,7 @@ AqlValue Functions::Length (triagens::aql::Query*,
   if (! parameters.empty() &&
       parameters[0].first.isArray()) {
     // shortcut!
-    return AqlValue(new Json(static_cast<double>(parameters[0].first.arraySize())));
+    return AqlValue::CreateNumber(static_cast<double>(parameters[0].first.arraySize()));
   }
 
   auto value = ExtractFunctionParameter(trx, parameters, 0, false);
@@ -359,7 +498,7 @@ AqlValue Functions::Length (triagens::aql::Query*,
     }
   }
 
-  return AqlValue(new Json(static_cast<double>(length)));
+  return AqlValue::CreateNumber(static_cast<double>(length));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -421,7 +560,7 @@ AqlValue Functions::Passthru (triagens::aql::Query*,
                               FunctionParameters const& parameters) {
 
   if (parameters.empty()) {
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
 
   auto json = ExtractFunctionParameter(trx, parameters, 0, true);
@@ -440,7 +579,7 @@ AqlValue Functions::Unset (triagens::aql::Query* query,
 
   if (! value.isObject()) {
     RegisterInvalidArgumentWarning(query, "UNSET");
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
  
   std::unordered_set<std::string> names;
@@ -497,7 +636,7 @@ AqlValue Functions::Keep (triagens::aql::Query* query,
 
   if (! value.isObject()) {
     RegisterInvalidArgumentWarning(query, "KEEP");
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
  
   std::unordered_set<std::string> names;
@@ -554,7 +693,7 @@ AqlValue Functions::Merge (triagens::aql::Query* query,
 
   if (! initial.isObject()) {
     RegisterInvalidArgumentWarning(query, "MERGE");
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
 
   std::unique_ptr<TRI_json_t> result(initial.steal());
@@ -565,7 +704,7 @@ AqlValue Functions::Merge (triagens::aql::Query* query,
 
     if (! param.isObject()) {
       RegisterInvalidArgumentWarning(query, "MERGE");
-      return AqlValue(new Json(Json::Null));
+      return AqlValue::CreateNull();
     }
  
     auto merged = TRI_MergeJson(TRI_UNKNOWN_MEM_ZONE, result.get(), param.json(), false, true);
@@ -593,14 +732,14 @@ AqlValue Functions::Has (triagens::aql::Query* query,
 
   if (n < 2) {
     // no parameters
-    return AqlValue(new Json(false));
+    return AqlValue::CreateBoolean(false);
   }
     
   auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
   if (! value.isObject()) {
     // not an object
-    return AqlValue(new Json(false));
+    return AqlValue::CreateBoolean(false);
   }
  
   // process name parameter 
@@ -618,7 +757,7 @@ AqlValue Functions::Has (triagens::aql::Query* query,
   }
  
   bool const hasAttribute = (TRI_LookupObjectJson(value.json(), p) != nullptr);
-  return AqlValue(new Json(hasAttribute));
+  return AqlValue::CreateBoolean(hasAttribute);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -632,7 +771,7 @@ AqlValue Functions::Attributes (triagens::aql::Query* query,
 
   if (n < 1) {
     // no parameters
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
     
   auto value = ExtractFunctionParameter(trx, parameters, 0, false);
@@ -640,7 +779,7 @@ AqlValue Functions::Attributes (triagens::aql::Query* query,
   if (! value.isObject()) {
     // not an object
     RegisterWarning(query, "ATTRIBUTES", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
  
   bool const removeInternal = GetBooleanParameter(trx, parameters, 1, false);
@@ -708,7 +847,7 @@ AqlValue Functions::Values (triagens::aql::Query* query,
 
   if (n < 1) {
     // no parameters
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
     
   auto value = ExtractFunctionParameter(trx, parameters, 0, false);
@@ -716,7 +855,7 @@ AqlValue Functions::Values (triagens::aql::Query* query,
   if (! value.isObject()) {
     // not an object
     RegisterWarning(query, "ATTRIBUTES", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
  
   bool const removeInternal = GetBooleanParameter(trx, parameters, 1, false);
@@ -767,7 +906,7 @@ AqlValue Functions::Min (triagens::aql::Query* query,
   if (! value.isArray()) {
     // not an array
     RegisterWarning(query, "MIN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
 
   TRI_json_t const* valueJson = value.json();
@@ -797,7 +936,7 @@ AqlValue Functions::Min (triagens::aql::Query* query,
     }
   }
 
-  return AqlValue(new Json(Json::Null));
+  return AqlValue::CreateNull();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -812,7 +951,7 @@ AqlValue Functions::Max (triagens::aql::Query* query,
   if (! value.isArray()) {
     // not an array
     RegisterWarning(query, "MAX", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
 
   TRI_json_t const* valueJson = value.json();
@@ -842,7 +981,7 @@ AqlValue Functions::Max (triagens::aql::Query* query,
     }
   }
 
-  return AqlValue(new Json(Json::Null));
+  return AqlValue::CreateNull();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -857,7 +996,7 @@ AqlValue Functions::Sum (triagens::aql::Query* query,
   if (! value.isArray()) {
     // not an array
     RegisterWarning(query, "SUM", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
 
   TRI_json_t const* valueJson = value.json();
@@ -873,7 +1012,7 @@ AqlValue Functions::Sum (triagens::aql::Query* query,
 
     if (! TRI_IsNumberJson(value)) {
       RegisterInvalidArgumentWarning(query, "SUM");
-      return AqlValue(new Json(Json::Null));
+      return AqlValue::CreateNull();
     }
 
     // got a numeric value
@@ -885,10 +1024,10 @@ AqlValue Functions::Sum (triagens::aql::Query* query,
   } 
 
   if (! std::isnan(sum) && sum != HUGE_VAL && sum != -HUGE_VAL) {
-    return AqlValue(new Json(sum));
+    return AqlValue::CreateNumber(sum);
   } 
 
-  return AqlValue(new Json(Json::Null));
+  return AqlValue::CreateNull();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -903,7 +1042,7 @@ AqlValue Functions::Average (triagens::aql::Query* query,
   if (! value.isArray()) {
     // not an array
     RegisterWarning(query, "AVERAGE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
 
   TRI_json_t const* valueJson = value.json();
@@ -920,7 +1059,7 @@ AqlValue Functions::Average (triagens::aql::Query* query,
 
     if (! TRI_IsNumberJson(value)) {
       RegisterInvalidArgumentWarning(query, "AVERAGE");
-      return AqlValue(new Json(Json::Null));
+      return AqlValue::CreateNull();
     }
 
     // got a numeric value
@@ -934,10 +1073,10 @@ AqlValue Functions::Average (triagens::aql::Query* query,
 
   if (count > 0 && 
       ! std::isnan(sum) && sum != HUGE_VAL && sum != -HUGE_VAL) {
-    return AqlValue(new Json(sum / static_cast<size_t>(count)));
+    return AqlValue::CreateNumber(sum / static_cast<size_t>(count));
   } 
 
-  return AqlValue(new Json(Json::Null));
+  return AqlValue::CreateNull();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1012,7 +1151,7 @@ AqlValue Functions::Unique (triagens::aql::Query* query,
   if (! value.isArray()) {
     // not an array
     RegisterWarning(query, "UNIQUE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
+    return AqlValue::CreateNull();
   }
   
   std::unordered_set<TRI_json_t const*, triagens::basics::JsonHash, triagens::basics::JsonEqual> values(
@@ -1072,7 +1211,7 @@ AqlValue Functions::Union (triagens::aql::Query* query,
     if (! value.isArray()) {
       // not an array
       RegisterInvalidArgumentWarning(query, "UNION");
-      return AqlValue(new Json(Json::Null));
+      return AqlValue::CreateNull();
     }
 
     TRI_json_t const* valueJson = value.json();
@@ -1146,7 +1285,7 @@ AqlValue Functions::UnionDistinct (triagens::aql::Query* query,
         // not an array
         freeValues();
         RegisterInvalidArgumentWarning(query, "UNION_DISTINCT");
-        return AqlValue(new Json(Json::Null));
+        return AqlValue::CreateNull();
       }
 
       TRI_json_t const* valueJson = value.json();
@@ -1237,7 +1376,7 @@ AqlValue Functions::Intersection (triagens::aql::Query* query,
         // not an array
         freeValues();
         RegisterWarning(query, "INTERSECTION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-        return AqlValue(new Json(Json::Null));
+        return AqlValue::CreateNull();
       }
 
       TRI_json_t const* valueJson = value.json();
@@ -1322,6 +1461,266 @@ AqlValue Functions::Intersection (triagens::aql::Query* query,
   return AqlValue(jr);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FULLTEXT
+///
+/// if a limit is given, the fulltext index ranks the matching documents and
+/// only the best ones are returned, best first
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Fulltext (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              FunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+
+  if (n < 3 || n > 4) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FULLTEXT", (int) 3, (int) 4);
+  }
+
+  auto collectionName = ExtractFunctionParameter(trx, parameters, 0, false);
+  auto attribute = ExtractFunctionParameter(trx, parameters, 1, false);
+  auto queryString = ExtractFunctionParameter(trx, parameters, 2, false);
+
+  if (! collectionName.isString() ||
+      ! attribute.isString() ||
+      ! queryString.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
+  }
+
+  size_t maxResults = 0; // 0 means "all results"
+
+  if (n == 4) {
+    auto limit = ExtractFunctionParameter(trx, parameters, 3, false);
+
+    if (limit.isNumber() && limit.json()->_value._number > 0.0) {
+      maxResults = static_cast<size_t>(limit.json()->_value._number);
+    }
+  }
+
+  std::string const name(collectionName.json()->_value._string.data);
+  auto collection = query->collections()->get(name);
+
+  if (collection == nullptr) {
+    // the collection is registered with the query when the query is parsed
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND, name.c_str());
+  }
+
+  auto trxCollection = trx->trxCollection(collection->cid());
+
+  if (trxCollection == nullptr) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND, name.c_str());
+  }
+
+  TRI_document_collection_t* document = trx->documentCollection(collection->cid());
+  triagens::arango::FulltextIndex* fulltextIndex = nullptr;
+
+  for (auto const& idx : document->allIndexes()) {
+    if (idx->type() == triagens::arango::Index::TRI_IDX_TYPE_FULLTEXT_INDEX &&
+        idx->fields()[0] == attribute.json()->_value._string.data) {
+      fulltextIndex = static_cast<triagens::arango::FulltextIndex*>(idx);
+      break;
+    }
+  }
+
+  if (fulltextIndex == nullptr) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FULLTEXT_INDEX_MISSING, name.c_str());
+  }
+
+  TRI_fulltext_query_t* ft = TRI_CreateQueryFulltextIndex(TRI_FULLTEXT_SEARCH_MAX_WORDS, maxResults);
+
+  if (ft == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  bool isSubstringQuery = false;
+  int res = TRI_ParseQueryFulltextIndex(ft, queryString.json()->_value._string.data, &isSubstringQuery);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    TRI_FreeQueryFulltextIndex(ft);
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  if (isSubstringQuery) {
+    TRI_FreeQueryFulltextIndex(ft);
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_NOT_IMPLEMENTED);
+  }
+
+  // this will free the query
+  TRI_fulltext_result_t* queryResult = TRI_QueryFulltextIndex(fulltextIndex->internals(), ft);
+
+  if (queryResult == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  try {
+    if (trx->orderDitch(trxCollection) == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    Json result(Json::Array, static_cast<size_t>(queryResult->_numDocuments));
+
+    for (uint32_t i = 0; i < queryResult->_numDocuments; ++i) {
+      auto mptr = reinterpret_cast<TRI_doc_mptr_t const*>(static_cast<uintptr_t>(queryResult->_documents[i]));
+      AqlValue value(static_cast<TRI_df_marker_t const*>(mptr->getDataPtr()));
+
+      result.add(value.toJson(trx, document, true));
+    }
+
+    TRI_FreeResultFulltextIndex(queryResult);
+
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  }
+  catch (...) {
+    TRI_FreeResultFulltextIndex(queryResult);
+    throw;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DISTANCE
+///
+/// returns the distance between two points in meters, calculated the same
+/// way as the geo index calculates it. like the geo index, coordinates that
+/// are out of range are rejected
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Distance (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              FunctionParameters const& parameters) {
+  if (parameters.size() != 4) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "DISTANCE", (int) 4, (int) 4);
+  }
+
+  double values[4];
+
+  for (size_t i = 0; i < 4; ++i) {
+    auto value = ExtractFunctionParameter(trx, parameters, i, false);
+
+    if (! value.isNumber()) {
+      RegisterInvalidArgumentWarning(query, "DISTANCE");
+      return AqlValue::CreateNull();
+    }
+
+    values[i] = value.json()->_value._number;
+  }
+
+  if (values[0] < -90.0 || values[0] > 90.0 || values[1] < -180.0 || values[1] > 180.0 ||
+      values[2] < -90.0 || values[2] > 90.0 || values[3] < -180.0 || values[3] > 180.0) {
+    RegisterInvalidArgumentWarning(query, "DISTANCE");
+    return AqlValue::CreateNull();
+  }
+
+  GeoCoordinate c1;
+  c1.latitude = values[0];
+  c1.longitude = values[1];
+  c1.data = nullptr;
+
+  GeoCoordinate c2;
+  c2.latitude = values[2];
+  c2.longitude = values[3];
+  c2.data = nullptr;
+
+  return AqlValue::CreateNumber(GeoIndex_distance(&c1, &c2));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function NEAR
+///
+/// the documents are read from the geo index nearest first, and only as many
+/// as requested by the limit
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Near (triagens::aql::Query* query,
+                          triagens::arango::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+
+  if (n < 3 || n > 5) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "NEAR", (int) 3, (int) 5);
+  }
+
+  auto collectionName = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (! collectionName.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
+  }
+
+  double const latitude = GetNumberParameter(trx, parameters, 1, 0.0);
+  double const longitude = GetNumberParameter(trx, parameters, 2, 0.0);
+  double const limit = GetNumberParameter(trx, parameters, 3, 100.0);
+
+  auto distanceAttribute = ExtractFunctionParameter(trx, parameters, 4, false);
+
+  if (! distanceAttribute.isNull() && ! distanceAttribute.isString()) {
+    RegisterInvalidArgumentWarning(query, "NEAR");
+  }
+
+  TRI_transaction_collection_t* trxCollection = nullptr;
+  TRI_document_collection_t* document = nullptr;
+  auto geoIndex = GetGeoIndex(query, trx, std::string(collectionName.json()->_value._string.data), trxCollection, document);
+
+  if (limit < 1.0) {
+    return AqlValue(new Json(Json::Array));
+  }
+
+  return GeoCursorResult(trx, 
+                         trxCollection, 
+                         document, 
+                         geoIndex->nearCursor(latitude, longitude), 
+                         static_cast<size_t>(limit),
+                         -1.0,
+                         distanceAttribute.isString() ? distanceAttribute.json()->_value._string.data : nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function WITHIN
+///
+/// the documents are read from the geo index nearest first, so the result is
+/// sorted by distance
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Within (triagens::aql::Query* query,
+                            triagens::arango::AqlTransaction* trx,
+                            FunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+
+  if (n < 4 || n > 5) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "WITHIN", (int) 4, (int) 5);
+  }
+
+  auto collectionName = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (! collectionName.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "WITHIN");
+  }
+
+  double const latitude = GetNumberParameter(trx, parameters, 1, 0.0);
+  double const longitude = GetNumberParameter(trx, parameters, 2, 0.0);
+  double const radius = GetNumberParameter(trx, parameters, 3, 0.0);
+
+  auto distanceAttribute = ExtractFunctionParameter(trx, parameters, 4, false);
+
+  if (! distanceAttribute.isNull() && ! distanceAttribute.isString()) {
+    RegisterInvalidArgumentWarning(query, "WITHIN");
+  }
+
+  TRI_transaction_collection_t* trxCollection = nullptr;
+  TRI_document_collection_t* document = nullptr;
+  auto geoIndex = GetGeoIndex(query, trx, std::string(collectionName.json()->_value._string.data), trxCollection, document);
+
+  if (radius < 0.0) {
+    return AqlValue(new Json(Json::Array));
+  }
+
+  return GeoCursorResult(trx, 
+                         trxCollection, 
+                         document, 
+                         geoIndex->nearCursor(latitude, longitude), 
+                         SIZE_MAX,
+                         radius,
+                         distanceAttribute.isString() ? distanceAttribute.json()->_value._string.data : nullptr);
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -556,6 +556,12 @@ void Optimizer::setupRules () {
                removeRedundantOrRule_pass6,
                true);
 
+  // use a geo index for FOR loops filtered or sorted by DISTANCE()
+  registerRule("use-geo-index",
+               useGeoIndexRule,
+               useGeoIndexRule_pass6,
+               true);
+
   // try to find a filter after an enumerate collection and find an index . . . 
   registerRule("use-index-range",
                useIndexRangeRule,
@@ -574,6 +580,12 @@ void Optimizer::setupRules () {
                useIndexForSortRule_pass6,
                true);
 
+  // pass LIMITs into FULLTEXT function calls
+  registerRule("push-limit-into-fulltext",
+               pushLimitIntoFulltextRule,
+               pushLimitIntoFulltextRule_pass6,
+               true);
+
   // finally, push calculations as far down as possible
   registerRule("move-calculations-down",
                moveCalculationsDownRule,
@@ -610,6 +622,11 @@ void Optimizer::setupRules () {
                  distributeSortToClusterRule,
                  distributeSortToClusterRule_pass10,
                  true);
+
+    registerRule("distribute-collect-to-cluster",
+                 distributeCollectToClusterRule,
+                 distributeCollectToClusterRule_pass10,
+                 true);
     
     registerRule("remove-unnecessary-remote-scatter",
                  removeUnnecessaryRemoteScatterRule,
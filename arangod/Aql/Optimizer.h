@@ -183,6 +183,9 @@ namespace triagens {
         // remove redundant OR conditions
         removeRedundantOrRule_pass6                   = 820,
         
+        // use a geo index for FOR loops filtered or sorted by DISTANCE()
+        useGeoIndexRule_pass6                         = 825,
+        
         // try to find a filter after an enumerate collection and find an index . . . 
         useIndexRangeRule_pass6                       = 830,
 
@@ -192,6 +195,10 @@ namespace triagens {
         // try to find sort blocks which are superseeded by indexes
         useIndexForSortRule_pass6                     = 850,
 
+        // pass the limit of a FOR loop over a fulltext result into the
+        // fulltext function, so it only returns the best-ranked documents
+        pushLimitIntoFulltextRule_pass6               = 860,
+
 //////////////////////////////////////////////////////////////////////////////
 /// Pass 9: push down calculations beyond FILTERs and LIMITs
 //////////////////////////////////////////////////////////////////////////////
@@ -222,6 +229,10 @@ namespace triagens {
         // move SortNodes into the distribution.
         // adjust gathernode to also contain the sort criteria.
         distributeSortToClusterRule_pass10            = 1030,
+
+        // split COLLECT into a partial COLLECT on the DB servers and a
+        // COLLECT on the coordinator that merges the partial results
+        distributeCollectToClusterRule_pass10         = 1035,
         
         // try to get rid of a RemoteNode->ScatterNode combination which has
         // only a SingletonNode and possibly some CalculationNodes as dependencies
@@ -27,11 +27,13 @@
 
 #include "Aql/OptimizerRules.h"
 #include "Aql/AggregationOptions.h"
+#include "Aql/Aggregator.h"
 #include "Aql/ExecutionEngine.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/Function.h"
 #include "Aql/Variable.h"
 #include "Aql/types.h"
+#include "Indexes/GeoIndex2.h"
 
 using namespace triagens::aql;
 using Json = triagens::basics::Json;
@@ -1513,6 +1515,9 @@ class triagens::aql::RedundantCalculationsReplacer : public WalkerWorker<Executi
           for (auto variable : node->_aggregateVariables) {
             variable.second = Variable::replace(variable.second, _replacements);
           }
+          for (auto& it : node->_aggregateFunctions) {
+            it.second.first = Variable::replace(it.second.first, _replacements);
+          }
           break;
         }
 
@@ -2994,6 +2999,541 @@ int triagens::aql::useIndexForSortRule (Optimizer* opt,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pass the limit of a FOR loop over a FULLTEXT() result into the
+/// function call
+/// this rule modifies the plan in place
+/// for queries such as
+///   FOR doc IN FULLTEXT(collection, attribute, query) LIMIT 10 RETURN doc
+/// the fulltext index will then rank the matching documents and only return
+/// the best 10 of them, instead of returning all matches
+////////////////////////////////////////////////////////////////////////////////
+
+int triagens::aql::pushLimitIntoFulltextRule (Optimizer* opt, 
+                                              ExecutionPlan* plan, 
+                                              Optimizer::Rule const* rule) {
+  bool modified = false;
+  std::vector<ExecutionNode*>&& nodes = plan->findNodesOfType(EN::LIMIT, true);
+
+  auto firstDependency = [] (ExecutionNode const* node) -> ExecutionNode* {
+    auto deps = node->getDependencies();
+    if (deps.size() != 1) {
+      return nullptr;
+    }
+    return deps[0];
+  };
+  
+  for (auto const& n : nodes) {
+    auto limitNode = static_cast<LimitNode*>(n);
+
+    if (limitNode->fullCount()) {
+      // the full count must be determined from all matches
+      continue;
+    }
+
+    // find the FOR loop the LIMIT belongs to. only calculations may be in
+    // between, as everything else may change the number of results
+    auto current = firstDependency(n);
+
+    while (current != nullptr && current->getType() == EN::CALCULATION) {
+      current = firstDependency(current);
+    }
+
+    if (current == nullptr || current->getType() != EN::ENUMERATE_LIST) {
+      continue;
+    }
+
+    auto enumerateNode = current;
+    auto const inVariable = enumerateNode->getVariablesUsedHere()[0];
+    auto setter = plan->getVarSetBy(inVariable->id);
+
+    if (setter == nullptr || 
+        setter->getType() != EN::CALCULATION ||
+        firstDependency(enumerateNode) != setter ||
+        enumerateNode->getVarsUsedLater().find(inVariable) != enumerateNode->getVarsUsedLater().end()) {
+      // the fulltext result must not be used anywhere else
+      continue;
+    }
+
+    auto cn = static_cast<CalculationNode*>(setter);
+    auto const expression = cn->expression();
+
+    if (expression == nullptr ||
+        expression->node() == nullptr ||
+        expression->node()->type != NODE_TYPE_FCALL) {
+      continue;
+    }
+
+    auto fcall = expression->node();
+    auto func = static_cast<Function const*>(fcall->getData());
+
+    if (func->externalName != "FULLTEXT") {
+      continue;
+    }
+
+    size_t const limit = limitNode->offset() + limitNode->limit();
+    auto args = fcall->getMember(0);
+    size_t const numArgs = args->numMembers();
+
+    if (numArgs < 3 || limit == 0) {
+      continue;
+    }
+
+    if (numArgs > 3) {
+      auto const existing = args->getMember(3);
+
+      if (! existing->isNumericValue()) {
+        // we don't know the limit the function was called with
+        continue;
+      }
+
+      if (existing->getIntValue() > 0 &&
+          static_cast<size_t>(existing->getIntValue()) <= limit) {
+        // the function call is already limited enough
+        continue;
+      }
+    }
+
+    // build a new function call with the limit
+    auto ast = plan->getAst();
+    auto newArgs = ast->createNodeArray();
+
+    for (size_t i = 0; i < 3; ++i) {
+      newArgs->addMember(args->getMember(i));
+    }
+    newArgs->addMember(ast->createNodeValueInt(static_cast<int64_t>(limit)));
+
+    auto newCall = ast->createNodeFunctionCall(func->externalName.c_str(), newArgs);
+    auto outVariable = cn->getVariablesSetHere()[0];
+
+    Expression* expr = new Expression(ast, newCall);
+    CalculationNode* newNode = nullptr;
+
+    try {
+      newNode = new CalculationNode(plan, plan->nextId(), expr, outVariable);
+    }
+    catch (...) {
+      delete expr;
+      throw;
+    }
+
+    plan->registerNode(newNode);
+    plan->replaceNode(cn, newNode);
+    modified = true;
+  }
+  
+  if (modified) {
+    plan->findVarUsage();
+  }
+  
+  opt->addPlan(plan, rule, modified);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks whether a node accesses an attribute of a variable, e.g.
+/// doc.location.lat for the attribute "location.lat"
+////////////////////////////////////////////////////////////////////////////////
+
+static bool IsAttributeOfVariable (AstNode const* node,
+                                   Variable const* variable,
+                                   std::string const& attribute) {
+  std::string path;
+
+  while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    if (path.empty()) {
+      path = node->getStringValue();
+    }
+    else {
+      path = std::string(node->getStringValue()) + "." + path;
+    }
+    node = node->getMember(0);
+  }
+
+  return (node->type == NODE_TYPE_REFERENCE &&
+          static_cast<Variable const*>(node->getData()) == variable &&
+          path == attribute);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks whether a node accesses an array member of an attribute of
+/// a variable, e.g. doc.location[0]
+////////////////////////////////////////////////////////////////////////////////
+
+static bool IsArrayMemberOfVariable (AstNode const* node,
+                                     Variable const* variable,
+                                     std::string const& attribute,
+                                     int64_t position) {
+  return (node->type == NODE_TYPE_INDEXED_ACCESS &&
+          node->getMember(1)->isIntValue() &&
+          node->getMember(1)->getIntValue() == position &&
+          IsAttributeOfVariable(node->getMember(0), variable, attribute));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks whether a node is a DISTANCE() call between the coordinates
+/// a geo index holds for the documents of a variable and a constant point.
+/// if so, the constant point is returned in <latitude> and <longitude>
+////////////////////////////////////////////////////////////////////////////////
+
+static bool IsGeoIndexDistance (AstNode const* node,
+                                Variable const* variable,
+                                Index const* index,
+                                bool geoJson,
+                                AstNode const*& latitude,
+                                AstNode const*& longitude) {
+  if (node->type != NODE_TYPE_FCALL) {
+    return false;
+  }
+
+  auto func = static_cast<Function const*>(node->getData());
+
+  if (func->externalName != "DISTANCE") {
+    return false;
+  }
+
+  auto args = node->getMember(0);
+
+  if (args->numMembers() != 4) {
+    return false;
+  }
+
+  auto isIndexed = [&] (AstNode const* lat, AstNode const* lon) -> bool {
+    if (index->type == triagens::arango::Index::TRI_IDX_TYPE_GEO2_INDEX) {
+      return (index->fields.size() == 2 &&
+              IsAttributeOfVariable(lat, variable, index->fields[0]) &&
+              IsAttributeOfVariable(lon, variable, index->fields[1]));
+    }
+
+    // a geo1 index has [ latitude, longitude ] in one attribute, or
+    // [ longitude, latitude ] if it is a geoJson index
+    return (index->fields.size() == 1 &&
+            IsArrayMemberOfVariable(lat, variable, index->fields[0], geoJson ? 1 : 0) &&
+            IsArrayMemberOfVariable(lon, variable, index->fields[0], geoJson ? 0 : 1));
+  };
+
+  // the indexed point may be the first or the second one
+  for (size_t i = 0; i < 4; i += 2) {
+    size_t const other = 2 - i;
+
+    if (isIndexed(args->getMember(i), args->getMember(i + 1)) &&
+        args->getMember(other)->isNumericValue() &&
+        args->getMember(other + 1)->isNumericValue()) {
+      latitude = args->getMember(other);
+      longitude = args->getMember(other + 1);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replaces a FOR loop over a collection with a loop over a NEAR() or
+/// WITHIN() result if the loop is followed by a radius FILTER or by a SORT
+/// by distance plus a LIMIT, using DISTANCE() to the indexed coordinates
+///
+/// documents that are not in the geo index have missing, non-numeric or
+/// out-of-range coordinates, and DISTANCE() returns null for exactly these.
+/// as null is less than any radius and sorts first, the loop is only replaced
+/// if a FILTER also removes the documents with a null distance, e.g. with
+/// DISTANCE(...) != null or IS_NUMBER(DISTANCE(...))
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ReplaceWithGeoIndex (ExecutionPlan* plan,
+                                 EnumerateCollectionNode* en) {
+  auto index = en->getGeoIndex();
+
+  if (index == nullptr || ! index->hasInternals()) {
+    return false;
+  }
+
+  bool const geoJson = static_cast<triagens::arango::GeoIndex2 const*>(index->getInternals())->isGeoJson();
+  auto const variable = en->outVariable();
+
+  auto firstParent = [] (ExecutionNode const* node) -> ExecutionNode* {
+    auto parents = node->getParents();
+    if (parents.size() != 1) {
+      return nullptr;
+    }
+    return parents[0];
+  };
+  
+  // the loop produces its documents only once if everything above it
+  // produces a single row. otherwise a SORT and LIMIT below the loop work on 
+  // the documents of all executions of the loop
+  bool singleRow = true;
+  auto deps = en->getDependencies();
+
+  while (deps.size() == 1 && deps[0]->getType() != EN::SINGLETON) {
+    auto const type = deps[0]->getType();
+
+    if (type != EN::CALCULATION && type != EN::SUBQUERY) {
+      singleRow = false;
+      break;
+    }
+    deps = deps[0]->getDependencies();
+  }
+
+  // calculations below the loop, by the variables they set
+  std::unordered_map<VariableId, CalculationNode const*> calculations;
+
+  auto skipCalculations = [&] (ExecutionNode* node) -> ExecutionNode* {
+    while (node != nullptr && node->getType() == EN::CALCULATION) {
+      calculations.emplace(node->getVariablesSetHere()[0]->id, static_cast<CalculationNode const*>(node));
+      node = firstParent(node);
+    }
+    return node;
+  };
+  
+  auto findCalculation = [&] (Variable const* v) -> AstNode const* {
+    auto it = calculations.find(v->id);
+    if (it == calculations.end() || 
+        (*it).second->expression() == nullptr) {
+      return nullptr;
+    }
+    return (*it).second->expression()->node();
+  };
+
+  // resolves a reference to a variable calculated below the loop
+  std::function<AstNode const*(AstNode const*)> resolve = [&] (AstNode const* node) -> AstNode const* {
+    if (node->type == NODE_TYPE_REFERENCE) {
+      auto expression = findCalculation(static_cast<Variable const*>(node->getData()));
+
+      if (expression != nullptr) {
+        return resolve(expression);
+      }
+    }
+    return node;
+  };
+
+  AstNode const* latitude = nullptr;
+  AstNode const* longitude = nullptr;
+  AstNode const* radius = nullptr;
+  bool nullExcluded = false;
+  SortNode* sortNode = nullptr;
+  LimitNode* limitNode = nullptr;
+
+  // checks whether a node is a DISTANCE() to the indexed coordinates, with
+  // the same point as all other DISTANCE() calls seen so far
+  auto isDistance = [&] (AstNode const* node) -> bool {
+    AstNode const* lat = nullptr;
+    AstNode const* lon = nullptr;
+
+    if (! IsGeoIndexDistance(resolve(node), variable, index, geoJson, lat, lon)) {
+      return false;
+    }
+
+    if (latitude == nullptr) {
+      latitude = lat;
+      longitude = lon;
+      return true;
+    }
+
+    return (lat->getDoubleValue() == latitude->getDoubleValue() &&
+            lon->getDoubleValue() == longitude->getDoubleValue());
+  };
+
+  // checks whether a filter condition consists of a radius condition and
+  // conditions that remove documents with a null distance only. any other
+  // filter needs to see all documents
+  std::function<bool(AstNode const*)> isGeoCondition = [&] (AstNode const* condition) -> bool {
+    condition = resolve(condition);
+
+    if (condition->type == NODE_TYPE_OPERATOR_BINARY_AND) {
+      return (isGeoCondition(condition->getMember(0)) &&
+              isGeoCondition(condition->getMember(1)));
+    }
+
+    if (condition->type == NODE_TYPE_OPERATOR_BINARY_NE) {
+      // DISTANCE(...) != null, or null != DISTANCE(...)
+      auto lhs = resolve(condition->getMember(0));
+      auto rhs = resolve(condition->getMember(1));
+
+      if ((rhs->isNullValue() && isDistance(lhs)) ||
+          (lhs->isNullValue() && isDistance(rhs))) {
+        nullExcluded = true;
+        return true;
+      }
+      return false;
+    }
+
+    if (condition->type == NODE_TYPE_FCALL) {
+      // IS_NUMBER(DISTANCE(...))
+      auto func = static_cast<Function const*>(condition->getData());
+      auto args = condition->getMember(0);
+
+      if (func->externalName == "IS_NUMBER" &&
+          args->numMembers() == 1 &&
+          isDistance(args->getMember(0))) {
+        nullExcluded = true;
+        return true;
+      }
+      return false;
+    }
+
+    // DISTANCE(...) <= radius, or radius >= DISTANCE(...)
+    AstNode const* call = nullptr;
+    AstNode const* value = nullptr;
+
+    if (condition->type == NODE_TYPE_OPERATOR_BINARY_LE ||
+        condition->type == NODE_TYPE_OPERATOR_BINARY_LT) {
+      call = condition->getMember(0);
+      value = resolve(condition->getMember(1));
+    }
+    else if (condition->type == NODE_TYPE_OPERATOR_BINARY_GE ||
+             condition->type == NODE_TYPE_OPERATOR_BINARY_GT) {
+      call = condition->getMember(1);
+      value = resolve(condition->getMember(0));
+    }
+
+    if (call == nullptr ||
+        radius != nullptr ||
+        ! value->isNumericValue() ||
+        ! isDistance(call)) {
+      return false;
+    }
+
+    radius = value;
+    return true;
+  };
+
+  auto current = skipCalculations(firstParent(en));
+
+  while (current != nullptr && current->getType() == EN::FILTER) {
+    auto condition = findCalculation(current->getVariablesUsedHere()[0]);
+
+    if (condition == nullptr || ! isGeoCondition(condition)) {
+      return false;
+    }
+
+    current = skipCalculations(firstParent(current));
+  }
+
+  if (current != nullptr && current->getType() == EN::SORT && singleRow) {
+    // SORT DISTANCE(...), optionally followed by a LIMIT
+    auto sn = static_cast<SortNode*>(current);
+    auto const& elements = sn->getElements();
+
+    if (elements.size() == 1 && elements[0].second) {
+      auto call = findCalculation(elements[0].first);
+
+      if (call != nullptr && isDistance(call)) {
+        sortNode = sn;
+
+        current = skipCalculations(firstParent(sn));
+
+        if (current != nullptr && 
+            current->getType() == EN::LIMIT &&
+            ! static_cast<LimitNode*>(current)->fullCount()) {
+          limitNode = static_cast<LimitNode*>(current);
+        }
+      }
+    }
+  }
+
+  if (radius == nullptr && limitNode == nullptr) {
+    // NEAR() needs a limit
+    return false;
+  }
+
+  if (! nullExcluded) {
+    // the original loop would also return the documents that are not in the
+    // geo index, with a null distance
+    return false;
+  }
+
+  double const lat = latitude->getDoubleValue();
+  double const lon = longitude->getDoubleValue();
+
+  if (lat < -90.0 || lat > 90.0 || lon < -180.0 || lon > 180.0) {
+    // DISTANCE() to an invalid point is always null
+    return false;
+  }
+
+  // build the function call
+  auto ast = plan->getAst();
+  auto args = ast->createNodeArray();
+  char const* function;
+
+  args->addMember(ast->createNodeCollection(en->collection()->name.c_str(), TRI_TRANSACTION_READ));
+  args->addMember(latitude);
+  args->addMember(longitude);
+
+  if (radius != nullptr) {
+    function = "WITHIN";
+    args->addMember(radius);
+  }
+  else {
+    function = "NEAR";
+    args->addMember(ast->createNodeValueInt(static_cast<int64_t>(limitNode->offset() + limitNode->limit())));
+  }
+
+  auto call = ast->createNodeFunctionCall(function, args);
+  auto tmpVariable = ast->variables()->createTemporaryVariable();
+
+  Expression* expr = new Expression(ast, call);
+  CalculationNode* calculationNode = nullptr;
+
+  try {
+    calculationNode = new CalculationNode(plan, plan->nextId(), expr, tmpVariable);
+  }
+  catch (...) {
+    delete expr;
+    throw;
+  }
+
+  plan->registerNode(calculationNode);
+
+  auto enumerateNode = new EnumerateListNode(plan, plan->nextId(), tmpVariable, variable);
+  plan->registerNode(enumerateNode);
+
+  plan->replaceNode(en, enumerateNode);
+  plan->insertDependency(enumerateNode, calculationNode);
+
+  if (sortNode != nullptr) {
+    // the documents are produced nearest first
+    plan->unlinkNode(sortNode);
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief use a geo index for a FOR loop over a collection that is filtered
+/// by a radius or sorted by distance and limited, e.g.
+///   FOR d IN c FILTER DISTANCE(d.lat, d.lon, 50, 6) <= 1000 RETURN d
+///   FOR d IN c SORT DISTANCE(d.lat, d.lon, 50, 6) LIMIT 10 RETURN d
+/// the loop will iterate over the result of WITHIN() or NEAR() instead,
+/// which read the documents from the geo index nearest first
+////////////////////////////////////////////////////////////////////////////////
+
+int triagens::aql::useGeoIndexRule (Optimizer* opt, 
+                                    ExecutionPlan* plan, 
+                                    Optimizer::Rule const* rule) {
+  bool modified = false;
+
+  if (! triagens::arango::ServerState::instance()->isCoordinator()) {
+    // the geo functions are not executed natively on a coordinator
+    std::vector<ExecutionNode*>&& nodes = plan->findNodesOfType(EN::ENUMERATE_COLLECTION, true);
+
+    for (auto const& n : nodes) {
+      if (ReplaceWithGeoIndex(plan, static_cast<EnumerateCollectionNode*>(n))) {
+        modified = true;
+      }
+    }
+  }
+
+  if (modified) {
+    plan->findVarUsage();
+  }
+  
+  opt->addPlan(plan, rule, modified);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 // TODO: finish rule and test it
 struct FilterCondition {
   std::string variableName;
@@ -3899,6 +4439,158 @@ int triagens::aql::distributeSortToClusterRule (Optimizer* opt,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief split a COLLECT that sits directly on top of a GatherNode into a
+/// partial COLLECT that is executed on the DB servers, and a COLLECT on the
+/// coordinator that merges the partial results. this way only one row per
+/// group and shard is shipped to the coordinator instead of all input rows
+///
+/// the rule only applies if all aggregate functions can be computed from
+/// their partial results, and if the COLLECT has no INTO clause (WITH COUNT
+/// INTO is fine)
+////////////////////////////////////////////////////////////////////////////////
+
+int triagens::aql::distributeCollectToClusterRule (Optimizer* opt, 
+                                                   ExecutionPlan* plan,
+                                                   Optimizer::Rule const* rule) {
+  bool modified = false;
+
+  std::vector<ExecutionNode*>&& nodes = plan->findNodesOfType(EN::GATHER, true);
+  
+  for (auto& n : nodes) {
+    auto remoteNodeList = n->getDependencies();
+    TRI_ASSERT(remoteNodeList.size() > 0);
+    auto rn = remoteNodeList[0];
+    auto gatherNode = static_cast<GatherNode*>(n);
+
+    auto parents = n->getParents();
+    if (parents.size() != 1 ||
+        parents[0]->getType() != EN::AGGREGATE) {
+      continue;
+    }
+
+    auto aggregateNode = static_cast<AggregateNode*>(parents[0]);
+
+    if (aggregateNode->hasExpressionVariable() ||
+        (aggregateNode->hasOutVariable() && ! aggregateNode->count())) {
+      // INTO needs all the group members on the coordinator
+      continue;
+    }
+
+    auto const& aggregateFunctions = aggregateNode->aggregateFunctions();
+    bool canMerge = true;
+    for (auto const& it : aggregateFunctions) {
+      if (Aggregator::mergeType(it.second.second).empty()) {
+        // e.g. AVERAGE() cannot be computed from partial averages
+        canMerge = false;
+        break;
+      }
+    }
+
+    if (! canMerge) {
+      continue;
+    }
+
+    auto variables = plan->getAst()->variables();
+    auto const& options = aggregateNode->getOptions();
+    auto const& aggregateVariables = aggregateNode->aggregateVariables();
+
+    std::vector<std::pair<Variable const*, Variable const*>> partialVariables;
+    std::vector<std::pair<Variable const*, Variable const*>> mergeVariables;
+    for (auto const& it : aggregateVariables) {
+      auto tmp = variables->createTemporaryVariable();
+      partialVariables.emplace_back(std::make_pair(tmp, it.second));
+      mergeVariables.emplace_back(std::make_pair(it.first, tmp));
+    }
+
+    SortElementVector gatherElements;
+    if (options.method == AggregationOptions::AGGREGATION_METHOD_SORTED) {
+      // the partial results must arrive on the coordinator sorted by the
+      // group values. the input of the partial COLLECT on the DB servers is
+      // sorted by the group expressions already, as the sort has been moved
+      // there by the distribute-sort-to-cluster rule
+      auto const& elements = gatherNode->getElements();
+      
+      for (auto const& element : elements) {
+        size_t i = 0;
+        for (; i < aggregateVariables.size(); ++i) {
+          if (aggregateVariables[i].second == element.first) {
+            break;
+          }
+        }
+        if (i == aggregateVariables.size()) {
+          break;
+        }
+        gatherElements.emplace_back(std::make_pair(partialVariables[i].first, element.second));
+      }
+
+      if (gatherElements.size() < aggregateVariables.size()) {
+        // the gather does not merge-sort by all group values
+        continue;
+      }
+    }
+
+    std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> partialFunctions;
+    std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> mergeFunctions;
+    for (auto const& it : aggregateFunctions) {
+      auto tmp = variables->createTemporaryVariable();
+      partialFunctions.emplace_back(std::make_pair(tmp, std::make_pair(it.second.first, it.second.second)));
+      mergeFunctions.emplace_back(std::make_pair(it.first, std::make_pair(tmp, Aggregator::mergeType(it.second.second))));
+    }
+
+    Variable const* partialCountVariable = nullptr;
+    if (aggregateNode->count()) {
+      // the partial counts are summed up on the coordinator
+      partialCountVariable = variables->createTemporaryVariable();
+      mergeFunctions.emplace_back(std::make_pair(aggregateNode->outVariable(), std::make_pair(partialCountVariable, std::string("SUM"))));
+    }
+
+    std::vector<Variable const*> const noKeepVariables;
+
+    auto partialNode = new AggregateNode(plan, 
+                                         plan->nextId(), 
+                                         options, 
+                                         partialVariables, 
+                                         partialFunctions, 
+                                         nullptr, 
+                                         partialCountVariable, 
+                                         noKeepVariables, 
+                                         aggregateNode->variableMap(), 
+                                         partialCountVariable != nullptr);
+    plan->registerNode(partialNode);
+    
+    auto mergeNode = new AggregateNode(plan, 
+                                       plan->nextId(), 
+                                       options, 
+                                       mergeVariables, 
+                                       mergeFunctions, 
+                                       nullptr, 
+                                       nullptr, 
+                                       noKeepVariables, 
+                                       aggregateNode->variableMap(), 
+                                       false);
+    plan->registerNode(mergeNode);
+
+    // the partial COLLECT goes in front of the RemoteNode, and the merging
+    // COLLECT replaces the original one on the coordinator
+    plan->insertDependency(rn, partialNode);
+    plan->replaceNode(aggregateNode, mergeNode);
+
+    // the old sort criteria of the gather refer to variables that are not
+    // passed to the coordinator anymore
+    gatherNode->setElements(gatherElements);
+    modified = true;
+  }
+  
+  if (modified) {
+    plan->findVarUsage();
+  }
+  
+  opt->addPlan(plan, rule, modified);
+  
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief try to get rid of a RemoteNode->ScatterNode combination which has
 /// only a SingletonNode and possibly some CalculationNodes as dependencies
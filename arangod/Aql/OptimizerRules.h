@@ -153,6 +153,20 @@ namespace triagens {
 
     int useIndexForSortRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pass the limit of a FOR loop over a FULLTEXT() result into the
+/// function call
+////////////////////////////////////////////////////////////////////////////////
+
+    int pushLimitIntoFulltextRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief use a geo index for a FOR loop over a collection that is filtered by
+/// or sorted by the DISTANCE() to a constant point
+////////////////////////////////////////////////////////////////////////////////
+
+    int useGeoIndexRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief try to remove filters which are covered by indexes
 ////////////////////////////////////////////////////////////////////////////////
@@ -188,6 +202,14 @@ namespace triagens {
 
     int distributeSortToClusterRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief split a COLLECT on top of a GatherNode into a partial COLLECT on
+/// the DB servers and a COLLECT on the coordinator that merges the partial
+/// results
+////////////////////////////////////////////////////////////////////////////////
+
+    int distributeCollectToClusterRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief try to get rid of a RemoteNode->ScatterNode combination which has
 /// only a SingletonNode and possibly some CalculationNodes as dependencies
@@ -92,6 +92,14 @@ namespace triagens {
           return triagens::rest::Dispatcher::AQL_QUEUE_NAME;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::rest::Job::JobPriority priority () const override {
+          return triagens::rest::Job::HIGH_PRIORITY;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief executes the handler
 ////////////////////////////////////////////////////////////////////////////////
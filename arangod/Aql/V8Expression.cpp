@@ -49,14 +49,17 @@ using namespace triagens::aql;
 
 V8Expression::V8Expression (v8::Isolate* isolate,
                             v8::Handle<v8::Function> func,
+                            v8::Handle<v8::Function> blockFunc,
                             v8::Handle<v8::Object> constantValues,
                             bool isSimple)
   : isolate(isolate),
     _func(),
+    _blockFunc(),
     _constantValues(),
     _isSimple(isSimple) {
 
   _func.Reset(isolate, func);
+  _blockFunc.Reset(isolate, blockFunc);
   _constantValues.Reset(isolate, constantValues);
 }
 
@@ -66,6 +69,7 @@ V8Expression::V8Expression (v8::Isolate* isolate,
 
 V8Expression::~V8Expression () {
   _constantValues.Reset();
+  _blockFunc.Reset();
   _func.Reset();
 }
 
@@ -87,6 +91,80 @@ AqlValue V8Expression::execute (v8::Isolate* isolate,
   size_t const n = vars.size();
   TRI_ASSERT_EXPENSIVE(regs.size() == n); // assert same vector length
 
+  std::vector<v8::Handle<v8::String>> names;
+  names.reserve(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    names.emplace_back(TRI_V8_STD_STRING(vars[i]->name));
+  }
+
+  v8::Handle<v8::Object> values = buildInput(isolate, trx, argv, startPos, vars, regs, names);
+  v8::Handle<v8::Value> result = call(isolate, query, _func, values);
+
+  return toAqlValue(isolate, result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute the expression for all rows of a block
+////////////////////////////////////////////////////////////////////////////////
+
+void V8Expression::executeBlock (v8::Isolate* isolate,
+                                 Query* query,
+                                 triagens::arango::AqlTransaction* trx,
+                                 AqlItemBlock const* argv,
+                                 std::vector<Variable*> const& vars,
+                                 std::vector<RegisterId> const& regs,
+                                 std::vector<AqlValue>& results) {
+  size_t const n = vars.size();
+  TRI_ASSERT_EXPENSIVE(regs.size() == n); // assert same vector length
+
+  // the variable names are the same for all rows
+  std::vector<v8::Handle<v8::String>> names;
+  names.reserve(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    names.emplace_back(TRI_V8_STD_STRING(vars[i]->name));
+  }
+
+  size_t const rows = argv->size();
+  v8::Handle<v8::Array> input = v8::Array::New(isolate, static_cast<int>(rows));
+
+  for (size_t i = 0; i < rows; ++i) {
+    input->Set(static_cast<uint32_t>(i), buildInput(isolate, trx, argv, i, vars, regs, names));
+  }
+
+  v8::Handle<v8::Value> result = call(isolate, query, _blockFunc, input);
+
+  if (! result->IsArray() ||
+      v8::Handle<v8::Array>::Cast(result)->Length() != rows) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid result of v8 block expression");
+  }
+
+  v8::Handle<v8::Array> values = v8::Handle<v8::Array>::Cast(result);
+  results.reserve(results.size() + rows);
+
+  for (size_t i = 0; i < rows; ++i) {
+    // cannot throw as we have reserved enough space
+    results.emplace_back(toAqlValue(isolate, values->Get(static_cast<uint32_t>(i))));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the V8 object with the input variables for a row
+////////////////////////////////////////////////////////////////////////////////
+
+v8::Handle<v8::Object> V8Expression::buildInput (v8::Isolate* isolate,
+                                                 triagens::arango::AqlTransaction* trx,
+                                                 AqlItemBlock const* argv,
+                                                 size_t startPos,
+                                                 std::vector<Variable*> const& vars,
+                                                 std::vector<RegisterId> const& regs,
+                                                 std::vector<v8::Handle<v8::String>> const& names) {
+  size_t const n = vars.size();
   bool const hasRestrictions = ! _attributeRestrictions.empty();
 
   v8::Handle<v8::Object> values = v8::Object::New(isolate);
@@ -101,7 +179,6 @@ AqlValue V8Expression::execute (v8::Isolate* isolate,
     }
     
     auto document = argv->getDocumentCollection(reg);
-    auto const& varname = vars[i]->name;
 
     if (hasRestrictions && value.isJson()) {
       // check if we can get away with constructing a partial JSON object
@@ -109,7 +186,7 @@ AqlValue V8Expression::execute (v8::Isolate* isolate,
 
       if (it != _attributeRestrictions.end()) {
         // build a partial object
-        values->ForceSet(TRI_V8_STD_STRING(varname), value.toV8Partial(isolate, trx, (*it).second, document));
+        values->ForceSet(names[i], value.toV8Partial(isolate, trx, (*it).second, document));
         continue;
       }
     }
@@ -117,11 +194,21 @@ AqlValue V8Expression::execute (v8::Isolate* isolate,
     // fallthrough to building the complete object
 
     // build the regular object
-    values->ForceSet(TRI_V8_STD_STRING(varname), value.toV8(isolate, trx, document));
+    values->ForceSet(names[i], value.toV8(isolate, trx, document));
   }
 
-  TRI_ASSERT(query != nullptr);
+  return values;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief call a compiled function, with the query set as the current query
+////////////////////////////////////////////////////////////////////////////////
 
+v8::Handle<v8::Value> V8Expression::call (v8::Isolate* isolate,
+                                          Query* query,
+                                          v8::Persistent<v8::Function> const& function,
+                                          v8::Handle<v8::Value> values) {
+  TRI_ASSERT(query != nullptr);
 
   TRI_GET_GLOBALS();
     
@@ -165,7 +252,7 @@ AqlValue V8Expression::execute (v8::Isolate* isolate,
     // execute the function
     v8::TryCatch tryCatch;
 
-    auto func = v8::Local<v8::Function>::New(isolate, _func);
+    auto func = v8::Local<v8::Function>::New(isolate, function);
     result = func->Call(func, 2, args);
 
 #ifdef TRI_ENABLE_FAILURE_TESTS
@@ -184,21 +271,34 @@ AqlValue V8Expression::execute (v8::Isolate* isolate,
     throw;
   }
 
-  // no exception was thrown if we get here
-  std::unique_ptr<TRI_json_t> json;
+  return result;
+}
 
-  if (result->IsUndefined()) {
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert the result of the function into an AqlValue
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue V8Expression::toAqlValue (v8::Isolate* isolate,
+                                   v8::Handle<v8::Value> result) const {
+  if (result->IsUndefined() || result->IsNull()) {
     // expression does not have any (defined) value. replace with null
-    json.reset(TRI_CreateNullJson(TRI_UNKNOWN_MEM_ZONE));
+    return AqlValue::CreateNull();
+  }
+  if (result->IsBoolean()) {
+    return AqlValue::CreateBoolean(result->IsTrue());
+  }
+  if (result->IsNumber()) {
+    return AqlValue::CreateNumber(result->ToNumber()->Value());
+  }
+
+  // expression had a result. convert it to JSON
+  std::unique_ptr<TRI_json_t> json;
+
+  if (_isSimple) { 
+    json.reset(TRI_ObjectToJsonSimple(isolate, result));
   }
   else {
-    // expression had a result. convert it to JSON
-    if (_isSimple) { 
-      json.reset(TRI_ObjectToJsonSimple(isolate, result));
-    }
-    else {
-      json.reset(TRI_ObjectToJson(isolate, result));
-    }
+    json.reset(TRI_ObjectToJson(isolate, result));
   }
 
   if (json.get() == nullptr) {
@@ -57,6 +57,7 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
       V8Expression (v8::Isolate*,
+                    v8::Handle<v8::Function>, 
                     v8::Handle<v8::Function>, 
                     v8::Handle<v8::Object>, 
                     bool);
@@ -95,10 +96,61 @@ namespace triagens {
                         std::vector<Variable*> const&,
                         std::vector<RegisterId> const&);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute the expression for all rows of a block
+///
+/// all rows are passed into V8 at once, and the function is called only
+/// once. the results are appended to the result vector, one per row
+////////////////////////////////////////////////////////////////////////////////
+
+      void executeBlock (v8::Isolate* isolate,
+                         Query* query,
+                         triagens::arango::AqlTransaction*,
+                         AqlItemBlock const*,
+                         std::vector<Variable*> const&,
+                         std::vector<RegisterId> const&,
+                         std::vector<AqlValue>&);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+    private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the V8 object with the input variables for a row
+////////////////////////////////////////////////////////////////////////////////
+
+      v8::Handle<v8::Object> buildInput (v8::Isolate* isolate,
+                                         triagens::arango::AqlTransaction*,
+                                         AqlItemBlock const*,
+                                         size_t,
+                                         std::vector<Variable*> const&,
+                                         std::vector<RegisterId> const&,
+                                         std::vector<v8::Handle<v8::String>> const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief call a compiled function, with the query set as the current query
+////////////////////////////////////////////////////////////////////////////////
+
+      v8::Handle<v8::Value> call (v8::Isolate* isolate,
+                                  Query* query,
+                                  v8::Persistent<v8::Function> const&,
+                                  v8::Handle<v8::Value>);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert the result of the function into an AqlValue
+////////////////////////////////////////////////////////////////////////////////
+
+      AqlValue toAqlValue (v8::Isolate* isolate,
+                           v8::Handle<v8::Value>) const;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                  public variables
 // -----------------------------------------------------------------------------
 
+    public:
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the isolate used when executing and destroying the expression
 ////////////////////////////////////////////////////////////////////////////////
@@ -111,6 +163,13 @@ namespace triagens {
 
        v8::Persistent<v8::Function> _func;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the compiled expression as a V8 function that is called with an
+/// array of input rows and returns an array of results
+////////////////////////////////////////////////////////////////////////////////
+
+       v8::Persistent<v8::Function> _blockFunc;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief constants
 ////////////////////////////////////////////////////////////////////////////////
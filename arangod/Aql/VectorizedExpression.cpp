@@ -0,0 +1,642 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, block-at-a-time evaluation of simple predicates
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2015 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014-2015, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/VectorizedExpression.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AttributeAccessor.h"
+#include "Aql/Variable.h"
+#include "Basics/Exceptions.h"
+#include "Basics/json-utilities.h"
+#include "VocBase/document-collection.h"
+#include "VocBase/voc-shaper.h"
+
+using namespace triagens::aql;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief marker for operands that are constants
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const NoColumn = SIZE_MAX;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compare two values, with a fast path for numbers
+////////////////////////////////////////////////////////////////////////////////
+
+static inline int CompareValues (TRI_json_t const* lhs,
+                                 TRI_json_t const* rhs,
+                                 bool useUtf8) {
+  if (lhs->_type == TRI_JSON_NUMBER && rhs->_type == TRI_JSON_NUMBER) {
+    if (lhs->_value._number == rhs->_value._number) {
+      return 0;
+    }
+    return (lhs->_value._number < rhs->_value._number) ? -1 : 1;
+  }
+
+  return TRI_CompareValuesJson(lhs, rhs, useUtf8);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compare the values of two operands for all rows
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+static inline void CompareLoop (TRI_json_t const* const* lhsColumn,
+                                TRI_json_t const* lhsConstant,
+                                TRI_json_t const* const* rhsColumn,
+                                TRI_json_t const* rhsConstant,
+                                bool useUtf8,
+                                size_t n,
+                                uint8_t* out,
+                                T const& predicate) {
+  if (lhsColumn != nullptr && rhsColumn == nullptr) {
+    // column compared to a constant. this is the most common case
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = predicate(CompareValues(lhsColumn[i], rhsConstant, useUtf8)) ? 1 : 0;
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    TRI_json_t const* lhs = (lhsColumn != nullptr) ? lhsColumn[i] : lhsConstant;
+    TRI_json_t const* rhs = (rhsColumn != nullptr) ? rhsColumn[i] : rhsConstant;
+    out[i] = predicate(CompareValues(lhs, rhs, useUtf8)) ? 1 : 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an empty program
+////////////////////////////////////////////////////////////////////////////////
+
+VectorizedExpression::VectorizedExpression ()
+  : _program(),
+    _columns(),
+    _stack(),
+    _ownedJson(),
+    _ownedValues() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the program
+////////////////////////////////////////////////////////////////////////////////
+
+VectorizedExpression::~VectorizedExpression () {
+  freeValues();
+
+  for (auto& it : _columns) {
+    delete it.accessor;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compile an expression into a program
+////////////////////////////////////////////////////////////////////////////////
+
+VectorizedExpression* VectorizedExpression::compile (AstNode const* node,
+                                                     std::vector<Variable*> const& vars,
+                                                     std::vector<RegisterId> const& regs) {
+  std::unique_ptr<VectorizedExpression> program(new VectorizedExpression());
+
+  if (! program->compileNode(node, vars, regs, 0) ||
+      program->_columns.empty()) {
+    // expression not supported
+    return nullptr;
+  }
+
+  return program.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate the program for all rows of the block
+////////////////////////////////////////////////////////////////////////////////
+
+void VectorizedExpression::execute (triagens::arango::AqlTransaction* trx,
+                                    AqlItemBlock const* block,
+                                    std::vector<uint8_t>& selection) {
+  size_t const n = block->size();
+
+  try {
+    for (auto& it : _columns) {
+      extractColumn(trx, block, it);
+    }
+
+    size_t sp = 0;
+
+    for (auto const& instruction : _program) {
+      switch (instruction.opCode) {
+        case OP_COMPARE: {
+          compare(instruction, n, _stack[sp]);
+          ++sp;
+          break;
+        }
+
+        case OP_AND: {
+          TRI_ASSERT(sp >= 2);
+          --sp;
+          uint8_t* lhs = _stack[sp - 1].data();
+          uint8_t const* rhs = _stack[sp].data();
+          for (size_t i = 0; i < n; ++i) {
+            lhs[i] &= rhs[i];
+          }
+          break;
+        }
+
+        case OP_OR: {
+          TRI_ASSERT(sp >= 2);
+          --sp;
+          uint8_t* lhs = _stack[sp - 1].data();
+          uint8_t const* rhs = _stack[sp].data();
+          for (size_t i = 0; i < n; ++i) {
+            lhs[i] |= rhs[i];
+          }
+          break;
+        }
+
+        case OP_NOT: {
+          TRI_ASSERT(sp >= 1);
+          uint8_t* value = _stack[sp - 1].data();
+          for (size_t i = 0; i < n; ++i) {
+            value[i] ^= 1;
+          }
+          break;
+        }
+      }
+    }
+
+    TRI_ASSERT(sp == 1);
+    selection.assign(_stack[0].begin(), _stack[0].begin() + n);
+  }
+  catch (...) {
+    freeValues();
+    throw;
+  }
+
+  freeValues();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compile a node recursively, appending to the program
+////////////////////////////////////////////////////////////////////////////////
+
+bool VectorizedExpression::compileNode (AstNode const* node,
+                                        std::vector<Variable*> const& vars,
+                                        std::vector<RegisterId> const& regs,
+                                        size_t depth) {
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR: {
+      if (! compileNode(node->getMember(0), vars, regs, depth) ||
+          ! compileNode(node->getMember(1), vars, regs, depth + 1)) {
+        return false;
+      }
+
+      Instruction instruction;
+      instruction.opCode = (node->type == NODE_TYPE_OPERATOR_BINARY_AND) ? OP_AND : OP_OR;
+      _program.emplace_back(instruction);
+      return true;
+    }
+
+    case NODE_TYPE_OPERATOR_UNARY_NOT: {
+      if (! compileNode(node->getMember(0), vars, regs, depth)) {
+        return false;
+      }
+
+      Instruction instruction;
+      instruction.opCode = OP_NOT;
+      _program.emplace_back(instruction);
+      return true;
+    }
+
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE: {
+      Instruction instruction;
+      instruction.opCode = OP_COMPARE;
+      instruction.comparison = node->type;
+      // same as in Expression::executeSimpleExpression()
+      instruction.useUtf8 = (node->type != NODE_TYPE_OPERATOR_BINARY_EQ &&
+                             node->type != NODE_TYPE_OPERATOR_BINARY_NE);
+
+      if (! compileOperand(node->getMember(0), vars, regs, instruction.lhs) ||
+          ! compileOperand(node->getMember(1), vars, regs, instruction.rhs)) {
+        return false;
+      }
+
+      if (instruction.lhs.column == NoColumn &&
+          instruction.rhs.column == NoColumn) {
+        // comparison of two constants. should have been optimized away
+        return false;
+      }
+
+      if (_stack.size() <= depth) {
+        _stack.resize(depth + 1);
+      }
+
+      _program.emplace_back(instruction);
+      return true;
+    }
+
+    default: {
+      return false;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compile a comparison operand
+////////////////////////////////////////////////////////////////////////////////
+
+bool VectorizedExpression::compileOperand (AstNode const* node,
+                                           std::vector<Variable*> const& vars,
+                                           std::vector<RegisterId> const& regs,
+                                           Operand& operand) {
+  operand.column = NoColumn;
+  operand.constant = nullptr;
+
+  if (node->isConstant()) {
+    // we do not own the JSON but the node does!
+    operand.constant = node->computeJson();
+    return (operand.constant != nullptr);
+  }
+
+  if (node->type != NODE_TYPE_ATTRIBUTE_ACCESS) {
+    return false;
+  }
+
+  std::vector<char const*> parts{ static_cast<char const*>(node->getData()) };
+  auto member = node->getMember(0);
+
+  while (member->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    parts.insert(parts.begin(), static_cast<char const*>(member->getData()));
+    member = member->getMember(0);
+  }
+
+  if (member->type != NODE_TYPE_REFERENCE) {
+    return false;
+  }
+
+  auto v = static_cast<Variable const*>(member->getData());
+  size_t position = 0;
+
+  while (position < vars.size() && vars[position]->id != v->id) {
+    ++position;
+  }
+
+  if (position == vars.size()) {
+    return false;
+  }
+
+  std::string combinedName;
+
+  for (auto const& it : parts) {
+    if (! combinedName.empty()) {
+      combinedName.push_back('.');
+    }
+    combinedName.append(it);
+  }
+
+  // re-use the column if the same attribute is used more than once
+  for (size_t i = 0; i < _columns.size(); ++i) {
+    if (_columns[i].regs[0] == regs[position] &&
+        _columns[i].combinedName == combinedName) {
+      operand.column = i;
+      return true;
+    }
+  }
+
+  Column column;
+  column.parts = parts;
+  column.combinedName = combinedName;
+  column.vars.emplace_back(vars[position]);
+  column.regs.emplace_back(regs[position]);
+  column.isKey = false;
+  column.accessor = nullptr;
+  column.shaper = nullptr;
+  column.pid = 0;
+
+  if (parts.size() == 1) {
+    char const* n = parts[0];
+
+    if (strcmp(n, TRI_VOC_ATTRIBUTE_KEY) == 0) {
+      column.isKey = true;
+    }
+    else if (strcmp(n, TRI_VOC_ATTRIBUTE_REV) == 0 ||
+             strcmp(n, TRI_VOC_ATTRIBUTE_ID) == 0 ||
+             strcmp(n, TRI_VOC_ATTRIBUTE_FROM) == 0 ||
+             strcmp(n, TRI_VOC_ATTRIBUTE_TO) == 0) {
+      // these attributes are not stored in the shaped data and must be
+      // assembled. leave this to the attribute accessor
+      column.accessor = new AttributeAccessor(parts, v);
+    }
+  }
+
+  try {
+    _columns.emplace_back(column);
+  }
+  catch (...) {
+    delete column.accessor;
+    throw;
+  }
+
+  operand.column = _columns.size() - 1;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract the values of a column for all rows of the block
+////////////////////////////////////////////////////////////////////////////////
+
+void VectorizedExpression::extractColumn (triagens::arango::AqlTransaction* trx,
+                                          AqlItemBlock const* block,
+                                          Column& column) {
+  size_t const n = block->size();
+  RegisterId const reg = column.regs[0];
+  TRI_document_collection_t const* document = block->getDocumentCollection(reg);
+
+  column.scratch.resize(n);
+  column.values.resize(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    AqlValue const& value = block->getValueReference(i, reg);
+    TRI_json_t const* json = nullptr;
+
+    if (value.isShaped()) {
+      json = extractShaped(trx, block, i, value, document, column);
+    }
+    else if (value._type == AqlValue::JSON) {
+      json = value._json->json();
+
+      for (auto const& it : column.parts) {
+        if (! TRI_IsObjectJson(json)) {
+          json = nullptr;
+          break;
+        }
+
+        json = TRI_LookupObjectJson(json, it);
+
+        if (json == nullptr) {
+          break;
+        }
+      }
+    }
+
+    if (json == nullptr) {
+      // attribute not present or value is not a document
+      TRI_InitNullJson(&column.scratch[i]);
+      json = &column.scratch[i];
+    }
+
+    column.values[i] = json;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract an attribute from a ShapedJson marker
+///
+/// scalars and strings are not copied but referenced from the marker. returns
+/// a nullptr if the attribute is not present
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t const* VectorizedExpression::extractShaped (triagens::arango::AqlTransaction* trx,
+                                                       AqlItemBlock const* block,
+                                                       size_t row,
+                                                       AqlValue const& value,
+                                                       TRI_document_collection_t const* document,
+                                                       Column& column) {
+  if (column.accessor != nullptr) {
+    AqlValue result = column.accessor->get(trx, block, row, column.vars, column.regs);
+
+    if (result._type != AqlValue::JSON) {
+      result.destroy();
+      return nullptr;
+    }
+
+    try {
+      _ownedValues.emplace_back(result);
+    }
+    catch (...) {
+      result.destroy();
+      throw;
+    }
+
+    return result._json->json();
+  }
+
+  TRI_json_t* result = &column.scratch[row];
+
+  if (column.isKey) {
+    char const* key = TRI_EXTRACT_MARKER_KEY(value._marker);
+    TRI_InitStringReferenceJson(result, key, strlen(key));
+    return result;
+  }
+
+  TRI_shaper_t* shaper = document->getShaper();
+
+  if (shaper != column.shaper) {
+    column.shaper = shaper;
+    column.pid = shaper->lookupAttributePathByName(shaper, column.combinedName.c_str());
+  }
+
+  if (column.pid == 0) {
+    // attribute does not exist in the collection
+    return nullptr;
+  }
+
+  TRI_shaped_json_t shapedJson;
+  TRI_EXTRACT_SHAPED_JSON_MARKER(shapedJson, value._marker);
+
+  TRI_shaped_json_t json;
+  TRI_shape_t const* shape;
+
+  if (! TRI_ExtractShapedJsonVocShaper(shaper, &shapedJson, 0, column.pid, &json, &shape) ||
+      shape == nullptr) {
+    return nullptr;
+  }
+
+  switch (shape->_type) {
+    case TRI_SHAPE_NULL: {
+      TRI_InitNullJson(result);
+      return result;
+    }
+
+    case TRI_SHAPE_BOOLEAN: {
+      TRI_InitBooleanJson(result, (* (TRI_shape_boolean_t const*) json._data.data) != 0);
+      return result;
+    }
+
+    case TRI_SHAPE_NUMBER: {
+      TRI_InitNumberJson(result, * (TRI_shape_number_t const*) (void const*) json._data.data);
+      return result;
+    }
+
+    case TRI_SHAPE_SHORT_STRING:
+    case TRI_SHAPE_LONG_STRING: {
+      char* data;
+      size_t length;
+      TRI_StringValueShapedJson(shape, json._data.data, &data, &length);
+      TRI_InitStringReferenceJson(result, data, length);
+      return result;
+    }
+
+    default: {
+      // arrays and objects need to be converted
+      _ownedJson.emplace_back(nullptr);
+      _ownedJson.back() = TRI_JsonShapedJson(shaper, &json);
+
+      if (_ownedJson.back() == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
+
+      return _ownedJson.back();
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief run a comparison instruction
+////////////////////////////////////////////////////////////////////////////////
+
+void VectorizedExpression::compare (Instruction const& instruction,
+                                    size_t n,
+                                    std::vector<uint8_t>& result) const {
+  result.resize(n);
+
+  TRI_json_t const* const* lhsColumn = nullptr;
+  TRI_json_t const* const* rhsColumn = nullptr;
+
+  if (instruction.lhs.column != NoColumn) {
+    lhsColumn = _columns[instruction.lhs.column].values.data();
+  }
+  if (instruction.rhs.column != NoColumn) {
+    rhsColumn = _columns[instruction.rhs.column].values.data();
+  }
+
+  TRI_json_t const* lhsConstant = instruction.lhs.constant;
+  TRI_json_t const* rhsConstant = instruction.rhs.constant;
+  bool const useUtf8 = instruction.useUtf8;
+  uint8_t* out = result.data();
+
+  if (lhsColumn == nullptr) {
+    // swap the operands so the column is on the left-hand side
+    std::swap(lhsColumn, rhsColumn);
+    std::swap(lhsConstant, rhsConstant);
+
+    switch (instruction.comparison) {
+      case NODE_TYPE_OPERATOR_BINARY_EQ:
+        CompareLoop(lhsColumn, lhsConstant, rhsColumn, rhsConstant, useUtf8, n, out, [] (int cmp) { return cmp == 0; });
+        return;
+      case NODE_TYPE_OPERATOR_BINARY_NE:
+        CompareLoop(lhsColumn, lhsConstant, rhsColumn, rhsConstant, useUtf8, n, out, [] (int cmp) { return cmp != 0; });
+        return;
+      case NODE_TYPE_OPERATOR_BINARY_LT:
+        CompareLoop(lhsColumn, lhsConstant, rhsColumn, rhsConstant, useUtf8, n, out, [] (int cmp) { return cmp > 0; });
+        return;
+      case NODE_TYPE_OPERATOR_BINARY_LE:
+        CompareLoop(lhsColumn, lhsConstant, rhsColumn, rhsConstant, useUtf8, n, out, [] (int cmp) { return cmp >= 0; });
+        return;
+      case NODE_TYPE_OPERATOR_BINARY_GT:
+        CompareLoop(lhsColumn, lhsConstant, rhsColumn, rhsConstant, useUtf8, n, out, [] (int cmp) { return cmp < 0; });
+        return;
+      case NODE_TYPE_OPERATOR_BINARY_GE:
+        CompareLoop(lhsColumn, lhsConstant, rhsColumn, rhsConstant, useUtf8, n, out, [] (int cmp) { return cmp <= 0; });
+        return;
+      default:
+        break;
+    }
+  }
+  else {
+    switch (instruction.comparison) {
+      case NODE_TYPE_OPERATOR_BINARY_EQ:
+        CompareLoop(lhsColumn, lhsConstant, rhsColumn, rhsConstant, useUtf8, n, out, [] (int cmp) { return cmp == 0; });
+        return;
+      case NODE_TYPE_OPERATOR_BINARY_NE:
+        CompareLoop(lhsColumn, lhsConstant, rhsColumn, rhsConstant, useUtf8, n, out, [] (int cmp) { return cmp != 0; });
+        return;
+      case NODE_TYPE_OPERATOR_BINARY_LT:
+        CompareLoop(lhsColumn, lhsConstant, rhsColumn, rhsConstant, useUtf8, n, out, [] (int cmp) { return cmp < 0; });
+        return;
+      case NODE_TYPE_OPERATOR_BINARY_LE:
+        CompareLoop(lhsColumn, lhsConstant, rhsColumn, rhsConstant, useUtf8, n, out, [] (int cmp) { return cmp <= 0; });
+        return;
+      case NODE_TYPE_OPERATOR_BINARY_GT:
+        CompareLoop(lhsColumn, lhsConstant, rhsColumn, rhsConstant, useUtf8, n, out, [] (int cmp) { return cmp > 0; });
+        return;
+      case NODE_TYPE_OPERATOR_BINARY_GE:
+        CompareLoop(lhsColumn, lhsConstant, rhsColumn, rhsConstant, useUtf8, n, out, [] (int cmp) { return cmp >= 0; });
+        return;
+      default:
+        break;
+    }
+  }
+
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid comparison in vectorized expression");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief free the values that were created while extracting columns
+////////////////////////////////////////////////////////////////////////////////
+
+void VectorizedExpression::freeValues () {
+  for (auto& it : _ownedJson) {
+    if (it != nullptr) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it);
+    }
+  }
+  _ownedJson.clear();
+
+  for (auto& it : _ownedValues) {
+    it.destroy();
+  }
+  _ownedValues.clear();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
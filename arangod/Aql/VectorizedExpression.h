@@ -0,0 +1,268 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, block-at-a-time evaluation of simple predicates
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2015 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014-2015, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_VECTORIZED_EXPRESSION_H
+#define ARANGODB_AQL_VECTORIZED_EXPRESSION_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+#include "Aql/AstNode.h"
+#include "Aql/types.h"
+#include "Basics/json.h"
+#include "ShapedJson/shaped-json.h"
+#include "Utils/AqlTransaction.h"
+
+struct TRI_document_collection_t;
+struct TRI_shaper_s;
+
+namespace triagens {
+  namespace aql {
+
+    class AqlItemBlock;
+    class AttributeAccessor;
+    struct Variable;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                    class VectorizedExpression
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a predicate compiled into a flat program that is evaluated for all
+/// rows of an AqlItemBlock at once
+///
+/// The program supports comparisons (==, !=, <, <=, >, >=) between attribute
+/// accesses and constants or other attribute accesses, combined with &&, ||
+/// and !. Each attribute used in the predicate is extracted once per block
+/// into a column, and each comparison then runs in a tight loop over the
+/// column, producing a selection bitmap with one entry per row.
+////////////////////////////////////////////////////////////////////////////////
+
+    class VectorizedExpression {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     private types
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief instruction types
+////////////////////////////////////////////////////////////////////////////////
+
+        enum OpCode {
+          OP_COMPARE,
+          OP_AND,
+          OP_OR,
+          OP_NOT
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a comparison operand, either a column or a constant
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Operand {
+          size_t column;
+          TRI_json_t const* constant;
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a single instruction of the program
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Instruction {
+          OpCode opCode;
+          AstNodeType comparison;
+          bool useUtf8;
+          Operand lhs;
+          Operand rhs;
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief an attribute that is extracted for all rows of a block
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Column {
+          std::vector<char const*> parts;
+          std::string combinedName;
+          std::vector<Variable*> vars;
+          std::vector<RegisterId> regs;
+          bool isKey;
+          AttributeAccessor* accessor;
+          struct TRI_shaper_s* shaper;
+          TRI_shape_pid_t pid;
+          std::vector<TRI_json_t> scratch;
+          std::vector<TRI_json_t const*> values;
+        };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      private:
+
+        VectorizedExpression ();
+
+      public:
+
+        ~VectorizedExpression ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compile an expression into a program
+///
+/// returns a nullptr if the expression is not supported, the caller must
+/// then fall back to row-by-row evaluation
+////////////////////////////////////////////////////////////////////////////////
+
+        static VectorizedExpression* compile (AstNode const*,
+                                              std::vector<Variable*> const&,
+                                              std::vector<RegisterId> const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate the program for all rows of the block
+///
+/// the selection bitmap will contain one entry per row, which is 1 if the
+/// predicate is true for the row and 0 otherwise
+////////////////////////////////////////////////////////////////////////////////
+
+        void execute (triagens::arango::AqlTransaction*,
+                      AqlItemBlock const*,
+                      std::vector<uint8_t>&);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compile a node recursively, appending to the program
+////////////////////////////////////////////////////////////////////////////////
+
+        bool compileNode (AstNode const*,
+                          std::vector<Variable*> const&,
+                          std::vector<RegisterId> const&,
+                          size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compile a comparison operand
+////////////////////////////////////////////////////////////////////////////////
+
+        bool compileOperand (AstNode const*,
+                             std::vector<Variable*> const&,
+                             std::vector<RegisterId> const&,
+                             Operand&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract the values of a column for all rows of the block
+////////////////////////////////////////////////////////////////////////////////
+
+        void extractColumn (triagens::arango::AqlTransaction*,
+                            AqlItemBlock const*,
+                            Column&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract an attribute from a ShapedJson marker
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_json_t const* extractShaped (triagens::arango::AqlTransaction*,
+                                         AqlItemBlock const*,
+                                         size_t,
+                                         AqlValue const&,
+                                         struct TRI_document_collection_t const*,
+                                         Column&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief run a comparison instruction
+////////////////////////////////////////////////////////////////////////////////
+
+        void compare (Instruction const&,
+                      size_t,
+                      std::vector<uint8_t>&) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief free the values that were created while extracting columns
+////////////////////////////////////////////////////////////////////////////////
+
+        void freeValues ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the program, in postfix order
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Instruction> _program;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the columns used by the program
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Column> _columns;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the bitmap stack used when running the program
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::vector<uint8_t>> _stack;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief values created while extracting columns from ShapedJson
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<TRI_json_t*> _ownedJson;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief values created by attribute accessors
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<AqlValue> _ownedValues;
+
+    };
+
+  }  // namespace triagens::aql
+}  // namespace triagens
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
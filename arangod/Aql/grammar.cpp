@@ -77,11 +77,12 @@
 #include <Basics/conversions.h>
 #include <Basics/tri-strings.h>
 
+#include "Aql/Aggregator.h"
 #include "Aql/AstNode.h"
 #include "Aql/Function.h"
 #include "Aql/Parser.h"
 
-#line 85 "arangod/Aql/grammar.cpp" /* yacc.c:339  */
+#line 86 "arangod/Aql/grammar.cpp" /* yacc.c:339  */
 
 # ifndef YY_NULLPTR
 #  if defined __cplusplus && 201103L <= __cplusplus
@@ -183,14 +184,14 @@ extern int Aqldebug;
 typedef union YYSTYPE YYSTYPE;
 union YYSTYPE
 {
-#line 22 "arangod/Aql/grammar.y" /* yacc.c:355  */
+#line 23 "arangod/Aql/grammar.y" /* yacc.c:355  */
 
   triagens::aql::AstNode*  node;
   char*                    strval;
   bool                     boolval;
   int64_t                  intval;
 
-#line 194 "arangod/Aql/grammar.cpp" /* yacc.c:355  */
+#line 195 "arangod/Aql/grammar.cpp" /* yacc.c:355  */
 };
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
@@ -217,7 +218,7 @@ int Aqlparse (triagens::aql::Parser* parser);
 #endif /* !YY_AQL_ARANGOD_AQL_GRAMMAR_HPP_INCLUDED  */
 
 /* Copy the second part of user declarations.  */
-#line 29 "arangod/Aql/grammar.y" /* yacc.c:358  */
+#line 30 "arangod/Aql/grammar.y" /* yacc.c:358  */
 
 
 using namespace triagens::aql;
@@ -248,10 +249,104 @@ void Aqlerror (YYLTYPE* locp,
   parser->registerError(TRI_ERROR_OUT_OF_MEMORY);   \
   YYABORT;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief start a new scope for the variables introduced by COLLECT, returns
+/// whether the variables of the COLLECT need to be registered in it
+////////////////////////////////////////////////////////////////////////////////
+
+static bool StartCollectScope (triagens::aql::Scopes* scopes) {
+  // check if we are in the main scope
+  if (scopes->type() == triagens::aql::AQL_SCOPE_MAIN) {
+    return false;
+  } 
+
+  // end the active scopes
+  scopes->endNested();
+  // start a new scope
+  scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register the variables of a list of assignments in the current scope
+////////////////////////////////////////////////////////////////////////////////
+
+static void RegisterAssignVariables (triagens::aql::Scopes* scopes, 
+                                     AstNode const* vars) {
+  size_t const n = vars->numMembers();
+  for (size_t i = 0; i < n; ++i) {
+    auto member = vars->getMember(i);
+
+    if (member != nullptr) {
+      TRI_ASSERT(member->type == NODE_TYPE_ASSIGN);
+      auto v = static_cast<Variable*>(member->getMember(0)->getData());
+      scopes->addVariable(v);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief validate the aggregate expressions of COLLECT ... AGGREGATE
+/// each expression must be a call of a supported aggregate function with a
+/// single argument, which must not refer to variables introduced by the
+/// same COLLECT
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ValidateAggregates (triagens::aql::Parser* parser,
+                                AstNode const* groups,
+                                AstNode const* aggregates,
+                                YYLTYPE const& loc) {
+  std::unordered_set<Variable*> collectVariables;
+  for (auto const& list : { groups, aggregates }) {
+    size_t const n = list->numMembers();
+    for (size_t i = 0; i < n; ++i) {
+      auto member = list->getMember(i);
+      if (member != nullptr) {
+        collectVariables.emplace(static_cast<Variable*>(member->getMember(0)->getData()));
+      }
+    }
+  }
+
+  size_t const n = aggregates->numMembers();
+  for (size_t i = 0; i < n; ++i) {
+    auto member = aggregates->getMember(i);
+
+    if (member == nullptr) {
+      continue;
+    }
+    
+    auto func = member->getMember(1);
+    if (func->type != NODE_TYPE_FCALL) {
+      parser->registerParseError(TRI_ERROR_QUERY_PARSE, "aggregate expression must be a function call", loc.first_line, loc.first_column);
+      return false;
+    }
+
+    auto f = static_cast<triagens::aql::Function*>(func->getData());
+    if (! Aggregator::isSupported(f->externalName)) {
+      parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unsupported aggregate function '%s'", f->externalName.c_str(), loc.first_line, loc.first_column);
+      return false;
+    }
+
+    if (func->getMember(0)->numMembers() != 1) {
+      parser->registerParseError(TRI_ERROR_QUERY_PARSE, "aggregate function '%s' must be called with exactly one argument", f->externalName.c_str(), loc.first_line, loc.first_column);
+      return false;
+    }
+
+    for (auto const& v : Ast::getReferencedVariables(func)) {
+      if (collectVariables.find(v) != collectVariables.end()) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "aggregate expression must not refer to variable '%s' introduced in the same COLLECT", v->name.c_str(), loc.first_line, loc.first_column);
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 #define scanner parser->scanner()
 
 
-#line 255 "arangod/Aql/grammar.cpp" /* yacc.c:358  */
+#line 350 "arangod/Aql/grammar.cpp" /* yacc.c:358  */
 
 #ifdef short
 # undef short
@@ -495,16 +590,16 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  3
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   784
+#define YYLAST   794
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  62
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  74
+#define YYNNTS  76
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  160
+#define YYNRULES  165
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  274
+#define YYNSTATES  284
 
 /* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
    by yylex, with out-of-bounds checking.  */
@@ -556,23 +651,23 @@ static const yytype_uint8 yytranslate[] =
   /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint16 yyrline[] =
 {
-       0,   204,   204,   206,   208,   210,   212,   214,   219,   221,
-     226,   230,   236,   238,   243,   245,   247,   249,   251,   253,
-     258,   267,   275,   280,   282,   287,   294,   304,   304,   318,
-     334,   361,   388,   420,   450,   452,   457,   464,   467,   473,
-     487,   504,   504,   518,   518,   529,   532,   538,   544,   547,
-     550,   553,   559,   564,   571,   579,   582,   588,   599,   610,
-     619,   631,   636,   645,   657,   662,   665,   671,   671,   723,
-     726,   729,   732,   735,   738,   744,   751,   768,   768,   780,
-     783,   786,   792,   795,   798,   801,   804,   807,   810,   813,
-     816,   819,   822,   825,   828,   831,   834,   840,   846,   848,
-     853,   856,   856,   875,   878,   884,   887,   893,   893,   902,
-     904,   909,   912,   918,   921,   935,   935,   944,   946,   951,
-     953,   958,   961,   964,   979,   982,   988,   991,   997,  1000,
-    1003,  1009,  1012,  1018,  1060,  1063,  1066,  1073,  1083,  1083,
-    1099,  1114,  1128,  1142,  1142,  1186,  1189,  1195,  1202,  1212,
-    1215,  1218,  1221,  1224,  1230,  1237,  1244,  1258,  1264,  1271,
-    1280
+       0,   301,   301,   303,   305,   307,   309,   311,   316,   318,
+     323,   327,   333,   335,   340,   342,   344,   346,   348,   350,
+     355,   364,   372,   377,   379,   384,   391,   401,   408,   419,
+     425,   435,   455,   475,   485,   500,   513,   515,   520,   527,
+     530,   536,   550,   567,   575,   586,   601,   603,   608,   608,
+     619,   622,   628,   634,   637,   640,   643,   649,   654,   661,
+     669,   672,   678,   689,   700,   709,   721,   726,   735,   747,
+     752,   755,   761,   761,   813,   816,   819,   822,   825,   828,
+     834,   841,   858,   858,   870,   873,   876,   882,   885,   888,
+     891,   894,   897,   900,   903,   906,   909,   912,   915,   918,
+     921,   924,   930,   936,   938,   943,   946,   946,   965,   968,
+     974,   977,   983,   983,   992,   994,   999,  1002,  1008,  1011,
+    1025,  1025,  1034,  1036,  1041,  1043,  1048,  1051,  1054,  1069,
+    1072,  1078,  1081,  1087,  1090,  1093,  1099,  1102,  1108,  1150,
+    1153,  1156,  1163,  1173,  1173,  1189,  1204,  1218,  1232,  1232,
+    1276,  1279,  1285,  1292,  1302,  1305,  1308,  1311,  1314,  1320,
+    1327,  1334,  1348,  1354,  1361,  1370
 };
 #endif
 
@@ -601,22 +696,23 @@ static const char *const yytname[] =
   "optional_post_modification_block",
   "optional_statement_block_statements", "statement_block_statement",
   "for_statement", "filter_statement", "let_statement", "let_list",
-  "let_element", "count_into", "collect_variable_list", "$@1",
+  "let_element", "count_into", "collect_start", "collect_variable_list",
   "collect_statement", "collect_list", "collect_element", "optional_into",
-  "variable_list", "keep", "$@2", "sort_statement", "$@3", "sort_list",
-  "sort_element", "sort_direction", "limit_statement", "return_statement",
+  "variable_list", "collect_qualifier", "keep", "aggregate",
+  "aggregate_list", "sort_statement", "$@1", "sort_list", "sort_element",
+  "sort_direction", "limit_statement", "return_statement",
   "in_or_into_collection", "remove_statement", "insert_statement",
   "update_parameters", "update_statement", "replace_parameters",
-  "replace_statement", "update_or_replace", "upsert_statement", "$@4",
-  "expression", "function_name", "function_call", "$@5", "operator_unary",
+  "replace_statement", "update_or_replace", "upsert_statement", "$@2",
+  "expression", "function_name", "function_call", "$@3", "operator_unary",
   "operator_binary", "operator_ternary",
-  "optional_function_call_arguments", "expression_or_query", "$@6",
-  "function_arguments_list", "compound_value", "array", "$@7",
+  "optional_function_call_arguments", "expression_or_query", "$@4",
+  "function_arguments_list", "compound_value", "array", "$@5",
   "optional_array_elements", "array_elements_list", "options", "object",
-  "$@8", "optional_object_elements", "object_elements_list",
+  "$@6", "optional_object_elements", "object_elements_list",
   "object_element", "array_filter_operator", "optional_array_filter",
-  "optional_array_limit", "optional_array_return", "reference", "$@9",
-  "$@10", "simple_value", "numeric_value", "value_literal",
+  "optional_array_limit", "optional_array_return", "reference", "$@7",
+  "$@8", "simple_value", "numeric_value", "value_literal",
   "collection_name", "bind_parameter", "object_element_name",
   "variable_name", YY_NULLPTR
 };
@@ -637,12 +733,12 @@ static const yytype_uint16 yytoknum[] =
 };
 # endif
 
-#define YYPACT_NINF -109
+#define YYPACT_NINF -105
 
 #define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-109)))
+  (!!((Yystate) == (-105)))
 
-#define YYTABLE_NINF -157
+#define YYTABLE_NINF -166
 
 #define yytable_value_is_error(Yytable_value) \
   0
@@ -651,34 +747,35 @@ static const yytype_uint16 yytoknum[] =
      STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-    -109,    12,   673,  -109,   -19,   -19,   712,   712,    14,  -109,
-     170,   712,   712,   712,   712,  -109,  -109,  -109,  -109,  -109,
-       9,  -109,  -109,  -109,  -109,    75,    75,    75,    75,    75,
-    -109,    24,     0,  -109,    16,  -109,  -109,  -109,    -2,  -109,
-    -109,  -109,  -109,   712,   712,   712,   712,  -109,  -109,   604,
-       7,  -109,  -109,  -109,  -109,  -109,  -109,  -109,   -26,  -109,
-    -109,  -109,   604,    64,    65,   -19,   712,    44,  -109,  -109,
-     475,   475,  -109,   375,  -109,   410,   712,   -19,    65,    84,
-     104,  -109,  -109,  -109,  -109,  -109,   712,   -19,   712,    83,
-      83,    83,   267,  -109,    -3,   712,   712,   101,   712,   712,
-     712,   712,   712,   712,   712,   712,   712,   712,   712,   712,
-     712,   712,   712,    91,    68,   646,    -8,   105,    72,  -109,
-      71,  -109,    98,    76,  -109,   307,   170,   732,    18,    65,
-      65,   712,    65,   712,    65,   507,   100,  -109,    72,    65,
-    -109,  -109,  -109,   604,  -109,   604,  -109,    90,  -109,  -109,
-     102,   712,    93,   106,  -109,   108,   604,    89,   114,   391,
-     712,    21,   619,   128,   128,   109,   109,   109,   109,    95,
-      95,    83,    83,    83,   539,   147,  -109,   679,  -109,   186,
-     137,  -109,  -109,   -19,  -109,   -19,   712,   712,  -109,  -109,
-    -109,  -109,  -109,   111,    25,    28,  -109,  -109,  -109,  -109,
-    -109,  -109,  -109,   475,  -109,   475,  -109,   712,   712,   -19,
-    -109,  -109,   712,   235,  -109,    -3,   712,  -109,   712,   391,
-     712,   604,   129,  -109,  -109,   132,  -109,  -109,   176,  -109,
-    -109,   604,  -109,    65,    65,   442,   572,   136,  -109,   604,
-     149,  -109,   604,   604,   604,  -109,  -109,   712,   712,   190,
-    -109,  -109,  -109,  -109,   712,  -109,   -19,   712,  -109,   604,
-     712,   197,   475,  -109,   604,   339,   712,   151,    65,   712,
-     604,  -109,  -109,   604
+    -105,    37,   683,  -105,    25,    25,   722,   722,    39,  -105,
+     275,   722,   722,   722,   722,  -105,  -105,  -105,  -105,  -105,
+      38,     9,  -105,  -105,  -105,  -105,    56,    56,    56,    56,
+      56,  -105,     5,    26,  -105,    57,  -105,  -105,  -105,   -13,
+    -105,  -105,  -105,  -105,   722,   722,   722,   722,  -105,  -105,
+     614,    42,  -105,  -105,  -105,  -105,  -105,  -105,  -105,   -40,
+    -105,  -105,  -105,   614,    61,    66,   722,    43,  -105,  -105,
+     485,   485,  -105,   385,  -105,   420,   722,    65,    50,  -105,
+      25,    66,    85,    25,    66,    91,    74,  -105,  -105,  -105,
+    -105,  -105,   722,    25,   722,    92,    92,    92,   277,  -105,
+       2,   722,   722,   108,   722,   722,   722,   722,   722,   722,
+     722,   722,   722,   722,   722,   722,   722,   722,   722,    99,
+      77,   656,     1,   113,    81,  -105,    96,  -105,   317,   275,
+     742,    20,    66,    66,   722,    66,   722,    66,   517,    25,
+    -105,    97,  -105,   722,   122,  -105,    81,    25,    66,    66,
+    -105,  -105,  -105,   614,  -105,   614,  -105,    87,  -105,  -105,
+     109,   722,   101,   107,  -105,   112,   614,   104,   114,   158,
+     722,   134,   629,   401,   401,    17,    17,    17,    17,   118,
+     118,    92,    92,    92,   549,   100,  -105,   689,  -105,   202,
+     125,  -105,  -105,    25,  -105,   722,  -105,  -105,  -105,  -105,
+    -105,    27,    30,    45,  -105,  -105,  -105,  -105,  -105,  -105,
+    -105,   485,  -105,   485,  -105,   722,  -105,    25,   614,   722,
+     115,    85,  -105,  -105,  -105,   722,   245,  -105,     2,   722,
+    -105,   722,   158,   722,   614,   128,  -105,  -105,   136,  -105,
+    -105,   179,  -105,  -105,    66,    66,   452,  -105,   582,    25,
+     614,   141,  -105,   614,   614,   614,  -105,  -105,   722,   722,
+     177,  -105,  -105,  -105,  -105,   722,  -105,  -105,   722,  -105,
+     614,   722,   182,   485,   614,   349,   722,   137,    66,   722,
+     614,  -105,  -105,   614
 };
 
   /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -686,60 +783,61 @@ static const yytype_int16 yypact[] =
      means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
-      12,     0,     0,     1,     0,     0,     0,     0,    27,    43,
-       0,     0,     0,     0,     0,    67,    13,    14,    16,    15,
-      37,    17,    18,    19,     2,    10,    10,    10,    10,    10,
-     160,     0,    22,    23,     0,   151,   152,   153,   133,   149,
-     147,   148,   157,     0,     0,     0,   138,   115,   107,    21,
-      77,   136,    69,    70,    71,   134,   105,   106,    73,   150,
-      72,   135,    54,     0,   113,     0,     0,    52,   145,   146,
-       0,     0,    61,     0,    64,     0,     0,     0,   113,   113,
-       0,     3,     4,     5,     6,     7,     0,     0,     0,    81,
-      79,    80,     0,    12,   117,   109,     0,     0,     0,     0,
+      12,     0,     0,     1,     0,     0,     0,     0,    27,    48,
+       0,     0,     0,     0,     0,    72,    13,    14,    16,    15,
+       0,    39,    17,    18,    19,     2,    10,    10,    10,    10,
+      10,   165,     0,    22,    23,     0,   156,   157,   158,   138,
+     154,   152,   153,   162,     0,     0,     0,   143,   120,   112,
+      21,    82,   141,    74,    75,    76,   139,   110,   111,    78,
+     155,    77,   140,    59,     0,   118,     0,    57,   150,   151,
+       0,     0,    66,     0,    69,     0,     0,    43,    28,    36,
+       0,   118,     0,     0,   118,   118,     0,     3,     4,     5,
+       6,     7,     0,     0,     0,    86,    84,    85,     0,    12,
+     122,   114,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,    29,
-      28,    34,     0,    44,    45,    48,     0,     0,     0,   113,
-     113,     0,   113,     0,   113,     0,    38,    30,    41,   113,
-      31,     9,    11,    20,    24,    25,   137,     0,   158,   159,
-       0,     0,     0,   118,   119,     0,   111,     0,   110,    95,
-       0,    83,    82,    89,    90,    91,    92,    93,    94,    84,
-      85,    86,    87,    88,     0,    74,    76,   101,   124,     0,
-     143,   140,   141,     0,   114,     0,     0,     0,    49,    50,
-      47,    51,    53,   133,   149,   157,    55,   154,   155,   156,
-      56,    57,    58,     0,    59,     0,    62,     0,     0,     0,
-      32,   139,     0,     0,   116,     0,     0,   108,     0,    96,
-       0,   100,     0,   103,    12,    99,   142,   125,   126,    26,
-      35,    36,    46,   113,   113,     0,   113,    42,    39,   123,
-       0,   120,   121,   112,    97,    78,   102,   101,     0,   128,
-      60,    63,    65,    66,     0,    33,     0,     0,   104,   127,
-       0,   131,     0,    40,   122,   129,     0,     0,   113,     0,
-     132,   144,    68,   130
+       0,     0,     0,     0,     0,    29,    49,    50,    53,     0,
+       0,     0,   118,   118,     0,   118,     0,   118,     0,     0,
+      46,    45,    31,     0,    40,    30,    43,     0,   118,   118,
+      33,     9,    11,    20,    24,    25,   142,     0,   163,   164,
+       0,     0,     0,   123,   124,     0,   116,     0,   115,   100,
+       0,    88,    87,    94,    95,    96,    97,    98,    99,    89,
+      90,    91,    92,    93,     0,    79,    81,   106,   129,     0,
+     148,   145,   146,     0,   119,     0,    54,    55,    52,    56,
+      58,   138,   154,   162,    60,   159,   160,   161,    61,    62,
+      63,     0,    64,     0,    67,     0,    37,     0,    38,     0,
+      44,    41,    34,    32,   144,     0,     0,   121,     0,     0,
+     113,     0,   101,     0,   105,     0,   108,    12,   104,   147,
+     130,   131,    26,    51,   118,   118,     0,    47,   118,     0,
+     128,     0,   125,   126,   117,   102,    83,   107,   106,     0,
+     133,    65,    68,    70,    71,     0,    35,    42,     0,   109,
+     132,     0,   136,     0,   127,   134,     0,     0,   118,     0,
+     137,   149,    73,   135
 };
 
   /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -109,   -91,  -109,    57,  -109,  -109,  -109,  -109,   125,  -109,
-     122,   191,  -109,  -109,  -109,  -109,    45,  -109,  -109,  -109,
-    -109,  -109,  -109,  -109,    26,  -109,  -109,   153,   -62,  -109,
-    -109,  -109,  -109,  -109,  -109,  -109,  -109,  -109,    -6,  -109,
-    -109,  -109,  -109,  -109,  -109,  -109,   -16,  -109,  -109,  -109,
-    -109,  -109,  -109,  -109,   -61,  -108,  -109,  -109,  -109,    19,
-    -109,  -109,  -109,  -109,  -109,  -109,  -109,   -60,  -109,     6,
-     107,     4,  -109,    -1
+    -105,   -89,  -105,    89,  -105,  -105,  -105,  -105,   103,  -105,
+     110,   181,  -105,  -105,  -105,  -105,   -16,  -105,  -105,   120,
+    -105,   121,  -105,  -105,  -105,  -105,    12,  -105,  -105,   124,
+     -62,  -105,  -105,  -105,  -105,  -105,  -105,  -105,  -105,  -105,
+      -6,  -105,  -105,  -105,  -105,  -105,  -105,  -105,   -50,  -105,
+    -105,  -105,  -105,  -105,  -105,  -105,   -66,  -104,  -105,  -105,
+    -105,   -12,  -105,  -105,  -105,  -105,  -105,  -105,  -105,   -64,
+    -105,     6,    84,     4,  -105,    -2
 };
 
   /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int16 yydefgoto[] =
 {
-      -1,     1,    80,    81,     2,    16,    17,    18,    19,    32,
-      33,    64,    20,    65,    21,   120,   121,    79,   237,   139,
-     209,    22,    66,   123,   124,   190,    23,    24,   129,    25,
-      26,    72,    27,    74,    28,   254,    29,    76,   125,    50,
-      51,   114,    52,    53,    54,   222,   223,   224,   225,    55,
-      56,    95,   157,   158,   119,    57,    94,   152,   153,   154,
-     180,   249,   261,   267,    58,    93,   228,    67,    59,    60,
-     196,    61,   155,    34
+      -1,     1,    86,    87,     2,    16,    17,    18,    19,    33,
+      34,    65,    20,    21,    22,    78,   140,    85,   220,    80,
+     148,    81,   141,    23,    66,   126,   127,   198,    24,    25,
+     132,    26,    27,    72,    28,    74,    29,   265,    30,    76,
+     128,    51,    52,   120,    53,    54,    55,   235,   236,   237,
+     238,    56,    57,   101,   167,   168,   125,    58,   100,   162,
+     163,   164,   190,   260,   272,   277,    59,    99,   241,    67,
+      60,    61,   204,    62,   165,    82
 };
 
   /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
@@ -747,119 +845,121 @@ static const yytype_int16 yydefgoto[] =
      number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      49,    62,   147,    31,    30,    70,    71,    73,    75,   130,
-     184,   132,     3,   134,    69,   181,    68,   137,   140,    42,
-     148,   149,    63,    77,   150,  -155,   115,    63,  -156,  -155,
-     184,  -155,  -156,    96,  -156,   116,    86,    89,    90,    91,
-      92,   197,   198,   -75,    88,   199,   -75,    87,  -155,   151,
-      97,  -156,   113,   100,   101,   102,   103,   104,   105,   106,
-     107,   108,   109,   110,   122,   191,   192,   112,   201,   202,
-     135,   204,  -155,   206,  -155,  -156,   136,  -156,   210,    -8,
-     143,    -8,   145,    82,    83,    84,    85,   117,   118,   156,
-     159,   126,   161,   162,   163,   164,   165,   166,   167,   168,
-     169,   170,   171,   172,   173,   174,   175,   138,     5,   179,
-       7,  -154,    97,   160,   176,  -154,   177,  -154,   185,   183,
-     182,   159,    47,   187,    97,   203,   186,   205,   208,    69,
-      69,    68,    68,   246,  -154,   108,   109,   110,    97,   211,
-      96,   233,   217,   234,   214,   213,   212,   106,   107,   108,
-     109,   110,   216,   215,   219,   112,   -75,    97,  -154,   -75,
-    -154,   218,   102,   103,   104,   105,   106,   107,   108,   109,
-     110,   221,   250,   251,   112,   255,    97,   227,   245,   247,
-     231,   248,   229,   256,   122,   106,   107,   108,   109,   110,
-      35,    36,    37,   257,    39,    40,    41,    42,    96,   260,
-     268,   235,   236,   266,   271,   141,   239,   272,   238,   144,
-     242,    78,   243,   232,   244,    97,    98,    99,   100,   101,
-     102,   103,   104,   105,   106,   107,   108,   109,   110,   111,
-     230,   258,   112,   142,   241,   200,     0,     0,     0,   226,
-       0,   221,   259,     0,     0,     0,     0,    96,   262,     0,
-       0,   264,     0,     0,   265,   263,     0,     0,     0,     0,
-     270,     0,     0,   273,    97,    98,    99,   100,   101,   102,
-     103,   104,   105,   106,   107,   108,   109,   110,   111,    96,
-       0,   112,     0,     0,     0,     0,     0,     0,   240,     0,
-       0,     0,     0,     0,     0,     0,    97,    98,    99,   100,
-     101,   102,   103,   104,   105,   106,   107,   108,   109,   110,
-     111,     0,     0,   112,     0,     0,   146,   188,   189,    96,
-       0,     0,     0,     0,     0,     0,     0,    35,    36,    37,
-       0,    39,    40,    41,    42,     0,    97,    98,    99,   100,
-     101,   102,   103,   104,   105,   106,   107,   108,   109,   110,
-     111,    96,     0,   112,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,    97,    98,
-      99,   100,   101,   102,   103,   104,   105,   106,   107,   108,
-     109,   110,   111,     0,     0,   112,   269,   127,   131,   128,
+      50,    63,    32,    35,    79,    70,    71,    73,    75,   133,
+     157,   135,   121,   137,    69,   142,    68,    92,   145,   150,
+     194,   122,    64,    83,   191,   158,   159,  -159,    43,   160,
+    -160,  -159,   -80,  -159,  -160,   -80,  -160,     3,    95,    96,
+      97,    98,   194,   205,   206,  -161,   103,   207,    31,  -161,
+    -159,  -161,    64,  -160,   161,   112,   113,   114,   115,   116,
+      -8,    77,    -8,   118,   199,   200,   209,   210,  -161,   212,
+     138,   214,   -80,    93,  -159,   -80,  -159,  -160,     5,  -160,
+       7,   144,   222,   223,   123,    94,   153,   119,   155,   124,
+     129,    35,  -161,  -165,  -161,   166,   169,   139,   171,   172,
+     173,   174,   175,   176,   177,   178,   179,   180,   181,   182,
+     183,   184,   185,   143,   146,   189,    88,    89,    90,    91,
+     170,   103,   186,   216,   169,   187,   192,   193,   211,   103,
+     213,    48,    69,    69,    68,    68,   224,   218,   112,   113,
+     114,   115,   116,   195,   217,   221,   102,   103,   257,   244,
+     219,   245,   227,   225,   228,   226,   229,   230,   114,   115,
+     116,   231,   249,   103,   232,   240,   106,   107,   108,   109,
+     110,   111,   112,   113,   114,   115,   116,   256,   261,   262,
+     118,   234,   266,   258,   259,   268,   271,   103,   276,   151,
+     281,   242,   108,   109,   110,   111,   112,   113,   114,   115,
+     116,   247,    84,   154,   118,   147,   149,   243,   269,   246,
+     152,   278,   282,   248,   102,   208,   252,     0,     0,   250,
+       0,     0,     0,   253,     0,   254,     0,   255,     0,     0,
+       0,   103,   104,   105,   106,   107,   108,   109,   110,   111,
+     112,   113,   114,   115,   116,   117,     0,   267,   118,     0,
+       0,     0,   234,   270,     0,   239,     0,   102,     0,   273,
+       0,     0,   274,     0,     0,   275,     0,     0,     0,     0,
+     280,     0,     0,   283,   103,   104,   105,   106,   107,   108,
+     109,   110,   111,   112,   113,   114,   115,   116,   117,   102,
+       0,   118,     0,     0,     0,    36,    37,    38,   251,    40,
+      41,    42,    43,     0,     0,     0,   103,   104,   105,   106,
+     107,   108,   109,   110,   111,   112,   113,   114,   115,   116,
+     117,     0,     0,   118,     0,     0,   156,   196,   197,   102,
+       0,     0,     0,     0,     0,     0,     0,    36,    37,    38,
+       0,    40,    41,    42,    43,     0,   103,   104,   105,   106,
+     107,   108,   109,   110,   111,   112,   113,   114,   115,   116,
+     117,   102,     0,   118,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   103,   104,
+     105,   106,   107,   108,   109,   110,   111,   112,   113,   114,
+     115,   116,   117,     0,     0,   118,   279,   130,   134,   131,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,    97,    98,    99,   100,   101,   102,
-     103,   104,   105,   106,   107,   108,   109,   110,   111,     0,
-      97,   112,   127,   133,   128,   102,   103,   104,   105,   106,
-     107,   108,   109,   110,     0,     0,     0,   112,     0,    97,
-      98,    99,   100,   101,   102,   103,   104,   105,   106,   107,
-     108,   109,   110,   111,    96,     0,   112,     0,     0,   252,
-     253,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,    97,    98,    99,   100,   101,   102,   103,   104,   105,
-     106,   107,   108,   109,   110,   111,     0,   127,   112,   128,
+       0,     0,     0,   102,   103,   104,   105,   106,   107,   108,
+     109,   110,   111,   112,   113,   114,   115,   116,   117,     0,
+     103,   118,   130,   136,   131,   108,   109,   110,   111,   112,
+     113,   114,   115,   116,     0,     0,     0,   118,     0,   103,
+     104,   105,   106,   107,   108,   109,   110,   111,   112,   113,
+     114,   115,   116,   117,   102,     0,   118,     0,     0,   263,
+     264,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,   103,   104,   105,   106,   107,   108,   109,   110,   111,
+     112,   113,   114,   115,   116,   117,     0,   130,   118,   131,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,    97,    98,    99,   100,   101,   102,
-     103,   104,   105,   106,   107,   108,   109,   110,   111,    96,
-       0,   112,     0,   207,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,    97,    98,    99,   100,
-     101,   102,   103,   104,   105,   106,   107,   108,   109,   110,
-     111,    96,     0,   112,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,    97,    98,
-      99,   100,   101,   102,   103,   104,   105,   106,   107,   108,
-     109,   110,   111,   220,    96,   112,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,   118,     0,     0,     0,     0,
-       0,    97,    98,    99,   100,   101,   102,   103,   104,   105,
-     106,   107,   108,   109,   110,   111,    96,     0,   112,     0,
+       0,     0,     0,     0,   103,   104,   105,   106,   107,   108,
+     109,   110,   111,   112,   113,   114,   115,   116,   117,   102,
+       0,   118,     0,   215,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,   103,   104,   105,   106,
+     107,   108,   109,   110,   111,   112,   113,   114,   115,   116,
+     117,   102,     0,   118,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   103,   104,
+     105,   106,   107,   108,   109,   110,   111,   112,   113,   114,
+     115,   116,   117,   233,   102,   118,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,   124,     0,     0,     0,     0,
+       0,   103,   104,   105,   106,   107,   108,   109,   110,   111,
+     112,   113,   114,   115,   116,   117,   102,     0,   118,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,    96,     0,    97,    98,    99,   100,   101,   102,   103,
-     104,   105,   106,   107,   108,   109,   110,   111,    97,    98,
-     112,   100,   101,   102,   103,   104,   105,   106,   107,   108,
-     109,   110,     0,     0,     0,   112,    35,    36,    37,    38,
-      39,    40,    41,    42,     0,    43,     4,     5,     6,     7,
-       8,     9,    10,     0,    44,    45,   178,     0,    11,    12,
-      13,    14,    15,     0,    46,     0,    47,     0,    48,    35,
-      36,    37,    38,    39,    40,    41,    42,     0,    43,     0,
-       0,     0,     0,     0,     0,     0,     0,    44,    45,     0,
-       0,     0,     0,     0,     0,     0,     0,    46,   -98,    47,
-       0,    48,    35,    36,    37,    38,    39,    40,    41,    42,
-       0,    43,     0,     0,     0,     0,     0,     0,     0,     0,
-      44,    45,    35,    36,    37,   193,   194,    40,    41,   195,
-      46,    43,    47,     0,    48,     0,     0,     0,     0,     0,
-      44,    45,     0,     0,     0,     0,     0,     0,     0,     0,
-      46,     0,    47,     0,    48
+       0,   102,     0,   103,   104,   105,   106,   107,   108,   109,
+     110,   111,   112,   113,   114,   115,   116,   117,   103,   104,
+     118,   106,   107,   108,   109,   110,   111,   112,   113,   114,
+     115,   116,     0,     0,     0,   118,    36,    37,    38,    39,
+      40,    41,    42,    43,     0,    44,     4,     5,     6,     7,
+       8,     9,    10,     0,    45,    46,   188,     0,    11,    12,
+      13,    14,    15,     0,    47,     0,    48,     0,    49,    36,
+      37,    38,    39,    40,    41,    42,    43,     0,    44,     0,
+       0,     0,     0,     0,     0,     0,     0,    45,    46,     0,
+       0,     0,     0,     0,     0,     0,     0,    47,  -103,    48,
+       0,    49,    36,    37,    38,    39,    40,    41,    42,    43,
+       0,    44,     0,     0,     0,     0,     0,     0,     0,     0,
+      45,    46,    36,    37,    38,   201,   202,    41,    42,   203,
+      47,    44,    48,     0,    49,     0,     0,     0,     0,     0,
+      45,    46,     0,     0,     0,     0,     0,     0,     0,     0,
+      47,     0,    48,     0,    49
 };
 
 static const yytype_int16 yycheck[] =
 {
-       6,     7,    93,     4,    23,    11,    12,    13,    14,    71,
-     118,    73,     0,    75,    10,    23,    10,    78,    79,    27,
-      23,    24,    13,    14,    27,     0,    52,    13,     0,     4,
-     138,     6,     4,    12,     6,    61,    12,    43,    44,    45,
-      46,    23,    24,    45,    28,    27,    48,    47,    23,    52,
-      29,    23,    45,    32,    33,    34,    35,    36,    37,    38,
-      39,    40,    41,    42,    65,   125,   126,    46,   129,   130,
-      76,   132,    47,   134,    49,    47,    77,    49,   139,     4,
-      86,     6,    88,    26,    27,    28,    29,    23,    23,    95,
-      96,    47,    98,    99,   100,   101,   102,   103,   104,   105,
-     106,   107,   108,   109,   110,   111,   112,    23,     4,   115,
-       6,     0,    29,    12,    23,     4,    48,     6,    47,    14,
-     116,   127,    50,    47,    29,   131,    28,   133,    28,   125,
-     126,   125,   126,   224,    23,    40,    41,    42,    29,    49,
-      12,   203,    53,   205,    51,   151,    44,    38,    39,    40,
-      41,    42,    44,    47,   160,    46,    45,    29,    47,    48,
-      49,    47,    34,    35,    36,    37,    38,    39,    40,    41,
-      42,   177,   233,   234,    46,   236,    29,    40,    49,    47,
-     186,     5,   183,    47,   185,    38,    39,    40,    41,    42,
-      20,    21,    22,    44,    24,    25,    26,    27,    12,     9,
-     262,   207,   208,     6,    53,    80,   212,   268,   209,    87,
-     216,    20,   218,   187,   220,    29,    30,    31,    32,    33,
-      34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
-     185,   247,    46,    80,   215,   128,    -1,    -1,    -1,    53,
-      -1,   247,   248,    -1,    -1,    -1,    -1,    12,   254,    -1,
-      -1,   257,    -1,    -1,   260,   256,    -1,    -1,    -1,    -1,
-     266,    -1,    -1,   269,    29,    30,    31,    32,    33,    34,
+       6,     7,     4,     5,    20,    11,    12,    13,    14,    71,
+      99,    73,    52,    75,    10,    81,    10,    12,    84,    85,
+     124,    61,    13,    14,    23,    23,    24,     0,    27,    27,
+       0,     4,    45,     6,     4,    48,     6,     0,    44,    45,
+      46,    47,   146,    23,    24,     0,    29,    27,    23,     4,
+      23,     6,    13,    23,    52,    38,    39,    40,    41,    42,
+       4,    23,     6,    46,   128,   129,   132,   133,    23,   135,
+      76,   137,    45,    47,    47,    48,    49,    47,     4,    49,
+       6,    83,   148,   149,    23,    28,    92,    45,    94,    23,
+      47,    93,    47,    28,    49,   101,   102,    47,   104,   105,
+     106,   107,   108,   109,   110,   111,   112,   113,   114,   115,
+     116,   117,   118,    28,    23,   121,    27,    28,    29,    30,
+      12,    29,    23,   139,   130,    48,   122,    14,   134,    29,
+     136,    50,   128,   129,   128,   129,    49,   143,    38,    39,
+      40,    41,    42,    47,    47,   147,    12,    29,   237,   211,
+      28,   213,    51,    44,    47,   161,    44,    53,    40,    41,
+      42,    47,    47,    29,   170,    40,    32,    33,    34,    35,
+      36,    37,    38,    39,    40,    41,    42,    49,   244,   245,
+      46,   187,   248,    47,     5,    44,     9,    29,     6,    86,
+      53,   193,    34,    35,    36,    37,    38,    39,    40,    41,
+      42,   217,    21,    93,    46,    85,    85,   195,   258,   215,
+      86,   273,   278,   219,    12,   131,   228,    -1,    -1,   225,
+      -1,    -1,    -1,   229,    -1,   231,    -1,   233,    -1,    -1,
+      -1,    29,    30,    31,    32,    33,    34,    35,    36,    37,
+      38,    39,    40,    41,    42,    43,    -1,   249,    46,    -1,
+      -1,    -1,   258,   259,    -1,    53,    -1,    12,    -1,   265,
+      -1,    -1,   268,    -1,    -1,   271,    -1,    -1,    -1,    -1,
+     276,    -1,    -1,   279,    29,    30,    31,    32,    33,    34,
       35,    36,    37,    38,    39,    40,    41,    42,    43,    12,
-      -1,    46,    -1,    -1,    -1,    -1,    -1,    -1,    53,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    29,    30,    31,    32,
+      -1,    46,    -1,    -1,    -1,    20,    21,    22,    53,    24,
+      25,    26,    27,    -1,    -1,    -1,    29,    30,    31,    32,
       33,    34,    35,    36,    37,    38,    39,    40,    41,    42,
       43,    -1,    -1,    46,    -1,    -1,    49,    10,    11,    12,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    20,    21,    22,
@@ -870,7 +970,7 @@ static const yytype_int16 yycheck[] =
       31,    32,    33,    34,    35,    36,    37,    38,    39,    40,
       41,    42,    43,    -1,    -1,    46,    47,    12,    13,    14,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    29,    30,    31,    32,    33,    34,
+      -1,    -1,    -1,    12,    29,    30,    31,    32,    33,    34,
       35,    36,    37,    38,    39,    40,    41,    42,    43,    -1,
       29,    46,    12,    13,    14,    34,    35,    36,    37,    38,
       39,    40,    41,    42,    -1,    -1,    -1,    46,    -1,    29,
@@ -917,32 +1017,33 @@ static const yytype_uint8 yystos[] =
 {
        0,    63,    66,     0,     3,     4,     5,     6,     7,     8,
        9,    15,    16,    17,    18,    19,    67,    68,    69,    70,
-      74,    76,    83,    88,    89,    91,    92,    94,    96,    98,
-      23,   135,    71,    72,   135,    20,    21,    22,    23,    24,
-      25,    26,    27,    29,    38,    39,    48,    50,    52,   100,
-     101,   102,   104,   105,   106,   111,   112,   117,   126,   130,
-     131,   133,   100,    13,    73,    75,    84,   129,   131,   133,
-     100,   100,    93,   100,    95,   100,    99,    14,    73,    79,
-      64,    65,    65,    65,    65,    65,    12,    47,    28,   100,
-     100,   100,   100,   127,   118,   113,    12,    29,    30,    31,
-      32,    33,    34,    35,    36,    37,    38,    39,    40,    41,
-      42,    43,    46,    45,   103,    52,    61,    23,    23,   116,
-      77,    78,   135,    85,    86,   100,    47,    12,    14,    90,
-      90,    13,    90,    13,    90,   100,   135,   116,    23,    81,
-     116,    70,    89,   100,    72,   100,    49,    63,    23,    24,
-      27,    52,   119,   120,   121,   134,   100,   114,   115,   100,
-      12,   100,   100,   100,   100,   100,   100,   100,   100,   100,
-     100,   100,   100,   100,   100,   100,    23,    48,    40,   100,
-     122,    23,   133,    14,   117,    47,    28,    47,    10,    11,
-      87,   129,   129,    23,    24,    27,   132,    23,    24,    27,
-     132,   116,   116,   100,   116,   100,   116,    16,    28,    82,
-     116,    49,    44,   100,    51,    47,    44,    53,    47,   100,
-      44,   100,   107,   108,   109,   110,    53,    40,   128,   135,
-      78,   100,    86,    90,    90,   100,   100,    80,   135,   100,
-      53,   121,   100,   100,   100,    49,    63,    47,     5,   123,
-     116,   116,    17,    18,    97,   116,    47,    44,   108,   100,
-       9,   124,   100,   135,   100,   100,     6,   125,    90,    47,
-     100,    53,   116,   100
+      74,    75,    76,    85,    90,    91,    93,    94,    96,    98,
+     100,    23,   137,    71,    72,   137,    20,    21,    22,    23,
+      24,    25,    26,    27,    29,    38,    39,    48,    50,    52,
+     102,   103,   104,   106,   107,   108,   113,   114,   119,   128,
+     132,   133,   135,   102,    13,    73,    86,   131,   133,   135,
+     102,   102,    95,   102,    97,   102,   101,    23,    77,    78,
+      81,    83,   137,    14,    73,    79,    64,    65,    65,    65,
+      65,    65,    12,    47,    28,   102,   102,   102,   102,   129,
+     120,   115,    12,    29,    30,    31,    32,    33,    34,    35,
+      36,    37,    38,    39,    40,    41,    42,    43,    46,    45,
+     105,    52,    61,    23,    23,   118,    87,    88,   102,    47,
+      12,    14,    92,    92,    13,    92,    13,    92,   102,    47,
+      78,    84,   118,    28,   137,   118,    23,    81,    82,    83,
+     118,    70,    91,   102,    72,   102,    49,    63,    23,    24,
+      27,    52,   121,   122,   123,   136,   102,   116,   117,   102,
+      12,   102,   102,   102,   102,   102,   102,   102,   102,   102,
+     102,   102,   102,   102,   102,   102,    23,    48,    40,   102,
+     124,    23,   135,    14,   119,    47,    10,    11,    89,   131,
+     131,    23,    24,    27,   134,    23,    24,    27,   134,   118,
+     118,   102,   118,   102,   118,    16,    78,    47,   102,    28,
+      80,   137,   118,   118,    49,    44,   102,    51,    47,    44,
+      53,    47,   102,    44,   102,   109,   110,   111,   112,    53,
+      40,   130,   137,    88,    92,    92,   102,    78,   102,    47,
+     102,    53,   123,   102,   102,   102,    49,    63,    47,     5,
+     125,   118,   118,    17,    18,    99,   118,   137,    44,   110,
+     102,     9,   126,   102,   102,   102,     6,   127,    92,    47,
+     102,    53,   118,   102
 };
 
   /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
@@ -950,21 +1051,21 @@ static const yytype_uint8 yyr1[] =
 {
        0,    62,    63,    63,    63,    63,    63,    63,    64,    64,
       65,    65,    66,    66,    67,    67,    67,    67,    67,    67,
-      68,    69,    70,    71,    71,    72,    73,    75,    74,    76,
-      76,    76,    76,    76,    77,    77,    78,    79,    79,    80,
-      80,    82,    81,    84,    83,    85,    85,    86,    87,    87,
-      87,    87,    88,    88,    89,    90,    90,    91,    92,    93,
-      93,    94,    95,    95,    96,    97,    97,    99,    98,   100,
-     100,   100,   100,   100,   100,   101,   101,   103,   102,   104,
-     104,   104,   105,   105,   105,   105,   105,   105,   105,   105,
-     105,   105,   105,   105,   105,   105,   105,   106,   107,   107,
-     108,   109,   108,   110,   110,   111,   111,   113,   112,   114,
-     114,   115,   115,   116,   116,   118,   117,   119,   119,   120,
-     120,   121,   121,   121,   122,   122,   123,   123,   124,   124,
-     124,   125,   125,   126,   126,   126,   126,   126,   127,   126,
-     126,   126,   126,   128,   126,   129,   129,   130,   130,   131,
-     131,   131,   131,   131,   132,   132,   132,   133,   134,   134,
-     135
+      68,    69,    70,    71,    71,    72,    73,    74,    75,    76,
+      76,    76,    76,    76,    76,    76,    77,    77,    78,    79,
+      79,    80,    80,    81,    82,    83,    84,    84,    86,    85,
+      87,    87,    88,    89,    89,    89,    89,    90,    90,    91,
+      92,    92,    93,    94,    95,    95,    96,    97,    97,    98,
+      99,    99,   101,   100,   102,   102,   102,   102,   102,   102,
+     103,   103,   105,   104,   106,   106,   106,   107,   107,   107,
+     107,   107,   107,   107,   107,   107,   107,   107,   107,   107,
+     107,   107,   108,   109,   109,   110,   111,   110,   112,   112,
+     113,   113,   115,   114,   116,   116,   117,   117,   118,   118,
+     120,   119,   121,   121,   122,   122,   123,   123,   123,   124,
+     124,   125,   125,   126,   126,   126,   127,   127,   128,   128,
+     128,   128,   128,   129,   128,   128,   128,   128,   130,   128,
+     131,   131,   132,   132,   133,   133,   133,   133,   133,   134,
+     134,   134,   135,   136,   136,   137
 };
 
   /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
@@ -972,21 +1073,21 @@ static const yytype_uint8 yyr2[] =
 {
        0,     2,     2,     3,     3,     3,     3,     3,     0,     2,
        0,     2,     0,     2,     1,     1,     1,     1,     1,     1,
-       4,     2,     2,     1,     3,     3,     4,     0,     3,     3,
-       3,     3,     4,     6,     1,     3,     3,     0,     2,     1,
-       3,     0,     3,     0,     3,     1,     3,     2,     0,     1,
-       1,     1,     2,     4,     2,     2,     2,     4,     4,     3,
-       5,     2,     3,     5,     2,     1,     1,     0,     9,     1,
-       1,     1,     1,     1,     3,     1,     3,     0,     5,     2,
-       2,     2,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     3,     3,     3,     3,     3,     4,     5,     0,     1,
-       1,     0,     2,     1,     3,     1,     1,     0,     4,     0,
-       1,     1,     3,     0,     2,     0,     4,     0,     1,     1,
-       3,     3,     5,     3,     1,     2,     0,     2,     0,     2,
-       4,     0,     2,     1,     1,     1,     1,     3,     0,     4,
-       3,     3,     4,     0,     8,     1,     1,     1,     1,     1,
+       4,     2,     2,     1,     3,     3,     4,     1,     2,     3,
+       3,     3,     4,     3,     4,     6,     1,     3,     3,     0,
+       2,     1,     3,     1,     2,     2,     1,     3,     0,     3,
+       1,     3,     2,     0,     1,     1,     1,     2,     4,     2,
+       2,     2,     4,     4,     3,     5,     2,     3,     5,     2,
+       1,     1,     0,     9,     1,     1,     1,     1,     1,     3,
+       1,     3,     0,     5,     2,     2,     2,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     4,     5,     0,     1,     1,     0,     2,     1,     3,
+       1,     1,     0,     4,     0,     1,     1,     3,     0,     2,
+       0,     4,     0,     1,     1,     3,     3,     5,     3,     1,
+       2,     0,     2,     0,     2,     4,     0,     2,     1,     1,
+       1,     1,     3,     0,     4,     3,     3,     4,     0,     8,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1
+       1,     1,     1,     1,     1,     1
 };
 
 
@@ -1764,187 +1865,187 @@ yyreduce:
   switch (yyn)
     {
         case 2:
-#line 204 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 301 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1771 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1872 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 3:
-#line 206 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 303 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1778 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1879 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 4:
-#line 208 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 305 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1785 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1886 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 5:
-#line 210 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 307 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1792 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1893 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 6:
-#line 212 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 309 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1799 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1900 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 7:
-#line 214 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 311 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1806 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1907 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 8:
-#line 219 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 316 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1813 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1914 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 9:
-#line 221 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 318 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1820 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1921 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 10:
-#line 226 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 323 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       // still need to close the scope opened by the data-modification statement
       parser->ast()->scopes()->endNested();
     }
-#line 1829 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1930 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 11:
-#line 230 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 327 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       // the RETURN statement will close the scope opened by the data-modification statement
     }
-#line 1837 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1938 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 12:
-#line 236 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 333 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1844 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1945 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 13:
-#line 238 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 335 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1851 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1952 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 14:
-#line 243 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 340 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1858 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1959 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 15:
-#line 245 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 342 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1865 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1966 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 16:
-#line 247 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 344 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1872 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1973 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 17:
-#line 249 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 346 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1879 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1980 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 18:
-#line 251 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 348 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1886 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1987 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 19:
-#line 253 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 350 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1893 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1994 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 20:
-#line 258 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 355 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_FOR);
      
       auto node = parser->ast()->createNodeFor((yyvsp[-2].strval), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 1904 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2005 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 21:
-#line 267 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 364 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       // operand is a reference. can use it directly
       auto node = parser->ast()->createNodeFilter((yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 1914 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2015 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 22:
-#line 275 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 372 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1921 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2022 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 23:
-#line 280 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 377 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1928 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2029 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 24:
-#line 282 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 379 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 1935 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2036 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 25:
-#line 287 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 384 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto node = parser->ast()->createNodeLet((yyvsp[-2].strval), (yyvsp[0].node), true);
       parser->ast()->addOperation(node);
     }
-#line 1944 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2045 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 26:
-#line 294 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 391 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if (! TRI_CaseEqualString((yyvsp[-2].strval), "COUNT")) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'COUNT'", (yyvsp[-2].strval), yylloc.first_line, yylloc.first_column);
@@ -1952,20 +2053,20 @@ yyreduce:
 
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 1956 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2057 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 27:
-#line 304 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 401 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 1965 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2066 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 28:
-#line 307 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 408 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     { 
       auto list = static_cast<AstNode*>(parser->popStack());
 
@@ -1974,118 +2075,107 @@ yyreduce:
       }
       (yyval.node) = list;
     }
-#line 1978 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2079 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 29:
-#line 318 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 419 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
-      auto scopes = parser->ast()->scopes();
-
-      // check if we are in the main scope
-      bool reRegisterVariables = (scopes->type() != triagens::aql::AQL_SCOPE_MAIN); 
-
-      if (reRegisterVariables) {
-        // end the active scopes
-        scopes->endNested();
-        // start a new scope
-        scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
-      }
+      StartCollectScope(parser->ast()->scopes());
 
       auto node = parser->ast()->createNodeCollectCount(parser->ast()->createNodeArray(), (yyvsp[-1].strval), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 1999 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2090 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 30:
-#line 334 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 425 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto scopes = parser->ast()->scopes();
 
-      // check if we are in the main scope
-      bool reRegisterVariables = (scopes->type() != triagens::aql::AQL_SCOPE_MAIN); 
-
-      if (reRegisterVariables) {
-        // end the active scopes
-        scopes->endNested();
-        // start a new scope
-        scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
-
-        size_t const n = (yyvsp[-2].node)->numMembers();
-        for (size_t i = 0; i < n; ++i) {
-          auto member = (yyvsp[-2].node)->getMember(i);
-
-          if (member != nullptr) {
-            TRI_ASSERT(member->type == NODE_TYPE_ASSIGN);
-            auto v = static_cast<Variable*>(member->getMember(0)->getData());
-            scopes->addVariable(v);
-          }
-        }
+      if (StartCollectScope(scopes)) {
+        RegisterAssignVariables(scopes, (yyvsp[-2].node));
       }
 
       auto node = parser->ast()->createNodeCollectCount((yyvsp[-2].node), (yyvsp[-1].strval), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2031 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2105 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 31:
-#line 361 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 435 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
-      auto scopes = parser->ast()->scopes();
+      auto groups = static_cast<AstNode*>(parser->popStack());
 
-      // check if we are in the main scope
-      bool reRegisterVariables = (scopes->type() != triagens::aql::AQL_SCOPE_MAIN); 
+      if (groups == nullptr) {
+        ABORT_OOM
+      }
 
-      if (reRegisterVariables) {
-        // end the active scopes
-        scopes->endNested();
-        // start a new scope
-        scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
+      if (! ValidateAggregates(parser, groups, (yyvsp[-1].node), yylloc)) {
+        YYABORT;
+      }
 
-        size_t const n = (yyvsp[-2].node)->numMembers();
-        for (size_t i = 0; i < n; ++i) {
-          auto member = (yyvsp[-2].node)->getMember(i);
+      auto scopes = parser->ast()->scopes();
 
-          if (member != nullptr) {
-            TRI_ASSERT(member->type == NODE_TYPE_ASSIGN);
-            auto v = static_cast<Variable*>(member->getMember(0)->getData());
-            scopes->addVariable(v);
-          }
-        }
+      if (StartCollectScope(scopes)) {
+        RegisterAssignVariables(scopes, (yyvsp[-1].node));
       }
 
-      auto node = parser->ast()->createNodeCollect((yyvsp[-2].node), (yyvsp[-1].strval), nullptr, (yyvsp[0].node));
+      auto node = parser->ast()->createNodeCollectAggregate(groups, (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2063 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2130 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
   case 32:
-#line 388 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+#line 455 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+    {
+      if ((yyvsp[-2].strval) != nullptr) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "use of 'INTO' together with 'AGGREGATE'", yylloc.first_line, yylloc.first_column);
+        YYABORT;
+      }
+
+      if (! ValidateAggregates(parser, (yyvsp[-3].node), (yyvsp[-1].node), yylloc)) {
+        YYABORT;
+      }
+
+      auto scopes = parser->ast()->scopes();
+
+      if (StartCollectScope(scopes)) {
+        RegisterAssignVariables(scopes, (yyvsp[-3].node));
+        RegisterAssignVariables(scopes, (yyvsp[-1].node));
+      }
+
+      auto node = parser->ast()->createNodeCollectAggregate((yyvsp[-3].node), (yyvsp[-1].node), (yyvsp[0].node));
+      parser->ast()->addOperation(node);
+    }
+#line 2155 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+    break;
+
+  case 33:
+#line 475 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto scopes = parser->ast()->scopes();
 
-      // check if we are in the main scope
-      bool reRegisterVariables = (scopes->type() != triagens::aql::AQL_SCOPE_MAIN); 
+      if (StartCollectScope(scopes)) {
+        RegisterAssignVariables(scopes, (yyvsp[-2].node));
+      }
 
-      if (reRegisterVariables) {
-        // end the active scopes
-        scopes->endNested();
-        // start a new scope
-        scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
+      auto node = parser->ast()->createNodeCollect((yyvsp[-2].node), (yyvsp[-1].strval), nullptr, (yyvsp[0].node));
+      parser->ast()->addOperation(node);
+    }
+#line 2170 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+    break;
 
-        size_t const n = (yyvsp[-3].node)->numMembers();
-        for (size_t i = 0; i < n; ++i) {
-          auto member = (yyvsp[-3].node)->getMember(i);
+  case 34:
+#line 485 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+    {
+      auto scopes = parser->ast()->scopes();
 
-          if (member != nullptr) {
-            TRI_ASSERT(member->type == NODE_TYPE_ASSIGN);
-            auto v = static_cast<Variable*>(member->getMember(0)->getData());
-            scopes->addVariable(v);
-          }
-        }
+      if (StartCollectScope(scopes)) {
+        RegisterAssignVariables(scopes, (yyvsp[-3].node));
       }
 
       if ((yyvsp[-2].strval) == nullptr && 
@@ -2096,82 +2186,65 @@ yyreduce:
       auto node = parser->ast()->createNodeCollect((yyvsp[-3].node), (yyvsp[-2].strval), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2100 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2190 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 33:
-#line 420 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 35:
+#line 500 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto scopes = parser->ast()->scopes();
 
-      // check if we are in the main scope
-      bool reRegisterVariables = (scopes->type() != triagens::aql::AQL_SCOPE_MAIN); 
-
-      if (reRegisterVariables) {
-        // end the active scopes
-        scopes->endNested();
-        // start a new scope
-        scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
-
-        size_t const n = (yyvsp[-5].node)->numMembers();
-        for (size_t i = 0; i < n; ++i) {
-          auto member = (yyvsp[-5].node)->getMember(i);
-
-          if (member != nullptr) {
-            TRI_ASSERT(member->type == NODE_TYPE_ASSIGN);
-            auto v = static_cast<Variable*>(member->getMember(0)->getData());
-            scopes->addVariable(v);
-          }
-        }
+      if (StartCollectScope(scopes)) {
+        RegisterAssignVariables(scopes, (yyvsp[-5].node));
       }
 
       auto node = parser->ast()->createNodeCollectExpression((yyvsp[-5].node), (yyvsp[-3].strval), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2132 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2205 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 34:
-#line 450 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 36:
+#line 513 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 2139 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2212 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 35:
-#line 452 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 37:
+#line 515 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 2146 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2219 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 36:
-#line 457 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 38:
+#line 520 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto node = parser->ast()->createNodeAssign((yyvsp[-2].strval), (yyvsp[0].node));
       parser->pushArrayElement(node);
     }
-#line 2155 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2228 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 37:
-#line 464 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 39:
+#line 527 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.strval) = nullptr;
     }
-#line 2163 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2236 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 38:
-#line 467 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 40:
+#line 530 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 2171 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2244 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 39:
-#line 473 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 41:
+#line 536 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if (! parser->ast()->scopes()->existsVariable((yyvsp[0].strval))) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "use of unknown variable '%s' for KEEP", (yyvsp[0].strval), yylloc.first_line, yylloc.first_column);
@@ -2186,11 +2259,11 @@ yyreduce:
       node->setFlag(FLAG_KEEP_VARIABLENAME);
       parser->pushArrayElement(node);
     }
-#line 2190 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2263 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 40:
-#line 487 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 42:
+#line 550 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if (! parser->ast()->scopes()->existsVariable((yyvsp[0].strval))) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "use of unknown variable '%s' for KEEP", (yyvsp[0].strval), yylloc.first_line, yylloc.first_column);
@@ -2205,153 +2278,185 @@ yyreduce:
       node->setFlag(FLAG_KEEP_VARIABLENAME);
       parser->pushArrayElement(node);
     }
-#line 2209 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2282 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 41:
-#line 504 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 43:
+#line 567 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
-      if (! TRI_CaseEqualString((yyvsp[0].strval), "KEEP")) {
-        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'KEEP'", (yyvsp[0].strval), yylloc.first_line, yylloc.first_column);
-      }
-
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
+      (yyval.strval) = (yyvsp[0].strval);
     }
-#line 2222 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2292 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 42:
-#line 511 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 44:
+#line 575 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
+      if (! TRI_CaseEqualString((yyvsp[-1].strval), "KEEP")) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'KEEP'", (yyvsp[-1].strval), yylloc.first_line, yylloc.first_column);
+      }
+
       auto list = static_cast<AstNode*>(parser->popStack());
       (yyval.node) = list;
     }
-#line 2231 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2305 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 43:
-#line 518 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 45:
+#line 586 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+    {
+      if (! TRI_CaseEqualString((yyvsp[-1].strval), "AGGREGATE")) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'AGGREGATE'", (yyvsp[-1].strval), yylloc.first_line, yylloc.first_column);
+      }
+
+      auto list = static_cast<AstNode*>(parser->popStack());
+
+      if (list == nullptr) {
+        ABORT_OOM
+      }
+      (yyval.node) = list;
+    }
+#line 2322 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+    break;
+
+  case 46:
+#line 601 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+    {
+    }
+#line 2329 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+    break;
+
+  case 47:
+#line 603 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+    {
+    }
+#line 2336 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+    break;
+
+  case 48:
+#line 608 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 2240 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2345 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 44:
-#line 521 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 49:
+#line 611 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto list = static_cast<AstNode const*>(parser->popStack());
       auto node = parser->ast()->createNodeSort(list);
       parser->ast()->addOperation(node);
     }
-#line 2250 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2355 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 45:
-#line 529 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 50:
+#line 619 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2258 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2363 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 46:
-#line 532 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 51:
+#line 622 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2266 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2371 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 47:
-#line 538 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 52:
+#line 628 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeSortElement((yyvsp[-1].node), (yyvsp[0].node));
     }
-#line 2274 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2379 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 48:
-#line 544 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 53:
+#line 634 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeValueBool(true);
     }
-#line 2282 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2387 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 49:
-#line 547 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 54:
+#line 637 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeValueBool(true);
     }
-#line 2290 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2395 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 50:
-#line 550 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 55:
+#line 640 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeValueBool(false);
     }
-#line 2298 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2403 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 51:
-#line 553 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 56:
+#line 643 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2306 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2411 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 52:
-#line 559 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 57:
+#line 649 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto offset = parser->ast()->createNodeValueInt(0);
       auto node = parser->ast()->createNodeLimit(offset, (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2316 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2421 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 53:
-#line 564 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 58:
+#line 654 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto node = parser->ast()->createNodeLimit((yyvsp[-2].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2325 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2430 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 54:
-#line 571 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 59:
+#line 661 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto node = parser->ast()->createNodeReturn((yyvsp[0].node));
       parser->ast()->addOperation(node);
       parser->ast()->scopes()->endNested();
     }
-#line 2335 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2440 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 55:
-#line 579 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 60:
+#line 669 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2343 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2448 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 56:
-#line 582 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 61:
+#line 672 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
        (yyval.node) = (yyvsp[0].node);
      }
-#line 2351 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2456 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 57:
-#line 588 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 62:
+#line 678 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if (! parser->configureWriteQuery(AQL_QUERY_REMOVE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
@@ -2360,11 +2465,11 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2364 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2469 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 58:
-#line 599 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 63:
+#line 689 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if (! parser->configureWriteQuery(AQL_QUERY_INSERT, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
@@ -2373,11 +2478,11 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2377 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2482 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 59:
-#line 610 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 64:
+#line 700 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if (! parser->configureWriteQuery(AQL_QUERY_UPDATE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
@@ -2387,11 +2492,11 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2391 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2496 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 60:
-#line 619 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 65:
+#line 709 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if (! parser->configureWriteQuery(AQL_QUERY_UPDATE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
@@ -2401,18 +2506,18 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2405 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2510 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 61:
-#line 631 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 66:
+#line 721 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 2412 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2517 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 62:
-#line 636 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 67:
+#line 726 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if (! parser->configureWriteQuery(AQL_QUERY_REPLACE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
@@ -2422,11 +2527,11 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2426 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2531 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 63:
-#line 645 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 68:
+#line 735 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if (! parser->configureWriteQuery(AQL_QUERY_REPLACE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
@@ -2436,44 +2541,44 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2440 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2545 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 64:
-#line 657 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 69:
+#line 747 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 2447 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2552 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 65:
-#line 662 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 70:
+#line 752 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.intval) = static_cast<int64_t>(NODE_TYPE_UPDATE);
     }
-#line 2455 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2560 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 66:
-#line 665 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 71:
+#line 755 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.intval) = static_cast<int64_t>(NODE_TYPE_REPLACE);
     }
-#line 2463 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2568 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 67:
-#line 671 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 72:
+#line 761 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     { 
       // reserve a variable named "$OLD", we might need it in the update expression
       // and in a later return thing
       parser->pushStack(parser->ast()->createNodeVariable(Variable::NAME_OLD, true));
     }
-#line 2473 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2578 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 68:
-#line 675 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 73:
+#line 765 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if (! parser->configureWriteQuery(AQL_QUERY_UPSERT, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
@@ -2519,59 +2624,59 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2523 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2628 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 69:
-#line 723 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 74:
+#line 813 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2531 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2636 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 70:
-#line 726 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 75:
+#line 816 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2539 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2644 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 71:
-#line 729 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 76:
+#line 819 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2547 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2652 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 72:
-#line 732 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 77:
+#line 822 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2555 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2660 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 73:
-#line 735 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 78:
+#line 825 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2563 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2668 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 74:
-#line 738 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 79:
+#line 828 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeRange((yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2571 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2676 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 75:
-#line 744 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 80:
+#line 834 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.strval) = (yyvsp[0].strval);
 
@@ -2579,11 +2684,11 @@ yyreduce:
         ABORT_OOM
       }
     }
-#line 2583 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2688 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 76:
-#line 751 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 81:
+#line 841 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if ((yyvsp[-2].strval) == nullptr || (yyvsp[0].strval) == nullptr) {
         ABORT_OOM
@@ -2598,205 +2703,205 @@ yyreduce:
         ABORT_OOM
       }
     }
-#line 2602 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2707 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 77:
-#line 768 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 82:
+#line 858 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       parser->pushStack((yyvsp[0].strval));
 
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 2613 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2718 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 78:
-#line 773 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 83:
+#line 863 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto list = static_cast<AstNode const*>(parser->popStack());
       (yyval.node) = parser->ast()->createNodeFunctionCall(static_cast<char const*>(parser->popStack()), list);
     }
-#line 2622 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2727 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 79:
-#line 780 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 84:
+#line 870 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeUnaryOperator(NODE_TYPE_OPERATOR_UNARY_PLUS, (yyvsp[0].node));
     }
-#line 2630 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2735 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 80:
-#line 783 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 85:
+#line 873 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeUnaryOperator(NODE_TYPE_OPERATOR_UNARY_MINUS, (yyvsp[0].node));
     }
-#line 2638 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2743 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 81:
-#line 786 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 86:
+#line 876 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     { 
       (yyval.node) = parser->ast()->createNodeUnaryOperator(NODE_TYPE_OPERATOR_UNARY_NOT, (yyvsp[0].node));
     }
-#line 2646 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2751 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 82:
-#line 792 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 87:
+#line 882 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_OR, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2654 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2759 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 83:
-#line 795 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 88:
+#line 885 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_AND, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2662 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2767 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 84:
-#line 798 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 89:
+#line 888 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_PLUS, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2670 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2775 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 85:
-#line 801 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 90:
+#line 891 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_MINUS, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2678 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2783 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 86:
-#line 804 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 91:
+#line 894 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_TIMES, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2686 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2791 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 87:
-#line 807 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 92:
+#line 897 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_DIV, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2694 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2799 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 88:
-#line 810 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 93:
+#line 900 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_MOD, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2702 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2807 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 89:
-#line 813 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 94:
+#line 903 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_EQ, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2710 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2815 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 90:
-#line 816 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 95:
+#line 906 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_NE, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2718 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2823 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 91:
-#line 819 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 96:
+#line 909 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_LT, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2726 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2831 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 92:
-#line 822 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 97:
+#line 912 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_GT, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2734 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2839 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 93:
-#line 825 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 98:
+#line 915 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_LE, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2742 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2847 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 94:
-#line 828 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 99:
+#line 918 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_GE, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2750 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2855 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 95:
-#line 831 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 100:
+#line 921 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_IN, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2758 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2863 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 96:
-#line 834 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 101:
+#line 924 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_NIN, (yyvsp[-3].node), (yyvsp[0].node));
     }
-#line 2766 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2871 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 97:
-#line 840 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 102:
+#line 930 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeTernaryOperator((yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2774 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2879 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 98:
-#line 846 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 103:
+#line 936 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 2781 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2886 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 99:
-#line 848 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 104:
+#line 938 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 2788 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2893 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 100:
-#line 853 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 105:
+#line 943 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2796 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2901 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 101:
-#line 856 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 106:
+#line 946 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if (parser->isModificationQuery()) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected subquery after data-modification operation", yylloc.first_line, yylloc.first_column);
@@ -2804,11 +2909,11 @@ yyreduce:
       parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_SUBQUERY);
       parser->ast()->startSubQuery();
     }
-#line 2808 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2913 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 102:
-#line 862 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 107:
+#line 952 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       AstNode* node = parser->ast()->endSubQuery();
       parser->ast()->scopes()->endCurrent();
@@ -2819,98 +2924,98 @@ yyreduce:
 
       (yyval.node) = parser->ast()->createNodeReference(variableName.c_str());
     }
-#line 2823 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2928 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 103:
-#line 875 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 108:
+#line 965 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2831 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2936 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 104:
-#line 878 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 109:
+#line 968 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2839 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2944 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 105:
-#line 884 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 110:
+#line 974 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2847 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2952 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 106:
-#line 887 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 111:
+#line 977 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2855 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2960 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 107:
-#line 893 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 112:
+#line 983 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 2864 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2969 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 108:
-#line 896 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 113:
+#line 986 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = static_cast<AstNode*>(parser->popStack());
     }
-#line 2872 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2977 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 109:
-#line 902 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 114:
+#line 992 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 2879 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2984 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 110:
-#line 904 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 115:
+#line 994 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 2886 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2991 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 111:
-#line 909 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 116:
+#line 999 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2894 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2999 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 112:
-#line 912 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 117:
+#line 1002 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2902 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3007 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 113:
-#line 918 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 118:
+#line 1008 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = nullptr;
     }
-#line 2910 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3015 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 114:
-#line 921 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 119:
+#line 1011 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if ((yyvsp[-1].strval) == nullptr || (yyvsp[0].node) == nullptr) {
         ABORT_OOM
@@ -2922,72 +3027,72 @@ yyreduce:
 
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2926 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3031 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 115:
-#line 935 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 120:
+#line 1025 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto node = parser->ast()->createNodeObject();
       parser->pushStack(node);
     }
-#line 2935 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3040 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 116:
-#line 938 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 121:
+#line 1028 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = static_cast<AstNode*>(parser->popStack());
     }
-#line 2943 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3048 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 117:
-#line 944 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 122:
+#line 1034 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 2950 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3055 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 118:
-#line 946 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 123:
+#line 1036 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 2957 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3062 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 119:
-#line 951 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 124:
+#line 1041 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 2964 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3069 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 120:
-#line 953 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 125:
+#line 1043 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
     }
-#line 2971 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3076 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 121:
-#line 958 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 126:
+#line 1048 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       parser->pushObjectElement((yyvsp[-2].strval), (yyvsp[0].node));
     }
-#line 2979 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3084 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 122:
-#line 961 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 127:
+#line 1051 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       parser->pushObjectElement((yyvsp[-3].node), (yyvsp[0].node));
     }
-#line 2987 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3092 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 123:
-#line 964 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 128:
+#line 1054 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if ((yyvsp[-2].strval) == nullptr) {
         ABORT_OOM
@@ -3000,83 +3105,83 @@ yyreduce:
       auto param = parser->ast()->createNodeParameter((yyvsp[-2].strval));
       parser->pushObjectElement(param, (yyvsp[0].node));
     }
-#line 3004 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3109 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 124:
-#line 979 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 129:
+#line 1069 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.intval) = 1;
     }
-#line 3012 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3117 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 125:
-#line 982 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 130:
+#line 1072 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.intval) = (yyvsp[-1].intval) + 1;
     }
-#line 3020 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3125 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 126:
-#line 988 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 131:
+#line 1078 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = nullptr;
     }
-#line 3028 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3133 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 127:
-#line 991 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 132:
+#line 1081 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3036 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3141 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 128:
-#line 997 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 133:
+#line 1087 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = nullptr;
     }
-#line 3044 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3149 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 129:
-#line 1000 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 134:
+#line 1090 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeArrayLimit(nullptr, (yyvsp[0].node));
     }
-#line 3052 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3157 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 130:
-#line 1003 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 135:
+#line 1093 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeArrayLimit((yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3060 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3165 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 131:
-#line 1009 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 136:
+#line 1099 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = nullptr;
     }
-#line 3068 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3173 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 132:
-#line 1012 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 137:
+#line 1102 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3076 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3181 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 133:
-#line 1018 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 138:
+#line 1108 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       // variable or collection
       auto ast = parser->ast();
@@ -3119,27 +3224,27 @@ yyreduce:
 
       (yyval.node) = node;
     }
-#line 3123 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3228 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 134:
-#line 1060 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 139:
+#line 1150 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3131 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3236 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 135:
-#line 1063 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 140:
+#line 1153 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3139 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3244 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 136:
-#line 1066 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 141:
+#line 1156 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
       
@@ -3147,11 +3252,11 @@ yyreduce:
         ABORT_OOM
       }
     }
-#line 3151 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3256 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 137:
-#line 1073 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 142:
+#line 1163 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if ((yyvsp[-1].node)->type == NODE_TYPE_EXPANSION) {
         // create a dummy passthru node that reduces and evaluates the expansion first
@@ -3162,11 +3267,11 @@ yyreduce:
         (yyval.node) = (yyvsp[-1].node);
       }
     }
-#line 3166 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3271 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 138:
-#line 1083 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 143:
+#line 1173 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if (parser->isModificationQuery()) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected subquery after data-modification operation", yylloc.first_line, yylloc.first_column);
@@ -3174,11 +3279,11 @@ yyreduce:
       parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_SUBQUERY);
       parser->ast()->startSubQuery();
     }
-#line 3178 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3283 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 139:
-#line 1089 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 144:
+#line 1179 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       AstNode* node = parser->ast()->endSubQuery();
       parser->ast()->scopes()->endCurrent();
@@ -3189,11 +3294,11 @@ yyreduce:
 
       (yyval.node) = parser->ast()->createNodeReference(variableName.c_str());
     }
-#line 3193 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3298 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 140:
-#line 1099 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 145:
+#line 1189 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       // named variable access, e.g. variable.reference
       if ((yyvsp[-2].node)->type == NODE_TYPE_EXPANSION) {
@@ -3209,11 +3314,11 @@ yyreduce:
         (yyval.node) = parser->ast()->createNodeAttributeAccess((yyvsp[-2].node), (yyvsp[0].strval));
       }
     }
-#line 3213 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3318 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 141:
-#line 1114 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 146:
+#line 1204 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       // named variable access, e.g. variable.@reference
       if ((yyvsp[-2].node)->type == NODE_TYPE_EXPANSION) {
@@ -3228,11 +3333,11 @@ yyreduce:
         (yyval.node) = parser->ast()->createNodeBoundAttributeAccess((yyvsp[-2].node), (yyvsp[0].node));
       }
     }
-#line 3232 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3337 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 142:
-#line 1128 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 147:
+#line 1218 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       // indexed variable access, e.g. variable[index]
       if ((yyvsp[-3].node)->type == NODE_TYPE_EXPANSION) {
@@ -3247,11 +3352,11 @@ yyreduce:
         (yyval.node) = parser->ast()->createNodeIndexedAccess((yyvsp[-3].node), (yyvsp[-1].node));
       }
     }
-#line 3251 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3356 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 143:
-#line 1142 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 148:
+#line 1232 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       // variable expansion, e.g. variable[*], with optional FILTER, LIMIT and RETURN clauses
       if ((yyvsp[0].intval) > 1 && (yyvsp[-2].node)->type == NODE_TYPE_EXPANSION) {
@@ -3276,11 +3381,11 @@ yyreduce:
       auto scopes = parser->ast()->scopes();
       scopes->stackCurrentVariable(scopes->getVariable(iteratorName));
     }
-#line 3280 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3385 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 144:
-#line 1165 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 149:
+#line 1255 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       auto scopes = parser->ast()->scopes();
       scopes->unstackCurrentVariable();
@@ -3299,27 +3404,27 @@ yyreduce:
         (yyval.node) = parser->ast()->createNodeExpansion((yyvsp[-5].intval), iterator, parser->ast()->createNodeReference(variable->name.c_str()), (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node));
       }
     }
-#line 3303 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3408 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 145:
-#line 1186 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 150:
+#line 1276 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3311 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3416 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 146:
-#line 1189 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 151:
+#line 1279 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3319 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3424 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 147:
-#line 1195 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 152:
+#line 1285 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if ((yyvsp[0].node) == nullptr) {
         ABORT_OOM
@@ -3327,11 +3432,11 @@ yyreduce:
       
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3331 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3436 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 148:
-#line 1202 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 153:
+#line 1292 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if ((yyvsp[0].node) == nullptr) {
         ABORT_OOM
@@ -3339,51 +3444,51 @@ yyreduce:
 
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3343 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3448 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 149:
-#line 1212 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 154:
+#line 1302 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeValueString((yyvsp[0].strval)); 
     }
-#line 3351 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3456 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 150:
-#line 1215 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 155:
+#line 1305 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3359 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3464 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 151:
-#line 1218 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 156:
+#line 1308 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeValueNull();
     }
-#line 3367 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3472 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 152:
-#line 1221 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 157:
+#line 1311 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeValueBool(true);
     }
-#line 3375 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3480 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 153:
-#line 1224 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 158:
+#line 1314 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeValueBool(false);
     }
-#line 3383 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3488 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 154:
-#line 1230 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 159:
+#line 1320 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
@@ -3391,11 +3496,11 @@ yyreduce:
 
       (yyval.node) = parser->ast()->createNodeCollection((yyvsp[0].strval), TRI_TRANSACTION_WRITE);
     }
-#line 3395 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3500 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 155:
-#line 1237 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 160:
+#line 1327 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
@@ -3403,11 +3508,11 @@ yyreduce:
 
       (yyval.node) = parser->ast()->createNodeCollection((yyvsp[0].strval), TRI_TRANSACTION_WRITE);
     }
-#line 3407 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3512 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 156:
-#line 1244 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 161:
+#line 1334 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
@@ -3419,19 +3524,19 @@ yyreduce:
 
       (yyval.node) = parser->ast()->createNodeParameter((yyvsp[0].strval));
     }
-#line 3423 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3528 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 157:
-#line 1258 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 162:
+#line 1348 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.node) = parser->ast()->createNodeParameter((yyvsp[0].strval));
     }
-#line 3431 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3536 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 158:
-#line 1264 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 163:
+#line 1354 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
@@ -3439,11 +3544,11 @@ yyreduce:
 
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 3443 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3548 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 159:
-#line 1271 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 164:
+#line 1361 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
@@ -3451,19 +3556,19 @@ yyreduce:
 
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 3455 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3560 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
-  case 160:
-#line 1280 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 165:
+#line 1370 "arangod/Aql/grammar.y" /* yacc.c:1646  */
     {
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 3463 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3568 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
     break;
 
 
-#line 3467 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3572 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -14,6 +14,7 @@
 #include <Basics/conversions.h>
 #include <Basics/tri-strings.h>
 
+#include "Aql/Aggregator.h"
 #include "Aql/AstNode.h"
 #include "Aql/Function.h"
 #include "Aql/Parser.h"
@@ -56,6 +57,100 @@ void Aqlerror (YYLTYPE* locp,
   parser->registerError(TRI_ERROR_OUT_OF_MEMORY);   \
   YYABORT;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief start a new scope for the variables introduced by COLLECT, returns
+/// whether the variables of the COLLECT need to be registered in it
+////////////////////////////////////////////////////////////////////////////////
+
+static bool StartCollectScope (triagens::aql::Scopes* scopes) {
+  // check if we are in the main scope
+  if (scopes->type() == triagens::aql::AQL_SCOPE_MAIN) {
+    return false;
+  } 
+
+  // end the active scopes
+  scopes->endNested();
+  // start a new scope
+  scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register the variables of a list of assignments in the current scope
+////////////////////////////////////////////////////////////////////////////////
+
+static void RegisterAssignVariables (triagens::aql::Scopes* scopes, 
+                                     AstNode const* vars) {
+  size_t const n = vars->numMembers();
+  for (size_t i = 0; i < n; ++i) {
+    auto member = vars->getMember(i);
+
+    if (member != nullptr) {
+      TRI_ASSERT(member->type == NODE_TYPE_ASSIGN);
+      auto v = static_cast<Variable*>(member->getMember(0)->getData());
+      scopes->addVariable(v);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief validate the aggregate expressions of COLLECT ... AGGREGATE
+/// each expression must be a call of a supported aggregate function with a
+/// single argument, which must not refer to variables introduced by the
+/// same COLLECT
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ValidateAggregates (triagens::aql::Parser* parser,
+                                AstNode const* groups,
+                                AstNode const* aggregates,
+                                YYLTYPE const& loc) {
+  std::unordered_set<Variable*> collectVariables;
+  for (auto const& list : { groups, aggregates }) {
+    size_t const n = list->numMembers();
+    for (size_t i = 0; i < n; ++i) {
+      auto member = list->getMember(i);
+      if (member != nullptr) {
+        collectVariables.emplace(static_cast<Variable*>(member->getMember(0)->getData()));
+      }
+    }
+  }
+
+  size_t const n = aggregates->numMembers();
+  for (size_t i = 0; i < n; ++i) {
+    auto member = aggregates->getMember(i);
+
+    if (member == nullptr) {
+      continue;
+    }
+    
+    auto func = member->getMember(1);
+    if (func->type != NODE_TYPE_FCALL) {
+      parser->registerParseError(TRI_ERROR_QUERY_PARSE, "aggregate expression must be a function call", loc.first_line, loc.first_column);
+      return false;
+    }
+
+    auto f = static_cast<triagens::aql::Function*>(func->getData());
+    if (! Aggregator::isSupported(f->externalName)) {
+      parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unsupported aggregate function '%s'", f->externalName.c_str(), loc.first_line, loc.first_column);
+      return false;
+    }
+
+    if (func->getMember(0)->numMembers() != 1) {
+      parser->registerParseError(TRI_ERROR_QUERY_PARSE, "aggregate function '%s' must be called with exactly one argument", f->externalName.c_str(), loc.first_line, loc.first_column);
+      return false;
+    }
+
+    for (auto const& v : Ast::getReferencedVariables(func)) {
+      if (collectVariables.find(v) != collectVariables.end()) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "aggregate expression must not refer to variable '%s' introduced in the same COLLECT", v->name.c_str(), loc.first_line, loc.first_column);
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 #define scanner parser->scanner()
 
 %}
@@ -159,6 +254,8 @@ void Aqlerror (YYLTYPE* locp,
 %type <node> collect_element;
 %type <node> collect_variable_list;
 %type <node> keep;
+%type <node> aggregate;
+%type <strval> collect_qualifier;
 %type <strval> optional_into;
 %type <strval> count_into;
 %type <node> expression;
@@ -300,11 +397,15 @@ count_into:
     }
   ;
 
-collect_variable_list:
+collect_start:
     T_COLLECT {
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
-    } collect_list { 
+    }
+  ;
+
+collect_variable_list:
+    collect_start collect_list { 
       auto list = static_cast<AstNode*>(parser->popStack());
 
       if (list == nullptr) {
@@ -316,17 +417,7 @@ collect_variable_list:
 
 collect_statement: 
     T_COLLECT count_into options {
-      auto scopes = parser->ast()->scopes();
-
-      // check if we are in the main scope
-      bool reRegisterVariables = (scopes->type() != triagens::aql::AQL_SCOPE_MAIN); 
-
-      if (reRegisterVariables) {
-        // end the active scopes
-        scopes->endNested();
-        // start a new scope
-        scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
-      }
+      StartCollectScope(parser->ast()->scopes());
 
       auto node = parser->ast()->createNodeCollectCount(parser->ast()->createNodeArray(), $2, $3);
       parser->ast()->addOperation(node);
@@ -334,52 +425,58 @@ collect_statement:
   | collect_variable_list count_into options {
       auto scopes = parser->ast()->scopes();
 
-      // check if we are in the main scope
-      bool reRegisterVariables = (scopes->type() != triagens::aql::AQL_SCOPE_MAIN); 
+      if (StartCollectScope(scopes)) {
+        RegisterAssignVariables(scopes, $1);
+      }
 
-      if (reRegisterVariables) {
-        // end the active scopes
-        scopes->endNested();
-        // start a new scope
-        scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
+      auto node = parser->ast()->createNodeCollectCount($1, $2, $3);
+      parser->ast()->addOperation(node);
+    }
+  | collect_start aggregate options {
+      auto groups = static_cast<AstNode*>(parser->popStack());
 
-        size_t const n = $1->numMembers();
-        for (size_t i = 0; i < n; ++i) {
-          auto member = $1->getMember(i);
+      if (groups == nullptr) {
+        ABORT_OOM
+      }
 
-          if (member != nullptr) {
-            TRI_ASSERT(member->type == NODE_TYPE_ASSIGN);
-            auto v = static_cast<Variable*>(member->getMember(0)->getData());
-            scopes->addVariable(v);
-          }
-        }
+      if (! ValidateAggregates(parser, groups, $2, yylloc)) {
+        YYABORT;
       }
 
-      auto node = parser->ast()->createNodeCollectCount($1, $2, $3);
+      auto scopes = parser->ast()->scopes();
+
+      if (StartCollectScope(scopes)) {
+        RegisterAssignVariables(scopes, $2);
+      }
+
+      auto node = parser->ast()->createNodeCollectAggregate(groups, $2, $3);
       parser->ast()->addOperation(node);
     }
-  | collect_variable_list optional_into options {
-      auto scopes = parser->ast()->scopes();
+  | collect_variable_list optional_into aggregate options {
+      if ($2 != nullptr) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "use of 'INTO' together with 'AGGREGATE'", yylloc.first_line, yylloc.first_column);
+        YYABORT;
+      }
 
-      // check if we are in the main scope
-      bool reRegisterVariables = (scopes->type() != triagens::aql::AQL_SCOPE_MAIN); 
+      if (! ValidateAggregates(parser, $1, $3, yylloc)) {
+        YYABORT;
+      }
 
-      if (reRegisterVariables) {
-        // end the active scopes
-        scopes->endNested();
-        // start a new scope
-        scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
+      auto scopes = parser->ast()->scopes();
 
-        size_t const n = $1->numMembers();
-        for (size_t i = 0; i < n; ++i) {
-          auto member = $1->getMember(i);
+      if (StartCollectScope(scopes)) {
+        RegisterAssignVariables(scopes, $1);
+        RegisterAssignVariables(scopes, $3);
+      }
 
-          if (member != nullptr) {
-            TRI_ASSERT(member->type == NODE_TYPE_ASSIGN);
-            auto v = static_cast<Variable*>(member->getMember(0)->getData());
-            scopes->addVariable(v);
-          }
-        }
+      auto node = parser->ast()->createNodeCollectAggregate($1, $3, $4);
+      parser->ast()->addOperation(node);
+    }
+  | collect_variable_list optional_into options {
+      auto scopes = parser->ast()->scopes();
+
+      if (StartCollectScope(scopes)) {
+        RegisterAssignVariables(scopes, $1);
       }
 
       auto node = parser->ast()->createNodeCollect($1, $2, nullptr, $3);
@@ -388,25 +485,8 @@ collect_statement:
   | collect_variable_list optional_into keep options {
       auto scopes = parser->ast()->scopes();
 
-      // check if we are in the main scope
-      bool reRegisterVariables = (scopes->type() != triagens::aql::AQL_SCOPE_MAIN); 
-
-      if (reRegisterVariables) {
-        // end the active scopes
-        scopes->endNested();
-        // start a new scope
-        scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
-
-        size_t const n = $1->numMembers();
-        for (size_t i = 0; i < n; ++i) {
-          auto member = $1->getMember(i);
-
-          if (member != nullptr) {
-            TRI_ASSERT(member->type == NODE_TYPE_ASSIGN);
-            auto v = static_cast<Variable*>(member->getMember(0)->getData());
-            scopes->addVariable(v);
-          }
-        }
+      if (StartCollectScope(scopes)) {
+        RegisterAssignVariables(scopes, $1);
       }
 
       if ($2 == nullptr && 
@@ -420,25 +500,8 @@ collect_statement:
   | collect_variable_list T_INTO variable_name T_ASSIGN expression options {
       auto scopes = parser->ast()->scopes();
 
-      // check if we are in the main scope
-      bool reRegisterVariables = (scopes->type() != triagens::aql::AQL_SCOPE_MAIN); 
-
-      if (reRegisterVariables) {
-        // end the active scopes
-        scopes->endNested();
-        // start a new scope
-        scopes->start(triagens::aql::AQL_SCOPE_COLLECT);
-
-        size_t const n = $1->numMembers();
-        for (size_t i = 0; i < n; ++i) {
-          auto member = $1->getMember(i);
-
-          if (member != nullptr) {
-            TRI_ASSERT(member->type == NODE_TYPE_ASSIGN);
-            auto v = static_cast<Variable*>(member->getMember(0)->getData());
-            scopes->addVariable(v);
-          }
-        }
+      if (StartCollectScope(scopes)) {
+        RegisterAssignVariables(scopes, $1);
       }
 
       auto node = parser->ast()->createNodeCollectExpression($1, $3, $5, $6);
@@ -500,20 +563,47 @@ variable_list:
     }
   ;
 
-keep: 
+collect_qualifier:
     T_STRING {
+      auto node = parser->ast()->createNodeArray();
+      parser->pushStack(node);
+      $$ = $1;
+    }
+  ;
+
+keep: 
+    collect_qualifier variable_list {
       if (! TRI_CaseEqualString($1, "KEEP")) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'KEEP'", $1, yylloc.first_line, yylloc.first_column);
       }
 
-      auto node = parser->ast()->createNodeArray();
-      parser->pushStack(node);
-    } variable_list {
       auto list = static_cast<AstNode*>(parser->popStack());
       $$ = list;
     }
   ;
 
+aggregate:
+    collect_qualifier aggregate_list {
+      if (! TRI_CaseEqualString($1, "AGGREGATE")) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'AGGREGATE'", $1, yylloc.first_line, yylloc.first_column);
+      }
+
+      auto list = static_cast<AstNode*>(parser->popStack());
+
+      if (list == nullptr) {
+        ABORT_OOM
+      }
+      $$ = list;
+    }
+  ;
+
+aggregate_list:
+    collect_element {
+    }
+  | aggregate_list T_COMMA collect_element {
+    }
+  ;
+
 sort_statement:
     T_SORT {
       auto node = parser->ast()->createNodeArray();
@@ -245,6 +245,62 @@ void CollectionInfoCurrent::copyAllJsons () {
   }
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                ShardRouting class
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates the routing information for a collection
+////////////////////////////////////////////////////////////////////////////////
+
+ShardRouting::ShardRouting (vector<ShardID> const& shards,
+                            vector<string> const& shardKeys)
+  : _shards(shards),
+    _shardKeys(shardKeys),
+    _shardKeyPointers(),
+    _usesDefaultShardingAttributes(shardKeys.size() == 1 &&
+                                   shardKeys[0] == TRI_VOC_ATTRIBUTE_KEY) {
+
+  TRI_ASSERT(! _shards.empty());
+
+  // the pointers refer to our own copy of the shard keys, which never changes
+  _shardKeyPointers.reserve(_shardKeys.size());
+  for (auto const& it : _shardKeys) {
+    _shardKeyPointers.emplace_back(it.c_str());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the routing uses the given shards and shard keys
+////////////////////////////////////////////////////////////////////////////////
+
+bool ShardRouting::equals (vector<ShardID> const& shards,
+                           vector<string> const& shardKeys) const {
+  return (_shards == shards && _shardKeys == shardKeys);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief find the shard that is responsible for a document
+////////////////////////////////////////////////////////////////////////////////
+
+int ShardRouting::getResponsibleShard (TRI_json_t const* json,
+                                       bool docComplete,
+                                       ShardID& shardID) const {
+  int error;
+  uint64_t hash = TRI_HashJsonByAttributes(json, 
+                                           const_cast<char const**>(_shardKeyPointers.data()),
+                                           (int) _shardKeyPointers.size(),
+                                           docComplete, &error);
+  static char const* magicPhrase
+      = "Foxx you have stolen the goose, give she back again!";
+  static size_t const len = 52;
+  // To improve our hash function:
+  hash = TRI_FnvHashBlock(hash, magicPhrase, len);
+
+  shardID = _shards[hash % _shards.size()];
+  return error;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
@@ -269,9 +325,11 @@ ClusterInfo::ClusterInfo ()
     _collectionsValid(false),
     _serversValid(false),
     _DBServersValid(false),
-    _coordinatorsValid(false) {
+    _coordinatorsValid(false),
+    _shardRouting() {
 
   _uniqid._currentValue = _uniqid._upperValue = 0ULL;
+  TRI_InitSpin(&_shardRoutingLock);
 
   // Actual loading into caches is postponed until necessary
 }
@@ -283,6 +341,7 @@ ClusterInfo::ClusterInfo ()
 ClusterInfo::~ClusterInfo () {
   clearPlannedDatabases();
   clearCurrentDatabases();
+  TRI_DestroySpin(&_shardRoutingLock);
 }
 
 // -----------------------------------------------------------------------------
@@ -598,9 +657,13 @@ void ClusterInfo::loadPlannedCollections (bool acquireLock) {
   if (result.successful()) {
     result.parse(prefixPlannedCollections + "/", false);
 
+    // the routing entries of collections that did not change are taken
+    // over from the current snapshot
+    std::shared_ptr<ShardRoutingTable const> oldRouting = shardRouting();
+    std::shared_ptr<ShardRoutingTable> newRouting(new ShardRoutingTable());
+
     WRITE_LOCKER(_lock);
     _collections.clear();
-    _shards.clear();
 
     std::map<std::string, AgencyCommResultEntry>::iterator it = result._values.begin();
 
@@ -634,18 +697,32 @@ void ClusterInfo::loadPlannedCollections (bool acquireLock) {
       (*it).second._json = nullptr;
 
       shared_ptr<CollectionInfo> collectionData (new CollectionInfo(json));
-      vector<string>* shardKeys = new vector<string>;
-      *shardKeys = collectionData->shardKeys();
-      _shardKeys.insert(
-                    make_pair(collection, shared_ptr<vector<string> > (shardKeys)));
+      vector<string> const shardKeys = collectionData->shardKeys();
       map<ShardID, ServerID> shardIDs = collectionData->shardIds();
-      vector<string>* shards = new vector<string>;
-      map<ShardID, ServerID>::iterator it3;
-      for (it3 = shardIDs.begin(); it3 != shardIDs.end(); ++it3) {
-        shards->push_back(it3->first);
+      vector<ShardID> shards;
+      shards.reserve(shardIDs.size());
+      for (auto const& it3 : shardIDs) {
+        shards.emplace_back(it3.first);
+      }
+
+      if (! shards.empty()) {
+        std::shared_ptr<ShardRouting const> routing;
+
+        if (oldRouting != nullptr) {
+          auto it3 = oldRouting->find(collection);
+
+          if (it3 != oldRouting->end() && 
+              (*it3).second->equals(shards, shardKeys)) {
+            routing = (*it3).second;
+          }
+        }
+
+        if (routing == nullptr) {
+          routing.reset(new ShardRouting(shards, shardKeys));
+        }
+
+        newRouting->emplace(collection, routing);
       }
-      _shards.emplace(
-              std::make_pair(collection, shared_ptr<vector<string> >(shards)));
 
       // insert the collection into the existing map, insert it under its
       // ID as well as under its name, so that a lookup can be done with
@@ -656,6 +733,13 @@ void ClusterInfo::loadPlannedCollections (bool acquireLock) {
                                            collectionData));
 
     }
+
+    // publish the new routing snapshot. readers that still use the old one
+    // keep it alive until they are done
+    TRI_LockSpin(&_shardRoutingLock);
+    _shardRouting = newRouting;
+    TRI_UnlockSpin(&_shardRoutingLock);
+
     _collectionsValid = true;
     return;
   }
@@ -732,6 +816,11 @@ TRI_col_info_t ClusterInfo::getCollectionProperties (CollectionInfo const& colle
   info._waitForSync  = collection.waitForSync();
   info._indexBuckets = collection.indexBuckets();
 
+  info._compactionDeadSizeThreshold = TRI_COL_COMPACTION_DEAD_SIZE_THRESHOLD;
+  info._compactionDeadSizeShare     = TRI_COL_COMPACTION_DEAD_SIZE_SHARE;
+  info._compactionMaxFileSize       = TRI_COL_COMPACTION_MAX_FILE_SIZE;
+  info._compressDatafiles           = false;
+
   return info;
 }
 
@@ -2190,62 +2279,40 @@ int ClusterInfo::getResponsibleShard (CollectionID const& collectionID,
   }
 
   int tries = 0;
-  shared_ptr<vector<string> > shardKeysPtr;
-  char const** shardKeys = nullptr;
-  shared_ptr<vector<ShardID> > shards;
-  bool found = false;
 
   while (true) {
-    {
-      // Get the sharding keys and the number of shards:
-      READ_LOCKER(_lock);
-      map<CollectionID, shared_ptr<vector<string>>>::iterator it
-          = _shards.find(collectionID);
-
-      if (it != _shards.end()) {
-        shards = it->second;
-        map<CollectionID, shared_ptr<vector<string>>>::iterator it2
-            = _shardKeys.find(collectionID);
-        if (it2 != _shardKeys.end()) {
-          shardKeysPtr = it2->second;
-          shardKeys = new char const* [shardKeysPtr->size()];
-          if (shardKeys != nullptr) {
-            size_t i;
-            for (i = 0; i < shardKeysPtr->size(); ++i) {
-              shardKeys[i] = shardKeysPtr->at(i).c_str();
-            }
-            usesDefaultShardingAttributes = shardKeysPtr->size() == 1 &&
-                                            shardKeysPtr->at(0) == TRI_VOC_ATTRIBUTE_KEY;
-            found = true;
-            break;  // all OK
-          }
-        }
+    // the snapshot cannot change while we are using it, so no further
+    // locking is required
+    std::shared_ptr<ShardRoutingTable const> routing = shardRouting();
+
+    if (routing != nullptr) {
+      auto it = routing->find(collectionID);
+
+      if (it != routing->end()) {
+        usesDefaultShardingAttributes = (*it).second->usesDefaultShardingAttributes();
+        return (*it).second->getResponsibleShard(json, docComplete, shardID);
       }
     }
+
     if (++tries >= 2) {
       break;
     }
     loadPlannedCollections();
   }
 
-  if (! found) {
-    return TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND;
-  }
+  return TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND;
+}
 
-  int error;
-  uint64_t hash = TRI_HashJsonByAttributes(json, shardKeys,
-                                           (int) shardKeysPtr->size(),
-                                           docComplete, &error);
-  static char const* magicPhrase
-      = "Foxx you have stolen the goose, give she back again!";
-  static size_t const len = 52;
-  // To improve our hash function:
-  hash = TRI_FnvHashBlock(hash, magicPhrase, len);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the current routing snapshot
+////////////////////////////////////////////////////////////////////////////////
 
-  delete[] shardKeys;
+std::shared_ptr<ShardRoutingTable const> ClusterInfo::shardRouting () {
+  TRI_LockSpin(&_shardRoutingLock);
+  std::shared_ptr<ShardRoutingTable const> routing = _shardRouting;
+  TRI_UnlockSpin(&_shardRoutingLock);
 
-  shardID = shards->at(hash % shards->size());
-  return error;
+  return routing;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -33,6 +33,7 @@
 
 #include "Basics/Common.h"
 #include "Basics/JsonHelper.h"
+#include "Basics/locks.h"
 #include "Cluster/AgencyComm.h"
 #include "VocBase/collection.h"
 #include "VocBase/voc-types.h"
@@ -691,6 +692,64 @@ namespace triagens {
         std::map<ShardID, TRI_json_t*> _jsons;
     };
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                class ShardRouting
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief routing information for a collection, i.e. its shards and its
+/// shard keys prepared for hashing documents. objects of this class are
+/// immutable once created, so they can be used without any locks
+////////////////////////////////////////////////////////////////////////////////
+
+    class ShardRouting {
+
+      public:
+
+        ShardRouting (std::vector<ShardID> const&,
+                      std::vector<std::string> const&);
+
+        ShardRouting (ShardRouting const&) = delete;
+        ShardRouting& operator= (ShardRouting const&) = delete;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the routing uses the given shards and shard keys
+////////////////////////////////////////////////////////////////////////////////
+
+        bool equals (std::vector<ShardID> const&,
+                     std::vector<std::string> const&) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief find the shard that is responsible for a document
+////////////////////////////////////////////////////////////////////////////////
+
+        int getResponsibleShard (TRI_json_t const*,
+                                 bool,
+                                 ShardID&) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the collection is sharded by _key only
+////////////////////////////////////////////////////////////////////////////////
+
+        bool usesDefaultShardingAttributes () const {
+          return _usesDefaultShardingAttributes;
+        }
+
+      private:
+
+        std::vector<ShardID> const      _shards;
+        std::vector<std::string> const  _shardKeys;
+        std::vector<char const*>        _shardKeyPointers;
+        bool                            _usesDefaultShardingAttributes;
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief routing information for all collections, by collection id
+////////////////////////////////////////////////////////////////////////////////
+
+    typedef std::unordered_map<CollectionID, std::shared_ptr<ShardRouting const>>
+            ShardRoutingTable;
+
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 class ClusterInfo
@@ -1006,6 +1065,13 @@ namespace triagens {
 
       private:
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the current routing snapshot, which may be a nullptr if
+/// the planned collections have not been loaded yet
+////////////////////////////////////////////////////////////////////////////////
+
+        std::shared_ptr<ShardRoutingTable const> shardRouting ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief flushes the list of planned databases
 ////////////////////////////////////////////////////////////////////////////////
@@ -1087,13 +1153,19 @@ namespace triagens {
         bool                            _coordinatorsValid;
         std::map<ShardID, ServerID>     _shardIds;
                                         // from Current/Collections/
-        std::map<CollectionID, std::shared_ptr<std::vector<std::string>>>
-                                        _shards;
-                                        // from Plan/Collections/
-                               // (may later come from Current/Colletions/ )
-        std::map<CollectionID, std::shared_ptr<std::vector<std::string>>>
-                                        _shardKeys;
-                                        // from Plan/Collections/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief routing snapshot, from Plan/Collections/
+///
+/// a reload of the planned collections builds a new table and publishes it
+/// by replacing the pointer. readers only hold _shardRoutingLock while
+/// copying the pointer, and never see a table that is being modified. the
+/// entries of collections whose shards did not change are shared between
+/// subsequent tables
+////////////////////////////////////////////////////////////////////////////////
+
+        std::shared_ptr<ShardRoutingTable const>  _shardRouting;
+        TRI_spin_t                                _shardRoutingLock;
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                          private static variables
@@ -437,11 +437,21 @@ int figuresOnCoordinator (string const& dbname,
             result->_numberJournalfiles   += ExtractFigure<TRI_voc_ssize_t>(figures, "journals", "count");
             result->_numberCompactorfiles += ExtractFigure<TRI_voc_ssize_t>(figures, "compactors", "count");
             result->_numberShapefiles     += ExtractFigure<TRI_voc_ssize_t>(figures, "shapefiles", "count");
+            result->_numberCompressedDatafiles += ExtractFigure<TRI_voc_ssize_t>(figures, "datafiles", "compressedCount");
 
             result->_datafileSize         += ExtractFigure<int64_t>(figures, "datafiles", "fileSize");
             result->_journalfileSize      += ExtractFigure<int64_t>(figures, "journals", "fileSize");
             result->_compactorfileSize    += ExtractFigure<int64_t>(figures, "compactors", "fileSize");
             result->_shapefileSize        += ExtractFigure<int64_t>(figures, "shapefiles", "fileSize");
+            result->_compressedDatafileSize += ExtractFigure<int64_t>(figures, "datafiles", "compressedFileSize");
+            result->_datafileResidentSize   += ExtractFigure<int64_t>(figures, "datafiles", "residentSize");
+            result->_journalResidentSize    += ExtractFigure<int64_t>(figures, "journals", "residentSize");
+            result->_numberColdDatafiles    += ExtractFigure<TRI_voc_ssize_t>(figures, "datafiles", "coldCount");
+
+            result->_compactionRuns         += ExtractFigure<uint64_t>(figures, "compaction", "count");
+            result->_compactionBytesRead    += ExtractFigure<uint64_t>(figures, "compaction", "bytesRead");
+            result->_compactionBytesWritten += ExtractFigure<uint64_t>(figures, "compaction", "bytesWritten");
+            result->_compactionTime         += ExtractFigure<double>(figures, "compaction", "time");
           }
           nrok++;
         }
@@ -1362,6 +1372,213 @@ int createEdgeOnCoordinator (
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief imports documents into a sharded collection on a coordinator
+///
+/// the documents are grouped by their responsible shards, and each shard
+/// receives a single import request with all its documents. the requests to
+/// the different shards are sent in parallel. errors of single documents are
+/// reported via errors, with the positions passed in via documents
+////////////////////////////////////////////////////////////////////////////////
+
+int importOnCoordinator (
+                 string const& dbname,
+                 string const& collname,
+                 vector<pair<size_t, TRI_json_t*>> const& documents,
+                 string const& onDuplicate,
+                 bool waitForSync,
+                 bool complete,
+                 map<string, string> const& headers,
+                 size_t& numCreated,
+                 size_t& numUpdated,
+                 size_t& numIgnored,
+                 vector<pair<size_t, string>>& errors) {
+
+  // Set a few variables needed for our work:
+  ClusterInfo* ci = ClusterInfo::instance();
+  ClusterComm* cc = ClusterComm::instance();
+
+  // First determine the collection ID from the name:
+  shared_ptr<CollectionInfo> collinfo = ci->getCollection(dbname, collname);
+
+  if (collinfo->empty()) {
+    return TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND;
+  }
+
+  string const collid = StringUtils::itoa(collinfo->id());
+
+  // per shard: the request body with one document per line, and the
+  // positions of these documents in the input
+  map<ShardID, pair<string, vector<size_t>>> batches;
+
+  for (auto const& it : documents) {
+    TRI_json_t* json = it.second;
+
+    // Sort out the _key attribute, in the same way as for single documents
+    bool const userSpecifiedKey = (TRI_LookupObjectJson(json, TRI_VOC_ATTRIBUTE_KEY) != nullptr);
+
+    if (! userSpecifiedKey) {
+      string const key = StringUtils::itoa(ci->uniqid());
+      TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, TRI_VOC_ATTRIBUTE_KEY,
+                            TRI_CreateStringCopyJson(TRI_UNKNOWN_MEM_ZONE, key.c_str(), key.size()));
+    }
+
+    // Now find the responsible shard:
+    bool usesDefaultShardingAttributes;
+    ShardID shardID;
+    int error = ci->getResponsibleShard(collid, json, true, shardID,
+                                        usesDefaultShardingAttributes);
+
+    if (error == TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
+      return TRI_ERROR_CLUSTER_SHARD_GONE;
+    }
+
+    if (error == TRI_ERROR_NO_ERROR &&
+        userSpecifiedKey && 
+        (! usesDefaultShardingAttributes || ! collinfo->allowUserKeys())) {
+      error = TRI_ERROR_CLUSTER_MUST_NOT_SPECIFY_KEY;
+    }
+
+    if (error != TRI_ERROR_NO_ERROR) {
+      errors.emplace_back(make_pair(it.first, string("creating document failed with error '") + TRI_errno_string(error) + "'"));
+
+      if (complete) {
+        // nothing has been sent yet
+        return error;
+      }
+      continue;
+    }
+
+    auto& batch = batches[shardID];
+    batch.first.append(JsonHelper::toString(json));
+    batch.first.push_back('\n');
+    batch.second.emplace_back(it.first);
+  }
+
+  string const url = "/_db/" + StringUtils::urlEncode(dbname) + 
+                     "/_api/import?type=documents&details=true" +
+                     "&waitForSync=" + (waitForSync ? "true" : "false") + 
+                     "&complete=" + (complete ? "true" : "false") + 
+                     "&onDuplicate=" + StringUtils::urlEncode(onDuplicate) + 
+                     "&collection=";
+
+  ClusterCommResult* res;
+  CoordTransactionID coordTransactionID = TRI_NewTickServer();
+
+  for (auto& it : batches) {
+    map<string, string>* headersCopy = new map<string, string>(headers);
+
+    // the body is owned by batches, which outlives the requests
+    res = cc->asyncRequest("", coordTransactionID, "shard:" + it.first,
+                           triagens::rest::HttpRequest::HTTP_REQUEST_POST,
+                           url + StringUtils::urlEncode(it.first),
+                           &it.second.first, 
+                           false, 
+                           headersCopy, 
+                           nullptr, 
+                           300.0);
+    delete res;
+  }
+
+  // Now listen to the results:
+  int result = TRI_ERROR_NO_ERROR;
+
+  for (size_t count = batches.size(); count > 0; count--) {
+    res = cc->wait("", coordTransactionID, 0, "", 0.0);
+
+    auto batch = batches.find(res->shardID);
+    TRI_ASSERT(batch != batches.end());
+    vector<size_t> const& positions = (*batch).second.second;
+
+    int error = TRI_ERROR_NO_ERROR;
+    string errorMessage;
+
+    if (res->status == CL_COMM_RECEIVED) {
+      TRI_json_t* json = TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, res->answer->body());
+
+      if (! JsonHelper::isObject(json)) {
+        error = TRI_ERROR_INTERNAL;
+      }
+      else if (res->answer_code != triagens::rest::HttpResponse::CREATED) {
+        error = JsonHelper::getNumericValue<int>(json, "errorNum", TRI_ERROR_INTERNAL);
+        errorMessage = JsonHelper::getStringValue(json, "errorMessage", "");
+      }
+      else {
+        numCreated += JsonHelper::getNumericValue<size_t>(json, "created", 0);
+        numUpdated += JsonHelper::getNumericValue<size_t>(json, "updated", 0);
+        numIgnored += JsonHelper::getNumericValue<size_t>(json, "ignored", 0);
+
+        // the DB server reports the positions of failed documents relative
+        // to its own part of the input. map them back to the input positions
+        TRI_json_t const* details = TRI_LookupObjectJson(json, "details");
+
+        if (TRI_IsArrayJson(details)) {
+          size_t const n = TRI_LengthArrayJson(details);
+
+          for (size_t i = 0; i < n; ++i) {
+            TRI_json_t const* detail = TRI_LookupArrayJson(details, i);
+
+            if (! TRI_IsStringJson(detail)) {
+              continue;
+            }
+
+            string message(detail->_value._string.data, detail->_value._string.length - 1);
+            size_t position = positions.front();
+
+            if (message.compare(0, 12, "at position ") == 0) {
+              size_t const sep = message.find(": ", 12);
+
+              if (sep != string::npos) {
+                uint64_t const local = StringUtils::uint64(message.substr(12, sep - 12));
+
+                if (local > 0 && local <= positions.size()) {
+                  position = positions[local - 1];
+                }
+                message = message.substr(sep + 2);
+              }
+            }
+
+            errors.emplace_back(make_pair(position, message));
+          }
+        }
+      }
+
+      if (json != nullptr) {
+        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+      }
+    }
+    else if (res->status == CL_COMM_TIMEOUT) {
+      error = TRI_ERROR_CLUSTER_TIMEOUT;
+    }
+    else {
+      error = TRI_ERROR_CLUSTER_CONNECTION_LOST;
+    }
+
+    if (error != TRI_ERROR_NO_ERROR) {
+      if (complete) {
+        // the shard has rolled back its part of the import
+        if (result == TRI_ERROR_NO_ERROR) {
+          result = error;
+        }
+      }
+      else {
+        // none of the documents sent to this shard has been imported
+        if (errorMessage.empty()) {
+          errorMessage = TRI_errno_string(error);
+        }
+
+        for (auto const& position : positions) {
+          errors.emplace_back(make_pair(position, "creating document failed with error '" + errorMessage + "'"));
+        }
+      }
+    }
+
+    delete res;
+  }
+
+  return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief flush Wal on all DBservers
 ////////////////////////////////////////////////////////////////////////////////
@@ -199,6 +199,26 @@ namespace triagens {
                  std::map<std::string, std::string>& resultHeaders,
                  std::string& resultBody);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief imports documents into a sharded collection on a coordinator,
+/// sending one import request per shard. the documents are passed as pairs
+/// of (input position, document), and errors of single documents are
+/// returned as pairs of (input position, error message)
+////////////////////////////////////////////////////////////////////////////////
+
+    int importOnCoordinator (
+                 std::string const& dbname,
+                 std::string const& collname,
+                 std::vector<std::pair<size_t, TRI_json_t*>> const& documents,
+                 std::string const& onDuplicate,
+                 bool waitForSync,
+                 bool complete,
+                 std::map<std::string, std::string> const& headers,
+                 size_t& numCreated,
+                 size_t& numUpdated,
+                 size_t& numIgnored,
+                 std::vector<std::pair<size_t, std::string>>& errors);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief truncate a cluster collection on a coordinator
 ////////////////////////////////////////////////////////////////////////////////
@@ -51,6 +51,7 @@
 static void FreeSlot (TRI_fulltext_handle_slot_t* slot) {
   TRI_Free(TRI_UNKNOWN_MEM_ZONE, slot->_documents);
   TRI_Free(TRI_UNKNOWN_MEM_ZONE, slot->_deleted);
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, slot->_lengths);
   TRI_Free(TRI_UNKNOWN_MEM_ZONE, slot);
 }
 
@@ -89,6 +90,16 @@ static bool AllocateSlot (TRI_fulltext_handles_t* const handles,
     return false;
   }
 
+  // allocate and clear document lengths
+  slot->_lengths = static_cast<uint16_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, sizeof(uint16_t) * handles->_slotSize, true));
+
+  if (slot->_lengths == nullptr) {
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, slot->_deleted);
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, slot->_documents);
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, slot);
+    return false;
+  }
+
   // set initial statistics
   slot->_min        = UINT32_MAX; // yes, this is intentional
   slot->_max        = 0;
@@ -164,8 +175,9 @@ TRI_fulltext_handles_t* TRI_CreateHandlesFulltextIndex (const uint32_t slotSize)
     return nullptr;
   }
 
-  handles->_numDeleted = 0;
-  handles->_next       = 1;
+  handles->_numDeleted  = 0;
+  handles->_totalLength = 0;
+  handles->_next        = 1;
 
   handles->_slotSize   = slotSize;
   handles->_numSlots   = 0;
@@ -283,7 +295,7 @@ TRI_fulltext_handles_t* TRI_CompactHandleFulltextIndex (TRI_fulltext_handles_t*
       else {
         // printf("- setting map at #%lu to %lu\n", (unsigned long) j, (unsigned long) targetHandle);
         map[originalHandle++] = targetHandle++;
-        TRI_InsertHandleFulltextIndex(clone, originalSlot->_documents[j]);
+        TRI_InsertHandleFulltextIndex(clone, originalSlot->_documents[j], originalSlot->_lengths[j]);
       }
     }
   }
@@ -294,11 +306,13 @@ TRI_fulltext_handles_t* TRI_CompactHandleFulltextIndex (TRI_fulltext_handles_t*
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief insert a document and return a handle for it
+/// @brief insert a document with the specified length (number of words) and
+/// return a handle for it
 ////////////////////////////////////////////////////////////////////////////////
 
 TRI_fulltext_handle_t TRI_InsertHandleFulltextIndex (TRI_fulltext_handles_t* const handles,
-                                                     const TRI_fulltext_doc_t document) {
+                                                     const TRI_fulltext_doc_t document,
+                                                     const uint32_t length) {
   TRI_fulltext_handle_t handle;
   TRI_fulltext_handle_slot_t* slot;
   uint32_t slotNumber;
@@ -334,6 +348,7 @@ TRI_fulltext_handle_t TRI_InsertHandleFulltextIndex (TRI_fulltext_handles_t* con
 
   // fill in document
   slot->_documents[slotPosition] = document;
+  slot->_lengths[slotPosition]   = (uint16_t) (length > UINT16_MAX ? UINT16_MAX : length);
   slot->_numUsed++;
   // no need to fill in deleted flag as it is initialised to false
 
@@ -344,6 +359,7 @@ TRI_fulltext_handle_t TRI_InsertHandleFulltextIndex (TRI_fulltext_handles_t* con
     slot->_min = document;
   }
 
+  handles->_totalLength += slot->_lengths[slotPosition];
   handles->_next++;
 
   return handle;
@@ -380,6 +396,7 @@ bool TRI_DeleteDocumentHandleFulltextIndex (TRI_fulltext_handles_t* const handle
         slot->_documents[j] = 0;
         slot->_numDeleted++;
         handles->_numDeleted++;
+        handles->_totalLength -= slot->_lengths[j];
         return true;
       }
     }
@@ -417,6 +434,33 @@ TRI_fulltext_doc_t TRI_GetDocumentFulltextIndex (const TRI_fulltext_handles_t* c
   return slot->_documents[slotPosition];
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the length of the document for a handle
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_GetLengthFulltextIndex (const TRI_fulltext_handles_t* const handles,
+                                     const TRI_fulltext_handle_t handle) {
+  TRI_fulltext_handle_slot_t* slot;
+
+  slot = handles->_slots[handle / handles->_slotSize];
+
+  return slot->_lengths[handle % handles->_slotSize];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the average length of all non-deleted documents
+////////////////////////////////////////////////////////////////////////////////
+
+double TRI_AverageLengthHandleFulltextIndex (const TRI_fulltext_handles_t* const handles) {
+  uint32_t numDocuments = handles->_next - 1 - handles->_numDeleted;
+
+  if (numDocuments == 0) {
+    return 0.0;
+  }
+
+  return ((double) handles->_totalLength / (double) numDocuments);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief dump all handles
 ////////////////////////////////////////////////////////////////////////////////
@@ -459,7 +503,7 @@ size_t TRI_MemoryHandleFulltextIndex (const TRI_fulltext_handles_t* const handle
 
   numSlots = handles->_numSlots;
 
-  perSlot = (sizeof(TRI_fulltext_doc_t) + sizeof(uint8_t)) * handles->_slotSize;
+  perSlot = (sizeof(TRI_fulltext_doc_t) + sizeof(uint8_t) + sizeof(uint16_t)) * handles->_slotSize;
 
   // slots list
   memory =  sizeof(TRI_fulltext_handle_slot_t*) * numSlots;
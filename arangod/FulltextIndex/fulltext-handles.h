@@ -80,6 +80,10 @@ typedef uint32_t TRI_fulltext_handle_t;
 /// to documents are just adjacent (second pointer is higher than first pointer).
 /// This is only true for documents that are created on the same memory page
 /// but this should be the common case to optimise for.
+///
+/// Each slot also stores the number of words indexed for each of its
+/// documents. The lengths are used for scoring query results. They are
+/// capped at UINT16_MAX to keep the slots small.
 ////////////////////////////////////////////////////////////////////////////////
 
 typedef struct TRI_fulltext_handle_slot_s {
@@ -89,6 +93,7 @@ typedef struct TRI_fulltext_handle_slot_s {
   TRI_fulltext_doc_t           _max;         // maximum handle value in slot
   TRI_fulltext_doc_t*          _documents;   // document ids for the slots
   uint8_t*                     _deleted;     // deleted flags for the slots
+  uint16_t*                    _lengths;     // document lengths for the slots
 }
 TRI_fulltext_handle_slot_t;
 
@@ -102,6 +107,8 @@ typedef struct TRI_fulltext_handles_s {
   TRI_fulltext_handle_slot_t** _slots;       // pointers to slots
   uint32_t                     _slotSize;    // the size of each slot
   uint32_t                     _numDeleted;  // total number of deleted documents
+  uint64_t                     _totalLength; // total length of all non-deleted
+                                             // documents
   TRI_fulltext_handle_t*       _map;         // a temporary map for remapping existing
                                              // handles to new handles during compaction
 }
@@ -158,11 +165,13 @@ bool TRI_ShouldCompactHandleFulltextIndex (TRI_fulltext_handles_t* const);
 TRI_fulltext_handles_t* TRI_CompactHandleFulltextIndex (TRI_fulltext_handles_t* const);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief insert a document and return a handle for it
+/// @brief insert a document with the specified length (number of words) and
+/// return a handle for it
 ////////////////////////////////////////////////////////////////////////////////
 
 TRI_fulltext_handle_t TRI_InsertHandleFulltextIndex (TRI_fulltext_handles_t* const,
-                                                     const TRI_fulltext_doc_t);
+                                                     const TRI_fulltext_doc_t,
+                                                     const uint32_t);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief mark a document as deleted in the handle list
@@ -178,6 +187,19 @@ bool TRI_DeleteDocumentHandleFulltextIndex (TRI_fulltext_handles_t* const,
 TRI_fulltext_doc_t TRI_GetDocumentFulltextIndex (const TRI_fulltext_handles_t* const,
                                                  const TRI_fulltext_handle_t);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the length of the document for a handle
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_GetLengthFulltextIndex (const TRI_fulltext_handles_t* const,
+                                     const TRI_fulltext_handle_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the average length of all non-deleted documents
+////////////////////////////////////////////////////////////////////////////////
+
+double TRI_AverageLengthHandleFulltextIndex (const TRI_fulltext_handles_t* const);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief dump all handles
 ////////////////////////////////////////////////////////////////////////////////
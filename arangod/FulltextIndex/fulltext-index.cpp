@@ -29,6 +29,9 @@
 
 #include "fulltext-index.h"
 
+#include <algorithm>
+#include <math.h>
+
 #include "Basics/locks.h"
 #include "Basics/logging.h"
 
@@ -55,6 +58,18 @@
 
 #define MAX_WORD_BYTES ((TRI_FULLTEXT_MAX_WORD_LENGTH) * 4)
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief BM25 term frequency saturation parameter
+////////////////////////////////////////////////////////////////////////////////
+
+#define BM25_K1 1.2
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief BM25 document length normalisation parameter
+////////////////////////////////////////////////////////////////////////////////
+
+#define BM25_B 0.75
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                     private types
 // -----------------------------------------------------------------------------
@@ -96,11 +111,17 @@ typedef void followers_t;
 /// - uint32_t numAllocated: number of handles allocated for the node
 /// - unit32_t numEntries: number of handles currently in use
 /// - TRI_fulltext_handle_t* handles: all the handle values subsequently
+/// - uint8_t* frequencies: the number of occurrences of the node's word in
+///   each of the documents
 /// Note that the highest bit of the numAllocated value contains a flag whether
-/// the handles list is sorted or not. It is therefore not safe to access the
+/// the handles list is sorted or not. The second highest bit contains a flag
+/// whether the list is packed. Once a node has collected enough handles, its
+/// list gets packed: the handles are then stored in blocks of delta and
+/// variable-byte encoded values with skip pointers, followed by a small
+/// uncompressed tail for new handles. It is therefore not safe to access the
 /// properties directly, but instead always the special functions provided in
-/// fulltext-list.c must be used. These provide access to the individual values
-/// at relatively low cost
+/// fulltext-list.cpp must be used. These provide access to the individual
+/// values at relatively low cost
 ////////////////////////////////////////////////////////////////////////////////
 
 typedef struct node_s {
@@ -1095,14 +1116,15 @@ static node_t* EnsureSubNode (index_t* const idx,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// insert a handle for a node
+/// insert a handle for a node, together with the number of occurrences of the
+/// node's word in the document
 ////////////////////////////////////////////////////////////////////////////////
 
 static bool InsertHandle (index_t* const idx,
                           node_t* const node,
-                          const TRI_fulltext_handle_t handle) {
+                          const TRI_fulltext_handle_t handle,
+                          const uint32_t frequency) {
   TRI_fulltext_list_t* list;
-  TRI_fulltext_list_t* oldList;
   size_t oldAlloc;
 
 #if TRI_FULLTEXT_DEBUG
@@ -1111,7 +1133,7 @@ static bool InsertHandle (index_t* const idx,
 
   if (node->_handles == nullptr) {
     // node does not yet have any handles. now allocate a new chunk of handles
-    node->_handles = TRI_CreateListFulltextIndex(idx->_initialNodeHandles);
+    node->_handles = TRI_CreateNodeListFulltextIndex(idx->_initialNodeHandles);
 
     if (node->_handles != nullptr) {
       idx->_memoryAllocated += TRI_MemoryListFulltextIndex(node->_handles);
@@ -1123,22 +1145,20 @@ static bool InsertHandle (index_t* const idx,
     return false;
   }
 
-  oldList  = node->_handles;
-  oldAlloc = TRI_MemoryListFulltextIndex(oldList);
+  oldAlloc = TRI_MemoryListFulltextIndex(node->_handles);
 
   // adding to the list might change the list pointer!
-  list = TRI_InsertListFulltextIndex(node->_handles, handle);
+  list = TRI_InsertListFulltextIndex(node->_handles, handle, frequency);
   if (list == nullptr) {
     // out of memory
     return false;
   }
 
-  if (list != oldList) {
-    // the insert might have changed the pointer
-    node->_handles = list;
-    idx->_memoryAllocated += TRI_MemoryListFulltextIndex(list);
-    idx->_memoryAllocated -= oldAlloc;
-  }
+  // the insert might have changed the pointer, and packing the list might
+  // have changed its size even if it didn't
+  node->_handles = list;
+  idx->_memoryAllocated += TRI_MemoryListFulltextIndex(list);
+  idx->_memoryAllocated -= oldAlloc;
 
   return true;
 }
@@ -1199,6 +1219,213 @@ static TRI_fulltext_result_t* MakeListResult (index_t* const idx,
   return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a scored document in the result heap
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  double                  _score;
+  TRI_fulltext_handle_t   _handle;
+}
+scored_handle_t;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a scoring term of a query
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  node_t const*           _node;
+  double                  _idf;
+  double                  _maxScore;          // upper bound for the term's score
+  double                  _remainingScore;    // sum of the bounds of this and all
+                                              // following terms
+}
+scoring_term_t;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compare two scored handles, so the heap's root is the worst one
+////////////////////////////////////////////////////////////////////////////////
+
+static inline bool CompareScoredHandles (scored_handle_t const& lhs,
+                                         scored_handle_t const& rhs) {
+  if (lhs._score != rhs._score) {
+    return lhs._score > rhs._score;
+  }
+  return lhs._handle < rhs._handle;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a result with the maxResults best matching documents of the
+/// handle list, scored with BM25
+///
+/// the candidates are scored term by term, with the terms ordered by their
+/// maximum possible contribution. As soon as a candidate cannot beat the
+/// worst document in the (full) result heap even if it got the maximum score
+/// for all remaining terms, it is dropped without looking at the remaining
+/// terms' lists (max-score pruning)
+///
+/// this must be called with the index's read lock held, as it accesses the
+/// terms' node lists. it will free the handle list
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_fulltext_result_t* MakeScoredResult (index_t* const idx,
+                                                TRI_fulltext_list_t* list,
+                                                scoring_term_t* terms,
+                                                uint32_t numTerms,
+                                                size_t maxResults) {
+  TRI_fulltext_list_iterator_t* iterators;
+  TRI_fulltext_result_t* result;
+  TRI_fulltext_list_entry_t* listEntries;
+  scored_handle_t* heap;
+  double numDocuments;
+  double averageLength;
+  uint32_t numEntries;
+  uint32_t numHeap;
+  uint32_t i, j;
+
+  if (list == nullptr) {
+    return nullptr;
+  }
+
+  numEntries = TRI_NumEntriesListFulltextIndex(list);
+
+  if (static_cast<size_t>(numEntries) < maxResults) {
+    maxResults = static_cast<size_t>(numEntries);
+  }
+
+  result = TRI_CreateResultFulltextIndex(static_cast<uint32_t>(maxResults));
+
+  if (result == nullptr) {
+    TRI_FreeListFulltextIndex(list);
+    return nullptr;
+  }
+
+  if (maxResults == 0) {
+    TRI_FreeListFulltextIndex(list);
+    return result;
+  }
+
+  heap = static_cast<scored_handle_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, sizeof(scored_handle_t) * maxResults, false));
+  iterators = static_cast<TRI_fulltext_list_iterator_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, sizeof(TRI_fulltext_list_iterator_t) * numTerms, false));
+  result->_scores = static_cast<double*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, sizeof(double) * maxResults, false));
+
+  if (heap == nullptr || iterators == nullptr || result->_scores == nullptr) {
+    if (heap != nullptr) {
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, heap);
+    }
+    if (iterators != nullptr) {
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, iterators);
+    }
+    TRI_FreeResultFulltextIndex(result);
+    TRI_FreeListFulltextIndex(list);
+    return nullptr;
+  }
+
+  // calculate the terms' weights
+  numDocuments  = (double) (TRI_NumHandlesHandleFulltextIndex(idx->_handles) - TRI_NumDeletedHandleFulltextIndex(idx->_handles));
+  averageLength = TRI_AverageLengthHandleFulltextIndex(idx->_handles);
+
+  for (i = 0; i < numTerms; ++i) {
+    double df = (double) TRI_NumEntriesListFulltextIndex(terms[i]._node->_handles);
+
+    if (df > numDocuments) {
+      // the list may still contain handles of deleted documents
+      df = numDocuments;
+    }
+
+    terms[i]._idf      = log(1.0 + (numDocuments - df + 0.5) / (df + 0.5));
+    terms[i]._maxScore = terms[i]._idf * (BM25_K1 + 1.0);
+  }
+
+  // evaluate the terms with the biggest contribution first, so candidates
+  // can be pruned as early as possible
+  std::sort(terms, terms + numTerms, [] (scoring_term_t const& lhs, scoring_term_t const& rhs) {
+    return lhs._maxScore > rhs._maxScore;
+  });
+
+  for (i = numTerms; i > 0; --i) {
+    terms[i - 1]._remainingScore = terms[i - 1]._maxScore + (i < numTerms ? terms[i]._remainingScore : 0.0);
+  }
+
+  for (i = 0; i < numTerms; ++i) {
+    TRI_InitIteratorListFulltextIndex(&iterators[i], terms[i]._node->_handles);
+  }
+
+  // the candidates must be sorted for the iterators
+  listEntries = TRI_StartListFulltextIndex(list);
+  numEntries  = TRI_NumEntriesListFulltextIndex(list);
+  std::sort(listEntries, listEntries + numEntries);
+
+  numHeap = 0;
+
+  for (i = 0; i < numEntries; ++i) {
+    TRI_fulltext_handle_t handle = listEntries[i];
+    double norm;
+    double score;
+
+    if ((i > 0 && handle == listEntries[i - 1]) ||
+        TRI_GetDocumentFulltextIndex(idx->_handles, handle) == 0) {
+      // duplicate or deleted document
+      continue;
+    }
+
+    norm = 1.0 - BM25_B;
+    if (averageLength > 0.0) {
+      norm += BM25_B * (double) TRI_GetLengthFulltextIndex(idx->_handles, handle) / averageLength;
+    }
+
+    score = 0.0;
+
+    for (j = 0; j < numTerms; ++j) {
+      uint32_t frequency;
+
+      if (numHeap == maxResults && score + terms[j]._remainingScore <= heap[0]._score) {
+        // the candidate cannot make it into the result anymore
+        break;
+      }
+
+      if (TRI_SeekIteratorListFulltextIndex(&iterators[j], handle, &frequency)) {
+        double tf = (double) frequency;
+
+        score += terms[j]._idf * tf * (BM25_K1 + 1.0) / (tf + BM25_K1 * norm);
+      }
+    }
+
+    if (j < numTerms) {
+      // pruned
+      continue;
+    }
+
+    if (numHeap < maxResults) {
+      heap[numHeap]._score  = score;
+      heap[numHeap]._handle = handle;
+      std::push_heap(heap, heap + ++numHeap, CompareScoredHandles);
+    }
+    else if (score > heap[0]._score) {
+      std::pop_heap(heap, heap + numHeap, CompareScoredHandles);
+      heap[numHeap - 1]._score  = score;
+      heap[numHeap - 1]._handle = handle;
+      std::push_heap(heap, heap + numHeap, CompareScoredHandles);
+    }
+  }
+
+  // return the documents with the best score first
+  std::sort_heap(heap, heap + numHeap, CompareScoredHandles);
+
+  for (i = 0; i < numHeap; ++i) {
+    result->_documents[i] = TRI_GetDocumentFulltextIndex(idx->_handles, heap[i]._handle);
+    result->_scores[i]    = heap[i]._score;
+  }
+
+  result->_numDocuments = numHeap;
+
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, iterators);
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, heap);
+  TRI_FreeListFulltextIndex(list);
+
+  return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief find all documents from the index that match the key
 ////////////////////////////////////////////////////////////////////////////////
@@ -1373,7 +1600,7 @@ bool TRI_InsertWordFulltextIndex (TRI_fts_index_t* const ftx,
 
   TRI_WriteLockReadWriteLock(&idx->_lock);
   // get a new handle for the document
-  handle = TRI_InsertHandleFulltextIndex(idx->_handles, document);
+  handle = TRI_InsertHandleFulltextIndex(idx->_handles, document, 1);
   if (handle == 0) {
     TRI_WriteUnlockReadWriteLock(&idx->_lock);
     return false;
@@ -1405,7 +1632,7 @@ bool TRI_InsertWordFulltextIndex (TRI_fts_index_t* const ftx,
   TRI_ASSERT(node != nullptr);
 #endif
 
-  result = InsertHandle(idx, node, handle);
+  result = InsertHandle(idx, node, handle, 1);
   TRI_WriteUnlockReadWriteLock(&idx->_lock);
 
   return result;
@@ -1418,7 +1645,8 @@ bool TRI_InsertWordFulltextIndex (TRI_fts_index_t* const ftx,
 /// MAX_WORD_BYTES. the caller must check this before calling this function
 ///
 /// The function will sort the wordlist in place to
-/// - filter out duplicates on insertion
+/// - filter out duplicates on insertion and count them, so the number of
+///   occurrences of each word can be stored for scoring
 /// - save redundant lookups of prefix nodes for adjacent words with shared
 ///   prefixes
 ////////////////////////////////////////////////////////////////////////////////
@@ -1448,8 +1676,9 @@ bool TRI_InsertWordsFulltextIndex (TRI_fts_index_t* const ftx,
 
   TRI_WriteLockReadWriteLock(&idx->_lock);
 
-  // get a new handle for the document
-  handle = TRI_InsertHandleFulltextIndex(idx->_handles, document);
+  // get a new handle for the document. the number of words (including
+  // duplicates) is the document's length
+  handle = TRI_InsertHandleFulltextIndex(idx->_handles, document, wordlist->_numWords);
   if (handle == 0) {
     TRI_WriteUnlockReadWriteLock(&idx->_lock);
     return false;
@@ -1466,6 +1695,7 @@ bool TRI_InsertWordsFulltextIndex (TRI_fts_index_t* const ftx,
     char* p;
     size_t start;
     size_t i;
+    uint32_t frequency;
 
     // LOG_DEBUG("checking word %s", wordlist->_words[w]);
 
@@ -1501,6 +1731,13 @@ bool TRI_InsertWordsFulltextIndex (TRI_fts_index_t* const ftx,
     // now insert into the tree, starting at the next character after the common prefix
     p = wordlist->_words[w++] + start;
 
+    // count the occurrences of the word. they are adjacent in the sorted list
+    frequency = 1;
+    while (w < wordlist->_numWords && strcmp(wordlist->_words[w], wordlist->_words[w - 1]) == 0) {
+      ++frequency;
+      ++w;
+    }
+
     for (i = start; *p && i <= MAX_WORD_BYTES; ++i) {
       node_char_t c = (node_char_t) *(p++);
 
@@ -1521,7 +1758,7 @@ bool TRI_InsertWordsFulltextIndex (TRI_fts_index_t* const ftx,
       paths[i + 1] = node;
     }
 
-    if (! InsertHandle(idx, node, handle)) {
+    if (! InsertHandle(idx, node, handle, frequency)) {
       // document was added at least once, mark it as deleted
       TRI_DeleteDocumentHandleFulltextIndex(idx->_handles, document);
       TRI_WriteUnlockReadWriteLock(&idx->_lock);
@@ -1569,12 +1806,20 @@ TRI_fulltext_result_t* TRI_FindPrefixFulltextIndex (TRI_fts_index_t* const ftx,
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief execute a query on the fulltext index
 /// note: this will free the query
+///
+/// if the query has a maximum number of results, the matching documents are
+/// ranked with BM25 using the complete-match words that are not excluded, and
+/// only the best ones are returned, best first. Prefix words only filter the
+/// results but do not contribute to the scores
 ////////////////////////////////////////////////////////////////////////////////
 
 TRI_fulltext_result_t* TRI_QueryFulltextIndex (TRI_fts_index_t* const ftx,
                                                TRI_fulltext_query_t* query) {
   index_t* idx;
   TRI_fulltext_list_t* result;
+  TRI_fulltext_result_t* scored;
+  scoring_term_t terms[TRI_FULLTEXT_SEARCH_MAX_WORDS];
+  uint32_t numTerms;
   size_t i;
 
   if (query == nullptr) {
@@ -1594,7 +1839,9 @@ TRI_fulltext_result_t* TRI_QueryFulltextIndex (TRI_fts_index_t* const ftx,
   TRI_ReadLockReadWriteLock(&idx->_lock);
 
   // initial result is empty
-  result = nullptr;
+  result   = nullptr;
+  scored   = nullptr;
+  numTerms = 0;
 
   // iterate over all words in query
   for (i = 0; i < query->_numWords; ++i) {
@@ -1623,6 +1870,32 @@ TRI_fulltext_result_t* TRI_QueryFulltextIndex (TRI_fts_index_t* const ftx,
 
     list = nullptr;
     node = FindNode(idx, word, strlen(word));
+
+    if (maxResults > 0 &&
+        match == TRI_FULLTEXT_COMPLETE &&
+        operation != TRI_FULLTEXT_EXCLUDE &&
+        node != nullptr &&
+        node->_handles != nullptr &&
+        numTerms < TRI_FULLTEXT_SEARCH_MAX_WORDS) {
+      // the word will contribute to the documents' scores
+      terms[numTerms++]._node = node;
+    }
+
+    if (operation == TRI_FULLTEXT_AND &&
+        match == TRI_FULLTEXT_COMPLETE &&
+        result != nullptr) {
+      // intersect with the node's handles directly. this will only decode
+      // the parts of the node's list that may contain any of the handles
+      // found so far
+      result = TRI_IntersectNodeListFulltextIndex(result, node != nullptr ? node->_handles : nullptr);
+
+      if (result == nullptr) {
+        // out of memory
+        break;
+      }
+      continue;
+    }
+
     if (node != nullptr) {
       if (match == TRI_FULLTEXT_COMPLETE) {
         // complete matching
@@ -1660,10 +1933,20 @@ TRI_fulltext_result_t* TRI_QueryFulltextIndex (TRI_fts_index_t* const ftx,
     }
   }
 
+  if (result != nullptr && numTerms > 0) {
+    // rank the results. this needs the lock as it reads the nodes' lists
+    scored = MakeScoredResult(idx, result, terms, numTerms, maxResults);
+  }
+
   TRI_ReadUnlockReadWriteLock(&idx->_lock);
 
   TRI_FreeQueryFulltextIndex(query);
 
+  if (numTerms > 0 && result != nullptr) {
+    // the handle list has already been consumed
+    return scored;
+  }
+
   if (result == nullptr) {
     // if we haven't found anything...
     return TRI_CreateResultFulltextIndex(0);
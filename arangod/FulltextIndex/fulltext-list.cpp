@@ -44,12 +44,91 @@
 
 #define SORTED_BIT 2147483648UL
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief we'll set this bit (the second highest of a uint32_t) if the list
+/// is packed
+///
+/// a packed list stores the bulk of its entries in delta + variable-byte
+/// encoded blocks and only the most recently inserted entries in an
+/// uncompressed tail. Small lists are never packed, so they don't pay for the
+/// bigger header
+////////////////////////////////////////////////////////////////////////////////
+
+#define PACKED_BIT 1073741824UL
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief we'll set this bit (the third highest of a uint32_t) if the list
+/// stores a term frequency for each entry. This is the case for the lists
+/// attached to index nodes, but not for the temporary lists built by queries
+////////////////////////////////////////////////////////////////////////////////
+
+#define FREQUENCY_BIT 536870912UL
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief all flag bits
+////////////////////////////////////////////////////////////////////////////////
+
+#define FLAG_BITS (SORTED_BIT | PACKED_BIT | FREQUENCY_BIT)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of entries per packed block. this is also the capacity of
+/// the uncompressed tail of a packed list, and the size at which an
+/// uncompressed list is turned into a packed one
+////////////////////////////////////////////////////////////////////////////////
+
+#define BLOCK_SIZE TRI_FULLTEXT_LIST_BLOCK_SIZE
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of bytes a variable-byte encoded uint32_t takes
+////////////////////////////////////////////////////////////////////////////////
+
+#define MAX_VARBYTE_LENGTH 5
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief above this size ratio, list intersection will gallop through the
+/// bigger list instead of scanning it
+////////////////////////////////////////////////////////////////////////////////
+
+#define GALLOP_RATIO 32
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not SSE2 is used to compare list entries
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#define FULLTEXT_SIMD 1
+#include <emmintrin.h>
+#else
+#undef FULLTEXT_SIMD
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief growth factor for lists
 ////////////////////////////////////////////////////////////////////////////////
 
 #define GROWTH_FACTOR 1.2
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     private types
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief skip pointer for a block of a packed list
+///
+/// the first value of a block is stored uncompressed in the skip pointer, so
+/// blocks can be located by galloping over the skip pointers without decoding
+/// any of them. All other values of the block are stored as variable-byte
+/// encoded deltas to their predecessor, starting at _offset in the list's
+/// data area. The deltas are followed by one frequency byte per value
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct block_s {
+  TRI_fulltext_list_entry_t _first;   // first (smallest) value in the block
+  uint32_t                  _offset;  // offset of the block's deltas
+  uint32_t                  _count;   // number of values in the block
+}
+block_t;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private functions
 // -----------------------------------------------------------------------------
@@ -73,6 +152,25 @@ static int CompareEntries (const void* lhs, const void* rhs) {
   return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compare two entries combined with their frequencies
+////////////////////////////////////////////////////////////////////////////////
+
+static int CompareCombinedEntries (const void* lhs, const void* rhs) {
+  uint64_t l = (*(uint64_t*) lhs);
+  uint64_t r = (*(uint64_t*) rhs);
+
+  if (l < r) {
+    return -1;
+  }
+
+  if (l > r) {
+    return 1;
+  }
+
+  return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return whether the list is sorted
 /// this will check the sorted bit at the start of the list
@@ -102,102 +200,901 @@ static inline void SetIsSorted (TRI_fulltext_list_t* const list,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return whether the list is packed
+////////////////////////////////////////////////////////////////////////////////
+
+static inline bool IsPacked (const TRI_fulltext_list_t* const list) {
+  uint32_t* head = (uint32_t*) list;
+
+  return ((*head & PACKED_BIT) != 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return whether the list stores frequencies
+////////////////////////////////////////////////////////////////////////////////
+
+static inline bool HasFrequencies (const TRI_fulltext_list_t* const list) {
+  uint32_t* head = (uint32_t*) list;
+
+  return ((*head & FREQUENCY_BIT) != 0);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the pointer to the start of the list entries
+/// for a packed list, these are the uncompressed entries in its tail
+////////////////////////////////////////////////////////////////////////////////
+
+static inline TRI_fulltext_list_entry_t* GetStart (const TRI_fulltext_list_t* const list) {
+  uint32_t* head = (uint32_t*) list;
+
+  if (IsPacked(list)) {
+    return (TRI_fulltext_list_entry_t*) (head + 8);
+  }
+
+  ++head; // numAllocated
+  ++head; // numEntries
+
+  return (TRI_fulltext_list_entry_t*) head;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of entries
+/// for a packed list, this is the number of entries in its tail
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint32_t GetNumEntries (const TRI_fulltext_list_t* const list) {
+  uint32_t* head = (uint32_t*) list;
+  return *(++head);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the number of entries
+////////////////////////////////////////////////////////////////////////////////
+
+static inline void SetNumEntries (TRI_fulltext_list_t* const list,
+                                  const uint32_t value) {
+  uint32_t* head = (uint32_t*) list;
+
+  *(++head) = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of allocated entries
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint32_t GetNumAllocated (TRI_fulltext_list_t const* list) {
+  uint32_t* head = (uint32_t*) list;
+
+  return (*head & ~FLAG_BITS);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return a header value of a packed list
+///
+/// the header of a packed list consists of the following uint32_t values:
+/// - numAllocated: size of the tail, plus the flag bits
+/// - numEntries: number of entries in the tail
+/// - numBlocks: number of blocks in use
+/// - blocksAllocated: number of skip pointers allocated
+/// - numBytes: number of bytes in use in the data area
+/// - bytesAllocated: size of the data area
+/// - lastPacked: the biggest value stored in any of the blocks
+/// - numPacked: the total number of values stored in the blocks
+/// it is followed by the tail, the tail's frequencies, the skip pointers and
+/// the data area
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint32_t GetPackedHeader (TRI_fulltext_list_t const* list,
+                                        size_t position) {
+  return ((uint32_t*) list)[position];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set a header value of a packed list
+////////////////////////////////////////////////////////////////////////////////
+
+static inline void SetPackedHeader (TRI_fulltext_list_t* list,
+                                    size_t position,
+                                    uint32_t value) {
+  ((uint32_t*) list)[position] = value;
+}
+
+static inline uint32_t GetNumBlocks (TRI_fulltext_list_t const* list) {
+  return GetPackedHeader(list, 2);
+}
+
+static inline uint32_t GetBlocksAllocated (TRI_fulltext_list_t const* list) {
+  return GetPackedHeader(list, 3);
+}
+
+static inline uint32_t GetNumBytes (TRI_fulltext_list_t const* list) {
+  return GetPackedHeader(list, 4);
+}
+
+static inline uint32_t GetBytesAllocated (TRI_fulltext_list_t const* list) {
+  return GetPackedHeader(list, 5);
+}
+
+static inline TRI_fulltext_list_entry_t GetLastPacked (TRI_fulltext_list_t const* list) {
+  return GetPackedHeader(list, 6);
+}
+
+static inline uint32_t GetNumPacked (TRI_fulltext_list_t const* list) {
+  return GetPackedHeader(list, 7);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the frequencies of a list that stores them
+/// for a packed list, these are the frequencies of the entries in its tail
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint8_t* GetFrequencies (TRI_fulltext_list_t const* list) {
+  if (IsPacked(list)) {
+    return (uint8_t*) (GetStart(list) + BLOCK_SIZE);
+  }
+
+  return (uint8_t*) (GetStart(list) + GetNumAllocated(list));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the skip pointers of a packed list
+////////////////////////////////////////////////////////////////////////////////
+
+static inline block_t* GetBlocks (TRI_fulltext_list_t const* list) {
+  return (block_t*) (GetFrequencies(list) + BLOCK_SIZE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the data area of a packed list
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint8_t* GetData (TRI_fulltext_list_t const* list) {
+  return (uint8_t*) (GetBlocks(list) + GetBlocksAllocated(list));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initialise a new list
+////////////////////////////////////////////////////////////////////////////////
+
+static void InitList (TRI_fulltext_list_t* list,
+                      uint32_t size) {
+  uint32_t* head = (uint32_t*) list;
+
+  *(head++) = size;
+  *(head) = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sort an array of entries and their frequencies in place
+/// frequencies may be a nullptr
+////////////////////////////////////////////////////////////////////////////////
+
+static bool SortEntries (TRI_fulltext_list_entry_t* entries,
+                         uint8_t* frequencies,
+                         uint32_t numEntries) {
+  uint64_t* combined;
+  uint32_t i;
+
+  if (numEntries < 2) {
+    return true;
+  }
+
+  if (frequencies == nullptr) {
+    qsort(entries, numEntries, sizeof(TRI_fulltext_list_entry_t), &CompareEntries);
+    return true;
+  }
+
+  // sort the entries together with their frequencies
+  combined = static_cast<uint64_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, numEntries * sizeof(uint64_t), false));
+
+  if (combined == nullptr) {
+    return false;
+  }
+
+  for (i = 0; i < numEntries; ++i) {
+    combined[i] = (((uint64_t) entries[i]) << 8) | frequencies[i];
+  }
+
+  qsort(combined, numEntries, sizeof(uint64_t), &CompareCombinedEntries);
+
+  for (i = 0; i < numEntries; ++i) {
+    entries[i]     = (TRI_fulltext_list_entry_t) (combined[i] >> 8);
+    frequencies[i] = (uint8_t) (combined[i] & 0xff);
+  }
+
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, combined);
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sort a list in place
+/// for a packed list, this will only sort the tail
+////////////////////////////////////////////////////////////////////////////////
+
+static bool SortList (TRI_fulltext_list_t* list) {
+  if (IsSorted(list)) {
+    // nothing to do
+    return true;
+  }
+
+  uint32_t numEntries = GetNumEntries(list);
+
+  if (! SortEntries(GetStart(list), HasFrequencies(list) ? GetFrequencies(list) : nullptr, numEntries)) {
+    return false;
+  }
+
+  if (! IsPacked(list) ||
+      numEntries == 0 ||
+      GetNumPacked(list) == 0 ||
+      GetStart(list)[0] > GetLastPacked(list)) {
+    SetIsSorted(list, true);
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove duplicates from a sorted array of entries
+/// frequencies may be a nullptr
+/// returns the number of entries remaining
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t UniqueEntries (TRI_fulltext_list_entry_t* entries,
+                               uint8_t* frequencies,
+                               uint32_t numEntries) {
+  uint32_t i, j;
+
+  if (numEntries < 2) {
+    return numEntries;
+  }
+
+  j = 1;
+  for (i = 1; i < numEntries; ++i) {
+    if (entries[i] != entries[j - 1]) {
+      if (frequencies != nullptr) {
+        frequencies[j] = frequencies[i];
+      }
+      entries[j++] = entries[i];
+    }
+  }
+
+  return j;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the position of the first entry not less than value
+/// the entries must be sorted. The search starts at position pos
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint32_t AdvanceTo (TRI_fulltext_list_entry_t const* entries,
+                                  uint32_t pos,
+                                  const uint32_t numEntries,
+                                  const TRI_fulltext_list_entry_t value) {
+  while (pos + 8 <= numEntries && entries[pos + 7] < value) {
+    pos += 8;
+  }
+
+#ifdef FULLTEXT_SIMD
+  if (pos + 8 <= numEntries) {
+    // the result is within the next 8 entries. compare them all at once and
+    // count how many are less than the value. SSE2 only has a signed
+    // comparison, so flip the sign bits first
+    __m128i const bias  = _mm_set1_epi32(INT32_MIN);
+    __m128i const probe = _mm_xor_si128(_mm_set1_epi32((int32_t) value), bias);
+    __m128i const lo    = _mm_xor_si128(_mm_loadu_si128((__m128i const*) (entries + pos)), bias);
+    __m128i const hi    = _mm_xor_si128(_mm_loadu_si128((__m128i const*) (entries + pos + 4)), bias);
+
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(lo, probe))) |
+               (_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(hi, probe))) << 4);
+
+    return pos + (uint32_t) __builtin_popcount(mask);
+  }
+#endif
+
+  while (pos < numEntries && entries[pos] < value) {
+    ++pos;
+  }
+
+  return pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the position of the first entry not less than value, using
+/// exponential search. this is faster than AdvanceTo when the entries are
+/// expected to be far apart
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint32_t GallopTo (TRI_fulltext_list_entry_t const* entries,
+                                 uint32_t pos,
+                                 const uint32_t numEntries,
+                                 const TRI_fulltext_list_entry_t value) {
+  uint32_t step = 1;
+  uint32_t hi = pos;
+
+  while (hi < numEntries && entries[hi] < value) {
+    pos = hi + 1;
+    hi += step;
+    step <<= 1;
+  }
+
+  if (hi > numEntries) {
+    hi = numEntries;
+  }
+
+  // the result is now in [pos, hi]
+  while (pos < hi) {
+    uint32_t mid = pos + (hi - pos) / 2;
+
+    if (entries[mid] < value) {
+      pos = mid + 1;
+    }
+    else {
+      hi = mid;
+    }
+  }
+
+  return pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief variable-byte encode a value
+/// returns the number of bytes written
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint32_t EncodeVarByte (uint8_t* p,
+                                      uint32_t value) {
+  uint32_t n = 0;
+
+  while (value >= 0x80) {
+    p[n++] = (uint8_t) (value | 0x80);
+    value >>= 7;
+  }
+  p[n++] = (uint8_t) value;
+
+  return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief decode a variable-byte encoded value
+/// returns the position after the value
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint8_t const* DecodeVarByte (uint8_t const* p,
+                                            uint32_t* value) {
+  uint32_t result = *p & 0x7f;
+  uint32_t shift = 7;
+
+  while (*p & 0x80) {
+    ++p;
+    result |= (uint32_t) (*p & 0x7f) << shift;
+    shift += 7;
+  }
+
+  *value = result;
+
+  return p + 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief decode a block of a packed list into buffers
+/// the buffers must have room for BLOCK_SIZE entries. frequencies may be a
+/// nullptr if the caller is not interested in them
+/// returns the number of entries decoded
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t DecodeBlock (TRI_fulltext_list_t const* list,
+                             uint32_t index,
+                             TRI_fulltext_list_entry_t* buffer,
+                             uint8_t* frequencies) {
+  block_t const* block = GetBlocks(list) + index;
+  uint8_t const* p = GetData(list) + block->_offset;
+  TRI_fulltext_list_entry_t value = block->_first;
+  uint32_t const count = block->_count;
+  uint32_t i;
+
+  buffer[0] = value;
+
+  for (i = 1; i < count; ++i) {
+    uint32_t delta;
+
+    p = DecodeVarByte(p, &delta);
+    value += delta;
+    buffer[i] = value;
+  }
+
+  if (frequencies != nullptr) {
+    memcpy(frequencies, p, count);
+  }
+
+  return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief find the last block whose first value is not greater than value
+/// the search gallops forward from block lo, whose first value must not be
+/// greater than value
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t FindBlock (block_t const* blocks,
+                           const uint32_t numBlocks,
+                           uint32_t lo,
+                           const TRI_fulltext_list_entry_t value) {
+  uint32_t step = 1;
+  uint32_t hi = lo + 1;
+
+  while (hi < numBlocks && blocks[hi]._first <= value) {
+    lo = hi;
+    step <<= 1;
+    hi = lo + step;
+  }
+
+  if (hi > numBlocks) {
+    hi = numBlocks;
+  }
+
+  while (hi - lo > 1) {
+    uint32_t mid = lo + (hi - lo) / 2;
+
+    if (blocks[mid]._first <= value) {
+      lo = mid;
+    }
+    else {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the memory usage for a list of the specified size
+////////////////////////////////////////////////////////////////////////////////
+
+static inline size_t MemoryList (const uint32_t size) {
+  return sizeof(uint32_t) + // numAllocated
+         sizeof(uint32_t) + // numEntries
+         size * sizeof(TRI_fulltext_list_entry_t); // entries
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the memory usage for a list with frequencies of the specified
+/// size
+////////////////////////////////////////////////////////////////////////////////
+
+static inline size_t MemoryNodeList (const uint32_t size) {
+  return MemoryList(size) +
+         size * sizeof(uint8_t); // frequencies
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the memory usage for a packed list of the specified sizes
+////////////////////////////////////////////////////////////////////////////////
+
+static inline size_t MemoryPackedList (const uint32_t blocksAllocated,
+                                       const uint32_t bytesAllocated) {
+  return 8 * sizeof(uint32_t) + // header
+         BLOCK_SIZE * sizeof(TRI_fulltext_list_entry_t) + // tail
+         BLOCK_SIZE * sizeof(uint8_t) + // tail frequencies
+         blocksAllocated * sizeof(block_t) + // skip pointers
+         bytesAllocated; // data
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief increase an existing list with frequencies
+/// the frequencies are moved behind the enlarged entries
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_fulltext_list_t* IncreaseList (TRI_fulltext_list_t* list,
+                                          const uint32_t size) {
+  uint32_t const oldSize = GetNumAllocated(list);
+  uint32_t const flags = (*(uint32_t*) list) & FLAG_BITS;
+
+  TRI_fulltext_list_t* copy = TRI_Reallocate(TRI_UNKNOWN_MEM_ZONE, list, MemoryNodeList(size));
+
+  if (copy != nullptr) {
+    TRI_fulltext_list_entry_t* entries = GetStart(copy);
+
+    memmove(entries + size, entries + oldSize, GetNumEntries(copy) * sizeof(uint8_t));
+    *((uint32_t*) copy) = size | flags;
+  }
+
+  return copy;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a new, empty packed list
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_fulltext_list_t* CreatePackedList (const uint32_t blocksAllocated,
+                                              const uint32_t bytesAllocated) {
+  TRI_fulltext_list_t* list = TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, MemoryPackedList(blocksAllocated, bytesAllocated), false);
+
+  if (list == nullptr) {
+    // out of memory
+    return nullptr;
+  }
+
+  SetPackedHeader(list, 0, BLOCK_SIZE | PACKED_BIT | SORTED_BIT | FREQUENCY_BIT);
+  SetPackedHeader(list, 1, 0);
+  SetPackedHeader(list, 2, 0);
+  SetPackedHeader(list, 3, blocksAllocated);
+  SetPackedHeader(list, 4, 0);
+  SetPackedHeader(list, 5, bytesAllocated);
+  SetPackedHeader(list, 6, 0);
+  SetPackedHeader(list, 7, 0);
+
+  return list;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief increase the skip pointers and data area of a packed list
+/// the data area is moved behind the enlarged skip pointers
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_fulltext_list_t* IncreasePackedList (TRI_fulltext_list_t* list,
+                                                const uint32_t blocksAllocated,
+                                                const uint32_t bytesAllocated) {
+  uint32_t const oldBlocksAllocated = GetBlocksAllocated(list);
+  uint32_t const numBytes = GetNumBytes(list);
+
+  TRI_fulltext_list_t* copy = TRI_Reallocate(TRI_UNKNOWN_MEM_ZONE, list, MemoryPackedList(blocksAllocated, bytesAllocated));
+
+  if (copy == nullptr) {
+    return nullptr;
+  }
+
+  if (blocksAllocated != oldBlocksAllocated) {
+    block_t* blocks = GetBlocks(copy);
+
+    memmove(blocks + blocksAllocated, blocks + oldBlocksAllocated, numBytes);
+  }
+
+  SetPackedHeader(copy, 3, blocksAllocated);
+  SetPackedHeader(copy, 5, bytesAllocated);
+
+  return copy;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append a block of values to a packed list
+/// the values must be sorted, unique and bigger than any value already packed
+/// this might free the old list and allocate a new, bigger one
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_fulltext_list_t* AppendBlock (TRI_fulltext_list_t* list,
+                                         TRI_fulltext_list_entry_t const* entries,
+                                         uint8_t const* frequencies,
+                                         const uint32_t numEntries) {
+  uint32_t numBlocks       = GetNumBlocks(list);
+  uint32_t blocksAllocated = GetBlocksAllocated(list);
+  uint32_t numBytes        = GetNumBytes(list);
+  uint32_t bytesAllocated  = GetBytesAllocated(list);
+  uint32_t const maxBytes  = (numEntries - 1) * MAX_VARBYTE_LENGTH + numEntries;
+
+  if (numBlocks == blocksAllocated ||
+      numBytes + maxBytes > bytesAllocated) {
+    if (numBlocks == blocksAllocated) {
+      blocksAllocated = (uint32_t) (blocksAllocated * GROWTH_FACTOR);
+
+      if (blocksAllocated == numBlocks) {
+        blocksAllocated = numBlocks + 1;
+      }
+    }
+
+    if (numBytes + maxBytes > bytesAllocated) {
+      bytesAllocated = (uint32_t) (bytesAllocated * GROWTH_FACTOR);
+
+      if (bytesAllocated < numBytes + maxBytes) {
+        bytesAllocated = numBytes + maxBytes;
+      }
+    }
+
+    list = IncreasePackedList(list, blocksAllocated, bytesAllocated);
+
+    if (list == nullptr) {
+      return nullptr;
+    }
+  }
+
+  block_t* block = GetBlocks(list) + numBlocks;
+  uint8_t* data  = GetData(list);
+  uint32_t i;
+
+  block->_first  = entries[0];
+  block->_offset = numBytes;
+  block->_count  = numEntries;
+
+  for (i = 1; i < numEntries; ++i) {
+    numBytes += EncodeVarByte(data + numBytes, entries[i] - entries[i - 1]);
+  }
+
+  memcpy(data + numBytes, frequencies, numEntries);
+  numBytes += numEntries;
+
+  SetPackedHeader(list, 2, numBlocks + 1);
+  SetPackedHeader(list, 4, numBytes);
+  SetPackedHeader(list, 6, entries[numEntries - 1]);
+  SetPackedHeader(list, 7, GetNumPacked(list) + numEntries);
+
+  return list;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
+/// @brief build a packed list from sorted, unique values
+/// all full blocks are packed, the remaining values are put into the tail
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_fulltext_list_t* BuildPackedList (TRI_fulltext_list_entry_t const* entries,
+                                             uint8_t const* frequencies,
+                                             const uint32_t numEntries) {
+  uint32_t const numBlocks = numEntries / BLOCK_SIZE;
+  uint32_t const numTail = numEntries % BLOCK_SIZE;
+  uint32_t i;
+
+  TRI_fulltext_list_t* list = CreatePackedList(numBlocks, numBlocks * BLOCK_SIZE * 3);
+
+  if (list == nullptr) {
+    return nullptr;
+  }
+
+  for (i = 0; i < numBlocks; ++i) {
+    TRI_fulltext_list_t* next = AppendBlock(list, entries + i * BLOCK_SIZE, frequencies + i * BLOCK_SIZE, BLOCK_SIZE);
+
+    if (next == nullptr) {
+      TRI_FreeListFulltextIndex(list);
+      return nullptr;
+    }
+
+    list = next;
+  }
+
+  if (numTail > 0) {
+    memcpy(GetStart(list), entries + numBlocks * BLOCK_SIZE, numTail * sizeof(TRI_fulltext_list_entry_t));
+    memcpy(GetFrequencies(list), frequencies + numBlocks * BLOCK_SIZE, numTail * sizeof(uint8_t));
+    SetNumEntries(list, numTail);
+  }
+
+  return list;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build a packed list from all values of a list, sorting them
+/// this will free the original list on success
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_fulltext_list_t* RepackList (TRI_fulltext_list_t* list) {
+  uint32_t numEntries = TRI_NumEntriesListFulltextIndex(list);
+  uint32_t const numBlocks = GetNumBlocks(list);
+  uint32_t i, pos;
+
+  TRI_fulltext_list_entry_t* entries = static_cast<TRI_fulltext_list_entry_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, numEntries * (sizeof(TRI_fulltext_list_entry_t) + sizeof(uint8_t)), false));
+
+  if (entries == nullptr) {
+    return nullptr;
+  }
+
+  uint8_t* frequencies = (uint8_t*) (entries + numEntries);
+
+  pos = 0;
+  for (i = 0; i < numBlocks; ++i) {
+    pos += DecodeBlock(list, i, entries + pos, frequencies + pos);
+  }
+
+  memcpy(entries + pos, GetStart(list), GetNumEntries(list) * sizeof(TRI_fulltext_list_entry_t));
+  memcpy(frequencies + pos, GetFrequencies(list), GetNumEntries(list) * sizeof(uint8_t));
+
+  TRI_fulltext_list_t* packed = nullptr;
+
+  if (SortEntries(entries, frequencies, numEntries)) {
+    numEntries = UniqueEntries(entries, frequencies, numEntries);
+    packed = BuildPackedList(entries, frequencies, numEntries);
+  }
+
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, entries);
+
+  if (packed != nullptr) {
+    TRI_FreeListFulltextIndex(list);
+  }
+
+  return packed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief move the tail of a packed list into a new block
+/// this might free the old list and allocate a new, bigger one
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_fulltext_list_t* PackTail (TRI_fulltext_list_t* list) {
+  TRI_fulltext_list_entry_t buffer[BLOCK_SIZE];
+  uint8_t frequencies[BLOCK_SIZE];
+  uint32_t numEntries;
+
+  if (! SortList(list)) {
+    return nullptr;
+  }
+
+  numEntries = UniqueEntries(GetStart(list), GetFrequencies(list), GetNumEntries(list));
+  SetNumEntries(list, numEntries);
+
+  if (GetNumPacked(list) > 0 && GetStart(list)[0] <= GetLastPacked(list)) {
+    // tail values overlap with packed values. this does not happen when
+    // handles are inserted in ascending order
+    return RepackList(list);
+  }
 
-static inline TRI_fulltext_list_entry_t* GetStart (const TRI_fulltext_list_t* const list) {
-  uint32_t* head = (uint32_t*) list;
-  ++head; // numAllocated
-  ++head; // numEntries
+  // the tail is part of the list's memory, which might be moved by the append
+  memcpy(buffer, GetStart(list), numEntries * sizeof(TRI_fulltext_list_entry_t));
+  memcpy(frequencies, GetFrequencies(list), numEntries * sizeof(uint8_t));
 
-  return (TRI_fulltext_list_entry_t*) head;
-}
+  TRI_fulltext_list_t* copy = AppendBlock(list, buffer, frequencies, numEntries);
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief return the number of entries
-////////////////////////////////////////////////////////////////////////////////
+  if (copy != nullptr) {
+    SetNumEntries(copy, 0);
+    SetIsSorted(copy, true);
+  }
 
-static inline uint32_t GetNumEntries (const TRI_fulltext_list_t* const list) {
-  uint32_t* head = (uint32_t*) list;
-  return *(++head);
+  return copy;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief set the number of entries
+/// @brief turn a full uncompressed list into a packed one
+/// if the list contains duplicates, they are removed and the list is
+/// returned uncompressed
+/// this will free the original list if a packed list is returned
 ////////////////////////////////////////////////////////////////////////////////
 
-static inline void SetNumEntries (TRI_fulltext_list_t* const list,
-                                  const uint32_t value) {
-  uint32_t* head = (uint32_t*) list;
+static TRI_fulltext_list_t* PackList (TRI_fulltext_list_t* list) {
+  uint32_t numEntries;
 
-  *(++head) = value;
-}
+  if (! SortList(list)) {
+    return nullptr;
+  }
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief return the number of allocated entries
-////////////////////////////////////////////////////////////////////////////////
+  numEntries = UniqueEntries(GetStart(list), GetFrequencies(list), GetNumEntries(list));
+  SetNumEntries(list, numEntries);
 
-static inline uint32_t GetNumAllocated (TRI_fulltext_list_t const* list) {
-  uint32_t* head = (uint32_t*) list;
+  if (numEntries < BLOCK_SIZE) {
+    return list;
+  }
+
+  TRI_fulltext_list_t* packed = BuildPackedList(GetStart(list), GetFrequencies(list), numEntries);
 
-  return (*head & ~SORTED_BIT);
+  if (packed != nullptr) {
+    TRI_FreeListFulltextIndex(list);
+  }
+
+  return packed;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief initialise a new list
+/// @brief insert an element into a packed list
+/// this might free the old list and allocate a new, bigger one
 ////////////////////////////////////////////////////////////////////////////////
 
-static void InitList (TRI_fulltext_list_t* list,
-                      uint32_t size) {
-  uint32_t* head = (uint32_t*) list;
+static TRI_fulltext_list_t* InsertPackedList (TRI_fulltext_list_t* list,
+                                              const TRI_fulltext_list_entry_t entry,
+                                              const uint8_t frequency) {
+  uint32_t numEntries = GetNumEntries(list);
 
-  *(head++) = size;
-  *(head) = 0;
-}
+  if (numEntries > 0) {
+    if (entry == GetStart(list)[numEntries - 1]) {
+      // entry is already contained. no need to insert the same value again
+      return list;
+    }
+  }
+  else if (GetNumPacked(list) > 0 && entry == GetLastPacked(list)) {
+    return list;
+  }
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief sort a list in place
-////////////////////////////////////////////////////////////////////////////////
+  if (numEntries == BLOCK_SIZE) {
+    // tail is full
+    list = PackTail(list);
 
-static void SortList (TRI_fulltext_list_t* list) {
-  if (IsSorted(list)) {
-    // nothing to do
-    return;
+    if (list == nullptr) {
+      return nullptr;
+    }
+
+    numEntries = GetNumEntries(list);
   }
 
-  uint32_t numEntries = GetNumEntries(list);
+  TRI_fulltext_list_entry_t* listEntries = GetStart(list);
 
-  if (numEntries > 1) {
-    // only sort if more than one elements
-    qsort(GetStart(list), numEntries, sizeof(TRI_fulltext_list_entry_t), &CompareEntries);
+  if ((numEntries > 0 && entry < listEntries[numEntries - 1]) ||
+      (GetNumPacked(list) > 0 && entry <= GetLastPacked(list))) {
+    SetIsSorted(list, false);
   }
 
-  SetIsSorted(list, true);
+  // insert at the end of the tail
+  listEntries[numEntries] = entry;
+  GetFrequencies(list)[numEntries] = frequency;
+  SetNumEntries(list, numEntries + 1);
+
+  return list;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief get the memory usage for a list of the specified size
+/// @brief rewrites the blocks of a packed list using a map of handles
+/// returns the number of values remaining in the blocks
+///
+/// the map is order-preserving and never increases a value, so the delta
+/// between two remaining values is never bigger than the sum of the deltas
+/// they originally spanned, and there is at most one frequency byte per
+/// remaining value. The rewritten data therefore never overtakes the data
+/// still to be read, and the list can be rewritten in place
 ////////////////////////////////////////////////////////////////////////////////
 
-static inline size_t MemoryList (const uint32_t size) {
-  return sizeof(uint32_t) + // numAllocated
-         sizeof(uint32_t) + // numEntries
-         size * sizeof(TRI_fulltext_list_entry_t); // entries
+static uint32_t RewriteBlocks (TRI_fulltext_list_t* list,
+                               TRI_fulltext_list_entry_t const* map) {
+  TRI_fulltext_list_entry_t buffer[BLOCK_SIZE];
+  uint8_t frequencies[BLOCK_SIZE];
+  block_t* blocks = GetBlocks(list);
+  uint8_t* data = GetData(list);
+  uint32_t const numBlocks = GetNumBlocks(list);
+  uint32_t numPacked = 0;
+  uint32_t numBytes = 0;
+  uint32_t lastPacked = 0;
+  uint32_t i, j, k;
+
+  k = 0;
+
+  for (i = 0; i < numBlocks; ++i) {
+    uint32_t const count = DecodeBlock(list, i, buffer, frequencies);
+    uint32_t remain = 0;
+
+    for (j = 0; j < count; ++j) {
+      TRI_fulltext_list_entry_t mapped = map[buffer[j]];
+
+      if (mapped != 0) {
+        frequencies[remain] = frequencies[j];
+        buffer[remain++] = mapped;
+      }
+    }
+
+    if (remain == 0) {
+      // all values of the block have been deleted
+      continue;
+    }
+
+    blocks[k]._first  = buffer[0];
+    blocks[k]._offset = numBytes;
+    blocks[k]._count  = remain;
+
+    for (j = 1; j < remain; ++j) {
+      numBytes += EncodeVarByte(data + numBytes, buffer[j] - buffer[j - 1]);
+    }
+
+    memmove(data + numBytes, frequencies, remain);
+    numBytes += remain;
+
+    lastPacked = buffer[remain - 1];
+    numPacked += remain;
+    ++k;
+  }
+
+  SetPackedHeader(list, 2, k);
+  SetPackedHeader(list, 4, numBytes);
+  SetPackedHeader(list, 6, lastPacked);
+  SetPackedHeader(list, 7, numPacked);
+
+  return numPacked;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief increase an existing list
+/// @brief turn a packed list into an uncompressed one
+/// the set operations only work on uncompressed lists. lists that are not
+/// packed are returned as they are, packed lists are freed
 ////////////////////////////////////////////////////////////////////////////////
 
-static TRI_fulltext_list_t* IncreaseList (TRI_fulltext_list_t* list,
-                                          const uint32_t size) {
-  TRI_fulltext_list_t* copy = TRI_Reallocate(TRI_UNKNOWN_MEM_ZONE, list, MemoryList(size));
-
-  if (copy != nullptr) {
-    InitList(copy, size);
+static TRI_fulltext_list_t* UnpackList (TRI_fulltext_list_t* list) {
+  if (list == nullptr || ! IsPacked(list)) {
+    return list;
   }
 
+  TRI_fulltext_list_t* copy = TRI_CloneListFulltextIndex(list);
+  TRI_FreeListFulltextIndex(list);
+
   return copy;
 }
 
@@ -216,16 +1113,28 @@ TRI_fulltext_list_t* TRI_CloneListFulltextIndex (TRI_fulltext_list_t const* sour
     numEntries = 0;
   }
   else {
-    numEntries = GetNumEntries(source);
+    numEntries = TRI_NumEntriesListFulltextIndex(source);
   }
 
   TRI_fulltext_list_t* list = TRI_CreateListFulltextIndex(numEntries);
 
-  if (list != nullptr) {
-    if (numEntries > 0) {
-      memcpy(GetStart(list), GetStart(source), numEntries * sizeof(TRI_fulltext_list_entry_t));
-      SetNumEntries(list, numEntries);
+  if (list != nullptr && numEntries > 0) {
+    TRI_fulltext_list_entry_t* listEntries = GetStart(list);
+    uint32_t numTail = GetNumEntries(source);
+
+    if (IsPacked(source)) {
+      // decode all blocks, followed by the uncompressed tail
+      uint32_t const numBlocks = GetNumBlocks(source);
+      uint32_t i;
+
+      for (i = 0; i < numBlocks; ++i) {
+        listEntries += DecodeBlock(source, i, listEntries, nullptr);
+      }
     }
+
+    memcpy(listEntries, GetStart(source), numTail * sizeof(TRI_fulltext_list_entry_t));
+    SetNumEntries(list, numEntries);
+    SetIsSorted(list, IsSorted(source));
   }
 
   return list;
@@ -248,6 +1157,25 @@ TRI_fulltext_list_t* TRI_CreateListFulltextIndex (const uint32_t size) {
   return list;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a new list for an index node
+/// in addition to the handles, these lists store a term frequency per handle
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_fulltext_list_t* TRI_CreateNodeListFulltextIndex (const uint32_t size) {
+  TRI_fulltext_list_t* list = TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, MemoryNodeList(size), false);
+
+  if (list == nullptr) {
+    // out of memory
+    return nullptr;
+  }
+
+  InitList(list, size);
+  *((uint32_t*) list) |= FREQUENCY_BIT;
+
+  return list;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief free a list
 ////////////////////////////////////////////////////////////////////////////////
@@ -265,7 +1193,16 @@ void TRI_FreeListFulltextIndex (TRI_fulltext_list_t* list) {
 ////////////////////////////////////////////////////////////////////////////////
 
 size_t TRI_MemoryListFulltextIndex (TRI_fulltext_list_t const* list) {
+  if (IsPacked(list)) {
+    return MemoryPackedList(GetBlocksAllocated(list), GetBytesAllocated(list));
+  }
+
   uint32_t size = GetNumAllocated(list);
+
+  if (HasFrequencies(list)) {
+    return MemoryNodeList(size);
+  }
+
   return MemoryList(size);
 }
 
@@ -286,10 +1223,24 @@ TRI_fulltext_list_t* TRI_UnioniseListFulltextIndex (TRI_fulltext_list_t* lhs,
   uint32_t listPos;
 
   if (lhs == nullptr) {
-    return rhs;
+    return UnpackList(rhs);
   }
   if (rhs == nullptr) {
-    return lhs;
+    return UnpackList(lhs);
+  }
+
+  lhs = UnpackList(lhs);
+  rhs = UnpackList(rhs);
+
+  if (lhs == nullptr || rhs == nullptr) {
+    // out of memory
+    if (lhs != nullptr) {
+      TRI_FreeListFulltextIndex(lhs);
+    }
+    if (rhs != nullptr) {
+      TRI_FreeListFulltextIndex(rhs);
+    }
+    return nullptr;
   }
 
   numLhs = GetNumEntries(lhs);
@@ -370,8 +1321,8 @@ TRI_fulltext_list_t* TRI_IntersectListFulltextIndex (TRI_fulltext_list_t* lhs,
                                                      TRI_fulltext_list_t* rhs) {
   TRI_fulltext_list_t* list;
   TRI_fulltext_list_entry_t last;
-  TRI_fulltext_list_entry_t* lhsEntries;
-  TRI_fulltext_list_entry_t* rhsEntries;
+  TRI_fulltext_list_entry_t const* lhsEntries;
+  TRI_fulltext_list_entry_t const* rhsEntries;
   TRI_fulltext_list_entry_t* listEntries;
   uint32_t l, r;
   uint32_t numLhs, numRhs;
@@ -379,11 +1330,25 @@ TRI_fulltext_list_t* TRI_IntersectListFulltextIndex (TRI_fulltext_list_t* lhs,
 
   // check if one of the pointers is NULL
   if (lhs == nullptr) {
-    return rhs;
+    return UnpackList(rhs);
   }
 
   if (rhs == nullptr) {
-    return lhs;
+    return UnpackList(lhs);
+  }
+
+  lhs = UnpackList(lhs);
+  rhs = UnpackList(rhs);
+
+  if (lhs == nullptr || rhs == nullptr) {
+    // out of memory
+    if (lhs != nullptr) {
+      TRI_FreeListFulltextIndex(lhs);
+    }
+    if (rhs != nullptr) {
+      TRI_FreeListFulltextIndex(rhs);
+    }
+    return nullptr;
   }
 
   numLhs = GetNumEntries(lhs);
@@ -413,44 +1378,48 @@ TRI_fulltext_list_t* TRI_IntersectListFulltextIndex (TRI_fulltext_list_t* lhs,
   }
 
   SortList(lhs);
-  lhsEntries = GetStart(lhs);
-  l = 0;
-
   SortList(rhs);
-  rhsEntries = GetStart(rhs);
-  r = 0;
+
+  // iterate over the smaller list and look up its values in the bigger one
+  if (numLhs <= numRhs) {
+    lhsEntries = GetStart(lhs);
+    rhsEntries = GetStart(rhs);
+  }
+  else {
+    lhsEntries = GetStart(rhs);
+    rhsEntries = GetStart(lhs);
+    std::swap(numLhs, numRhs);
+  }
 
   listPos = 0;
   listEntries = GetStart(list);
   last = 0;
+  r = 0;
 
-  while (true) {
-    while (l < numLhs && lhsEntries[l] <= last) {
-      ++l;
+  bool const gallop = (numRhs / numLhs >= GALLOP_RATIO);
+
+  for (l = 0; l < numLhs; ++l) {
+    TRI_fulltext_list_entry_t const entry = lhsEntries[l];
+
+    if (entry <= last) {
+      continue;
     }
 
-    while (r < numRhs && rhsEntries[r] <= last) {
-      ++r;
+    if (gallop) {
+      r = GallopTo(rhsEntries, r, numRhs, entry);
+    }
+    else {
+      r = AdvanceTo(rhsEntries, r, numRhs, entry);
     }
 
-again:
-    if (l >= numLhs || r >= numRhs) {
+    if (r >= numRhs) {
       break;
     }
 
-    if (lhsEntries[l] < rhsEntries[r]) {
-      ++l;
-      goto again;
-    }
-    else if (lhsEntries[l] > rhsEntries[r]) {
-      ++r;
-      goto again;
+    if (rhsEntries[r] == entry) {
+      // match
+      listEntries[listPos++] = last = entry;
     }
-
-    // match
-    listEntries[listPos++] = last = lhsEntries[l];
-    ++l;
-    ++r;
   }
 
   SetNumEntries(list, listPos);
@@ -464,6 +1433,60 @@ again:
   return list;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief intersect a list with the list of an index node (a.k.a. logical AND)
+/// this will modify lhs in place and leave the node's list untouched
+///
+/// if the node's list is packed, only the blocks that may contain a value of
+/// lhs are decoded. The blocks are found by galloping over the skip pointers,
+/// so intersecting a short list with a long one is cheap
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_fulltext_list_t* TRI_IntersectNodeListFulltextIndex (TRI_fulltext_list_t* lhs,
+                                                         TRI_fulltext_list_t const* node) {
+  TRI_fulltext_list_iterator_t iterator;
+  TRI_fulltext_list_entry_t* listEntries;
+  uint32_t numEntries;
+  uint32_t i, listPos;
+
+  if (lhs == nullptr) {
+    return TRI_CloneListFulltextIndex(node);
+  }
+
+  if (node == nullptr || ! IsPacked(node)) {
+    // nothing to skip in an uncompressed list
+    TRI_fulltext_list_t* rhs = TRI_CloneListFulltextIndex(node);
+
+    if (rhs == nullptr) {
+      TRI_FreeListFulltextIndex(lhs);
+      return nullptr;
+    }
+
+    return TRI_IntersectListFulltextIndex(lhs, rhs);
+  }
+
+  if (! SortList(lhs)) {
+    TRI_FreeListFulltextIndex(lhs);
+    return nullptr;
+  }
+
+  numEntries = UniqueEntries(GetStart(lhs), nullptr, GetNumEntries(lhs));
+  listEntries = GetStart(lhs);
+  listPos = 0;
+
+  TRI_InitIteratorListFulltextIndex(&iterator, node);
+
+  for (i = 0; i < numEntries; ++i) {
+    if (TRI_SeekIteratorListFulltextIndex(&iterator, listEntries[i], nullptr)) {
+      listEntries[listPos++] = listEntries[i];
+    }
+  }
+
+  SetNumEntries(lhs, listPos);
+
+  return lhs;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief exclude values from a list
 /// this will modify list in place
@@ -529,17 +1552,35 @@ TRI_fulltext_list_t* TRI_ExcludeListFulltextIndex (TRI_fulltext_list_t* list,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief insert an element into a list
-/// this might free the old list and allocate a new, bigger one
+/// @brief insert an element into the list of an index node
+/// this might free the old list and allocate a new, bigger one. Frequencies
+/// are stored in a single byte, so they are capped at 255
 ////////////////////////////////////////////////////////////////////////////////
 
 TRI_fulltext_list_t* TRI_InsertListFulltextIndex (TRI_fulltext_list_t* list,
-                                                  const TRI_fulltext_list_entry_t entry) {
+                                                  const TRI_fulltext_list_entry_t entry,
+                                                  const uint32_t frequency) {
+  uint8_t const compressed = (uint8_t) (frequency > UINT8_MAX ? UINT8_MAX : frequency);
   TRI_fulltext_list_entry_t* listEntries;
   uint32_t numAllocated;
   uint32_t numEntries;
   bool unsort;
 
+  TRI_ASSERT(HasFrequencies(list));
+
+  if (! IsPacked(list) && GetNumEntries(list) >= BLOCK_SIZE) {
+    // the list has grown big enough to be worth compressing
+    list = PackList(list);
+
+    if (list == nullptr) {
+      return nullptr;
+    }
+  }
+
+  if (IsPacked(list)) {
+    return InsertPackedList(list, entry, compressed);
+  }
+
   numAllocated = GetNumAllocated(list);
   numEntries   = GetNumEntries(list);
   listEntries  = GetStart(list);
@@ -562,7 +1603,7 @@ TRI_fulltext_list_t* TRI_InsertListFulltextIndex (TRI_fulltext_list_t* list,
     }
   }
 
-  if (numEntries + 1 >= numAllocated) {
+  if (numEntries >= numAllocated) {
     // must allocate more memory
     TRI_fulltext_list_t* clone;
     uint32_t newSize;
@@ -574,6 +1615,11 @@ TRI_fulltext_list_t* TRI_InsertListFulltextIndex (TRI_fulltext_list_t* list,
       newSize = numEntries + 1;
     }
 
+    if (newSize > BLOCK_SIZE) {
+      // the list will be packed when it grows beyond this size
+      newSize = BLOCK_SIZE;
+    }
+
     // increase the existing list
     clone = IncreaseList(list, newSize);
     if (clone == nullptr) {
@@ -593,6 +1639,7 @@ TRI_fulltext_list_t* TRI_InsertListFulltextIndex (TRI_fulltext_list_t* list,
 
   // insert at the end
   listEntries[numEntries] = entry;
+  GetFrequencies(list)[numEntries] = compressed;
   SetNumEntries(list, numEntries + 1);
 
   return list;
@@ -608,16 +1655,25 @@ uint32_t TRI_RewriteListFulltextIndex (TRI_fulltext_list_t* list,
                                        void const* data) {
   TRI_fulltext_list_entry_t* listEntries;
   TRI_fulltext_list_entry_t* map;
+  uint8_t* frequencies;
   uint32_t numEntries;
+  uint32_t numPacked;
   uint32_t i, j;
 
+  map = (TRI_fulltext_list_entry_t*) data;
+  numPacked = 0;
+
+  if (IsPacked(list)) {
+    numPacked = RewriteBlocks(list, map);
+  }
+
   numEntries  = GetNumEntries(list);
   if (numEntries == 0) {
-    return 0;
+    return numPacked;
   }
 
-  map = (TRI_fulltext_list_entry_t*) data;
   listEntries = GetStart(list);
+  frequencies = HasFrequencies(list) ? GetFrequencies(list) : nullptr;
   j = 0;
 
   for (i = 0; i < numEntries; ++i) {
@@ -635,6 +1691,9 @@ uint32_t TRI_RewriteListFulltextIndex (TRI_fulltext_list_t* list,
       continue;
     }
 
+    if (frequencies != nullptr) {
+      frequencies[j] = frequencies[i];
+    }
     listEntries[j++] = mapped;
   }
 
@@ -642,7 +1701,111 @@ uint32_t TRI_RewriteListFulltextIndex (TRI_fulltext_list_t* list,
     SetNumEntries(list, j);
   }
 
-  return j;
+  return numPacked + j;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initialise an iterator over the list of an index node
+/// the list must not be modified while the iterator is in use
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_InitIteratorListFulltextIndex (TRI_fulltext_list_iterator_t* iterator,
+                                        TRI_fulltext_list_t const* list) {
+  uint32_t numTail;
+
+  iterator->_list          = list;
+  iterator->_block         = 0;
+  iterator->_decodedBlock  = UINT32_MAX;
+  iterator->_numDecoded    = 0;
+  iterator->_position      = 0;
+  iterator->_tailPosition  = 0;
+  iterator->_numTail       = 0;
+
+  if (list == nullptr) {
+    return;
+  }
+
+  // the tail (or the whole list if it is not packed) might be unsorted, and
+  // we must not modify it as other readers might access it concurrently.
+  // so sort a copy of it
+  numTail = GetNumEntries(list);
+  TRI_ASSERT(numTail <= BLOCK_SIZE);
+
+  memcpy(iterator->_tail, GetStart(list), numTail * sizeof(TRI_fulltext_list_entry_t));
+
+  if (HasFrequencies(list)) {
+    memcpy(iterator->_tailFrequencies, GetFrequencies(list), numTail * sizeof(uint8_t));
+  }
+  else {
+    memset(iterator->_tailFrequencies, 1, numTail * sizeof(uint8_t));
+  }
+
+  if (! IsSorted(list) &&
+      ! SortEntries(iterator->_tail, iterator->_tailFrequencies, numTail)) {
+    // out of memory. fall back to sorting without frequencies
+    memset(iterator->_tailFrequencies, 1, numTail * sizeof(uint8_t));
+    SortEntries(iterator->_tail, nullptr, numTail);
+  }
+
+  iterator->_numTail = numTail;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief move an iterator forward to an entry and return whether the list
+/// contains it. If it does, the entry's term frequency is stored in frequency
+/// (if non-null). The entries sought must be increasing
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_SeekIteratorListFulltextIndex (TRI_fulltext_list_iterator_t* iterator,
+                                        TRI_fulltext_list_entry_t entry,
+                                        uint32_t* frequency) {
+  TRI_fulltext_list_t const* list = iterator->_list;
+
+  if (list == nullptr) {
+    return false;
+  }
+
+  if (IsPacked(list)) {
+    block_t const* blocks = GetBlocks(list);
+    uint32_t const numBlocks = GetNumBlocks(list);
+
+    if (numBlocks > 0 &&
+        entry >= blocks[0]._first &&
+        entry <= GetLastPacked(list)) {
+      uint32_t const block = FindBlock(blocks, numBlocks, iterator->_block, entry);
+
+      if (block != iterator->_decodedBlock) {
+        iterator->_numDecoded   = DecodeBlock(list, block, iterator->_entries, iterator->_frequencies);
+        iterator->_decodedBlock = block;
+        iterator->_position     = 0;
+      }
+
+      iterator->_block = block;
+      iterator->_position = AdvanceTo(iterator->_entries, iterator->_position, iterator->_numDecoded, entry);
+
+      if (iterator->_position < iterator->_numDecoded &&
+          iterator->_entries[iterator->_position] == entry) {
+        if (frequency != nullptr) {
+          *frequency = iterator->_frequencies[iterator->_position];
+        }
+        return true;
+      }
+    }
+  }
+
+  if (iterator->_numTail > 0) {
+    iterator->_tailPosition = AdvanceTo(iterator->_tail, iterator->_tailPosition, iterator->_numTail, entry);
+
+    if (iterator->_tailPosition < iterator->_numTail &&
+        iterator->_tail[iterator->_tailPosition] == entry) {
+      if (frequency != nullptr) {
+        *frequency = iterator->_tailFrequencies[iterator->_tailPosition];
+      }
+      return true;
+    }
+  }
+
+  return false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -651,12 +1814,18 @@ uint32_t TRI_RewriteListFulltextIndex (TRI_fulltext_list_t* list,
 
 #if TRI_FULLTEXT_DEBUG
 void TRI_DumpListFulltextIndex (TRI_fulltext_list_t const* list) {
+  TRI_fulltext_list_t* copy;
   TRI_fulltext_list_entry_t* listEntries;
   uint32_t numEntries;
   uint32_t i;
 
-  numEntries = GetNumEntries(list);
-  listEntries = GetStart(list);
+  copy = TRI_CloneListFulltextIndex(list);
+  if (copy == nullptr) {
+    return;
+  }
+
+  numEntries = GetNumEntries(copy);
+  listEntries = GetStart(copy);
 
   printf("(");
 
@@ -672,6 +1841,8 @@ void TRI_DumpListFulltextIndex (TRI_fulltext_list_t const* list) {
   }
 
   printf(")");
+
+  TRI_FreeListFulltextIndex(copy);
 }
 #endif
 
@@ -680,11 +1851,16 @@ void TRI_DumpListFulltextIndex (TRI_fulltext_list_t const* list) {
 ////////////////////////////////////////////////////////////////////////////////
 
 uint32_t TRI_NumEntriesListFulltextIndex (TRI_fulltext_list_t const* list) {
+  if (IsPacked(list)) {
+    return GetNumPacked(list) + GetNumEntries(list);
+  }
+
   return GetNumEntries(list);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return a pointer to the first list entry
+/// this must not be called for packed lists
 ////////////////////////////////////////////////////////////////////////////////
 
 TRI_fulltext_list_entry_t* TRI_StartListFulltextIndex (TRI_fulltext_list_t const* list) {
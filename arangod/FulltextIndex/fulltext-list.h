@@ -48,6 +48,33 @@ typedef void TRI_fulltext_list_t;
 
 typedef uint32_t TRI_fulltext_list_entry_t;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of entries per compressed block of a list
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_FULLTEXT_LIST_BLOCK_SIZE 128
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief iterator over the list of an index node
+/// the iterator can only move forward. It decodes at most one block of a
+/// compressed list at a time
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct TRI_fulltext_list_iterator_s {
+  TRI_fulltext_list_t const* _list;
+  uint32_t                   _block;
+  uint32_t                   _decodedBlock;
+  uint32_t                   _numDecoded;
+  uint32_t                   _position;
+  uint32_t                   _tailPosition;
+  uint32_t                   _numTail;
+  TRI_fulltext_list_entry_t  _entries[TRI_FULLTEXT_LIST_BLOCK_SIZE];
+  TRI_fulltext_list_entry_t  _tail[TRI_FULLTEXT_LIST_BLOCK_SIZE];
+  uint8_t                    _frequencies[TRI_FULLTEXT_LIST_BLOCK_SIZE];
+  uint8_t                    _tailFrequencies[TRI_FULLTEXT_LIST_BLOCK_SIZE];
+}
+TRI_fulltext_list_iterator_t;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                        constructors / destructors
 // -----------------------------------------------------------------------------
@@ -64,6 +91,13 @@ TRI_fulltext_list_t* TRI_CloneListFulltextIndex (TRI_fulltext_list_t const*);
 
 TRI_fulltext_list_t* TRI_CreateListFulltextIndex (uint32_t);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a list for an index node
+/// these lists store a term frequency for each entry
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_fulltext_list_t* TRI_CreateNodeListFulltextIndex (uint32_t);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief free a list
 ////////////////////////////////////////////////////////////////////////////////
@@ -96,6 +130,14 @@ TRI_fulltext_list_t* TRI_UnioniseListFulltextIndex (TRI_fulltext_list_t*,
 TRI_fulltext_list_t* TRI_IntersectListFulltextIndex (TRI_fulltext_list_t*,
                                                      TRI_fulltext_list_t*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief intersect a list with the list of an index node
+/// this will modify lhs in place and leave the node's list untouched
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_fulltext_list_t* TRI_IntersectNodeListFulltextIndex (TRI_fulltext_list_t*,
+                                                         TRI_fulltext_list_t const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief exclude values from a list
 /// this will modify the result in place
@@ -105,12 +147,15 @@ TRI_fulltext_list_t* TRI_ExcludeListFulltextIndex (TRI_fulltext_list_t*,
                                                    TRI_fulltext_list_t*);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief insert an element into a list
-/// this might free the old list and allocate a new, bigger one
+/// @brief insert an element and its term frequency into the list of an
+/// index node
+/// this might free the old list and allocate a new, bigger one. Lists that
+/// grow beyond a certain size are packed
 ////////////////////////////////////////////////////////////////////////////////
 
 TRI_fulltext_list_t* TRI_InsertListFulltextIndex (TRI_fulltext_list_t*,
-                                                  const TRI_fulltext_list_entry_t);
+                                                  const TRI_fulltext_list_entry_t,
+                                                  const uint32_t);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief rewrites the list of entries using a map of values
@@ -120,6 +165,23 @@ TRI_fulltext_list_t* TRI_InsertListFulltextIndex (TRI_fulltext_list_t*,
 uint32_t TRI_RewriteListFulltextIndex (TRI_fulltext_list_t*,
                                        void const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initialise an iterator over the list of an index node
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_InitIteratorListFulltextIndex (TRI_fulltext_list_iterator_t*,
+                                        TRI_fulltext_list_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief move an iterator forward to an entry and return whether the list
+/// contains it. The entry's term frequency is returned in the last argument
+/// if it is non-null. The entries sought must be increasing
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_SeekIteratorListFulltextIndex (TRI_fulltext_list_iterator_t*,
+                                        TRI_fulltext_list_entry_t,
+                                        uint32_t*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief dump a list
 ////////////////////////////////////////////////////////////////////////////////
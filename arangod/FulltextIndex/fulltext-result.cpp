@@ -45,6 +45,7 @@ TRI_fulltext_result_t* TRI_CreateResultFulltextIndex (const uint32_t size) {
   }
 
   result->_documents    = nullptr;
+  result->_scores       = nullptr;
   result->_numDocuments = 0;
 
   if (size > 0) {
@@ -67,6 +68,10 @@ void TRI_DestroyResultFulltextIndex (TRI_fulltext_result_t* result) {
   if (result->_documents != nullptr) {
     TRI_Free(TRI_UNKNOWN_MEM_ZONE, result->_documents);
   }
+
+  if (result->_scores != nullptr) {
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, result->_scores);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
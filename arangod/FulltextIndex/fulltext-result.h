@@ -38,11 +38,14 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief typedef for a fulltext result list
+/// if the result was ranked, _scores contains the score for each document and
+/// the documents are sorted by descending score. otherwise it is a nullptr
 ////////////////////////////////////////////////////////////////////////////////
 
 typedef struct TRI_fulltext_result_s {
   uint32_t             _numDocuments;
   TRI_fulltext_doc_t*  _documents;
+  double*              _scores;
 }
 TRI_fulltext_result_t;
 
@@ -31,6 +31,8 @@
 /* Version 2.1   8.1.2012  R. A. Parker              */
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <algorithm>
+#include <vector>
 
 #include "GeoIndex.h"
 
@@ -1236,6 +1238,224 @@ GeoCoordinates * GeoIndex_NearestCountPoints(GeoIndex * gi,
     return answer;   /* note - this may be NULL  */
 }
 /* =================================================== */
+/*                 GeoCursor structures                */
+/* A cursor returns the points of the index in order   */
+/* of increasing distance from the target point, a     */
+/* batch at a time, without knowing up front how many  */
+/* points will be wanted.  It keeps two priority queues*/
+/* (as min-heaps) - one of pots not yet looked at,     */
+/* keyed by a lower bound on the SNMD of any point they*/
+/* contain, and one of points that have been seen but  */
+/* not yet returned, keyed by their SNMD.  A point can */
+/* be returned as soon as it is at least as close as   */
+/* the lower bound of every pot still to be looked at. */
+/* The cursor holds slot and pot numbers, so it must   */
+/* not be used any more once the index is modified     */
+/* =================================================== */
+typedef struct
+{
+    double snmd;
+    int id;
+}
+GeoCursorEntry;
+
+typedef struct
+{
+    GeoIx * gix;
+    GeoCoordinate target;
+    GeoDetailedPoint gd;
+    std::vector<GeoCursorEntry> pots;
+    std::vector<GeoCursorEntry> slots;
+}
+GeoCr;
+/* =================================================== */
+/*               GeoCursorCompare                      */
+/* ordering for the std heap functions, which keep the */
+/* largest entry at the front, hence the ">" to make   */
+/* the heaps deliver the nearest entry first           */
+/* =================================================== */
+static bool GeoCursorCompare(GeoCursorEntry const& l, GeoCursorEntry const& r)
+{
+    return l.snmd > r.snmd;
+}
+/* =================================================== */
+/*               GeoCursorPotSNMD                      */
+/* Computes a lower bound for the SNMD from the target */
+/* point to any point in the pot.  The distance from   */
+/* the target to a fixed point can be at most the      */
+/* distance from the target to an indexed point plus   */
+/* the distance from that point to the fixed point, so */
+/* the difference between the target's distance to a   */
+/* fixed point and the pot's maxdist to it is a lower  */
+/* bound (in GeoFix units of half the angle at the     */
+/* centre of the earth).  Two units are subtracted to  */
+/* allow for the truncation of the GeoFix values       */
+/* =================================================== */
+static double GeoCursorPotSNMD(GeoCr * gcr, int pot)
+{
+    GeoPot * gp;
+    GeoFix best;
+    double angle,hnmd;
+    int i;
+    gp=gcr->gix->pots+pot;
+    best=0;
+    for(i=0;i<GeoIndexFIXEDPOINTS;i++)
+    {
+        if( ((gcr->gd.fixdist)[i] > gp->maxdist[i]) &&
+            ((gcr->gd.fixdist)[i] - gp->maxdist[i] > best) )
+            best=(gcr->gd.fixdist)[i] - gp->maxdist[i];
+    }
+    if(best<=2) return 0.0;
+    angle=((double) (best-2))/ARCSINFIX;
+    if(angle>=M_PI/2.0) return 4.0;
+    hnmd=sin(angle);   /* half normalized mole distance  */
+    return hnmd*hnmd*4.0;
+}
+/* =================================================== */
+/*               GeoCursorPushPot                      */
+/* =================================================== */
+static void GeoCursorPushPot(GeoCr * gcr, int pot)
+{
+    GeoCursorEntry e;
+    e.snmd=GeoCursorPotSNMD(gcr,pot);
+    e.id=pot;
+    gcr->pots.push_back(e);
+    std::push_heap(gcr->pots.begin(),gcr->pots.end(),GeoCursorCompare);
+}
+/* =================================================== */
+/*               GeoIndex_NewCursor                    */
+/* User-facing routine to start a nearest-first search */
+/* around the target point.  Only the root pot is put  */
+/* on the pot queue - all the rest of the work is done */
+/* lazily by GeoIndex_ReadCursor.  Returns NULL if out */
+/* of memory                                           */
+/* =================================================== */
+GeoCursor * GeoIndex_NewCursor(GeoIndex * gi, GeoCoordinate * c)
+{
+    GeoCr * gcr;
+    try
+    {
+        gcr = new GeoCr;
+        gcr->gix = (GeoIx *) gi;
+        gcr->target = *c;
+        GeoMkDetail(gcr->gix,&(gcr->gd),&(gcr->target));
+        GeoCursorPushPot(gcr,1);
+    }
+    catch (...)
+    {
+        return NULL;
+    }
+    return (GeoCursor *) gcr;
+}
+/* =================================================== */
+/*               GeoIndex_ReadCursor                   */
+/* Returns the next (at most) <count> points of the    */
+/* cursor, nearest first, in the same GeoCoordinates   */
+/* structure that the other searches return, but with  */
+/* the points already sorted by distance.  If          */
+/* <maxdistance> is not negative, no point further away*/
+/* than that (in meters) is returned, and the search   */
+/* stops as soon as the nearest remaining pot and point*/
+/* are both beyond it.  NULL is returned once there are*/
+/* no more points (or if out of memory)                */
+/* =================================================== */
+GeoCoordinates * GeoIndex_ReadCursor(GeoCursor * gc, int count,
+                    double maxdistance)
+{
+    GeoCr * gcr;
+    GeoIx * gix;
+    GeoPot * gp;
+    GeoCoordinates * ans;
+    GeoCursorEntry e;
+    double maxsnmd,mole,dist;
+    int i,n,slot;
+
+    gcr = (GeoCr *) gc;
+    gix = gcr->gix;
+    if(count<=0) return NULL;
+    maxsnmd=10.0;  /* larger than any real SNMD  */
+    if(maxdistance>=0.0) maxsnmd=GeoMetersToSNMD(maxdistance)*1.00000000000001;
+
+    ans = static_cast<GeoCoordinates*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, sizeof(GeoCoordinates), false));
+    if(ans==NULL) return NULL;
+    ans->coordinates = static_cast<GeoCoordinate*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, count * sizeof(GeoCoordinate), false));
+    ans->distances = static_cast<double*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, count * sizeof(double), false));
+    if( (ans->coordinates==NULL) || (ans->distances==NULL) )
+    {
+        GeoIndex_CoordinatesFree(ans);
+        return NULL;
+    }
+
+    n=0;
+    try
+    {
+        while(n<count)
+        {
+            if( (! gcr->slots.empty()) &&
+                (gcr->pots.empty() || gcr->slots[0].snmd <= gcr->pots[0].snmd) )
+            {
+/* the nearest point seen is nearer than anything in the pots  */
+                if(gcr->slots[0].snmd > maxsnmd) break;
+                slot=gcr->slots[0].id;
+                mole=sqrt(gcr->slots[0].snmd);
+                if(mole >  2.0) mole = 2.0; /* make sure arcsin succeeds! */
+                dist=2.0 * EARTHRADIUS * asin(mole/2.0);
+                if( (maxdistance>=0.0) && (dist>maxdistance) ) break;
+                std::pop_heap(gcr->slots.begin(),gcr->slots.end(),GeoCursorCompare);
+                gcr->slots.pop_back();
+                ans->coordinates[n].latitude  = (gix->gc)[slot].latitude;
+                ans->coordinates[n].longitude = (gix->gc)[slot].longitude;
+                ans->coordinates[n].data      = (gix->gc)[slot].data;
+                ans->distances[n] = dist;
+                n++;
+                continue;
+            }
+            if(gcr->pots.empty()) break;
+            if(gcr->pots[0].snmd > maxsnmd) break;
+/* otherwise open up the nearest pot  */
+            i=gcr->pots[0].id;
+            std::pop_heap(gcr->pots.begin(),gcr->pots.end(),GeoCursorCompare);
+            gcr->pots.pop_back();
+            gp=gix->pots+i;
+            if(gp->LorLeaf==0)
+            {
+                for(i=0;i<gp->RorPoints;i++)
+                {
+                    e.id=gp->points[i];
+                    e.snmd=GeoSNMD(&(gcr->gd),gix->gc+e.id);
+                    gcr->slots.push_back(e);
+                    std::push_heap(gcr->slots.begin(),gcr->slots.end(),GeoCursorCompare);
+                }
+            }
+            else
+            {
+                GeoCursorPushPot(gcr,gp->LorLeaf);
+                GeoCursorPushPot(gcr,gp->RorPoints);
+            }
+        }
+    }
+    catch (...)
+    {
+        GeoIndex_CoordinatesFree(ans);
+        return NULL;
+    }
+
+    if(n==0)
+    {
+        GeoIndex_CoordinatesFree(ans);
+        return NULL;
+    }
+    ans->length = n;
+    return ans;
+}
+/* =================================================== */
+/*               GeoIndex_CursorFree                   */
+/* =================================================== */
+void GeoIndex_CursorFree(GeoCursor * gc)
+{
+    delete (GeoCr *) gc;
+}
+/* =================================================== */
 /*             GeoIndexFreeSlot                        */
 /* return the specified slot to the free list          */
 /* =================================================== */
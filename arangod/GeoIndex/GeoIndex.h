@@ -95,6 +95,7 @@ typedef struct {
 GeoCoordinates;
 
 typedef char GeoIndex;   /* to keep the structure private  */
+typedef char GeoCursor;  /* to keep the structure private  */
 
 
 size_t GeoIndex_MemoryUsage (void*);
@@ -109,6 +110,10 @@ GeoCoordinates * GeoIndex_PointsWithinRadius(GeoIndex * gi,
                     GeoCoordinate * c, double d);
 GeoCoordinates * GeoIndex_NearestCountPoints(GeoIndex * gi,
                     GeoCoordinate * c, int count);
+GeoCursor * GeoIndex_NewCursor(GeoIndex * gi, GeoCoordinate * c);
+GeoCoordinates * GeoIndex_ReadCursor(GeoCursor * gc, int count,
+                    double maxdistance);
+void GeoIndex_CursorFree(GeoCursor * gc);
 void GeoIndex_CoordinatesFree(GeoCoordinates * clist);
 #ifdef TRI_GEO_DEBUG
 void GeoIndex_INDEXDUMP(GeoIndex * gi, FILE * f);
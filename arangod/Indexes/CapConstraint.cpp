@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "CapConstraint.h"
+#include "Indexes/PrimaryIndex.h"
 #include "Utils/transactions.h"
 #include "VocBase/document-collection.h"
 #include "VocBase/transaction.h"
@@ -119,6 +120,30 @@ int CapConstraint::initialize () {
   TRI_ASSERT(_count > 0 || _size > 0);
 
   TRI_headers_t* headers = _collection->_headersPtr;  // ONLY IN INDEX (CAP)
+
+  if (! headers->hasOrder()) {
+    // the cap constraint needs to know which documents are the oldest
+    auto primaryIndex = _collection->primaryIndex()->internals();
+
+    std::vector<TRI_doc_mptr_t*> existing;
+    existing.reserve(static_cast<size_t>(primaryIndex->_nrUsed));
+
+    void** ptr = primaryIndex->_table;
+    void** end = ptr + primaryIndex->_nrAlloc;
+
+    for (;  ptr < end;  ++ptr) {
+      if (*ptr != nullptr) {
+        existing.emplace_back(static_cast<TRI_doc_mptr_t*>(*ptr));
+      }
+    }
+
+    int res = headers->enableOrder(existing);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+  }
+
   int64_t currentCount   = static_cast<int64_t>(headers->count());
   int64_t currentSize    = headers->size();
 
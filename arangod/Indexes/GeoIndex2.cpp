@@ -286,6 +286,20 @@ GeoCoordinates* GeoIndex2::nearQuery (double lat,
   return GeoIndex_NearestCountPoints(_geoIndex, &gc, static_cast<int>(count));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief starts a cursor returning the points nearest first
+////////////////////////////////////////////////////////////////////////////////
+
+GeoCursor* GeoIndex2::nearCursor (double lat,
+                                  double lon) const {
+  GeoCoordinate gc;
+  gc.latitude = lat;
+  gc.longitude = lon;
+  gc.data = nullptr;
+
+  return GeoIndex_NewCursor(_geoIndex, &gc);
+}
+
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
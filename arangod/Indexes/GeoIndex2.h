@@ -127,6 +127,23 @@ namespace triagens {
 
         GeoCoordinates* nearQuery (double, double, size_t) const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief starts a cursor returning the points nearest first
+///
+/// the cursor must be freed with GeoIndex_CursorFree, and must not be used
+/// after the index has been modified
+////////////////////////////////////////////////////////////////////////////////
+
+        GeoCursor* nearCursor (double, double) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether the index is a geoJson index (longitude first)
+////////////////////////////////////////////////////////////////////////////////
+
+        bool isGeoJson () const {
+          return _geoJson;
+        }
+
         bool isSame (TRI_shape_pid_t location, bool geoJson) const {
           return (_location != 0 && _location == location && _geoJson == geoJson);
         }
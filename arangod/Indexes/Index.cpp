@@ -361,6 +361,30 @@ double Index::selectivityEstimate () const {
   THROW_ARANGO_EXCEPTION(TRI_ERROR_NOT_IMPLEMENTED);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether the index builds its structures faster from a batch
+////////////////////////////////////////////////////////////////////////////////
+
+bool Index::hasBatchInsert () const {
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief default implementation for batchInsert
+////////////////////////////////////////////////////////////////////////////////
+
+int Index::batchInsert (std::vector<TRI_doc_mptr_t const*> const& documents) {
+  for (auto const& it : documents) {
+    int res = insert(it, false);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief default implementation for postInsert
 ////////////////////////////////////////////////////////////////////////////////
@@ -183,6 +183,11 @@ namespace triagens {
   
         virtual int insert (struct TRI_doc_mptr_t const*, bool) = 0;
         virtual int remove (struct TRI_doc_mptr_t const*, bool) = 0;
+
+        // insert a batch of documents, used when filling a new index. only
+        // worth collecting the documents for if hasBatchInsert() is true
+        virtual bool hasBatchInsert () const;
+        virtual int batchInsert (std::vector<struct TRI_doc_mptr_t const*> const&);
         virtual int postInsert (struct TRI_transaction_collection_s*, struct TRI_doc_mptr_t const*);
 
         // a garbage collection function for the index
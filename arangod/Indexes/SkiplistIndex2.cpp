@@ -219,6 +219,68 @@ int SkiplistIndex2::insert (TRI_doc_mptr_t const* doc,
   return SkiplistIndex_insert(_skiplistIndex, skiplistElement);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inserts a batch of documents into a skiplist index
+///
+/// if the index is still empty, all elements are created first and the
+/// skiplist is then built bottom-up from the sorted elements, which is much
+/// cheaper than inserting them one by one
+////////////////////////////////////////////////////////////////////////////////
+
+int SkiplistIndex2::batchInsert (std::vector<TRI_doc_mptr_t const*> const& documents) {
+  if (SkiplistIndex_getNrUsed(_skiplistIndex) > 0) {
+    return Index::batchInsert(documents);
+  }
+
+  std::vector<TRI_skiplist_index_element_t*> elements;
+  int res = TRI_ERROR_NO_ERROR;
+
+  try {
+    elements.reserve(documents.size());
+
+    for (auto const& it : documents) {
+      auto skiplistElement = static_cast<TRI_skiplist_index_element_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, SkiplistIndex_ElementSize(_skiplistIndex), false));
+
+      if (skiplistElement == nullptr) {
+        res = TRI_ERROR_OUT_OF_MEMORY;
+        break;
+      }
+
+      res = fillElement(skiplistElement, it);
+
+      // see insert() for the handling of missing attributes
+      if (res == TRI_ERROR_ARANGO_INDEX_DOCUMENT_ATTRIBUTE_MISSING) {
+        res = TRI_ERROR_NO_ERROR;
+
+        if (_sparse) {
+          TRI_Free(TRI_UNKNOWN_MEM_ZONE, skiplistElement);
+          continue;
+        }
+      }
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        TRI_Free(TRI_UNKNOWN_MEM_ZONE, skiplistElement);
+        break;
+      }
+
+      elements.emplace_back(skiplistElement);
+    }
+  }
+  catch (...) {
+    res = TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    for (auto element : elements) {
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, element);
+    }
+    return res;
+  }
+
+  // the memory for the elements will be owned or freed by the index
+  return SkiplistIndex_bulkLoad(_skiplistIndex, elements);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief removes a document from a skiplist index
 ////////////////////////////////////////////////////////////////////////////////
@@ -90,6 +90,12 @@ namespace triagens {
          
         int remove (struct TRI_doc_mptr_t const*, bool) override final;
 
+        bool hasBatchInsert () const override final {
+          return true;
+        }
+
+        int batchInsert (std::vector<struct TRI_doc_mptr_t const*> const&) override final;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief attempts to locate an entry in the skip list index
 ///
@@ -638,11 +638,17 @@ int ContinuousSyncer::changeCollection (TRI_json_t const* json) {
     triagens::arango::CollectionGuard guard(_vocbase, cid);
 
     TRI_col_info_t parameters;
+    TRI_col_info_t const& current = guard.collection()->_collection->_info;
 
-    // only need to set these three properties as the others cannot be updated on the fly
+    // only need to set these properties as the others cannot be updated on the fly
     parameters._doCompact   = doCompact;
     parameters._maximalSize = maximalSize;
     parameters._waitForSync = waitForSync;
+    parameters._indexBuckets = JsonHelper::getNumericValue<uint32_t>(collectionJson, "indexBuckets", current._indexBuckets);
+    parameters._compactionDeadSizeThreshold = JsonHelper::getNumericValue<uint64_t>(collectionJson, "compactionDeadSizeThreshold", current._compactionDeadSizeThreshold);
+    parameters._compactionDeadSizeShare     = JsonHelper::getNumericValue<double>(collectionJson, "compactionDeadSizeShare", current._compactionDeadSizeShare);
+    parameters._compactionMaxFileSize       = JsonHelper::getNumericValue<uint64_t>(collectionJson, "compactionMaxFileSize", current._compactionMaxFileSize);
+    parameters._compressDatafiles           = JsonHelper::getBooleanValue(collectionJson, "compressDatafiles", current._compressDatafiles);
 
     bool doSync = _vocbase->_settings.forceSyncProperties;
     return TRI_UpdateCollectionInfo(_vocbase, guard.collection()->_collection, &parameters, doSync);
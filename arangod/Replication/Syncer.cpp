@@ -396,6 +396,10 @@ int Syncer::createCollection (TRI_json_t const* json,
   params._doCompact   = JsonHelper::getBooleanValue(json, "doCompact", true);
   params._waitForSync = JsonHelper::getBooleanValue(json, "waitForSync", _vocbase->_settings.defaultWaitForSync);
   params._isVolatile  = JsonHelper::getBooleanValue(json, "isVolatile", false);
+  params._compressDatafiles = JsonHelper::getBooleanValue(json, "compressDatafiles", false);
+  params._compactionDeadSizeThreshold = JsonHelper::getNumericValue<uint64_t>(json, "compactionDeadSizeThreshold", TRI_COL_COMPACTION_DEAD_SIZE_THRESHOLD);
+  params._compactionDeadSizeShare     = JsonHelper::getNumericValue<double>(json, "compactionDeadSizeShare", TRI_COL_COMPACTION_DEAD_SIZE_SHARE);
+  params._compactionMaxFileSize       = JsonHelper::getNumericValue<uint64_t>(json, "compactionMaxFileSize", TRI_COL_COMPACTION_MAX_FILE_SIZE);
   params._isSystem    = (name[0] == '_');
   params._planId      = 0;
 
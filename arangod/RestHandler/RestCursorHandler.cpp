@@ -36,6 +36,7 @@
 #include "Basics/ScopeGuard.h"
 #include "Utils/Cursor.h"
 #include "Utils/CursorRepository.h"
+#include "Utils/CursorStream.h"
 #include "V8Server/ApplicationV8.h"
 
 using namespace triagens::arango;
@@ -211,7 +212,8 @@ void RestCursorHandler::processQuery (TRI_json_t const* json) {
       return;
     }
       
-    // result is bigger than batchSize, and a cursor will be created
+    // result is bigger than batchSize, and a cursor will be created. its
+    // first batch is streamed to the client
     auto cursors = static_cast<triagens::arango::CursorRepository*>(_vocbase->_cursorRepository);
     TRI_ASSERT(cursors != nullptr);
 
@@ -223,19 +225,8 @@ void RestCursorHandler::processQuery (TRI_json_t const* json) {
     triagens::arango::JsonCursor* cursor = cursors->createFromJson(j, batchSize, extra.steal(), ttl, count); 
     queryResult.json = nullptr;
 
-    try {
-      _response->body().appendChar('{');
-      cursor->dump(_response->body());
-      _response->body().appendText(",\"error\":false,\"code\":");
-      _response->body().appendInteger(static_cast<uint32_t>(_response->responseCode()));
-      _response->body().appendChar('}');
-
-      cursors->release(cursor);
-    }
-    catch (...) {
-      cursors->release(cursor);
-      throw;
-    }
+    // the stream releases the cursor
+    streamResponse(new triagens::arango::CursorStream(cursors, cursor, _response->responseCode()));
   }
 }
 
@@ -860,26 +851,19 @@ void RestCursorHandler::modifyCursor () {
     return;
   }
 
+  // the stream releases the cursor
+  std::unique_ptr<triagens::arango::CursorStream> stream(new triagens::arango::CursorStream(cursors, cursor, HttpResponse::OK));
+
   try {
     _response = createResponse(HttpResponse::OK);
     _response->setContentType("application/json; charset=utf-8");
 
-    _response->body().appendChar('{');
-    cursor->dump(_response->body());
-    _response->body().appendText(",\"error\":false,\"code\":");
-    _response->body().appendInteger(static_cast<uint32_t>(_response->responseCode()));
-    _response->body().appendChar('}');
-
-    cursors->release(cursor);
+    streamResponse(stream.release());
   }
   catch (triagens::basics::Exception const& ex) {
-    cursors->release(cursor);
-
     generateError(HttpResponse::responseCode(ex.code()), ex.code(), ex.what());
   }
   catch (...) {
-    cursors->release(cursor);
-
     generateError(HttpResponse::SERVER_ERROR, TRI_ERROR_INTERNAL);
   }
 }
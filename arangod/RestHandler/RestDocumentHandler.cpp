@@ -302,25 +302,24 @@ bool RestDocumentHandler::createDocument () {
 
   bool const waitForSync = extractWaitForSync();
 
-  TRI_json_t* json = parseJsonBody();
+  if (ServerState::instance()->isCoordinator()) {
+    TRI_json_t* json = parseJsonBody();
 
-  if (json == nullptr) {
-    return false;
-  }
+    if (json == nullptr) {
+      return false;
+    }
 
-  if (json->_type != TRI_JSON_OBJECT) {
-    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
-    generateTransactionError(collection, TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID);
-    return false;
-  }
+    if (json->_type != TRI_JSON_OBJECT) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+      generateTransactionError(collection, TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID);
+      return false;
+    }
 
-  if (ServerState::instance()->isCoordinator()) {
     // json will be freed inside!
     return createDocumentCoordinator(collection, waitForSync, json);
   }
 
   if (! checkCreateCollection(collection, getCollectionType())) {
-    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
     return false;
   }
 
@@ -334,14 +333,12 @@ bool RestDocumentHandler::createDocument () {
   int res = trx.begin();
 
   if (res != TRI_ERROR_NO_ERROR) {
-    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
     generateTransactionError(collection, res);
     return false;
   }
 
   if (trx.documentCollection()->_info._type != TRI_COL_TYPE_DOCUMENT) {
     // check if we are inserting with the DOCUMENT handler into a non-DOCUMENT collection
-    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
     generateError(HttpResponse::BAD, TRI_ERROR_ARANGO_COLLECTION_TYPE_INVALID);
     return false;
   }
@@ -349,10 +346,37 @@ bool RestDocumentHandler::createDocument () {
   TRI_voc_cid_t const cid = trx.cid();
 
   TRI_doc_mptr_copy_t mptr;
-  res = trx.createDocument(&mptr, json, waitForSync);
-  res = trx.finish(res);
 
-  TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+  // shape the body directly, without creating a TRI_json_t first
+  TRI_shaper_t* shaper = trx.documentCollection()->getShaper();  // PROTECTED by trx here
+  string key;
+  TRI_shaped_json_t* shaped = TRI_ShapedJsonString(shaper, _request->body(), _request->bodySize(), true, true, key, &res);
+
+  if (shaped != nullptr) {
+    res = trx.createDocument(key.empty() ? nullptr : const_cast<char*>(key.c_str()), &mptr, shaped, waitForSync);
+    TRI_FreeShapedJson(shaper->_memoryZone, shaped);
+  }
+  else if (res == TRI_ERROR_HTTP_CORRUPTED_JSON) {
+    // the body is invalid. the json code path reports the parse error
+    TRI_json_t* json = parseJsonBody();
+
+    if (json == nullptr) {
+      return false;
+    }
+
+    if (json->_type != TRI_JSON_OBJECT) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+      generateTransactionError(collection, TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID);
+      return false;
+    }
+
+    res = trx.createDocument(&mptr, json, waitForSync);
+
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+  }
+  // other errors of the direct shaping are reported below
+
+  res = trx.finish(res);
 
   // .............................................................................
   // outside write transaction
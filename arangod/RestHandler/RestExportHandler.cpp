@@ -34,6 +34,7 @@
 #include "Utils/CollectionExport.h"
 #include "Utils/Cursor.h"
 #include "Utils/CursorRepository.h"
+#include "Utils/CursorStream.h"
 #include "Wal/LogfileManager.h"
 
 using namespace triagens::arango;
@@ -404,19 +405,8 @@ void RestExportHandler::createCursor () {
       triagens::arango::ExportCursor* cursor = cursors->createFromExport(collectionExport.get(), batchSize, ttl, count); 
       collectionExport.release();
       
-      try {
-        _response->body().appendChar('{');
-        cursor->dump(_response->body());
-        _response->body().appendText(",\"error\":false,\"code\":");
-        _response->body().appendInteger(static_cast<uint32_t>(_response->responseCode()));
-        _response->body().appendChar('}');
-
-        cursors->release(cursor);
-      }
-      catch (...) {
-        cursors->release(cursor);
-        throw;
-      }
+      // the stream releases the cursor
+      streamResponse(new triagens::arango::CursorStream(cursors, cursor, _response->responseCode()));
     }
   }  
   catch (triagens::basics::Exception const& ex) {
@@ -456,26 +446,19 @@ void RestExportHandler::modifyCursor () {
     return;
   }
 
+  // the stream releases the cursor
+  std::unique_ptr<triagens::arango::CursorStream> stream(new triagens::arango::CursorStream(cursors, cursor, HttpResponse::OK));
+
   try {
     _response = createResponse(HttpResponse::OK);
     _response->setContentType("application/json; charset=utf-8");
 
-    _response->body().appendChar('{');
-    cursor->dump(_response->body());
-    _response->body().appendText(",\"error\":false,\"code\":");
-    _response->body().appendInteger(static_cast<uint32_t>(_response->responseCode()));
-    _response->body().appendChar('}');
-
-    cursors->release(cursor);
+    streamResponse(stream.release());
   }
   catch (triagens::basics::Exception const& ex) {
-    cursors->release(cursor);
-
     generateError(HttpResponse::responseCode(ex.code()), ex.code(), ex.what());
   }
   catch (...) {
-    cursors->release(cursor);
-
     generateError(HttpResponse::SERVER_ERROR, TRI_ERROR_INTERNAL);
   }
 }
@@ -32,6 +32,7 @@
 #include "Basics/JsonHelper.h"
 #include "Basics/StringUtils.h"
 #include "Basics/tri-strings.h"
+#include "Cluster/ClusterMethods.h"
 #include "Rest/HttpRequest.h"
 #include "VocBase/document-collection.h"
 #include "VocBase/edge-collection.h"
@@ -64,13 +65,6 @@ RestImportHandler::RestImportHandler (HttpRequest* request)
 ////////////////////////////////////////////////////////////////////////////////
 
 HttpHandler::status_t RestImportHandler::execute () {
-  if (ServerState::instance()->isCoordinator()) {
-    generateError(HttpResponse::NOT_IMPLEMENTED,
-                  TRI_ERROR_CLUSTER_UNSUPPORTED,
-                  "'/_api/import' is not yet supported in a cluster");
-    return status_t(HANDLER_DONE);
-  }
-  
   // set default value for onDuplicate
   _onDuplicateAction = DUPLICATE_ERROR;
       
@@ -174,6 +168,25 @@ void RestImportHandler::registerError (RestImportResult& result,
   result._errors.push_back(errorMsg);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register an error for a document which could not be created
+////////////////////////////////////////////////////////////////////////////////
+
+void RestImportHandler::registerDocumentError (RestImportResult& result,
+                                               int res,
+                                               std::string part,
+                                               size_t i) {
+  if (part.size() > 255) {
+    part = part.substr(0, 255) + "...";
+  }
+
+  std::string errorMsg = positionise(i) +
+                         "creating document failed with error '" + TRI_errno_string(res) +
+                         "', offending document: " + part;
+
+  registerError(result, errorMsg);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief construct an error message
 ////////////////////////////////////////////////////////////////////////////////
@@ -194,17 +207,13 @@ std::string RestImportHandler::buildParseError (size_t i,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief process a single JSON document
+/// @brief check that a document to import is a JSON object
 ////////////////////////////////////////////////////////////////////////////////
 
-int RestImportHandler::handleSingleDocument (RestImportTransaction& trx,
-                                             RestImportResult& result,
-                                             char const* lineStart,
-                                             TRI_json_t const* json,
-                                             bool isEdgeCollection,
-                                             bool waitForSync,
-                                             size_t i) {
-
+int RestImportHandler::checkDocumentType (RestImportResult& result,
+                                          char const* lineStart,
+                                          TRI_json_t const* json,
+                                          size_t i) {
   if (! TRI_IsObjectJson(json)) {
     std::string errorMsg;
 
@@ -225,9 +234,28 @@ int RestImportHandler::handleSingleDocument (RestImportTransaction& trx,
     return TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID;
   }
 
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process a single JSON document
+////////////////////////////////////////////////////////////////////////////////
+
+int RestImportHandler::handleSingleDocument (RestImportTransaction& trx,
+                                             RestImportResult& result,
+                                             char const* lineStart,
+                                             TRI_json_t const* json,
+                                             bool isEdgeCollection,
+                                             bool waitForSync,
+                                             size_t i) {
+  int res = checkDocumentType(result, lineStart, json, i);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
   // document ok, now import it
   TRI_doc_mptr_copy_t document;
-  int res = TRI_ERROR_NO_ERROR;
 
   if (isEdgeCollection) {
     char const* from = extractJsonStringValue(json, TRI_VOC_ATTRIBUTE_FROM);
@@ -293,66 +321,264 @@ int RestImportHandler::handleSingleDocument (RestImportTransaction& trx,
 
     if (TRI_IsStringJson(keyJson)) {
       // insert failed. now try an update/replace
+      res = handleDuplicateDocument(trx, result, keyJson->_value._string.data, json, waitForSync);
+    }
+  }
+
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    registerDocumentError(result, res, JsonHelper::toString(json), i);
+  }
+
+  return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief handle a document whose insert violated a unique constraint,
+/// according to the onDuplicate action. the json is only needed for updates
+/// and replacements
+////////////////////////////////////////////////////////////////////////////////
 
-      if (_onDuplicateAction == DUPLICATE_UPDATE) {
-        // update: first read existing document
-        TRI_doc_mptr_copy_t previous;
-        int res2 = trx.read(&previous, keyJson->_value._string.data);
+int RestImportHandler::handleDuplicateDocument (RestImportTransaction& trx,
+                                                RestImportResult& result,
+                                                char const* key,
+                                                TRI_json_t const* json,
+                                                bool waitForSync) {
+  TRI_ASSERT(_onDuplicateAction != DUPLICATE_ERROR);
 
-        if (res2 == TRI_ERROR_NO_ERROR) {
-          TRI_shaper_t* shaper = trx.documentCollection()->getShaper();  // PROTECTED by trx here
+  TRI_doc_mptr_copy_t document;
+  int res = TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
 
-          TRI_shaped_json_t shapedJson;
-          TRI_EXTRACT_SHAPED_JSON_MARKER(shapedJson, previous.getDataPtr()); // PROTECTED by trx here
-          std::unique_ptr<TRI_json_t> old(TRI_JsonShapedJson(shaper, &shapedJson));
+  if (_onDuplicateAction == DUPLICATE_UPDATE) {
+    // update: first read existing document
+    TRI_doc_mptr_copy_t previous;
+    int res2 = trx.read(&previous, key);
 
-          // default value
-          res = TRI_ERROR_OUT_OF_MEMORY;
+    if (res2 == TRI_ERROR_NO_ERROR) {
+      TRI_shaper_t* shaper = trx.documentCollection()->getShaper();  // PROTECTED by trx here
 
-          if (old != nullptr) {
-            std::unique_ptr<TRI_json_t> patchedJson(TRI_MergeJson(TRI_UNKNOWN_MEM_ZONE, old.get(), json, false, true));
+      TRI_shaped_json_t shapedJson;
+      TRI_EXTRACT_SHAPED_JSON_MARKER(shapedJson, previous.getDataPtr()); // PROTECTED by trx here
+      std::unique_ptr<TRI_json_t> old(TRI_JsonShapedJson(shaper, &shapedJson));
 
-            if (patchedJson != nullptr) {
-              res = trx.updateDocument(keyJson->_value._string.data, &document, patchedJson.get(), TRI_DOC_UPDATE_LAST_WRITE, waitForSync, 0, nullptr);
-            }
-          }
+      // default value
+      res = TRI_ERROR_OUT_OF_MEMORY;
 
-          if (res == TRI_ERROR_NO_ERROR) {
-            ++result._numUpdated;
-          }
+      if (old != nullptr) {
+        std::unique_ptr<TRI_json_t> patchedJson(TRI_MergeJson(TRI_UNKNOWN_MEM_ZONE, old.get(), json, false, true));
+
+        if (patchedJson != nullptr) {
+          res = trx.updateDocument(key, &document, patchedJson.get(), TRI_DOC_UPDATE_LAST_WRITE, waitForSync, 0, nullptr);
         }
       }
-      else if (_onDuplicateAction == DUPLICATE_REPLACE) {
-        // replace
-        res = trx.updateDocument(keyJson->_value._string.data, &document, json, TRI_DOC_UPDATE_LAST_WRITE, waitForSync, 0, nullptr);
-          
-        if (res == TRI_ERROR_NO_ERROR) {
-          ++result._numUpdated;
-        }
+
+      if (res == TRI_ERROR_NO_ERROR) {
+        ++result._numUpdated;
+      }
+    }
+  }
+  else if (_onDuplicateAction == DUPLICATE_REPLACE) {
+    // replace
+    res = trx.updateDocument(key, &document, json, TRI_DOC_UPDATE_LAST_WRITE, waitForSync, 0, nullptr);
+      
+    if (res == TRI_ERROR_NO_ERROR) {
+      ++result._numUpdated;
+    }
+  }
+  else {
+    // simply ignore unique key violations silently
+    TRI_ASSERT(_onDuplicateAction == DUPLICATE_IGNORE); 
+    res = TRI_ERROR_NO_ERROR;
+    ++result._numIgnored;
+  }
+
+  return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process the text of a single JSON document for a document
+/// collection, shaping it without creating a TRI_json_t
+///
+/// the line is validated completely before the shaper is used, and errors are
+/// reported from this single parse. the line is only parsed into a TRI_json_t
+/// when a duplicate document must be updated or replaced
+////////////////////////////////////////////////////////////////////////////////
+
+int RestImportHandler::handleSingleDocumentText (RestImportTransaction& trx,
+                                                 RestImportResult& result,
+                                                 char const* lineStart,
+                                                 char const* lineEnd,
+                                                 bool waitForSync,
+                                                 size_t i) {
+  TRI_shaper_t* shaper = trx.documentCollection()->getShaper();  // PROTECTED by trx here
+  std::string key;
+  int res = TRI_ERROR_NO_ERROR;
+
+  // as in the json code path, duplicate attribute names are not rejected
+  TRI_shaped_json_t* shaped = TRI_ShapedJsonString(shaper, lineStart, (size_t) (lineEnd - lineStart), true, false, key, &res);
+
+  if (shaped == nullptr) {
+    if (res == TRI_ERROR_HTTP_CORRUPTED_JSON) {
+      registerError(result, buildParseError(i, lineStart));
+      return TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID;
+    }
+
+    if (res == TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID) {
+      string part(lineStart, lineEnd);
+      if (part.size() > 255) {
+        part = part.substr(0, 255) + "...";
+      }
+
+      registerError(result, positionise(i) + "invalid JSON type (expecting object), offending document: " + part);
+      return res;
+    }
+
+    registerDocumentError(result, res, string(lineStart, lineEnd), i);
+    return res;
+  }
+
+  TRI_doc_mptr_copy_t document;
+  res = trx.createDocument(key.empty() ? nullptr : const_cast<char*>(key.c_str()), &document, shaped, waitForSync);
+
+  TRI_FreeShapedJson(shaper->_memoryZone, shaped);
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    ++result._numCreated;
+    return res;
+  }
+
+  // special behavior in case of unique constraint violation . . .
+  if (res == TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED &&
+      _onDuplicateAction != DUPLICATE_ERROR &&
+      ! key.empty()) {
+
+    if (_onDuplicateAction == DUPLICATE_IGNORE) {
+      res = handleDuplicateDocument(trx, result, key.c_str(), nullptr, waitForSync);
+    }
+    else {
+      // updates and replacements need the document as json
+      TRI_json_t* json = parseJsonLine(lineStart, lineEnd);
+
+      if (json == nullptr) {
+        res = TRI_ERROR_OUT_OF_MEMORY;
       }
       else {
-        // simply ignore unique key violations silently
-        TRI_ASSERT(_onDuplicateAction == DUPLICATE_IGNORE); 
-        res = TRI_ERROR_NO_ERROR;
-        ++result._numIgnored;
+        res = handleDuplicateDocument(trx, result, key.c_str(), json, waitForSync);
+        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
       }
     }
   }
 
+  if (res != TRI_ERROR_NO_ERROR) {
+    registerDocumentError(result, res, string(lineStart, lineEnd), i);
+  }
+
+  return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collect a single JSON document for a cluster import
+////////////////////////////////////////////////////////////////////////////////
+
+int RestImportHandler::collectClusterDocument (RestImportClusterDocuments& documents,
+                                               RestImportResult& result,
+                                               char const* lineStart,
+                                               TRI_json_t const* json,
+                                               size_t i) {
+  int res = checkDocumentType(result, lineStart, json, i);
 
   if (res != TRI_ERROR_NO_ERROR) {
-    string part = JsonHelper::toString(json);
-    if (part.size() > 255) {
-      // UTF-8 chars in string will be escaped so we can truncate it at any point
-      part = part.substr(0, 255) + "...";
+    return res;
+  }
+
+  TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, json);
+
+  if (copy == nullptr) {
+    registerError(result, positionise(i) + TRI_errno_string(TRI_ERROR_OUT_OF_MEMORY));
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  try {
+    documents.emplace_back(std::make_pair(i, copy));
+  }
+  catch (...) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, copy);
+    registerError(result, positionise(i) + TRI_errno_string(TRI_ERROR_OUT_OF_MEMORY));
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief import the collected documents into a cluster collection. this is
+/// called on a coordinator, and sends one request per responsible shard.
+/// the errors reported by the shards are merged with the errors found while
+/// parsing the input, in input order
+////////////////////////////////////////////////////////////////////////////////
+
+int RestImportHandler::finishClusterImport (std::string const& collection,
+                                            RestImportClusterDocuments& documents,
+                                            RestImportResult& result,
+                                            int res,
+                                            bool waitForSync,
+                                            bool complete) {
+  if (res == TRI_ERROR_NO_ERROR) {
+    std::string onDuplicate = "error";
+    if (_onDuplicateAction == DUPLICATE_UPDATE) {
+      onDuplicate = "update";
+    }
+    else if (_onDuplicateAction == DUPLICATE_REPLACE) {
+      onDuplicate = "replace";
+    }
+    else if (_onDuplicateAction == DUPLICATE_IGNORE) {
+      onDuplicate = "ignore";
     }
 
-    std::string errorMsg = positionise(i) +
-                           "creating document failed with error '" + TRI_errno_string(res) +
-                           "', offending document: " + part;
-      
-    registerError(result, errorMsg);
+    std::vector<std::pair<size_t, std::string>> errors;
+
+    // all errors found while parsing have the form "at position <n>: ..."
+    for (auto const& it : result._errors) {
+      size_t position = 0;
+      if (it.compare(0, 12, "at position ") == 0) {
+        position = static_cast<size_t>(StringUtils::uint64(it.substr(12, it.find(": ", 12) - 12)));
+      }
+      errors.emplace_back(std::make_pair(position, it));
+    }
+    size_t const numParseErrors = errors.size();
+
+    res = importOnCoordinator(_request->databaseName(),
+                              collection,
+                              documents,
+                              onDuplicate,
+                              waitForSync,
+                              complete,
+                              getForwardableRequestHeaders(_request),
+                              result._numCreated,
+                              result._numUpdated,
+                              result._numIgnored,
+                              errors);
+
+    for (size_t i = numParseErrors; i < errors.size(); ++i) {
+      ++result._numErrors;
+      errors[i].second = positionise(errors[i].first) + errors[i].second;
+    }
+
+    std::stable_sort(errors.begin(), errors.end(), [] (std::pair<size_t, std::string> const& lhs,
+                                                       std::pair<size_t, std::string> const& rhs) {
+      return lhs.first < rhs.first;
+    });
+
+    result._errors.clear();
+    for (auto& it : errors) {
+      result._errors.emplace_back(std::move(it.second));
+    }
+  }
+
+  for (auto& it : documents) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it.second);
   }
+  documents.clear();
 
   return res;
 }
@@ -425,6 +651,12 @@ int RestImportHandler::handleSingleDocument (RestImportTransaction& trx,
 /// If set to `true` or `yes`, the result will include an attribute `details`
 /// with details about documents that could not be imported.
 ///
+/// @RESTQUERYPARAM{line,number,optional}
+/// The number of lines preceding the request body in the import file. It is
+/// added to the positions reported in `details` for imports of type
+/// `documents`, so that they refer to lines of the file when a file is
+/// imported in multiple requests.
+///
 /// @RESTDESCRIPTION
 /// Creates documents in the collection identified by `collection-name`.
 /// The JSON representations of the documents must be passed as the body of the
@@ -451,7 +683,10 @@ int RestImportHandler::handleSingleDocument (RestImportTransaction& trx,
 ///   contain a `details` attribute which is an array with more detailed
 ///   information about which documents could not be inserted.
 ///
-/// Note: this API is currently not supported on cluster coordinators.
+/// On a cluster coordinator, the documents are grouped by their responsible
+/// shards, and each shard receives one import request. The `complete` option
+/// then applies per shard: documents that were imported into other shards are
+/// not rolled back if a shard fails.
 ///
 /// @RESTRETURNCODES
 ///
@@ -475,10 +710,6 @@ int RestImportHandler::handleSingleDocument (RestImportTransaction& trx,
 /// is returned if the server cannot auto-generate a document key (out of keys
 /// error) for a document with no user-defined key.
 ///
-/// @RESTRETURNCODE{501}
-/// The server will respond with *HTTP 501* if this API is called on a cluster
-/// coordinator.
-///
 /// @EXAMPLES
 ///
 /// Importing documents with heterogenous attributes from a JSON array:
@@ -775,35 +1006,61 @@ bool RestImportHandler::createFromJson (string const& type) {
     return false;
   }
 
-  // find and load collection given by name or identifier
-  RestImportTransaction trx(new StandaloneTransactionContext(), _vocbase, collection);
+  // read line number (optional)
+  int64_t lineNumber = 0;
+  string const& lineNumValue = _request->value("line", found);
+  if (found) {
+    lineNumber = StringUtils::int64(lineNumValue);
+  }
 
-  // .............................................................................
-  // inside write transaction
-  // .............................................................................
+  // on a coordinator, the documents are collected first and then sent to
+  // their responsible shards
+  std::unique_ptr<RestImportTransaction> trx;
+  RestImportClusterDocuments clusterDocuments;
+  bool isEdgeCollection = false;
+  int res = TRI_ERROR_NO_ERROR;
 
-  int res = trx.begin();
+  if (ServerState::instance()->isCoordinator()) {
+    if (overwrite) {
+      res = truncateCollectionOnCoordinator(_request->databaseName(), collection);
 
-  if (res != TRI_ERROR_NO_ERROR) {
-    generateTransactionError(collection, res);
-    return false;
+      if (res != TRI_ERROR_NO_ERROR) {
+        generateTransactionError(collection, res);
+        return false;
+      }
+    }
   }
+  else {
+    // find and load collection given by name or identifier
+    trx.reset(new RestImportTransaction(new StandaloneTransactionContext(), _vocbase, collection));
 
-  TRI_document_collection_t* document = trx.documentCollection();
-  bool const isEdgeCollection = (document->_info._type == TRI_COL_TYPE_EDGE);
+    // .............................................................................
+    // inside write transaction
+    // .............................................................................
 
-  trx.lockWrite();
+    res = trx->begin();
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      generateTransactionError(collection, res);
+      return false;
+    }
 
-  if (overwrite) {
-    // truncate collection first
-    trx.truncate(false);
+    TRI_document_collection_t* document = trx->documentCollection();
+    isEdgeCollection = (document->_info._type == TRI_COL_TYPE_EDGE);
+
+    trx->lockWrite();
+
+    if (overwrite) {
+      // truncate collection first
+      trx->truncate(false);
+    }
   }
 
   if (linewise) {
     // each line is a separate JSON document
     char const* ptr = _request->body();
     char const* end = ptr + _request->bodySize();
-    size_t i = 0;
+    size_t i = (size_t) lineNumber;
 
     while (ptr < end) {
       // read line until done
@@ -824,8 +1081,7 @@ bool RestImportHandler::createFromJson (string const& type) {
       // now find end of line
       char const* pos = strchr(ptr, '\n');
       char const* oldPtr = nullptr;
-
-      TRI_json_t* json = nullptr;
+      char const* lineEnd = nullptr;
 
       if (pos == ptr) {
         // line starting with \n, i.e. empty line
@@ -838,7 +1094,7 @@ bool RestImportHandler::createFromJson (string const& type) {
         *(const_cast<char*>(pos)) = '\0';
         TRI_ASSERT(ptr != nullptr);
         oldPtr = ptr;
-        json = parseJsonLine(ptr, pos);
+        lineEnd = pos;
         ptr = pos + 1;
       }
       else {
@@ -846,14 +1102,27 @@ bool RestImportHandler::createFromJson (string const& type) {
         TRI_ASSERT(pos == nullptr);
         TRI_ASSERT(ptr != nullptr);
         oldPtr = ptr;
-        json = parseJsonLine(ptr);
+        lineEnd = oldPtr + strlen(oldPtr);
         ptr = end;
       }
 
-      res = handleSingleDocument(trx, result, oldPtr, json, isEdgeCollection, waitForSync, i);
+      if (trx != nullptr && ! isEdgeCollection) {
+        // documents are shaped directly from the line
+        res = handleSingleDocumentText(*trx, result, oldPtr, lineEnd, waitForSync, i);
+      }
+      else {
+        TRI_json_t* json = parseJsonLine(oldPtr, lineEnd);
 
-      if (json != nullptr) {
-        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+        if (trx == nullptr) {
+          res = collectClusterDocument(clusterDocuments, result, oldPtr, json, i);
+        }
+        else {
+          res = handleSingleDocument(*trx, result, oldPtr, json, isEdgeCollection, waitForSync, i);
+        }
+
+        if (json != nullptr) {
+          TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+        }
       }
       
       if (res != TRI_ERROR_NO_ERROR) {
@@ -887,7 +1156,12 @@ bool RestImportHandler::createFromJson (string const& type) {
     for (size_t i = 0; i < n; ++i) {
       TRI_json_t const* json = static_cast<TRI_json_t const*>(TRI_AtVector(&documents->_value._objects, i));
 
-      res = handleSingleDocument(trx, result, nullptr, json, isEdgeCollection, waitForSync, i + 1);
+      if (trx == nullptr) {
+        res = collectClusterDocument(clusterDocuments, result, nullptr, json, i + 1);
+      }
+      else {
+        res = handleSingleDocument(*trx, result, nullptr, json, isEdgeCollection, waitForSync, i + 1);
+      }
       
       if (res != TRI_ERROR_NO_ERROR) {
         if (complete) {
@@ -903,8 +1177,13 @@ bool RestImportHandler::createFromJson (string const& type) {
   }
 
 
-  // this may commit, even if previous errors occurred
-  res = trx.finish(res);
+  if (trx == nullptr) {
+    res = finishClusterImport(collection, clusterDocuments, result, res, waitForSync, complete);
+  }
+  else {
+    // this may commit, even if previous errors occurred
+    res = trx->finish(res);
+  }
 
   // .............................................................................
   // outside write transaction
@@ -1007,7 +1286,10 @@ bool RestImportHandler::createFromJson (string const& type) {
 ///   contain a `details` attribute which is an array with more detailed
 ///   information about which documents could not be inserted.
 ///
-/// Note: this API is currently not supported on cluster coordinators.
+/// On a cluster coordinator, the documents are grouped by their responsible
+/// shards, and each shard receives one import request. The `complete` option
+/// then applies per shard: documents that were imported into other shards are
+/// not rolled back if a shard fails.
 ///
 /// @RESTRETURNCODES
 ///
@@ -1031,10 +1313,6 @@ bool RestImportHandler::createFromJson (string const& type) {
 /// is returned if the server cannot auto-generate a document key (out of keys
 /// error) for a document with no user-defined key.
 ///
-/// @RESTRETURNCODE{501}
-/// The server will respond with *HTTP 501* if this API is called on a cluster
-/// coordinator.
-///
 /// @EXAMPLES
 ///
 /// Importing two documents, with attributes `_key`, `value1` and `value2` each. One
@@ -1278,29 +1556,49 @@ bool RestImportHandler::createFromKeyValueList () {
   current = next + 1;
 
 
-  // find and load collection given by name or identifier
-  RestImportTransaction trx(new StandaloneTransactionContext(), _vocbase, collection);
-
-  // .............................................................................
-  // inside write transaction
-  // .............................................................................
+  // on a coordinator, the documents are collected first and then sent to
+  // their responsible shards
+  std::unique_ptr<RestImportTransaction> trx;
+  RestImportClusterDocuments clusterDocuments;
+  bool isEdgeCollection = false;
+  int res = TRI_ERROR_NO_ERROR;
 
-  int res = trx.begin();
+  if (ServerState::instance()->isCoordinator()) {
+    if (overwrite) {
+      res = truncateCollectionOnCoordinator(_request->databaseName(), collection);
 
-  if (res != TRI_ERROR_NO_ERROR) {
-    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, keys);
-    generateTransactionError(collection, res);
-    return false;
+      if (res != TRI_ERROR_NO_ERROR) {
+        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, keys);
+        generateTransactionError(collection, res);
+        return false;
+      }
+    }
   }
+  else {
+    // find and load collection given by name or identifier
+    trx.reset(new RestImportTransaction(new StandaloneTransactionContext(), _vocbase, collection));
 
-  TRI_document_collection_t* document = trx.documentCollection();
-  bool const isEdgeCollection = (document->_info._type == TRI_COL_TYPE_EDGE);
+    // .............................................................................
+    // inside write transaction
+    // .............................................................................
 
-  trx.lockWrite();
+    res = trx->begin();
 
-  if (overwrite) {
-    // truncate collection first
-    trx.truncate(false);
+    if (res != TRI_ERROR_NO_ERROR) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, keys);
+      generateTransactionError(collection, res);
+      return false;
+    }
+
+    TRI_document_collection_t* document = trx->documentCollection();
+    isEdgeCollection = (document->_info._type == TRI_COL_TYPE_EDGE);
+
+    trx->lockWrite();
+
+    if (overwrite) {
+      // truncate collection first
+      trx->truncate(false);
+    }
   }
 
   size_t i = (size_t) lineNumber;
@@ -1350,7 +1648,12 @@ bool RestImportHandler::createFromKeyValueList () {
       TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, values);
 
       if (json != nullptr) {
-        res = handleSingleDocument(trx, result, lineStart, json, isEdgeCollection, waitForSync, i);
+        if (trx == nullptr) {
+          res = collectClusterDocument(clusterDocuments, result, lineStart, json, i);
+        }
+        else {
+          res = handleSingleDocument(*trx, result, lineStart, json, isEdgeCollection, waitForSync, i);
+        }
         TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
       }
       else {
@@ -1374,8 +1677,13 @@ bool RestImportHandler::createFromKeyValueList () {
     }
   }
 
-  // we'll always commit, even if previous errors occurred
-  res = trx.finish(res);
+  if (trx == nullptr) {
+    res = finishClusterImport(collection, clusterDocuments, result, res, waitForSync, complete);
+  }
+  else {
+    // we'll always commit, even if previous errors occurred
+    res = trx->finish(res);
+  }
 
   TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, keys);
 
@@ -71,6 +71,13 @@ namespace triagens {
         std::vector<std::string> _errors;
     };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief documents collected for an import on a coordinator, as pairs of
+/// (input position, document)
+////////////////////////////////////////////////////////////////////////////////
+
+    typedef std::vector<std::pair<size_t, TRI_json_t*>> RestImportClusterDocuments;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief import request handler
 ////////////////////////////////////////////////////////////////////////////////
@@ -101,6 +108,14 @@ namespace triagens {
 
         status_t execute ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief bulk requests are queued with a low priority
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::rest::Job::JobPriority priority () const override {
+          return triagens::rest::Job::LOW_PRIORITY;
+        }
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
@@ -132,6 +147,15 @@ namespace triagens {
         void registerError (RestImportResult&,
                             std::string const&);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register an error for a document which could not be created
+////////////////////////////////////////////////////////////////////////////////
+
+        void registerDocumentError (RestImportResult&,
+                                    int,
+                                    std::string,
+                                    size_t);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief construct an error message
 ////////////////////////////////////////////////////////////////////////////////
@@ -139,6 +163,15 @@ namespace triagens {
         std::string buildParseError (size_t,
                                      char const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check that a document to import is a JSON object
+////////////////////////////////////////////////////////////////////////////////
+
+        int checkDocumentType (RestImportResult&,
+                               char const*,
+                               TRI_json_t const*,
+                               size_t);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief process a single JSON document
 ////////////////////////////////////////////////////////////////////////////////
@@ -151,6 +184,49 @@ namespace triagens {
                                   bool,
                                   size_t);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief handle a document whose insert violated a unique constraint
+////////////////////////////////////////////////////////////////////////////////
+
+        int handleDuplicateDocument (RestImportTransaction&,
+                                     RestImportResult&,
+                                     char const*,
+                                     TRI_json_t const*,
+                                     bool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process the text of a single JSON document for a document
+/// collection, shaping it without creating a TRI_json_t
+////////////////////////////////////////////////////////////////////////////////
+
+        int handleSingleDocumentText (RestImportTransaction&,
+                                      RestImportResult&,
+                                      char const*,
+                                      char const*,
+                                      bool,
+                                      size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collect a single JSON document for a cluster import
+////////////////////////////////////////////////////////////////////////////////
+
+        int collectClusterDocument (RestImportClusterDocuments&,
+                                    RestImportResult&,
+                                    char const*,
+                                    TRI_json_t const*,
+                                    size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief import the collected documents on a coordinator, shard by shard
+////////////////////////////////////////////////////////////////////////////////
+
+        int finishClusterImport (std::string const&,
+                                 RestImportClusterDocuments&,
+                                 RestImportResult&,
+                                 int,
+                                 bool,
+                                 bool);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief creates documents by JSON objects
 /// each line of the input stream contains an individual JSON object
@@ -86,6 +86,14 @@ namespace triagens {
 
         Handler::status_t execute ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief bulk requests are queued with a low priority
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::rest::Job::JobPriority priority () const override {
+          return triagens::rest::Job::LOW_PRIORITY;
+        }
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                             public static methods
 // -----------------------------------------------------------------------------
@@ -82,6 +82,7 @@
 #include "V8/v8-utils.h"
 #include "V8Server/ApplicationV8.h"
 #include "VocBase/auth.h"
+#include "VocBase/MaintenanceScheduler.h"
 #include "VocBase/server.h"
 #include "Wal/LogfileManager.h"
 
@@ -337,6 +338,9 @@ ArangoServer::ArangoServer (int argc, char** argv)
     _dispatcherQueueSize(16384),
     _v8Contexts(8),
     _indexThreads(2),
+    _maintenanceThreads(2),
+    _compactionIoBudget(0),
+    _datafileColdTime(0.0),
     _databasePath(),
     _defaultMaximalSize(TRI_JOURNAL_DEFAULT_MAXIMAL_SIZE),
     _defaultWaitForSync(false),
@@ -350,6 +354,7 @@ ArangoServer::ArangoServer (int argc, char** argv)
     _queryRegistry(nullptr),
     _pairForAql(nullptr),
     _indexPool(nullptr),
+    _maintenanceScheduler(nullptr),
     _threadAffinity(0) {
 
   TRI_SetApplicationName("arangod");
@@ -382,6 +387,8 @@ ArangoServer::ArangoServer (int argc, char** argv)
 ////////////////////////////////////////////////////////////////////////////////
 
 ArangoServer::~ArangoServer () {
+  delete _maintenanceScheduler;
+
   delete _indexPool;
 
   delete _jobManager;
@@ -591,6 +598,9 @@ void ArangoServer::buildApplicationServer () {
     ("database.ignore-datafile-errors", &_ignoreDatafileErrors, "load collections even if datafiles may contain errors")
     ("database.disable-query-tracking", &_disableQueryTracking, "turn off AQL query tracking by default")
     ("database.index-threads", &_indexThreads, "threads to start for parallel background index creation")
+    ("database.maintenance-threads", &_maintenanceThreads, "threads to start for cleanup and compaction of all databases")
+    ("database.compaction-io-budget", &_compactionIoBudget, "maximum number of datafile bytes to compact per second (0 = unlimited)")
+    ("database.datafile-cold-time", &_datafileColdTime, "drop datafiles from memory that were not read for this many seconds (0 = never)")
   ;
 
   // .............................................................................
@@ -802,6 +812,14 @@ void ArangoServer::buildApplicationServer () {
       _indexThreads = 128;
     }
   }
+
+  if (_maintenanceThreads < 1) {
+    _maintenanceThreads = 1;
+  }
+  else if (_maintenanceThreads > 64) {
+    // some arbitrary limit
+    _maintenanceThreads = 64;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1422,9 +1440,12 @@ void ArangoServer::openDatabases (bool checkVersion,
     _indexPool = new triagens::basics::ThreadPool(_indexThreads, "IndexBuilder");
   }
 
+  _maintenanceScheduler = new MaintenanceScheduler(static_cast<size_t>(_maintenanceThreads), _compactionIoBudget, _datafileColdTime);
+
   int res = TRI_InitServer(_server,
                            _applicationEndpointServer,
                            _indexPool,
+                           _maintenanceScheduler,
                            _databasePath.c_str(),
                            _applicationV8->appPath().c_str(),
                            &defaults,
@@ -72,6 +72,7 @@ namespace triagens {
     class ApplicationMR;
     class ApplicationV8;
     class ApplicationCluster;
+    class MaintenanceScheduler;
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                class ArangoServer
@@ -372,6 +373,51 @@ namespace triagens {
 
         int _indexThreads;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of worker threads for cleanup and compaction
+/// @startDocuBlock maintenanceThreads
+/// `--database.maintenance-threads`
+///
+/// Specifies the *number* of worker threads that run cleanup and compaction
+/// jobs. The workers are shared among all databases of the server. Cleanup
+/// jobs are preferred over compaction jobs, and collections with a higher
+/// share of dead data are compacted first. At most one job per database is
+/// running at any time.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        int _maintenanceThreads;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief server-wide I/O budget for compaction
+/// @startDocuBlock compactionIoBudget
+/// `--database.compaction-io-budget`
+///
+/// Specifies the number of datafile bytes that may be compacted per second,
+/// summed up over all databases and collections. No new compaction is
+/// started while the budget is used up. Specifying a value of *0* turns off
+/// the limit.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t _compactionIoBudget;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief time after which unused datafiles are dropped from memory
+/// @startDocuBlock datafileColdTime
+/// `--database.datafile-cold-time`
+///
+/// Specifies the number of seconds after which a datafile of a collection
+/// that was not read anymore is dropped from memory. The datafile stays
+/// mapped, and its contents are read in again from disk when it is used the
+/// next time. This keeps the memory usage of large collections with a small
+/// working set predictable. Journals and compressed datafiles are never
+/// dropped. Specifying a value of *0* turns this off.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        double _datafileColdTime;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief path to the database
 /// @startDocuBlock DatabaseDirectory
@@ -633,6 +679,12 @@ namespace triagens {
 
         triagens::basics::ThreadPool* _indexPool;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief scheduler for cleanup and compaction
+////////////////////////////////////////////////////////////////////////////////
+
+        MaintenanceScheduler* _maintenanceScheduler;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief use thread affinity
 ////////////////////////////////////////////////////////////////////////////////
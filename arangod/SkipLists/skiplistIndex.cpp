@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "skiplistIndex.h"
+#include "Basics/Exceptions.h"
 #include "Basics/Utf8Helper.h"
 #include "ShapedJson/json-shaper.h"
 #include "ShapedJson/shaped-json.h"
@@ -992,6 +993,43 @@ int SkiplistIndex_insert (SkiplistIndex* skiplistIndex,
   return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief builds an empty skip list from a batch of elements
+/// the elements are sorted and linked bottom-up, ownership for the elements
+/// is transferred to the index in any case
+////////////////////////////////////////////////////////////////////////////////
+
+int SkiplistIndex_bulkLoad (SkiplistIndex* skiplistIndex,
+                            std::vector<TRI_skiplist_index_element_t*>& elements) {
+  int res;
+
+  try {
+    std::sort(elements.begin(), elements.end(),
+      [&skiplistIndex] (TRI_skiplist_index_element_t* l, TRI_skiplist_index_element_t* r) {
+        return CmpElmElm(skiplistIndex, l, r, triagens::basics::SKIPLIST_CMP_TOTORDER) < 0;
+      });
+
+    std::vector<void*> docs(elements.begin(), elements.end());
+    res = skiplistIndex->skiplist->bulkLoad(docs);
+  }
+  catch (triagens::basics::Exception const& ex) {
+    res = ex.code();
+  }
+  catch (...) {
+    res = TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    for (auto element : elements) {
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, element);
+    }
+  }
+
+  elements.clear();
+
+  return res;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief removes an entry from the skip list
 /// ownership for the element is transferred to the index
@@ -153,6 +153,8 @@ TRI_skiplist_iterator_t* SkiplistIndex_find (SkiplistIndex*,
 
 int SkiplistIndex_insert (SkiplistIndex*, TRI_skiplist_index_element_t*);
 
+int SkiplistIndex_bulkLoad (SkiplistIndex*, std::vector<TRI_skiplist_index_element_t*>&);
+
 int SkiplistIndex_remove (SkiplistIndex*, TRI_skiplist_index_element_t*);
 
 bool SkiplistIndex_update (SkiplistIndex*, const TRI_skiplist_index_element_t*,
@@ -123,7 +123,24 @@ namespace triagens {
         
         virtual size_t count () const = 0;
 
-        virtual void dump (triagens::basics::StringBuffer&) = 0;
+////////////////////////////////////////////////////////////////////////////////
+/// @brief appends the next result to the buffer
+////////////////////////////////////////////////////////////////////////////////
+
+        virtual void dumpNext (triagens::basics::StringBuffer&) = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief appends the attributes following the result of a batch, and marks
+/// the cursor as deleted if it is exhausted
+////////////////////////////////////////////////////////////////////////////////
+
+        void dumpTail (triagens::basics::StringBuffer&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief dumps the next batch into the buffer
+////////////////////////////////////////////////////////////////////////////////
+
+        void dump (triagens::basics::StringBuffer&);
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                               protected variables
@@ -171,7 +188,7 @@ namespace triagens {
         
         size_t count () const override final;
 
-        void dump (triagens::basics::StringBuffer&) override final;
+        void dumpNext (triagens::basics::StringBuffer&) override final;
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private functions
@@ -220,7 +237,7 @@ namespace triagens {
         
         size_t count () const override final;
 
-        void dump (triagens::basics::StringBuffer&) override final;
+        void dumpNext (triagens::basics::StringBuffer&) override final;
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief streamed cursor response
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Utils/CursorStream.h"
+#include "Utils/Cursor.h"
+#include "Utils/CursorRepository.h"
+
+using namespace triagens::arango;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                class CursorStream
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+CursorStream::CursorStream (CursorRepository* cursors,
+                            Cursor* cursor,
+                            triagens::rest::HttpResponse::HttpResponseCode code)
+  : _cursors(cursors),
+    _cursor(cursor),
+    _code(code),
+    _dumped(0),
+    _started(false) {
+
+  TRI_ASSERT(_cursor->isUsed());
+}
+
+CursorStream::~CursorStream () {
+  if (_cursor != nullptr) {
+    // the batch was not completed
+    _cursor->deleted();
+    _cursors->release(_cursor);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        HttpResponseStream methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief appends the next part of the batch to the buffer
+////////////////////////////////////////////////////////////////////////////////
+
+bool CursorStream::next (triagens::basics::StringBuffer& buffer,
+                         size_t chunkSize) {
+  TRI_ASSERT(_cursor != nullptr);
+
+  size_t const initialLength = buffer.length();
+
+  if (! _started) {
+    buffer.appendText("{\"result\":[");
+    _started = true;
+  }
+
+  size_t const n = _cursor->batchSize();
+
+  while (_dumped < n && _cursor->hasNext()) {
+    if (_dumped > 0) {
+      buffer.appendChar(',');
+    }
+
+    _cursor->dumpNext(buffer);
+    ++_dumped;
+
+    if (buffer.length() - initialLength >= chunkSize) {
+      return true;
+    }
+  }
+
+  _cursor->dumpTail(buffer);
+
+  buffer.appendText(",\"error\":false,\"code\":");
+  buffer.appendInteger(static_cast<uint32_t>(_code));
+  buffer.appendChar('}');
+
+  _cursors->release(_cursor);
+  _cursor = nullptr;
+
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
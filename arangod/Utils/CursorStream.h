@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief streamed cursor response
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_ARANGO_CURSOR_STREAM_H
+#define ARANGODB_ARANGO_CURSOR_STREAM_H 1
+
+#include "Basics/Common.h"
+#include "Rest/HttpResponse.h"
+
+namespace triagens {
+  namespace arango {
+
+    class Cursor;
+    class CursorRepository;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                class CursorStream
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief produces the response for the next batch of a cursor
+///
+/// The stream takes over a cursor that is in use and releases it once the
+/// batch has been produced. If the stream is abandoned before that, the
+/// cursor is deleted because the client cannot know where the batch ended.
+////////////////////////////////////////////////////////////////////////////////
+
+    class CursorStream : public triagens::rest::HttpResponseStream {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        CursorStream (CursorRepository*,
+                      Cursor*,
+                      triagens::rest::HttpResponse::HttpResponseCode);
+
+        ~CursorStream ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        HttpResponseStream methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+        bool next (triagens::basics::StringBuffer&, size_t) override final;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+        CursorRepository* _cursors;
+
+        Cursor* _cursor;
+
+        triagens::rest::HttpResponse::HttpResponseCode const _code;
+
+        size_t _dumped;
+
+        bool _started;
+    };
+  }
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
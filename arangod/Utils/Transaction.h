@@ -418,6 +418,8 @@ namespace triagens {
           uint32_t count = 0;
           *total = (uint32_t) primaryIndex->_nrUsed;
 
+          document->touchScan();
+
           try {
             if (batchSize > 2048) {
               docs.reserve(2048);
@@ -436,6 +438,7 @@ namespace triagens {
                 }
                 else {
                   docs.emplace_back(*d);
+                  document->touchDatafile(d->_fid);
                   if (++count >= limit) {
                     break;
                   }
@@ -512,12 +515,15 @@ namespace triagens {
             }
           }
 
+          document->touchScan();
+
           TRI_voc_size_t numRead = 0;
           do {
             auto d = static_cast<TRI_doc_mptr_t*>(primaryIndex->_table[position]);
 
             if (d != nullptr) {
               docs.emplace_back(*d);
+              document->touchDatafile(d->_fid);
               ++numRead;
             }
 
@@ -864,6 +870,7 @@ namespace triagens {
             }
 
             *mptr = *((TRI_doc_mptr_t*) beg[pos]);
+            document->touchLookup(mptr->_fid);
           }
 
           this->unlock(trxCollection, TRI_TRANSACTION_READ);
@@ -903,10 +910,13 @@ namespace triagens {
             void** ptr = primaryIndex->_table;
             void** end = ptr + primaryIndex->_nrAlloc;
 
+            document->touchScan();
+
             for (;  ptr < end;  ++ptr) {
               if (*ptr) {
                 TRI_doc_mptr_t const* d = (TRI_doc_mptr_t const*) *ptr;
                 ids.push_back(TRI_EXTRACT_MARKER_KEY(d));  // PROTECTED by trx in trxCollection
+                document->touchDatafile(d->_fid);
               }
             }
           }
@@ -940,40 +950,92 @@ namespace triagens {
             return TRI_ERROR_OUT_OF_MEMORY;
           }
 
-          TRI_doc_mptr_t* doc;
+          TRI_headers_t const* headers = document->_headersPtr;  // PROTECTED by trx in trxCollection
+
+          if (headers->hasOrder()) {
+            TRI_doc_mptr_t* doc;
 
-          if (offset >= 0) {
-            // read from front
-            doc = document->_headersPtr->front();  // PROTECTED by trx in trxCollection
-            int64_t i = 0;
+            if (offset >= 0) {
+              // read from front
+              doc = headers->front();
+              int64_t i = 0;
 
-            while (doc != nullptr && i < offset) {
-              doc = doc->_next;
-              ++i;
+              while (doc != nullptr && i < offset) {
+                doc = headers->next(doc);
+                ++i;
+              }
+
+              i = 0;
+              while (doc != nullptr && i < count) {
+                documents.emplace_back(*doc);
+                doc = headers->next(doc);
+                ++i;
+              }
             }
+            else {
+              // read from back
+              doc = headers->back();
+              int64_t i = -1;
+
+              while (doc != nullptr && i > offset) {
+                doc = headers->prev(doc);
+                --i;
+              }
 
-            i = 0;
-            while (doc != nullptr && i < count) {
-              documents.emplace_back(*doc);
-              doc = doc->_next;
-              ++i;
+              i = 0;
+              while (doc != nullptr && i < count) {
+                documents.emplace_back(*doc);
+                doc = headers->prev(doc);
+                ++i;
+              }
             }
           }
           else {
-            // read from back
-            doc = document->_headersPtr->back();  // PROTECTED by trx in trxCollection
-            int64_t i = -1;
+            // the order is not tracked for this collection. revision ids are
+            // increasing, so order the documents by their revision ids. only
+            // the first skip + count documents are kept, in a heap whose top
+            // is the least wanted of them, so no full copy of the index is made
+            auto primaryIndex = document->primaryIndex()->internals();
 
-            while (doc != nullptr && i > offset) {
-              doc = doc->_prev;
-              --i;
-            }
+            bool const fromFront = (offset >= 0);
+            size_t const skip = static_cast<size_t>(fromFront ? offset : (- offset - 1));
+
+            if (skip < static_cast<size_t>(primaryIndex->_nrUsed) && count > 0) {
+              size_t const wanted = skip + static_cast<size_t>(count);
+
+              auto comparator = [&fromFront] (TRI_doc_mptr_t const* lhs, TRI_doc_mptr_t const* rhs) {
+                return fromFront ? (lhs->_rid < rhs->_rid) : (lhs->_rid > rhs->_rid);
+              };
 
-            i = 0;
-            while (doc != nullptr && i < count) {
-              documents.emplace_back(*doc);
-              doc = doc->_prev;
-              ++i;
+              std::vector<TRI_doc_mptr_t const*> heap;
+              heap.reserve((std::min)(wanted, static_cast<size_t>(primaryIndex->_nrUsed)));
+
+              void** ptr = primaryIndex->_table;
+              void** end = ptr + primaryIndex->_nrAlloc;
+
+              for (;  ptr < end;  ++ptr) {
+                if (*ptr == nullptr) {
+                  continue;
+                }
+
+                auto mptr = static_cast<TRI_doc_mptr_t const*>(*ptr);
+
+                if (heap.size() < wanted) {
+                  heap.emplace_back(mptr);
+                  std::push_heap(heap.begin(), heap.end(), comparator);
+                }
+                else if (comparator(mptr, heap.front())) {
+                  std::pop_heap(heap.begin(), heap.end(), comparator);
+                  heap.back() = mptr;
+                  std::push_heap(heap.begin(), heap.end(), comparator);
+                }
+              }
+
+              std::sort_heap(heap.begin(), heap.end(), comparator);
+
+              for (size_t i = skip; i < heap.size(); ++i) {
+                documents.emplace_back(*heap[i]);
+              }
             }
           }
 
@@ -1027,6 +1089,8 @@ namespace triagens {
 
           *total = (uint32_t) primaryIndex->_nrUsed;
 
+          document->touchScan();
+
           // apply skip
           if (skip > 0) {
             // skip from the beginning
@@ -1061,6 +1125,7 @@ namespace triagens {
               TRI_doc_mptr_t* d = (TRI_doc_mptr_t*) *ptr;
 
               docs.emplace_back(*d);
+              document->touchDatafile(d->_fid);
               ++count;
             }
           }
@@ -1103,11 +1168,14 @@ namespace triagens {
           void** ptr = primaryIndex->_table;
           void** end = ptr + primaryIndex->_nrAlloc;
 
+          document->touchScan();
+
           // fetch documents, taking limit into account
           for (; ptr < end; ++ptr) {
             if (*ptr) {
               TRI_doc_mptr_t* d = (TRI_doc_mptr_t*) *ptr;
               docs.push_back(d);
+              document->touchDatafile(d->_fid);
             }
           }
 
@@ -1150,6 +1218,8 @@ namespace triagens {
             void** end = ptr + primaryIndex->_nrAlloc;
             *total = (uint32_t) primaryIndex->_nrUsed;
 
+            document->touchScan();
+
             // fetch documents, taking partition into account
             for (; ptr < end; ++ptr) {
               if (*ptr) {
@@ -1158,6 +1228,7 @@ namespace triagens {
                 if (d->_hash % numberOfPartitions == partitionId) {
                   // correct partition
                   docs.emplace_back(*d);
+                  document->touchDatafile(d->_fid);
                 }
               }
             }
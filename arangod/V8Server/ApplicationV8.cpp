@@ -796,10 +796,10 @@ void ApplicationV8::upgradeDatabase (bool skip,
 
         res |= TRI_StopCompactorVocBase(vocbase);
         vocbase->_state = 3;
-        res |= TRI_JoinThread(&vocbase->_cleanup);
+        res |= TRI_StopCleanupVocBase(vocbase);
 
         if (res != TRI_ERROR_NO_ERROR) {
-          LOG_ERROR("unable to join database threads for database '%s'", vocbase->_name);
+          LOG_ERROR("unable to stop maintenance for database '%s'", vocbase->_name);
         }
       }
     }
@@ -882,10 +882,10 @@ void ApplicationV8::versionCheck () {
 
       res |= TRI_StopCompactorVocBase(vocbase);
       vocbase->_state = 3;
-      res |= TRI_JoinThread(&vocbase->_cleanup);
+      res |= TRI_StopCleanupVocBase(vocbase);
 
       if (res != TRI_ERROR_NO_ERROR) {
-        LOG_ERROR("unable to join database threads for database '%s'", vocbase->_name);
+        LOG_ERROR("unable to stop maintenance for database '%s'", vocbase->_name);
       }
     }
   }
@@ -905,8 +905,25 @@ void ApplicationV8::versionCheck () {
 void ApplicationV8::prepareServer () {
   size_t nrInstances = _nrInstances[DEFAULT_NAME];
 
-  for (size_t i = 0;  i < nrInstances;  ++i) {
-    prepareV8Server(DEFAULT_NAME, i, _startupFile);
+  if (nrInstances == 0) {
+    return;
+  }
+
+  // the first context performs the one-time server setup (statistics, Foxx
+  // applications, queue manager) the other contexts rely on
+  prepareV8Server(DEFAULT_NAME, 0, _startupFile);
+
+  // the other contexts only load modules and routing, each in its own
+  // isolate, so they are bootstrapped in parallel
+  std::vector<std::thread> threads;
+
+  for (size_t i = 1;  i < nrInstances;  ++i) {
+    threads.push_back(std::thread(&ApplicationV8::prepareV8Server,
+                                  this, DEFAULT_NAME, i, _startupFile));
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
   }
 }
 
@@ -1285,19 +1302,25 @@ ApplicationV8::V8Context* ApplicationV8::pickFreeContextForGc () {
 ////////////////////////////////////////////////////////////////////////////////
 
 bool ApplicationV8::prepareV8Instance (const string& name, size_t i, bool useActions) {
-  CONDITION_LOCKER(guard, _contextCondition);
-
   vector<string> files;
 
   files.push_back("server/initialise.js");
 
   v8::Isolate* isolate = v8::Isolate::New();
   
-  V8Context* context = _contexts[name][i] = new V8Context();
+  V8Context* context = new V8Context();
 
   if (context == nullptr) {
     LOG_FATAL_AND_EXIT("cannot initialize V8 context #%d", (int) i);
   }
+
+  // only the registration of the context needs the lock. the isolate is
+  // private to the calling thread, so that the contexts can be created in
+  // parallel
+  {
+    CONDITION_LOCKER(guard, _contextCondition);
+    _contexts[name][i] = context;
+  }
   
   TRI_ASSERT(context->_locker == nullptr);
 
@@ -1408,7 +1431,10 @@ bool ApplicationV8::prepareV8Instance (const string& name, size_t i, bool useAct
 
   LOG_TRACE("initialised V8 context #%d", (int) i);
 
-  _freeContexts[name].push_back(context);
+  {
+    CONDITION_LOCKER(guard, _contextCondition);
+    _freeContexts[name].push_back(context);
+  }
 
   return true;
 }
@@ -1418,9 +1444,14 @@ bool ApplicationV8::prepareV8Instance (const string& name, size_t i, bool useAct
 ////////////////////////////////////////////////////////////////////////////////
 
 void ApplicationV8::prepareV8Server (const string& name, const size_t i, const string& startupFile) {
+  V8Context* context;
+
+  {
+    CONDITION_LOCKER(guard, _contextCondition);
+    context = _contexts[name][i];
+  }
 
   // enter context and isolate
-  V8Context* context = _contexts[name][i];
 
   auto isolate = context->isolate;
   TRI_ASSERT(context->_locker == nullptr);
@@ -100,6 +100,15 @@ string const& V8QueueJob::queue () const {
 /// {@inheritDoc}
 ////////////////////////////////////////////////////////////////////////////////
 
+Job::JobPriority V8QueueJob::priority () const {
+  // queued tasks run in the background
+  return LOW_PRIORITY;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
 Job::status_t V8QueueJob::work () {
   if (_canceled) {
     return status_t(JOB_DONE);
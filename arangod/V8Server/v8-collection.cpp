@@ -44,6 +44,7 @@
 #include "Wal/LogfileManager.h"
 
 #include "VocBase/auth.h"
+#include "VocBase/compactor.h"
 #include "VocBase/KeyGenerator.h"
 
 #include "Cluster/ClusterMethods.h"
@@ -1722,9 +1723,20 @@ static TRI_doc_collection_info_t* GetFigures (TRI_vocbase_col_t* collection) {
 ///   only contained in the write-ahead log are not reporting in this figure.
 /// * *datafiles.count*: The number of datafiles.
 /// * *datafiles.fileSize*: The total filesize of datafiles (in bytes).
+/// * *datafiles.compressedCount*: The number of datafiles that are stored
+///   compressed on disk (see the *compressDatafiles* collection property).
+/// * *datafiles.compressedFileSize*: The total size of the compressed
+///   datafiles on disk (in bytes).
+/// * *datafiles.residentSize*: The number of bytes of the datafiles currently
+///   held in memory.
+/// * *datafiles.coldCount*: The number of datafiles that were dropped from
+///   memory because they were not read for a while (see the option
+///   *--database.datafile-cold-time*).
 /// * *journals.count*: The number of journal files.
 /// * *journals.fileSize*: The total filesize of the journal files
 ///   (in bytes).
+/// * *journals.residentSize*: The number of bytes of the journal files
+///   currently held in memory.
 /// * *compactors.count*: The number of compactor files.
 /// * *compactors.fileSize*: The total filesize of the compactor files
 ///   (in bytes).
@@ -1831,6 +1843,10 @@ static void JS_FiguresVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>& arg
   result->Set(TRI_V8_ASCII_STRING("datafiles"), dfs);
   dfs->Set(TRI_V8_ASCII_STRING("count"),         v8::Number::New(isolate, (double) info->_numberDatafiles));
   dfs->Set(TRI_V8_ASCII_STRING("fileSize"),      v8::Number::New(isolate, (double) info->_datafileSize));
+  dfs->Set(TRI_V8_ASCII_STRING("compressedCount"),    v8::Number::New(isolate, (double) info->_numberCompressedDatafiles));
+  dfs->Set(TRI_V8_ASCII_STRING("compressedFileSize"), v8::Number::New(isolate, (double) info->_compressedDatafileSize));
+  dfs->Set(TRI_V8_ASCII_STRING("residentSize"),  v8::Number::New(isolate, (double) info->_datafileResidentSize));
+  dfs->Set(TRI_V8_ASCII_STRING("coldCount"),     v8::Number::New(isolate, (double) info->_numberColdDatafiles));
 
   // journal info
   v8::Handle<v8::Object> js = v8::Object::New(isolate);
@@ -1838,6 +1854,7 @@ static void JS_FiguresVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>& arg
   result->Set(TRI_V8_ASCII_STRING("journals"), js);
   js->Set(TRI_V8_ASCII_STRING("count"),          v8::Number::New(isolate, (double) info->_numberJournalfiles));
   js->Set(TRI_V8_ASCII_STRING("fileSize"),       v8::Number::New(isolate, (double) info->_journalfileSize));
+  js->Set(TRI_V8_ASCII_STRING("residentSize"),   v8::Number::New(isolate, (double) info->_journalResidentSize));
 
   // compactors info
   v8::Handle<v8::Object> cs = v8::Object::New(isolate);
@@ -1846,6 +1863,21 @@ static void JS_FiguresVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>& arg
   cs->Set(TRI_V8_ASCII_STRING("count"),          v8::Number::New(isolate, (double) info->_numberCompactorfiles));
   cs->Set(TRI_V8_ASCII_STRING("fileSize"),       v8::Number::New(isolate, (double) info->_compactorfileSize));
 
+  // compaction info
+  v8::Handle<v8::Object> compaction = v8::Object::New(isolate);
+  double deadRatio = 0.0;
+
+  if (info->_sizeDead > 0) {
+    deadRatio = (double) info->_sizeDead / ((double) info->_sizeDead + (double) info->_sizeAlive);
+  }
+
+  result->Set(TRI_V8_ASCII_STRING("compaction"), compaction);
+  compaction->Set(TRI_V8_ASCII_STRING("count"),        v8::Number::New(isolate, (double) info->_compactionRuns));
+  compaction->Set(TRI_V8_ASCII_STRING("bytesRead"),    v8::Number::New(isolate, (double) info->_compactionBytesRead));
+  compaction->Set(TRI_V8_ASCII_STRING("bytesWritten"), v8::Number::New(isolate, (double) info->_compactionBytesWritten));
+  compaction->Set(TRI_V8_ASCII_STRING("time"),         v8::Number::New(isolate, info->_compactionTime));
+  compaction->Set(TRI_V8_ASCII_STRING("deadRatio"),    v8::Number::New(isolate, deadRatio));
+
   // shapefiles info
   v8::Handle<v8::Object> sf = v8::Object::New(isolate);
 
@@ -1939,6 +1971,53 @@ static void JS_LoadVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>& args)
   TRI_V8_TRY_CATCH_END
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief manages the memory residency of the datafiles of a collection
+///
+/// runs the residency pass of the cleanup for the collection, with the given
+/// cold time instead of *--database.datafile-cold-time*, and returns the
+/// number of datafiles that are cold afterwards
+////////////////////////////////////////////////////////////////////////////////
+
+static void JS_ManageResidencyVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>& args) {
+  TRI_V8_TRY_CATCH_BEGIN(isolate);
+  v8::HandleScope scope(isolate);
+
+  if (ServerState::instance()->isCoordinator()) {
+    TRI_V8_THROW_EXCEPTION(TRI_ERROR_CLUSTER_UNSUPPORTED);
+  }
+
+  if (args.Length() != 1) {
+    TRI_V8_THROW_EXCEPTION_USAGE("manageResidency(<coldTime>)");
+  }
+
+  double const coldTime = TRI_ObjectToDouble(args[0]);
+
+  TRI_vocbase_col_t const* collection = UseCollection(args.Holder(), args);
+
+  if (collection == nullptr) {
+    return;
+  }
+
+  TRI_THROW_SHARDING_COLLECTION_NOT_YET_IMPLEMENTED(collection);
+
+  TRI_document_collection_t* document = collection->_collection;
+
+  // the cleanup runs its residency pass under the compactor lock
+  while (! TRI_CheckAndLockCompactorVocBase(document->_vocbase)) {
+    usleep(5000);
+  }
+
+  size_t const numCold = TRI_ManageResidencyDocumentCollection(document, coldTime);
+
+  TRI_UnlockCompactorVocBase(document->_vocbase);
+
+  ReleaseCollection(collection);
+
+  TRI_V8_RETURN(v8::Number::New(isolate, (double) numCold));
+  TRI_V8_TRY_CATCH_END
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns the name of a collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -2038,6 +2117,19 @@ static void JS_PlanIdVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>& args
 ///   value. Changes (see below) are applied when the collection is
 ///   loaded the next time.
 ///
+/// * *compactionDeadSizeThreshold*: minimum size of dead data (in bytes) in
+///   a datafile that makes the datafile eligible for compaction.
+///
+/// * *compactionDeadSizeShare*: minimum share of dead data in a datafile
+///   (between 0 and 1) that makes the datafile eligible for compaction.
+///
+/// * *compactionMaxFileSize*: maximum size of a compacted file (in bytes).
+///
+/// * *compressDatafiles*: If *true*, the compactor rewrites sealed datafiles
+///   into a block-compressed format. Journals are never compressed, and
+///   compressed datafiles are decompressed into a temporary file when the
+///   collection is loaded. This is meant for read-mostly collections.
+///
 /// In a cluster setup, the result will also contain the following attributes:
 ///
 /// * *numberOfShards*: the number of shards of the collection.
@@ -2058,6 +2150,14 @@ static void JS_PlanIdVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>& args
 /// * *indexBuckets* : See above, changes are only applied when the
 ///   collection is loaded the next time.
 ///
+/// * *compactionDeadSizeThreshold*, *compactionDeadSizeShare* and
+///   *compactionMaxFileSize*: See above, changes are applied to the next
+///   compaction run.
+///
+/// * *compressDatafiles*: See above. When turned on, existing datafiles are
+///   compressed by the following compaction runs. When turned off, already
+///   compressed datafiles stay compressed until they are compacted again.
+///
 /// *Note*: it is not possible to change the journal size after the journal or
 /// datafile has been created. Changing this parameter will only effect newly
 /// created journals. Also note that you cannot lower the journal size to less
@@ -2232,6 +2332,10 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
       bool doCompact     = base->_info._doCompact;
       bool waitForSync   = base->_info._waitForSync;
       uint32_t indexBuckets = base->_info._indexBuckets;
+      uint64_t compactionDeadSizeThreshold = base->_info._compactionDeadSizeThreshold;
+      double compactionDeadSizeShare       = base->_info._compactionDeadSizeShare;
+      uint64_t compactionMaxFileSize       = base->_info._compactionMaxFileSize;
+      bool compressDatafiles               = base->_info._compressDatafiles;
 
       TRI_UNLOCK_JOURNAL_ENTRIES_DOC_COLLECTION(document);
 
@@ -2241,6 +2345,11 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
         doCompact = TRI_ObjectToBoolean(po->Get(DoCompactKey));
       }
 
+      // extract compression flag
+      if (po->Has(TRI_V8_ASCII_STRING("compressDatafiles"))) {
+        compressDatafiles = TRI_ObjectToBoolean(po->Get(TRI_V8_ASCII_STRING("compressDatafiles")));
+      }
+
       // extract sync flag
       TRI_GET_GLOBAL_STRING(WaitForSyncKey);
       if (po->Has(WaitForSyncKey)) {
@@ -2281,6 +2390,29 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
         }
       }
 
+      // extract the compaction thresholds
+      if (po->Has(TRI_V8_ASCII_STRING("compactionDeadSizeThreshold"))) {
+        compactionDeadSizeThreshold = TRI_ObjectToUInt64(po->Get(TRI_V8_ASCII_STRING("compactionDeadSizeThreshold")), true);
+      }
+
+      if (po->Has(TRI_V8_ASCII_STRING("compactionDeadSizeShare"))) {
+        compactionDeadSizeShare = TRI_ObjectToDouble(po->Get(TRI_V8_ASCII_STRING("compactionDeadSizeShare")));
+
+        if (compactionDeadSizeShare < 0.0 || compactionDeadSizeShare > 1.0) {
+          ReleaseCollection(collection);
+          TRI_V8_THROW_EXCEPTION_PARAMETER("compactionDeadSizeShare must be between 0 and 1");
+        }
+      }
+
+      if (po->Has(TRI_V8_ASCII_STRING("compactionMaxFileSize"))) {
+        compactionMaxFileSize = TRI_ObjectToUInt64(po->Get(TRI_V8_ASCII_STRING("compactionMaxFileSize")), true);
+
+        if (compactionMaxFileSize < TRI_JOURNAL_MINIMAL_SIZE) {
+          ReleaseCollection(collection);
+          TRI_V8_THROW_EXCEPTION_PARAMETER("<properties>.compactionMaxFileSize too small");
+        }
+      }
+
       // update collection
       TRI_col_info_t newParameters;
 
@@ -2288,6 +2420,10 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
       newParameters._maximalSize = maximalSize;
       newParameters._waitForSync = waitForSync;
       newParameters._indexBuckets = indexBuckets;
+      newParameters._compactionDeadSizeThreshold = compactionDeadSizeThreshold;
+      newParameters._compactionDeadSizeShare     = compactionDeadSizeShare;
+      newParameters._compactionMaxFileSize       = compactionMaxFileSize;
+      newParameters._compressDatafiles           = compressDatafiles;
 
       // try to write new parameter to file
       bool doSync = base->_vocbase->_settings.forceSyncProperties;
@@ -2340,6 +2476,14 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
   result->Set(JournalSizeKey, v8::Number::New( isolate, base->_info._maximalSize));
   result->Set(TRI_V8_ASCII_STRING("indexBuckets"),
               v8::Number::New(isolate, document->_info._indexBuckets));
+  result->Set(TRI_V8_ASCII_STRING("compactionDeadSizeThreshold"),
+              v8::Number::New(isolate, (double) document->_info._compactionDeadSizeThreshold));
+  result->Set(TRI_V8_ASCII_STRING("compactionDeadSizeShare"),
+              v8::Number::New(isolate, document->_info._compactionDeadSizeShare));
+  result->Set(TRI_V8_ASCII_STRING("compactionMaxFileSize"),
+              v8::Number::New(isolate, (double) document->_info._compactionMaxFileSize));
+  result->Set(TRI_V8_ASCII_STRING("compressDatafiles"),
+              v8::Boolean::New(isolate, document->_info._compressDatafiles));
 
   TRI_json_t* keyOptions = document->_keyGenerator->toJson(TRI_UNKNOWN_MEM_ZONE);
 
@@ -4468,6 +4612,7 @@ void TRI_InitV8collection (v8::Handle<v8::Context> context,
   TRI_AddMethodVocbase(isolate, rt, TRI_V8_ASCII_STRING("figures"), JS_FiguresVocbaseCol);
   TRI_AddMethodVocbase(isolate, rt, TRI_V8_ASCII_STRING("insert"), JS_InsertVocbaseCol);
   TRI_AddMethodVocbase(isolate, rt, TRI_V8_ASCII_STRING("load"), JS_LoadVocbaseCol);
+  TRI_AddMethodVocbase(isolate, rt, TRI_V8_ASCII_STRING("manageResidency"), JS_ManageResidencyVocbaseCol, true);
   TRI_AddMethodVocbase(isolate, rt, TRI_V8_ASCII_STRING("name"), JS_NameVocbaseCol);
   TRI_AddMethodVocbase(isolate, rt, TRI_V8_ASCII_STRING("planId"), JS_PlanIdVocbaseCol);
   TRI_AddMethodVocbase(isolate, rt, TRI_V8_ASCII_STRING("properties"), JS_PropertiesVocbaseCol);
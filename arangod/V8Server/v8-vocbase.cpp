@@ -58,6 +58,7 @@
 #include "V8Server/V8Traverser.h"
 #include "VocBase/auth.h"
 #include "VocBase/KeyGenerator.h"
+#include "VocBase/MaintenanceScheduler.h"
 #include "Wal/LogfileManager.h"
 
 #include <unicode/timezone.h>
@@ -514,6 +515,148 @@ static void JS_PropertiesWal (const v8::FunctionCallbackInfo<v8::Value>& args) {
   TRI_V8_TRY_CATCH_END
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a maintenance job into a V8 object
+////////////////////////////////////////////////////////////////////////////////
+
+static v8::Handle<v8::Object> MaintenanceJobToV8 (v8::Isolate* isolate,
+                                                  MaintenanceScheduler::Job const& job) {
+  v8::Handle<v8::Object> result = v8::Object::New(isolate);
+
+  result->Set(TRI_V8_ASCII_STRING("type"),       TRI_V8_ASCII_STRING(job.type == MaintenanceScheduler::JOB_CLEANUP ? "cleanup" : "compaction"));
+  result->Set(TRI_V8_ASCII_STRING("database"),   TRI_V8_STRING(job.vocbase->_name));
+  result->Set(TRI_V8_ASCII_STRING("priority"),   v8::Number::New(isolate, job.priority));
+
+  if (job.type == MaintenanceScheduler::JOB_COMPACTION) {
+    result->Set(TRI_V8_ASCII_STRING("collection"), V8TickId(isolate, job.cid));
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the state of the cleanup and compaction queue
+/// @startDocuBlock maintenanceQueue
+/// `internal.maintenance.queue()`
+///
+/// Returns the number of maintenance worker threads, the compaction I/O
+/// budget (in bytes per second, *0* means unlimited), the currently
+/// available budget (in bytes), the backoff factor applied under load, the
+/// resulting effective compaction rate (in bytes per second, *0* means
+/// unlimited), and the queued and the running cleanup and compaction jobs of
+/// all databases. Queued jobs are sorted by priority,
+/// highest first.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+static void JS_QueueMaintenance (const v8::FunctionCallbackInfo<v8::Value>& args) {
+  TRI_V8_TRY_CATCH_BEGIN(isolate);
+  v8::HandleScope scope(isolate);
+
+  if (args.Length() != 0) {
+    TRI_V8_THROW_EXCEPTION_USAGE("queue()");
+  }
+
+  TRI_vocbase_t* vocbase = GetContextVocBase(isolate);
+
+  if (vocbase == nullptr) {
+    TRI_V8_THROW_EXCEPTION(TRI_ERROR_ARANGO_DATABASE_NOT_FOUND);
+  }
+
+  auto scheduler = static_cast<MaintenanceScheduler*>(vocbase->_server->_maintenanceScheduler);
+
+  if (scheduler == nullptr) {
+    TRI_V8_THROW_EXCEPTION(TRI_ERROR_NOT_IMPLEMENTED);
+  }
+
+  std::vector<MaintenanceScheduler::Job> queued;
+  std::vector<MaintenanceScheduler::Job> running;
+  scheduler->jobs(queued, running);
+
+  v8::Handle<v8::Object> result = v8::Object::New(isolate);
+  result->Set(TRI_V8_ASCII_STRING("workers"),     v8::Number::New(isolate, (double) scheduler->numWorkers()));
+  result->Set(TRI_V8_ASCII_STRING("ioBudget"),    v8::Number::New(isolate, (double) scheduler->ioBudget()));
+  result->Set(TRI_V8_ASCII_STRING("ioAvailable"), v8::Number::New(isolate, scheduler->ioAvailable()));
+  result->Set(TRI_V8_ASCII_STRING("backoff"),     v8::Number::New(isolate, scheduler->backoff()));
+  result->Set(TRI_V8_ASCII_STRING("ioRate"),      v8::Number::New(isolate, scheduler->ioRate()));
+
+  v8::Handle<v8::Array> queuedList = v8::Array::New(isolate, static_cast<int>(queued.size()));
+  uint32_t i = 0;
+
+  for (auto const& job : queued) {
+    queuedList->Set(i++, MaintenanceJobToV8(isolate, job));
+  }
+
+  result->Set(TRI_V8_ASCII_STRING("queued"), queuedList);
+
+  v8::Handle<v8::Array> runningList = v8::Array::New(isolate, static_cast<int>(running.size()));
+  i = 0;
+
+  for (auto const& job : running) {
+    runningList->Set(i++, MaintenanceJobToV8(isolate, job));
+  }
+
+  result->Set(TRI_V8_ASCII_STRING("running"), runningList);
+
+  TRI_V8_RETURN(result);
+  TRI_V8_TRY_CATCH_END
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief retrieves or changes the configuration of the maintenance scheduler
+/// @startDocuBlock maintenanceProperties
+/// `internal.maintenance.properties(properties)`
+///
+/// Retrieves the configuration of the cleanup and compaction scheduler. If
+/// *properties* are given, the configuration is changed first. The following
+/// attributes are supported:
+/// - *ioBudget*: the compaction I/O budget (in bytes per second). A value of
+///   *0* means unlimited. Each compaction is charged against the budget after
+///   it has finished, and further compactions are delayed until the budget
+///   was refilled.
+///
+/// The changed configuration is not persisted. After a restart, the value of
+/// the startup option is used again.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+static void JS_PropertiesMaintenance (const v8::FunctionCallbackInfo<v8::Value>& args) {
+  TRI_V8_TRY_CATCH_BEGIN(isolate);
+  v8::HandleScope scope(isolate);
+
+  if (args.Length() > 1 || (args.Length() == 1 && ! args[0]->IsObject())) {
+    TRI_V8_THROW_EXCEPTION_USAGE("properties(<object>)");
+  }
+
+  TRI_vocbase_t* vocbase = GetContextVocBase(isolate);
+
+  if (vocbase == nullptr) {
+    TRI_V8_THROW_EXCEPTION(TRI_ERROR_ARANGO_DATABASE_NOT_FOUND);
+  }
+
+  auto scheduler = static_cast<MaintenanceScheduler*>(vocbase->_server->_maintenanceScheduler);
+
+  if (scheduler == nullptr) {
+    TRI_V8_THROW_EXCEPTION(TRI_ERROR_NOT_IMPLEMENTED);
+  }
+
+  if (args.Length() == 1) {
+    // set the properties
+    v8::Handle<v8::Object> object = v8::Handle<v8::Object>::Cast(args[0]);
+
+    if (object->Has(TRI_V8_ASCII_STRING("ioBudget"))) {
+      uint64_t value = TRI_ObjectToUInt64(object->Get(TRI_V8_ASCII_STRING("ioBudget")), true);
+      scheduler->ioBudget(value);
+    }
+  }
+
+  v8::Handle<v8::Object> result = v8::Object::New(isolate);
+  result->Set(TRI_V8_ASCII_STRING("ioBudget"), v8::Number::New(isolate, (double) scheduler->ioBudget()));
+
+  TRI_V8_RETURN(result);
+  TRI_V8_TRY_CATCH_END
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief flushes the currently open WAL logfile
 /// @startDocuBlock walFlush
@@ -3726,6 +3869,8 @@ void TRI_InitV8VocBridge (v8::Isolate* isolate,
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("TRANSACTION"), JS_Transaction, true);
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("WAL_FLUSH"), JS_FlushWal, true);
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("WAL_PROPERTIES"), JS_PropertiesWal, true);
+  TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("MAINTENANCE_QUEUE"), JS_QueueMaintenance, true);
+  TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("MAINTENANCE_PROPERTIES"), JS_PropertiesMaintenance, true);
   
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("ENABLE_NATIVE_BACKTRACES"), JS_EnableNativeBacktraces, true);
 
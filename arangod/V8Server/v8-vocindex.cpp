@@ -1623,6 +1623,10 @@ static void CreateVocBase (const v8::FunctionCallbackInfo<v8::Value>& args,
       parameters._doCompact = true;
     }
 
+    if (p->Has(TRI_V8_ASCII_STRING("compressDatafiles"))) {
+      parameters._compressDatafiles = TRI_ObjectToBoolean(p->Get(TRI_V8_ASCII_STRING("compressDatafiles")));
+    }
+
     TRI_GET_GLOBAL_STRING(IsSystemKey);
     if (p->Has(IsSystemKey)) {
       parameters._isSystem = TRI_ObjectToBoolean(p->Get(IsSystemKey));
@@ -1659,6 +1663,29 @@ static void CreateVocBase (const v8::FunctionCallbackInfo<v8::Value>& args,
         TRI_V8_THROW_EXCEPTION_PARAMETER("indexBuckets must be a two-power between 1 and 1024");
       }
     }
+
+    if (p->Has(TRI_V8_ASCII_STRING("compactionDeadSizeThreshold"))) {
+      parameters._compactionDeadSizeThreshold = TRI_ObjectToUInt64(p->Get(TRI_V8_ASCII_STRING("compactionDeadSizeThreshold")), true);
+    }
+
+    if (p->Has(TRI_V8_ASCII_STRING("compactionDeadSizeShare"))) {
+      parameters._compactionDeadSizeShare = TRI_ObjectToDouble(p->Get(TRI_V8_ASCII_STRING("compactionDeadSizeShare")));
+
+      if (parameters._compactionDeadSizeShare < 0.0 ||
+          parameters._compactionDeadSizeShare > 1.0) {
+        TRI_FreeCollectionInfoOptions(&parameters);
+        TRI_V8_THROW_EXCEPTION_PARAMETER("compactionDeadSizeShare must be between 0 and 1");
+      }
+    }
+
+    if (p->Has(TRI_V8_ASCII_STRING("compactionMaxFileSize"))) {
+      parameters._compactionMaxFileSize = TRI_ObjectToUInt64(p->Get(TRI_V8_ASCII_STRING("compactionMaxFileSize")), true);
+
+      if (parameters._compactionMaxFileSize < TRI_JOURNAL_MINIMAL_SIZE) {
+        TRI_FreeCollectionInfoOptions(&parameters);
+        TRI_V8_THROW_EXCEPTION_PARAMETER("<properties>.compactionMaxFileSize too small");
+      }
+    }
   }
   else {
     TRI_InitCollectionInfo(vocbase, &parameters, name.c_str(), collectionType, effectiveSize, nullptr);
@@ -390,6 +390,33 @@ bool Ditches::contains (Ditch::DitchType type) {
   return false;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of ditches with callbacks that the cleanup
+/// will execute
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t Ditches::numCallbacks () {
+  MUTEX_LOCKER(_lock);
+
+  uint64_t count = 0;
+  auto const* ptr = _begin;
+
+  while (ptr != nullptr) {
+    auto const type = ptr->type();
+
+    if (type == Ditch::TRI_DITCH_DATAFILE_DROP ||
+        type == Ditch::TRI_DITCH_DATAFILE_RENAME ||
+        type == Ditch::TRI_DITCH_COLLECTION_UNLOAD ||
+        type == Ditch::TRI_DITCH_COLLECTION_DROP) {
+      ++count;
+    }
+
+    ptr = ptr->_next;
+  }
+
+  return count;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief removes and frees a ditch
 ////////////////////////////////////////////////////////////////////////////////
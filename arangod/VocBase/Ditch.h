@@ -487,6 +487,13 @@ namespace triagens {
 
         bool contains (Ditch::DitchType);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of ditches with callbacks that the cleanup
+/// will execute
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t numCallbacks ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief unlinks and frees a ditch
 ////////////////////////////////////////////////////////////////////////////////
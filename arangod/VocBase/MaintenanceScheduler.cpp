@@ -0,0 +1,846 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief server-wide scheduler for cleanup and compaction of databases
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2015 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014-2015, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MaintenanceScheduler.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/logging.h"
+#include "Basics/Thread.h"
+#include "Statistics/statistics.h"
+#include "VocBase/cleanup.h"
+#include "VocBase/compactor.h"
+#include "VocBase/vocbase.h"
+#include "Wal/LogfileManager.h"
+
+using namespace triagens::arango;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private constants
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief interval for planning jobs (in s)
+////////////////////////////////////////////////////////////////////////////////
+
+static double const PLAN_INTERVAL = 1.0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cleanup interval per database (in s)
+////////////////////////////////////////////////////////////////////////////////
+
+static double const CLEANUP_INTERVAL = 1.0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compaction interval per database (in s)
+////////////////////////////////////////////////////////////////////////////////
+
+static double const COMPACTOR_INTERVAL = 1.0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief base priority of cleanup jobs
+///
+/// compaction jobs have a priority between 0 and 1, so cleanup jobs are
+/// always preferred. cleanup jobs free resources and make the results of
+/// compactions visible
+////////////////////////////////////////////////////////////////////////////////
+
+static double const CLEANUP_PRIORITY = 1.0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait time when there are jobs that cannot be started yet (in us)
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t const WAIT_INTERVAL = 100 * 1000;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lowest backoff factor
+////////////////////////////////////////////////////////////////////////////////
+
+static double const BACKOFF_MIN = 1.0 / 64.0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief additive increase of the backoff factor per planning interval
+////////////////////////////////////////////////////////////////////////////////
+
+static double const BACKOFF_INCREASE = 0.125;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief I/O rate used for backing off when there is no I/O budget (in B/s)
+////////////////////////////////////////////////////////////////////////////////
+
+static double const BACKOFF_RATE = 64.0 * 1024.0 * 1024.0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief request latency, relative to the baseline, that counts as pressure
+////////////////////////////////////////////////////////////////////////////////
+
+static double const LATENCY_FACTOR = 2.0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief request latency that never counts as pressure (in s)
+////////////////////////////////////////////////////////////////////////////////
+
+static double const LATENCY_MIN = 0.01;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief weight of a new sample in the latency baseline
+////////////////////////////////////////////////////////////////////////////////
+
+static double const LATENCY_WEIGHT = 0.05;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief minimum number of requests per interval to judge the latency
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t const LATENCY_MIN_REQUESTS = 10;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of collectable logfiles that counts as WAL collector backlog
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const WAL_BACKLOG_THRESHOLD = 2;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                           class MaintenanceThread
+// -----------------------------------------------------------------------------
+
+namespace triagens {
+  namespace arango {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief planner or worker thread of the scheduler
+////////////////////////////////////////////////////////////////////////////////
+
+    class MaintenanceThread : public triagens::basics::Thread {
+
+      public:
+
+        MaintenanceThread (MaintenanceThread const&) = delete;
+        MaintenanceThread& operator= (MaintenanceThread const&) = delete;
+
+        MaintenanceThread (MaintenanceScheduler* scheduler,
+                           bool isPlanner)
+          : Thread(isPlanner ? "MaintenancePlanner" : "MaintenanceWorker"),
+            _scheduler(scheduler),
+            _isPlanner(isPlanner) {
+        }
+
+        ~MaintenanceThread () {
+        }
+
+      protected:
+
+        void run () override {
+          if (_isPlanner) {
+            while (! _scheduler->_stopping) {
+              _scheduler->plan();
+
+              CONDITION_LOCKER(guard, _scheduler->_condition);
+
+              if (! _scheduler->_stopping) {
+                guard.wait(static_cast<uint64_t>(PLAN_INTERVAL * 1000.0 * 1000.0));
+              }
+            }
+          }
+          else {
+            MaintenanceScheduler::Job job;
+
+            while (_scheduler->dequeue(job)) {
+              _scheduler->execute(job);
+            }
+          }
+        }
+
+      private:
+
+        MaintenanceScheduler* _scheduler;
+
+        bool const _isPlanner;
+    };
+
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        class MaintenanceScheduler
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the scheduler and start its threads
+////////////////////////////////////////////////////////////////////////////////
+
+MaintenanceScheduler::MaintenanceScheduler (size_t numWorkers,
+                                            uint64_t ioBudget,
+                                            double datafileColdTime)
+  : _condition(),
+    _databases(),
+    _queue(),
+    _running(),
+    _threads(),
+    _numWorkers(numWorkers > 0 ? numWorkers : 1),
+    _ioBudget(ioBudget),
+    _datafileColdTime(datafileColdTime > 0.0 ? datafileColdTime : 0.0),
+    _ioAvailable(static_cast<double>(ioBudget)),
+    _ioRefilled(TRI_microtime()),
+    _backoff(1.0),
+    _lastRequestCount(0),
+    _lastRequestTotal(0.0),
+    _baselineLatency(0.0),
+    _sequence(0),
+    _stopping(false) {
+
+  _threads.reserve(_numWorkers + 1);
+
+  for (size_t i = 0; i < _numWorkers + 1; ++i) {
+    // the first thread is the planner
+    auto thread = new MaintenanceThread(this, i == 0);
+
+    try {
+      _threads.emplace_back(thread);
+    }
+    catch (...) {
+      delete thread;
+      throw;
+    }
+
+    thread->start();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stop the threads and destroy the scheduler
+////////////////////////////////////////////////////////////////////////////////
+
+MaintenanceScheduler::~MaintenanceScheduler () {
+  _stopping = true;
+
+  {
+    CONDITION_LOCKER(guard, _condition);
+    guard.broadcast();
+  }
+
+  for (auto it : _threads) {
+    it->join();
+    delete it;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register a database for cleanup
+////////////////////////////////////////////////////////////////////////////////
+
+void MaintenanceScheduler::registerDatabase (TRI_vocbase_t* vocbase) {
+  double const now = TRI_microtime();
+
+  CONDITION_LOCKER(guard, _condition);
+
+  Database database;
+  database.compaction      = false;
+  database.cleanupQueued   = false;
+  database.cleanupSignaled = false;
+  database.removing        = false;
+  database.users           = 0;
+  database.iterations      = 0;
+  database.nextCleanup     = now + CLEANUP_INTERVAL;
+  database.nextCompaction  = now + COMPACTOR_INTERVAL;
+
+  _databases.emplace(vocbase, database);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief unregister a database
+////////////////////////////////////////////////////////////////////////////////
+
+bool MaintenanceScheduler::unregisterDatabase (TRI_vocbase_t* vocbase) {
+  CONDITION_LOCKER(guard, _condition);
+
+  auto it = _databases.find(vocbase);
+
+  if (it == _databases.end() || (*it).second.removing) {
+    return false;
+  }
+
+  // no new jobs will be queued for the database from now on
+  (*it).second.removing = true;
+
+  _queue.erase(std::remove_if(_queue.begin(), _queue.end(), [&vocbase] (Job const& job) {
+    return job.vocbase == vocbase;
+  }), _queue.end());
+
+  waitUnused(vocbase, false);
+
+  _databases.erase(vocbase);
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief turn on compaction for a registered database
+////////////////////////////////////////////////////////////////////////////////
+
+void MaintenanceScheduler::startCompaction (TRI_vocbase_t* vocbase) {
+  CONDITION_LOCKER(guard, _condition);
+
+  auto it = _databases.find(vocbase);
+
+  if (it != _databases.end()) {
+    (*it).second.compaction = true;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief turn off compaction for a registered database
+////////////////////////////////////////////////////////////////////////////////
+
+void MaintenanceScheduler::stopCompaction (TRI_vocbase_t* vocbase) {
+  CONDITION_LOCKER(guard, _condition);
+
+  auto it = _databases.find(vocbase);
+
+  if (it == _databases.end()) {
+    return;
+  }
+
+  (*it).second.compaction = false;
+
+  _queue.erase(std::remove_if(_queue.begin(), _queue.end(), [&vocbase] (Job const& job) {
+    return (job.vocbase == vocbase && job.type == JOB_COMPACTION);
+  }), _queue.end());
+
+  (*it).second.compactions.clear();
+
+  waitUnused(vocbase, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief request a cleanup of a database as soon as possible
+////////////////////////////////////////////////////////////////////////////////
+
+void MaintenanceScheduler::signalCleanup (TRI_vocbase_t* vocbase) {
+  CONDITION_LOCKER(guard, _condition);
+
+  auto it = _databases.find(vocbase);
+
+  if (it != _databases.end()) {
+    (*it).second.cleanupSignaled = true;
+    guard.broadcast();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the queued and the running jobs
+////////////////////////////////////////////////////////////////////////////////
+
+void MaintenanceScheduler::jobs (std::vector<Job>& queued,
+                                 std::vector<Job>& running) {
+  CONDITION_LOCKER(guard, _condition);
+
+  queued = _queue;
+  running = _running;
+
+  // highest priority first
+  std::sort(queued.begin(), queued.end(), [] (Job const& lhs, Job const& rhs) {
+    if (lhs.priority != rhs.priority) {
+      return lhs.priority > rhs.priority;
+    }
+    return lhs.sequence < rhs.sequence;
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the currently available compaction I/O budget (bytes)
+////////////////////////////////////////////////////////////////////////////////
+
+double MaintenanceScheduler::ioAvailable () {
+  CONDITION_LOCKER(guard, _condition);
+
+  refill(TRI_microtime());
+
+  return _ioAvailable;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the effective compaction I/O rate (bytes per second)
+////////////////////////////////////////////////////////////////////////////////
+
+double MaintenanceScheduler::ioRate () {
+  CONDITION_LOCKER(guard, _condition);
+
+  return rate();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the current backoff factor, between 0 and 1
+////////////////////////////////////////////////////////////////////////////////
+
+double MaintenanceScheduler::backoff () {
+  CONDITION_LOCKER(guard, _condition);
+
+  return _backoff;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the compaction I/O budget (bytes per second)
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t MaintenanceScheduler::ioBudget () {
+  CONDITION_LOCKER(guard, _condition);
+
+  return _ioBudget;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief change the compaction I/O budget (bytes per second)
+////////////////////////////////////////////////////////////////////////////////
+
+void MaintenanceScheduler::ioBudget (uint64_t value) {
+  CONDITION_LOCKER(guard, _condition);
+
+  // account for the time passed at the old rate first
+  refill(TRI_microtime());
+  _ioBudget = value;
+
+  guard.broadcast();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief queue the jobs that are due
+///
+/// the priorities are calculated without holding the scheduler's lock. the
+/// databases are marked as used in the meantime, so they cannot go away
+////////////////////////////////////////////////////////////////////////////////
+
+void MaintenanceScheduler::plan () {
+  adapt();
+
+  double const now = TRI_microtime();
+
+  std::vector<TRI_vocbase_t*> cleanups;
+  std::vector<TRI_vocbase_t*> compactions;
+
+  {
+    CONDITION_LOCKER(guard, _condition);
+
+    for (auto& it : _databases) {
+      Database& database = it.second;
+
+      if (database.removing) {
+        continue;
+      }
+
+      if (! database.cleanupQueued &&
+          (database.cleanupSignaled || database.nextCleanup <= now)) {
+        database.cleanupQueued   = true;
+        database.cleanupSignaled = false;
+        database.nextCleanup     = now + CLEANUP_INTERVAL;
+        ++database.users;
+
+        cleanups.emplace_back(it.first);
+      }
+
+      if (database.compaction && database.nextCompaction <= now) {
+        database.nextCompaction  = now + COMPACTOR_INTERVAL;
+        ++database.users;
+
+        compactions.emplace_back(it.first);
+      }
+    }
+  }
+
+  if (cleanups.empty() && compactions.empty()) {
+    return;
+  }
+
+  // databases with more pending ditches are cleaned up first
+  std::vector<double> cleanupPriorities;
+  cleanupPriorities.reserve(cleanups.size());
+
+  for (auto& vocbase : cleanups) {
+    cleanupPriorities.emplace_back(CLEANUP_PRIORITY + static_cast<double>(TRI_PendingCleanupVocBase(vocbase)));
+  }
+
+  // collections with a higher share of dead data are compacted first
+  std::vector<std::tuple<TRI_vocbase_t*, TRI_voc_cid_t, double>> candidates;
+
+  for (auto& vocbase : compactions) {
+    TRI_vector_pointer_t collections;
+    TRI_InitVectorPointer(&collections, TRI_UNKNOWN_MEM_ZONE);
+
+    TRI_READ_LOCK_COLLECTIONS_VOCBASE(vocbase);
+    TRI_CopyDataVectorPointer(&collections, &vocbase->_collections);
+    TRI_READ_UNLOCK_COLLECTIONS_VOCBASE(vocbase);
+
+    for (size_t i = 0;  i < collections._length;  ++i) {
+      TRI_vocbase_col_t* collection = static_cast<TRI_vocbase_col_t*>(collections._buffer[i]);
+      double share = TRI_DeadShareCompactorVocBase(collection, now);
+
+      if (share >= 0.0) {
+        candidates.emplace_back(vocbase, collection->_cid, share);
+      }
+    }
+
+    TRI_DestroyVectorPointer(&collections);
+  }
+
+  CONDITION_LOCKER(guard, _condition);
+
+  for (size_t i = 0; i < cleanups.size(); ++i) {
+    Database& database = _databases[cleanups[i]];
+    --database.users;
+
+    if (database.removing) {
+      database.cleanupQueued = false;
+    }
+    else {
+      enqueue(JOB_CLEANUP, cleanups[i], 0, cleanupPriorities[i]);
+    }
+  }
+
+  for (auto& it : candidates) {
+    Database& database = _databases[std::get<0>(it)];
+
+    if (! database.removing &&
+        database.compaction &&
+        database.compactions.emplace(std::get<1>(it)).second) {
+      enqueue(JOB_COMPACTION, std::get<0>(it), std::get<1>(it), std::get<2>(it));
+    }
+  }
+
+  for (auto& vocbase : compactions) {
+    --_databases[vocbase].users;
+  }
+
+  guard.broadcast();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief adjust the backoff factor to the current load of the server
+///
+/// the factor is halved while the WAL collector lags behind or the average
+/// request time of the last interval is well above its long-term baseline,
+/// and raised additively otherwise
+////////////////////////////////////////////////////////////////////////////////
+
+void MaintenanceScheduler::adapt () {
+  bool pressure = false;
+
+  auto logfileManager = triagens::wal::LogfileManager::instance();
+
+  if (logfileManager != nullptr &&
+      (logfileManager->isThrottled() ||
+       logfileManager->numCollectableLogfiles() > WAL_BACKLOG_THRESHOLD)) {
+    pressure = true;
+  }
+
+#if TRI_ENABLE_FIGURES
+  if (TRI_TotalTimeDistributionStatistics != nullptr) {
+    triagens::basics::StatisticsDistribution totalTime;
+    triagens::basics::StatisticsDistribution requestTime;
+    triagens::basics::StatisticsDistribution queueTime;
+    triagens::basics::StatisticsDistribution ioTime;
+    triagens::basics::StatisticsDistribution bytesSent;
+    triagens::basics::StatisticsDistribution bytesReceived;
+
+    TRI_FillRequestStatistics(totalTime, requestTime, queueTime, ioTime, bytesSent, bytesReceived);
+
+    if (totalTime._count >= _lastRequestCount + LATENCY_MIN_REQUESTS) {
+      double const latency = (totalTime._total - _lastRequestTotal) / static_cast<double>(totalTime._count - _lastRequestCount);
+
+      if (latency > LATENCY_MIN &&
+          _baselineLatency > 0.0 &&
+          latency > _baselineLatency * LATENCY_FACTOR) {
+        pressure = true;
+      }
+      else if (_baselineLatency > 0.0) {
+        _baselineLatency += (latency - _baselineLatency) * LATENCY_WEIGHT;
+      }
+      else {
+        _baselineLatency = latency;
+      }
+
+      _lastRequestCount = totalTime._count;
+      _lastRequestTotal = totalTime._total;
+    }
+    else if (totalTime._count < _lastRequestCount) {
+      _lastRequestCount = totalTime._count;
+      _lastRequestTotal = totalTime._total;
+    }
+  }
+#endif
+
+  CONDITION_LOCKER(guard, _condition);
+
+  if (pressure) {
+    _backoff = (std::max)(_backoff / 2.0, BACKOFF_MIN);
+  }
+  else {
+    _backoff = (std::min)(_backoff + BACKOFF_INCREASE, 1.0);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the effective I/O rate. the condition lock must be held
+///
+/// without an I/O budget, compaction is only throttled while backing off
+////////////////////////////////////////////////////////////////////////////////
+
+double MaintenanceScheduler::rate () const {
+  if (_ioBudget > 0) {
+    return static_cast<double>(_ioBudget) * _backoff;
+  }
+
+  if (_backoff < 1.0) {
+    return BACKOFF_RATE * _backoff;
+  }
+
+  return 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pick the next job to run. returns false when shutting down
+///
+/// the job with the highest priority is picked, unless there is already a job
+/// running for its database, or it is a compaction job and the I/O budget is
+/// used up
+////////////////////////////////////////////////////////////////////////////////
+
+bool MaintenanceScheduler::dequeue (Job& job) {
+  CONDITION_LOCKER(guard, _condition);
+
+  while (! _stopping) {
+    refill(TRI_microtime());
+
+    size_t const n = _queue.size();
+    size_t best = n;
+
+    for (size_t i = 0; i < n; ++i) {
+      Job const& candidate = _queue[i];
+
+      if (candidate.type == JOB_COMPACTION &&
+          rate() > 0.0 &&
+          _ioAvailable <= 0.0) {
+        continue;
+      }
+
+      if (best < n &&
+          (candidate.priority < _queue[best].priority ||
+           (candidate.priority == _queue[best].priority && candidate.sequence > _queue[best].sequence))) {
+        continue;
+      }
+
+      bool busy = false;
+
+      for (auto const& running : _running) {
+        if (running.vocbase == candidate.vocbase) {
+          busy = true;
+          break;
+        }
+      }
+
+      if (! busy) {
+        best = i;
+      }
+    }
+
+    if (best < n) {
+      job = _queue[best];
+      _queue.erase(_queue.begin() + best);
+      _running.emplace_back(job);
+      ++_databases[job.vocbase].users;
+
+      return true;
+    }
+
+    guard.wait(n == 0 ? static_cast<uint64_t>(PLAN_INTERVAL * 1000.0 * 1000.0) : WAIT_INTERVAL);
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute a job
+////////////////////////////////////////////////////////////////////////////////
+
+void MaintenanceScheduler::execute (Job const& job) {
+  uint64_t bytesCompacted = 0;
+  bool worked = false;
+
+  try {
+    if (job.type == JOB_CLEANUP) {
+      uint64_t iterations;
+
+      {
+        CONDITION_LOCKER(guard, _condition);
+        iterations = ++_databases[job.vocbase].iterations;
+      }
+
+      TRI_CleanupVocBase(job.vocbase, iterations, false);
+    }
+    else {
+      TRI_vocbase_col_t* collection = TRI_LookupCollectionByIdVocBase(job.vocbase, job.cid);
+
+      if (collection != nullptr) {
+        worked = TRI_CompactCollectionCompactorVocBase(job.vocbase, collection, &bytesCompacted);
+      }
+    }
+  }
+  catch (...) {
+    LOG_WARNING("caught exception during maintenance of database '%s'", job.vocbase->_name);
+  }
+
+  CONDITION_LOCKER(guard, _condition);
+
+  for (auto it = _running.begin(); it != _running.end(); ++it) {
+    if ((*it).sequence == job.sequence) {
+      _running.erase(it);
+      break;
+    }
+  }
+
+  Database& database = _databases[job.vocbase];
+  --database.users;
+
+  if (job.type == JOB_CLEANUP) {
+    database.cleanupQueued = false;
+  }
+  else {
+    database.compactions.erase(job.cid);
+
+    // the compaction is charged only after it released all collection locks.
+    // running out of budget delays the next compaction, but never blocks
+    // foreground operations waiting for the collection
+    if (rate() > 0.0) {
+      refill(TRI_microtime());
+      _ioAvailable -= static_cast<double>(bytesCompacted);
+    }
+
+    if (worked) {
+      // make the results visible soon, and check if there is more to compact
+      database.cleanupSignaled = true;
+      database.nextCompaction  = 0.0;
+    }
+  }
+
+  guard.broadcast();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add a job to the queue. the condition lock must be held
+////////////////////////////////////////////////////////////////////////////////
+
+void MaintenanceScheduler::enqueue (JobType type,
+                                    TRI_vocbase_t* vocbase,
+                                    TRI_voc_cid_t cid,
+                                    double priority) {
+  Job job;
+  job.type     = type;
+  job.vocbase  = vocbase;
+  job.cid      = cid;
+  job.priority = priority;
+  job.sequence = ++_sequence;
+
+  _queue.emplace_back(job);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief refill the I/O budget. the condition lock must be held
+///
+/// the budget works like a token bucket that holds at most one second worth
+/// of I/O at the effective rate. a compaction may use more than what is
+/// available, in which case no further compactions are started until the
+/// budget was refilled
+////////////////////////////////////////////////////////////////////////////////
+
+void MaintenanceScheduler::refill (double now) {
+  double const budget = rate();
+
+  if (budget <= 0.0) {
+    _ioAvailable = 0.0;
+    _ioRefilled = now;
+    return;
+  }
+
+  _ioAvailable += (now - _ioRefilled) * budget;
+
+  if (_ioAvailable > budget) {
+    _ioAvailable = budget;
+  }
+
+  _ioRefilled = now;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait until a database is not used anymore. the condition lock must
+/// be held
+///
+/// if compactionOnly is true, only waits for running compaction jobs
+////////////////////////////////////////////////////////////////////////////////
+
+void MaintenanceScheduler::waitUnused (TRI_vocbase_t* vocbase,
+                                       bool compactionOnly) {
+  while (true) {
+    bool used = false;
+
+    if (compactionOnly) {
+      for (auto const& running : _running) {
+        if (running.vocbase == vocbase && running.type == JOB_COMPACTION) {
+          used = true;
+          break;
+        }
+      }
+    }
+    else {
+      used = (_databases[vocbase].users > 0);
+    }
+
+    if (! used) {
+      return;
+    }
+
+    _condition.wait(WAIT_INTERVAL);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
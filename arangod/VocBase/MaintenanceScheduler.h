@@ -0,0 +1,421 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief server-wide scheduler for cleanup and compaction of databases
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2015 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014-2015, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_VOC_BASE_MAINTENANCE_SCHEDULER_H
+#define ARANGODB_VOC_BASE_MAINTENANCE_SCHEDULER_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
+#include "VocBase/voc-types.h"
+
+struct TRI_vocbase_s;
+
+namespace triagens {
+  namespace arango {
+
+    class MaintenanceThread;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        class MaintenanceScheduler
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief server-wide scheduler for cleanup and compaction
+///
+/// Instead of running a cleanup and a compactor thread per database, the
+/// scheduler uses one planner thread and a bounded pool of workers for all
+/// databases. The planner periodically queues a cleanup job per database and
+/// a compaction job per collection that has something to compact. Cleanup
+/// jobs are prioritized by the number of pending ditches, compaction jobs by
+/// the share of dead bytes in the collection. Workers run at most one job per
+/// database at a time, and compaction jobs are only started while the
+/// server-wide compaction I/O budget is not used up.
+///
+/// Each compaction is charged to the same budget once it has finished and
+/// released the collection locks, so a used-up budget delays the next
+/// compaction but never blocks foreground operations. The planner lowers the
+/// effective rate when foreground requests get slower or the WAL collector
+/// falls behind, raising it again step by step once the pressure is gone.
+////////////////////////////////////////////////////////////////////////////////
+
+    class MaintenanceScheduler {
+
+      friend class MaintenanceThread;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                      public types
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief job types
+////////////////////////////////////////////////////////////////////////////////
+
+        enum JobType {
+          JOB_CLEANUP,
+          JOB_COMPACTION
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a queued or running job
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Job {
+          JobType                type;
+          struct TRI_vocbase_s*  vocbase;
+          TRI_voc_cid_t          cid;
+          double                 priority;
+          uint64_t               sequence;
+        };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     private types
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maintenance state of a database
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Database {
+          bool                   compaction;
+          bool                   cleanupQueued;
+          bool                   cleanupSignaled;
+          bool                   removing;
+          uint64_t               users;
+          uint64_t               iterations;
+          double                 nextCleanup;
+          double                 nextCompaction;
+          std::unordered_set<TRI_voc_cid_t> compactions;
+        };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        MaintenanceScheduler (MaintenanceScheduler const&) = delete;
+        MaintenanceScheduler& operator= (MaintenanceScheduler const&) = delete;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the scheduler and start its threads
+///
+/// the I/O budget is the number of datafile bytes that may be compacted per
+/// second, server-wide. a value of 0 means unlimited. datafiles that were not
+/// read for the cold time (in seconds) are dropped from memory by the
+/// cleanup. a value of 0 turns this off
+////////////////////////////////////////////////////////////////////////////////
+
+        MaintenanceScheduler (size_t,
+                              uint64_t,
+                              double);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stop the threads and destroy the scheduler
+////////////////////////////////////////////////////////////////////////////////
+
+        ~MaintenanceScheduler ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register a database for cleanup
+////////////////////////////////////////////////////////////////////////////////
+
+        void registerDatabase (struct TRI_vocbase_s*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief unregister a database
+///
+/// removes all queued jobs of the database and waits until no job for it is
+/// running anymore. returns false if the database was not registered
+////////////////////////////////////////////////////////////////////////////////
+
+        bool unregisterDatabase (struct TRI_vocbase_s*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief turn on compaction for a registered database
+////////////////////////////////////////////////////////////////////////////////
+
+        void startCompaction (struct TRI_vocbase_s*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief turn off compaction for a registered database
+///
+/// removes the queued compaction jobs of the database and waits until no
+/// compaction job for it is running anymore
+////////////////////////////////////////////////////////////////////////////////
+
+        void stopCompaction (struct TRI_vocbase_s*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief request a cleanup of a database as soon as possible
+////////////////////////////////////////////////////////////////////////////////
+
+        void signalCleanup (struct TRI_vocbase_s*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the queued and the running jobs
+////////////////////////////////////////////////////////////////////////////////
+
+        void jobs (std::vector<Job>&,
+                   std::vector<Job>&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of worker threads
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t numWorkers () const {
+          return _numWorkers;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the compaction I/O budget (bytes per second)
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t ioBudget ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief change the compaction I/O budget (bytes per second), 0 means
+/// unlimited
+////////////////////////////////////////////////////////////////////////////////
+
+        void ioBudget (uint64_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the time after which unused datafiles are dropped from
+/// memory (in seconds), 0 means never
+////////////////////////////////////////////////////////////////////////////////
+
+        double datafileColdTime () const {
+          return _datafileColdTime;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the currently available compaction I/O budget (bytes)
+////////////////////////////////////////////////////////////////////////////////
+
+        double ioAvailable ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the effective compaction I/O rate (bytes per second)
+///
+/// this is the I/O budget scaled by the current backoff. a value of 0 means
+/// unlimited
+////////////////////////////////////////////////////////////////////////////////
+
+        double ioRate ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the current backoff factor, between 0 and 1
+////////////////////////////////////////////////////////////////////////////////
+
+        double backoff ();
+
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief queue the jobs that are due
+////////////////////////////////////////////////////////////////////////////////
+
+        void plan ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief adjust the backoff factor to the current load of the server
+////////////////////////////////////////////////////////////////////////////////
+
+        void adapt ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the effective I/O rate. the condition lock must be held
+////////////////////////////////////////////////////////////////////////////////
+
+        double rate () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pick the next job to run. returns false when shutting down
+////////////////////////////////////////////////////////////////////////////////
+
+        bool dequeue (Job&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute a job
+////////////////////////////////////////////////////////////////////////////////
+
+        void execute (Job const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add a job to the queue. the condition lock must be held
+////////////////////////////////////////////////////////////////////////////////
+
+        void enqueue (JobType,
+                      struct TRI_vocbase_s*,
+                      TRI_voc_cid_t,
+                      double);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief refill the I/O budget. the condition lock must be held
+////////////////////////////////////////////////////////////////////////////////
+
+        void refill (double);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait until a database is not used anymore. the condition lock must
+/// be held
+////////////////////////////////////////////////////////////////////////////////
+
+        void waitUnused (struct TRI_vocbase_s*,
+                         bool);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief condition variable protecting all state below
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::ConditionVariable _condition;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief registered databases
+////////////////////////////////////////////////////////////////////////////////
+
+        std::unordered_map<struct TRI_vocbase_s*, Database> _databases;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief queued jobs
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Job> _queue;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief running jobs
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Job> _running;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief planner and worker threads
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<MaintenanceThread*> _threads;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of worker threads
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t const _numWorkers;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compaction I/O budget in bytes per second, 0 means unlimited
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t _ioBudget;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief time after which unused datafiles are dropped from memory
+////////////////////////////////////////////////////////////////////////////////
+
+        double const _datafileColdTime;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief currently available compaction I/O budget in bytes
+////////////////////////////////////////////////////////////////////////////////
+
+        double _ioAvailable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief time of the last refill of the I/O budget
+////////////////////////////////////////////////////////////////////////////////
+
+        double _ioRefilled;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief backoff factor applied to the I/O rate, between 0 and 1
+////////////////////////////////////////////////////////////////////////////////
+
+        double _backoff;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of requests seen at the last adaption
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t _lastRequestCount;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief total request time seen at the last adaption
+////////////////////////////////////////////////////////////////////////////////
+
+        double _lastRequestTotal;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief moving average of the request latency without pressure (in s)
+////////////////////////////////////////////////////////////////////////////////
+
+        double _baselineLatency;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sequence number for queued jobs
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t _sequence;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the scheduler is shutting down
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<bool> _stopping;
+    };
+
+  }
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
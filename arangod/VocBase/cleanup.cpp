@@ -35,18 +35,14 @@
 #include "VocBase/compactor.h"
 #include "VocBase/Ditch.h"
 #include "VocBase/document-collection.h"
+#include "VocBase/MaintenanceScheduler.h"
+#include "VocBase/server.h"
 #include "Wal/LogfileManager.h"
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private constants
 // -----------------------------------------------------------------------------
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief clean interval in microseconds
-////////////////////////////////////////////////////////////////////////////////
-
-static int const CLEANUP_INTERVAL = (1 * 1000 * 1000);
-
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief how many cleanup iterations until shadows are cleaned
 ////////////////////////////////////////////////////////////////////////////////
@@ -59,6 +55,12 @@ static int const CLEANUP_CURSOR_ITERATIONS = 3;
 
 static int const CLEANUP_INDEX_ITERATIONS = 5;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief how many cleanup iterations until the datafile residency is checked
+////////////////////////////////////////////////////////////////////////////////
+
+static int const CLEANUP_RESIDENCY_ITERATIONS = 10;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private functions
 // -----------------------------------------------------------------------------
@@ -209,106 +211,127 @@ static void CleanupCursors (TRI_vocbase_t* vocbase,
 // -----------------------------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief cleanup event loop
+/// @brief run one cleanup iteration for a database
 ////////////////////////////////////////////////////////////////////////////////
 
-void TRI_CleanupVocBase (void* data) {
-  uint64_t iterations = 0;
-
-  TRI_vocbase_t* const vocbase = static_cast<TRI_vocbase_t*>(data);
+void TRI_CleanupVocBase (TRI_vocbase_t* vocbase,
+                         uint64_t iterations,
+                         bool shutdown) {
   TRI_ASSERT(vocbase != nullptr);
-  TRI_ASSERT(vocbase->_state == 1);
-
-  TRI_vector_pointer_t collections;
-  TRI_InitVectorPointer(&collections, TRI_UNKNOWN_MEM_ZONE);
 
-  while (true) {
-    // keep initial _state value as vocbase->_state might change during cleanup loop
-    int state = vocbase->_state;
+  if (shutdown) {
+    // shadows must be cleaned before collections are handled
+    // otherwise the shadows might still hold barriers on collections
+    // and collections cannot be closed properly
+    CleanupCursors(vocbase, true);
+  }
 
-    ++iterations;
+  // check if we can get the compactor lock exclusively
+  if (TRI_CheckAndLockCompactorVocBase(vocbase)) {
+    TRI_vector_pointer_t collections;
+    TRI_InitVectorPointer(&collections, TRI_UNKNOWN_MEM_ZONE);
 
-    if (state == (sig_atomic_t) TRI_VOCBASE_STATE_SHUTDOWN_COMPACTOR ||
-        state == (sig_atomic_t) TRI_VOCBASE_STATE_SHUTDOWN_CLEANUP) {
-      // shadows must be cleaned before collections are handled
-      // otherwise the shadows might still hold barriers on collections
-      // and collections cannot be closed properly
-      CleanupCursors(vocbase, true);
-    }
+    // copy all collections
+    TRI_READ_LOCK_COLLECTIONS_VOCBASE(vocbase);
+    TRI_CopyDataVectorPointer(&collections, &vocbase->_collections);
+    TRI_READ_UNLOCK_COLLECTIONS_VOCBASE(vocbase);
 
-    // check if we can get the compactor lock exclusively
-    if (TRI_CheckAndLockCompactorVocBase(vocbase)) {
-      // copy all collections
-      TRI_READ_LOCK_COLLECTIONS_VOCBASE(vocbase);
-      TRI_CopyDataVectorPointer(&collections, &vocbase->_collections);
-      TRI_READ_UNLOCK_COLLECTIONS_VOCBASE(vocbase);
+    size_t const n = collections._length;
 
-      size_t const n = collections._length;
+    double coldTime = 0.0;
+    auto scheduler = static_cast<triagens::arango::MaintenanceScheduler*>(vocbase->_server->_maintenanceScheduler);
 
-      for (size_t i = 0;  i < n;  ++i) {
-        TRI_vocbase_col_t* collection = static_cast<TRI_vocbase_col_t*>(collections._buffer[i]);
+    if (scheduler != nullptr) {
+      coldTime = scheduler->datafileColdTime();
+    }
 
-        TRI_ASSERT(collection != nullptr);
+    for (size_t i = 0;  i < n;  ++i) {
+      TRI_vocbase_col_t* collection = static_cast<TRI_vocbase_col_t*>(collections._buffer[i]);
 
-        TRI_READ_LOCK_STATUS_VOCBASE_COL(collection);
+      TRI_ASSERT(collection != nullptr);
 
-        TRI_document_collection_t* document = collection->_collection;
+      TRI_READ_LOCK_STATUS_VOCBASE_COL(collection);
 
-        if (document == nullptr) {
-          // collection currently not loaded
-          TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
-          continue;
-        }
+      TRI_document_collection_t* document = collection->_collection;
 
+      if (document == nullptr) {
+        // collection currently not loaded
         TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
+        continue;
+      }
 
-        TRI_ASSERT(document != nullptr);
+      TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
 
-        // we're the only ones that can unload the collection, so using
-        // the collection pointer outside the lock is ok
+      TRI_ASSERT(document != nullptr);
 
-        // maybe cleanup indexes, unload the collection or some datafiles
-        // clean indexes?
-        if (iterations % (uint64_t) CLEANUP_INDEX_ITERATIONS == 0) {
-          document->cleanupIndexes(document);
-        }
+      // we're the only ones that can unload the collection, so using
+      // the collection pointer outside the lock is ok
+
+      // maybe cleanup indexes, unload the collection or some datafiles
+      // clean indexes?
+      if (iterations % (uint64_t) CLEANUP_INDEX_ITERATIONS == 0) {
+        document->cleanupIndexes(document);
+      }
 
-        CleanupDocumentCollection(collection, document);
+      // drop cold datafiles from memory?
+      if (! shutdown && iterations % (uint64_t) CLEANUP_RESIDENCY_ITERATIONS == 0) {
+        TRI_ManageResidencyDocumentCollection(document, coldTime);
       }
 
-      TRI_UnlockCompactorVocBase(vocbase);
+      CleanupDocumentCollection(collection, document);
     }
 
-    if (vocbase->_state >= 1) {
-      // server is still running, clean up unused cursors
-      if (iterations % CLEANUP_CURSOR_ITERATIONS == 0) {
-        CleanupCursors(vocbase, false);
-      
-        // clean up expired compactor locks
-        TRI_CleanupCompactorVocBase(vocbase);
-      }
+    TRI_UnlockCompactorVocBase(vocbase);
+    TRI_DestroyVectorPointer(&collections);
+  }
 
-      if (state == 1) {
-        TRI_LockCondition(&vocbase->_cleanupCondition);
-        TRI_TimedWaitCondition(&vocbase->_cleanupCondition, (uint64_t) CLEANUP_INTERVAL);
-        TRI_UnlockCondition(&vocbase->_cleanupCondition);
-      }
-      else if (state > 1) {
-        // prevent busy waiting
-        usleep(10000);
-      }
+  if (! shutdown && iterations % CLEANUP_CURSOR_ITERATIONS == 0) {
+    // clean up unused cursors
+    CleanupCursors(vocbase, false);
+
+    // clean up expired compactor locks
+    TRI_CleanupCompactorVocBase(vocbase);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of pending ditches with callbacks in a database
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t TRI_PendingCleanupVocBase (TRI_vocbase_t* vocbase) {
+  TRI_ASSERT(vocbase != nullptr);
+
+  uint64_t pending = 0;
+
+  TRI_vector_pointer_t collections;
+  TRI_InitVectorPointer(&collections, TRI_UNKNOWN_MEM_ZONE);
+
+  // copy all collections
+  TRI_READ_LOCK_COLLECTIONS_VOCBASE(vocbase);
+  TRI_CopyDataVectorPointer(&collections, &vocbase->_collections);
+  TRI_READ_UNLOCK_COLLECTIONS_VOCBASE(vocbase);
+
+  size_t const n = collections._length;
+
+  for (size_t i = 0;  i < n;  ++i) {
+    TRI_vocbase_col_t* collection = static_cast<TRI_vocbase_col_t*>(collections._buffer[i]);
+
+    if (! TRI_TRY_READ_LOCK_STATUS_VOCBASE_COL(collection)) {
+      continue;
     }
 
-    if (state == 3) {
-      // server shutdown
-      break;
+    TRI_document_collection_t* document = collection->_collection;
+
+    if (document != nullptr) {
+      pending += document->ditches()->numCallbacks();
     }
 
+    TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
   }
 
   TRI_DestroyVectorPointer(&collections);
 
-  LOG_TRACE("shutting down cleanup thread");
+  return pending;
 }
 
 // -----------------------------------------------------------------------------
@@ -49,10 +49,22 @@
 // -----------------------------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief cleanup event loop
+/// @brief run one cleanup iteration for a database
+///
+/// the iteration number determines whether indexes and cursors are cleaned
+/// up as well. during shutdown, all cursors are cleaned up before the
+/// collections are handled
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_CleanupVocBase (TRI_vocbase_t*,
+                         uint64_t,
+                         bool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of pending ditches with callbacks in a database
 ////////////////////////////////////////////////////////////////////////////////
 
-void TRI_CleanupVocBase (void*);
+uint64_t TRI_PendingCleanupVocBase (TRI_vocbase_t*);
 
 #endif
 
@@ -36,6 +36,7 @@
 #include "Basics/json.h"
 #include "Basics/JsonHelper.h"
 #include "Basics/logging.h"
+#include "Basics/memory-map.h"
 #include "Basics/tri-strings.h"
 #include "VocBase/document-collection.h"
 #include "VocBase/server.h"
@@ -736,7 +737,14 @@ static bool IterateDatafilesVector (const TRI_vector_pointer_t* const files,
               datafile->getName(datafile),
               (unsigned long long) datafile->_fid);
 
-    if (! TRI_IterateDatafile(datafile, iterator, data)) {
+    // the datafile is read front to back, so make the most of readahead
+    TRI_AdviseDatafile(datafile, TRI_MADVISE_SEQUENTIAL);
+
+    bool result = TRI_IterateDatafile(datafile, iterator, data);
+
+    TRI_AdviseDatafile(datafile, TRI_MADVISE_NORMAL);
+
+    if (! result) {
       return false;
     }
   }
@@ -840,6 +848,15 @@ static void FillParametersFromJson (TRI_col_info_t* parameters,
       else if (TRI_EqualString(key->_value._string.data, "indexBuckets")) {
         parameters->_indexBuckets = static_cast<uint32_t>(value->_value._number);
       }
+      else if (TRI_EqualString(key->_value._string.data, "compactionDeadSizeThreshold")) {
+        parameters->_compactionDeadSizeThreshold = static_cast<uint64_t>(value->_value._number);
+      }
+      else if (TRI_EqualString(key->_value._string.data, "compactionDeadSizeShare")) {
+        parameters->_compactionDeadSizeShare = value->_value._number;
+      }
+      else if (TRI_EqualString(key->_value._string.data, "compactionMaxFileSize")) {
+        parameters->_compactionMaxFileSize = static_cast<uint64_t>(value->_value._number);
+      }
     }
     else if (TRI_IsStringJson(value)) {
       if (TRI_EqualString(key->_value._string.data, "name")) {
@@ -861,6 +878,9 @@ static void FillParametersFromJson (TRI_col_info_t* parameters,
       else if (TRI_EqualString(key->_value._string.data, "doCompact")) {
         parameters->_doCompact = value->_value._boolean;
       }
+      else if (TRI_EqualString(key->_value._string.data, "compressDatafiles")) {
+        parameters->_compressDatafiles = value->_value._boolean;
+      }
       else if (TRI_EqualString(key->_value._string.data, "isVolatile")) {
         parameters->_isVolatile = value->_value._boolean;
       }
@@ -907,6 +927,10 @@ void TRI_InitCollectionInfo (TRI_vocbase_t* vocbase,
   parameters->_initialCount  = -1;
   parameters->_indexBuckets  = 1;
 
+  parameters->_compactionDeadSizeThreshold = TRI_COL_COMPACTION_DEAD_SIZE_THRESHOLD;
+  parameters->_compactionDeadSizeShare     = TRI_COL_COMPACTION_DEAD_SIZE_SHARE;
+  parameters->_compactionMaxFileSize       = TRI_COL_COMPACTION_MAX_FILE_SIZE;
+
   // fill name with 0 bytes
   memset(parameters->_name, 0, sizeof(parameters->_name));
   TRI_CopyString(parameters->_name, name, sizeof(parameters->_name) - 1);
@@ -919,6 +943,7 @@ void TRI_InitCollectionInfo (TRI_vocbase_t* vocbase,
 
   parameters->_deleted       = false;
   parameters->_doCompact     = true;
+  parameters->_compressDatafiles = false;
   parameters->_isVolatile    = false;
   parameters->_isSystem      = false;
   parameters->_waitForSync   = vocbase->_settings.defaultWaitForSync;
@@ -951,6 +976,10 @@ void TRI_CopyCollectionInfo (TRI_col_info_t* dst,
   dst->_initialCount  = src->_initialCount;
   dst->_indexBuckets  = src->_indexBuckets;
 
+  dst->_compactionDeadSizeThreshold = src->_compactionDeadSizeThreshold;
+  dst->_compactionDeadSizeShare     = src->_compactionDeadSizeShare;
+  dst->_compactionMaxFileSize       = src->_compactionMaxFileSize;
+
   TRI_CopyString(dst->_name, src->_name, sizeof(dst->_name) - 1);
 
   if (src->_keyOptions) {
@@ -962,6 +991,7 @@ void TRI_CopyCollectionInfo (TRI_col_info_t* dst,
 
   dst->_deleted       = src->_deleted;
   dst->_doCompact     = src->_doCompact;
+  dst->_compressDatafiles = src->_compressDatafiles;
   dst->_isSystem      = src->_isSystem;
   dst->_isVolatile    = src->_isVolatile;
   dst->_waitForSync   = src->_waitForSync;
@@ -1338,8 +1368,13 @@ TRI_json_t* TRI_CreateJsonCollectionInfo (TRI_col_info_t const* info) {
 
   TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "indexBuckets", TRI_CreateNumberJson(TRI_CORE_MEM_ZONE, info->_indexBuckets));
 
+  TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "compactionDeadSizeThreshold", TRI_CreateNumberJson(TRI_CORE_MEM_ZONE, (double) info->_compactionDeadSizeThreshold));
+  TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "compactionDeadSizeShare",     TRI_CreateNumberJson(TRI_CORE_MEM_ZONE, info->_compactionDeadSizeShare));
+  TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "compactionMaxFileSize",       TRI_CreateNumberJson(TRI_CORE_MEM_ZONE, (double) info->_compactionMaxFileSize));
+
   TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "deleted",      TRI_CreateBooleanJson(TRI_CORE_MEM_ZONE, info->_deleted));
   TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "doCompact",    TRI_CreateBooleanJson(TRI_CORE_MEM_ZONE, info->_doCompact));
+  TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "compressDatafiles", TRI_CreateBooleanJson(TRI_CORE_MEM_ZONE, info->_compressDatafiles));
   TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "maximalSize",  TRI_CreateNumberJson(TRI_CORE_MEM_ZONE, (double) info->_maximalSize));
   TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "name",         TRI_CreateStringCopyJson(TRI_CORE_MEM_ZONE, info->_name, strlen(info->_name)));
   TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "isVolatile",   TRI_CreateBooleanJson(TRI_CORE_MEM_ZONE, info->_isVolatile));
@@ -1369,6 +1404,11 @@ int TRI_LoadCollectionInfo (char const* path,
   parameter->_doCompact  = true;
   parameter->_isVolatile = false;
 
+  // collections created with older versions don't have these
+  parameter->_compactionDeadSizeThreshold = TRI_COL_COMPACTION_DEAD_SIZE_THRESHOLD;
+  parameter->_compactionDeadSizeShare     = TRI_COL_COMPACTION_DEAD_SIZE_SHARE;
+  parameter->_compactionMaxFileSize       = TRI_COL_COMPACTION_MAX_FILE_SIZE;
+
   // find parameter file
   char* filename = TRI_Concatenate2File(path, TRI_VOC_PARAMETER_FILE);
 
@@ -1468,9 +1508,13 @@ int TRI_UpdateCollectionInfo (TRI_vocbase_t* vocbase,
 
   if (parameters != nullptr) {
     collection->_info._doCompact   = parameters->_doCompact;
+    collection->_info._compressDatafiles = parameters->_compressDatafiles;
     collection->_info._maximalSize = parameters->_maximalSize;
     collection->_info._waitForSync = parameters->_waitForSync;
     collection->_info._indexBuckets = parameters->_indexBuckets;
+    collection->_info._compactionDeadSizeThreshold = parameters->_compactionDeadSizeThreshold;
+    collection->_info._compactionDeadSizeShare     = parameters->_compactionDeadSizeShare;
+    collection->_info._compactionMaxFileSize       = parameters->_compactionMaxFileSize;
 
     // the following collection properties are intentionally not updated as updating
     // them would be very complicated:
@@ -1794,13 +1838,14 @@ int TRI_UpgradeCollection20 (TRI_vocbase_t* vocbase,
 
         tick = TRI_NewTickServer();
 
-        // datafile header
+        // datafile header. the shape markers are copied as they are, so the new
+        // datafile keeps the CRC32 checksums of the old ones
         TRI_InitMarkerDatafile((char*) &header, TRI_DF_MARKER_HEADER, sizeof(TRI_df_header_marker_t));
-        header._version     = TRI_DF_VERSION;
+        header._version     = TRI_DF_VERSION_CRC32;
         header._maximalSize = 0; // TODO: seems ok to set this to 0, check if this is ok
         header._fid         = tick;
         header.base._tick   = tick;
-        header.base._crc    = TRI_FinalCrc32(TRI_BlockCrc32(TRI_InitialCrc32(), (char const*) &header.base, header.base._size));
+        header.base._crc    = TRI_CrcMarkerDatafile(&header.base, false);
 
         written += TRI_WRITE(fdout, &header.base, header.base._size);
 
@@ -1809,7 +1854,7 @@ int TRI_UpgradeCollection20 (TRI_vocbase_t* vocbase,
         cm._type      = (TRI_col_type_t) info->_type;
         cm._cid       = info->_cid;
         cm.base._tick = tick;
-        cm.base._crc  = TRI_FinalCrc32(TRI_BlockCrc32(TRI_InitialCrc32(), (char const*) &cm.base, cm.base._size));
+        cm.base._crc  = TRI_CrcMarkerDatafile(&cm.base, false);
 
         written += TRI_WRITE(fdout, &cm.base, cm.base._size);
       }
@@ -1847,7 +1892,7 @@ int TRI_UpgradeCollection20 (TRI_vocbase_t* vocbase,
       tick = TRI_NewTickServer();
       TRI_InitMarkerDatafile((char*) &footer, TRI_DF_MARKER_FOOTER, sizeof(TRI_df_footer_marker_t));
       footer.base._tick = tick;
-      footer.base._crc  = TRI_FinalCrc32(TRI_BlockCrc32(TRI_InitialCrc32(), (char const*) &footer.base, footer.base._size));
+      footer.base._crc  = TRI_CrcMarkerDatafile(&footer.base, false);
 
       written += TRI_WRITE(fdout, &footer.base, footer.base._size);
 
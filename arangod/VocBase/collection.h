@@ -92,6 +92,26 @@ struct TRI_vocbase_col_s;
 
 #define TRI_COL_VERSION TRI_COL_VERSION_20
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief default minimum size of dead data (in bytes) in a datafile that will
+/// make the datafile eligible for compaction
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_COL_COMPACTION_DEAD_SIZE_THRESHOLD (1024 * 128)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief default share of dead data in a datafile that will make the datafile
+/// eligible for compaction
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_COL_COMPACTION_DEAD_SIZE_SHARE (0.1)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief default maximum size of a compacted file
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_COL_COMPACTION_MAX_FILE_SIZE (128 * 1024 * 1024)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief predefined system collection name for transactions
 ////////////////////////////////////////////////////////////////////////////////
@@ -177,12 +197,17 @@ typedef struct TRI_col_info_s {
   int64_t            _initialCount;    // initial count, used when loading a collection
   uint32_t           _indexBuckets;    // number of buckets used in hash tables for indexes
 
+  uint64_t           _compactionDeadSizeThreshold;  // dead bytes in a datafile that trigger compaction
+  double             _compactionDeadSizeShare;      // share of dead bytes in a datafile that triggers compaction
+  uint64_t           _compactionMaxFileSize;        // maximum size of a compacted file
+
   char               _name[TRI_COL_PATH_LENGTH];  // name of the collection
   struct TRI_json_t* _keyOptions;      // options for key creation
 
   // flags
   bool               _deleted;         // if true, collection has been deleted
   bool               _doCompact;       // if true, collection will be compacted
+  bool               _compressDatafiles; // if true, the compactor compresses sealed datafiles
   bool               _isSystem;        // if true, this is a system collection
   bool               _isVolatile;      // if true, collection is memory-only
   bool               _waitForSync;     // if true, wait for msync
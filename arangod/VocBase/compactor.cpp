@@ -47,27 +47,6 @@
 // --SECTION--                                                 private constants
 // -----------------------------------------------------------------------------
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief minimum size of dead data (in bytes) in a datafile that will make
-/// the datafile eligible for compaction at all.
-///
-/// Any datafile with less dead data than the threshold will not become a
-/// candidate for compaction.
-////////////////////////////////////////////////////////////////////////////////
-
-#define COMPACTOR_DEAD_SIZE_THRESHOLD (1024 * 128)
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief percentage of dead documents in a datafile that will trigger the
-/// compaction
-///
-/// for example, if the collection contains 800 bytes of alive and 400 bytes of
-/// dead documents, the share of the dead documents is 400 / (400 + 800) = 33 %.
-/// if this value if higher than the threshold, the datafile will be compacted
-////////////////////////////////////////////////////////////////////////////////
-
-#define COMPACTOR_DEAD_SIZE_SHARE (0.1)
-
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief maximum number of datafiles to join together in one compaction run
 ////////////////////////////////////////////////////////////////////////////////
@@ -82,12 +61,6 @@
 
 #define COMPACTOR_MAX_SIZE_FACTOR (3)
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief maximum filesize of resulting compacted file
-////////////////////////////////////////////////////////////////////////////////
-
-#define COMPACTOR_MAX_RESULT_FILESIZE (128 * 1024 * 1024)
-
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief datafiles smaller than the following value will be merged with others
 ////////////////////////////////////////////////////////////////////////////////
@@ -101,10 +74,11 @@
 #define COMPACTOR_COLLECTION_INTERVAL (10.0)
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief compactify interval in microseconds
+/// @brief do not rewrite a datafile for compression again in this interval
+/// (in s) after its compression failed
 ////////////////////////////////////////////////////////////////////////////////
 
-static int const COMPACTOR_INTERVAL = (1 * 1000 * 1000);
+#define COMPACTOR_COMPRESSION_RETRY_INTERVAL (3600.0)
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                     private types
@@ -141,6 +115,7 @@ typedef struct compaction_context_s {
   TRI_document_collection_t* _document;
   TRI_datafile_t*            _compactor;
   TRI_doc_datafile_info_t    _dfi;
+  uint64_t                   _bytesWritten;
   bool                       _keepDeletions;
 }
 compaction_context_t;
@@ -200,21 +175,36 @@ static TRI_datafile_t* CreateCompactor (TRI_document_collection_t* document,
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief write a copy of the marker into the datafile
+///
+/// the marker is re-checksummed if the source datafile uses a different
+/// checksum algorithm than the compactor
 ////////////////////////////////////////////////////////////////////////////////
 
-static int CopyMarker (TRI_document_collection_t* document,
-                       TRI_datafile_t* compactor,
+static int CopyMarker (compaction_context_t* context,
+                       TRI_datafile_t const* datafile,
                        TRI_df_marker_t const* marker,
                        TRI_df_marker_t** result) {
+  TRI_datafile_t* compactor = context->_compactor;
+
   int res = TRI_ReserveElementDatafile(compactor, marker->_size, result, 0);
 
   if (res != TRI_ERROR_NO_ERROR) {
-    document->_lastError = TRI_set_errno(TRI_ERROR_ARANGO_NO_JOURNAL);
+    context->_document->_lastError = TRI_set_errno(TRI_ERROR_ARANGO_NO_JOURNAL);
 
     return TRI_ERROR_ARANGO_NO_JOURNAL;
   }
 
-  return TRI_WriteElementDatafile(compactor, *result, marker, false);
+  res = TRI_WriteElementDatafile(compactor, *result, marker, false);
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    if (datafile->_crc32c != compactor->_crc32c) {
+      (*result)->_crc = TRI_CrcMarkerDatafile(*result, compactor->_crc32c);
+    }
+
+    context->_bytesWritten += (uint64_t) AlignedSize(marker);
+  }
+
+  return res;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -472,7 +462,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
     context->_keepDeletions = true;
 
     // write to compactor files
-    res = CopyMarker(document, context->_compactor, marker, &result);
+    res = CopyMarker(context, datafile, marker, &result);
 
     if (res != TRI_ERROR_NO_ERROR) {
       // TODO: dont fail but recover from this state
@@ -521,7 +511,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
   else if (marker->_type == TRI_DOC_MARKER_KEY_DELETION &&
            context->_keepDeletions) {
     // write to compactor files
-    res = CopyMarker(document, context->_compactor, marker, &result);
+    res = CopyMarker(context, datafile, marker, &result);
 
     if (res != TRI_ERROR_NO_ERROR) {
       // TODO: dont fail but recover from this state
@@ -535,7 +525,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
   // shapes
   else if (marker->_type == TRI_DF_MARKER_SHAPE) {
     // write to compactor files
-    res = CopyMarker(document, context->_compactor, marker, &result);
+    res = CopyMarker(context, datafile, marker, &result);
 
     if (res != TRI_ERROR_NO_ERROR) {
       // TODO: dont fail but recover from this state
@@ -555,7 +545,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
   // attributes
   else if (marker->_type == TRI_DF_MARKER_ATTRIBUTE) {
     // write to compactor files
-    res = CopyMarker(document, context->_compactor, marker, &result);
+    res = CopyMarker(context, datafile, marker, &result);
 
     if (res != TRI_ERROR_NO_ERROR) {
       // TODO: dont fail but recover from this state
@@ -583,7 +573,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
 
     if (document->_failedTransactions != nullptr) {
       // write to compactor files
-      res = CopyMarker(document, context->_compactor, marker, &result);
+      res = CopyMarker(context, datafile, marker, &result);
 
       if (res != TRI_ERROR_NO_ERROR) {
         // TODO: dont fail but recover from this state
@@ -786,7 +776,8 @@ static compaction_initial_context_t InitCompaction (TRI_document_collection_t* d
 ////////////////////////////////////////////////////////////////////////////////
 
 static void CompactifyDatafiles (TRI_document_collection_t* document,
-                                 TRI_vector_t const* compactions) {
+                                 TRI_vector_t const* compactions,
+                                 uint64_t* bytesWritten) {
   TRI_datafile_t* compactor;
   compaction_initial_context_t initial;
   compaction_context_t context;
@@ -827,9 +818,10 @@ static void CompactifyDatafiles (TRI_document_collection_t* document,
 
   memset(&context._dfi, 0, sizeof(TRI_doc_datafile_info_t));
   // these attributes remain the same for all datafiles we collect
-  context._document  = document;
-  context._compactor = compactor;
-  context._dfi._fid  = compactor->_fid;
+  context._document     = document;
+  context._compactor    = compactor;
+  context._dfi._fid     = compactor->_fid;
+  context._bytesWritten = 0;
 
   // now compact all datafiles
   for (i = 0; i < n; ++i) {
@@ -853,6 +845,8 @@ static void CompactifyDatafiles (TRI_document_collection_t* document,
     
     TRI_WRITE_UNLOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(document);
 
+    *bytesWritten = context._bytesWritten;
+
     if (! ok) {
       LOG_WARNING("failed to compact datafile '%s'", df->getName(df));
       // compactor file does not need to be removed now. will be removed on next startup
@@ -926,6 +920,15 @@ static void CompactifyDatafiles (TRI_document_collection_t* document,
     }
   }
   else {
+    if (document->_info._compressDatafiles && compactor->isPhysical(compactor)) {
+      // the compactor is sealed now and will not be written to anymore
+      int res = TRI_CompressDatafile(compactor);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        LOG_WARNING("could not compress compactor file '%s': %s", compactor->getName(compactor), TRI_errno_string(res));
+      }
+    }
+
     if (n > 1) {
       // create .dead files for all collected files but the first
       for (i = 1; i < n; ++i) {
@@ -976,11 +979,33 @@ static void CompactifyDatafiles (TRI_document_collection_t* document,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether a datafile should be rewritten so it can be compressed
+///
+/// after its compression failed, a datafile is not rewritten for this reason
+/// again before COMPACTOR_COMPRESSION_RETRY_INTERVAL has passed
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ShouldCompressDatafile (TRI_document_collection_t const* document,
+                                    TRI_datafile_t const* df,
+                                    double now) {
+  return (document->_info._compressDatafiles &&
+          df->isPhysical(df) &&
+          df->_compressedSize == 0 &&
+          df->_compressionFailed + COMPACTOR_COMPRESSION_RETRY_INTERVAL <= now);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief checks all datafiles of a collection
+///
+/// the number of bytes in the datafiles that were compacted is stored in the
+/// last parameter
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool CompactifyDocumentCollection (TRI_document_collection_t* document) {
+static bool CompactifyDocumentCollection (TRI_document_collection_t* document,
+                                          uint64_t* bytesCompacted) {
+  *bytesCompacted = 0;
+
   // we can hopefully get away without the lock here...
 //  if (! TRI_IsFullyCollectedDocumentCollection(document)) {
 //    return false;
@@ -1004,13 +1029,19 @@ static bool CompactifyDocumentCollection (TRI_document_collection_t* document) {
     return false;
   }
 
+  // get the thresholds of the collection
+  uint64_t const deadSizeThreshold = document->_info._compactionDeadSizeThreshold;
+  double const deadSizeShare       = document->_info._compactionDeadSizeShare;
+  uint64_t const maxResultSize     = document->_info._compactionMaxFileSize;
+  double const now                 = TRI_microtime();
+
   // get maximum size of result file
   uint64_t maxSize = (uint64_t) COMPACTOR_MAX_SIZE_FACTOR * (uint64_t) document->_info._maximalSize;
   if (maxSize < 8 * 1024 * 1024) {
     maxSize = 8 * 1024 * 1024;
   }
-  if (maxSize >= COMPACTOR_MAX_RESULT_FILESIZE) {
-    maxSize = COMPACTOR_MAX_RESULT_FILESIZE;
+  if (maxSize >= maxResultSize) {
+    maxSize = maxResultSize;
   }
 
   // copy datafile information
@@ -1053,7 +1084,7 @@ static bool CompactifyDocumentCollection (TRI_document_collection_t* document) {
     }
     else {
       // in all other cases, only check the number and size of "dead" objects
-      if (dfi->_sizeDead >= (int64_t) COMPACTOR_DEAD_SIZE_THRESHOLD) {
+      if (dfi->_sizeDead >= (int64_t) deadSizeThreshold) {
         shouldCompact = true;
         compactNext = true;
       }
@@ -1061,12 +1092,17 @@ static bool CompactifyDocumentCollection (TRI_document_collection_t* document) {
         // the size of dead objects is above some threshold
         double share = (double) dfi->_sizeDead / ((double) dfi->_sizeDead + (double) dfi->_sizeAlive);
 
-        if (share >= COMPACTOR_DEAD_SIZE_SHARE) {
+        if (share >= deadSizeShare) {
           // the size of dead objects is above some share
           shouldCompact = true;
           compactNext = true;
         }
       }
+
+      if (! shouldCompact && ShouldCompressDatafile(document, df, now)) {
+        // the datafile is rewritten so it can be compressed
+        shouldCompact = true;
+      }
     }
 
     if (! shouldCompact) {
@@ -1102,6 +1138,7 @@ static bool CompactifyDocumentCollection (TRI_document_collection_t* document) {
     compaction._keepDeletions = (numAlive > 0 && i > 0);
 
     TRI_PushBackVector(&vector, &compaction);
+    *bytesCompacted += (uint64_t) df->_currentSize;
 
     // we stop at the first few datafiles.
     // this is better than going over all datafiles in a collection in one go
@@ -1125,13 +1162,23 @@ static bool CompactifyDocumentCollection (TRI_document_collection_t* document) {
   if (TRI_LengthVector(&vector) == 0) {
     // cleanup local variables
     TRI_DestroyVector(&vector);
+    *bytesCompacted = 0;
     return false;
   }
 
   // handle datafiles with dead objects
   TRI_ASSERT(TRI_LengthVector(&vector) >= 1);
 
-  CompactifyDatafiles(document, &vector);
+  double const start = TRI_microtime();
+  uint64_t bytesWritten = 0;
+
+  CompactifyDatafiles(document, &vector, &bytesWritten);
+
+  // update the compaction statistics of the collection
+  ++document->_compactionRuns;
+  document->_compactionBytesRead    += *bytesCompacted;
+  document->_compactionBytesWritten += bytesWritten;
+  document->_compactionTime         += (uint64_t) ((TRI_microtime() - start) * 1000000.0);
 
   // cleanup local variables
   TRI_DestroyVector(&vector);
@@ -1372,124 +1419,142 @@ int TRI_RemoveBlockerCompactorVocBase (TRI_vocbase_t* vocbase,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief compactor event loop
+/// @brief return the share of dead data in the datafiles of a collection
+///
+/// returns a negative value if the collection is currently not a candidate
+/// for compaction
 ////////////////////////////////////////////////////////////////////////////////
 
-void TRI_CompactorVocBase (void* data) {
-  TRI_vocbase_t* vocbase;
-  TRI_vector_pointer_t collections;
-  int numCompacted = 0;
+double TRI_DeadShareCompactorVocBase (TRI_vocbase_col_t* collection,
+                                      double now) {
+  if (! TRI_TRY_READ_LOCK_STATUS_VOCBASE_COL(collection)) {
+    // if we can't acquire the read lock instantly, we continue directly
+    // we don't want to stall here for too long
+    return -1.0;
+  }
 
-  vocbase = (TRI_vocbase_t*) data;
-  TRI_ASSERT(vocbase->_state == 1);
+  TRI_document_collection_t* document = collection->_collection;
 
-  TRI_InitVectorPointer(&collections, TRI_UNKNOWN_MEM_ZONE);
+  if (document == nullptr ||
+      collection->_status != TRI_VOC_COL_STATUS_LOADED ||
+      ! document->_info._doCompact ||
+      document->_lastCompaction + COMPACTOR_COLLECTION_INTERVAL > now) {
+    TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
+    return -1.0;
+  }
 
-  while (true) {
-    // keep initial _state value as vocbase->_state might change during compaction loop
-    int state = vocbase->_state;
+  if (! TRI_TRY_READ_LOCK_DATAFILES_DOC_COLLECTION(document)) {
+    TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
+    return -1.0;
+  }
 
-    // check if compaction is currently disallowed
-    if (CheckAndLockCompaction(vocbase)) {
-      // compaction is currently allowed
-      double now = TRI_microtime();
-      numCompacted = 0;
+  size_t const n = document->_datafiles._length;
+  bool candidate = false;
+  int64_t sizeDead = 0;
+  int64_t sizeAlive = 0;
 
-      // copy all collections
-      TRI_READ_LOCK_COLLECTIONS_VOCBASE(vocbase);
-      TRI_CopyDataVectorPointer(&collections, &vocbase->_collections);
-      TRI_READ_UNLOCK_COLLECTIONS_VOCBASE(vocbase);
+  uint64_t const deadSizeThreshold = document->_info._compactionDeadSizeThreshold;
+  double const deadSizeShare       = document->_info._compactionDeadSizeShare;
 
-      size_t const n = collections._length;
+  if (document->_compactors._length == 0) {
+    for (size_t i = 0;  i < n;  ++i) {
+      TRI_datafile_t* df = static_cast<TRI_datafile_t*>(document->_datafiles._buffer[i]);
+      TRI_doc_datafile_info_t* dfi = TRI_FindDatafileInfoDocumentCollection(document, df->_fid, false);
 
-      for (size_t i = 0;  i < n;  ++i) {
-        TRI_vocbase_col_t* collection = static_cast<TRI_vocbase_col_t*>(collections._buffer[i]);
+      if (dfi == nullptr) {
+        continue;
+      }
 
-        if (! TRI_TRY_READ_LOCK_STATUS_VOCBASE_COL(collection)) {
-          // if we can't acquire the read lock instantly, we continue directly
-          // we don't want to stall here for too long
-          continue;
-        }
+      sizeDead += dfi->_sizeDead;
+      sizeAlive += dfi->_sizeAlive;
+
+      // same criteria as in CompactifyDocumentCollection
+      if ((df->_maximalSize < COMPACTOR_MIN_SIZE && i < n - 1) ||
+          (dfi->_numberAlive == 0 && dfi->_numberDeletion > 0) ||
+          dfi->_sizeDead >= (int64_t) deadSizeThreshold ||
+          (dfi->_sizeDead > 0 &&
+           (double) dfi->_sizeDead / ((double) dfi->_sizeDead + (double) dfi->_sizeAlive) >= deadSizeShare) ||
+          ShouldCompressDatafile(document, df, now)) {
+        candidate = true;
+      }
+    }
+  }
 
-        TRI_document_collection_t* document = collection->_collection;
+  TRI_READ_UNLOCK_DATAFILES_DOC_COLLECTION(document);
+  TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
 
-        if (document == nullptr) {
-          TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
-          continue;
-        }
+  if (! candidate) {
+    return -1.0;
+  }
 
-        bool worked    = false;
-        bool doCompact = document->_info._doCompact;
+  if (sizeDead <= 0) {
+    return 0.0;
+  }
 
-        // for document collection, compactify datafiles
-        if (collection->_status == TRI_VOC_COL_STATUS_LOADED && doCompact) {
-          // check whether someone else holds a read-lock on the compaction lock
-          if (! TRI_TryWriteLockReadWriteLock(&document->_compactionLock)) {
-            // someone else is holding the compactor lock, we'll not compact
-            TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
-            continue;
-          }
+  return (double) sizeDead / ((double) sizeDead + (double) sizeAlive);
+}
 
-          if (document->_lastCompaction + COMPACTOR_COLLECTION_INTERVAL <= now) {
-            auto ce = document->ditches()->createCompactionDitch(__FILE__, __LINE__);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compact the datafiles of a collection
+////////////////////////////////////////////////////////////////////////////////
 
-            if (ce == nullptr) {
-              // out of memory
-              LOG_WARNING("out of memory when trying to create compaction ditch");
-            }
-            else {
-              worked = CompactifyDocumentCollection(document);
+bool TRI_CompactCollectionCompactorVocBase (TRI_vocbase_t* vocbase,
+                                            TRI_vocbase_col_t* collection,
+                                            uint64_t* bytesCompacted) {
+  *bytesCompacted = 0;
 
-              if (! worked) {
-                // set compaction stamp
-                document->_lastCompaction = now;
-              }
-              // if we worked, then we don't set the compaction stamp to force another round of compaction
+  // check if compaction is currently disallowed
+  if (! CheckAndLockCompaction(vocbase)) {
+    return false;
+  }
 
-              document->ditches()->freeDitch(ce);
-            }
-          }
+  double now = TRI_microtime();
 
-          // read-unlock the compaction lock
-          TRI_WriteUnlockReadWriteLock(&document->_compactionLock);
-        }
+  if (! TRI_TRY_READ_LOCK_STATUS_VOCBASE_COL(collection)) {
+    // if we can't acquire the read lock instantly, we return directly
+    // we don't want to stall here for too long
+    UnlockCompaction(vocbase);
+    return false;
+  }
 
-        TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
+  TRI_document_collection_t* document = collection->_collection;
+  bool worked = false;
+
+  // for document collection, compactify datafiles
+  if (document != nullptr && 
+      collection->_status == TRI_VOC_COL_STATUS_LOADED && 
+      document->_info._doCompact) {
+    // check whether someone else holds a read-lock on the compaction lock
+    if (TRI_TryWriteLockReadWriteLock(&document->_compactionLock)) {
+      if (document->_lastCompaction + COMPACTOR_COLLECTION_INTERVAL <= now) {
+        auto ce = document->ditches()->createCompactionDitch(__FILE__, __LINE__);
+
+        if (ce == nullptr) {
+          // out of memory
+          LOG_WARNING("out of memory when trying to create compaction ditch");
+        }
+        else {
+          worked = CompactifyDocumentCollection(document, bytesCompacted);
 
-        if (worked) {
-          ++numCompacted;
+          if (! worked) {
+            // set compaction stamp
+            document->_lastCompaction = now;
+          }
+          // if we worked, then we don't set the compaction stamp to force another round of compaction
 
-          // signal the cleanup thread that we worked and that it can now wake up
-          TRI_LockCondition(&vocbase->_cleanupCondition);
-          TRI_SignalCondition(&vocbase->_cleanupCondition);
-          TRI_UnlockCondition(&vocbase->_cleanupCondition);
+          document->ditches()->freeDitch(ce);
         }
       }
 
-      UnlockCompaction(vocbase);
-    }
-
-    if (numCompacted > 0) {
-      // no need to sleep long or go into wait state if we worked.
-      // maybe there's still work left
-      usleep(1000);
-    }
-    else if (state != 2 && vocbase->_state == 1) {
-      // only sleep while server is still running
-      TRI_LockCondition(&vocbase->_compactorCondition);
-      TRI_TimedWaitCondition(&vocbase->_compactorCondition, (uint64_t) COMPACTOR_INTERVAL);
-      TRI_UnlockCondition(&vocbase->_compactorCondition);
-    }
-
-    if (state == 2) {
-      // server shutdown
-      break;
+      // read-unlock the compaction lock
+      TRI_WriteUnlockReadWriteLock(&document->_compactionLock);
     }
   }
 
-  TRI_DestroyVectorPointer(&collections);
+  TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
+  UnlockCompaction(vocbase);
 
-  LOG_TRACE("shutting down compactor thread");
+  return worked;
 }
 
 // -----------------------------------------------------------------------------
@@ -35,6 +35,7 @@
 #include "VocBase/voc-types.h"
 
 struct TRI_vocbase_s;
+struct TRI_vocbase_col_s;
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                  public functions
@@ -96,10 +97,25 @@ bool TRI_CheckAndLockCompactorVocBase (struct TRI_vocbase_s*);
 void TRI_UnlockCompactorVocBase (struct TRI_vocbase_s*);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief compactor event loop
+/// @brief return the share of dead data in the datafiles of a collection
+///
+/// returns a negative value if the collection is currently not a candidate
+/// for compaction
+////////////////////////////////////////////////////////////////////////////////
+
+double TRI_DeadShareCompactorVocBase (struct TRI_vocbase_col_s*,
+                                      double);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compact the datafiles of a collection
+///
+/// returns true if some datafiles were compacted, and stores the number of
+/// bytes in the compacted datafiles in the last parameter
 ////////////////////////////////////////////////////////////////////////////////
 
-void TRI_CompactorVocBase (void*);
+bool TRI_CompactCollectionCompactorVocBase (struct TRI_vocbase_s*,
+                                            struct TRI_vocbase_col_s*,
+                                            uint64_t*);
 
 #endif
 
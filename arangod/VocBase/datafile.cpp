@@ -41,6 +41,8 @@
 #include "Basics/files.h"
 #include "VocBase/server.h"
 
+#include <zlib.h>
+
 
 // #define DEBUG_DATAFILE 1
 
@@ -134,34 +136,13 @@ static int TruncateDatafile (TRI_datafile_t* const datafile, const off_t length)
   return TRI_ERROR_NO_ERROR;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief calculates the actual CRC of a marker, without bounds checks
-////////////////////////////////////////////////////////////////////////////////
-
-static TRI_voc_crc_t CalculateCrcValue (TRI_df_marker_t const* marker) {
-  TRI_voc_size_t zero = 0;
-  off_t o = offsetof(TRI_df_marker_t, _crc);
-  size_t n = sizeof(TRI_voc_crc_t);
-
-  char const* ptr = (char const*) marker;
-
-  TRI_voc_crc_t crc = TRI_InitialCrc32();
-
-  crc = TRI_BlockCrc32(crc, ptr, o);
-  crc = TRI_BlockCrc32(crc, (char*) &zero, n);
-  crc = TRI_BlockCrc32(crc, ptr + o + n, marker->_size - o - n);
-
-  crc = TRI_FinalCrc32(crc);
-
-  return crc;
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief diagnoses a marker
 ////////////////////////////////////////////////////////////////////////////////
 
 static std::string DiagnoseMarker (TRI_df_marker_t const* marker,
-                                   char const* end) {
+                                   char const* end,
+                                   bool crc32c) {
   std::ostringstream result;
 
   if (marker == nullptr) {
@@ -200,7 +181,7 @@ static std::string DiagnoseMarker (TRI_df_marker_t const* marker,
     return result.str();
   }
 
-  TRI_voc_crc_t crc = CalculateCrcValue(marker);
+  TRI_voc_crc_t crc = TRI_CrcMarkerDatafile(marker, crc32c);
     
   if (marker->_crc == crc) {
     result << "crc checksum is correct";
@@ -217,7 +198,8 @@ static std::string DiagnoseMarker (TRI_df_marker_t const* marker,
 ////////////////////////////////////////////////////////////////////////////////
 
 static bool CheckCrcMarker (TRI_df_marker_t const* marker,
-                            char const* end) {
+                            char const* end,
+                            bool crc32c) {
   if (marker->_size < sizeof(TRI_df_marker_t)) {
     return false;
   }
@@ -226,7 +208,7 @@ static bool CheckCrcMarker (TRI_df_marker_t const* marker,
     return false;
   }
 
-  auto expected = CalculateCrcValue(marker);
+  auto expected = TRI_CrcMarkerDatafile(marker, crc32c);
   return marker->_crc == expected;
 }
 
@@ -325,6 +307,13 @@ static void InitDatafile (TRI_datafile_t* datafile,
   datafile->_isSealed    = false;
   datafile->_lastError   = TRI_ERROR_NO_ERROR;
 
+  // new datafiles use the current datafile version
+  datafile->_crc32c      = true;
+
+  datafile->_compressedSize    = 0;
+  datafile->_compressionFailed = 0.0;
+  datafile->_isCold            = false;
+
   datafile->_full        = false;
 
   datafile->_data        = data;
@@ -572,7 +561,7 @@ static TRI_df_scan_t ScanDatafile (TRI_datafile_t const* datafile) {
     if (marker->_size < sizeof(TRI_df_marker_t)) {
       entry._status = 4;
 
-      auto&& diagnosis = DiagnoseMarker(marker, end);
+      auto&& diagnosis = DiagnoseMarker(marker, end, datafile->_crc32c);
       entry._diagnosis = TRI_DuplicateString2Z(TRI_UNKNOWN_MEM_ZONE, diagnosis.c_str(), diagnosis.size());
 
       scan._endPosition = currentSize;
@@ -585,7 +574,7 @@ static TRI_df_scan_t ScanDatafile (TRI_datafile_t const* datafile) {
     if (! TRI_IsValidMarkerDatafile(marker)) {
       entry._status = 4;
 
-      auto&& diagnosis = DiagnoseMarker(marker, end);
+      auto&& diagnosis = DiagnoseMarker(marker, end, datafile->_crc32c);
       entry._diagnosis = TRI_DuplicateString2Z(TRI_UNKNOWN_MEM_ZONE, diagnosis.c_str(), diagnosis.size());
 
       scan._endPosition = currentSize;
@@ -595,12 +584,12 @@ static TRI_df_scan_t ScanDatafile (TRI_datafile_t const* datafile) {
       return scan;
     }
 
-    ok = CheckCrcMarker(marker, end);
+    ok = CheckCrcMarker(marker, end, datafile->_crc32c);
 
     if (! ok) {
       entry._status = 5;
       
-      auto&& diagnosis = DiagnoseMarker(marker, end);
+      auto&& diagnosis = DiagnoseMarker(marker, end, datafile->_crc32c);
       entry._diagnosis = TRI_DuplicateString2Z(TRI_UNKNOWN_MEM_ZONE, diagnosis.c_str(), diagnosis.size());
       
       scan._status = 4;
@@ -660,7 +649,7 @@ static bool TryRepairDatafile (TRI_datafile_t* datafile) {
     }
 
     if (marker->_type != 0) {
-      if (! CheckCrcMarker(marker, end)) {
+      if (! CheckCrcMarker(marker, end, datafile->_crc32c)) {
         // CRC mismatch!
         auto next = reinterpret_cast<char const*>(marker) + marker->_size;
         auto p = next;
@@ -696,7 +685,7 @@ static bool TryRepairDatafile (TRI_datafile_t* datafile) {
                 nextMarker->_size >= sizeof(TRI_df_marker_t) &&
                 next + nextMarker->_size <= end &&
                 TRI_IsValidMarkerDatafile(nextMarker) &&
-                CheckCrcMarker(nextMarker, end)) {
+                CheckCrcMarker(nextMarker, end, datafile->_crc32c)) {
               // next marker looks good.
 
               // create a temporary buffer
@@ -709,7 +698,7 @@ static bool TryRepairDatafile (TRI_datafile_t* datafile) {
               // create a new marker in the temporary buffer
               auto temp = reinterpret_cast<TRI_df_marker_t*>(buffer);
               TRI_InitMarkerDatafile(static_cast<char*>(buffer), TRI_DF_MARKER_BLANK, static_cast<TRI_voc_size_t>(marker->_size));
-              temp->_crc = CalculateCrcValue(temp);
+              temp->_crc = TRI_CrcMarkerDatafile(temp, datafile->_crc32c);
 
               // all done. now copy back the marker into the file
               memcpy(static_cast<void*>(ptr), buffer, static_cast<size_t>(marker->_size));
@@ -901,7 +890,7 @@ static bool CheckDatafile (TRI_datafile_t* datafile,
     }
 
     if (marker->_type != 0) {
-      bool ok = CheckCrcMarker(marker, end);
+      bool ok = CheckCrcMarker(marker, end, datafile->_crc32c);
 
       if (! ok) {
         // CRC mismatch!
@@ -939,7 +928,7 @@ static bool CheckDatafile (TRI_datafile_t* datafile,
                     nextMarker->_size >= sizeof(TRI_df_marker_t) &&
                     next + nextMarker->_size <= end &&
                     TRI_IsValidMarkerDatafile(nextMarker) &&
-                    CheckCrcMarker(nextMarker, end)) {
+                    CheckCrcMarker(nextMarker, end, datafile->_crc32c)) {
                   // next marker looks good.
                   nextMarkerOk = true;
                 }
@@ -964,7 +953,7 @@ static bool CheckDatafile (TRI_datafile_t* datafile,
           LOG_WARNING("crc mismatch found in datafile '%s' at position %lu. expected crc: %x, actual crc: %x", 
                       datafile->getName(datafile),
                       (unsigned long) currentSize,
-                      CalculateCrcValue(marker),
+                      TRI_CrcMarkerDatafile(marker, datafile->_crc32c),
                       marker->_crc);
           
           if (nextMarkerOk) {
@@ -1058,6 +1047,203 @@ static int WriteInitialHeaderMarker (TRI_datafile_t* datafile,
   return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes the checksum of a compressed datafile header and index
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_voc_crc_t CrcCompressedHeader (TRI_df_compressed_header_t const* header,
+                                          uint64_t const* offsets) {
+  TRI_df_compressed_header_t copy = *header;
+  copy._crc = 0;
+
+  TRI_voc_crc_t crc = TRI_InitialCrc32();
+  crc = TRI_BlockCrc32(crc, (char const*) &copy, sizeof(TRI_df_compressed_header_t));
+  crc = TRI_BlockCrc32(crc, (char const*) offsets, (header->_numberBlocks + 1) * sizeof(uint64_t));
+
+  return TRI_FinalCrc32(crc);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief opens a block-compressed datafile
+///
+/// the blocks are decompressed one after the other into a temporary file next
+/// to the datafile, which is unlinked right away and then mapped like an
+/// uncompressed datafile. the mapped pages are thus backed by a file and can be
+/// dropped from memory. the descriptor of the compressed file is closed, the
+/// datafile owns the descriptor of the temporary file afterwards
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_datafile_t* OpenCompressedDatafile (char const* filename,
+                                               int fd,
+                                               TRI_voc_fid_t fid,
+                                               TRI_voc_size_t fileSize) {
+  TRI_df_compressed_header_t header;
+
+  if (TRI_LSEEK(fd, 0, SEEK_SET) == (TRI_lseek_t) -1 ||
+      ! TRI_ReadPointer(fd, &header, sizeof(TRI_df_compressed_header_t))) {
+    LOG_ERROR("cannot read compressed datafile header from '%s': %s", filename, TRI_last_error());
+
+    TRI_CLOSE(fd);
+    return nullptr;
+  }
+
+  uint64_t const indexSize = ((uint64_t) header._numberBlocks + 1) * sizeof(uint64_t);
+
+  if (header._version != TRI_DF_COMPRESSED_VERSION ||
+      header._blockSize == 0 ||
+      header._size < sizeof(TRI_df_header_marker_t) + sizeof(TRI_df_footer_marker_t) ||
+      header._numberBlocks != (header._size + header._blockSize - 1) / header._blockSize ||
+      sizeof(TRI_df_compressed_header_t) + indexSize > fileSize) {
+    TRI_set_errno(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE);
+    TRI_CLOSE(fd);
+
+    LOG_ERROR("corrupted compressed datafile header read from '%s'", filename);
+    return nullptr;
+  }
+
+  uint64_t* offsets = static_cast<uint64_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, (size_t) indexSize, false));
+
+  if (offsets == nullptr) {
+    TRI_set_errno(TRI_ERROR_OUT_OF_MEMORY);
+    TRI_CLOSE(fd);
+
+    return nullptr;
+  }
+
+  bool ok = TRI_ReadPointer(fd, offsets, (size_t) indexSize);
+
+  if (ok) {
+    ok = (CrcCompressedHeader(&header, offsets) == header._crc &&
+          offsets[0] == sizeof(TRI_df_compressed_header_t) + indexSize &&
+          offsets[header._numberBlocks] == fileSize);
+  }
+
+  size_t maxLength = 0;
+
+  for (uint32_t i = 0; ok && i < header._numberBlocks; ++i) {
+    if (offsets[i + 1] <= offsets[i]) {
+      ok = false;
+    }
+    else if (offsets[i + 1] - offsets[i] > maxLength) {
+      maxLength = (size_t) (offsets[i + 1] - offsets[i]);
+    }
+  }
+
+  if (! ok) {
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, offsets);
+    TRI_set_errno(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE);
+    TRI_CLOSE(fd);
+
+    LOG_ERROR("corrupted block index in compressed datafile '%s'", filename);
+    return nullptr;
+  }
+
+  char* buffer = static_cast<char*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, maxLength, false));
+  char* block = static_cast<char*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, (size_t) header._blockSize, false));
+
+  if (buffer == nullptr || block == nullptr) {
+    if (buffer != nullptr) {
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, buffer);
+    }
+    if (block != nullptr) {
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, block);
+    }
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, offsets);
+    TRI_set_errno(TRI_ERROR_OUT_OF_MEMORY);
+    TRI_CLOSE(fd);
+
+    LOG_ERROR("cannot allocate memory for compressed datafile '%s'", filename);
+    return nullptr;
+  }
+
+  // a left-over of a crash is removed on startup because of its .dead suffix
+  char* tempname = TRI_Concatenate2String(filename, ".dead");
+  TRI_UnlinkFile(tempname);
+
+  int tempFd = CreateSparseFile(tempname, header._size);
+
+  if (tempFd >= 0) {
+    // the file is only accessed via its descriptor, and its blocks are given
+    // back when the descriptor is closed
+    TRI_UnlinkFile(tempname);
+  }
+
+  TRI_FreeString(TRI_CORE_MEM_ZONE, tempname);
+
+  ok = (tempFd >= 0 && TRI_LSEEK(tempFd, 0, SEEK_SET) != (TRI_lseek_t) -1);
+
+  // the blocks are stored back to back, directly after the index
+  for (uint32_t i = 0; ok && i < header._numberBlocks; ++i) {
+    size_t const length = (size_t) (offsets[i + 1] - offsets[i]);
+    size_t const position = (size_t) i * header._blockSize;
+    uLongf expected = (uLongf) (std::min)((size_t) header._blockSize, (size_t) header._size - position);
+    uLongf actual = expected;
+
+    if (! TRI_ReadPointer(fd, buffer, length) ||
+        uncompress((Bytef*) block, &actual, (Bytef const*) buffer, (uLong) length) != Z_OK ||
+        actual != expected) {
+      TRI_set_errno(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE);
+      ok = false;
+    }
+    else if (! TRI_WritePointer(tempFd, block, (size_t) actual)) {
+      ok = false;
+    }
+  }
+
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, block);
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, buffer);
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, offsets);
+  TRI_CLOSE(fd);
+
+  void* data = nullptr;
+  void* mmHandle = nullptr;
+
+  if (ok) {
+    int res = TRI_MMFile(0, header._size, PROT_READ, MAP_SHARED, tempFd, &mmHandle, 0, &data);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      TRI_set_errno(res);
+      ok = false;
+    }
+  }
+
+  if (! ok) {
+    if (tempFd >= 0) {
+      TRI_CLOSE(tempFd);
+    }
+
+    LOG_ERROR("cannot decompress datafile '%s': %s", filename, TRI_last_error());
+    return nullptr;
+  }
+
+  TRI_datafile_t* datafile = static_cast<TRI_datafile_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, sizeof(TRI_datafile_t), false));
+
+  if (datafile == nullptr) {
+    TRI_UNMMFile(data, header._size, tempFd, &mmHandle);
+    TRI_CLOSE(tempFd);
+
+    return nullptr;
+  }
+
+  // the datafile keeps the name of the compressed file
+  InitDatafile(datafile,
+               TRI_DuplicateString(filename),
+               tempFd,
+               mmHandle,
+               header._size,
+               header._size,
+               fid,
+               static_cast<char*>(data));
+
+  datafile->_compressedSize = fileSize;
+
+  // the datafile version determines the checksum algorithm
+  TRI_df_header_marker_t const* marker = reinterpret_cast<TRI_df_header_marker_t const*>(datafile->_data);
+  datafile->_crc32c = (marker->_version == TRI_DF_VERSION_CRC32C);
+
+  return datafile;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief opens a datafile
 ////////////////////////////////////////////////////////////////////////////////
@@ -1110,9 +1296,27 @@ static TRI_datafile_t* OpenDatafile (char const* filename,
     return nullptr;
   }
 
-  // check that file is not too small
   size = static_cast<TRI_voc_size_t>(status.st_size);
 
+  // check whether the file is block-compressed
+  if (size >= sizeof(TRI_df_compressed_header_t)) {
+    uint32_t magic;
+
+    if (! TRI_ReadPointer(fd, &magic, sizeof(magic))) {
+      LOG_ERROR("cannot read datafile header from '%s': %s", filename, TRI_last_error());
+
+      TRI_CLOSE(fd);
+      return nullptr;
+    }
+
+    if (magic == TRI_DF_COMPRESSED_MAGIC) {
+      return OpenCompressedDatafile(filename, fd, fid, size);
+    }
+
+    TRI_LSEEK(fd, 0, SEEK_SET);
+  }
+
+  // check that file is not too small
   if (size < sizeof(TRI_df_header_marker_t) + sizeof(TRI_df_footer_marker_t)) {
     TRI_set_errno(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE);
     TRI_CLOSE(fd);
@@ -1137,8 +1341,11 @@ static TRI_datafile_t* OpenDatafile (char const* filename,
   
   char const* end = static_cast<char const*>(ptr) + len;
 
+  // the datafile version determines the checksum algorithm, even for the header
+  bool const crc32c = (header._version == TRI_DF_VERSION_CRC32C);
+
   // check CRC
-  ok = CheckCrcMarker(&header.base, end);
+  ok = CheckCrcMarker(&header.base, end, crc32c);
 
   if (! ok) {
     TRI_set_errno(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE);
@@ -1153,7 +1360,8 @@ static TRI_datafile_t* OpenDatafile (char const* filename,
 
   // check the datafile version
   if (ok) {
-    if (header._version != TRI_DF_VERSION) {
+    if (header._version != TRI_DF_VERSION_CRC32 &&
+        header._version != TRI_DF_VERSION_CRC32C) {
       TRI_set_errno(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE);
 
       LOG_ERROR("unknown datafile version '%u' in datafile '%s'",
@@ -1205,6 +1413,8 @@ static TRI_datafile_t* OpenDatafile (char const* filename,
                fid,
                static_cast<char*>(data));
 
+  datafile->_crc32c = crc32c;
+
   return datafile;
 }
 
@@ -1796,6 +2006,36 @@ void TRI_UpdateTicksDatafile (TRI_datafile_t* datafile,
   */
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief calculates the checksum of a marker, treating its _crc as 0
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_voc_crc_t TRI_CrcMarkerDatafile (TRI_df_marker_t const* marker,
+                                     bool crc32c) {
+  TRI_voc_size_t zero = 0;
+  off_t o = offsetof(TRI_df_marker_t, _crc);
+  size_t n = sizeof(TRI_voc_crc_t);
+
+  char const* ptr = (char const*) marker;
+
+  TRI_voc_crc_t crc = TRI_InitialCrc32();
+
+  if (crc32c) {
+    crc = TRI_BlockCrc32c(crc, ptr, o);
+    crc = TRI_BlockCrc32c(crc, (char*) &zero, n);
+    crc = TRI_BlockCrc32c(crc, ptr + o + n, marker->_size - o - n);
+  }
+  else {
+    crc = TRI_BlockCrc32(crc, ptr, o);
+    crc = TRI_BlockCrc32(crc, (char*) &zero, n);
+    crc = TRI_BlockCrc32(crc, ptr + o + n, marker->_size - o - n);
+  }
+
+  crc = TRI_FinalCrc32(crc);
+
+  return crc;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief checksums and writes a marker to the datafile
 ////////////////////////////////////////////////////////////////////////////////
@@ -1807,10 +2047,7 @@ int TRI_WriteCrcElementDatafile (TRI_datafile_t* datafile,
   TRI_ASSERT(marker->_tick != 0);
 
   if (datafile->isPhysical(datafile)) {
-    TRI_voc_crc_t crc = TRI_InitialCrc32();
-
-    crc = TRI_BlockCrc32(crc, (char const*) marker, marker->_size);
-    marker->_crc = TRI_FinalCrc32(crc);
+    marker->_crc = TRI_CrcMarkerDatafile(marker, datafile->_crc32c);
   }
 
   return TRI_WriteElementDatafile(datafile, position, marker, forceSync);
@@ -1879,6 +2116,11 @@ TRI_datafile_t* TRI_OpenDatafile (char const* filename,
   // check the datafile by scanning markers
   bool ok = CheckDatafile(datafile, ignoreFailures);
 
+  if (ok && datafile->_compressedSize > 0 && ! datafile->_isSealed) {
+    // only sealed datafiles are compressed, and they cannot be written to
+    ok = false;
+  }
+
   if (! ok) {
     TRI_UNMMFile(datafile->_data, datafile->_maximalSize, datafile->_fd, &datafile->_mmHandle);
     TRI_CLOSE(datafile->_fd);
@@ -1922,7 +2164,7 @@ TRI_datafile_t* TRI_ForcedOpenDatafile (char const* filename) {
 
   // change to read-write if no footer has been found
   else {
-    if (! datafile->_isSealed) {
+    if (! datafile->_isSealed && datafile->_compressedSize == 0) {
       datafile->_state = TRI_DF_STATE_WRITE;
       TRI_ProtectMMFile(datafile->_data, datafile->_maximalSize, PROT_READ | PROT_WRITE, datafile->_fd, &datafile->_mmHandle);
     }
@@ -1998,6 +2240,179 @@ bool TRI_RenameDatafile (TRI_datafile_t* datafile, char const* filename) {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replaces a sealed datafile on disk with a block-compressed copy
+///
+/// the compressed copy is written to a .dead file first, which is removed on
+/// startup if the server stops before the copy replaced the datafile. the
+/// existing memory mapping still refers to the uncompressed file contents
+/// after the replacement
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_CompressDatafile (TRI_datafile_t* datafile) {
+  TRI_ERRORBUF;
+
+  // this function must not be called for non-physical datafiles
+  TRI_ASSERT(datafile->isPhysical(datafile));
+
+  if (datafile->_state != TRI_DF_STATE_READ || ! datafile->_isSealed) {
+    return TRI_set_errno(TRI_ERROR_ARANGO_ILLEGAL_STATE);
+  }
+
+  if (datafile->_compressedSize > 0) {
+    // already compressed
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  TRI_df_compressed_header_t header;
+  header._magic        = TRI_DF_COMPRESSED_MAGIC;
+  header._version      = TRI_DF_COMPRESSED_VERSION;
+  header._blockSize    = TRI_DF_COMPRESSED_BLOCK_SIZE;
+  header._size         = datafile->_currentSize;
+  header._numberBlocks = (header._size + header._blockSize - 1) / header._blockSize;
+  header._crc          = 0;
+
+  size_t const indexSize = ((size_t) header._numberBlocks + 1) * sizeof(uint64_t);
+  uLong const bound = compressBound((uLong) header._blockSize);
+
+  uint64_t* offsets = static_cast<uint64_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, indexSize, false));
+  char* buffer = static_cast<char*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, (size_t) bound, false));
+
+  if (offsets == nullptr || buffer == nullptr) {
+    if (offsets != nullptr) {
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, offsets);
+    }
+    if (buffer != nullptr) {
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, buffer);
+    }
+    datafile->_compressionFailed = TRI_microtime();
+    return TRI_set_errno(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  char* tempname = TRI_Concatenate2String(datafile->_filename, ".dead");
+
+  // remove a left-over from a previous attempt
+  TRI_UnlinkFile(tempname);
+
+  int fd = TRI_CREATE(tempname, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP);
+  int res = TRI_ERROR_NO_ERROR;
+
+  if (fd < 0) {
+    TRI_SYSTEM_ERROR();
+    LOG_ERROR("cannot create compressed datafile '%s': %s", tempname, TRI_GET_ERRORBUF);
+
+    res = TRI_ERROR_SYS_ERROR;
+  }
+  else {
+    uint64_t position = sizeof(TRI_df_compressed_header_t) + indexSize;
+
+    if (TRI_LSEEK(fd, (TRI_lseek_t) position, SEEK_SET) == (TRI_lseek_t) -1) {
+      res = TRI_ERROR_SYS_ERROR;
+    }
+
+    // compress and write the blocks
+    for (uint32_t i = 0; res == TRI_ERROR_NO_ERROR && i < header._numberBlocks; ++i) {
+      size_t const start = (size_t) i * header._blockSize;
+      size_t const length = (std::min)((size_t) header._blockSize, (size_t) header._size - start);
+      uLongf compressed = bound;
+
+      if (compress2((Bytef*) buffer, &compressed, (Bytef const*) datafile->_data + start, (uLong) length, Z_BEST_SPEED) != Z_OK) {
+        res = TRI_ERROR_INTERNAL;
+      }
+      else if (! TRI_WritePointer(fd, buffer, (size_t) compressed)) {
+        res = TRI_ERROR_SYS_ERROR;
+      }
+
+      offsets[i] = position;
+      position += compressed;
+    }
+
+    offsets[header._numberBlocks] = position;
+
+    // now that the positions are known, write the header and the index
+    if (res == TRI_ERROR_NO_ERROR) {
+      header._crc = CrcCompressedHeader(&header, offsets);
+
+      if (TRI_LSEEK(fd, 0, SEEK_SET) == (TRI_lseek_t) -1 ||
+          ! TRI_WritePointer(fd, &header, sizeof(TRI_df_compressed_header_t)) ||
+          ! TRI_WritePointer(fd, offsets, indexSize) ||
+          ! TRI_fsync(fd)) {
+        res = TRI_ERROR_SYS_ERROR;
+      }
+    }
+
+    TRI_CLOSE(fd);
+
+    if (res == TRI_ERROR_NO_ERROR) {
+      // the mapping of the old file stays valid after the rename
+      res = TRI_RenameFile(tempname, datafile->_filename);
+    }
+
+    if (res == TRI_ERROR_NO_ERROR) {
+      datafile->_compressedSize = (TRI_voc_size_t) position;
+
+      LOG_DEBUG("compressed datafile '%s' from %llu to %llu bytes",
+                datafile->getName(datafile),
+                (unsigned long long) header._size,
+                (unsigned long long) position);
+    }
+    else {
+      LOG_ERROR("cannot write compressed datafile '%s': %s", tempname, TRI_errno_string(res));
+      TRI_UnlinkFile(tempname);
+    }
+  }
+
+  TRI_FreeString(TRI_CORE_MEM_ZONE, tempname);
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, buffer);
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, offsets);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    datafile->_compressionFailed = TRI_microtime();
+    return TRI_set_errno(res);
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief gives the operating system a hint about the use of a datafile
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_AdviseDatafile (TRI_datafile_t* datafile,
+                        int advice) {
+  if (datafile->_data == nullptr || datafile->_maximalSize == 0) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  if (advice == TRI_MADVISE_DONTNEED && ! datafile->isPhysical(datafile)) {
+    // the pages are not backed by a file, dropping them would lose data
+    return TRI_ERROR_BAD_PARAMETER;
+  }
+
+  int res = TRI_MMFileAdvise(datafile->_data, datafile->_maximalSize, advice, datafile->_fd, 0);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_DEBUG("cannot advise datafile '%s': %s", datafile->getName(datafile), TRI_last_error());
+  }
+
+  return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the number of bytes of a datafile held in memory
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_ResidentSizeDatafile (TRI_datafile_t const* datafile,
+                              size_t* resident) {
+  *resident = 0;
+
+  if (datafile->_data == nullptr || datafile->_maximalSize == 0) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  return TRI_MMFileResidentSize(datafile->_data, datafile->_maximalSize, resident);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief seals a datafile, writes a footer, sets it to read-only
 ////////////////////////////////////////////////////////////////////////////////
@@ -2135,6 +2550,14 @@ bool TRI_TryRepairDatafile (char const* path) {
   if (datafile == nullptr) {
     return false;
   }
+
+  if (datafile->_compressedSize > 0) {
+    LOG_ERROR("cannot repair compressed datafile '%s'", path);
+
+    TRI_CloseDatafile(datafile);
+    TRI_FreeDatafile(datafile);
+    return false;
+  }
      
   // set to read/write access 
   TRI_ProtectMMFile(datafile->_data, datafile->_maximalSize, PROT_READ | PROT_WRITE, datafile->_fd, &datafile->_mmHandle);
@@ -96,10 +96,22 @@
 // -----------------------------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief datafile version
+/// @brief datafile version with markers checksummed using CRC32
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_DF_VERSION_CRC32    (1)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief datafile version with markers checksummed using CRC32C
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_DF_VERSION_CRC32C   (2)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief datafile version for new datafiles
 ////////////////////////////////////////////////////////////////////////////////
 
-#define TRI_DF_VERSION          (1)
+#define TRI_DF_VERSION          (TRI_DF_VERSION_CRC32C)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief alignment in datafile blocks
@@ -113,6 +125,27 @@
 
 #define TRI_MARKER_MAXIMAL_SIZE (256 * 1024 * 1024)
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief magic number at the start of a block-compressed datafile
+///
+/// the first four bytes of an uncompressed datafile contain the size of its
+/// header marker, which can never be equal to this value
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_DF_COMPRESSED_MAGIC   (0x5a445241)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief version of the block-compressed datafile format
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_DF_COMPRESSED_VERSION (1)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief uncompressed size of a block in a block-compressed datafile
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_DF_COMPRESSED_BLOCK_SIZE (64 * 1024)
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                      public types
 // -----------------------------------------------------------------------------
@@ -286,6 +319,11 @@ typedef struct TRI_datafile_s {
   int _lastError;                // last (critical) error
   bool _full;                    // at least one request was rejected because there is not enough room
   bool _isSealed;                // true, if footer has been written
+  bool _crc32c;                  // markers are checksummed using CRC32C instead of CRC32
+
+  TRI_voc_size_t _compressedSize; // size on disk if the file is block-compressed, 0 otherwise
+  double _compressionFailed;     // time of the last failed compression, 0 if none
+  bool _isCold;                  // pages were dropped from memory, only used by the cleanup
 
   // .............................................................................
   // access to the following attributes must be protected by a _lock
@@ -360,7 +398,10 @@ TRI_df_marker_t;
 ///   <tr>
 ///     <td>TRI_df_version_t</td>
 ///     <td>_version</td>
-///     <td>The version of a datafile, see @ref TRI_df_version_t.</td>
+///     <td>The version of a datafile, see @ref TRI_df_version_t. It also
+///         determines the checksum algorithm of all markers in the datafile,
+///         including the header itself: CRC32 for version 1, CRC32C for
+///         version 2.</td>
 ///   </tr>
 ///   <tr>
 ///     <td>TRI_voc_size_t</td>
@@ -422,6 +463,63 @@ typedef struct TRI_df_footer_marker_s {
 }
 TRI_df_footer_marker_t;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief header of a block-compressed datafile
+///
+/// A sealed datafile can be stored block-compressed on disk. The file then
+/// starts with this header, followed by the block index and the blocks.
+/// Each block holds _blockSize bytes of the uncompressed datafile (the last
+/// one possibly less), compressed with zlib.
+///
+/// <table border>
+///   <tr>
+///     <td>uint32_t</td>
+///     <td>_magic</td>
+///     <td>Always TRI_DF_COMPRESSED_MAGIC.</td>
+///   </tr>
+///   <tr>
+///     <td>uint32_t</td>
+///     <td>_version</td>
+///     <td>The version of the compressed format.</td>
+///   </tr>
+///   <tr>
+///     <td>uint32_t</td>
+///     <td>_blockSize</td>
+///     <td>The uncompressed size of a block.</td>
+///   </tr>
+///   <tr>
+///     <td>uint32_t</td>
+///     <td>_numberBlocks</td>
+///     <td>The number of blocks.</td>
+///   </tr>
+///   <tr>
+///     <td>TRI_voc_size_t</td>
+///     <td>_size</td>
+///     <td>The uncompressed size of the datafile.</td>
+///   </tr>
+///   <tr>
+///     <td>TRI_voc_crc_t</td>
+///     <td>_crc</td>
+///     <td>A CRC32 of the header and the block index. It is computed as if
+///         the field _crc is equal to 0.</td>
+///   </tr>
+/// </table>
+///
+/// The block index consists of _numberBlocks + 1 uint64_t values. Value i is
+/// the position of block i in the file, and the last value is the size of
+/// the file.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct TRI_df_compressed_header_s {
+  uint32_t       _magic;                //  4 bytes
+  uint32_t       _version;              //  4 bytes
+  uint32_t       _blockSize;            //  4 bytes
+  uint32_t       _numberBlocks;         //  4 bytes
+  TRI_voc_size_t _size;                 //  4 bytes
+  TRI_voc_crc_t  _crc;                  //  4 bytes
+}
+TRI_df_compressed_header_t;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief document datafile header marker
 ////////////////////////////////////////////////////////////////////////////////
@@ -681,6 +779,13 @@ int TRI_WriteElementDatafile (TRI_datafile_t* datafile,
                               TRI_df_marker_t const* marker,
                               bool sync) TRI_WARN_UNUSED_RESULT;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief calculates the checksum of a marker, treating its _crc as 0
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_voc_crc_t TRI_CrcMarkerDatafile (TRI_df_marker_t const*,
+                                     bool crc32c);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief checksums and writes a marker to the datafile
 ////////////////////////////////////////////////////////////////////////////////
@@ -737,6 +842,35 @@ int TRI_SealDatafile (TRI_datafile_t* datafile) TRI_WARN_UNUSED_RESULT;
 
 bool TRI_RenameDatafile (TRI_datafile_t* datafile, char const* filename);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replaces a sealed datafile on disk with a block-compressed copy
+///
+/// the datafile stays mapped and can be used as before. when the datafile is
+/// opened the next time, it is decompressed into an unlinked temporary file
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_CompressDatafile (TRI_datafile_t* datafile);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief gives the operating system a hint about the use of a datafile
+///
+/// advice is one of the TRI_MADVISE_* values. TRI_MADVISE_DONTNEED drops the
+/// pages of the datafile from memory. the mapping stays valid, and the pages
+/// are read in again from disk on the next access. this is refused for
+/// anonymous datafiles, whose memory is not backed by a file. the pages of a
+/// compressed datafile are read in again from its decompressed copy
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_AdviseDatafile (TRI_datafile_t* datafile,
+                        int advice);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the number of bytes of a datafile held in memory
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_ResidentSizeDatafile (TRI_datafile_t const* datafile,
+                              size_t* resident);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief truncates a datafile and seals it
 ////////////////////////////////////////////////////////////////////////////////
@@ -34,6 +34,7 @@
 #include "Basics/Exceptions.h"
 #include "Basics/files.h"
 #include "Basics/logging.h"
+#include "Basics/memory-map.h"
 #include "Basics/tri-strings.h"
 #include "Basics/ThreadPool.h"
 #include "FulltextIndex/fulltext-index.h"
@@ -63,6 +64,24 @@
 
 using namespace triagens::arango;
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private constants
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief time after the last lookup until a collection counts as not read by
+/// lookups anymore (in seconds)
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t const RESIDENCY_LOOKUP_WINDOW = 600;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief time after the last scan until a collection counts as not scanned
+/// anymore (in seconds)
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t const RESIDENCY_SCAN_WINDOW = 300;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return a pointer to the beginning of the marker
 ////////////////////////////////////////////////////////////////////////////////
@@ -119,9 +138,24 @@ TRI_document_collection_t::TRI_document_collection_t ()
     _headersPtr(nullptr),
     _keyGenerator(nullptr),
     _uncollectedLogfileEntries(0),
+    _compactionRuns(0),
+    _compactionBytesRead(0),
+    _compactionBytesWritten(0),
+    _compactionTime(0),
     _cleanupIndexes(0) {
 
   _tickMax = 0;
+
+  // all datafiles count as used when the collection is loaded
+  uint32_t const now = static_cast<uint32_t>(TRI_microtime());
+
+  _accessTick = now;
+  _lastLookup = 0;
+  _lastScan   = 0;
+
+  for (size_t i = 0;  i < DatafileAccessSlots;  ++i) {
+    _datafileAccess[i] = now;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -171,6 +205,8 @@ triagens::arango::Index* TRI_document_collection_t::removeIndex (TRI_idx_iid_t i
       if (idx->type() == triagens::arango::Index::TRI_IDX_TYPE_CAP_CONSTRAINT) {
         // unregister cap constraint
         _capConstraint = nullptr;
+        // the order of documents is not needed anymore
+        _headersPtr->disableOrder();
       }
       else if (idx->type() == triagens::arango::Index::TRI_IDX_TYPE_FULLTEXT_INDEX) {
         --_cleanupIndexes;
@@ -2002,6 +2038,11 @@ static TRI_doc_collection_info_t* Figures (TRI_document_collection_t* document)
 
     info->_datafileSize += (int64_t) df->_maximalSize;
     ++info->_numberDatafiles;
+
+    if (df->_compressedSize > 0) {
+      info->_compressedDatafileSize += (int64_t) df->_compressedSize;
+      ++info->_numberCompressedDatafiles;
+    }
   }
 
   for (size_t i = 0; i < base->_journals._length; ++i) {
@@ -2011,6 +2052,29 @@ static TRI_doc_collection_info_t* Figures (TRI_document_collection_t* document)
     ++info->_numberJournalfiles;
   }
 
+  // add the memory residency of datafiles and journals
+  for (size_t i = 0; i < base->_datafiles._length; ++i) {
+    TRI_datafile_t* df = (TRI_datafile_t*) base->_datafiles._buffer[i];
+    size_t resident;
+
+    if (TRI_ResidentSizeDatafile(df, &resident) == TRI_ERROR_NO_ERROR) {
+      info->_datafileResidentSize += (int64_t) resident;
+    }
+
+    if (df->_isCold) {
+      ++info->_numberColdDatafiles;
+    }
+  }
+
+  for (size_t i = 0; i < base->_journals._length; ++i) {
+    TRI_datafile_t* df = (TRI_datafile_t*) base->_journals._buffer[i];
+    size_t resident;
+
+    if (TRI_ResidentSizeDatafile(df, &resident) == TRI_ERROR_NO_ERROR) {
+      info->_journalResidentSize += (int64_t) resident;
+    }
+  }
+
   for (size_t i = 0; i < base->_compactors._length; ++i) {
     TRI_datafile_t* df = (TRI_datafile_t*) base->_compactors._buffer[i];
 
@@ -2034,6 +2098,11 @@ static TRI_doc_collection_info_t* Figures (TRI_document_collection_t* document)
   info->_uncollectedLogfileEntries = document->_uncollectedLogfileEntries;
   info->_tickMax = document->_tickMax;
 
+  info->_compactionRuns         = document->_compactionRuns.load();
+  info->_compactionBytesRead    = document->_compactionBytesRead.load();
+  info->_compactionBytesWritten = document->_compactionBytesWritten.load();
+  info->_compactionTime         = (double) document->_compactionTime.load() / 1000000.0;
+
   return info;
 }
 
@@ -3110,6 +3179,11 @@ TRI_document_collection_t* TRI_OpenDocumentCollection (TRI_vocbase_t* vocbase,
     }
   }
 
+  // new documents go into the journals
+  for (size_t i = 0;  i < collection->_journals._length;  ++i) {
+    TRI_AdviseDatafile(static_cast<TRI_datafile_t*>(collection->_journals._buffer[i]), TRI_MADVISE_WILLNEED);
+  }
+
   TRI_ASSERT(document->getShaper() != nullptr);  // ONLY in OPENCOLLECTION, PROTECTED by fake trx here
 
   TRI_InitVocShaper(document->getShaper());  // ONLY in OPENCOLLECTION, PROTECTED by fake trx here
@@ -3226,6 +3300,27 @@ static int FillIndex (TRI_document_collection_t* document,
     // give the index a size hint
     idx->sizeHint(static_cast<size_t>(primaryIndex->_nrUsed));
 
+    if (idx->hasBatchInsert()) {
+      // collect all documents and hand them to the index in one batch, this
+      // allows the index to build its structures in bulk
+      std::vector<TRI_doc_mptr_t const*> documents;
+      documents.reserve(static_cast<size_t>(primaryIndex->_nrUsed));
+
+      for (;  ptr < end;  ++ptr) {
+        auto mptr = static_cast<TRI_doc_mptr_t const*>(*ptr);
+
+        if (mptr != nullptr) {
+          documents.emplace_back(mptr);
+        }
+      }
+
+      LOG_TRACE("indexing %llu documents of collection %llu",
+                (unsigned long long) documents.size(),
+                (unsigned long long) document->_info._cid);
+
+      return idx->batchInsert(documents);
+    }
+
 #ifdef TRI_ENABLE_MAINTAINER_MODE
     static const int LoopSize = 10000;
     int counter = 0;
@@ -4953,6 +5048,83 @@ int TRI_RotateJournalDocumentCollection (TRI_document_collection_t* document) {
   return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief manage the memory residency of the datafiles of a collection
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_ManageResidencyDocumentCollection (TRI_document_collection_t* document,
+                                              double coldTime) {
+  size_t numCold = 0;
+  uint32_t const now = static_cast<uint32_t>(TRI_microtime());
+
+  document->_accessTick = now;
+
+  // collections that were read by lookups recently, but not scanned, don't
+  // benefit from readahead
+  uint32_t const lastLookup = document->_lastLookup.load(std::memory_order_relaxed);
+  uint32_t const lastScan   = document->_lastScan.load(std::memory_order_relaxed);
+
+  int advice = TRI_MADVISE_NORMAL;
+
+  if (lastLookup > 0 &&
+      now - lastLookup < RESIDENCY_LOOKUP_WINDOW &&
+      (lastScan == 0 || now - lastScan >= RESIDENCY_SCAN_WINDOW)) {
+    advice = TRI_MADVISE_RANDOM;
+  }
+
+  TRI_READ_LOCK_DATAFILES_DOC_COLLECTION(document);
+
+  size_t const n = document->_datafiles._length;
+
+  for (size_t i = 0;  i < n;  ++i) {
+    auto df = static_cast<TRI_datafile_t*>(document->_datafiles._buffer[i]);
+
+    if (! df->isPhysical(df)) {
+      // memory is not backed by a file
+      continue;
+    }
+
+    auto& slot = document->_datafileAccess[df->_fid % TRI_document_collection_t::DatafileAccessSlots];
+
+    if (df->_isCold) {
+      size_t resident;
+
+      if (TRI_ResidentSizeDatafile(df, &resident) != TRI_ERROR_NO_ERROR ||
+          resident == 0) {
+        ++numCold;
+        continue;
+      }
+
+      // pages were read in again. not all accesses are recorded, so this
+      // counts as an access too
+      df->_isCold = false;
+      document->stampAccess(slot);
+
+      LOG_DEBUG("datafile '%s' is used again", df->getName(df));
+    }
+
+    uint32_t const lastAccess = slot.load(std::memory_order_relaxed);
+
+    if (coldTime > 0.0 && lastAccess < now && (double) (now - lastAccess) >= coldTime) {
+      if (TRI_AdviseDatafile(df, TRI_MADVISE_DONTNEED) == TRI_ERROR_NO_ERROR) {
+        df->_isCold = true;
+        ++numCold;
+
+        LOG_DEBUG("dropped cold datafile '%s' from memory, last access %llu s ago",
+                  df->getName(df),
+                  (unsigned long long) (now - lastAccess));
+      }
+      continue;
+    }
+
+    TRI_AdviseDatafile(df, advice);
+  }
+
+  TRI_READ_UNLOCK_DATAFILES_DOC_COLLECTION(document);
+
+  return numCold;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                      CRUD methods
 // -----------------------------------------------------------------------------
@@ -4991,6 +5163,8 @@ int TRI_ReadShapedJsonDocumentCollection (TRI_transaction_collection_t* trxColle
 
     // we found a document, now copy it over
     *mptr = *header;
+
+    document->touchLookup(header->_fid);
   }
 
   TRI_ASSERT(mptr->getDataPtr() != nullptr);  // PROTECTED by trx in trxCollection
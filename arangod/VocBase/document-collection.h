@@ -123,14 +123,17 @@ class KeyGenerator;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief master pointer
+///
+/// there is one master pointer per document, so it is kept as small as
+/// possible. it does not have any virtual methods (apart from in maintainer
+/// mode) and does not link to other master pointers. the order of insertion
+/// is tracked separately by the headers, and only if required
 ////////////////////////////////////////////////////////////////////////////////
 
 struct TRI_doc_mptr_t {
     TRI_voc_rid_t          _rid;     // this is the revision identifier
     TRI_voc_fid_t          _fid;     // this is the datafile identifier
     uint64_t               _hash;    // the pre-calculated hash value of the key
-    TRI_doc_mptr_t*        _prev;    // previous master pointer
-    TRI_doc_mptr_t*        _next;    // next master pointer
   protected:
     void const*            _dataptr; // this is the pointer to the beginning of the raw marker
 
@@ -138,21 +141,19 @@ struct TRI_doc_mptr_t {
     TRI_doc_mptr_t () : _rid(0), 
                         _fid(0), 
                         _hash(0),
-                        _prev(nullptr),
-                        _next(nullptr),
                         _dataptr(nullptr) {
     }
 
+#ifdef TRI_ENABLE_MAINTAINER_MODE
     virtual ~TRI_doc_mptr_t () {
     }
+#endif
 
     void clear () {
       _rid = 0;
       _fid = 0;
       setDataPtr(nullptr);
       _hash = 0;
-      _prev = nullptr;
-      _next = nullptr;
     }
 
     void copy (TRI_doc_mptr_t const& that) {
@@ -161,8 +162,6 @@ struct TRI_doc_mptr_t {
       _fid = that._fid;
       _dataptr = that._dataptr;
       _hash = that._hash;
-      _prev = that._prev;
-      _next = that._next;
     }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -222,6 +221,10 @@ struct TRI_doc_mptr_t {
 
 };
 
+#ifndef TRI_ENABLE_MAINTAINER_MODE
+static_assert(sizeof(TRI_doc_mptr_t) <= 32, "invalid size of TRI_doc_mptr_t");
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief A derived class for copies of master pointers, they
 ////////////////////////////////////////////////////////////////////////////////
@@ -315,6 +318,7 @@ typedef struct TRI_doc_collection_info_s {
   TRI_voc_ssize_t _numberJournalfiles;
   TRI_voc_ssize_t _numberCompactorfiles;
   TRI_voc_ssize_t _numberShapefiles;
+  TRI_voc_ssize_t _numberCompressedDatafiles;
 
   TRI_voc_ssize_t _numberAlive;
   TRI_voc_ssize_t _numberDead;
@@ -335,9 +339,19 @@ typedef struct TRI_doc_collection_info_s {
   int64_t         _journalfileSize;
   int64_t         _compactorfileSize;
   int64_t         _shapefileSize;
+  int64_t         _compressedDatafileSize;
+
+  int64_t         _datafileResidentSize;
+  int64_t         _journalResidentSize;
+  TRI_voc_ssize_t _numberColdDatafiles;
 
   TRI_voc_tick_t  _tickMax;
   uint64_t        _uncollectedLogfileEntries;
+
+  uint64_t        _compactionRuns;
+  uint64_t        _compactionBytesRead;
+  uint64_t        _compactionBytesWritten;
+  double          _compactionTime;
 }
 TRI_doc_collection_info_t;
 
@@ -399,6 +413,44 @@ public:
     return &_ditches;
   }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief record that a document from a datafile was read by key or by index
+////////////////////////////////////////////////////////////////////////////////
+
+  inline void touchLookup (TRI_voc_fid_t fid) const {
+    stampAccess(_datafileAccess[fid % DatafileAccessSlots]);
+    stampAccess(_lastLookup);
+  }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief record that the collection is being scanned
+////////////////////////////////////////////////////////////////////////////////
+
+  inline void touchScan () const {
+    stampAccess(_lastScan);
+  }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief record that a document from a datafile was read by a scan
+////////////////////////////////////////////////////////////////////////////////
+
+  inline void touchDatafile (TRI_voc_fid_t fid) const {
+    stampAccess(_datafileAccess[fid % DatafileAccessSlots]);
+  }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stamp an access slot with the current access tick
+////////////////////////////////////////////////////////////////////////////////
+
+  inline void stampAccess (std::atomic<uint32_t>& slot) const {
+    // only write if the value changes, to keep the cache line shared
+    uint32_t const tick = _accessTick.load(std::memory_order_relaxed);
+
+    if (slot.load(std::memory_order_relaxed) != tick) {
+      slot.store(tick, std::memory_order_relaxed);
+    }
+  }
+
   mutable triagens::arango::Ditches      _ditches;
   TRI_associative_pointer_t              _datafileInfo;
 
@@ -414,6 +466,24 @@ public:
   TRI_read_write_lock_t                  _compactionLock;
   double                                 _lastCompaction;
 
+  // compaction statistics, only modified by the compactor
+  std::atomic<uint64_t>                  _compactionRuns;
+  std::atomic<uint64_t>                  _compactionBytesRead;
+  std::atomic<uint64_t>                  _compactionBytesWritten;
+  std::atomic<uint64_t>                  _compactionTime;  // in microseconds
+
+  // datafile residency, see TRI_ManageResidencyDocumentCollection. readers
+  // stamp the slot of the datafile they read from with the access tick,
+  // which is advanced by the cleanup. datafiles are mapped to slots by their
+  // fid, so datafiles sharing a slot may look more recently used than they
+  // are, but never less
+  static size_t const                    DatafileAccessSlots = 64;
+
+  mutable std::atomic<uint32_t>          _accessTick;  // in seconds
+  mutable std::atomic<uint32_t>          _datafileAccess[DatafileAccessSlots];
+  mutable std::atomic<uint32_t>          _lastLookup;
+  mutable std::atomic<uint32_t>          _lastScan;
+
   // ...........................................................................
   // this condition variable protects the _journalsCondition
   // ...........................................................................
@@ -1081,6 +1151,20 @@ int TRI_DeleteDocumentDocumentCollection (struct TRI_transaction_collection_s*,
 
 int TRI_RotateJournalDocumentCollection (TRI_document_collection_t*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief manage the memory residency of the datafiles of a collection
+///
+/// sealed datafiles that were not read for the given number of seconds are
+/// dropped from memory. their mappings stay valid, and pages are read in
+/// again from disk when the datafile is accessed next. a cold time of 0
+/// turns this off. datafiles of collections that are only read by key or
+/// index lookups are marked for random access, which turns off readahead.
+/// returns the number of datafiles that are cold afterwards
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_ManageResidencyDocumentCollection (TRI_document_collection_t*,
+                                              double);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                      CRUD methods
 // -----------------------------------------------------------------------------
@@ -56,7 +56,7 @@ static inline size_t GetBlockSize (size_t blockNumber) {
   }
 
   // use a block size of 32768
-  // this will use 32768 * sizeof(TRI_doc_mptr_t) bytes, i.e. 1.5 MB
+  // this will use 32768 * sizeof(TRI_doc_mptr_t) bytes, i.e. 1 MB
   return (size_t) (BLOCK_SIZE_UNIT << 8);
 }
 
@@ -70,11 +70,12 @@ static inline size_t GetBlockSize (size_t blockNumber) {
 
 TRI_headers_t::TRI_headers_t ()
   : _freelist(nullptr),
-    _begin(nullptr),
-    _end(nullptr),
     _nrAllocated(0),
     _nrLinked(0),
-    _totalSize(0) {
+    _totalSize(0),
+    _links(nullptr),
+    _begin(nullptr),
+    _end(nullptr) {
 
   TRI_InitVectorPointer(&_blocks, TRI_UNKNOWN_MEM_ZONE, 16);
 }
@@ -84,6 +85,8 @@ TRI_headers_t::TRI_headers_t ()
 ////////////////////////////////////////////////////////////////////////////////
 
 TRI_headers_t::~TRI_headers_t () {
+  delete _links;
+
   for (size_t i = 0;  i < _blocks._length;  ++i) {
     delete[] static_cast<TRI_doc_mptr_t*>(_blocks._buffer[i]);
   }
@@ -96,12 +99,12 @@ TRI_headers_t::~TRI_headers_t () {
 // -----------------------------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief moves an existing header to the end of the list
+/// @brief accounts for an updated header and moves it to the end of the order
 /// this is called when there is an update operation on a document
 ////////////////////////////////////////////////////////////////////////////////
 
 void TRI_headers_t::moveBack (TRI_doc_mptr_t* header,
-                              TRI_doc_mptr_t* old) {
+                              TRI_doc_mptr_t const* old) {
   if (header == nullptr) {
     return;
   }
@@ -110,12 +113,6 @@ void TRI_headers_t::moveBack (TRI_doc_mptr_t* header,
   TRI_ASSERT(_nrLinked > 0);
   TRI_ASSERT(_totalSize > 0);
 
-  // we have at least one element in the list
-  TRI_ASSERT(_begin != nullptr);
-  TRI_ASSERT(_end != nullptr);
-  TRI_ASSERT(header->_prev != header);
-  TRI_ASSERT(header->_next != header);
-
   TRI_ASSERT(old != nullptr);
   TRI_ASSERT(old->getDataPtr() != nullptr);  // ONLY IN HEADERS, PROTECTED by RUNTIME
 
@@ -126,42 +123,16 @@ void TRI_headers_t::moveBack (TRI_doc_mptr_t* header,
   _totalSize += (  TRI_DF_ALIGN_BLOCK(newSize)
                  - TRI_DF_ALIGN_BLOCK(oldSize));
 
-  if (_end == header) {
-    // header is already at the end
-    TRI_ASSERT(header->_next == nullptr);
-    return;
-  }
-
-  TRI_ASSERT(_begin != _end);
-
-  // unlink the element
-  if (header->_prev != nullptr) {
-    header->_prev->_next = header->_next;
-  }
-  if (header->_next != nullptr) {
-    header->_next->_prev = header->_prev;
-  }
+  TRI_ASSERT(_totalSize > 0);
 
-  if (_begin == header) {
-    TRI_ASSERT(header->_next != nullptr);
-    _begin = header->_next;
+  if (_links != nullptr && _end != header) {
+    removeOrder(header);
+    appendOrder(header);
   }
-
-  header->_prev   = _end;
-  header->_next   = nullptr;
-  _end            = header;
-  header->_prev->_next = header;
-
-  TRI_ASSERT(_begin != nullptr);
-  TRI_ASSERT(_end != nullptr);
-  TRI_ASSERT(header->_prev != header);
-  TRI_ASSERT(header->_next != header);
-
-  TRI_ASSERT(_totalSize > 0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief unlinks a header from the linked list, without freeing it
+/// @brief unlinks a header, without freeing it
 ////////////////////////////////////////////////////////////////////////////////
 
 void TRI_headers_t::unlink (TRI_doc_mptr_t* header) {
@@ -169,33 +140,14 @@ void TRI_headers_t::unlink (TRI_doc_mptr_t* header) {
 
   TRI_ASSERT(header != nullptr);
   TRI_ASSERT(header->getDataPtr() != nullptr); // ONLY IN HEADERS, PROTECTED by RUNTIME
-  TRI_ASSERT(header->_prev != header);
-  TRI_ASSERT(header->_next != header);
 
   size = (int64_t) ((TRI_df_marker_t*) header->getDataPtr())->_size; // ONLY IN HEADERS, PROTECTED by RUNTIME
   TRI_ASSERT(size > 0);
 
-  // unlink the header
-  if (header->_prev != nullptr) {
-    header->_prev->_next = header->_next;
+  if (_links != nullptr) {
+    removeOrder(header);
   }
 
-  if (header->_next != nullptr) {
-    header->_next->_prev = header->_prev;
-  }
-
-  // adjust begin & end pointers
-  if (_begin == header) {
-    _begin = header->_next;
-  }
-
-  if (_end == header) {
-    _end = header->_prev;
-  }
-
-  TRI_ASSERT(_begin != header);
-  TRI_ASSERT(_end != header);
-
   TRI_ASSERT(_nrLinked > 0);
   _nrLinked--;
   _totalSize -= TRI_DF_ALIGN_BLOCK(size);
@@ -206,29 +158,22 @@ void TRI_headers_t::unlink (TRI_doc_mptr_t* header) {
     TRI_ASSERT(_totalSize == 0);
   }
   else {
-    TRI_ASSERT(_begin != nullptr);
-    TRI_ASSERT(_end != nullptr);
     TRI_ASSERT(_totalSize > 0);
   }
-
-  TRI_ASSERT(header->_prev != header);
-  TRI_ASSERT(header->_next != header);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief moves a header around in the list, using its previous position
+/// @brief moves a header back to the position of its previous revision
 /// (specified in "old"), note that this is only used in revert operations
 ////////////////////////////////////////////////////////////////////////////////
 
 void TRI_headers_t::move (TRI_doc_mptr_t* header,
-                          TRI_doc_mptr_t* old) {
+                          TRI_doc_mptr_t const* old) {
   if (header == nullptr) {
     return;
   }
 
   TRI_ASSERT(_nrAllocated > 0);
-  TRI_ASSERT(header->_prev != header);
-  TRI_ASSERT(header->_next != header);
   TRI_ASSERT(header->getDataPtr() != nullptr); // ONLY IN HEADERS, PROTECTED by RUNTIME
   TRI_ASSERT(((TRI_df_marker_t*) header->getDataPtr())->_size > 0); // ONLY IN HEADERS, PROTECTED by RUNTIME
   TRI_ASSERT(old != nullptr);
@@ -244,55 +189,25 @@ void TRI_headers_t::move (TRI_doc_mptr_t* header,
   _totalSize -= (  TRI_DF_ALIGN_BLOCK(newSize)
                  - TRI_DF_ALIGN_BLOCK(oldSize));
 
-  // adjust list start and end pointers
-  if (old->_prev == nullptr) {
-    _begin = header;
-  }
-  else if (_begin == header) {
-    if (old->_prev != nullptr) {
-      _begin = old->_prev;
-    }
-  }
+  if (_links != nullptr) {
+    removeOrder(header);
 
-  if (old->_next == nullptr) {
-    _end = header;
-  }
-  else if (_end == header) {
-    if (old->_next != nullptr) {
-      _end = old->_next;
+    try {
+      insertOrder(header, old->_rid);
+    }
+    catch (...) {
+      // out of memory. the header will not take part in the order
     }
   }
-
-  if (header->_prev != nullptr) {
-    header->_prev->_next = header->_next;
-  }
-  if (header->_next != nullptr) {
-    header->_next->_prev = header->_prev;
-  }
-
-  if (old->_prev != nullptr) {
-    old->_prev->_next = header;
-  }
-  if (old->_next != nullptr) {
-    old->_next->_prev = header;
-  }
-
-  header->_prev = old->_prev;
-  header->_next = old->_next;
-
-  TRI_ASSERT(_begin != nullptr);
-  TRI_ASSERT(_end != nullptr);
-  TRI_ASSERT(header->_prev != header);
-  TRI_ASSERT(header->_next != header);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief moves a header back into the list, using its previous position
+/// @brief relinks a header, using the position of its previous revision
 /// (specified in "old")
 ////////////////////////////////////////////////////////////////////////////////
 
 void TRI_headers_t::relink (TRI_doc_mptr_t* header,
-                            TRI_doc_mptr_t* old) {
+                            TRI_doc_mptr_t const* old) {
   if (header == nullptr) {
     return;
   }
@@ -302,16 +217,20 @@ void TRI_headers_t::relink (TRI_doc_mptr_t* header,
   int64_t size = (int64_t) ((TRI_df_marker_t*) header->getDataPtr())->_size; // ONLY IN HEADERS, PROTECTED by RUNTIME
   TRI_ASSERT(size > 0);
 
-  TRI_ASSERT(_begin != header);
-  TRI_ASSERT(_end != header);
+  TRI_ASSERT(old != nullptr);
+
+  if (_links != nullptr) {
+    try {
+      insertOrder(header, old->_rid);
+    }
+    catch (...) {
+      // out of memory. the header will not take part in the order
+    }
+  }
 
-  this->move(header, old);
   _nrLinked++;
   _totalSize += TRI_DF_ALIGN_BLOCK(size);
   TRI_ASSERT(_totalSize > 0);
-
-  TRI_ASSERT(header->_prev != header);
-  TRI_ASSERT(header->_next != header);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -360,34 +279,18 @@ TRI_doc_mptr_t* TRI_headers_t::request (size_t size) {
   TRI_doc_mptr_t* result = const_cast<TRI_doc_mptr_t*>(_freelist);
   TRI_ASSERT(result != nullptr);
 
-  _freelist = static_cast<TRI_doc_mptr_t const*>(result->getDataPtr()); // ONLY IN HEADERS, PROTECTED by RUNTIME
-  result->setDataPtr(nullptr); // ONLY IN HEADERS
-
-  // put new header at the end of the list
-  if (_begin == nullptr) {
-    // list of headers is empty
-    TRI_ASSERT(_nrLinked == 0);
-    TRI_ASSERT(_totalSize == 0);
-
-    _begin = result;
-    _end   = result;
-
-    result->_prev   = nullptr;
-    result->_next   = nullptr;
+  if (_links != nullptr) {
+    try {
+      appendOrder(result);
+    }
+    catch (...) {
+      TRI_set_errno(TRI_ERROR_OUT_OF_MEMORY);
+      return nullptr;
+    }
   }
-  else {
-    // list is not empty
-    TRI_ASSERT(_nrLinked > 0);
-    TRI_ASSERT(_totalSize > 0);
-    TRI_ASSERT(_nrAllocated > 0);
-    TRI_ASSERT(_begin != nullptr);
-    TRI_ASSERT(_end != nullptr);
 
-    _end->_next   = result;
-    result->_prev = _end;
-    result->_next = nullptr;
-    _end          = result;
-  }
+  _freelist = static_cast<TRI_doc_mptr_t const*>(result->getDataPtr()); // ONLY IN HEADERS, PROTECTED by RUNTIME
+  result->setDataPtr(nullptr); // ONLY IN HEADERS
 
   _nrAllocated++;
   _nrLinked++;
@@ -432,8 +335,6 @@ void TRI_headers_t::release (TRI_doc_mptr_t* header,
     // set length to 0
     _blocks._length = 0;
     _freelist = nullptr;
-    _begin = nullptr;
-    _end = nullptr;
   }
 }
 
@@ -451,6 +352,175 @@ void TRI_headers_t::adjustTotalSize (int64_t oldSize,
                  - TRI_DF_ALIGN_BLOCK(newSize));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief start tracking the order of insertion/update of the headers
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_headers_t::enableOrder (std::vector<TRI_doc_mptr_t*>& headers) {
+  if (_links != nullptr) {
+    // already tracked
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  // revision ids are increasing, so ordering by them restores the order in
+  // which the documents were inserted or last updated
+  std::sort(headers.begin(), headers.end(), [] (TRI_doc_mptr_t const* lhs, TRI_doc_mptr_t const* rhs) {
+    return lhs->_rid < rhs->_rid;
+  });
+
+  try {
+    _links = new std::unordered_map<TRI_doc_mptr_t const*, Links>();
+    _links->reserve(headers.size());
+
+    for (auto& it : headers) {
+      appendOrder(it);
+    }
+  }
+  catch (...) {
+    disableOrder();
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stop tracking the order of insertion/update of the headers
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_headers_t::disableOrder () {
+  delete _links;
+  _links = nullptr;
+  _begin = nullptr;
+  _end = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the successor of a header in the order
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_doc_mptr_t* TRI_headers_t::next (TRI_doc_mptr_t const* header) const {
+  TRI_ASSERT(_links != nullptr);
+
+  auto it = _links->find(header);
+
+  if (it == _links->end()) {
+    return nullptr;
+  }
+
+  return (*it).second._next;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the predecessor of a header in the order
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_doc_mptr_t* TRI_headers_t::prev (TRI_doc_mptr_t const* header) const {
+  TRI_ASSERT(_links != nullptr);
+
+  auto it = _links->find(header);
+
+  if (it == _links->end()) {
+    return nullptr;
+  }
+
+  return (*it).second._prev;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append a header to the end of the order
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_headers_t::appendOrder (TRI_doc_mptr_t* header) {
+  TRI_ASSERT(_links != nullptr);
+  TRI_ASSERT(_links->find(header) == _links->end());
+
+  _links->emplace(header, Links{ _end, nullptr });
+
+  if (_end == nullptr) {
+    TRI_ASSERT(_begin == nullptr);
+    _begin = header;
+  }
+  else {
+    (*_links)[_end]._next = header;
+  }
+
+  _end = header;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief insert a header into the order, at the position of a revision id
+///
+/// the order is searched backwards from its end, as reverted operations
+/// usually concern recent revisions
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_headers_t::insertOrder (TRI_doc_mptr_t* header,
+                                 TRI_voc_rid_t rid) {
+  TRI_ASSERT(_links != nullptr);
+
+  TRI_doc_mptr_t* prev = _end;
+
+  while (prev != nullptr && prev->_rid > rid) {
+    prev = (*_links)[prev]._prev;
+  }
+
+  TRI_doc_mptr_t* next = (prev == nullptr ? _begin : (*_links)[prev]._next);
+
+  _links->emplace(header, Links{ prev, next });
+
+  if (prev == nullptr) {
+    _begin = header;
+  }
+  else {
+    (*_links)[prev]._next = header;
+  }
+
+  if (next == nullptr) {
+    _end = header;
+  }
+  else {
+    (*_links)[next]._prev = header;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove a header from the order
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_headers_t::removeOrder (TRI_doc_mptr_t* header) {
+  TRI_ASSERT(_links != nullptr);
+
+  auto it = _links->find(header);
+
+  if (it == _links->end()) {
+    return;
+  }
+
+  Links links = (*it).second;
+  _links->erase(it);
+
+  if (links._prev == nullptr) {
+    TRI_ASSERT(_begin == header);
+    _begin = links._next;
+  }
+  else {
+    (*_links)[links._prev]._next = links._next;
+  }
+
+  if (links._next == nullptr) {
+    TRI_ASSERT(_end == header);
+    _end = links._prev;
+  }
+  else {
+    (*_links)[links._next]._prev = links._prev;
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
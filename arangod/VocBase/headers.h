@@ -32,6 +32,7 @@
 
 #include "Basics/Common.h"
 #include "Basics/vector.h"
+#include "VocBase/voc-types.h"
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                              forward declarations
@@ -70,29 +71,29 @@ class TRI_headers_t {
   public:
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief move an existing header to the end of the linked list
+/// @brief account for an updated header, moving it to the end of the order
 ////////////////////////////////////////////////////////////////////////////////
 
-    void moveBack (struct TRI_doc_mptr_t*, struct TRI_doc_mptr_t*);
+    void moveBack (struct TRI_doc_mptr_t*, struct TRI_doc_mptr_t const*);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief unlink an existing header from the linked list, without freeing it
+/// @brief unlink an existing header, without freeing it
 ////////////////////////////////////////////////////////////////////////////////
 
     void unlink (struct TRI_doc_mptr_t*);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief move an existing header to another position in the linked list
+/// @brief revert the update of a header, moving it back to the position of
+/// its previous revision
 ////////////////////////////////////////////////////////////////////////////////
 
-    void move (struct TRI_doc_mptr_t*, struct TRI_doc_mptr_t*);
+    void move (struct TRI_doc_mptr_t*, struct TRI_doc_mptr_t const*);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief relink an existing header into the linked list, at its original
-/// position
+/// @brief relink an existing header, at its original position
 ////////////////////////////////////////////////////////////////////////////////
 
-    void relink (struct TRI_doc_mptr_t*, struct TRI_doc_mptr_t*);
+    void relink (struct TRI_doc_mptr_t*, struct TRI_doc_mptr_t const*);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief request a new header
@@ -114,9 +115,35 @@ class TRI_headers_t {
     void adjustTotalSize (int64_t, int64_t);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief return the element at the head of the list
+/// @brief start tracking the order of insertion/update of the headers
 ///
-/// note: the element returned might be nullptr
+/// the headers passed are the currently linked headers. they are put into
+/// order by their revision ids. the order is only maintained for collections
+/// that need it (i.e. collections with a cap constraint), as it costs extra
+/// memory per header
+////////////////////////////////////////////////////////////////////////////////
+
+    int enableOrder (std::vector<struct TRI_doc_mptr_t*>&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stop tracking the order of insertion/update of the headers
+////////////////////////////////////////////////////////////////////////////////
+
+    void disableOrder ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the order of headers is tracked
+////////////////////////////////////////////////////////////////////////////////
+
+    inline bool hasOrder () const {
+      return _links != nullptr;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the element at the head of the order
+///
+/// note: the element returned might be nullptr, it is always nullptr if the
+/// order is not tracked
 ////////////////////////////////////////////////////////////////////////////////
 
     inline struct TRI_doc_mptr_t* front () const {
@@ -124,15 +151,28 @@ class TRI_headers_t {
     }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief return the element at the tail of the list
+/// @brief return the element at the tail of the order
 ///
-/// note: the element returned might be nullptr
+/// note: the element returned might be nullptr, it is always nullptr if the
+/// order is not tracked
 ////////////////////////////////////////////////////////////////////////////////
 
     inline struct TRI_doc_mptr_t* back () const {
       return _end;
     }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the successor of a header in the order
+////////////////////////////////////////////////////////////////////////////////
+
+    struct TRI_doc_mptr_t* next (struct TRI_doc_mptr_t const*) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the predecessor of a header in the order
+////////////////////////////////////////////////////////////////////////////////
+
+    struct TRI_doc_mptr_t* prev (struct TRI_doc_mptr_t const*) const;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the number of active headers
 ////////////////////////////////////////////////////////////////////////////////
@@ -149,6 +189,45 @@ class TRI_headers_t {
       return _totalSize;
     }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+  private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append a header to the end of the order
+////////////////////////////////////////////////////////////////////////////////
+
+    void appendOrder (struct TRI_doc_mptr_t*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief insert a header into the order, at the position of a revision id
+////////////////////////////////////////////////////////////////////////////////
+
+    void insertOrder (struct TRI_doc_mptr_t*, TRI_voc_rid_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove a header from the order
+////////////////////////////////////////////////////////////////////////////////
+
+    void removeOrder (struct TRI_doc_mptr_t*);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     private types
+// -----------------------------------------------------------------------------
+
+  private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief position of a header in the order
+////////////////////////////////////////////////////////////////////////////////
+
+    struct Links {
+      TRI_doc_mptr_t*      _prev;
+      TRI_doc_mptr_t*      _next;
+    };
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
@@ -157,13 +236,15 @@ class TRI_headers_t {
 
     TRI_doc_mptr_t const*  _freelist;    // free headers
 
-    TRI_doc_mptr_t*        _begin;       // start pointer to list of allocated headers
-    TRI_doc_mptr_t*        _end;         // end pointer to list of allocated headers
     size_t                 _nrAllocated; // number of allocated headers
     size_t                 _nrLinked;    // number of linked headers
     int64_t                _totalSize;   // total size of markers for linked headers
 
     TRI_vector_pointer_t   _blocks;
+
+    std::unordered_map<TRI_doc_mptr_t const*, Links>* _links; // order of headers, optional
+    TRI_doc_mptr_t*        _begin;       // first header in order
+    TRI_doc_mptr_t*        _end;         // last header in order
 };
 
 #endif
@@ -1706,6 +1706,7 @@ TRI_server_t* TRI_CreateServer () {
 int TRI_InitServer (TRI_server_t* server,
                     void* applicationEndpointServer,
                     void* indexPool,
+                    void* maintenanceScheduler,
                     char const* basePath,
                     char const* appPath,
                     TRI_vocbase_defaults_t const* defaults,
@@ -1723,6 +1724,8 @@ int TRI_InitServer (TRI_server_t* server,
 
   server->_indexPool                 = indexPool;
 
+  server->_maintenanceScheduler      = maintenanceScheduler;
+
   // .............................................................................
   // set up paths and filenames
   // .............................................................................
@@ -61,6 +61,7 @@ typedef struct TRI_server_s {
   TRI_vocbase_defaults_t      _defaults;
   void*                       _applicationEndpointServer; // ptr to C++ object
   void*                       _indexPool;                 // ptr to C++ object
+  void*                       _maintenanceScheduler;      // ptr to C++ object
 
   char*                       _basePath;
   char*                       _databasePath;
@@ -99,6 +100,7 @@ TRI_server_t* TRI_CreateServer (void);
 ////////////////////////////////////////////////////////////////////////////////
 
 int TRI_InitServer (TRI_server_t*,
+                    void*,
                     void*,
                     void*,
                     char const*,
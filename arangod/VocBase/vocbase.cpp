@@ -53,6 +53,7 @@
 #include "VocBase/compactor.h"
 #include "VocBase/Ditch.h"
 #include "VocBase/document-collection.h"
+#include "VocBase/MaintenanceScheduler.h"
 #include "VocBase/replication-applier.h"
 #include "VocBase/server.h"
 #include "VocBase/transaction.h"
@@ -1434,9 +1435,6 @@ TRI_vocbase_t* TRI_CreateInitialVocBase (TRI_server_t* server,
   TRI_InitReadWriteLock(&vocbase->_inventoryLock);
   TRI_InitReadWriteLock(&vocbase->_lock);
 
-  TRI_InitCondition(&vocbase->_compactorCondition);
-  TRI_InitCondition(&vocbase->_cleanupCondition);
-
   TRI_CreateUserStructuresVocBase(vocbase);
   
   return vocbase;
@@ -1461,9 +1459,6 @@ void TRI_DestroyInitialVocBase (TRI_vocbase_t* vocbase) {
     delete vocbase->_oldTransactions;
   }
 
-  TRI_DestroyCondition(&vocbase->_cleanupCondition);
-  TRI_DestroyCondition(&vocbase->_compactorCondition);
-
   TRI_DestroyReadWriteLock(&vocbase->_lock);
   TRI_DestroyReadWriteLock(&vocbase->_inventoryLock);
 
@@ -1539,9 +1534,12 @@ TRI_vocbase_t* TRI_OpenVocBase (TRI_server_t* server,
   // start helper threads
   // .............................................................................
 
-  // start cleanup thread
-  TRI_InitThread(&vocbase->_cleanup);
-  TRI_StartThread(&vocbase->_cleanup, nullptr, "[cleanup]", TRI_CleanupVocBase, vocbase);
+  // register for cleanup
+  auto scheduler = static_cast<triagens::arango::MaintenanceScheduler*>(server->_maintenanceScheduler);
+
+  if (scheduler != nullptr) {
+    scheduler->registerDatabase(vocbase);
+  }
       
   vocbase->_replicationApplier = TRI_CreateReplicationApplier(server, vocbase);
 
@@ -1590,32 +1588,22 @@ void TRI_DestroyVocBase (TRI_vocbase_t* vocbase) {
 
   TRI_DestroyVectorPointer(&collections);
 
-  // this will signal the synchroniser and the compactor threads to do one last iteration
+  // no more compaction jobs for this database
   vocbase->_state = (sig_atomic_t) TRI_VOCBASE_STATE_SHUTDOWN_COMPACTOR;
   
-  TRI_LockCondition(&vocbase->_compactorCondition);
-  TRI_SignalCondition(&vocbase->_compactorCondition);
-  TRI_UnlockCondition(&vocbase->_compactorCondition);
-
-  if (vocbase->_hasCompactor) {
-    int res = TRI_JoinThread(&vocbase->_compactor);
+  int res = TRI_StopCompactorVocBase(vocbase);
 
-    if (res != TRI_ERROR_NO_ERROR) {
-      LOG_ERROR("unable to join compactor thread: %s", TRI_errno_string(res));
-    }
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_ERROR("unable to stop compaction: %s", TRI_errno_string(res));
   }
 
-  // this will signal the cleanup thread to do one last iteration
+  // no more cleanup jobs for this database. this does one last iteration
   vocbase->_state = (sig_atomic_t) TRI_VOCBASE_STATE_SHUTDOWN_CLEANUP;
 
-  TRI_LockCondition(&vocbase->_cleanupCondition);
-  TRI_SignalCondition(&vocbase->_cleanupCondition);
-  TRI_UnlockCondition(&vocbase->_cleanupCondition);
-
-  int res = TRI_JoinThread(&vocbase->_cleanup);
+  res = TRI_StopCleanupVocBase(vocbase);
 
   if (res != TRI_ERROR_NO_ERROR) {
-    LOG_ERROR("unable to join cleanup thread: %s", TRI_errno_string(res));
+    LOG_ERROR("unable to stop cleanup: %s", TRI_errno_string(res));
   }
 
   // free dead collections (already dropped but pointers still around)
@@ -1637,21 +1625,25 @@ void TRI_DestroyVocBase (TRI_vocbase_t* vocbase) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief starts the compactor thread
+/// @brief starts compaction for the database
 ////////////////////////////////////////////////////////////////////////////////
 
 void TRI_StartCompactorVocBase (TRI_vocbase_t* vocbase) {
   TRI_ASSERT(! vocbase->_hasCompactor);
 
+  auto scheduler = static_cast<triagens::arango::MaintenanceScheduler*>(vocbase->_server->_maintenanceScheduler);
+
+  if (scheduler == nullptr) {
+    return;
+  }
+
   LOG_TRACE("starting compactor for database '%s'", vocbase->_name);
-  // start compactor thread
-  TRI_InitThread(&vocbase->_compactor);
-  TRI_StartThread(&vocbase->_compactor, nullptr, "[compactor]", TRI_CompactorVocBase, vocbase);
+  scheduler->startCompaction(vocbase);
   vocbase->_hasCompactor = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief stops the compactor thread
+/// @brief stops compaction for the database
 ////////////////////////////////////////////////////////////////////////////////
 
 int TRI_StopCompactorVocBase (TRI_vocbase_t* vocbase) {
@@ -1659,9 +1651,11 @@ int TRI_StopCompactorVocBase (TRI_vocbase_t* vocbase) {
     vocbase->_hasCompactor = false;
 
     LOG_TRACE("stopping compactor for database '%s'", vocbase->_name);
-    int res = TRI_JoinThread(&vocbase->_compactor);
 
-    if (res != TRI_ERROR_NO_ERROR) {
+    try {
+      static_cast<triagens::arango::MaintenanceScheduler*>(vocbase->_server->_maintenanceScheduler)->stopCompaction(vocbase);
+    }
+    catch (...) {
       return TRI_ERROR_INTERNAL;
     }
   }
@@ -1669,6 +1663,44 @@ int TRI_StopCompactorVocBase (TRI_vocbase_t* vocbase) {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stops cleanup for the database
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_StopCleanupVocBase (TRI_vocbase_t* vocbase) {
+  auto scheduler = static_cast<triagens::arango::MaintenanceScheduler*>(vocbase->_server->_maintenanceScheduler);
+
+  if (scheduler == nullptr) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  try {
+    if (scheduler->unregisterDatabase(vocbase)) {
+      LOG_TRACE("stopping cleanup for database '%s'", vocbase->_name);
+
+      // one last iteration
+      TRI_CleanupVocBase(vocbase, 0, true);
+    }
+  }
+  catch (...) {
+    return TRI_ERROR_INTERNAL;
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wakes up the cleanup for the database
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_SignalCleanupVocBase (TRI_vocbase_t* vocbase) {
+  auto scheduler = static_cast<triagens::arango::MaintenanceScheduler*>(vocbase->_server->_maintenanceScheduler);
+
+  if (scheduler != nullptr) {
+    scheduler->signalCleanup(vocbase);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns all known (document) collections
 ////////////////////////////////////////////////////////////////////////////////
@@ -2050,10 +2082,8 @@ int TRI_UnloadCollectionVocBase (TRI_vocbase_t* vocbase,
   // release locks
   TRI_WRITE_UNLOCK_STATUS_VOCBASE_COL(collection);
 
-  // wake up the cleanup thread
-  TRI_LockCondition(&vocbase->_cleanupCondition);
-  TRI_SignalCondition(&vocbase->_cleanupCondition);
-  TRI_UnlockCondition(&vocbase->_cleanupCondition);
+  // wake up the cleanup
+  TRI_SignalCleanupVocBase(vocbase);
 
   return TRI_ERROR_NO_ERROR;
 }
@@ -2204,10 +2234,8 @@ int TRI_DropCollectionVocBase (TRI_vocbase_t* vocbase,
       // add callback for dropping
       collection->_collection->ditches()->createDropCollectionDitch(collection->_collection, collection, DropCollectionCallback, __FILE__, __LINE__);
 
-      // wake up the cleanup thread
-      TRI_LockCondition(&vocbase->_cleanupCondition);
-      TRI_SignalCondition(&vocbase->_cleanupCondition);
-      TRI_UnlockCondition(&vocbase->_cleanupCondition);
+      // wake up the cleanup
+      TRI_SignalCleanupVocBase(vocbase);
     }
 
     return TRI_ERROR_NO_ERROR;
@@ -329,23 +329,17 @@ typedef struct TRI_vocbase_s {
   // state of the database
   // 0 = inactive
   // 1 = normal operation/running
-  // 2 = shutdown in progress/waiting for compactor/synchroniser thread to finish
-  // 3 = shutdown in progress/waiting for cleanup thread to finish
+  // 2 = shutdown in progress/waiting for compaction jobs to finish
+  // 3 = shutdown in progress/waiting for cleanup jobs to finish
   // 4 = version check failed
 
   sig_atomic_t               _state;
 
-  TRI_thread_t               _compactor;
-  TRI_thread_t               _cleanup;
-
   struct {
     TRI_read_write_lock_t _lock;
     TRI_vector_t          _data;
   }
   _compactionBlockers;
-
-  TRI_condition_t            _compactorCondition;
-  TRI_condition_t            _cleanupCondition;
 }
 TRI_vocbase_t;
 
@@ -451,17 +445,34 @@ TRI_vocbase_t* TRI_OpenVocBase (struct TRI_server_s*,
 void TRI_DestroyVocBase (TRI_vocbase_t*);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief starts the compactor thread
+/// @brief starts compaction for the database
 ////////////////////////////////////////////////////////////////////////////////
 
 void TRI_StartCompactorVocBase (TRI_vocbase_t*);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief stops the compactor thread
+/// @brief stops compaction for the database
+///
+/// waits until no compaction job for the database is running anymore
 ////////////////////////////////////////////////////////////////////////////////
 
 int TRI_StopCompactorVocBase (TRI_vocbase_t*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stops cleanup for the database
+///
+/// waits until no cleanup job for the database is running anymore and then
+/// runs a final cleanup iteration in the calling thread
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_StopCleanupVocBase (TRI_vocbase_t*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wakes up the cleanup for the database
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_SignalCleanupVocBase (TRI_vocbase_t*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns all known collections
 ////////////////////////////////////////////////////////////////////////////////
@@ -30,7 +30,6 @@
 #include "CollectorThread.h"
 
 #include "Basics/MutexLocker.h"
-#include "Basics/hashes.h"
 #include "Basics/logging.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/Exceptions.h"
@@ -1401,14 +1400,12 @@ void CollectorThread::finishMarker (char const* walPosition,
   // re-use the original WAL marker's tick
   marker->_tick = tick;
 
-  // calculate the CRC
-  TRI_voc_crc_t crc = TRI_InitialCrc32();
-  crc = TRI_BlockCrc32(crc, const_cast<char*>(datafilePosition), marker->_size);
-  marker->_crc = TRI_FinalCrc32(crc);
-
   TRI_datafile_t* datafile = cache->lastDatafile;
   TRI_ASSERT(datafile != nullptr);
 
+  // calculate the CRC, using the algorithm of the target datafile
+  marker->_crc = TRI_CrcMarkerDatafile(marker, datafile->_crc32c);
+
   // update ticks
   TRI_UpdateTicksDatafile(datafile, marker);
 
@@ -1331,6 +1331,26 @@ Logfile* LogfileManager::getCollectableLogfile () {
   return nullptr;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of sealed logfiles that wait for collection
+////////////////////////////////////////////////////////////////////////////////
+
+size_t LogfileManager::numCollectableLogfiles () {
+  size_t count = 0;
+
+  READ_LOCKER(_logfilesLock);
+
+  for (auto it = _logfiles.begin(); it != _logfiles.end(); ++it) {
+    Logfile* logfile = (*it).second;
+
+    if (logfile != nullptr && logfile->canBeCollected()) {
+      ++count;
+    }
+  }
+
+  return count;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get a logfile to remove. this may return nullptr
 ////////////////////////////////////////////////////////////////////////////////
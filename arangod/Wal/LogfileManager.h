@@ -598,6 +598,12 @@ namespace triagens {
 
         Logfile* getRemovableLogfile ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of sealed logfiles that wait for collection
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t numCollectableLogfiles ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief increase the number of collect operations for a logfile
 ////////////////////////////////////////////////////////////////////////////////
@@ -1153,11 +1153,21 @@ bool RecoverState::ReplayMarker (TRI_df_marker_t const* marker,
       parameters._doCompact = true;
       parameters._waitForSync = vocbase->_settings.defaultWaitForSync;
       parameters._maximalSize = vocbase->_settings.defaultMaximalSize; 
+      parameters._indexBuckets = document->_info._indexBuckets;
+      parameters._compactionDeadSizeThreshold = document->_info._compactionDeadSizeThreshold;
+      parameters._compactionDeadSizeShare     = document->_info._compactionDeadSizeShare;
+      parameters._compactionMaxFileSize       = document->_info._compactionMaxFileSize;
+      parameters._compressDatafiles           = document->_info._compressDatafiles;
 
       value = TRI_LookupObjectJson(json, "doCompact");
       if (TRI_IsBooleanJson(value)) {
         parameters._doCompact = value->_value._boolean;
       }
+
+      value = TRI_LookupObjectJson(json, "compressDatafiles");
+      if (TRI_IsBooleanJson(value)) {
+        parameters._compressDatafiles = value->_value._boolean;
+      }
       
       value = TRI_LookupObjectJson(json, "waitForSync");
       if (TRI_IsBooleanJson(value)) {
@@ -1168,6 +1178,26 @@ bool RecoverState::ReplayMarker (TRI_df_marker_t const* marker,
       if (TRI_IsNumberJson(value)) {
         parameters._maximalSize = static_cast<TRI_voc_size_t>(value->_value._number);
       }
+
+      value = TRI_LookupObjectJson(json, "indexBuckets");
+      if (TRI_IsNumberJson(value)) {
+        parameters._indexBuckets = static_cast<uint32_t>(value->_value._number);
+      }
+
+      value = TRI_LookupObjectJson(json, "compactionDeadSizeThreshold");
+      if (TRI_IsNumberJson(value)) {
+        parameters._compactionDeadSizeThreshold = static_cast<uint64_t>(value->_value._number);
+      }
+
+      value = TRI_LookupObjectJson(json, "compactionDeadSizeShare");
+      if (TRI_IsNumberJson(value)) {
+        parameters._compactionDeadSizeShare = value->_value._number;
+      }
+
+      value = TRI_LookupObjectJson(json, "compactionMaxFileSize");
+      if (TRI_IsNumberJson(value)) {
+        parameters._compactionMaxFileSize = static_cast<uint64_t>(value->_value._number);
+      }
       
       int res = TRI_UpdateCollectionInfo(vocbase, document, &parameters, vocbase->_settings.forceSyncProperties);
 
@@ -1339,6 +1369,9 @@ bool RecoverState::ReplayMarker (TRI_df_marker_t const* marker,
       
       TRI_col_info_t info;
       memset(&info, 0, sizeof(TRI_col_info_t));
+      info._compactionDeadSizeThreshold = TRI_COL_COMPACTION_DEAD_SIZE_THRESHOLD;
+      info._compactionDeadSizeShare     = TRI_COL_COMPACTION_DEAD_SIZE_SHARE;
+      info._compactionMaxFileSize       = TRI_COL_COMPACTION_MAX_FILE_SIZE;
 
       TRI_FromJsonCollectionInfo(&info, json);
       TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
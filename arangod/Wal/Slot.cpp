@@ -28,7 +28,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Wal/Slot.h"
-#include "Basics/hashes.h"
+#include "VocBase/datafile.h"
 
 using namespace triagens::wal;
 
@@ -45,7 +45,8 @@ Slot::Slot ()
     _logfileId(0),
     _mem(nullptr),
     _size(0),
-    _status(StatusType::UNUSED) {
+    _status(StatusType::UNUSED),
+    _crc32c(true) {
 }
 
 // -----------------------------------------------------------------------------
@@ -95,11 +96,8 @@ void Slot::fill (void* src,
   // set size
   marker->_size = static_cast<TRI_voc_size_t>(size);
 
-  // calculate the crc
-  marker->_crc = 0;
-  TRI_voc_crc_t crc = TRI_InitialCrc32();
-  crc = TRI_BlockCrc32(crc, (char const*) marker, static_cast<TRI_voc_size_t>(size));
-  marker->_crc = TRI_FinalCrc32(crc);
+  // calculate the crc, using the algorithm of the logfile
+  marker->_crc = TRI_CrcMarkerDatafile(marker, _crc32c);
 
   TRI_IF_FAILURE("WalSlotCrc") {
     // intentionally corrupt the marker
@@ -135,13 +133,15 @@ void Slot::setUnused () {
 void Slot::setUsed (void* mem,
                     uint32_t size,
                     Logfile::IdType logfileId,
-                    Slot::TickType tick) {
+                    Slot::TickType tick,
+                    bool crc32c) {
   TRI_ASSERT(isUnused());
   _tick = tick;
   _logfileId = logfileId;
   _mem = mem;
   _size = size;
   _status = StatusType::USED;
+  _crc32c = crc32c;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
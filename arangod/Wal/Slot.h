@@ -65,7 +65,7 @@ namespace triagens {
 /// @brief slot status typedef
 ////////////////////////////////////////////////////////////////////////////////
 
-        enum class StatusType : uint32_t {
+        enum class StatusType : uint8_t {
           UNUSED        = 0,
           USED          = 1,
           RETURNED      = 2,
@@ -188,7 +188,8 @@ namespace triagens {
         void setUsed (void*,
                       uint32_t,
                       Logfile::IdType,
-                      Slot::TickType);
+                      Slot::TickType,
+                      bool);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief mark as slot as returned
@@ -236,6 +237,12 @@ namespace triagens {
 
         StatusType _status;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether the slot's logfile checksums markers using CRC32C
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _crc32c;
+
     };
 
     static_assert(sizeof(Slot) == 32, "invalid slot size");
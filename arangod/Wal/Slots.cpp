@@ -215,7 +215,7 @@ SlotInfo Slots::nextUnused (uint32_t size) {
         }
 
         // only in this case we return a valid slot
-        slot->setUsed(static_cast<void*>(mem), size, _logfile->id(), handout());
+        slot->setUsed(static_cast<void*>(mem), size, _logfile->id(), handout(), _logfile->df()->_crc32c);
 
         return SlotInfo(slot);
       }
@@ -349,7 +349,7 @@ SlotInfo Slots::nextUnused (uint32_t size,
         }
 
         // only in this case we return a valid slot
-        slot->setUsed(static_cast<void*>(mem), size, _logfile->id(), handout());
+        slot->setUsed(static_cast<void*>(mem), size, _logfile->id(), handout(), _logfile->df()->_crc32c);
 
         return SlotInfo(slot);
       }
@@ -685,7 +685,7 @@ int Slots::writeHeader (Slot* slot) {
   TRI_df_marker_t* mem = reinterpret_cast<TRI_df_marker_t*>(_logfile->reserve(size));
   TRI_ASSERT(mem != nullptr);
 
-  slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), handout());
+  slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), handout(), _logfile->df()->_crc32c);
   slot->fill(&header.base, size);
   slot->setReturned(false); // sync
 
@@ -705,7 +705,7 @@ int Slots::writeFooter (Slot* slot) {
   TRI_df_marker_t* mem = reinterpret_cast<TRI_df_marker_t*>(_logfile->reserve(size));
   TRI_ASSERT(mem != nullptr);
 
-  slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), handout());
+  slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), handout(), _logfile->df()->_crc32c);
   slot->fill(&footer.base, size);
   slot->setReturned(true); // sync
 
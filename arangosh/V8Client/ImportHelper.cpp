@@ -149,6 +149,10 @@ namespace triagens {
                                 uint64_t maxUploadSize)
     : _client(client),
       _maxUploadSize(maxUploadSize),
+      _senders(),
+      _senderThreads(),
+      _queue(),
+      _queueDone(false),
       _separator(","),
       _quote("\""),
       _useBackslash(false),
@@ -170,6 +174,7 @@ namespace triagens {
     }
 
     ImportHelper::~ImportHelper () {
+      waitForSenders();
     }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -179,6 +184,42 @@ namespace triagens {
     bool ImportHelper::importDelimited (string const& collectionName,
                                         string const& fileName,
                                         DelimitedImportType typeImport) {
+      bool ok = readDelimited(collectionName, fileName, typeImport);
+
+      // wait until all batches have been sent
+      waitForSenders();
+
+      return ok && ! _hasError;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief imports a file with JSON objects
+////////////////////////////////////////////////////////////////////////////////
+
+    bool ImportHelper::importJson (string const& collectionName,
+                                   string const& fileName) {
+      bool ok = readJson(collectionName, fileName);
+
+      // wait until all batches have been sent
+      waitForSenders();
+
+      // this is an approximation only. _numberLines is more meaningful for CSV imports
+      _numberLines = _numberErrors + _numberCreated + _numberIgnored + _numberUpdated;
+
+      return ok && ! _hasError;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// private functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads a delimited file and sends its contents in batches
+////////////////////////////////////////////////////////////////////////////////
+
+    bool ImportHelper::readDelimited (string const& collectionName,
+                                      string const& fileName,
+                                      DelimitedImportType typeImport) {
       _collectionName = collectionName;
       _firstLine = "";
       _outputBuffer.clear();
@@ -285,12 +326,18 @@ namespace triagens {
       return !_hasError;
     }
 
-    bool ImportHelper::importJson (const string& collectionName, const string& fileName) {
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads a file with JSON objects and sends its contents in batches
+////////////////////////////////////////////////////////////////////////////////
+
+    bool ImportHelper::readJson (string const& collectionName,
+                                 string const& fileName) {
       _collectionName = collectionName;
       _firstLine = "";
       _outputBuffer.clear();
       _errorMessage = "";
       _hasError = false;
+      _rowOffset = 0;
 
       // read and convert
       int fd;
@@ -397,17 +444,10 @@ namespace triagens {
         TRI_CLOSE(fd);
       }
 
-      // this is an approximation only. _numberLines is more meaningful for CSV imports
-      _numberLines = _numberErrors + _numberCreated + _numberIgnored + _numberUpdated;
-
       _outputBuffer.clear();
       return ! _hasError;
     }
 
-////////////////////////////////////////////////////////////////////////////////
-/// private functions
-////////////////////////////////////////////////////////////////////////////////
-
     void ImportHelper::reportProgress (int64_t totalLength,
                                        int64_t totalRead,
                                        double& nextProgress) {
@@ -643,11 +683,9 @@ namespace triagens {
         return;
       }
 
-      map<string, string> headerFields;
       string url("/_api/import?" + getCollectionUrlPart() + "&line=" + StringUtils::itoa(_rowOffset) + "&details=true&onDuplicate=" + StringUtils::urlEncode(_onDuplicateAction));
-      std::unique_ptr<SimpleHttpResult> result(_client->request(HttpRequest::HTTP_REQUEST_POST, url, _outputBuffer.c_str(), _outputBuffer.length(), headerFields));
 
-      handleResult(result.get());
+      sendBatch(url, _outputBuffer.c_str(), _outputBuffer.length());
 
       _outputBuffer.reset();
       _rowOffset = _rowsRead;
@@ -664,15 +702,133 @@ namespace triagens {
         url += "&type=array";
       }
       else {
-        url += "&type=documents";
+        // pass the number of preceding lines so errors refer to lines of the file
+        url += "&type=documents&line=" + StringUtils::itoa(_rowOffset);
+        _rowOffset += (size_t) std::count(str, str + len, '\n');
       }
 
+      sendBatch(url, str, len);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sends a batch, either directly or via the sender threads
+////////////////////////////////////////////////////////////////////////////////
+
+    void ImportHelper::sendBatch (string const& url,
+                                  char const* data,
+                                  size_t len) {
+      if (_senderThreads.empty()) {
+        // the first batch is sent directly, as it may create or truncate the
+        // collection. the sender threads are started only afterwards
+        sendRequest(_client, url, data, len);
+
+        if (! _senders.empty() && ! _hasError) {
+          startSenders();
+        }
+        return;
+      }
+
+      Batch batch{ url, string(data, len) };
+
+      std::unique_lock<std::mutex> locker(_queueLock);
+
+      // limit the number of batches waiting in memory
+      _queueCondition.wait(locker, [&] () {
+        return _queue.size() < 2 * _senderThreads.size();
+      });
+
+      _queue.emplace_back(std::move(batch));
+      _queueCondition.notify_all();
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sends a single import request and processes its result
+////////////////////////////////////////////////////////////////////////////////
+
+    void ImportHelper::sendRequest (SimpleHttpClient* client,
+                                    string const& url,
+                                    char const* data,
+                                    size_t len) {
       map<string, string> headerFields;
-      std::unique_ptr<SimpleHttpResult> result(_client->request(HttpRequest::HTTP_REQUEST_POST, url, str, len, headerFields));
+      std::unique_ptr<SimpleHttpResult> result(client->request(HttpRequest::HTTP_REQUEST_POST, url, data, len, headerFields));
 
       handleResult(result.get());
     }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief starts one sender thread per client
+////////////////////////////////////////////////////////////////////////////////
+
+    void ImportHelper::startSenders () {
+      TRI_ASSERT(_senderThreads.empty());
+
+      _queueDone = false;
+      _senderThreads.emplace_back(&ImportHelper::runSender, this, _client);
+
+      for (auto client : _senders) {
+        _senderThreads.emplace_back(&ImportHelper::runSender, this, client);
+      }
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief main loop of a sender thread
+////////////////////////////////////////////////////////////////////////////////
+
+    void ImportHelper::runSender (SimpleHttpClient* client) {
+      while (true) {
+        Batch batch;
+
+        {
+          std::unique_lock<std::mutex> locker(_queueLock);
+
+          _queueCondition.wait(locker, [&] () {
+            return ! _queue.empty() || _queueDone;
+          });
+
+          if (_queue.empty()) {
+            // done
+            return;
+          }
+
+          batch = std::move(_queue.front());
+          _queue.pop_front();
+          _queueCondition.notify_all();
+        }
+
+        if (! _hasError) {
+          sendRequest(client, batch._url, batch._body.c_str(), batch._body.size());
+        }
+      }
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief waits until the sender threads have sent all queued batches
+////////////////////////////////////////////////////////////////////////////////
+
+    void ImportHelper::waitForSenders () {
+      if (_senderThreads.empty()) {
+        return;
+      }
+
+      {
+        std::lock_guard<std::mutex> locker(_queueLock);
+        _queueDone = true;
+        _queueCondition.notify_all();
+      }
+
+      for (auto& thread : _senderThreads) {
+        thread.join();
+      }
+
+      _senderThreads.clear();
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief processes the result of an import request
+///
+/// this may be called by several sender threads at the same time
+////////////////////////////////////////////////////////////////////////////////
+
     void ImportHelper::handleResult (SimpleHttpResult* result) {
       if (result == nullptr) {
         return;
@@ -699,6 +855,8 @@ namespace triagens {
         }
       }
 
+      std::lock_guard<std::mutex> locker(_resultLock);
+
       // get the "error" flag. This returns a pointer, not a copy
       TRI_json_t const* error = TRI_LookupObjectJson(json.get(), "error");
 
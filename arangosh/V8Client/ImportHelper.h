@@ -83,6 +83,19 @@ namespace triagens {
 
       ~ImportHelper ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief adds a client for an additional sender thread
+///
+/// when clients were added, the batches are sent by a pool of threads, one
+/// per client including the one passed to the constructor, while the calling
+/// thread keeps reading and converting the input. the first batch is always
+/// sent before the others, as it may create or truncate the collection
+////////////////////////////////////////////////////////////////////////////////
+
+      void addSender (httpclient::SimpleHttpClient* client) {
+        _senders.push_back(client);
+      }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief imports a delimited file
 ////////////////////////////////////////////////////////////////////////////////
@@ -217,6 +230,20 @@ namespace triagens {
       }
 
     private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a batch waiting to be sent by a sender thread
+////////////////////////////////////////////////////////////////////////////////
+
+      struct Batch {
+        std::string _url;
+        std::string _body;
+      };
+
+    private:
+      bool readDelimited (std::string const&, std::string const&, DelimitedImportType);
+      bool readJson (std::string const&, std::string const&);
+
       static void ProcessCsvBegin (TRI_csv_parser_t*, size_t);
       static void ProcessCsvAdd (TRI_csv_parser_t*, char const*, size_t, size_t, size_t, bool);
       static void ProcessCsvEnd (TRI_csv_parser_t*, char const*, size_t, size_t, size_t, bool);
@@ -230,12 +257,25 @@ namespace triagens {
 
       void sendCsvBuffer ();
       void sendJsonBuffer (char const* str, size_t len, bool isObject);
+      void sendBatch (std::string const& url, char const* data, size_t len);
+      void sendRequest (httpclient::SimpleHttpClient*, std::string const& url, char const* data, size_t len);
+      void startSenders ();
+      void runSender (httpclient::SimpleHttpClient*);
+      void waitForSenders ();
       void handleResult (httpclient::SimpleHttpResult* result);
 
     private:
       httpclient::SimpleHttpClient* _client;
       uint64_t _maxUploadSize;
 
+      std::vector<httpclient::SimpleHttpClient*> _senders;
+      std::vector<std::thread> _senderThreads;
+      std::deque<Batch> _queue;
+      std::mutex _queueLock;
+      std::condition_variable _queueCondition;
+      bool _queueDone;
+      std::mutex _resultLock;
+
       std::string _separator;
       std::string _quote;
       bool _useBackslash;
@@ -259,7 +299,7 @@ namespace triagens {
       triagens::basics::StringBuffer _outputBuffer;
       std::string _firstLine;
 
-      bool _hasError;
+      std::atomic<bool> _hasError;
       std::string _errorMessage;
 
       static const double ProgressStep;
@@ -148,17 +148,66 @@ static uint64_t BatchId = 0;
 
 static bool clusterMode = false;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of collections to dump in parallel
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t Threads = 1;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief continue an interrupted dump
+////////////////////////////////////////////////////////////////////////////////
+
+static bool Resume = false;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief statistics
 ////////////////////////////////////////////////////////////////////////////////
 
 static struct {
-  uint64_t _totalBatches;
-  uint64_t _totalCollections;
-  uint64_t _totalWritten;
+  std::atomic<uint64_t> _totalBatches;
+  std::atomic<uint64_t> _totalCollections;
+  std::atomic<uint64_t> _totalWritten;
 }
 Stats;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief dump progress of a collection, as stored in the manifest
+////////////////////////////////////////////////////////////////////////////////
+
+struct ManifestEntry {
+  uint64_t _tick;   // tick to continue the dump from
+  uint64_t _size;   // number of bytes of the data file dumped up to _tick
+  bool     _done;   // whether or not the collection was dumped completely
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief dump progress of all collections
+////////////////////////////////////////////////////////////////////////////////
+
+static map<string, ManifestEntry> Manifest;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief last tick included in the dump, as stored in the manifest
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t ManifestTickEnd = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief protects the manifest
+////////////////////////////////////////////////////////////////////////////////
+
+static std::mutex ManifestLock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a collection to dump
+////////////////////////////////////////////////////////////////////////////////
+
+struct DumpJob {
+  string _cid;
+  string _name;
+};
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private functions
 // -----------------------------------------------------------------------------
@@ -179,6 +228,8 @@ static void ParseProgramOptions (int argc, char* argv[]) {
     ("output-directory", &OutputDirectory, "output directory")
     ("overwrite", &Overwrite, "overwrite data in output directory")
     ("progress", &Progress, "show progress")
+    ("resume", &Resume, "continue an interrupted dump in the output directory")
+    ("threads", &Threads, "number of collections to dump in parallel")
     ("tick-start", &TickStart, "only include data after this tick")
     ("tick-end", &TickEnd, "last tick to be included in data dump")
   ;
@@ -465,7 +516,8 @@ static int StartBatch (string DBserver, string& errorMsg) {
 /// @brief prolongs a batch
 ////////////////////////////////////////////////////////////////////////////////
 
-static void ExtendBatch (string DBserver) {
+static void ExtendBatch (SimpleHttpClient* client,
+                         string DBserver) {
   TRI_ASSERT(BatchId > 0);
 
   map<string, string> headers;
@@ -476,7 +528,7 @@ static void ExtendBatch (string DBserver) {
     urlExt = "?DBserver="+DBserver;
   }
 
-  SimpleHttpResult* response = Client->request(HttpRequest::HTTP_REQUEST_PUT,
+  SimpleHttpResult* response = client->request(HttpRequest::HTTP_REQUEST_PUT,
                                                url + urlExt,
                                                body.c_str(),
                                                body.size(),
@@ -516,14 +568,145 @@ static void EndBatch (string DBserver) {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the name of the manifest file
+////////////////////////////////////////////////////////////////////////////////
+
+static string ManifestFilename () {
+  return OutputDirectory + TRI_DIR_SEPARATOR_STR + "dump.manifest.json";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writes the manifest. the manifest lock must be held
+////////////////////////////////////////////////////////////////////////////////
+
+static bool WriteManifest () {
+  TRI_json_t* json = TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE);
+
+  if (json == nullptr) {
+    return false;
+  }
+
+  TRI_json_t* collections = TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE);
+
+  if (collections == nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+    return false;
+  }
+
+  for (auto const& it : Manifest) {
+    TRI_json_t* entry = TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE);
+
+    if (entry == nullptr) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, collections);
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+      return false;
+    }
+
+    string const tick = StringUtils::itoa(it.second._tick);
+
+    TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, entry, "tick", TRI_CreateStringCopyJson(TRI_UNKNOWN_MEM_ZONE, tick.c_str(), tick.size()));
+    TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, entry, "size", TRI_CreateNumberJson(TRI_UNKNOWN_MEM_ZONE, (double) it.second._size));
+    TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, entry, "done", TRI_CreateBooleanJson(TRI_UNKNOWN_MEM_ZONE, it.second._done));
+
+    TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, collections, it.first.c_str(), entry);
+  }
+
+  string const tickEnd = StringUtils::itoa(ManifestTickEnd);
+
+  TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, "tickEnd", TRI_CreateStringCopyJson(TRI_UNKNOWN_MEM_ZONE, tickEnd.c_str(), tickEnd.size()));
+  TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, "collections", collections);
+
+  bool ok = TRI_SaveJson(ManifestFilename().c_str(), json, false);
+
+  TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+
+  return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads the manifest of an interrupted dump
+////////////////////////////////////////////////////////////////////////////////
+
+static int ReadManifest (string& errorMsg) {
+  string const fileName = ManifestFilename();
+
+  if (! TRI_ExistsFile(fileName.c_str())) {
+    errorMsg = "cannot resume dump: no manifest found in '" + OutputDirectory + "'";
+    return TRI_ERROR_FILE_NOT_FOUND;
+  }
+
+  TRI_json_t* json = TRI_JsonFile(TRI_UNKNOWN_MEM_ZONE, fileName.c_str(), nullptr);
+  TRI_json_t const* collections = JsonHelper::getObjectElement(json, "collections");
+
+  if (! JsonHelper::isObject(json) || ! JsonHelper::isObject(collections)) {
+    if (json != nullptr) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+    }
+
+    errorMsg = "cannot resume dump: invalid manifest '" + fileName + "'";
+    return TRI_ERROR_INTERNAL;
+  }
+
+  ManifestTickEnd = StringUtils::uint64(JsonHelper::getStringValue(json, "tickEnd", "0"));
+
+  size_t const n = TRI_LengthVector(&collections->_value._objects);
+
+  for (size_t i = 0; i + 1 < n; i += 2) {
+    auto key   = static_cast<TRI_json_t const*>(TRI_AtVector(&collections->_value._objects, i));
+    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&collections->_value._objects, i + 1));
+
+    if (! JsonHelper::isString(key) || ! JsonHelper::isObject(value)) {
+      continue;
+    }
+
+    ManifestEntry entry;
+    entry._tick = StringUtils::uint64(JsonHelper::getStringValue(value, "tick", "0"));
+    entry._size = JsonHelper::getNumericValue<uint64_t>(value, "size", 0);
+    entry._done = JsonHelper::getBooleanValue(value, "done", false);
+
+    Manifest[string(key->_value._string.data, key->_value._string.length - 1)] = entry;
+  }
+
+  TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief records the progress of a collection in the manifest
+////////////////////////////////////////////////////////////////////////////////
+
+static void UpdateManifest (string const& name,
+                            uint64_t tick,
+                            uint64_t size,
+                            bool done) {
+  std::lock_guard<std::mutex> locker(ManifestLock);
+
+  ManifestEntry& entry = Manifest[name];
+  entry._tick = tick;
+  entry._size = size;
+  entry._done = done;
+
+  if (! WriteManifest()) {
+    cerr << "cannot write manifest '" << ManifestFilename() << "'" << endl;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief dump a single collection
+///
+/// the dump starts at fromTick, appending to the data file which already
+/// contains size bytes. the progress is recorded in the manifest after each
+/// chunk was synced to disk
 ////////////////////////////////////////////////////////////////////////////////
 
-static int DumpCollection (int fd,
+static int DumpCollection (SimpleHttpClient* client,
+                           int fd,
                            const string& cid,
                            const string& name,
-                           TRI_json_t const* parameters,
+                           uint64_t fromTick,
+                           uint64_t size,
                            const uint64_t maxTick,
                            string& errorMsg) {
 
@@ -533,8 +716,6 @@ static int DumpCollection (int fd,
 
   map<string, string> headers;
 
-  uint64_t fromTick = TickStart;
-
   while (1) {
     string url = baseUrl + "&from=" + StringUtils::itoa(fromTick);
 
@@ -544,14 +725,14 @@ static int DumpCollection (int fd,
 
     Stats._totalBatches++;
 
-    SimpleHttpResult* response = Client->request(HttpRequest::HTTP_REQUEST_GET,
+    SimpleHttpResult* response = client->request(HttpRequest::HTTP_REQUEST_GET,
                                                  url,
                                                  nullptr,
                                                  0,
                                                  headers);
 
     if (response == nullptr || ! response->isComplete()) {
-      errorMsg = "got invalid response from server: " + Client->getErrorMessage();
+      errorMsg = "got invalid response from server: " + client->getErrorMessage();
 
       if (response != nullptr) {
         delete response;
@@ -610,17 +791,26 @@ static int DumpCollection (int fd,
       }
       else {
         Stats._totalWritten += (uint64_t) body.length();
+        size += (uint64_t) body.length();
       }
     }
 
+    if (res == TRI_ERROR_NO_ERROR && ! TRI_fsync(fd)) {
+      // the manifest must never record data that may still be lost
+      res = TRI_ERROR_CANNOT_WRITE_FILE;
+    }
+
     delete response;
 
     if (res != TRI_ERROR_NO_ERROR) {
       return res;
     }
 
-    if (! checkMore || fromTick == 0) {
-      // done
+    bool const done = (! checkMore || fromTick == 0);
+
+    UpdateManifest(name, fromTick, size, done);
+
+    if (done) {
       return res;
     }
   }
@@ -629,6 +819,219 @@ static int DumpCollection (int fd,
   return TRI_ERROR_INTERNAL;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief dump the data of a single collection into its data file
+///
+/// when resuming, a collection that was dumped completely is skipped, and a
+/// partially dumped one is continued from the last tick recorded in the
+/// manifest. data written after that tick is cut off first. if the data file
+/// is shorter than recorded, the collection is dumped again from the start
+////////////////////////////////////////////////////////////////////////////////
+
+static int DumpCollectionData (SimpleHttpClient* client,
+                               DumpJob const& job,
+                               uint64_t maxTick,
+                               string& errorMsg) {
+  string const fileName = OutputDirectory + TRI_DIR_SEPARATOR_STR + job._name + ".data.json";
+
+  uint64_t fromTick = TickStart;
+  uint64_t size = 0;
+  int fd = -1;
+
+  if (Resume) {
+    ManifestEntry entry;
+    bool found = false;
+
+    {
+      std::lock_guard<std::mutex> locker(ManifestLock);
+      auto it = Manifest.find(job._name);
+
+      if (it != Manifest.end()) {
+        entry = (*it).second;
+        found = true;
+      }
+    }
+
+    if (found && entry._done) {
+      if (Progress) {
+        cout << "collection '" << job._name << "' was dumped completely, skipping" << endl;
+      }
+
+      return TRI_ERROR_NO_ERROR;
+    }
+
+    if (found && entry._size > 0 && TRI_ExistsFile(fileName.c_str())) {
+      fd = TRI_OPEN(fileName.c_str(), O_RDWR);
+
+      if (fd >= 0) {
+        TRI_stat_t st;
+
+        if (TRI_FSTAT(fd, &st) == 0 &&
+            (uint64_t) st.st_size >= entry._size &&
+            ftruncate(fd, (off_t) entry._size) == 0 &&
+            TRI_LSEEK(fd, 0, SEEK_END) == (off_t) entry._size) {
+          fromTick = entry._tick;
+          size = entry._size;
+
+          if (Progress) {
+            cout << "continuing dump of collection '" << job._name << "' at tick " << fromTick << endl;
+          }
+        }
+        else {
+          // the data file is shorter than recorded, start over
+          TRI_CLOSE(fd);
+          fd = -1;
+        }
+      }
+    }
+  }
+
+  if (fd < 0) {
+    // remove an existing file first
+    if (TRI_ExistsFile(fileName.c_str())) {
+      TRI_UnlinkFile(fileName.c_str());
+    }
+
+    fd = TRI_CREATE(fileName.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+
+    if (fd < 0) {
+      errorMsg = "cannot write to file '" + fileName + "'";
+
+      return TRI_ERROR_CANNOT_WRITE_FILE;
+    }
+  }
+
+  ExtendBatch(client, "");
+  int res = DumpCollection(client, fd, job._cid, job._name, fromTick, size, maxTick, errorMsg);
+
+  TRI_CLOSE(fd);
+
+  if (res != TRI_ERROR_NO_ERROR && errorMsg.empty()) {
+    errorMsg = "cannot write to file '" + fileName + "'";
+  }
+
+  return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief request location rewriter (injects database name)
+////////////////////////////////////////////////////////////////////////////////
+
+static string rewriteLocation (void*, const string&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates an additional client for a worker thread
+///
+/// the client does not own its connection, which is returned separately and
+/// must be deleted after the client
+////////////////////////////////////////////////////////////////////////////////
+
+static SimpleHttpClient* CreateClient (GeneralClientConnection*& connection) {
+  connection = GeneralClientConnection::factory(BaseClient.endpointServer(),
+                                                BaseClient.requestTimeout(),
+                                                BaseClient.connectTimeout(),
+                                                ArangoClient::DEFAULT_RETRIES,
+                                                BaseClient.sslProtocol());
+
+  if (connection == nullptr) {
+    return nullptr;
+  }
+
+  SimpleHttpClient* client = new SimpleHttpClient(connection, BaseClient.requestTimeout(), false);
+
+  client->setLocationRewriter(0, &rewriteLocation);
+  client->setUserNamePassword("/", BaseClient.username(), BaseClient.password());
+
+  return client;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief dumps the data of the collections, using up to --threads
+/// collections in parallel. each worker thread uses its own connection
+////////////////////////////////////////////////////////////////////////////////
+
+static int RunJobs (vector<DumpJob> const& jobs,
+                    uint64_t maxTick,
+                    string& errorMsg) {
+  size_t const numThreads = (std::min)((size_t) Threads, jobs.size());
+
+  if (numThreads <= 1) {
+    for (auto const& job : jobs) {
+      int res = DumpCollectionData(Client, job, maxTick, errorMsg);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+    }
+
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  std::atomic<size_t> next(0);
+  std::mutex errorLock;
+  int result = TRI_ERROR_NO_ERROR;
+
+  auto worker = [&] () {
+    GeneralClientConnection* connection = nullptr;
+    SimpleHttpClient* client = CreateClient(connection);
+
+    if (client == nullptr) {
+      std::lock_guard<std::mutex> locker(errorLock);
+
+      if (result == TRI_ERROR_NO_ERROR) {
+        result = TRI_ERROR_OUT_OF_MEMORY;
+        errorMsg = "out of memory";
+      }
+      return;
+    }
+
+    while (true) {
+      {
+        std::lock_guard<std::mutex> locker(errorLock);
+
+        if (result != TRI_ERROR_NO_ERROR) {
+          // another worker failed
+          break;
+        }
+      }
+
+      size_t const i = next++;
+
+      if (i >= jobs.size()) {
+        break;
+      }
+
+      string msg;
+      int res = DumpCollectionData(client, jobs[i], maxTick, msg);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        std::lock_guard<std::mutex> locker(errorLock);
+
+        if (result == TRI_ERROR_NO_ERROR) {
+          result = res;
+          errorMsg = msg;
+        }
+        break;
+      }
+    }
+
+    delete client;
+    delete connection;
+  };
+
+  vector<std::thread> threads;
+
+  for (size_t i = 0; i < numThreads; ++i) {
+    threads.emplace_back(worker);
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief execute a WAL flush request
 ////////////////////////////////////////////////////////////////////////////////
@@ -734,6 +1137,26 @@ static int RunDump (string& errorMsg) {
     maxTick = TickEnd;
   }
 
+  if (Resume) {
+    // continue with the tick range of the interrupted dump
+    maxTick = ManifestTickEnd;
+  }
+  else if (DumpData) {
+    std::lock_guard<std::mutex> locker(ManifestLock);
+
+    Manifest.clear();
+    ManifestTickEnd = maxTick;
+
+    if (! WriteManifest()) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+      errorMsg = "cannot write manifest '" + ManifestFilename() + "'";
+
+      return TRI_ERROR_CANNOT_WRITE_FILE;
+    }
+  }
+
+  vector<DumpJob> jobs;
+
   // create a lookup table for collections
   map<string, bool> restrictList;
   for (size_t i = 0; i < Collections.size(); ++i) {
@@ -831,46 +1254,15 @@ static int RunDump (string& errorMsg) {
 
 
     if (DumpData) {
-      // save the actual data
-      string fileName;
-      fileName = OutputDirectory + TRI_DIR_SEPARATOR_STR + name + ".data.json";
-
-      int fd;
-
-      // remove an existing file first
-      if (TRI_ExistsFile(fileName.c_str())) {
-        TRI_UnlinkFile(fileName.c_str());
-      }
-
-      fd = TRI_CREATE(fileName.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
-
-      if (fd < 0) {
-        errorMsg = "cannot write to file '" + fileName + "'";
-        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
-
-        return TRI_ERROR_CANNOT_WRITE_FILE;
-      }
-
-      ExtendBatch("");
-      int res = DumpCollection(fd, cid, name, parameters, maxTick, errorMsg);
-
-      TRI_CLOSE(fd);
-
-      if (res != TRI_ERROR_NO_ERROR) {
-        if (errorMsg.empty()) {
-          errorMsg = "cannot write to file '" + fileName + "'";
-        }
-        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
-
-        return res;
-      }
+      // the actual data is dumped below, possibly in parallel
+      jobs.push_back(DumpJob{ cid, name });
     }
   }
 
 
   TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
 
-  return TRI_ERROR_NO_ERROR;
+  return RunJobs(jobs, maxTick, errorMsg);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1274,6 +1666,15 @@ int main (int argc, char* argv[]) {
     TRI_EXIT_FUNCTION(EXIT_FAILURE, nullptr);
   }
 
+  if (Threads < 1) {
+    Threads = 1;
+  }
+
+  if (Resume && ! DumpData) {
+    cerr << "cannot use --resume together with --dump-data false" << endl;
+    TRI_EXIT_FUNCTION(EXIT_FAILURE, nullptr);
+  }
+
   if (! OutputDirectory.empty() &&
       OutputDirectory.back() == TRI_DIR_SEPARATOR_CHAR) {
     // trim trailing slash from path because it may cause problems on ... Windows
@@ -1306,7 +1707,18 @@ int main (int argc, char* argv[]) {
     TRI_EXIT_FUNCTION(EXIT_FAILURE, nullptr);
   }
 
-  if (isDirectory && ! isEmptyDirectory && ! Overwrite) {
+  if (Resume) {
+    string errorMsg;
+
+    if (! isDirectory || ReadManifest(errorMsg) != TRI_ERROR_NO_ERROR) {
+      if (errorMsg.empty()) {
+        errorMsg = "cannot resume dump: output directory '" + OutputDirectory + "' does not exist";
+      }
+      cerr << errorMsg << endl;
+      TRI_EXIT_FUNCTION(EXIT_FAILURE, nullptr);
+    }
+  }
+  else if (isDirectory && ! isEmptyDirectory && ! Overwrite) {
     cerr << "output directory '" << OutputDirectory << "' already exists. use \"--overwrite true\" to overwrite data in it" << endl;
     TRI_EXIT_FUNCTION(EXIT_FAILURE, nullptr);
   }
@@ -1383,6 +1795,10 @@ int main (int argc, char* argv[]) {
         cerr << "cannot use tick-start or tick-end on a cluster" << endl;
         TRI_EXIT_FUNCTION(EXIT_FAILURE, nullptr);
       }
+      if (Resume) {
+        cerr << "cannot use --resume on a cluster" << endl;
+        TRI_EXIT_FUNCTION(EXIT_FAILURE, nullptr);
+      }
     }
   }
 
@@ -1412,7 +1828,9 @@ int main (int argc, char* argv[]) {
     cout << "Writing dump to output directory '" << OutputDirectory << "'" << endl;
   }
 
-  memset(&Stats, 0, sizeof(Stats));
+  Stats._totalBatches     = 0;
+  Stats._totalCollections = 0;
+  Stats._totalWritten     = 0;
 
   string errorMsg = "";
 
@@ -1448,12 +1866,12 @@ int main (int argc, char* argv[]) {
 
   if (Progress) {
     if (DumpData) {
-      cout << "Processed " << Stats._totalCollections << " collection(s), " <<
-              "wrote " << Stats._totalWritten << " byte(s) into datafiles, " <<
-              "sent " << Stats._totalBatches << " batch(es)" << endl;
+      cout << "Processed " << Stats._totalCollections.load() << " collection(s), " <<
+              "wrote " << Stats._totalWritten.load() << " byte(s) into datafiles, " <<
+              "sent " << Stats._totalBatches.load() << " batch(es)" << endl;
     }
     else {
-      cout << "Processed " << Stats._totalCollections << " collection(s)" << endl;
+      cout << "Processed " << Stats._totalCollections.load() << " collection(s)" << endl;
     }
   }
 
@@ -129,6 +129,12 @@ static std::string OnDuplicateAction = "error";
 
 static bool Progress = true;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of import requests to keep in flight
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t Threads = 1;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private functions
 // -----------------------------------------------------------------------------
@@ -157,6 +163,7 @@ static void ParseProgramOptions (int argc, char* argv[]) {
     ("quote", &Quote, "quote character(s), used for csv")
     ("separator", &Separator, "field separator, used for csv")
     ("progress", &Progress, "show progress")
+    ("threads", &Threads, "number of parallel import requests, each using its own connection")
     ("on-duplicate", &OnDuplicateAction, "action to perform when a unique key constraint violation occurs. Possible values: 'error', 'update', 'replace', 'ignore')")
     (deprecatedOptions, true)
   ;
@@ -347,10 +354,43 @@ int main (int argc, char* argv[]) {
 
       cout << "connect timeout:  " << BaseClient.connectTimeout() << endl;
       cout << "request timeout:  " << BaseClient.requestTimeout() << endl;
+
+      if (Threads > 1) {
+        cout << "threads:          " << Threads << endl;
+      }
+
       cout << "----------------------------------------" << endl;
 
+      // additional connections and clients for the sender threads. they must
+      // outlive the import helper
+      std::vector<std::unique_ptr<GeneralClientConnection>> senderConnections;
+      std::vector<std::unique_ptr<SimpleHttpClient>> senderClients;
+
+      for (uint64_t i = 1; i < Threads; ++i) {
+        GeneralClientConnection* senderConnection = GeneralClientConnection::factory(BaseClient.endpointServer(),
+                                                                                     BaseClient.requestTimeout(),
+                                                                                     BaseClient.connectTimeout(),
+                                                                                     ArangoClient::DEFAULT_RETRIES,
+                                                                                     BaseClient.sslProtocol());
+
+        if (senderConnection == nullptr) {
+          cerr << "out of memory" << endl;
+          TRI_EXIT_FUNCTION(EXIT_FAILURE, nullptr);
+        }
+
+        senderConnections.emplace_back(senderConnection);
+        senderClients.emplace_back(new SimpleHttpClient(senderConnection, BaseClient.requestTimeout(), false));
+
+        senderClients.back()->setLocationRewriter(nullptr, &RewriteLocation);
+        senderClients.back()->setUserNamePassword("/", BaseClient.username(), BaseClient.password());
+      }
+
       triagens::v8client::ImportHelper ih(&client, ChunkSize);
 
+      for (auto& senderClient : senderClients) {
+        ih.addSender(senderClient.get());
+      }
+
       // create colletion
       if (CreateCollection) {
         ih.setCreateCollection(true);
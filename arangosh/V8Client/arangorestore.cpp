@@ -153,17 +153,66 @@ static bool ClusterMode = false;
 
 static int LastErrorCode = TRI_ERROR_NO_ERROR;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of collections to restore in parallel
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t Threads = 1;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief continue an interrupted restore
+////////////////////////////////////////////////////////////////////////////////
+
+static bool Resume = false;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief statistics
 ////////////////////////////////////////////////////////////////////////////////
 
 static struct {
-  uint64_t _totalBatches;
-  uint64_t _totalCollections;
-  uint64_t _totalRead;
+  std::atomic<uint64_t> _totalBatches;
+  std::atomic<uint64_t> _totalCollections;
+  std::atomic<uint64_t> _totalRead;
 }
 Stats;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief restore progress of a collection, as stored in the manifest
+////////////////////////////////////////////////////////////////////////////////
+
+struct ManifestEntry {
+  bool     _created;  // whether or not the collection was re-created
+  uint64_t _offset;   // number of bytes of the data file sent to the server
+  bool     _done;     // whether or not the collection was restored completely
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief restore progress of all collections
+////////////////////////////////////////////////////////////////////////////////
+
+static map<string, ManifestEntry> Manifest;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not writing the manifest failed before
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ManifestFailed = false;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief protects the manifest
+////////////////////////////////////////////////////////////////////////////////
+
+static std::mutex ManifestLock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a collection to load data into
+////////////////////////////////////////////////////////////////////////////////
+
+struct RestoreJob {
+  TRI_json_t const* _json;
+  string _name;
+};
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private functions
 // -----------------------------------------------------------------------------
@@ -187,6 +236,8 @@ static void ParseProgramOptions (int argc, char* argv[]) {
     ("input-directory", &InputDirectory, "input directory")
     ("overwrite", &Overwrite, "overwrite collections if they exist")
     ("progress", &Progress, "show progress")
+    ("resume", &Resume, "continue an interrupted restore from the input directory")
+    ("threads", &Threads, "number of collections to restore in parallel")
   ;
 
   BaseClient.setupGeneral(description);
@@ -467,7 +518,8 @@ static bool GetArangoIsCluster () {
 /// @brief send the request to re-create a collection
 ////////////////////////////////////////////////////////////////////////////////
 
-static int SendRestoreCollection (TRI_json_t const* json,
+static int SendRestoreCollection (SimpleHttpClient* client,
+                                  TRI_json_t const* json,
                                   string& errorMsg) {
   map<string, string> headers;
 
@@ -478,14 +530,14 @@ static int SendRestoreCollection (TRI_json_t const* json,
 
   const string body = JsonHelper::toString(json);
 
-  SimpleHttpResult* response = Client->request(HttpRequest::HTTP_REQUEST_PUT,
+  SimpleHttpResult* response = client->request(HttpRequest::HTTP_REQUEST_PUT,
                                                url,
                                                body.c_str(),
                                                body.size(),
                                                headers);
 
   if (response == nullptr || ! response->isComplete()) {
-    errorMsg = "got invalid response from server: " + Client->getErrorMessage();
+    errorMsg = "got invalid response from server: " + client->getErrorMessage();
 
     if (response != nullptr) {
       delete response;
@@ -510,21 +562,22 @@ static int SendRestoreCollection (TRI_json_t const* json,
 /// @brief send the request to re-create indexes for a collection
 ////////////////////////////////////////////////////////////////////////////////
 
-static int SendRestoreIndexes (TRI_json_t const* json,
+static int SendRestoreIndexes (SimpleHttpClient* client,
+                               TRI_json_t const* json,
                                string& errorMsg) {
   map<string, string> headers;
 
   const string url = "/_api/replication/restore-indexes?force=" + string(Force ? "true" : "false");
   const string body = JsonHelper::toString(json);
 
-  SimpleHttpResult* response = Client->request(HttpRequest::HTTP_REQUEST_PUT,
+  SimpleHttpResult* response = client->request(HttpRequest::HTTP_REQUEST_PUT,
                                                url,
                                                body.c_str(),
                                                body.size(),
                                                headers);
 
   if (response == nullptr || ! response->isComplete()) {
-    errorMsg = "got invalid response from server: " + Client->getErrorMessage();
+    errorMsg = "got invalid response from server: " + client->getErrorMessage();
 
     if (response != nullptr) {
       delete response;
@@ -549,7 +602,8 @@ static int SendRestoreIndexes (TRI_json_t const* json,
 /// @brief send the request to load data into a collection
 ////////////////////////////////////////////////////////////////////////////////
 
-static int SendRestoreData (string const& cname,
+static int SendRestoreData (SimpleHttpClient* client,
+                            string const& cname,
                             char const* buffer,
                             size_t bufferSize,
                             string& errorMsg) {
@@ -560,7 +614,7 @@ static int SendRestoreData (string const& cname,
                      "&recycleIds=" + (RecycleIds ? "true" : "false") +
                      "&force=" + (Force ? "true" : "false");
 
-  SimpleHttpResult* response = Client->request(HttpRequest::HTTP_REQUEST_PUT,
+  SimpleHttpResult* response = client->request(HttpRequest::HTTP_REQUEST_PUT,
                                                url,
                                                buffer,
                                                bufferSize,
@@ -568,7 +622,7 @@ static int SendRestoreData (string const& cname,
 
 
   if (response == nullptr || ! response->isComplete()) {
-    errorMsg = "got invalid response from server: " + Client->getErrorMessage();
+    errorMsg = "got invalid response from server: " + client->getErrorMessage();
 
     if (response != nullptr) {
       delete response;
@@ -589,6 +643,144 @@ static int SendRestoreData (string const& cname,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the name of the manifest file
+////////////////////////////////////////////////////////////////////////////////
+
+static string ManifestFilename () {
+  return InputDirectory + TRI_DIR_SEPARATOR_STR + "restore.manifest.json";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writes the manifest. the manifest lock must be held
+////////////////////////////////////////////////////////////////////////////////
+
+static bool WriteManifest () {
+  TRI_json_t* json = TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE);
+
+  if (json == nullptr) {
+    return false;
+  }
+
+  TRI_json_t* collections = TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE);
+
+  if (collections == nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+    return false;
+  }
+
+  for (auto const& it : Manifest) {
+    TRI_json_t* entry = TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE);
+
+    if (entry == nullptr) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, collections);
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+      return false;
+    }
+
+    TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, entry, "created", TRI_CreateBooleanJson(TRI_UNKNOWN_MEM_ZONE, it.second._created));
+    TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, entry, "offset", TRI_CreateNumberJson(TRI_UNKNOWN_MEM_ZONE, (double) it.second._offset));
+    TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, entry, "done", TRI_CreateBooleanJson(TRI_UNKNOWN_MEM_ZONE, it.second._done));
+
+    TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, collections, it.first.c_str(), entry);
+  }
+
+  TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, "collections", collections);
+
+  bool ok = TRI_SaveJson(ManifestFilename().c_str(), json, false);
+
+  TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+
+  return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads the manifest of an interrupted restore
+////////////////////////////////////////////////////////////////////////////////
+
+static int ReadManifest (string& errorMsg) {
+  string const fileName = ManifestFilename();
+
+  if (! TRI_ExistsFile(fileName.c_str())) {
+    errorMsg = "cannot resume restore: no manifest found in '" + InputDirectory + "'";
+    return TRI_ERROR_FILE_NOT_FOUND;
+  }
+
+  TRI_json_t* json = TRI_JsonFile(TRI_UNKNOWN_MEM_ZONE, fileName.c_str(), nullptr);
+  TRI_json_t const* collections = JsonHelper::getObjectElement(json, "collections");
+
+  if (! JsonHelper::isObject(json) || ! JsonHelper::isObject(collections)) {
+    if (json != nullptr) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+    }
+
+    errorMsg = "cannot resume restore: invalid manifest '" + fileName + "'";
+    return TRI_ERROR_INTERNAL;
+  }
+
+  size_t const n = TRI_LengthVector(&collections->_value._objects);
+
+  for (size_t i = 0; i + 1 < n; i += 2) {
+    auto key   = static_cast<TRI_json_t const*>(TRI_AtVector(&collections->_value._objects, i));
+    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&collections->_value._objects, i + 1));
+
+    if (! JsonHelper::isString(key) || ! JsonHelper::isObject(value)) {
+      continue;
+    }
+
+    ManifestEntry entry;
+    entry._created = JsonHelper::getBooleanValue(value, "created", false);
+    entry._offset  = JsonHelper::getNumericValue<uint64_t>(value, "offset", 0);
+    entry._done    = JsonHelper::getBooleanValue(value, "done", false);
+
+    Manifest[string(key->_value._string.data, key->_value._string.length - 1)] = entry;
+  }
+
+  TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief looks up the progress of a collection in the manifest
+////////////////////////////////////////////////////////////////////////////////
+
+static ManifestEntry LookupManifest (string const& name) {
+  std::lock_guard<std::mutex> locker(ManifestLock);
+
+  auto it = Manifest.find(name);
+
+  if (it == Manifest.end()) {
+    return ManifestEntry{ false, 0, false };
+  }
+
+  return (*it).second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief records the progress of a collection in the manifest
+///
+/// failing to write the manifest is not an error, as the input directory may
+/// be read-only. it only means that the restore cannot be resumed
+////////////////////////////////////////////////////////////////////////////////
+
+static void UpdateManifest (string const& name,
+                            bool created,
+                            uint64_t offset,
+                            bool done) {
+  std::lock_guard<std::mutex> locker(ManifestLock);
+
+  ManifestEntry& entry = Manifest[name];
+  entry._created = created;
+  entry._offset  = offset;
+  entry._done    = done;
+
+  if (! WriteManifest() && ! ManifestFailed) {
+    cerr << "cannot write manifest '" << ManifestFilename() << "', the restore cannot be resumed" << endl;
+    ManifestFailed = true;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief comparator to sort collections
 /// sort order is by collection type first (vertices before edges, this is
@@ -613,6 +805,295 @@ static int SortCollections (const void* l,
   return strcasecmp(leftName.c_str(), rightName.c_str());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief load the data into a single collection and create its indexes
+///
+/// when resuming, loading continues at the offset of the data file recorded
+/// in the manifest. the data of a collection is always sent in file order
+////////////////////////////////////////////////////////////////////////////////
+
+static int RestoreCollectionData (SimpleHttpClient* client,
+                                  RestoreJob const& job,
+                                  string& errorMsg) {
+  TRI_json_t const* indexes = JsonHelper::getObjectElement(job._json, "indexes");
+  string const& cname = job._name;
+
+  ManifestEntry const entry = LookupManifest(cname);
+  bool const created = entry._created || ImportStructure;
+  uint64_t offset = entry._offset;
+
+  if (ImportData) {
+    // import data. check if we have a datafile
+    // TODO: externalise file extension
+    const string datafile = InputDirectory + TRI_DIR_SEPARATOR_STR + cname + ".data.json";
+
+    if (TRI_ExistsFile(datafile.c_str())) {
+      // found a datafile
+
+      if (Progress) {
+        if (offset > 0) {
+          cout << "Continuing to load data into collection '" << cname << "' at offset " << offset << "..." << endl;
+        }
+        else {
+          cout << "Loading data into collection '" << cname << "'..." << endl;
+        }
+      }
+
+      int fd = TRI_OPEN(datafile.c_str(), O_RDONLY);
+
+      if (fd < 0) {
+        errorMsg = "cannot open collection data file '" + datafile + "'";
+
+        return TRI_ERROR_INTERNAL;
+      }
+
+      if (offset > 0 && TRI_LSEEK(fd, (off_t) offset, SEEK_SET) != (off_t) offset) {
+        TRI_CLOSE(fd);
+        errorMsg = "cannot continue loading collection data file '" + datafile + "'";
+
+        return TRI_ERROR_INTERNAL;
+      }
+
+      StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+
+      while (true) {
+        if (buffer.reserve(16384) != TRI_ERROR_NO_ERROR) {
+          TRI_CLOSE(fd);
+          errorMsg = "out of memory";
+
+          return TRI_ERROR_OUT_OF_MEMORY;
+        }
+
+        ssize_t numRead = TRI_READ(fd, buffer.end(), 16384);
+
+        if (numRead < 0) {
+          // error while reading
+          int res = TRI_errno();
+          TRI_CLOSE(fd);
+          errorMsg = string(TRI_errno_string(res));
+
+          return res;
+        }
+
+        // read something
+        buffer.increaseLength(numRead);
+
+        Stats._totalRead += (uint64_t) numRead;
+
+        if (buffer.length() < ChunkSize && numRead > 0) {
+          // still continue reading
+          continue;
+        }
+
+        // do we have a buffer?
+        if (buffer.length() > 0) {
+          // look for the last \n in the buffer
+          char* found = (char*) memrchr((const void*) buffer.begin(), '\n', buffer.length());
+          size_t length;
+
+          if (found == nullptr) {
+            // no \n found...
+            if (numRead == 0) {
+              // we're at the end. send the complete buffer anyway
+              length = buffer.length();
+            }
+            else {
+              // read more
+              continue;
+            }
+          }
+          else {
+            // found a \n somewhere
+            length = found - buffer.begin();
+          }
+
+          TRI_ASSERT(length > 0);
+
+          Stats._totalBatches++;
+
+          int res = SendRestoreData(client, cname, buffer.begin(), length, errorMsg);
+
+          if (res != TRI_ERROR_NO_ERROR) {
+            if (errorMsg.empty()) {
+              errorMsg = string(TRI_errno_string(res));
+            }
+            else {
+              errorMsg = string(TRI_errno_string(res)) + ": " + errorMsg;
+            }
+
+            if (! Force) {
+              TRI_CLOSE(fd);
+              return res;
+            }
+
+            // skip this batch
+            cerr << errorMsg << endl;
+            errorMsg.clear();
+          }
+
+          buffer.erase_front(length);
+          offset += (uint64_t) length;
+
+          UpdateManifest(cname, created, offset, false);
+        }
+
+        if (numRead == 0) {
+          // EOF
+          break;
+        }
+      }
+
+      TRI_CLOSE(fd);
+    }
+  }
+
+
+  if (ImportStructure) {
+    // re-create indexes
+
+    if (TRI_LengthVector(&indexes->_value._objects) > 0) {
+      // we actually have indexes
+      if (Progress) {
+        cout << "Creating indexes for collection '" << cname << "'..." << endl;
+      }
+
+      int res = SendRestoreIndexes(client, job._json, errorMsg);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        if (Force) {
+          cerr << errorMsg << endl;
+          errorMsg.clear();
+          return TRI_ERROR_NO_ERROR;
+        }
+
+        return TRI_ERROR_INTERNAL;
+      }
+    }
+  }
+
+  UpdateManifest(cname, created, offset, true);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief request location rewriter (injects database name)
+////////////////////////////////////////////////////////////////////////////////
+
+static string rewriteLocation (void*, const string&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates an additional client for a worker thread
+///
+/// the client does not own its connection, which is returned separately and
+/// must be deleted after the client
+////////////////////////////////////////////////////////////////////////////////
+
+static SimpleHttpClient* CreateClient (GeneralClientConnection*& connection) {
+  connection = GeneralClientConnection::factory(BaseClient.endpointServer(),
+                                                BaseClient.requestTimeout(),
+                                                BaseClient.connectTimeout(),
+                                                ArangoClient::DEFAULT_RETRIES,
+                                                BaseClient.sslProtocol());
+
+  if (connection == nullptr) {
+    return nullptr;
+  }
+
+  SimpleHttpClient* client = new SimpleHttpClient(connection, BaseClient.requestTimeout(), false);
+
+  client->setLocationRewriter(nullptr, &rewriteLocation);
+  client->setUserNamePassword("/", BaseClient.username(), BaseClient.password());
+
+  return client;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief loads the data into the collections, using up to --threads
+/// collections in parallel. each worker thread uses its own connection
+////////////////////////////////////////////////////////////////////////////////
+
+static int RunJobs (vector<RestoreJob> const& jobs,
+                    string& errorMsg) {
+  size_t const numThreads = (std::min)((size_t) Threads, jobs.size());
+
+  if (numThreads <= 1) {
+    for (auto const& job : jobs) {
+      int res = RestoreCollectionData(Client, job, errorMsg);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+    }
+
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  std::atomic<size_t> next(0);
+  std::mutex errorLock;
+  int result = TRI_ERROR_NO_ERROR;
+
+  auto worker = [&] () {
+    GeneralClientConnection* connection = nullptr;
+    SimpleHttpClient* client = CreateClient(connection);
+
+    if (client == nullptr) {
+      std::lock_guard<std::mutex> locker(errorLock);
+
+      if (result == TRI_ERROR_NO_ERROR) {
+        result = TRI_ERROR_OUT_OF_MEMORY;
+        errorMsg = "out of memory";
+      }
+      return;
+    }
+
+    while (true) {
+      {
+        std::lock_guard<std::mutex> locker(errorLock);
+
+        if (result != TRI_ERROR_NO_ERROR) {
+          // another worker failed
+          break;
+        }
+      }
+
+      size_t const i = next++;
+
+      if (i >= jobs.size()) {
+        break;
+      }
+
+      string msg;
+      int res = RestoreCollectionData(client, jobs[i], msg);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        std::lock_guard<std::mutex> locker(errorLock);
+
+        if (result == TRI_ERROR_NO_ERROR) {
+          result = res;
+          errorMsg = msg;
+        }
+        break;
+      }
+    }
+
+    delete client;
+    delete connection;
+  };
+
+  vector<std::thread> threads;
+
+  for (size_t i = 0; i < numThreads; ++i) {
+    threads.emplace_back(worker);
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief process all files from the input directory
 ////////////////////////////////////////////////////////////////////////////////
@@ -724,187 +1205,62 @@ static int ProcessInputDirectory (string& errorMsg) {
   // sort collections according to type (documents before edges)
   qsort(collections->_value._objects._buffer, n, sizeof(TRI_json_t), &SortCollections);
 
-  StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
-
-  // step2: run the actual import
-  {
-    for (size_t i = 0; i < n; ++i) {
-      TRI_json_t const* json = (TRI_json_t const*) TRI_AtVector(&collections->_value._objects, i);
-      TRI_json_t const* parameters = JsonHelper::getObjectElement(json, "parameters");
-      TRI_json_t const* indexes = JsonHelper::getObjectElement(json, "indexes");
-      const string cname = JsonHelper::getStringValue(parameters, "name", "");
-      const string cid   = JsonHelper::getStringValue(parameters, "cid", "");
-
-      if (ImportStructure) {
-        // re-create collection
-        if (Progress) {
-          if (Overwrite) {
-            cout << "Re-creating collection '" << cname << "'..." << endl;
-          }
-          else {
-            cout << "Creating collection '" << cname << "'..." << endl;
-          }
-        }
-
-        int res = SendRestoreCollection(json, errorMsg);
+  vector<RestoreJob> jobs;
 
-        if (res != TRI_ERROR_NO_ERROR) {
-          if (Force) {
-            cerr << errorMsg << endl;
-            continue;
-          }
+  // step2: re-create the collections. this is done one after the other, in
+  // the sort order from above
+  for (size_t i = 0; i < n; ++i) {
+    TRI_json_t const* json = (TRI_json_t const*) TRI_AtVector(&collections->_value._objects, i);
+    TRI_json_t const* parameters = JsonHelper::getObjectElement(json, "parameters");
+    const string cname = JsonHelper::getStringValue(parameters, "name", "");
 
-          TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, collections);
+    ManifestEntry const entry = LookupManifest(cname);
 
-          return TRI_ERROR_INTERNAL;
-        }
+    if (entry._done) {
+      if (Progress) {
+        cout << "Collection '" << cname << "' was restored completely, skipping" << endl;
       }
+      continue;
+    }
 
-      Stats._totalCollections++;
-
-      if (ImportData) {
-        // import data. check if we have a datafile
-        // TODO: externalise file extension
-        const string datafile = InputDirectory + TRI_DIR_SEPARATOR_STR + cname + ".data.json";
-
-        if (TRI_ExistsFile(datafile.c_str())) {
-          // found a datafile
-
-          if (Progress) {
-            cout << "Loading data into collection '" << cname << "'..." << endl;
-          }
-
-          int fd = TRI_OPEN(datafile.c_str(), O_RDONLY);
-
-          if (fd < 0) {
-            errorMsg = "cannot open collection data file '" + datafile + "'";
-            TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, collections);
-
-            return TRI_ERROR_INTERNAL;
-          }
-
-          buffer.clear();
-
-          while (true) {
-            if (buffer.reserve(16384) != TRI_ERROR_NO_ERROR) {
-              TRI_CLOSE(fd);
-              errorMsg = "out of memory";
-              TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, collections);
-
-              return TRI_ERROR_OUT_OF_MEMORY;
-            }
-
-            ssize_t numRead = TRI_READ(fd, buffer.end(), 16384);
-
-            if (numRead < 0) {
-              // error while reading
-              int res = TRI_errno();
-              TRI_CLOSE(fd);
-              errorMsg = string(TRI_errno_string(res));
-              TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, collections);
-
-              return res;
-            }
-
-            // read something
-            buffer.increaseLength(numRead);
-
-            Stats._totalRead += (uint64_t) numRead;
-
-            if (buffer.length() < ChunkSize && numRead > 0) {
-              // still continue reading
-              continue;
-            }
-
-            // do we have a buffer?
-            if (buffer.length() > 0) {
-              // look for the last \n in the buffer
-              char* found = (char*) memrchr((const void*) buffer.begin(), '\n', buffer.length());
-              size_t length;
-
-              if (found == nullptr) {
-                // no \n found...
-                if (numRead == 0) {
-                  // we're at the end. send the complete buffer anyway
-                  length = buffer.length();
-                }
-                else {
-                  // read more
-                  continue;
-                }
-              }
-              else {
-                // found a \n somewhere
-                length = found - buffer.begin();
-              }
-
-              TRI_ASSERT(length > 0);
-
-              Stats._totalBatches++;
-
-              int res = SendRestoreData(cname, buffer.begin(), length, errorMsg);
-
-              if (res != TRI_ERROR_NO_ERROR) {
-                TRI_CLOSE(fd);
-                if (errorMsg.empty()) {
-                  errorMsg = string(TRI_errno_string(res));
-                }
-                else {
-                  errorMsg = string(TRI_errno_string(res)) + ": " + errorMsg;
-                }
-
-                if (Force) {
-                  cerr << errorMsg << endl;
-                  continue;
-                }
-
-                TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, collections);
-                return res;
-              }
-
-              buffer.erase_front(length);
-            }
-
-            if (numRead == 0) {
-              // EOF
-              break;
-            }
-          }
-
-          TRI_CLOSE(fd);
+    if (ImportStructure && ! entry._created) {
+      // re-create collection
+      if (Progress) {
+        if (Overwrite) {
+          cout << "Re-creating collection '" << cname << "'..." << endl;
+        }
+        else {
+          cout << "Creating collection '" << cname << "'..." << endl;
         }
       }
 
+      int res = SendRestoreCollection(Client, json, errorMsg);
 
-      if (ImportStructure) {
-        // re-create indexes
+      if (res != TRI_ERROR_NO_ERROR) {
+        if (Force) {
+          cerr << errorMsg << endl;
+          continue;
+        }
 
-        if (TRI_LengthVector(&indexes->_value._objects) > 0) {
-          // we actually have indexes
-          if (Progress) {
-            cout << "Creating indexes for collection '" << cname << "'..." << endl;
-          }
+        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, collections);
 
-          int res = SendRestoreIndexes(json, errorMsg);
+        return TRI_ERROR_INTERNAL;
+      }
 
-          if (res != TRI_ERROR_NO_ERROR) {
-            if (Force) {
-              cerr << errorMsg << endl;
-              continue;
-            }
+      UpdateManifest(cname, true, 0, false);
+    }
 
-            TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, collections);
+    Stats._totalCollections++;
 
-            return TRI_ERROR_INTERNAL;
-          }
-        }
-      }
-    }
+    jobs.push_back(RestoreJob{ json, cname });
   }
 
+  // step3: load the data and create the indexes, possibly in parallel
+  int res = RunJobs(jobs, errorMsg);
+
   TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, collections);
 
-  return TRI_ERROR_NO_ERROR;
+  return res;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -977,6 +1333,23 @@ int main (int argc, char* argv[]) {
     TRI_EXIT_FUNCTION(EXIT_FAILURE, nullptr);
   }
 
+  if (Threads < 1) {
+    Threads = 1;
+  }
+
+  if (Resume) {
+    string errorMsg;
+
+    if (ReadManifest(errorMsg) != TRI_ERROR_NO_ERROR) {
+      cerr << errorMsg << endl;
+      TRI_EXIT_FUNCTION(EXIT_FAILURE, nullptr);
+    }
+  }
+  else if (TRI_ExistsFile(ManifestFilename().c_str())) {
+    // remove the manifest of an earlier restore
+    TRI_UnlinkFile(ManifestFilename().c_str());
+  }
+
   // .............................................................................
   // set-up client connection
   // .............................................................................
@@ -1071,7 +1444,9 @@ int main (int argc, char* argv[]) {
     cout << "Connected to ArangoDB '" << BaseClient.endpointServer()->getSpecification() << endl;
   }
 
-  memset(&Stats, 0, sizeof(Stats));
+  Stats._totalBatches     = 0;
+  Stats._totalCollections = 0;
+  Stats._totalRead        = 0;
 
   string errorMsg = "";
 
@@ -1091,12 +1466,12 @@ int main (int argc, char* argv[]) {
 
   if (Progress) {
     if (ImportData) {
-      cout << "Processed " << Stats._totalCollections << " collection(s), " <<
-              "read " << Stats._totalRead << " byte(s) from datafiles, " <<
-              "sent " << Stats._totalBatches << " batch(es)" << endl;
+      cout << "Processed " << Stats._totalCollections.load() << " collection(s), " <<
+              "read " << Stats._totalRead.load() << " byte(s) from datafiles, " <<
+              "sent " << Stats._totalBatches.load() << " batch(es)" << endl;
     }
     else if (ImportStructure) {
-      cout << "Processed " << Stats._totalCollections << " collection(s)" << endl;
+      cout << "Processed " << Stats._totalCollections.load() << " collection(s)" << endl;
     }
   }
 
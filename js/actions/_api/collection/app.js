@@ -71,6 +71,11 @@ function collectionRepresentation (collection, showProperties, showCount, showFi
     result.waitForSync   = properties.waitForSync;
     result.indexBuckets  = properties.indexBuckets;
 
+    result.compactionDeadSizeThreshold = properties.compactionDeadSizeThreshold;
+    result.compactionDeadSizeShare     = properties.compactionDeadSizeShare;
+    result.compactionMaxFileSize       = properties.compactionMaxFileSize;
+    result.compressDatafiles           = properties.compressDatafiles;
+
     if (cluster.isCoordinator()) {
       result.shardKeys = properties.shardKeys;
       result.numberOfShards = properties.numberOfShards;
@@ -141,6 +146,15 @@ function parseBodyForCreateCollection (req, res) {
     r.parameter.indexBuckets = body.indexBuckets;
   }
 
+  [ "compactionDeadSizeThreshold",
+    "compactionDeadSizeShare",
+    "compactionMaxFileSize",
+    "compressDatafiles" ].forEach(function (attribute) {
+    if (body.hasOwnProperty(attribute)) {
+      r.parameter[attribute] = body[attribute];
+    }
+  });
+
   if (body.hasOwnProperty("keyOptions")) {
     r.parameter.keyOptions = body.keyOptions;
   }
@@ -211,6 +225,12 @@ function parseBodyForCreateCollection (req, res) {
 ///   should threrefore be used for cache-type collections only, and not 
 ///   for data that cannot be re-created otherwise.
 ///
+/// - *compressDatafiles* (optional, default is *false*): If *true*, the
+///   compactor rewrites sealed datafiles of the collection into a
+///   block-compressed format. This saves disk space for read-mostly
+///   collections, at the price of decompressing the datafiles when the
+///   collection is loaded. Journals are never compressed.
+///
 /// - *keyOptions* (optional) additional options for key generation. If
 ///   specified, then *keyOptions* should be a JSON array containing the
 ///   following attributes (note: some of them are optional):
@@ -633,8 +653,22 @@ function get_api_collections (req, res) {
 /// - *figures.datafiles.count*: The number of datafiles.
 /// - *figures.datafiles.fileSize*: The total filesize of datafiles (in bytes).
 ///
+/// - *figures.datafiles.compressedCount*: The number of datafiles that are
+///   stored compressed on disk.
+///
+/// - *figures.datafiles.compressedFileSize*: The total size of the compressed
+///   datafiles on disk (in bytes).
+///
+/// - *figures.datafiles.residentSize*: The number of bytes of the datafiles
+///   currently held in memory.
+///
+/// - *figures.datafiles.coldCount*: The number of datafiles that were dropped
+///   from memory because they were not read for a while.
+///
 /// - *figures.journals.count*: The number of journal files.
 /// - *figures.journals.fileSize*: The total filesize of all journal files (in bytes).
+/// - *figures.journals.residentSize*: The number of bytes of the journal files
+///   currently held in memory.
 ///
 /// - *figures.compactors.count*: The number of compactor files.
 /// - *figures.compactors.fileSize*: The total filesize of all compactor files (in bytes).
@@ -1227,6 +1261,17 @@ function put_api_collection_truncate (req, res, collection) {
 ///   additional journals or datafiles that are created. Already
 ///   existing journals or datafiles will not be affected.
 ///
+/// - *compactionDeadSizeThreshold*: The minimum size of dead data (in bytes)
+///   in a datafile that makes the datafile eligible for compaction.
+///
+/// - *compactionDeadSizeShare*: The minimum share of dead data (between 0
+///   and 1) in a datafile that makes the datafile eligible for compaction.
+///
+/// - *compactionMaxFileSize*: The maximum size of a compacted file in bytes.
+///
+/// - *compressDatafiles*: If *true*, the following compaction runs will
+///   compress the sealed datafiles of the collection.
+///
 /// On success an object with the following attributes is returned:
 ///
 /// - *id*: The identifier of the collection.
@@ -489,6 +489,9 @@ function processQuery (query, explain) {
                  (node.count ? " " + keyword("WITH COUNT") : "") + 
                  (node.outVariable ? " " + keyword("INTO") + " " + variableName(node.outVariable) : "") +
                  (node.keepVariables ? " " + keyword("KEEP") + " " + node.keepVariables.map(function(variable) { return variableName(variable); }).join(", ") : "") + 
+                 (node.aggregateFunctions ? " " + keyword("AGGREGATE") + " " + node.aggregateFunctions.map(function(node) {
+                   return variableName(node.outVariable) + " = " + func(node.type) + "(" + variableName(node.inVariable) + ")";
+                 }).join(", ") : "") + 
                  "   " + annotation("/* " + node.aggregationOptions.method + "*/");
       case "SortNode":
         return keyword("SORT") + " " + node.elements.map(function(node) {
@@ -995,6 +995,48 @@ function CollectionSuite () {
       db._drop(cn);
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test first / last after updates, with and without cap constraint
+////////////////////////////////////////////////////////////////////////////////
+
+    testFirstLastAfterUpdate : function () {
+      var cn = "example";
+
+      [ false, true ].forEach(function (capped) {
+        db._drop(cn);
+        var c1 = db._create(cn);
+
+        if (capped) {
+          c1.ensureCapConstraint(1000);
+        }
+
+        for (var i = 0; i < 100; ++i) {
+          c1.save({ _key : "test" + i, "value" : i });
+        }
+
+        c1.update("test0", { "value" : 100 });
+        c1.update("test50", { "value" : 101 });
+
+        var actual = c1.first(2);
+        assertEqual(2, actual.length);
+        assertEqual("test1", actual[0]._key);
+        assertEqual("test2", actual[1]._key);
+
+        actual = c1.last(3);
+        assertEqual(3, actual.length);
+        assertEqual("test50", actual[0]._key);
+        assertEqual("test0", actual[1]._key);
+        assertEqual("test99", actual[2]._key);
+
+        actual = c1.first(100);
+        assertEqual(100, actual.length);
+        assertEqual("test49", actual[48]._key);
+        assertEqual("test51", actual[49]._key);
+      });
+
+      db._drop(cn);
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test system collection dropping / renaming / unloading
 ////////////////////////////////////////////////////////////////////////////////
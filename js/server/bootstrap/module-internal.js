@@ -125,6 +125,21 @@ exports.wal = {
   }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cleanup and compaction scheduler object
+////////////////////////////////////////////////////////////////////////////////
+
+exports.maintenance = {
+
+  queue: function () {
+    return global.MAINTENANCE_QUEUE.apply(null, arguments);
+  },
+
+  properties: function () {
+    return global.MAINTENANCE_PROPERTIES.apply(null, arguments);
+  }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief defines an action
 ////////////////////////////////////////////////////////////////////////////////
@@ -3745,6 +3745,45 @@ function AQL_WITHIN_RECTANGLE (collection, latitude1, longitude1, latitude2, lon
   return COLLECTION(collection).withinRectangle(latitude1, longitude1, latitude2, longitude2).toArray();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the distance between two points in meters
+////////////////////////////////////////////////////////////////////////////////
+
+function AQL_DISTANCE (latitude1, longitude1, latitude2, longitude2) {
+  'use strict';
+
+  if (TYPEWEIGHT(latitude1) !== TYPEWEIGHT_NUMBER ||
+      TYPEWEIGHT(longitude1) !== TYPEWEIGHT_NUMBER ||
+      TYPEWEIGHT(latitude2) !== TYPEWEIGHT_NUMBER ||
+      TYPEWEIGHT(longitude2) !== TYPEWEIGHT_NUMBER) {
+    WARN("DISTANCE", INTERNAL.errors.ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return null;
+  }
+
+  // the geo index rejects coordinates that are out of range, too
+  if (latitude1 < -90 || latitude1 > 90 || longitude1 < -180 || longitude1 > 180 ||
+      latitude2 < -90 || latitude2 > 90 || longitude2 < -180 || longitude2 > 180) {
+    WARN("DISTANCE", INTERNAL.errors.ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return null;
+  }
+
+  // same calculation as in the geo index
+  var toRadians = Math.PI / 180.0;
+  var z1 = Math.sin(latitude1 * toRadians);
+  var x1 = Math.cos(latitude1 * toRadians) * Math.cos(longitude1 * toRadians);
+  var y1 = Math.cos(latitude1 * toRadians) * Math.sin(longitude1 * toRadians);
+  var z2 = Math.sin(latitude2 * toRadians);
+  var x2 = Math.cos(latitude2 * toRadians) * Math.cos(longitude2 * toRadians);
+  var y2 = Math.cos(latitude2 * toRadians) * Math.sin(longitude2 * toRadians);
+  var mole = Math.sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2) + (z1 - z2) * (z1 - z2));
+
+  if (mole > 2.0) {
+    mole = 2.0;
+  }
+
+  return 2.0 * 6371000.0 * Math.asin(mole / 2.0);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return true if a point is contained inside a polygon
 ////////////////////////////////////////////////////////////////////////////////
@@ -8496,6 +8535,7 @@ exports.AQL_STDDEV_POPULATION = AQL_STDDEV_POPULATION;
 exports.AQL_NEAR = AQL_NEAR;
 exports.AQL_WITHIN = AQL_WITHIN;
 exports.AQL_WITHIN_RECTANGLE = AQL_WITHIN_RECTANGLE;
+exports.AQL_DISTANCE = AQL_DISTANCE;
 exports.AQL_IS_IN_POLYGON = AQL_IS_IN_POLYGON;
 exports.AQL_FULLTEXT = AQL_FULLTEXT;
 exports.AQL_PATHS = AQL_PATHS;
@@ -1448,7 +1448,8 @@ function runArangoImp (options, instanceInfo, what) {
   return executeAndWait(arangoimp, toArgv(args));
 }
 
-function runArangoDumpRestore (options, instanceInfo, which, database) {
+function runArangoDumpRestore (options, instanceInfo, which, database,
+                               directory, cmds) {
   var args = {
     "configuration":   "none",
     "server.username": options.username,
@@ -1457,18 +1458,63 @@ function runArangoDumpRestore (options, instanceInfo, which, database) {
     "server.database": database
   };
   var exe;
+  if (directory === undefined) {
+    directory = "dump";
+  }
   if (which === "dump") {
-    args["output-directory"] = fs.join(instanceInfo.tmpDataDir,"dump");
+    args["output-directory"] = fs.join(instanceInfo.tmpDataDir,directory);
     exe = fs.join("bin","arangodump");
   }
   else {
     args["create-database"] = "true";
-    args["input-directory"] = fs.join(instanceInfo.tmpDataDir,"dump");
+    args["input-directory"] = fs.join(instanceInfo.tmpDataDir,directory);
     exe = fs.join("bin","arangorestore");
   }
+  args = _.extend(args, cmds);
   return executeAndWait(exe, toArgv(args));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief makes a finished dump look interrupted
+///
+/// one data file is shorter than recorded in the manifest, so its collection
+/// must be dumped again from the start. another one has data beyond the
+/// recorded size, which must be cut off
+////////////////////////////////////////////////////////////////////////////////
+
+function interruptDump (directory) {
+  var manifestFile = fs.join(directory, "dump.manifest.json");
+  var manifest = JSON.parse(fs.read(manifestFile));
+  var entry, dataFile;
+
+  entry = manifest.collections.UnitTestsDumpMany;
+  dataFile = fs.join(directory, "UnitTestsDumpMany.data.json");
+  entry.done = false;
+  entry.size = fs.size(dataFile) + 1000;
+
+  entry = manifest.collections.UnitTestsDumpEdges;
+  dataFile = fs.join(directory, "UnitTestsDumpEdges.data.json");
+  entry.done = false;
+  fs.write(dataFile, fs.read(dataFile) + "{\"type\":2300,\"data\":{\"_key\":\"broken");
+
+  fs.write(manifestFile, JSON.stringify(manifest));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief makes a finished restore look interrupted
+///
+/// one collection must be re-created and loaded again
+////////////////////////////////////////////////////////////////////////////////
+
+function interruptRestore (directory) {
+  var manifestFile = fs.join(directory, "restore.manifest.json");
+  var manifest = JSON.parse(fs.read(manifestFile));
+
+  manifest.collections.UnitTestsDumpMany = { created: false, offset: 0, done: false };
+
+  fs.write(manifestFile, JSON.stringify(manifest));
+}
+
 function runArangoBenchmark (options, instanceInfo, cmds) {
   var args = {
     "configuration":   "none",
@@ -1796,6 +1842,45 @@ testFuncs.dump = function (options) {
         results.test = runInArangosh(options, instanceInfo,
                                      makePathUnix("js/server/tests/dump"+cluster+".js"),
                                      { "server.database": "UnitTestsDumpDst"});
+        if (! options.cluster &&
+            checkInstanceAlive(instanceInfo, options) &&
+            results.test.status === true) {
+          // --resume is not supported on a cluster
+          print(Date() + ": Dump and Restore - dump with threads");
+          results.dumpThreads = runArangoDumpRestore(options, instanceInfo, "dump",
+                                                     "UnitTestsDumpSrc", "dump-resume",
+                                                     { "threads": "4" });
+          if (results.dumpThreads.status === true) {
+            print(Date() + ": Dump and Restore - resume dump");
+            interruptDump(fs.join(instanceInfo.tmpDataDir, "dump-resume"));
+            results.dumpResume = runArangoDumpRestore(options, instanceInfo, "dump",
+                                                      "UnitTestsDumpSrc", "dump-resume",
+                                                      { "threads": "4", "resume": "true" });
+          }
+          if (checkInstanceAlive(instanceInfo, options) &&
+              results.dumpResume !== undefined &&
+              results.dumpResume.status === true) {
+            print(Date() + ": Dump and Restore - restore with threads");
+            results.restoreThreads = runArangoDumpRestore(options, instanceInfo, "restore",
+                                                          "UnitTestsDumpDst", "dump-resume",
+                                                          { "threads": "4" });
+            if (results.restoreThreads.status === true) {
+              print(Date() + ": Dump and Restore - resume restore");
+              interruptRestore(fs.join(instanceInfo.tmpDataDir, "dump-resume"));
+              results.restoreResume = runArangoDumpRestore(options, instanceInfo, "restore",
+                                                           "UnitTestsDumpDst", "dump-resume",
+                                                           { "threads": "4", "resume": "true" });
+            }
+          }
+          if (checkInstanceAlive(instanceInfo, options) &&
+              results.restoreResume !== undefined &&
+              results.restoreResume.status === true) {
+            print(Date() + ": Dump and Restore - dump 3");
+            results.testResume = runInArangosh(options, instanceInfo,
+                                               makePathUnix("js/server/tests/dump.js"),
+                                               { "server.database": "UnitTestsDumpDst"});
+          }
+        }
         if (checkInstanceAlive(instanceInfo, options)) {
           print(Date() + ": Dump and Restore - teardown");
           results.tearDown = runInArangosh(options, instanceInfo,
@@ -0,0 +1,273 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for query language, scalar values stored inline
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2015 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2015, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+var helper = require("org/arangodb/aql-helper");
+var getQueryResults = helper.getQueryResults;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+///
+/// members of a literal array are enumerated as JSON values, while results of
+/// function calls such as PASSTHRU() are stored inline if they are scalars.
+/// strings are stored inline up to 7 bytes
+////////////////////////////////////////////////////////////////////////////////
+
+function ahuacatlInlineValuesTestSuite () {
+  var cn = "UnitTestsAhuacatlInlineValues";
+  var c;
+
+  var values = [
+    null,
+    false,
+    true,
+    0,
+    -1,
+    1.5,
+    1e300,
+    "",
+    "0",
+    "a",
+    "null",
+    "abcdef",
+    "abcdefg",
+    "abcdefgh",
+    "abcdefghi",
+    "äöü",
+    "aäöü",
+    "abäöü",
+    "äöüß"
+  ];
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn);
+      c = db._create(cn);
+
+      values.forEach(function (value, i) {
+        c.save({ _key: "test" + i, value: value });
+      });
+
+      c.save({ _key: "abcdefg", value: "short key" });
+      c.save({ _key: "abcdefgh", value: "long key" });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test equality of inline values and their JSON equivalents
+////////////////////////////////////////////////////////////////////////////////
+
+    testEquality : function () {
+      var query = "FOR a IN @values FOR b IN @values " +
+                  "LET inlineA = PASSTHRU(a) LET inlineB = PASSTHRU(b) " +
+                  "RETURN [ a == b, a == inlineB, inlineA == b, inlineA == inlineB, " +
+                  "a != inlineB, inlineA != inlineB, a IN [ inlineB ], inlineA IN [ b ] ]";
+
+      var actual = getQueryResults(query, { values: values });
+      assertEqual(values.length * values.length, actual.length);
+
+      actual.forEach(function (row, n) {
+        // all values are different from each other
+        var equal = (Math.floor(n / values.length) === n % values.length);
+        assertEqual([ equal, equal, equal, equal, ! equal, ! equal, equal, equal ], row, JSON.stringify(row));
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test comparison of inline values and their JSON equivalents
+////////////////////////////////////////////////////////////////////////////////
+
+    testCompare : function () {
+      var query = "FOR a IN @values FOR b IN @values " +
+                  "LET inlineA = PASSTHRU(a) LET inlineB = PASSTHRU(b) " +
+                  "RETURN [ [ a < b, a <= b, a > b, a >= b ], [ a < inlineB, a <= inlineB, a > inlineB, a >= inlineB ], " +
+                  "[ inlineA < b, inlineA <= b, inlineA > b, inlineA >= b ], " +
+                  "[ inlineA < inlineB, inlineA <= inlineB, inlineA > inlineB, inlineA >= inlineB ] ]";
+
+      var actual = getQueryResults(query, { values: values });
+      assertEqual(values.length * values.length, actual.length);
+
+      actual.forEach(function (row) {
+        assertEqual(row[0], row[1]);
+        assertEqual(row[0], row[2]);
+        assertEqual(row[0], row[3]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test sorting a mix of inline values and their JSON equivalents
+////////////////////////////////////////////////////////////////////////////////
+
+    testSort : function () {
+      var expected = getQueryResults("FOR v IN @values SORT v RETURN v", { values: values });
+
+      var actual = getQueryResults("FOR v IN @values LET inline = PASSTHRU(v) SORT inline RETURN inline", { values: values });
+      assertEqual(expected, actual);
+
+      actual = getQueryResults("FOR v IN @values FOR i IN 1..2 LET value = (i == 1 ? v : PASSTHRU(v)) SORT value, i RETURN value", { values: values });
+      assertEqual(values.length * 2, actual.length);
+
+      for (var i = 0; i < expected.length; ++i) {
+        assertEqual(expected[i], actual[i * 2]);
+        assertEqual(expected[i], actual[i * 2 + 1]);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test hashing of inline values and their JSON equivalents
+////////////////////////////////////////////////////////////////////////////////
+
+    testCollect : function () {
+      [ "hash", "sorted" ].forEach(function (method) {
+        var query = "FOR v IN @values FOR i IN 1..2 LET value = (i == 1 ? v : PASSTHRU(v)) " +
+                    "COLLECT key = value WITH COUNT INTO n OPTIONS { method: '" + method + "' } RETURN [ key, n ]";
+
+        var actual = getQueryResults(query, { values: values });
+        assertEqual(values.length, actual.length, method);
+
+        actual.forEach(function (row) {
+          assertEqual(2, row[1], JSON.stringify(row));
+        });
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the boundary of inline strings
+////////////////////////////////////////////////////////////////////////////////
+
+    testStringBoundary : function () {
+      var strings = [ "abcdefg", "abcdefgh", "abäöü", "abcäöü", "äöüx", "äöüß" ];
+      var query = "FOR s IN @strings LET value = PASSTHRU(s) LET concat = CONCAT(SUBSTRING(s, 0, 1), SUBSTRING(s, 1)) " +
+                  "RETURN [ value, LENGTH(value), value == s, concat == s, concat == value, " +
+                  "CONCAT(value, 'x'), SUBSTRING(CONCAT(value, 'x'), 0, LENGTH(s)) == value ]";
+
+      var actual = getQueryResults(query, { strings: strings });
+      assertEqual(strings.length, actual.length);
+
+      actual.forEach(function (row, i) {
+        assertEqual(strings[i], row[0]);
+        assertEqual(strings[i].length, row[1]);
+        assertEqual([ true, true, true ], row.slice(2, 5));
+        assertEqual(strings[i] + "x", row[5]);
+        assertTrue(row[6]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test attribute values read from documents
+////////////////////////////////////////////////////////////////////////////////
+
+    testDocumentAttributes : function () {
+      var query = "FOR doc IN " + cn + " FILTER LIKE(doc._key, 'test%') FOR v IN @values " +
+                  "FILTER doc.value == v SORT TO_NUMBER(SUBSTRING(doc._key, 4)) RETURN [ doc._key, doc.value, v == PASSTHRU(doc.value) ]";
+
+      var actual = getQueryResults(query, { values: values });
+      assertEqual(values.length, actual.length);
+
+      actual.forEach(function (row, i) {
+        assertEqual([ "test" + i, values[i], true ], row);
+      });
+
+      query = "FOR doc IN " + cn + " FILTER LIKE(doc._key, 'abc%') SORT doc._key " +
+              "RETURN [ doc._key, LENGTH(doc._key), doc._key == CONCAT('', doc._key), doc._id == CONCAT(@cn, '/', doc._key) ]";
+
+      actual = getQueryResults(query, { cn: cn });
+      assertEqual([ [ "abcdefg", 7, true, true ], [ "abcdefgh", 8, true, true ] ], actual);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test cloning and destroying inline values in item blocks
+////////////////////////////////////////////////////////////////////////////////
+
+    testItemBlocks : function () {
+      // subquery results are cloned into the enumerating block, sorted rows
+      // are moved between blocks of 1000 rows
+      var query = "LET inline = (FOR v IN @values RETURN PASSTHRU(v)) " +
+                  "FOR i IN 1..150 FOR value IN inline " +
+                  "LET copy = (FOR x IN inline FILTER x == value RETURN x) " +
+                  "SORT i DESC, value LIMIT 5, 2000 " +
+                  "RETURN [ value, copy ]";
+
+      var actual = getQueryResults(query, { values: values });
+      assertEqual(2000, actual.length);
+
+      actual.forEach(function (row) {
+        assertEqual([ row[0] ], row[1]);
+      });
+
+      var sorted = getQueryResults("FOR v IN @values SORT v RETURN v", { values: values });
+
+      query = "FOR i IN 1..3 LET sub = (FOR v IN @values LET value = PASSTHRU(v) SORT value RETURN value) RETURN sub";
+      actual = getQueryResults(query, { values: values });
+      assertEqual([ sorted, sorted, sorted ], actual);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the results of a query are not changed by inline values
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var result = AQL_EXECUTE("FOR v IN @values RETURN PASSTHRU(v)", { values: values }).json;
+      assertEqual(values, result);
+
+      result = AQL_EXECUTE("FOR v IN @values RETURN [ v, PASSTHRU(v) ]", { values: values }).json;
+      result.forEach(function (row, i) {
+        assertEqual([ values[i], values[i] ], row);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(ahuacatlInlineValuesTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
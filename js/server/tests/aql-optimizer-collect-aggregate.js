@@ -0,0 +1,210 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertNull, assertTrue, AQL_EXECUTE, AQL_EXPLAIN */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for COLLECT w/ AGGREGATE
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var internal = require("internal");
+var errors = internal.errors;
+var db = require("org/arangodb").db;
+var helper = require("org/arangodb/aql-helper");
+var assertQueryError = helper.assertQueryError;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerAggregateTestSuite () {
+  var c;
+
+  return {
+    setUp : function () {
+      db._drop("UnitTestsCollection");
+      c = db._create("UnitTestsCollection");
+
+      for (var i = 0; i < 1000; ++i) {
+        c.save({ group: "test" + (i % 10), value: i });
+      }
+    },
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test invalid syntax
+////////////////////////////////////////////////////////////////////////////////
+
+    testInvalidSyntax : function () {
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT AGGREGATE RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT AGGREGATE length RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT AGGREGATE length = 1 RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT AGGREGATE length = i.value RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT AGGREGATE length = CONCAT(i.value) RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT AGGREGATE length = LENGTH(i.value) + 1 RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT AGGREGATE length = LENGTH(i.value) INTO g RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT group = i.group INTO g AGGREGATE length = LENGTH(i.value) RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT group = i.group AGGREGATE length = LENGTH(group) RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT AGGREGATE a = SUM(i.value), b = SUM(a) RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT group = i.group AGGREGATE a = LENGTH(i.value) KEEP i RETURN 1");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR i IN " + c.name() + " COLLECT group = i.group KEEP a = LENGTH(i.value) RETURN 1");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test aggregate without groups
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateTotal : function () {
+      var query = "FOR i IN " + c.name() + " COLLECT AGGREGATE length = LENGTH(i), count = COUNT(1), min = MIN(i.value), max = MAX(i.value), sum = SUM(i.value), avg = AVERAGE(i.value) RETURN { length: length, count: count, min: min, max: max, sum: sum, avg: avg }";
+
+      var results = AQL_EXECUTE(query);
+      assertEqual(1, results.json.length);
+      assertEqual({ length: 1000, count: 1000, min: 0, max: 999, sum: 499500, avg: 499.5 }, results.json[0]);
+
+      var plan = AQL_EXPLAIN(query).plan;
+      // must not have a SortNode
+      assertEqual(-1, plan.nodes.map(function(node) { return node.type; }).indexOf("SortNode"));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test aggregate without groups, empty input
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateTotalEmpty : function () {
+      var query = "FOR i IN " + c.name() + " FILTER i.group == 'test99' COLLECT AGGREGATE length = LENGTH(i), min = MIN(i.value), max = MAX(i.value), sum = SUM(i.value), avg = AVERAGE(i.value) RETURN { length: length, min: min, max: max, sum: sum, avg: avg }";
+
+      var results = AQL_EXECUTE(query);
+      assertEqual(1, results.json.length);
+      assertEqual({ length: 0, min: null, max: null, sum: 0, avg: null }, results.json[0]);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test aggregate with groups
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateGrouped : function () {
+      [ [ "", "hash" ], [ "OPTIONS { method: 'sorted' }", "sorted" ] ].forEach(function(data) {
+        var query = "FOR i IN " + c.name() + " COLLECT group = i.group AGGREGATE length = LENGTH(i), min = MIN(i.value), max = MAX(i.value), sum = SUM(i.value), avg = AVERAGE(i.value) " + data[0] + " SORT group RETURN { group: group, length: length, min: min, max: max, sum: sum, avg: avg }";
+
+        var results = AQL_EXECUTE(query);
+        assertEqual(10, results.json.length);
+        for (var i = 0; i < 10; ++i) {
+          assertEqual({ group: "test" + i, length: 100, min: i, max: 990 + i, sum: 49500 + 100 * i, avg: 495 + i }, results.json[i]);
+        }
+
+        var plan = AQL_EXPLAIN(query).plan;
+        var collectNodes = plan.nodes.filter(function(node) { return node.type === "AggregateNode"; });
+        assertEqual(1, collectNodes.length);
+        assertEqual(5, collectNodes[0].aggregateFunctions.length);
+        assertEqual(data[1], collectNodes[0].aggregationOptions.method);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test aggregate with expressions and null values
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateExpressions : function () {
+      var query = "FOR i IN " + c.name() + " COLLECT group = i.value % 2 AGGREGATE sum = SUM(i.value % 2 == 0 ? null : i.value * 2), max = MAX(i.value % 2 == 0 ? null : i.value), min = MIN(i.missing) SORT group RETURN { group: group, sum: sum, max: max, min: min }";
+
+      var results = AQL_EXECUTE(query);
+      assertEqual(2, results.json.length);
+      assertEqual({ group: 0, sum: 0, max: null, min: null }, results.json[0]);
+      assertEqual({ group: 1, sum: 500000, max: 999, min: null }, results.json[1]);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test aggregate with non-numeric values
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateNonNumeric : function () {
+      var query = "FOR i IN " + c.name() + " COLLECT AGGREGATE sum = SUM(i.group), avg = AVERAGE(i.group), min = MIN(i.group), max = MAX(i.group) RETURN { sum: sum, avg: avg, min: min, max: max }";
+
+      var results = AQL_EXECUTE(query);
+      assertEqual(1, results.json.length);
+      assertEqual({ sum: null, avg: null, min: "test0", max: "test9" }, results.json[0]);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test variance and standard deviation
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateVariance : function () {
+      var query = "FOR i IN [ 1, 2, 3, 4, null ] COLLECT AGGREGATE vp = VARIANCE_POPULATION(i), vs = VARIANCE_SAMPLE(i), sp = STDDEV_POPULATION(i), ss = STDDEV_SAMPLE(i) RETURN [ vp, vs, sp, ss ]";
+
+      var results = AQL_EXECUTE(query);
+      assertEqual(1, results.json.length);
+      var expected = AQL_EXECUTE("RETURN [ VARIANCE_POPULATION([ 1, 2, 3, 4 ]), VARIANCE_SAMPLE([ 1, 2, 3, 4 ]), STDDEV_POPULATION([ 1, 2, 3, 4 ]), STDDEV_SAMPLE([ 1, 2, 3, 4 ]) ]").json[0];
+      for (var i = 0; i < 4; ++i) {
+        assertTrue(Math.abs(expected[i] - results.json[0][i]) < 0.0001);
+      }
+
+      query = "FOR i IN [ 1 ] COLLECT AGGREGATE vp = VARIANCE_POPULATION(i), vs = VARIANCE_SAMPLE(i) RETURN [ vp, vs ]";
+      results = AQL_EXECUTE(query);
+      assertEqual(0, results.json[0][0]);
+      assertNull(results.json[0][1]);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test aggregate in subquery
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateSubquery : function () {
+      var query = "FOR j IN 1..3 LET s = (FOR i IN " + c.name() + " FILTER i.value < j * 10 COLLECT AGGREGATE sum = SUM(i.value) RETURN sum) RETURN s[0]";
+
+      var results = AQL_EXECUTE(query);
+      assertEqual([ 45, 190, 435 ], results.json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test aggregate with shaped values
+////////////////////////////////////////////////////////////////////////////////
+
+    testAggregateShaped : function () {
+      var query = "FOR i IN " + c.name() + " COLLECT AGGREGATE min = MIN(i), max = MAX(i) RETURN [ min.value, max.value ]";
+
+      var results = AQL_EXECUTE(query);
+      assertEqual(1, results.json.length);
+      assertEqual(2, results.json[0].length);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerAggregateTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
@@ -0,0 +1,229 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertTrue, assertEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rule distribute-collect-to-cluster
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2015 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Copyright 2015, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var db = require("org/arangodb").db;
+var jsunity = require("jsunity");
+var helper = require("org/arangodb/aql-helper");
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "distribute-collect-to-cluster";
+  // various choices to control the optimizer:
+  var rulesAll         = { optimizer: { rules: [ "+all" ] } };
+  var thisRuleDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+
+  var cn = "UnitTestsAqlOptimizerRuleDistributeCollect";
+  var c;
+
+  var explain = function (result) {
+    return helper.getCompactPlan(result).map(function(node)
+        { return node.type; });
+  };
+
+  // returns the AggregateNodes of the plan, the partial one (below the
+  // RemoteNode) first
+  var aggregateNodes = function (result) {
+    return helper.findExecutionNodes(result, "AggregateNode");
+  };
+
+  return {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief set up
+    ////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      var i;
+      db._drop(cn);
+      c = db._create(cn, { numberOfShards: 4 });
+      for (i = 0; i < 1000; i++) {
+        c.insert({ group: "test" + (i % 10), value: i });
+      }
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief tear down
+    ////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief test that rule does not fire when it is disabled
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testThisRuleDisabled : function () {
+      var queries = [
+        "FOR d IN " + cn + " COLLECT group = d.group WITH COUNT INTO count RETURN { group: group, count: count }",
+        "FOR d IN " + cn + " COLLECT group = d.group AGGREGATE sum = SUM(d.value) RETURN { group: group, sum: sum }"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, thisRuleDisabled);
+        assertTrue(result.plan.rules.indexOf(ruleName) === -1, query);
+        assertEqual(1, aggregateNodes(result).length, query);
+      });
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief test that rule has no effect
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [
+        // aggregates that cannot be computed from partial results
+        "FOR d IN " + cn + " COLLECT group = d.group AGGREGATE avg = AVERAGE(d.value) RETURN { group: group, avg: avg }",
+        "FOR d IN " + cn + " COLLECT group = d.group AGGREGATE sum = SUM(d.value), avg = AVERAGE(d.value) RETURN { group: group, sum: sum, avg: avg }",
+        "FOR d IN " + cn + " COLLECT AGGREGATE min = MIN(d.value), stddev = STDDEV(d.value) RETURN { min: min, stddev: stddev }",
+        "FOR d IN " + cn + " COLLECT AGGREGATE variance = VARIANCE(d.value) RETURN variance",
+        // the group members are needed on the coordinator
+        "FOR d IN " + cn + " COLLECT group = d.group INTO g RETURN { group: group, g: LENGTH(g) }",
+        "FOR d IN " + cn + " COLLECT group = d.group INTO g = d.value RETURN { group: group, g: g }",
+        // no GatherNode below the COLLECT
+        "FOR i IN 1..10 COLLECT group = i % 2 WITH COUNT INTO count RETURN { group: group, count: count }"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, rulesAll);
+        assertTrue(result.plan.rules.indexOf(ruleName) === -1, query);
+        assertEqual(1, aggregateNodes(result).length, query);
+      });
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief test that rule has an effect
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [
+        [ "FOR d IN " + cn + " COLLECT group = d.group WITH COUNT INTO count RETURN { group: group, count: count }", [ ], true ],
+        [ "FOR d IN " + cn + " COLLECT WITH COUNT INTO count RETURN count", [ ], true ],
+        [ "FOR d IN " + cn + " COLLECT group = d.group AGGREGATE sum = SUM(d.value) RETURN { group: group, sum: sum }", [ "MERGE_SUM" ], false ],
+        [ "FOR d IN " + cn + " COLLECT group = d.group AGGREGATE min = MIN(d.value), max = MAX(d.value) RETURN { group: group, min: min, max: max }", [ "MIN", "MAX" ], false ],
+        [ "FOR d IN " + cn + " COLLECT AGGREGATE length = LENGTH(d), count = COUNT(1), sum = SUM(d.value) RETURN { length: length, count: count, sum: sum }", [ "SUM", "SUM", "MERGE_SUM" ], false ]
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query[0], { }, rulesAll);
+        assertTrue(result.plan.rules.indexOf(ruleName) !== -1, query[0]);
+
+        var nodes = explain(result);
+        var aggregates = aggregateNodes(result);
+        assertEqual(2, aggregates.length, query[0]);
+
+        // the partial COLLECT runs on the DB servers, the merging one on the
+        // coordinator
+        var partial = nodes.indexOf("AggregateNode");
+        var merge = nodes.lastIndexOf("AggregateNode");
+        assertTrue(partial < nodes.indexOf("RemoteNode"), query[0]);
+        assertTrue(merge > nodes.indexOf("GatherNode"), query[0]);
+
+        // partial counts are summed up by the merging COLLECT
+        assertEqual(query[2], aggregates[0].count, query[0]);
+        assertEqual(false, aggregates[1].count, query[0]);
+
+        var types = aggregates[1].aggregateFunctions.map(function(f) { return f.type; });
+        if (query[2]) {
+          assertEqual(query[1].concat([ "SUM" ]), types, query[0]);
+        }
+        else {
+          assertEqual(query[1], types, query[0]);
+        }
+      });
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief test that the gather merge-sorts the partial results of a sorted
+    /// COLLECT by the partial group values
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testRuleSortedGather : function () {
+      var query = "FOR d IN " + cn + " COLLECT group = d.group AGGREGATE max = MAX(d.value) OPTIONS { method: 'sorted' } RETURN { group: group, max: max }";
+
+      var result = AQL_EXPLAIN(query, { }, rulesAll);
+      assertTrue(result.plan.rules.indexOf(ruleName) !== -1, query);
+
+      var aggregates = aggregateNodes(result);
+      assertEqual(2, aggregates.length);
+      assertEqual("sorted", aggregates[0].aggregationOptions.method);
+      assertEqual("sorted", aggregates[1].aggregationOptions.method);
+
+      var nodes = explain(result);
+      assertTrue(nodes.indexOf("SortNode") < nodes.indexOf("RemoteNode"));
+
+      var gather = helper.findExecutionNodes(result, "GatherNode");
+      assertEqual(1, gather.length);
+      assertEqual(1, gather[0].elements.length);
+      assertEqual(aggregates[0].aggregates[0].outVariable.id, gather[0].elements[0].inVariable.id);
+      assertEqual(aggregates[0].aggregates[0].outVariable.id, aggregates[1].aggregates[0].inVariable.id);
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief test that the distributed COLLECT returns the same results as the
+    /// COLLECT on the coordinator
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [
+        "FOR d IN " + cn + " COLLECT group = d.group WITH COUNT INTO count SORT group RETURN { group: group, count: count }",
+        "FOR d IN " + cn + " COLLECT group = d.group WITH COUNT INTO count OPTIONS { method: 'sorted' } RETURN { group: group, count: count }",
+        "FOR d IN " + cn + " COLLECT WITH COUNT INTO count RETURN count",
+        "FOR d IN " + cn + " FILTER d.group == 'test99' COLLECT WITH COUNT INTO count RETURN count",
+        "FOR d IN " + cn + " COLLECT group = d.group AGGREGATE length = LENGTH(d), count = COUNT(1), min = MIN(d.value), max = MAX(d.value), sum = SUM(d.value) SORT group RETURN { group: group, length: length, count: count, min: min, max: max, sum: sum }",
+        "FOR d IN " + cn + " COLLECT group = d.group AGGREGATE min = MIN(d.value), max = MAX(d.value), sum = SUM(d.value) OPTIONS { method: 'sorted' } RETURN { group: group, min: min, max: max, sum: sum }",
+        "FOR d IN " + cn + " COLLECT group = d.value % 3 AGGREGATE sum = SUM(d.value % 2 == 0 ? null : d.value), min = MIN(d.missing) SORT group RETURN { group: group, sum: sum, min: min }",
+        "FOR d IN " + cn + " COLLECT AGGREGATE length = LENGTH(d), min = MIN(d.value), max = MAX(d.value), sum = SUM(d.value) RETURN { length: length, min: min, max: max, sum: sum }",
+        "FOR d IN " + cn + " FILTER d.group == 'test99' COLLECT AGGREGATE length = LENGTH(d), min = MIN(d.value), max = MAX(d.value), sum = SUM(d.value) RETURN { length: length, min: min, max: max, sum: sum }"
+      ];
+
+      queries.forEach(function(query) {
+        var resultEnabled = AQL_EXECUTE(query, { }, rulesAll);
+        var resultDisabled = AQL_EXECUTE(query, { }, thisRuleDisabled);
+
+        assertEqual(resultDisabled.json, resultEnabled.json, query);
+      });
+
+      assertEqual([ 1000 ], AQL_EXECUTE(queries[2], { }, rulesAll).json);
+      assertEqual([ 0 ], AQL_EXECUTE(queries[3], { }, rulesAll).json);
+    }
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
+
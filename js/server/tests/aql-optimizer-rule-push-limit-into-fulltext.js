@@ -0,0 +1,196 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, assertFalse, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var helper = require("org/arangodb/aql-helper");
+var db = require("org/arangodb").db;
+var removeAlwaysOnClusterRules = helper.removeAlwaysOnClusterRules;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "push-limit-into-fulltext";
+  // various choices to control the optimizer: 
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var c;
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop("UnitTestsCollection");
+      c = db._create("UnitTestsCollection");
+      c.ensureFulltextIndex("text");
+
+      for (var i = 0; i < 100; ++i) {
+        c.save({ value: i, text: "foo bar" });
+      }
+      c.save({ value: 100, text: "foo foo foo" });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var queries = [ 
+        "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo') LIMIT 10 RETURN d",
+        "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo') LIMIT 2, 10 RETURN d"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramNone);
+        assertEqual([ ], removeAlwaysOnClusterRules(result.plan.rules));
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [ 
+        [ "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo') RETURN d", { } ], // no limit
+        [ "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo') FILTER d.value > 10 LIMIT 10 RETURN d", { } ], // filter in between
+        [ "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo') SORT d.value LIMIT 10 RETURN d", { } ], // sort in between
+        [ "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo', 5) LIMIT 10 RETURN d", { } ], // smaller limit already present
+        [ "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo') LIMIT 10 RETURN d", { fullCount: true } ], // fullCount
+        [ "LET r = FULLTEXT(" + c.name() + ", 'text', 'foo') FOR d IN r LIMIT 10 RETURN [ d, LENGTH(r) ]", { } ], // result used later
+        [ "FOR d IN NOOPT(FULLTEXT(" + c.name() + ", 'text', 'foo')) LIMIT 10 RETURN d", { } ], // other function
+        [ "FOR d IN 1..10 LIMIT 10 RETURN d", { } ] // no function call
+      ];
+
+      queries.forEach(function(query) {
+        var options = { optimizer: paramEnabled.optimizer, fullCount: query[1].fullCount };
+        var result = AQL_EXPLAIN(query[0], { }, options);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [ 
+        "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo') LIMIT 10 RETURN d",
+        "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo') LIMIT 2, 10 RETURN d",
+        "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo', 100) LIMIT 10 RETURN d",
+        "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo') LET v = d.value LIMIT 10 RETURN v"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test generated plans
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlans : function () {
+      var queries = [ 
+        [ "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo') LIMIT 10 RETURN d", 10 ],
+        [ "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo') LIMIT 2, 10 RETURN d", 12 ],
+        [ "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo', 100) LIMIT 3 RETURN d", 3 ]
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query[0], { }, paramEnabled);
+        var calculations = result.plan.nodes.filter(function(node) { 
+          return node.type === "CalculationNode" && node.expression.type === "function call"; 
+        });
+        assertEqual(1, calculations.length, query[0]);
+        var fcall = calculations[0].expression;
+        assertEqual("function call", fcall.type);
+        assertEqual("FULLTEXT", fcall.name);
+        assertEqual(4, fcall.subNodes[0].subNodes.length);
+        assertEqual(query[1], fcall.subNodes[0].subNodes[3].value);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [ 
+        [ "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo') LIMIT 1 RETURN d.value", [ 100 ] ],
+        [ "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo,bar') LIMIT 1 RETURN d.value", [ 0 ] ],
+        [ "FOR d IN FULLTEXT(" + c.name() + ", 'text', 'foo') LIMIT 1000 RETURN 1", null ]
+      ];
+
+      queries.forEach(function(query) {
+        var planDisabled = AQL_EXPLAIN(query[0], { }, paramNone);
+        var planEnabled  = AQL_EXPLAIN(query[0], { }, paramEnabled);
+        var resultEnabled = AQL_EXECUTE(query[0], { }, paramEnabled).json;
+
+        assertEqual(-1, planDisabled.plan.rules.indexOf(ruleName), query[0]);
+        assertNotEqual(-1, planEnabled.plan.rules.indexOf(ruleName), query[0]);
+
+        if (query[1] !== null) {
+          assertEqual(query[1], resultEnabled, query[0]);
+        }
+        else {
+          assertEqual(101, resultEnabled.length, query[0]);
+        }
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
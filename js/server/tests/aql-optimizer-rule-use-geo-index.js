@@ -0,0 +1,256 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, assertFalse, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var helper = require("org/arangodb/aql-helper");
+var db = require("org/arangodb").db;
+var removeAlwaysOnClusterRules = helper.removeAlwaysOnClusterRules;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "use-geo-index";
+  // various choices to control the optimizer: 
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var c, c1;
+
+  var sortResult = function (result) {
+    return result.sort(function (l, r) {
+      if (l[0] !== r[0]) {
+        return l[0] < r[0] ? -1 : 1;
+      }
+      return l[1] - r[1];
+    });
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      var lat, lon;
+      db._drop("UnitTestsCollection");
+      db._drop("UnitTestsCollection1");
+      c = db._create("UnitTestsCollection");
+      c1 = db._create("UnitTestsCollection1");
+
+      for (lat = -20; lat <= 20; ++lat) {
+        for (lon = -20; lon <= 20; ++lon) {
+          c.save({ lat: lat, lon: lon, value: lat * 100 + lon });
+          c1.save({ location: [ lat, lon ], value: lat * 100 + lon });
+        }
+      }
+
+      // documents that are not contained in the geo indexes
+      c.save({ value: "missing" });
+      c.save({ lat: null, lon: 3, value: "null" });
+      c.save({ lat: "1", lon: 3, value: "string" });
+      c.save({ lat: 95, lon: 3, value: "out of range" });
+      c1.save({ value: "missing" });
+      c1.save({ location: [ 1 ], value: "too short" });
+
+      c.ensureGeoIndex("lat", "lon");
+      c1.ensureGeoIndex("location");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+      db._drop("UnitTestsCollection1");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var queries = [ 
+        "FOR d IN " + c.name() + " SORT DISTANCE(d.lat, d.lon, 0, 0) LIMIT 10 RETURN d",
+        "FOR d IN " + c.name() + " FILTER DISTANCE(d.lat, d.lon, 0, 0) <= 100000 RETURN d"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramNone);
+        assertEqual([ ], removeAlwaysOnClusterRules(result.plan.rules));
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [ 
+        [ "FOR d IN " + c.name() + " SORT DISTANCE(d.lat, d.lon, 0, 0) RETURN d", { } ], // no limit
+        [ "FOR d IN " + c.name() + " SORT DISTANCE(d.lat, d.lon, 0, 0) DESC LIMIT 10 RETURN d", { } ], // descending
+        [ "FOR d IN " + c.name() + " SORT DISTANCE(d.lat, d.lon, 0, 0), d.value LIMIT 10 RETURN d", { } ], // more than one sort criterion
+        [ "FOR d IN " + c.name() + " SORT DISTANCE(d.lon, d.lat, 0, 0) LIMIT 10 RETURN d", { } ], // wrong attributes
+        [ "FOR d IN " + c.name() + " SORT DISTANCE(d.lat, d.lon, d.lat, 0) LIMIT 10 RETURN d", { } ], // non-constant point
+        [ "FOR d IN " + c.name() + " FILTER d.value > 0 SORT DISTANCE(d.lat, d.lon, 0, 0) LIMIT 10 RETURN d", { } ], // other filter
+        [ "FOR d IN " + c.name() + " FILTER DISTANCE(d.lat, d.lon, 0, 0) >= 100000 RETURN d", { } ], // wrong direction
+        [ "FOR d IN " + c.name() + " FILTER DISTANCE(d.lat, d.lon, 0, 0) <= d.value RETURN d", { } ], // non-constant radius
+        [ "FOR d IN " + c.name() + " SORT DISTANCE(d.lat, d.lon, 0, 0) LIMIT 10 RETURN d", { fullCount: true } ], // fullCount
+        [ "FOR i IN 1..2 FOR d IN " + c.name() + " SORT DISTANCE(d.lat, d.lon, 0, 0) LIMIT 10 RETURN d", { } ], // outer loop
+        [ "FOR d IN " + c1.name() + " SORT DISTANCE(d.location[1], d.location[0], 0, 0) LIMIT 10 RETURN d", { } ], // wrong positions
+        [ "FOR d IN " + c.name() + " SORT d.value LIMIT 10 RETURN d", { } ], // no distance
+        [ "FOR d IN " + c.name() + " SORT DISTANCE(d.lat, d.lon, 0, 0) LIMIT 10 RETURN d", { } ], // null distances not excluded
+        [ "FOR d IN " + c.name() + " FILTER DISTANCE(d.lat, d.lon, 0, 0) <= 100000 RETURN d", { } ], // null distances not excluded
+        [ "FOR d IN " + c.name() + " FILTER DISTANCE(d.lat, d.lon, 1, 1) != null SORT DISTANCE(d.lat, d.lon, 0, 0) LIMIT 10 RETURN d", { } ], // different points
+        [ "FOR d IN " + c.name() + " FILTER DISTANCE(d.lat, d.lon, 0, 0) != null || d.value > 0 SORT DISTANCE(d.lat, d.lon, 0, 0) LIMIT 10 RETURN d", { } ], // other condition
+        [ "FOR d IN " + c.name() + " FILTER DISTANCE(d.lat, d.lon, 95, 0) != null SORT DISTANCE(d.lat, d.lon, 95, 0) LIMIT 10 RETURN d", { } ] // invalid point
+      ];
+
+      queries.forEach(function(query) {
+        var options = { optimizer: paramEnabled.optimizer, fullCount: query[1].fullCount };
+        var result = AQL_EXPLAIN(query[0], { }, options);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [ 
+        [ "FOR d IN " + c.name() + " FILTER DISTANCE(d.lat, d.lon, 0, 0) != null SORT DISTANCE(d.lat, d.lon, 0, 0) LIMIT 10 RETURN d", "NEAR" ],
+        [ "FOR d IN " + c.name() + " FILTER null != DISTANCE(0, 0, d.lat, d.lon) SORT DISTANCE(0, 0, d.lat, d.lon) LIMIT 2, 10 RETURN d", "NEAR" ],
+        [ "FOR d IN " + c.name() + " LET dist = DISTANCE(d.lat, d.lon, -5.5, 3) FILTER dist != null SORT dist LIMIT 10 RETURN dist", "NEAR" ],
+        [ "FOR d IN " + c.name() + " LET dist = DISTANCE(d.lat, d.lon, -5.5, 3) FILTER IS_NUMBER(dist) SORT dist LIMIT 10 RETURN dist", "NEAR" ],
+        [ "FOR d IN " + c1.name() + " FILTER DISTANCE(d.location[0], d.location[1], 0, 0) != null SORT DISTANCE(d.location[0], d.location[1], 0, 0) LIMIT 10 RETURN d", "NEAR" ],
+        [ "FOR d IN " + c.name() + " FILTER DISTANCE(d.lat, d.lon, 0, 0) != null && DISTANCE(d.lat, d.lon, 0, 0) <= 100000 RETURN d", "WITHIN" ],
+        [ "FOR d IN " + c.name() + " FILTER DISTANCE(d.lat, d.lon, 0, 0) != null FILTER 100000 > DISTANCE(d.lat, d.lon, 0, 0) RETURN d", "WITHIN" ],
+        [ "FOR d IN " + c.name() + " LET dist = DISTANCE(d.lat, d.lon, 0, 0) FILTER dist != null && dist <= 100000 SORT dist RETURN d", "WITHIN" ],
+        [ "FOR i IN 1..2 FOR d IN " + c.name() + " FILTER IS_NUMBER(DISTANCE(d.lat, d.lon, 0, 0)) && DISTANCE(d.lat, d.lon, 0, 0) < 100000 RETURN d", "WITHIN" ]
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query[0], { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query[0]);
+
+        var types = result.plan.nodes.map(function(node) { return node.type; });
+        assertEqual(-1, types.indexOf("EnumerateCollectionNode"), query[0]);
+        assertNotEqual(-1, types.indexOf("EnumerateListNode"), query[0]);
+        assertNotEqual(-1, types.indexOf("FilterNode"), query[0]);
+        assertEqual(-1, types.indexOf("SortNode"), query[0]);
+
+        var calls = result.plan.nodes.filter(function(node) {
+          return node.type === "CalculationNode" && 
+                 node.expression.type === "function call" && 
+                 node.expression.name === query[1];
+        });
+        assertEqual(1, calls.length, query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [ 
+        "FOR d IN " + c.name() + " LET dist = DISTANCE(d.lat, d.lon, 0.2, 0.1) FILTER dist != null SORT dist LIMIT 5 RETURN [ dist, d.value ]",
+        "FOR d IN " + c.name() + " LET dist = DISTANCE(d.lat, d.lon, -7.6, 12.1) FILTER dist != null SORT dist LIMIT 3, 20 RETURN [ dist, d.value ]",
+        "FOR d IN " + c1.name() + " LET dist = DISTANCE(d.location[0], d.location[1], 19.6, -19.9) FILTER IS_NUMBER(dist) SORT dist LIMIT 12 RETURN [ dist, d.value ]",
+        "FOR d IN " + c.name() + " LET dist = DISTANCE(d.lat, d.lon, 3, 4) FILTER dist != null && dist <= 333585.8 RETURN [ dist, d.value ]",
+        "FOR d IN " + c.name() + " LET dist = DISTANCE(d.lat, d.lon, 3, 4) FILTER dist != null && dist < 333585.8 RETURN [ dist, d.value ]",
+        "FOR d IN " + c.name() + " LET dist = DISTANCE(d.lat, d.lon, 50, 4) FILTER dist != null && dist <= 10000 RETURN [ dist, d.value ]"
+      ];
+
+      queries.forEach(function(query) {
+        var planDisabled = AQL_EXPLAIN(query, { }, paramNone);
+        var planEnabled = AQL_EXPLAIN(query, { }, paramEnabled);
+        var resultDisabled = AQL_EXECUTE(query, { }, paramNone).json;
+        var resultEnabled = AQL_EXECUTE(query, { }, paramEnabled).json;
+
+        assertEqual(-1, planDisabled.plan.rules.indexOf(ruleName), query);
+        assertNotEqual(-1, planEnabled.plan.rules.indexOf(ruleName), query);
+
+        // documents with the same distance may come in any order
+        assertEqual(resultDisabled.length, resultEnabled.length, query);
+        for (var i = 1; i < resultEnabled.length; ++i) {
+          assertTrue(resultEnabled[i - 1][0] <= resultEnabled[i][0], query);
+        }
+        if (query.indexOf("LIMIT") === -1) {
+          assertEqual(sortResult(resultDisabled), sortResult(resultEnabled), query);
+        }
+        else {
+          assertEqual(resultDisabled.map(function(r) { return r[0]; }), 
+                      resultEnabled.map(function(r) { return r[0]; }), query);
+        }
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that documents without valid coordinates are returned when
+/// the rule does not fire
+////////////////////////////////////////////////////////////////////////////////
+
+    testResultsWithoutCoordinates : function () {
+      var queries = [ 
+        [ "FOR d IN " + c.name() + " SORT DISTANCE(d.lat, d.lon, 0, 0) LIMIT 4 RETURN d.value", [ "missing", "null", "out of range", "string" ] ],
+        [ "FOR d IN " + c.name() + " FILTER DISTANCE(d.lat, d.lon, 0, 0) <= 1 SORT d.value RETURN d.value", [ 0, "missing", "null", "out of range", "string" ] ],
+        [ "FOR d IN " + c1.name() + " SORT DISTANCE(d.location[0], d.location[1], 0, 0) LIMIT 2 RETURN d.value", [ "missing", "too short" ] ],
+        [ "FOR d IN " + c.name() + " FILTER DISTANCE(d.lat, d.lon, 0, 0) != null SORT DISTANCE(d.lat, d.lon, 0, 0) LIMIT 1 RETURN d.value", [ 0 ] ],
+        [ "FOR d IN " + c.name() + " FILTER DISTANCE(d.lat, d.lon, 0, 0) != null && DISTANCE(d.lat, d.lon, 0, 0) <= 1 RETURN d.value", [ 0 ] ]
+      ];
+
+      queries.forEach(function(query) {
+        var resultDisabled = AQL_EXECUTE(query[0], { }, paramNone).json;
+        var resultEnabled = AQL_EXECUTE(query[0], { }, paramEnabled).json;
+
+        assertEqual(query[1], resultDisabled.sort(), query[0]);
+        assertEqual(query[1], resultEnabled.sort(), query[0]);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
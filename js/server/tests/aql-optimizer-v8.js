@@ -101,6 +101,59 @@ function optimizerUserFunctionsTestSuite () {
       for (var i = 0; i < 10; ++i) {
         assertEqual(expected, result.json[i]);
       }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test user function results for multiple blocks of rows
+////////////////////////////////////////////////////////////////////////////////
+
+    testUserFunctionMultipleBlocks : function () {
+      aqlfunctions.register("UnitTests::types", function (value) {
+        switch (value % 5) {
+          case 0: return undefined;
+          case 1: return value % 2 === 0;
+          case 2: return value * 2;
+          case 3: return "value" + value;
+          default: return { value: value, values: [ value ] };
+        }
+      }, true);
+
+      var result = AQL_EXECUTE("FOR i IN 1..2500 LET x = { i: i } RETURN UnitTests::types(x.i)").json;
+
+      assertEqual(2500, result.length);
+      for (var i = 1; i <= 2500; ++i) {
+        var expected;
+        switch (i % 5) {
+          case 0: expected = null; break;
+          case 1: expected = (i % 2 === 0); break;
+          case 2: expected = i * 2; break;
+          case 3: expected = "value" + i; break;
+          default: expected = { value: i, values: [ i ] };
+        }
+        assertEqual(expected, result[i - 1]);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test user function throwing in the middle of a block
+////////////////////////////////////////////////////////////////////////////////
+
+    testUserFunctionThrowInBlock : function () {
+      aqlfunctions.register("UnitTests::thrower", function (value) {
+        if (value === 500) {
+          throw "peng!";
+        }
+        return value;
+      }, true);
+
+      var result = AQL_EXECUTE("FOR i IN 1..1000 RETURN UnitTests::thrower(i)");
+
+      assertEqual(1000, result.json.length);
+      for (var i = 1; i <= 1000; ++i) {
+        assertEqual(i === 500 ? null : i, result.json[i - 1]);
+      }
+      assertEqual(1, result.warnings.length);
+      assertEqual(internal.errors.ERROR_QUERY_FUNCTION_RUNTIME_ERROR.code, result.warnings[0].code);
     }
 
   };
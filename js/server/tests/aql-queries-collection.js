@@ -854,6 +854,41 @@ function ahuacatlQueryCollectionTestSuite () {
       var expected = [ [ "riding", "skating", "swimming", null, "swimming" ] ];
       var actual = getQueryResults("FOR u in " + users.name() + " FILTER HAS(u, 'hobbies') RETURN [ u.hobbies[0], u.hobbies[1], u.hobbies[2], u.hobbies[3], u.hobbies[-1] ]");
       assertEqual(expected, actual);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test simple filter conditions evaluated for whole blocks, compared
+/// to the row-by-row evaluation
+////////////////////////////////////////////////////////////////////////////////
+    
+    testSimpleFilterConditions : function () {
+      users.save({ "id" : 300, "name" : "Nobody" });
+      users.save({ "id" : 301, "name" : "Somebody", "age" : "37", "active" : null, "address" : { "city" : "Cologne" } });
+      users.save({ "id" : 302, "name" : "Anybody", "age" : [ 37 ], "gender" : { }, "address" : { "city" : "Berlin" } });
+
+      var conditions = [
+        "u.age > 30",
+        "30 < u.age",
+        "u.age >= 37 && u.gender == 'f'",
+        "u.age < 30 || u.active == false",
+        "! (u.age <= 35)",
+        "u.age != 37 && ! (u.gender == 'm' || u.active != true)",
+        "u.name >= 'M'",
+        "u.age == null",
+        "u.age == [ 37 ]",
+        "u.gender == { }",
+        "u.address.city == 'Cologne'",
+        "u.address.city > null",
+        "u.id > u.age",
+        "u._key == u._key && u._id != null"
+      ];
+
+      conditions.forEach(function (condition) {
+        var query = "FOR u IN " + users.name() + " FILTER @@ SORT u.id RETURN u.id";
+        var expected = getQueryResults(query.replace("@@", "NOOPT(" + condition + ")"));
+        var actual = getQueryResults(query.replace("@@", condition));
+        assertEqual(expected, actual, condition);
+      });
     }
 
   };
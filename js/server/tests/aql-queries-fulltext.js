@@ -146,6 +146,37 @@ function ahuacatlFulltextTestSuite () {
       assertEqual(2, actual.length);
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test ranking of limited fulltext results
+////////////////////////////////////////////////////////////////////////////////
+
+    testFulltextRanked : function () {
+      fulltext.save({ id : 1, text : "apple banana cherry date elderberry fig grape" });
+      fulltext.save({ id : 2, text : "apple apple apple" });
+      fulltext.save({ id : 3, text : "apple banana" });
+      fulltext.save({ id : 4, text : "banana cherry" });
+      fulltext.save({ id : 5, text : "apple apple banana cherry" });
+
+      var actual;
+      actual = getQueryResults("FOR d IN FULLTEXT(" + fulltext.name() + ", 'text', 'apple', 1) RETURN d.id");
+      assertEqual([ 2 ], actual);
+      
+      actual = getQueryResults("FOR d IN FULLTEXT(" + fulltext.name() + ", 'text', 'apple', 10) RETURN d.id");
+      assertEqual([ 2, 5, 3, 1 ], actual);
+      
+      actual = getQueryResults("FOR d IN FULLTEXT(" + fulltext.name() + ", 'text', 'apple,banana', 2) RETURN d.id");
+      assertEqual([ 5, 3 ], actual);
+      
+      actual = getQueryResults("FOR d IN FULLTEXT(" + fulltext.name() + ", 'text', 'apple,-banana', 10) RETURN d.id");
+      assertEqual([ 2 ], actual);
+      
+      actual = getQueryResults("FOR d IN FULLTEXT(" + fulltext.name() + ", 'text', 'apple') LIMIT 2 RETURN d.id");
+      assertEqual([ 2, 5 ], actual);
+      
+      actual = getQueryResults("FOR d IN FULLTEXT(" + fulltext.name() + ", 'text', 'apple') LIMIT 1, 2 RETURN d.id");
+      assertEqual([ 5, 3 ], actual);
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test without fulltext index available
 ////////////////////////////////////////////////////////////////////////////////
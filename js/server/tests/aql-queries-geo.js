@@ -1,5 +1,5 @@
 /*jshint globalstrict:false, strict:false, maxlen: 500 */
-/*global assertEqual */
+/*global assertEqual, assertTrue */
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief tests for query language, geo queries
@@ -210,6 +210,67 @@ function ahuacatlGeoTestSuite () {
       assertEqual(expected, actual);
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test near function result order
+////////////////////////////////////////////////////////////////////////////////
+
+    testNearOrder : function () {
+      var actual = getQueryResults("FOR x IN NEAR(" + locations.name() + ", 10.2, 20.1, 1000, \"distance\") RETURN x.distance");
+      assertEqual(1000, actual.length);
+      for (var i = 1; i < actual.length; ++i) {
+        assertTrue(actual[i - 1] <= actual[i]);
+      }
+
+      actual = runQuery("FOR x IN NEAR(" + locations.name() + ", 10.2, 20.1, 2) RETURN x");
+      assertEqual([ { "latitude" : 10, "longitude" : 20 }, { "latitude" : 11, "longitude" : 20 } ], actual);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test within function result order
+////////////////////////////////////////////////////////////////////////////////
+
+    testWithinOrder : function () {
+      var actual = getQueryResults("FOR x IN WITHIN(" + locations.name() + ", 10.2, 20.1, 500000, \"distance\") RETURN x.distance");
+      assertEqual(66, actual.length);
+      for (var i = 1; i < actual.length; ++i) {
+        assertTrue(actual[i - 1] <= actual[i]);
+      }
+      assertTrue(actual[actual.length - 1] <= 500000);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test distance function
+////////////////////////////////////////////////////////////////////////////////
+
+    testDistance : function () {
+      var actual = getQueryResults("RETURN DISTANCE(0, 0, 0, 1)");
+      assertEqual("111194.92664", actual[0].toFixed(5));
+      
+      actual = getQueryResults("RETURN DISTANCE(0, 0, 1, 0)");
+      assertEqual("111194.92664", actual[0].toFixed(5));
+      
+      actual = getQueryResults("RETURN DISTANCE(-70, 70, 40, -40)");
+      assertEqual("14891044.54146", actual[0].toFixed(5));
+      
+      actual = getQueryResults("RETURN DISTANCE(50.5, 6.25, 50.5, 6.25)");
+      assertEqual([ 0 ], actual);
+
+      actual = getQueryResults("FOR x IN NEAR(" + locations.name() + ", 10.2, 20.1, 10, \"distance\") RETURN x.distance - DISTANCE(x.latitude, x.longitude, 10.2, 20.1)");
+      assertEqual([ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 ], actual);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test distance function with invalid arguments
+////////////////////////////////////////////////////////////////////////////////
+
+    testDistanceInvalid : function () {
+      assertEqual([ null ], getQueryResults("RETURN DISTANCE(0, 0, 0, NOOPT(\"foo\"))"));
+      assertEqual([ null ], getQueryResults("RETURN DISTANCE(NOOPT(null), 0, 0, 0)"));
+      assertEqual([ null ], getQueryResults("RETURN DISTANCE(NOOPT(90.5), 0, 0, 0)"));
+      assertEqual([ null ], getQueryResults("RETURN DISTANCE(0, 0, 0, NOOPT(-180.5))"));
+      assertQueryError(errors.ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH.code, "RETURN DISTANCE(0, 0, 0)"); 
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test without geo index available
 ////////////////////////////////////////////////////////////////////////////////
@@ -519,6 +519,243 @@ function CompactionSuite () {
       internal.db._drop(cn);
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test compaction properties
+////////////////////////////////////////////////////////////////////////////////
+
+    testCompactionProperties : function () {
+      var cn = "example";
+      internal.db._drop(cn);
+      var c1 = internal.db._create(cn, { "journalSize" : 1048576 });
+
+      var p = c1.properties();
+      assertEqual(128 * 1024, p.compactionDeadSizeThreshold);
+      assertEqual(0.1, p.compactionDeadSizeShare);
+      assertEqual(128 * 1024 * 1024, p.compactionMaxFileSize);
+
+      p = c1.properties({ compactionDeadSizeThreshold: 4096, compactionDeadSizeShare: 0.5, compactionMaxFileSize: 4 * 1024 * 1024 });
+      assertEqual(4096, p.compactionDeadSizeThreshold);
+      assertEqual(0.5, p.compactionDeadSizeShare);
+      assertEqual(4 * 1024 * 1024, p.compactionMaxFileSize);
+
+      try {
+        c1.properties({ compactionDeadSizeShare: 1.5 });
+        fail();
+      }
+      catch (err) {
+        assertEqual(internal.errors.ERROR_BAD_PARAMETER.code, err.errorNum);
+      }
+
+      try {
+        c1.properties({ compactionMaxFileSize: 1024 });
+        fail();
+      }
+      catch (err) {
+        assertEqual(internal.errors.ERROR_BAD_PARAMETER.code, err.errorNum);
+      }
+
+      // values survive an unload
+      testHelper.waitUnload(c1);
+      p = c1.properties();
+      assertEqual(4096, p.compactionDeadSizeThreshold);
+      assertEqual(0.5, p.compactionDeadSizeShare);
+      assertEqual(4 * 1024 * 1024, p.compactionMaxFileSize);
+
+      // values can also be set when creating the collection
+      internal.db._drop(cn);
+      c1 = internal.db._create(cn, { compactionDeadSizeThreshold: 0, compactionDeadSizeShare: 0.25 });
+      p = c1.properties();
+      assertEqual(0, p.compactionDeadSizeThreshold);
+      assertEqual(0.25, p.compactionDeadSizeShare);
+      assertEqual(128 * 1024 * 1024, p.compactionMaxFileSize);
+
+      internal.db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test compaction figures
+////////////////////////////////////////////////////////////////////////////////
+
+    testFiguresCompaction : function () {
+      var cn = "example";
+      var n = 400;
+      var i;
+      var payload = "the quick brown fox jumped over the lazy dog. a quick dog jumped over the lazy fox. boom bang.";
+
+      for (i = 0; i < 5; ++i) {
+        payload += payload;
+      }
+
+      internal.db._drop(cn);
+      var c1 = internal.db._create(cn, { "journalSize" : 1048576, "compactionDeadSizeThreshold" : 0 });
+
+      var fig = c1.figures();
+      assertEqual(0, fig.compaction.count);
+      assertEqual(0, fig.compaction.bytesRead);
+      assertEqual(0, fig.compaction.bytesWritten);
+      assertEqual(0, fig.compaction.time);
+      assertEqual(0, fig.compaction.deadRatio);
+
+      for (i = 0; i < n; ++i) {
+        c1.save({ _key: "test" + i, value : i, payload : payload });
+      }
+      for (i = 0; i < n; i += 2) {
+        c1.remove("test" + i);
+      }
+
+      internal.wal.flush(true, true);
+      c1.rotate();
+
+      var tries = 0;
+      while (++tries < 40) {
+        fig = c1.figures();
+        if (fig.compaction.count > 0) {
+          break;
+        }
+        internal.wait(1, false);
+      }
+
+      assertTrue(fig.compaction.count > 0);
+      assertTrue(fig.compaction.bytesRead > 0);
+      assertTrue(fig.compaction.bytesWritten > 0);
+      assertTrue(fig.compaction.bytesWritten <= fig.compaction.bytesRead);
+      assertTrue(fig.compaction.time >= 0);
+      assertTrue(fig.compaction.deadRatio >= 0 && fig.compaction.deadRatio <= 1);
+
+      internal.db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test compressed datafiles
+////////////////////////////////////////////////////////////////////////////////
+
+    testCompressDatafiles : function () {
+      var cn = "example";
+      var n = 400;
+      var i, doc;
+      var payload = "the quick brown fox jumped over the lazy dog. a quick dog jumped over the lazy fox. boom bang.";
+
+      for (i = 0; i < 5; ++i) {
+        payload += payload;
+      }
+
+      internal.db._drop(cn);
+      var c1 = internal.db._create(cn, { "journalSize" : 1048576, "compressDatafiles" : true });
+      assertTrue(c1.properties().compressDatafiles);
+
+      var fig = c1.figures();
+      assertEqual(0, fig.datafiles.compressedCount);
+      assertEqual(0, fig.datafiles.compressedFileSize);
+
+      for (i = 0; i < n; ++i) {
+        c1.save({ _key: "test" + i, value : i, payload : payload });
+      }
+
+      internal.wal.flush(true, true);
+      c1.rotate();
+
+      var tries = 0;
+      while (++tries < 40) {
+        fig = c1.figures();
+        if (fig.datafiles.compressedCount > 0) {
+          break;
+        }
+        internal.wait(1, false);
+      }
+
+      assertTrue(fig.datafiles.compressedCount > 0);
+      assertTrue(fig.datafiles.compressedFileSize > 0);
+      assertTrue(fig.datafiles.compressedFileSize < fig.datafiles.fileSize);
+
+      // documents must still be readable after reopening the compressed files
+      testHelper.waitUnload(c1);
+      assertEqual(n, c1.count());
+
+      for (i = 0; i < n; ++i) {
+        doc = c1.document("test" + i);
+        assertEqual(i, doc.value);
+        assertEqual(payload, doc.payload);
+      }
+
+      fig = c1.figures();
+      assertTrue(fig.datafiles.compressedCount > 0);
+
+      // the property can be turned off again
+      assertFalse(c1.properties({ compressDatafiles: false }).compressDatafiles);
+      testHelper.waitUnload(c1);
+      assertFalse(c1.properties().compressDatafiles);
+
+      internal.db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test residency figures
+////////////////////////////////////////////////////////////////////////////////
+
+    testFiguresResidency : function () {
+      var cn = "example";
+      var n = 400;
+      var i;
+      var payload = "the quick brown fox jumped over the lazy dog. a quick dog jumped over the lazy fox. boom bang.";
+
+      for (i = 0; i < 5; ++i) {
+        payload += payload;
+      }
+
+      internal.db._drop(cn);
+      var c1 = internal.db._create(cn, { "journalSize" : 1048576 });
+
+      for (i = 0; i < n; ++i) {
+        c1.save({ _key: "test" + i, value : i, payload : payload });
+      }
+
+      internal.wal.flush(true, true);
+      c1.rotate();
+
+      var tries = 0;
+      var fig;
+      while (++tries < 40) {
+        fig = c1.figures();
+        if (fig.datafiles.count > 0) {
+          break;
+        }
+        internal.wait(1, false);
+      }
+
+      assertTrue(fig.datafiles.count > 0);
+      assertTrue(fig.datafiles.residentSize >= 0);
+      assertTrue(fig.datafiles.residentSize <= fig.datafiles.fileSize);
+      assertTrue(fig.journals.residentSize >= 0);
+      assertTrue(fig.journals.residentSize <= fig.journals.fileSize);
+      // the server runs without --database.datafile-cold-time
+      assertEqual(0, fig.datafiles.coldCount);
+
+      // the datafiles were not read since they were written, so a residency
+      // pass with a small cold time drops them from memory
+      internal.wait(3, false);
+      var cold = c1.manageResidency(1);
+      assertTrue(cold > 0);
+
+      fig = c1.figures();
+      assertEqual(cold, fig.datafiles.coldCount);
+
+      // the documents of cold datafiles can still be read, and reading them
+      // brings the datafiles into memory again
+      for (i = 0; i < n; ++i) {
+        assertEqual(i, c1.document("test" + i).value);
+        assertEqual(payload, c1.document("test" + i).payload);
+      }
+
+      fig = c1.figures();
+      assertTrue(fig.datafiles.residentSize > 0);
+
+      assertEqual(0, c1.manageResidency(3600));
+      fig = c1.figures();
+      assertEqual(0, fig.datafiles.coldCount);
+
+      internal.db._drop(cn);
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test figures after truncate and rotate, with compaction disabled
 ////////////////////////////////////////////////////////////////////////////////
@@ -845,6 +1082,128 @@ function CompactionSuite () {
       // we should still have all the deletion markers
       assertTrue(n >= fig["dead"]["deletion"]);
 
+      internal.db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the maintenance queue
+////////////////////////////////////////////////////////////////////////////////
+
+    testMaintenanceQueue : function () {
+      var queue = internal.maintenance.queue();
+
+      assertTrue(queue.workers >= 1);
+      assertTrue(queue.ioBudget >= 0);
+      assertTrue(queue.backoff > 0 && queue.backoff <= 1);
+      assertTrue(queue.ioRate >= 0);
+      if (queue.ioBudget > 0) {
+        assertTrue(queue.ioRate <= queue.ioBudget);
+      }
+      assertTrue(Array.isArray(queue.queued));
+      assertTrue(Array.isArray(queue.running));
+
+      queue.queued.concat(queue.running).forEach(function (job) {
+        assertTrue(job.type === "cleanup" || job.type === "compaction");
+        assertEqual("string", typeof job.database);
+        assertEqual("number", typeof job.priority);
+
+        if (job.type === "compaction") {
+          assertEqual("string", typeof job.collection);
+          assertTrue(job.priority >= 0 && job.priority <= 1);
+        }
+        else {
+          assertTrue(job.priority >= 1);
+        }
+      });
+
+      // queued jobs are sorted by priority
+      for (var i = 1; i < queue.queued.length; ++i) {
+        assertTrue(queue.queued[i - 1].priority >= queue.queued[i].priority);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief write to a collection while its compaction is throttled
+///
+/// with a tiny I/O budget, each compaction run overdraws the budget and the
+/// next one is delayed. write transactions must not wait for the budget
+////////////////////////////////////////////////////////////////////////////////
+
+    testWritesDuringThrottledCompaction : function () {
+      var cn = "example";
+      var n = 1000;
+      var i;
+      var payload = "the quick brown fox jumped over the lazy dog. a quick dog jumped over the lazy fox. boom bang.";
+
+      for (i = 0; i < 5; ++i) {
+        payload += payload;
+      }
+
+      internal.db._drop(cn);
+      var c1 = internal.db._create(cn, { "journalSize" : 1048576, "compactionDeadSizeThreshold" : 0 });
+
+      for (i = 0; i < n; ++i) {
+        c1.save({ _key: "test" + i, value : i, payload : payload });
+      }
+      for (i = 0; i < n; i += 2) {
+        c1.remove("test" + i);
+      }
+
+      internal.wal.flush(true, true);
+
+      var ioBudget = internal.maintenance.properties().ioBudget;
+
+      try {
+        assertEqual(64 * 1024, internal.maintenance.properties({ ioBudget: 64 * 1024 }).ioBudget);
+        c1.rotate();
+
+        var overdrawn = false;
+        var written = 0;
+        var tries = 0;
+
+        while (++tries < 400) {
+          var start = internal.time();
+
+          internal.db._executeTransaction({
+            collections: { write: cn },
+            action: function (params) {
+              var c = require("internal").db._collection(params.cn);
+              c.save({ _key: "new" + params.i, value: params.i });
+              c.remove("test" + (params.i * 2 + 1));
+            },
+            params: { cn: cn, i: written }
+          });
+
+          ++written;
+
+          // a write waiting for the compaction budget would take seconds
+          assertTrue(internal.time() - start < 2.0);
+
+          if (internal.maintenance.queue().ioAvailable < 0) {
+            overdrawn = true;
+          }
+
+          if (overdrawn && c1.figures().compaction.count > 0 && written >= 20) {
+            break;
+          }
+
+          internal.wait(0.1, false);
+        }
+
+        assertTrue(overdrawn);
+        assertTrue(c1.figures().compaction.count > 0);
+        assertEqual(n / 2, c1.count());
+
+        for (i = 0; i < written; ++i) {
+          assertEqual(i, c1.document("new" + i).value);
+          assertFalse(c1.exists("test" + (i * 2 + 1)));
+        }
+      }
+      finally {
+        internal.maintenance.properties({ ioBudget: ioBudget });
+      }
+
+      assertEqual(ioBudget, internal.maintenance.properties().ioBudget);
       internal.db._drop(cn);
     }
 
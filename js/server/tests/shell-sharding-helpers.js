@@ -1,5 +1,5 @@
 /*jshint globalstrict:false, strict:false */
-/*global assertFalse, assertTrue, assertEqual, ArangoAgency, ArangoServerState, ArangoClusterInfo */
+/*global assertFalse, assertTrue, assertEqual, fail, ArangoAgency, ArangoServerState, ArangoClusterInfo */
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test the cluster helper functions
@@ -30,6 +30,7 @@
 
 var cluster = require("org/arangodb/cluster");
 var jsunity = require("jsunity");
+var errors = require("internal").errors;
 
 var compareStringIds = function (l, r) {
   'use strict';
@@ -352,6 +353,153 @@ function ClusterEnabledSuite () {
       assertEqual("myself", ci.getResponsibleServer("s2"));
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test getResponsibleShard
+////////////////////////////////////////////////////////////////////////////////
+
+    testGetResponsibleShard : function () {
+      var collection = {
+        id: "12345868390663",
+        name: "mycollection_test",
+        type: 2,
+        status: 3, // LOADED
+        shardKeys: [ "_key" ],
+        shards: { "s1" : "myself", "s2" : "other", "s3" : "foo" }
+      };
+
+      assertTrue(agency.set("Plan/Collections/test/" + collection.id, collection));
+      ci.flush();
+
+      var i, result, used = { };
+      for (i = 0; i < 100; ++i) {
+        result = ci.getResponsibleShard(collection.id, { _key: "test" + i, value: i });
+        assertTrue(collection.shards.hasOwnProperty(result.shardId));
+        assertTrue(result.usesDefaultShardingAttributes);
+
+        // routing only depends on the shard keys
+        assertEqual(result.shardId, ci.getResponsibleShard(collection.id, { _key: "test" + i }).shardId);
+        used[result.shardId] = true;
+      }
+      assertEqual(3, Object.keys(used).length);
+
+      try {
+        ci.getResponsibleShard("99999999", { _key: "test" });
+        fail();
+      }
+      catch (err) {
+        assertEqual(errors.ERROR_ARANGO_COLLECTION_NOT_FOUND.code, err.errorNum);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test getResponsibleShard with other shard keys
+////////////////////////////////////////////////////////////////////////////////
+
+    testGetResponsibleShardKeys : function () {
+      var collection = {
+        id: "12345868390663",
+        name: "mycollection_test",
+        type: 2,
+        status: 3, // LOADED
+        shardKeys: [ "a", "b" ],
+        shards: { "s1" : "myself", "s2" : "other", "s3" : "foo", "s4" : "bar" }
+      };
+
+      assertTrue(agency.set("Plan/Collections/test/" + collection.id, collection));
+      ci.flush();
+
+      var i, result, used = { };
+      for (i = 0; i < 100; ++i) {
+        result = ci.getResponsibleShard(collection.id, { _key: "test" + i, a: i, b: "foo" });
+        assertTrue(collection.shards.hasOwnProperty(result.shardId));
+        assertFalse(result.usesDefaultShardingAttributes);
+
+        // the _key is not a shard key
+        assertEqual(result.shardId, ci.getResponsibleShard(collection.id, { _key: "other" + i, a: i, b: "foo" }).shardId);
+        used[result.shardId] = true;
+      }
+      assertEqual(4, Object.keys(used).length);
+
+      // incomplete documents must contain all shard keys
+      result = ci.getResponsibleShard(collection.id, { a: 1 }, true);
+      assertTrue(collection.shards.hasOwnProperty(result.shardId));
+
+      try {
+        ci.getResponsibleShard(collection.id, { a: 1 }, false);
+        fail();
+      }
+      catch (err) {
+        assertEqual(errors.ERROR_CLUSTER_NOT_ALL_SHARDING_ATTRIBUTES_GIVEN.code, err.errorNum);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test getResponsibleShard after changes of the plan
+////////////////////////////////////////////////////////////////////////////////
+
+    testGetResponsibleShardPlanChange : function () {
+      var collection1 = {
+        id: "123",
+        name: "mycollection1",
+        type: 2,
+        status: 3, // LOADED
+        shardKeys: [ "_key" ],
+        shards: { "s1" : "myself", "s2" : "other" }
+      };
+      var collection2 = {
+        id: "456",
+        name: "mycollection2",
+        type: 2,
+        status: 3, // LOADED
+        shardKeys: [ "_key" ],
+        shards: { "s3" : "myself", "s4" : "other" }
+      };
+
+      assertTrue(agency.set("Plan/Collections/test/" + collection1.id, collection1));
+      assertTrue(agency.set("Plan/Collections/test/" + collection2.id, collection2));
+      ci.flush();
+
+      var i, before = [ ];
+      for (i = 0; i < 50; ++i) {
+        before.push(ci.getResponsibleShard(collection1.id, { _key: "test" + i }).shardId);
+        assertTrue(collection2.shards.hasOwnProperty(ci.getResponsibleShard(collection2.id, { _key: "test" + i }).shardId));
+      }
+
+      // change the shards of one collection only
+      collection2.shards = { "s5" : "foo" };
+      assertTrue(agency.set("Plan/Collections/test/" + collection2.id, collection2));
+      ci.flush();
+
+      for (i = 0; i < 50; ++i) {
+        assertEqual(before[i], ci.getResponsibleShard(collection1.id, { _key: "test" + i }).shardId);
+        assertEqual("s5", ci.getResponsibleShard(collection2.id, { _key: "test" + i }).shardId);
+      }
+
+      // change the shard keys
+      collection2.shardKeys = [ "value" ];
+      assertTrue(agency.set("Plan/Collections/test/" + collection2.id, collection2));
+      ci.flush();
+
+      assertFalse(ci.getResponsibleShard(collection2.id, { value: 1 }).usesDefaultShardingAttributes);
+      assertTrue(ci.getResponsibleShard(collection1.id, { _key: "test" }).usesDefaultShardingAttributes);
+
+      // remove a collection
+      assertTrue(agency.remove("Plan/Collections/test/" + collection2.id));
+      ci.flush();
+
+      try {
+        ci.getResponsibleShard(collection2.id, { value: 1 });
+        fail();
+      }
+      catch (err) {
+        assertEqual(errors.ERROR_ARANGO_COLLECTION_NOT_FOUND.code, err.errorNum);
+      }
+
+      for (i = 0; i < 50; ++i) {
+        assertEqual(before[i], ci.getResponsibleShard(collection1.id, { _key: "test" + i }).shardId);
+      }
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test getServerEndpoint
 ////////////////////////////////////////////////////////////////////////////////
@@ -29,6 +29,11 @@
 
 #include "hashes.h"
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#define TRI_HAVE_SSE42_CRC32C 1
+#endif
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                               FNV
 // -----------------------------------------------------------------------------
@@ -566,6 +571,195 @@ uint32_t TRI_Crc32HashString (char const* data) {
   return TRI_FinalCrc32(crc);
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                            CRC32C
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lookup values for crc32c 8 bytes-at-a-time calculation
+///
+/// Crc32cLookup[0] is the standard single-byte table, Crc32cLookup[k] advances
+/// a byte over k following zero bytes. generated by TRI_InitialiseHashes
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t Crc32cLookup[8][256];
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief crc32c block implementation, chosen by TRI_InitialiseHashes
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t (*BlockCrc32c) (uint32_t, char const*, size_t) = nullptr;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generates the CRC32C lookup tables
+////////////////////////////////////////////////////////////////////////////////
+
+static void GenerateCrc32cLookup (void) {
+  // reflected Castagnoli polynomial
+  uint32_t const polynomial = 0x82F63B78;
+
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t value = i;
+
+    for (int j = 0; j < 8; ++j) {
+      value = (value >> 1) ^ ((value & 1) ? polynomial : 0);
+    }
+
+    Crc32cLookup[0][i] = value;
+  }
+
+  for (uint32_t i = 0; i < 256; ++i) {
+    for (int k = 1; k < 8; ++k) {
+      uint32_t const previous = Crc32cLookup[k - 1][i];
+      Crc32cLookup[k][i] = (previous >> 8) ^ Crc32cLookup[0][previous & 0xFF];
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block, slicing-by-8 software version
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t BlockCrc32cSoftware (uint32_t value,
+                                     char const* data,
+                                     size_t length) {
+  uint8_t const* current = reinterpret_cast<uint8_t const*>(data);
+
+  // process eight bytes at once
+  while (length >= 8) {
+    uint32_t one;
+    uint32_t two;
+    memcpy(&one, current, sizeof(uint32_t));
+    memcpy(&two, current + sizeof(uint32_t), sizeof(uint32_t));
+    one ^= value;
+
+    value = Crc32cLookup[0][(two>>24) & 0xFF] ^
+            Crc32cLookup[1][(two>>16) & 0xFF] ^
+            Crc32cLookup[2][(two>> 8) & 0xFF] ^
+            Crc32cLookup[3][ two      & 0xFF] ^
+            Crc32cLookup[4][(one>>24) & 0xFF] ^
+            Crc32cLookup[5][(one>>16) & 0xFF] ^
+            Crc32cLookup[6][(one>> 8) & 0xFF] ^
+            Crc32cLookup[7][ one      & 0xFF];
+    current += 8;
+    length -= 8;
+  }
+
+  // remaining 1 to 7 bytes
+  while (length--) {
+    value = (value >> 8) ^ Crc32cLookup[0][(value & 0xFF) ^ *current++];
+  }
+
+  return value;
+}
+
+#ifdef TRI_HAVE_SSE42_CRC32C
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block, using the SSE4.2 crc32 instruction
+///
+/// the instruction is emitted via inline assembly so the file does not need
+/// to be compiled with -msse4.2. it is only called if the CPU supports it
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t BlockCrc32cHardware (uint32_t value,
+                                     char const* data,
+                                     size_t length) {
+  uint64_t value64 = value;
+
+  // process eight bytes at once
+  while (length >= 8) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(uint64_t));
+
+    __asm__("crc32q %1, %0" : "+r" (value64) : "rm" (word));
+    data += 8;
+    length -= 8;
+  }
+
+  value = static_cast<uint32_t>(value64);
+
+  // remaining 1 to 7 bytes
+  while (length--) {
+    uint8_t byte = static_cast<uint8_t>(*data++);
+
+    __asm__("crc32b %1, %0" : "+r" (value) : "rm" (byte));
+  }
+
+  return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the CPU supports SSE4.2
+////////////////////////////////////////////////////////////////////////////////
+
+static bool HasSse42 (void) {
+  unsigned int eax, ebx, ecx, edx;
+
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+    return false;
+  }
+
+  return (ecx & bit_SSE4_2) != 0;
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_BlockCrc32c (uint32_t value, char const* data, size_t length) {
+  TRI_ASSERT(BlockCrc32c != nullptr);
+
+  return BlockCrc32c(value, data, length);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block, always calculated in software
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_BlockCrc32cSoftware (uint32_t value, char const* data, size_t length) {
+  return BlockCrc32cSoftware(value, data, length);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes a CRC32C for memory blobs
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_Crc32cHashPointer (void const* data, size_t length) {
+  uint32_t crc;
+
+  crc = TRI_InitialCrc32();
+  crc = TRI_BlockCrc32c(crc, static_cast<char const*>(data), length);
+
+  return TRI_FinalCrc32(crc);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not CRC32C values are calculated in hardware
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_HasHardwareCrc32c () {
+#ifdef TRI_HAVE_SSE42_CRC32C
+  return BlockCrc32c == &BlockCrc32cHardware;
+#else
+  return false;
+#endif
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                            MODULE
 // -----------------------------------------------------------------------------
@@ -594,6 +788,15 @@ void TRI_InitialiseHashes () {
   }
 
   GenerateCrc32Polynomial();
+  GenerateCrc32cLookup();
+
+  BlockCrc32c = &BlockCrc32cSoftware;
+
+#ifdef TRI_HAVE_SSE42_CRC32C
+  if (HasSse42()) {
+    BlockCrc32c = &BlockCrc32cHardware;
+  }
+#endif
 
   Initialised = true;
 }
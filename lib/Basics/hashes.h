@@ -120,6 +120,43 @@ uint32_t TRI_Crc32HashPointer (void const*, size_t);
 
 uint32_t TRI_Crc32HashString (char const*);
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                            CRC32C
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C (Castagnoli) value of data block
+///
+/// start with TRI_InitialCrc32() and finish with TRI_FinalCrc32(), as for
+/// CRC32. uses the SSE4.2 crc32 instruction if the CPU supports it
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_BlockCrc32c (uint32_t, char const* data, size_t length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block, always calculated in software
+///
+/// this is the fallback of TRI_BlockCrc32c for CPUs without SSE4.2
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_BlockCrc32cSoftware (uint32_t, char const* data, size_t length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes a CRC32C for memory blobs
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_Crc32cHashPointer (void const*, size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not CRC32C values are calculated in hardware
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_HasHardwareCrc32c (void);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                            MODULE
 // -----------------------------------------------------------------------------
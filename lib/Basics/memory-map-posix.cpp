@@ -34,7 +34,9 @@
 #include "Basics/logging.h"
 #include "Basics/tri-strings.h"
 
+#include <fcntl.h>
 #include <sys/mman.h>
+#include <unistd.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 // @brief flush memory mapped file to disk
@@ -162,6 +164,82 @@ int TRI_ProtectMMFile (void* memoryAddress,
   return TRI_ERROR_SYS_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// @brief give a hint about the use of a memory-mapped region
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_MMFileAdvise (void* memoryAddress,
+                      size_t numOfBytes,
+                      int advice,
+                      int fileDescriptor,
+                      int64_t offset) {
+  if (madvise(memoryAddress, numOfBytes, advice) != 0) {
+    TRI_set_errno(TRI_ERROR_SYS_ERROR);
+    return TRI_ERROR_SYS_ERROR;
+  }
+
+#ifdef POSIX_FADV_DONTNEED
+  if (advice == TRI_MADVISE_DONTNEED && fileDescriptor >= 0) {
+    // the mapping does not reference the pages anymore, so they can be
+    // dropped from the page cache, too. this is a hint only
+    posix_fadvise(fileDescriptor, (off_t) offset, (off_t) numOfBytes, POSIX_FADV_DONTNEED);
+  }
+#endif
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// @brief return the number of bytes of a memory-mapped region held in memory
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_MMFileResidentSize (void* memoryAddress,
+                            size_t numOfBytes,
+                            size_t* resident) {
+  // inspect the region in chunks to keep the page vector small
+  static size_t const ChunkPages = 4096;
+
+  size_t const pageSize = (size_t) getpagesize();
+  char* p = static_cast<char*>(memoryAddress);
+  char const* end = p + numOfBytes;
+#ifdef __APPLE__
+  char pages[ChunkPages];
+#else
+  unsigned char pages[ChunkPages];
+#endif
+
+  *resident = 0;
+
+  while (p < end) {
+    size_t length = (size_t) (end - p);
+
+    if (length > ChunkPages * pageSize) {
+      length = ChunkPages * pageSize;
+    }
+
+    if (mincore(p, length, pages) != 0) {
+      TRI_set_errno(TRI_ERROR_SYS_ERROR);
+      return TRI_ERROR_SYS_ERROR;
+    }
+
+    size_t const n = (length + pageSize - 1) / pageSize;
+
+    for (size_t i = 0;  i < n;  ++i) {
+      if (pages[i] & 1) {
+        *resident += pageSize;
+      }
+    }
+
+    p += length;
+  }
+
+  if (*resident > numOfBytes) {
+    *resident = numOfBytes;
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 #endif
 
 // -----------------------------------------------------------------------------
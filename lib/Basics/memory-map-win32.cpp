@@ -328,6 +328,24 @@ int TRI_ProtectMMFile(void* memoryAddress,  size_t numOfBytesToProtect, int flag
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// @brief give a hint about the use of a memory-mapped region -- not supported
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_MMFileAdvise (void* memoryAddress, size_t numOfBytes, int advice, int fileDescriptor, int64_t offset) {
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// @brief resident size of a memory-mapped region -- not supported
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_MMFileResidentSize (void* memoryAddress, size_t numOfBytes, size_t* resident) {
+  *resident = 0;
+
+  return TRI_ERROR_NOT_IMPLEMENTED;
+}
+
 
 #endif
 
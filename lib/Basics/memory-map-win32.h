@@ -56,6 +56,16 @@
 
 #define TRI_MMAP_ANONYMOUS MAP_ANONYMOUS
 
+////////////////////////////////////////////////////////////////////////////////
+// Hints for TRI_MMFileAdvise -- ignored under windows
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_MADVISE_NORMAL     0
+#define TRI_MADVISE_SEQUENTIAL 1
+#define TRI_MADVISE_RANDOM     2
+#define TRI_MADVISE_WILLNEED   3
+#define TRI_MADVISE_DONTNEED   4
+
 ////////////////////////////////////////////////////////////////////////////////
 // Define some dummy flags which are ignored under windows.
 // Under windows only the MS_SYNC flag makes sense, that is, all memory map
@@ -111,6 +111,31 @@ int TRI_ProtectMMFile (void* memoryAddress,
                        int fileDescriptor,
                        void** mmHandle);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief gives the operating system a hint about the expected use of a
+/// memory mapped region
+///
+/// advice must be one of the TRI_MADVISE_* values. if fileDescriptor is valid
+/// and advice is TRI_MADVISE_DONTNEED, the pages of the file are also dropped
+/// from the page cache. the mapping itself stays valid, and the pages are
+/// read in again from the file when the region is accessed next
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_MMFileAdvise (void* memoryAddress,
+                      size_t numOfBytes,
+                      int advice,
+                      int fileDescriptor,
+                      int64_t offset);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the number of bytes of a memory mapped region that are
+/// currently held in memory
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_MMFileResidentSize (void* memoryAddress,
+                            size_t numOfBytes,
+                            size_t* resident);
+
 #endif
 
 // -----------------------------------------------------------------------------
@@ -90,6 +90,7 @@ SkipListNode* SkipList::allocNode (int height) {
 
   newNode->_doc = nullptr;
   newNode->_height = height;
+  newNode->_bulk = false;
   newNode->_next = reinterpret_cast<SkipListNode**>(static_cast<char*>(ptr) + sizeof(SkipListNode));
 
   for (int i = 0; i < newNode->_height; i++) {
@@ -108,6 +109,13 @@ SkipListNode* SkipList::allocNode (int height) {
 ////////////////////////////////////////////////////////////////////////////////
 
 void SkipList::freeNode (SkipListNode* node) {
+  if (node->_bulk) {
+    // the node is part of a block allocated by bulkLoad, the block
+    // is only released as a whole when the skiplist is destroyed
+    node->~SkipListNode();
+    return;
+  }
+
   // update memory usage
   _memoryUsed -= sizeof(SkipListNode) +
                  sizeof(SkipListNode*) * node->_height;
@@ -118,6 +126,27 @@ void SkipList::freeNode (SkipListNode* node) {
   TRI_Free(TRI_UNKNOWN_MEM_ZONE, node);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief deterministic height of the i-th node of a bulk-loaded skiplist
+///
+/// This is 1 + the number of trailing zero bits of i + 1, i.e. every node
+/// has height >= 1, every second node has height >= 2, every fourth node
+/// height >= 3 and so on, just like the expected distribution of
+/// randomHeight.
+////////////////////////////////////////////////////////////////////////////////
+
+static int bulkHeight (size_t i) {
+  size_t v = i + 1;
+  int height = 1;
+
+  while ((v & 1) == 0 && height < TRI_SKIPLIST_MAX_HEIGHT) {
+    v >>= 1;
+    height++;
+  }
+
+  return height;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief lookupLess
 /// The following function is the main search engine for our skiplists.
@@ -323,6 +352,10 @@ SkipList::~SkipList () {
   }
 
   freeNode(_start);
+
+  for (auto block : _bulkBlocks) {
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, block);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -460,6 +493,110 @@ int SkipList::remove (void* doc) {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief builds the skiplist bottom-up from an array of documents
+///
+/// The skiplist must be empty and docs must be sorted in the proper total
+/// order. All nodes are allocated in one block in level-0 order and get
+/// deterministic heights. Returns TRI_ERROR_NO_ERROR if all is well,
+/// TRI_ERROR_OUT_OF_MEMORY if allocation failed, TRI_ERROR_BAD_PARAMETER
+/// if the skiplist is not empty or docs is not sorted and
+/// TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED if docs contains duplicates.
+/// In the error cases nothing is inserted.
+////////////////////////////////////////////////////////////////////////////////
+
+int SkipList::bulkLoad (std::vector<void*> const& docs) {
+  if (_nrUsed != 0) {
+    return TRI_ERROR_BAD_PARAMETER;
+  }
+
+  size_t const n = docs.size();
+
+  if (n == 0) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  // validate the input first, so nothing has to be undone later
+  for (size_t i = 1; i < n; i++) {
+    int cmp = _cmp_elm_elm(_cmpdata, docs[i - 1], docs[i], SKIPLIST_CMP_TOTORDER);
+
+    if (cmp > 0) {
+      return TRI_ERROR_BAD_PARAMETER;
+    }
+    if (cmp == 0) {
+      return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+    }
+    if (_unique &&
+        0 == _cmp_elm_elm(_cmpdata, docs[i - 1], docs[i], SKIPLIST_CMP_PREORDER)) {
+      return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+    }
+  }
+
+  // allocate all nodes plus their towers in one go
+  size_t size = 0;
+  for (size_t i = 0; i < n; i++) {
+    size += sizeof(SkipListNode) + sizeof(SkipListNode*) * bulkHeight(i);
+  }
+
+  char* block = static_cast<char*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, size, false));
+
+  if (block == nullptr) {
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  try {
+    _bulkBlocks.emplace_back(block);
+  }
+  catch (...) {
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, block);
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  _memoryUsed += size;
+
+  // last[lev] is the last node linked so far on level lev
+  SkipListNode* last[TRI_SKIPLIST_MAX_HEIGHT];
+  for (int lev = 0; lev < TRI_SKIPLIST_MAX_HEIGHT; lev++) {
+    last[lev] = _start;
+  }
+
+  char* ptr = block;
+  int maxHeight = 1;
+
+  for (size_t i = 0; i < n; i++) {
+    int height = bulkHeight(i);
+
+    // use placement new
+    SkipListNode* node = new(ptr) SkipListNode();
+    node->_doc = docs[i];
+    node->_height = height;
+    node->_bulk = true;
+    node->_next = reinterpret_cast<SkipListNode**>(ptr + sizeof(SkipListNode));
+    node->_prev = last[0];
+
+    for (int lev = 0; lev < height; lev++) {
+      node->_next[lev] = nullptr;
+      last[lev]->_next[lev] = node;
+      last[lev] = node;
+    }
+
+    if (height > maxHeight) {
+      maxHeight = height;
+    }
+
+    ptr += sizeof(SkipListNode) + sizeof(SkipListNode*) * height;
+  }
+
+  TRI_ASSERT(ptr == block + size);
+
+  // Note that _start is already initialised with nullptr to the top!
+  _start->_height = maxHeight;
+  _end = last[0];
+  _nrUsed = n;
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief looks up doc in the skiplist using the proper order
 /// comparison.
@@ -564,6 +701,79 @@ SkipListNode* SkipList::rightKeyLookup (void* key) const {
   return pos[0];
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief splits the range (left, right] into at most n sub-ranges
+///
+/// Returns the boundaries left, ..., right of the sub-ranges. The split
+/// points are taken from the highest level that has at least n - 1 nodes
+/// strictly between left and right, so only a small part of the range
+/// is visited.
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector<SkipListNode*> SkipList::partition (SkipListNode* left,
+                                                SkipListNode* right,
+                                                size_t n) const {
+  TRI_ASSERT(left != nullptr);
+  TRI_ASSERT(right != nullptr);
+
+  std::vector<SkipListNode*> result;
+  result.emplace_back(left);
+
+  if (right == left ||
+      right == _start ||
+      (left != _start &&
+       _cmp_elm_elm(_cmpdata, right->_doc, left->_doc, SKIPLIST_CMP_TOTORDER) <= 0)) {
+    // empty range
+    result.emplace_back(left);
+    return result;
+  }
+
+  if (n > 1) {
+    // pos[lev] is the last node on level lev that is not behind left
+    SkipListNode* pos[TRI_SKIPLIST_MAX_HEIGHT];
+
+    if (left == _start) {
+      for (int lev = 0; lev < _start->_height; lev++) {
+        pos[lev] = _start;
+      }
+    }
+    else {
+      SkipListNode* next;
+      lookupLessOrEq(left->_doc, &pos, &next, SKIPLIST_CMP_TOTORDER);
+      TRI_ASSERT(pos[0] == left);
+    }
+
+    std::vector<SkipListNode*> candidates;
+
+    for (int lev = _start->_height - 1; lev >= 0; lev--) {
+      candidates.clear();
+
+      SkipListNode* node = pos[lev]->_next[lev];
+      while (node != nullptr &&
+             node != right &&
+             _cmp_elm_elm(_cmpdata, node->_doc, right->_doc, SKIPLIST_CMP_TOTORDER) < 0) {
+        candidates.emplace_back(node);
+        node = node->_next[lev];
+      }
+
+      if (candidates.size() >= n - 1) {
+        break;
+      }
+    }
+
+    // pick the split points evenly from the candidates
+    size_t const m = candidates.size();
+    size_t const k = (std::min)(n - 1, m);
+
+    for (size_t j = 1; j <= k; j++) {
+      result.emplace_back(candidates[j * m / (k + 1)]);
+    }
+  }
+
+  result.emplace_back(right);
+  return result;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -56,6 +56,7 @@ namespace triagens {
         SkipListNode* _prev;
         void* _doc;
         int _height;
+        bool _bulk;       // node lives in a block allocated by bulkLoad
       public:
         void* document () {
           return _doc;
@@ -125,6 +126,7 @@ namespace triagens {
                           // are equal in the preorder are allowed in
         uint64_t _nrUsed;
         size_t _memoryUsed;
+        std::vector<void*> _bulkBlocks;  // node blocks allocated by bulkLoad
 
       public:
 
@@ -216,6 +218,25 @@ namespace triagens {
 
         int remove (void* doc);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief builds the skiplist bottom-up from an array of documents
+///
+/// The skiplist must be empty and docs must be sorted ascendingly in the
+/// proper total order. Tower heights are not random but deterministic
+/// (node i gets 1 + the number of trailing zero bits of i + 1, which yields
+/// the same expected height distribution as insert), and all nodes are
+/// allocated in a single block in level-0 order, so that scans walk
+/// through memory sequentially. Returns TRI_ERROR_NO_ERROR if all is well,
+/// TRI_ERROR_OUT_OF_MEMORY if allocation failed, TRI_ERROR_BAD_PARAMETER
+/// if the skiplist is not empty or docs is not sorted and
+/// TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED if two documents compare
+/// equal in the proper total order or, for a unique skiplist, in the
+/// preorder. In the error cases nothing is inserted and the ownership of
+/// the documents stays with the caller.
+////////////////////////////////////////////////////////////////////////////////
+
+        int bulkLoad (std::vector<void*> const& docs);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns the number of entries in the skiplist.
 ////////////////////////////////////////////////////////////////////////////////
@@ -278,6 +299,24 @@ namespace triagens {
 
         SkipListNode* rightKeyLookup (void* key) const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief splits the range (left, right] into at most n sub-ranges
+///
+/// left and right are nodes as returned by the left*Lookup and right*Lookup
+/// methods. The result contains the boundaries b[0] = left, ..., b[k] = right
+/// with k <= n, and sub-range j consists of the nodes in (b[j], b[j + 1]],
+/// so that each sub-range can be consumed independently by walking
+/// nextNode() from b[j] until b[j + 1] has been processed. Split points are
+/// taken from the highest level that has enough nodes in the range, so the
+/// sub-ranges have roughly the same size and the range is not walked
+/// completely. Fewer than n sub-ranges are returned if the range does not
+/// contain enough nodes. An empty range yields { left, left }.
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<SkipListNode*> partition (SkipListNode* left,
+                                              SkipListNode* right,
+                                              size_t n) const;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
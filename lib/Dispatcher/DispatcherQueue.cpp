@@ -37,10 +37,24 @@
 #include "Basics/ConditionLocker.h"
 #include "Basics/logging.h"
 #include "Dispatcher/DispatcherThread.h"
+#include "Statistics/statistics.h"
 
 using namespace std;
 using namespace triagens::rest;
 
+static_assert(Job::NUM_PRIORITIES == TRI_STATISTICS_QUEUE_LANES,
+              "invalid number of dispatcher queue lanes");
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private constants
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief every n-th job is taken from a lower priority lane, if possible
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t const FAIRNESS_INTERVAL = 8;
+
 // -----------------------------------------------------------------------------
 // constructors and destructors
 // -----------------------------------------------------------------------------
@@ -60,6 +74,8 @@ DispatcherQueue::DispatcherQueue (Scheduler* scheduler,
     _threadData(threadData),
     _accessQueue(),
     _readyJobs(),
+    _nrReady(0),
+    _nrDequeued(0),
     _runningJobs(),
     _maxSize(maxSize),
     _stopping(0),
@@ -104,10 +120,13 @@ DispatcherQueue::~DispatcherQueue () {
 bool DispatcherQueue::addJob (Job* job) {
   TRI_ASSERT(job != nullptr);
 
+  size_t const lane = static_cast<size_t>(job->priority());
+  TRI_ASSERT(lane < Job::NUM_PRIORITIES);
+
   CONDITION_LOCKER(guard, _accessQueue);
 
   // queue is full
-  if (_readyJobs.size() >= _maxSize) {
+  if (_nrReady >= _maxSize) {
     return false;
   }
 
@@ -116,18 +135,27 @@ bool DispatcherQueue::addJob (Job* job) {
     startQueueThread();
   }
 
-  // add the job to the list of ready jobs
+  // add the job to the lane of ready jobs
   try {
-    _readyJobs.emplace_back(job);
+    _readyJobs[lane].emplace_back(job);
   }
   catch (...) { 
     // could not add job
     return false;
   }
 
-  // wake up the _dispatcher queue threads
+  ++_nrReady;
+
+#ifdef TRI_ENABLE_FIGURES
+  ++TRI_LaneQueueDepthStatistics[lane];
+#endif
+
+  RequestStatisticsAgentSetQueueLane(job, lane);
+
+  // wake up one of the _dispatcher queue threads. one job needs only one
+  // thread, waking up all of them would just make them compete for the lock
   if (0 < _nrWaiting) {
-    guard.broadcast();
+    guard.signal();
   }
 
   return true;
@@ -155,32 +183,39 @@ bool DispatcherQueue::cancelJob (uint64_t jobId) {
   }
 
   // maybe there is a waiting job with this it, try to remove it
-  for (list<Job*>::iterator it = _readyJobs.begin();  it != _readyJobs.end();  ++it) {
-    Job* job = *it;
+  for (size_t lane = 0;  lane < Job::NUM_PRIORITIES;  ++lane) {
+    for (auto it = _readyJobs[lane].begin();  it != _readyJobs[lane].end();  ++it) {
+      Job* job = *it;
 
-    if (job->id() == jobId) {
-      bool canceled = job->cancel(false);
+      if (job->id() == jobId) {
+        bool canceled = job->cancel(false);
 
-      if (canceled) {
-        try {
-          job->setDispatcherThread(nullptr);
-          job->cleanup();
-        }
-        catch (...) {
-#ifdef TRI_HAVE_POSIX_THREADS
-          if (_stopping != 0) {
-            LOG_WARNING("caught cancellation exception during cleanup");
-            throw;
+        if (canceled) {
+          try {
+            job->setDispatcherThread(nullptr);
+            job->cleanup();
           }
+          catch (...) {
+#ifdef TRI_HAVE_POSIX_THREADS
+            if (_stopping != 0) {
+              LOG_WARNING("caught cancellation exception during cleanup");
+              throw;
+            }
 #endif
 
-          LOG_WARNING("caught error while cleaning up!");
+            LOG_WARNING("caught error while cleaning up!");
+          }
+
+          _readyJobs[lane].erase(it);
+          --_nrReady;
+
+#ifdef TRI_ENABLE_FIGURES
+          --TRI_LaneQueueDepthStatistics[lane];
+#endif
         }
 
-        _readyJobs.erase(it);
+        return true;
       }
-
-      return true;
     }
   }
 
@@ -274,21 +309,31 @@ void DispatcherQueue::beginShutdown () {
   // kill all jobs in the queue that were not yet executed
   {
     CONDITION_LOCKER(guard, _accessQueue);
-    for (auto it = _readyJobs.begin();  it != _readyJobs.end();  ++it) {
-      Job* job = *it;
 
-      bool canceled = job->cancel(false);
+    for (size_t lane = 0;  lane < Job::NUM_PRIORITIES;  ++lane) {
+      for (auto it = _readyJobs[lane].begin();  it != _readyJobs[lane].end();  ++it) {
+        Job* job = *it;
 
-      if (canceled) {
-        try {
-          job->setDispatcherThread(nullptr);
-          job->cleanup();
-        }
-        catch (...) {
+        bool canceled = job->cancel(false);
+
+        if (canceled) {
+          try {
+            job->setDispatcherThread(nullptr);
+            job->cleanup();
+          }
+          catch (...) {
+          }
         }
       }
+
+#ifdef TRI_ENABLE_FIGURES
+      TRI_LaneQueueDepthStatistics[lane] -= static_cast<int64_t>(_readyJobs[lane].size());
+#endif
+
+      _readyJobs[lane].clear();
     }
-    _readyJobs.clear();
+
+    _nrReady = 0;
   }
 
 
@@ -409,6 +454,58 @@ void DispatcherQueue::setProcessorAffinity (const vector<size_t>& cores) {
   _affinityCores = cores;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the lane to take the next job from
+////////////////////////////////////////////////////////////////////////////////
+
+size_t DispatcherQueue::nextLane () const {
+  if (_nrReady == 0) {
+    return Job::NUM_PRIORITIES;
+  }
+
+  size_t first = 0;
+
+  if (_nrDequeued % FAIRNESS_INTERVAL == FAIRNESS_INTERVAL - 1) {
+    // give the lower lanes a turn, one after the other
+    first = 1 + static_cast<size_t>(_nrDequeued / FAIRNESS_INTERVAL) % (Job::NUM_PRIORITIES - 1);
+  }
+
+  for (size_t i = 0;  i < Job::NUM_PRIORITIES;  ++i) {
+    size_t const lane = (first + i) % Job::NUM_PRIORITIES;
+
+    if (! _readyJobs[lane].empty()) {
+      return lane;
+    }
+  }
+
+  return Job::NUM_PRIORITIES;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes the first job of a lane and returns it
+////////////////////////////////////////////////////////////////////////////////
+
+Job* DispatcherQueue::popJob (size_t lane) {
+  TRI_ASSERT(lane < Job::NUM_PRIORITIES);
+  TRI_ASSERT(! _readyJobs[lane].empty());
+
+  Job* job = _readyJobs[lane].front();
+  _readyJobs[lane].pop_front();
+
+  --_nrReady;
+  ++_nrDequeued;
+
+#ifdef TRI_ENABLE_FIGURES
+  --TRI_LaneQueueDepthStatistics[lane];
+#endif
+
+  return job;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -35,6 +35,7 @@
 
 #include "Basics/ConditionVariable.h"
 #include "Dispatcher/Dispatcher.h"
+#include "Dispatcher/Job.h"
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                              forward declarations
@@ -43,7 +44,6 @@
 namespace triagens {
   namespace rest {
     class DispatcherThread;
-    class Job;
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                             class DispatcherQueue
@@ -171,6 +171,30 @@ namespace triagens {
 
         void setProcessorAffinity (const std::vector<size_t>& cores);
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the lane to take the next job from
+///
+/// Lanes are served in order of priority. Every FAIRNESS_INTERVAL-th job is
+/// taken from one of the lower lanes instead, if it has jobs, so that a steady
+/// stream of high priority jobs cannot starve them. Returns NUM_PRIORITIES if
+/// there are no ready jobs. Must be called with the queue lock held.
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t nextLane () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes the first job of a lane and returns it. Must be called with
+/// the queue lock held.
+////////////////////////////////////////////////////////////////////////////////
+
+        Job* popJob (size_t lane);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
@@ -196,10 +220,22 @@ namespace triagens {
         basics::ConditionVariable _accessQueue;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief list of ready jobs
+/// @brief lists of ready jobs, one lane per job priority
+////////////////////////////////////////////////////////////////////////////////
+
+        std::list<Job*> _readyJobs[Job::NUM_PRIORITIES];
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief total number of ready jobs in all lanes
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _nrReady;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of jobs taken from the lanes so far
 ////////////////////////////////////////////////////////////////////////////////
 
-        std::list<Job*> _readyJobs;
+        uint64_t _nrDequeued;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief current running job
@@ -278,7 +314,7 @@ namespace triagens {
 /// @brief number of waiting jobs
 ///
 /// Whenever a threads waits for more work, this number is increased by 1.  As
-/// soon as the thread leaves the wait because it received a broadcast, this
+/// soon as the thread leaves the wait because it received a signal, this
 /// number is decreased by 1.
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -96,14 +96,21 @@ void DispatcherThread::run () {
     _queue->_stoppedThreads.clear();
     _queue->_nrStopped = 0;
 
+    // the lane of the next job
+    size_t const lane = _queue->nextLane();
+
     // a job is waiting to execute
-    if (  ! _queue->_readyJobs.empty()
-         && _queue->_monopolizer == 0
-         && ! (_queue->_readyJobs.front()->type() == Job::WRITE_JOB && 1 < _queue->_nrRunning)) {
+    if (   lane < Job::NUM_PRIORITIES
+        && _queue->_monopolizer == 0
+        && ! (_queue->_readyJobs[lane].front()->type() == Job::WRITE_JOB && 1 < _queue->_nrRunning)) {
 
       // try next job
-      Job* job = _queue->_readyJobs.front();
-      _queue->_readyJobs.pop_front();
+      Job* job = _queue->popJob(lane);
+
+      // pass on the wake-up if there is more work than running threads
+      if (0 < _queue->_nrWaiting && 0 < _queue->_nrReady) {
+        _queue->_accessQueue.signal();
+      }
 
       // handle job type
       _jobType = job->type();
@@ -262,8 +269,8 @@ void DispatcherThread::run () {
       // cleanup
       _queue->_monopolizer = 0;
 
-      if (0 < _queue->_nrWaiting && ! _queue->_readyJobs.empty()) {
-        _queue->_accessQueue.broadcast();
+      if (0 < _queue->_nrWaiting && 0 < _queue->_nrReady) {
+        _queue->_accessQueue.signal();
       }
     }
     else {
@@ -284,7 +291,7 @@ void DispatcherThread::run () {
       }
 
       // wait, if there are no jobs
-      if (_queue->_readyJobs.empty()) {
+      if (_queue->_nrReady == 0) {
         _queue->_nrRunning--;
         _queue->_nrWaiting++;
 
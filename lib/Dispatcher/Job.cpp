@@ -71,6 +71,14 @@ std::string const& Job::queue () const {
   return QUEUE_NAME;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the priority of the job
+////////////////////////////////////////////////////////////////////////////////
+
+Job::JobPriority Job::priority () const {
+  return MEDIUM_PRIORITY;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief sets the thread which currently dealing with the job
 ////////////////////////////////////////////////////////////////////////////////
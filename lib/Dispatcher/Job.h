@@ -72,6 +72,30 @@ namespace triagens {
           SPECIAL_JOB
         };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief job priorities
+///
+/// Each dispatcher queue keeps one lane of ready jobs per priority. Jobs of
+/// a higher priority are taken first, but lower lanes regularly get a turn
+/// so that they cannot starve.
+///
+/// HIGH_PRIORITY is used for cluster-internal requests, which other servers
+/// are waiting for, LOW_PRIORITY for bulk and background work such as imports,
+/// replication and queued tasks.
+////////////////////////////////////////////////////////////////////////////////
+
+        enum JobPriority {
+          HIGH_PRIORITY = 0,
+          MEDIUM_PRIORITY = 1,
+          LOW_PRIORITY = 2
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of job priorities
+////////////////////////////////////////////////////////////////////////////////
+
+        static size_t const NUM_PRIORITIES = 3;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief status of execution
 ////////////////////////////////////////////////////////////////////////////////
@@ -172,6 +196,12 @@ namespace triagens {
 
         virtual std::string const& queue () const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the priority of the job
+////////////////////////////////////////////////////////////////////////////////
+
+        virtual JobPriority priority () const;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief sets the thread which currently dealing with the job
 ////////////////////////////////////////////////////////////////////////////////
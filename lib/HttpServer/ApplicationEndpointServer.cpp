@@ -103,6 +103,9 @@ ApplicationEndpointServer::ApplicationEndpointServer (ApplicationServer* applica
     _keepAliveTimeout(300.0),
     _defaultApiCompatibility(0),
     _allowMethodOverride(false),
+    _compressionThreshold(0),
+    _compressionLevel(1),
+    _compressionContentTypes(),
     _backlogSize(64),
     _httpsKeyfile(),
     _cafile(),
@@ -215,6 +218,9 @@ void ApplicationEndpointServer::setupOptions (map<string, ProgramOptionsDescript
   options["Server Options:help-admin"]
     ("server.allow-method-override", &_allowMethodOverride, "allow HTTP method override using special headers")
     ("server.backlog-size", &_backlogSize, "listen backlog size")
+    ("server.compression-content-type", &_compressionContentTypes, "content type prefix of compressed responses")
+    ("server.compression-level", &_compressionLevel, "compression level for responses (1 = fastest, 9 = best)")
+    ("server.compression-threshold", &_compressionThreshold, "minimal body size in bytes for compressed responses (0 = no compression)")
     ("server.default-api-compatibility", &_defaultApiCompatibility, "default API compatibility version")
     ("server.keep-alive-timeout", &_keepAliveTimeout, "keep-alive timeout in seconds")
     ("server.reuse-address", &_reuseAddress, "try to reuse address")
@@ -250,6 +256,10 @@ bool ApplicationEndpointServer::parsePhase2 (ProgramOptions& options) {
     LOG_WARNING("value for --server.backlog-size exceeds default system header SOMAXCONN value %d. trying to use %d anyway", (int) SOMAXCONN, (int) SOMAXCONN);
   }
 
+  if (_compressionLevel < 1 || _compressionLevel > 9) {
+    LOG_FATAL_AND_EXIT("invalid value for --server.compression-level. expecting a value between 1 and 9");
+  }
+
   if (! _httpPort.empty()) {
     // issue #175: add hidden option --server.http-port for downwards-compatibility
     string httpEndpoint("tcp://" + _httpPort);
@@ -561,8 +571,23 @@ bool ApplicationEndpointServer::prepare () {
                                            _setContext,
                                            _contextData);
 
+  HttpHandlerFactory::compression_policy_t policy;
+  policy.minimalSize = static_cast<size_t>(_compressionThreshold);
+  policy.level = _compressionLevel;
+  policy.contentTypes = _compressionContentTypes;
+
+  if (policy.contentTypes.empty()) {
+    policy.contentTypes = { "application/json", "application/javascript", "application/x-arango-dump", "text/" };
+  }
+
+  _handlerFactory->setCompressionPolicy(policy);
+
   LOG_INFO("using default API compatibility: %ld", (long int) _defaultApiCompatibility);
 
+  if (policy.minimalSize > 0) {
+    LOG_INFO("compressing responses with at least %llu bytes", (unsigned long long) policy.minimalSize);
+  }
+
   return true;
 }
 
@@ -432,6 +432,54 @@ namespace triagens {
 
         bool _allowMethodOverride;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief minimal body size for compressed responses
+/// @startDocuBlock serverCompressionThreshold
+/// `--server.compression-threshold`
+///
+/// Response bodies with at least this many bytes are compressed if the client
+/// announced support for the *deflate* or *gzip* content encoding via the
+/// *Accept-Encoding* request header. Compression takes place on the
+/// dispatcher threads after the request has been handled, and streamed
+/// responses are compressed chunk by chunk. Responses of requests that are
+/// handled directly by the I/O threads are never compressed.
+///
+/// The default value is *0*, which turns off response compression.
+///
+/// Independent of this option, the server accepts request bodies that are
+/// compressed with *deflate* or *gzip* and flagged as such by the
+/// *Content-Encoding* request header.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t _compressionThreshold;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compression level for responses
+/// @startDocuBlock serverCompressionLevel
+/// `--server.compression-level`
+///
+/// The zlib compression level used for compressed responses, ranging from *1*
+/// (fastest) to *9* (best compression). The default value is *1*.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        int32_t _compressionLevel;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief content types of compressed responses
+/// @startDocuBlock serverCompressionContentTypes
+/// `--server.compression-content-type`
+///
+/// Only responses whose content type starts with one of the given prefixes
+/// are compressed. The option can be specified multiple times. If it is not
+/// specified, responses of type *application/json*, *application/javascript*,
+/// *application/x-arango-dump* and *text/* are compressed.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::string> _compressionContentTypes;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief listen backlog size
 /// @startDocuBlock serverBacklog
@@ -33,15 +33,35 @@
 #include "Basics/StringBuffer.h"
 #include "Basics/logging.h"
 #include "Basics/MutexLocker.h"
+#include "Dispatcher/Dispatcher.h"
 #include "HttpServer/HttpHandler.h"
 #include "HttpServer/HttpHandlerFactory.h"
 #include "HttpServer/HttpServer.h"
+#include "HttpServer/HttpStreamJob.h"
 #include "Scheduler/Scheduler.h"
 
 using namespace triagens::basics;
 using namespace triagens::rest;
 using namespace std;
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private constants
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief minimal size of a request body that is handed over to the request
+/// together with the read buffer instead of being copied
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const MinimalAdoptBodySize = 64 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief minimal size of a response body that is handed over to the write
+/// queue as a buffer of its own instead of being copied behind the header
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const MinimalHandOverBodySize = 64 * 1024;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                            class AsyncChunkedTask
 // -----------------------------------------------------------------------------
@@ -178,6 +198,12 @@ HttpCommTask::HttpCommTask (HttpServer* server,
     _originalBodyLength(0),
     _isChunked(false),
     _chunkedTask(this),
+    _stream(nullptr),
+    _streaming(false),
+    _streamDelivered(false),
+    _deliveredStream(nullptr),
+    _deliveredBody(nullptr),
+    _streamLock(),
     _setupDone(false) {
   LOG_TRACE(
     "connection established, client %d, server ip %s, server port %d, client ip %s, client port %d",
@@ -226,6 +252,11 @@ HttpCommTask::~HttpCommTask () {
   if (_request != nullptr) {
     delete _request;
   }
+
+  // abandon an unfinished streamed response
+  delete _stream;
+  delete _deliveredStream;
+  delete _deliveredBody;
 }
 
 // -----------------------------------------------------------------------------
@@ -240,6 +271,24 @@ int HttpCommTask::signalChunk (const string& data) {
   return _chunkedTask.signalChunk(data);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief signals the next part of a streamed response
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpCommTask::signalStreamChunk (HttpResponseStream* stream,
+                                      StringBuffer* body) {
+  {
+    MUTEX_LOCKER(_streamLock);
+
+    TRI_ASSERT(! _streamDelivered);
+    _streamDelivered = true;
+    _deliveredStream = stream;
+    _deliveredBody = body;
+  }
+
+  AsyncTask::signal();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief begins shutdown 
 ////////////////////////////////////////////////////////////////////////////////
@@ -262,7 +311,12 @@ void HttpCommTask::beginShutdown ()  {
 ////////////////////////////////////////////////////////////////////////////////
 
 void HttpCommTask::handleResponse (HttpResponse * response)  {
-  if (response->isChunked()) {
+  if (response->hasStream()) {
+    // further requests are processed once the stream is exhausted
+    _requestPending = true;
+    _isChunked = false;
+  }
+  else if (response->isChunked()) {
     _requestPending = true;
     _isChunked = true;
   }
@@ -544,11 +598,23 @@ bool HttpCommTask::processRead () {
       return false;
     }
 
-    // read "bodyLength" from read buffer and add this body to "httpRequest"
-    _request->setBody(_readBuffer->c_str() + _bodyPosition, _bodyLength);
-
     LOG_TRACE("%s", string(_readBuffer->c_str() + _bodyPosition, _bodyLength).c_str());
 
+    // read "bodyLength" from read buffer and add this body to "httpRequest"
+    if (_bodyLength >= MinimalAdoptBodySize &&
+        _bodyPosition + _bodyLength == _readBuffer->length()) {
+      // the body is at the end of the read buffer, i. e. nothing is pipelined
+      // behind it. hand the whole buffer over to the request instead of
+      // copying a large body, and continue reading into a fresh buffer
+      _request->adoptBody(_readBuffer->steal(), _bodyPosition, _bodyLength);
+
+      delete _readBuffer;
+      _readBuffer = new StringBuffer(TRI_UNKNOWN_MEM_ZONE);
+    }
+    else {
+      _request->setBody(_readBuffer->c_str() + _bodyPosition, _bodyLength);
+    }
+
     // remove body from read buffer and reset read position
     _readRequestBody = false;
     handleRequest = true;
@@ -763,10 +829,24 @@ void HttpCommTask::addResponse (HttpResponse* response) {
 
   size_t responseBodyLength = response->bodySize();
 
+  TRI_ASSERT(_stream == nullptr && ! _streaming);
+  _stream = response->stealStream();
+
   if (_requestType == HttpRequest::HTTP_REQUEST_HEAD) {
     // clear body if this is an HTTP HEAD request
     // HEAD must not return a body
     response->headResponse(responseBodyLength);
+
+    if (_stream != nullptr) {
+      delete _stream;
+      _stream = nullptr;
+      _requestPending = false;
+    }
+  }
+  else if (_stream != nullptr) {
+    // the remainder of the body is produced while the client reads
+    _streaming = true;
+    response->setHeader("transfer-encoding", strlen("transfer-encoding"), "chunked");
   }
   // else {
   //    // to enable automatic deflating of responses, active this.
@@ -778,31 +858,50 @@ void HttpCommTask::addResponse (HttpResponse* response) {
   //   }
   // }
 
+  // large bodies are handed over as a write buffer of their own instead
+  // of being copied behind the header
+  bool const handOverBody = (_requestType != HttpRequest::HTTP_REQUEST_HEAD &&
+                             responseBodyLength >= MinimalHandOverBodySize);
+
   // reserve some outbuffer size
   StringBuffer* buffer
-    = new StringBuffer(TRI_UNKNOWN_MEM_ZONE, responseBodyLength + 128);
+    = new StringBuffer(TRI_UNKNOWN_MEM_ZONE, (handOverBody ? 0 : responseBodyLength) + 128);
+  StringBuffer* body = nullptr;
 
   // write header
   response->writeHeader(buffer);
 
   // write body
   if (_requestType != HttpRequest::HTTP_REQUEST_HEAD) {
-    if (_isChunked) {
-      if (0 != responseBodyLength) {
+    bool const chunked = (_isChunked || _stream != nullptr);
+
+    if (! chunked || 0 != responseBodyLength) {
+      if (chunked) {
         buffer->appendHex(response->body().length());
         buffer->appendText("\r\n");
+      }
+
+      if (handOverBody) {
+        body = new StringBuffer(TRI_UNKNOWN_MEM_ZONE);
+        body->swap(&response->body());
+      }
+      else {
         buffer->appendText(response->body());
-        buffer->appendText("\r\n");
       }
-    }
-    else {
-      buffer->appendText(response->body());
+
+      if (chunked) {
+        (body != nullptr ? body : buffer)->appendText("\r\n");
+      }
     }
   }
 
   _writeBuffers.push_back(buffer);
           
   LOG_TRACE("HTTP WRITE FOR %p: %s", (void*) this, buffer->c_str());
+
+  if (body != nullptr) {
+    _writeBuffers.push_back(body);
+  }
           
   // clear body
   response->body().clear();
@@ -810,7 +909,18 @@ void HttpCommTask::addResponse (HttpResponse* response) {
   double totalTime;
 
 #ifdef TRI_ENABLE_FIGURES
-  _writeBuffersStats.push_back(RequestStatisticsAgent::transfer());
+  TRI_request_statistics_t* statistics = RequestStatisticsAgent::transfer();
+
+  if (body != nullptr) {
+    // the statistics go with the last buffer of the response
+    if (statistics != nullptr) {
+      statistics->_sentBytes += buffer->length();
+    }
+
+    _writeBuffersStats.push_back(nullptr);
+  }
+
+  _writeBuffersStats.push_back(statistics);
   totalTime = RequestStatisticsAgent::elapsedSinceReadStart();
 #else
   totalTime = 0.0;
@@ -900,6 +1010,106 @@ void HttpCommTask::fillWriteBuffer () {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief requests the next chunk of a streamed response
+///
+/// called only when everything produced before has been written, so the
+/// amount of data buffered per connection stays bounded by the chunk size.
+/// The chunk is produced by a dispatcher job, the I/O thread only writes it
+/// once it is delivered
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpCommTask::pullStream () {
+  TRI_ASSERT(_stream != nullptr && _streaming);
+
+  HttpStreamJob* job = new HttpStreamJob(taskId(), _stream);
+  _stream = nullptr;
+
+  Dispatcher* dispatcher = _server->dispatcher();
+
+  if (dispatcher == nullptr) {
+    // without a dispatcher the chunk is produced right here, it is
+    // delivered through the signal all the same
+    job->work();
+    job->cleanup();
+    return;
+  }
+
+  int res = dispatcher->addJob(job);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_WARNING("cannot queue streamed response: %s", TRI_errno_string(res));
+
+    delete job;
+    receiveStream(nullptr, nullptr);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writes the next chunk of a streamed response
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpCommTask::receiveStream (HttpResponseStream* stream,
+                                  StringBuffer* body) {
+  TRI_ASSERT(_stream == nullptr && _streaming);
+
+  if (body == nullptr) {
+    TRI_ASSERT(stream == nullptr);
+
+    // the status code has been sent already, so the only way to tell the
+    // client is to drop the connection before the last chunk
+    LOG_WARNING("could not produce streamed response, closing connection");
+
+    _streaming = false;
+    _requestPending = false;
+    _closeRequested = true;
+
+    if (! _clientClosed && ! hasWriteBuffer() && _writeBuffers.empty()) {
+      _clientClosed = true;
+      _server->handleCommunicationClosed(this);
+    }
+
+    return;
+  }
+
+  _stream = stream;
+
+  if (body->empty() && _stream != nullptr) {
+    delete body;
+    pullStream();
+    return;
+  }
+
+  if (! body->empty()) {
+    StringBuffer* buffer = new StringBuffer(TRI_UNKNOWN_MEM_ZONE, 16);
+    buffer->appendHex(body->length());
+    buffer->appendText("\r\n");
+    body->appendText("\r\n");
+
+    _writeBuffers.push_back(buffer);
+#ifdef TRI_ENABLE_FIGURES
+    _writeBuffersStats.push_back(nullptr);
+#endif
+  }
+
+  if (_stream == nullptr) {
+    body->appendText("0\r\n\r\n");
+    _streaming = false;
+  }
+
+  _writeBuffers.push_back(body);
+#ifdef TRI_ENABLE_FIGURES
+  _writeBuffersStats.push_back(nullptr);
+#endif
+
+  fillWriteBuffer();
+
+  if (! _streaming) {
+    _requestPending = false;
+    processRead();
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief handles CORS options
 ////////////////////////////////////////////////////////////////////////////////
@@ -967,6 +1177,11 @@ void HttpCommTask::processRequest (uint32_t compatibility) {
   // check for an async request
   string const& asyncExecution = _request->header("x-arango-async", found);
 
+  if (found && (asyncExecution == "true" || asyncExecution == "store")) {
+    // the response of an async job is not sent over this connection
+    _request->setClientTaskId(0);
+  }
+
   // clear request object
   _request = nullptr;
   RequestStatisticsAgent::transfer(handler);
@@ -1059,7 +1274,12 @@ void HttpCommTask::resetState (bool close) {
       compact = true;
     }
 
-    if (compact) {
+    if (_readBuffer->length() < _bodyPosition + _bodyLength) {
+      // the read buffer was handed over to the request together with the body
+      _sinceCompactification = 0;
+      _readPosition = 0;
+    }
+    else if (compact) {
       _readBuffer->erase_front(_bodyPosition + _bodyLength);
 
       _sinceCompactification = 0;
@@ -1167,7 +1387,32 @@ bool HttpCommTask::handleEvent (EventToken token, EventType events) {
 ////////////////////////////////////////////////////////////////////////////////
 
 bool HttpCommTask::handleAsync () {
-  _server->handleAsync(this);
+  HttpResponseStream* stream = nullptr;
+  StringBuffer* body = nullptr;
+  bool delivered = false;
+
+  {
+    MUTEX_LOCKER(_streamLock);
+
+    if (_streamDelivered) {
+      stream = _deliveredStream;
+      body = _deliveredBody;
+      delivered = true;
+
+      _streamDelivered = false;
+      _deliveredStream = nullptr;
+      _deliveredBody = nullptr;
+    }
+  }
+
+  if (delivered) {
+    // no handler is running while a response is streamed
+    receiveStream(stream, body);
+  }
+  else {
+    _server->handleAsync(this);
+  }
+
   return true;
 }
 
@@ -1227,7 +1472,11 @@ void HttpCommTask::completedWriteBuffer () {
 
   fillWriteBuffer();
 
-  if (! _clientClosed && _closeRequested && ! hasWriteBuffer() && _writeBuffers.empty() && ! _isChunked) {
+  if (_stream != nullptr && ! hasWriteBuffer() && _writeBuffers.empty()) {
+    pullStream();
+  }
+
+  if (! _clientClosed && _closeRequested && ! hasWriteBuffer() && _writeBuffers.empty() && ! _isChunked && ! _streaming) {
     _clientClosed = true;
     _server->handleCommunicationClosed(this);
   }
@@ -41,6 +41,7 @@ namespace triagens {
     class HttpCommTask;
     class HttpServer;
     class HttpResponse;
+    class HttpResponseStream;
     class HttpRequest;
 
 // -----------------------------------------------------------------------------
@@ -113,6 +114,12 @@ namespace triagens {
 
         int signalChunk (const std::string&);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief signals the next part of a streamed response
+////////////////////////////////////////////////////////////////////////////////
+
+        void signalStreamChunk (HttpResponseStream*, basics::StringBuffer*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief begins shutdown 
 ////////////////////////////////////////////////////////////////////////////////
@@ -173,6 +180,18 @@ namespace triagens {
 
         void fillWriteBuffer ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief requests the next chunk of a streamed response
+////////////////////////////////////////////////////////////////////////////////
+
+        void pullStream ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writes the next chunk of a streamed response
+////////////////////////////////////////////////////////////////////////////////
+
+        void receiveStream (HttpResponseStream*, basics::StringBuffer*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief handles CORS options
 ////////////////////////////////////////////////////////////////////////////////
@@ -446,6 +465,44 @@ namespace triagens {
 
         AsyncChunkedTask _chunkedTask;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stream of the response currently sent, if any
+///
+/// nullptr while a job produces the next chunk
+////////////////////////////////////////////////////////////////////////////////
+
+        HttpResponseStream* _stream;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief true while a streamed response is sent
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _streaming;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief true if a job has delivered the next chunk of the stream
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _streamDelivered;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stream handed back by the job, nullptr if exhausted or failed
+////////////////////////////////////////////////////////////////////////////////
+
+        HttpResponseStream* _deliveredStream;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief chunk handed back by the job, nullptr if it failed
+////////////////////////////////////////////////////////////////////////////////
+
+        basics::StringBuffer* _deliveredBody;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lock for the delivered chunk
+////////////////////////////////////////////////////////////////////////////////
+
+        basics::Mutex _streamLock;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief task ready
 ////////////////////////////////////////////////////////////////////////////////
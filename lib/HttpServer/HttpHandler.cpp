@@ -29,12 +29,49 @@
 
 #include "HttpHandler.h"
 
+#include "Basics/Exceptions.h"
 #include "Basics/logging.h"
+#include "Basics/StringUtils.h"
+#include "HttpServer/HttpHandlerFactory.h"
 #include "HttpServer/HttpServerJob.h"
 #include "Rest/HttpRequest.h"
 
+using namespace triagens::basics;
 using namespace triagens::rest;
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks whether an accept-encoding header allows an encoding
+////////////////////////////////////////////////////////////////////////////////
+
+static bool AcceptsEncoding (std::string const& header,
+                             std::string const& encoding) {
+  for (auto& part : StringUtils::split(header, ',')) {
+    std::string value = StringUtils::tolower(StringUtils::trim(part));
+    double quality = 1.0;
+    size_t pos = value.find(';');
+
+    if (pos != std::string::npos) {
+      std::string parameter = StringUtils::trim(value.substr(pos + 1));
+
+      if (parameter.compare(0, 2, "q=") == 0) {
+        quality = StringUtils::doubleDecimal(parameter.substr(2));
+      }
+
+      value = StringUtils::trim(value.substr(0, pos));
+    }
+
+    if (value == encoding && quality > 0.0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 class HttpHandler
 // -----------------------------------------------------------------------------
@@ -122,6 +159,94 @@ HttpResponse* HttpHandler::stealResponse () {
   return tmp;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inflates a compressed request body
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpHandler::decodeRequest () {
+  if (_request == nullptr || _server == nullptr) {
+    return;
+  }
+
+  int res = _request->inflateBody(_server->sizeRestrictions().maximalBodySize);
+
+  if (res == TRI_ERROR_OUT_OF_MEMORY) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_HTTP_BAD_PARAMETER, "inflated request body is too large");
+  }
+  else if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(res, "cannot inflate request body");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compresses the response according to the server's policy
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpHandler::compressResponse () {
+  if (_request == nullptr || _response == nullptr || _server == nullptr) {
+    return;
+  }
+
+  auto const& policy = _server->compressionPolicy();
+
+  // responses of async jobs and batch parts are not sent to the client
+  // connection directly, so the accept-encoding header does not apply
+  if (policy.minimalSize == 0 ||
+      _request->clientTaskId() == 0 ||
+      _response->isChunked()) {
+    return;
+  }
+
+  if (! _response->hasStream() && _response->body().length() < policy.minimalSize) {
+    return;
+  }
+
+  bool found = false;
+  _response->header(std::string("content-encoding"), found);
+
+  if (found) {
+    return;
+  }
+
+  std::string const contentType = _response->header("content-type");
+  bool matches = false;
+
+  for (auto const& prefix : policy.contentTypes) {
+    if (contentType.compare(0, prefix.size(), prefix) == 0) {
+      matches = true;
+      break;
+    }
+  }
+
+  if (! matches) {
+    return;
+  }
+
+  char const* accept = _request->header("accept-encoding", found);
+
+  if (! found) {
+    return;
+  }
+
+  bool gzip;
+
+  if (AcceptsEncoding(accept, "gzip")) {
+    gzip = true;
+  }
+  else if (AcceptsEncoding(accept, "deflate")) {
+    gzip = false;
+  }
+  else {
+    return;
+  }
+
+  int res = _response->compress(policy.level, gzip);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_WARNING("could not compress response: %s", TRI_errno_string(res));
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   Handler methods
 // -----------------------------------------------------------------------------
@@ -134,6 +259,23 @@ Job* HttpHandler::createJob (HttpServer* server, bool isDetached) {
   return new HttpServerJob(server, this, isDetached);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the priority of the job created for the handler
+////////////////////////////////////////////////////////////////////////////////
+
+Job::JobPriority HttpHandler::priority () const {
+  if (_request != nullptr) {
+    bool found;
+    _request->header("x-arango-coordinator", found);
+
+    if (found) {
+      return Job::HIGH_PRIORITY;
+    }
+  }
+
+  return Job::MEDIUM_PRIORITY;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 protected methods
 // -----------------------------------------------------------------------------
@@ -170,6 +312,29 @@ HttpResponse* HttpHandler::createResponse (HttpResponse::HttpResponseCode code)
   return new HttpResponse(code, apiCompatibility);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief produces the response body from a stream
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpHandler::streamResponse (HttpResponseStream* stream) {
+  TRI_ASSERT(_response != nullptr);
+
+  std::unique_ptr<HttpResponseStream> guard(stream);
+
+  // only requests read from a client connection carry a task id, and
+  // chunked transfer encoding requires HTTP/1.1
+  bool const canStream = (_request != nullptr &&
+                          _request->clientTaskId() != 0 &&
+                          _request->isHttp11());
+
+  while (guard->next(_response->body(), HttpResponse::StreamChunkSize)) {
+    if (canStream) {
+      _response->setStream(guard.release());
+      return;
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
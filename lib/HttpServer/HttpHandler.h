@@ -125,6 +125,23 @@ namespace triagens {
 
         HttpResponse* stealResponse ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inflates a compressed request body
+///
+/// throws if the body cannot be inflated
+////////////////////////////////////////////////////////////////////////////////
+
+        void decodeRequest ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compresses the response according to the server's policy
+///
+/// The response is compressed if the client accepts a supported content
+/// encoding and the response is sent to the client connection directly.
+////////////////////////////////////////////////////////////////////////////////
+
+        void compressResponse ();
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   Handler methods
 // -----------------------------------------------------------------------------
@@ -137,6 +154,15 @@ namespace triagens {
 
         Job* createJob (HttpServer*, bool isDetached) override;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the priority of the job created for the handler
+///
+/// requests sent by a coordinator on behalf of a client request are
+/// cluster-internal and have a high priority
+////////////////////////////////////////////////////////////////////////////////
+
+        Job::JobPriority priority () const override;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 protected methods
 // -----------------------------------------------------------------------------
@@ -155,6 +181,19 @@ namespace triagens {
 
         HttpResponse* createResponse (HttpResponse::HttpResponseCode);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief produces the response body from a stream
+///
+/// The first part of the body is produced right away. If the stream has more
+/// to deliver, it is attached to the response and the remainder is produced
+/// while the client consumes the data. Responses that are not delivered to a
+/// client connection directly (async jobs, batch parts) and responses to
+/// HTTP/1.0 clients get the complete body. The handler takes ownership of the
+/// stream.
+////////////////////////////////////////////////////////////////////////////////
+
+        void streamResponse (HttpResponseStream*);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                               protected variables
 // -----------------------------------------------------------------------------
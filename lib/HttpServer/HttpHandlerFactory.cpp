@@ -93,7 +93,11 @@ HttpHandlerFactory::HttpHandlerFactory (std::string const& authenticationRealm,
     _allowMethodOverride(allowMethodOverride),
     _setContext(setContext),
     _setContextData(setContextData),
-    _notFound(nullptr) {
+    _notFound(nullptr),
+    _compressionPolicy() {
+
+  _compressionPolicy.minimalSize = 0;
+  _compressionPolicy.level = -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -109,7 +113,8 @@ HttpHandlerFactory::HttpHandlerFactory (HttpHandlerFactory const& that)
     _constructors(that._constructors),
     _datas(that._datas),
     _prefixes(that._prefixes),
-    _notFound(that._notFound) {
+    _notFound(that._notFound),
+    _compressionPolicy(that._compressionPolicy) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -127,6 +132,7 @@ HttpHandlerFactory& HttpHandlerFactory::operator= (HttpHandlerFactory const& tha
     _datas = that._datas;
     _prefixes = that._prefixes;
     _notFound = that._notFound;
+    _compressionPolicy = that._compressionPolicy;
   }
 
   return *this;
@@ -169,6 +175,14 @@ HttpHandlerFactory::size_restriction_t HttpHandlerFactory::sizeRestrictions () c
   return restrictions;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sets the response compression policy
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpHandlerFactory::setCompressionPolicy (compression_policy_t const& policy) {
+  _compressionPolicy = policy;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief authenticates a new request
 ///
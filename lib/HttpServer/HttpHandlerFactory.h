@@ -102,6 +102,20 @@ namespace triagens {
           size_t maximalBodySize;
           size_t maximalPipelineSize;
         } size_restriction_t;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief response compression policy
+///
+/// responses are compressed if their body has at least minimalSize bytes and
+/// their content type starts with one of the given prefixes. A minimalSize of
+/// 0 disables response compression
+////////////////////////////////////////////////////////////////////////////////
+
+        typedef struct {
+          size_t minimalSize;
+          int level;
+          std::vector<std::string> contentTypes;
+        } compression_policy_t;
         
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
@@ -161,6 +175,20 @@ namespace triagens {
 
         size_restriction_t sizeRestrictions () const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the response compression policy
+////////////////////////////////////////////////////////////////////////////////
+
+        compression_policy_t const& compressionPolicy () const {
+          return _compressionPolicy;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sets the response compression policy
+////////////////////////////////////////////////////////////////////////////////
+
+        void setCompressionPolicy (compression_policy_t const&);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief authenticates a new request, wrapper method
 ////////////////////////////////////////////////////////////////////////////////
@@ -272,6 +300,12 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         create_fptr _notFound;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief response compression policy
+////////////////////////////////////////////////////////////////////////////////
+
+        compression_policy_t _compressionPolicy;
     };
   }
 }
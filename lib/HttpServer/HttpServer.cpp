@@ -86,6 +86,26 @@ int HttpServer::sendChunk (uint64_t taskId, const string& data) {
 
   return it->second->signalChunk(data);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hands the next part of a streamed response to a task
+////////////////////////////////////////////////////////////////////////////////
+
+int HttpServer::sendStreamChunk (uint64_t taskId,
+                                 HttpResponseStream* stream,
+                                 StringBuffer* body) {
+  MUTEX_LOCKER(HttpCommTaskMapLock);
+
+  auto&& it = HttpCommTaskMap.find(taskId);
+
+  if (it == HttpCommTaskMap.end()) {
+    return TRI_ERROR_TASK_NOT_FOUND;
+  }
+
+  it->second->signalStreamChunk(stream, body);
+
+  return TRI_ERROR_NO_ERROR;
+}
         
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
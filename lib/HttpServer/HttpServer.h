@@ -59,6 +59,10 @@
 // -----------------------------------------------------------------------------
 
 namespace triagens {
+  namespace basics {
+    class StringBuffer;
+  }
+
   namespace rest {
     class AsyncJobManager;
     class Dispatcher;
@@ -67,6 +71,7 @@ namespace triagens {
     class HttpCommTask;
     class HttpHandler;
     class HttpHandlerFactory;
+    class HttpResponseStream;
     class Job;
     class ListenTask;
 
@@ -89,6 +94,18 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         static int sendChunk (uint64_t, const std::string&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hands the next part of a streamed response to a task
+///
+/// the stream is nullptr once it is exhausted, the part is nullptr if it
+/// could not be produced. Returns TRI_ERROR_TASK_NOT_FOUND if the task is
+/// gone, the caller keeps ownership of both in this case.
+////////////////////////////////////////////////////////////////////////////////
+
+        static int sendStreamChunk (uint64_t,
+                                    HttpResponseStream*,
+                                    basics::StringBuffer*);
         
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
@@ -119,6 +119,14 @@ const string& HttpServerJob::queue () const {
 /// {@inheritDoc}
 ////////////////////////////////////////////////////////////////////////////////
 
+Job::JobPriority HttpServerJob::priority () const {
+  return _handler->priority();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
 void HttpServerJob::setDispatcherThread (DispatcherThread* thread) {
   _handler->setDispatcherThread(thread);
 }
@@ -141,6 +149,7 @@ Job::status_t HttpServerJob::work () {
   Handler::status_t status;
 
   try {
+    _handler->decodeRequest();
     status = _handler->execute();
   }
   catch (...) {
@@ -149,6 +158,7 @@ Job::status_t HttpServerJob::work () {
   }
 
   _handler->finalizeExecute();
+  _handler->compressResponse();
   RequestStatisticsAgentSetRequestEnd(_handler);
 
   LOG_TRACE("finished job %p with status %d", (void*) this, (int) status.status);
@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief job producing the next part of a streamed response
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2015 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014-2015, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HttpStreamJob.h"
+
+#include "Basics/StringBuffer.h"
+#include "Basics/logging.h"
+#include "HttpServer/HttpServer.h"
+#include "Rest/HttpResponse.h"
+
+using namespace triagens::basics;
+using namespace triagens::rest;
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                               class HttpStreamJob
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                      constructors and destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief constructs a new stream job
+////////////////////////////////////////////////////////////////////////////////
+
+HttpStreamJob::HttpStreamJob (uint64_t taskId,
+                              HttpResponseStream* stream)
+  : Job("HttpStreamJob"),
+    _taskId(taskId),
+    _stream(stream),
+    _body(nullptr) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destructs a stream job
+////////////////////////////////////////////////////////////////////////////////
+
+HttpStreamJob::~HttpStreamJob () {
+  delete _body;
+  delete _stream;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       Job methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+Job::JobType HttpStreamJob::type () const {
+  return READ_JOB;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+Job::status_t HttpStreamJob::work () {
+  TRI_ASSERT(_stream != nullptr);
+  TRI_ASSERT(_body == nullptr);
+
+  StringBuffer* body = new StringBuffer(TRI_UNKNOWN_MEM_ZONE, HttpResponse::StreamChunkSize);
+  bool more;
+
+  try {
+    more = _stream->next(*body, HttpResponse::StreamChunkSize);
+  }
+  catch (...) {
+    LOG_WARNING("could not produce streamed response");
+
+    delete body;
+    return status_t(JOB_FAILED);
+  }
+
+  _body = body;
+
+  if (! more) {
+    // release the stream here instead of in the communication task
+    delete _stream;
+    _stream = nullptr;
+  }
+
+  return status_t(JOB_DONE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+bool HttpStreamJob::cancel (bool running) {
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpStreamJob::cleanup () {
+  if (_body == nullptr) {
+    // the part could not be produced, the rest of the stream is useless
+    delete _stream;
+    _stream = nullptr;
+  }
+
+  if (HttpServer::sendStreamChunk(_taskId, _stream, _body) == TRI_ERROR_NO_ERROR) {
+    // ownership has been handed over to the communication task
+    _stream = nullptr;
+    _body = nullptr;
+  }
+
+  delete this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+bool HttpStreamJob::beginShutdown () {
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpStreamJob::handleError (triagens::basics::Exception const& ex) {
+  LOG_WARNING("could not produce streamed response: %s", ex.what());
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
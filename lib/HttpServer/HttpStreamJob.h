@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief job producing the next part of a streamed response
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2015 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014-2015, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_HTTP_SERVER_HTTP_STREAM_JOB_H
+#define ARANGODB_HTTP_SERVER_HTTP_STREAM_JOB_H 1
+
+#include "Dispatcher/Job.h"
+
+#include "Basics/Exceptions.h"
+
+namespace triagens {
+  namespace basics {
+    class StringBuffer;
+  }
+
+  namespace rest {
+    class HttpResponseStream;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                               class HttpStreamJob
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief job producing the next part of a streamed response
+///
+/// The job owns the stream while it runs. Once done, it hands the produced
+/// part and the stream back to the communication task, which only writes
+/// ready buffers. If the task has gone away in the meantime, the job frees
+/// both itself.
+////////////////////////////////////////////////////////////////////////////////
+
+    class HttpStreamJob : public Job {
+      HttpStreamJob (HttpStreamJob const&) = delete;
+      HttpStreamJob& operator= (HttpStreamJob const&) = delete;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                      constructors and destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief constructs a new stream job
+////////////////////////////////////////////////////////////////////////////////
+
+        HttpStreamJob (uint64_t taskId,
+                       HttpResponseStream* stream);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destructs a stream job
+////////////////////////////////////////////////////////////////////////////////
+
+        ~HttpStreamJob ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       Job methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+        JobType type () const override;
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+        status_t work () override;
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+        bool cancel (bool running) override;
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+        void cleanup () override;
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+        bool beginShutdown () override;
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+        void handleError (basics::Exception const&) override;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief id of the communication task the response belongs to
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t const _taskId;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the stream, nullptr once it is exhausted or has failed
+////////////////////////////////////////////////////////////////////////////////
+
+        HttpResponseStream* _stream;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the part produced, nullptr if producing it failed
+////////////////////////////////////////////////////////////////////////////////
+
+        basics::StringBuffer* _body;
+    };
+  }
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
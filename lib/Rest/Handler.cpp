@@ -77,6 +77,14 @@ string const& Handler::queue () const {
   return STANDARD_QUEUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the priority of the job created for the handler
+////////////////////////////////////////////////////////////////////////////////
+
+Job::JobPriority Handler::priority () const {
+  return Job::MEDIUM_PRIORITY;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief sets the thread which currently dealing with the job
 ////////////////////////////////////////////////////////////////////////////////
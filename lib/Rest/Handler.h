@@ -153,6 +153,12 @@ namespace triagens {
 
         virtual std::string const& queue () const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the priority of the job created for the handler
+////////////////////////////////////////////////////////////////////////////////
+
+        virtual Job::JobPriority priority () const;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief sets the thread which currently dealing with the job
 ////////////////////////////////////////////////////////////////////////////////
@@ -37,6 +37,8 @@
 #include "Basics/tri-strings.h"
 #include "Basics/Utf8Helper.h"
 
+#include <zlib.h>
+
 using namespace std;
 using namespace triagens::basics;
 using namespace triagens::rest;
@@ -47,6 +49,63 @@ using namespace triagens::rest;
 
 static char const* EMPTY_STR = "";
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inflates compressed data into a string buffer
+////////////////////////////////////////////////////////////////////////////////
+
+static int InflateData (char const* data,
+                        size_t length,
+                        int windowBits,
+                        size_t maximalSize,
+                        StringBuffer& out) {
+  z_stream strm;
+  strm.zalloc = Z_NULL;
+  strm.zfree = Z_NULL;
+  strm.opaque = Z_NULL;
+  strm.next_in = (unsigned char*) data;
+  strm.avail_in = (uInt) length;
+
+  if (inflateInit2(&strm, windowBits) != Z_OK) {
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  char buffer[16384];
+  int res;
+
+  do {
+    strm.next_out = (unsigned char*) buffer;
+    strm.avail_out = (uInt) sizeof(buffer);
+
+    res = inflate(&strm, Z_NO_FLUSH);
+
+    if (res != Z_OK && res != Z_STREAM_END) {
+      break;
+    }
+
+    size_t produced = sizeof(buffer) - strm.avail_out;
+
+    if (out.length() + produced > maximalSize) {
+      (void) inflateEnd(&strm);
+      return TRI_ERROR_OUT_OF_MEMORY;
+    }
+
+    out.appendText(buffer, produced);
+  }
+  while (res != Z_STREAM_END);
+
+  (void) inflateEnd(&strm);
+
+  if (res != Z_STREAM_END) {
+    return TRI_ERROR_HTTP_BAD_PARAMETER;
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 class HttpRequest
 // -----------------------------------------------------------------------------
@@ -478,6 +537,75 @@ int HttpRequest::setBody (char const* newBody,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpRequest::adoptBody (char* buffer,
+                             size_t offset,
+                             size_t length) {
+  TRI_ASSERT(buffer != nullptr);
+  TRI_ASSERT(buffer[offset + length] == '\0');
+
+  _freeables.push_back(buffer);
+
+  _body = buffer + offset;
+  _contentLength = (int64_t) length;
+  _bodySize = length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// {@inheritDoc}
+////////////////////////////////////////////////////////////////////////////////
+
+int HttpRequest::inflateBody (size_t maximalSize) {
+  bool found;
+  char const* encoding = header("content-encoding", found);
+
+  if (! found || _bodySize == 0) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  bool const isDeflate = TRI_CaseEqualString(encoding, "deflate");
+
+  if (! isDeflate &&
+      ! TRI_CaseEqualString(encoding, "gzip") &&
+      ! TRI_CaseEqualString(encoding, "x-gzip")) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  StringBuffer inflated(TRI_UNKNOWN_MEM_ZONE);
+
+  // 15 + 32 detects zlib and gzip headers automatically
+  int res = InflateData(_body, _bodySize, 15 + 32, maximalSize, inflated);
+
+  if (res == TRI_ERROR_HTTP_BAD_PARAMETER && isDeflate) {
+    // some clients send raw deflate data without the zlib header
+    inflated.clear();
+    res = InflateData(_body, _bodySize, -15, maximalSize, inflated);
+  }
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  _headers.erase("content-encoding");
+
+  size_t const length = inflated.length();
+
+  if (length == 0) {
+    _body = nullptr;
+    _contentLength = 0;
+    _bodySize = 0;
+
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  adoptBody(inflated.steal(), 0, length);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief sets a header field
 ////////////////////////////////////////////////////////////////////////////////
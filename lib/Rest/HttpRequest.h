@@ -503,6 +503,25 @@ namespace triagens {
 
         int setBody (char const* newBody, size_t length);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sets the body to a range of a buffer, without copying it
+///
+/// the request takes over the buffer, which must have been allocated in
+/// TRI_UNKNOWN_MEM_ZONE. the body must be followed by a NUL byte
+////////////////////////////////////////////////////////////////////////////////
+
+        void adoptBody (char* buffer, size_t offset, size_t length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inflates a body sent with content encoding deflate or gzip
+///
+/// the content-encoding header is removed once the body has been inflated.
+/// bodies without or with other content encodings are left untouched. The
+/// inflated body must not be larger than the given number of bytes
+////////////////////////////////////////////////////////////////////////////////
+
+        int inflateBody (size_t maximalSize);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief set a header field
 ////////////////////////////////////////////////////////////////////////////////
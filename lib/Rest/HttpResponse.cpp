@@ -30,14 +30,139 @@
 
 #include "HttpResponse.h"
 
+#include "Basics/Exceptions.h"
 #include "Basics/logging.h"
 #include "Basics/tri-strings.h"
 #include "Basics/StringUtils.h"
 
+#include <zlib.h>
+
 using namespace triagens::basics;
 using namespace triagens::rest;
 using namespace std;
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief incremental zlib compressor for response bodies
+////////////////////////////////////////////////////////////////////////////////
+
+  class Deflater {
+    Deflater (Deflater const&) = delete;
+    Deflater& operator= (Deflater const&) = delete;
+
+    public:
+
+      Deflater ()
+        : _initialized(false) {
+        _strm.zalloc = Z_NULL;
+        _strm.zfree  = Z_NULL;
+        _strm.opaque = Z_NULL;
+      }
+
+      ~Deflater () {
+        if (_initialized) {
+          (void) deflateEnd(&_strm);
+        }
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initializes the compressor, windowBits 15 + 16 produces gzip
+////////////////////////////////////////////////////////////////////////////////
+
+      int init (int level, bool gzip) {
+        if (deflateInit2(&_strm, level, Z_DEFLATED, gzip ? 15 + 16 : 15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+          return TRI_ERROR_OUT_OF_MEMORY;
+        }
+
+        _initialized = true;
+        return TRI_ERROR_NO_ERROR;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compresses the data and appends the output to the buffer
+///
+/// flush must be Z_SYNC_FLUSH for all but the last part and Z_FINISH for the
+/// last part, so that each part can be sent on its own
+////////////////////////////////////////////////////////////////////////////////
+
+      int compress (char const* data,
+                    size_t length,
+                    StringBuffer& out,
+                    int flush) {
+        char buffer[16384];
+
+        _strm.next_in = (unsigned char*) data;
+        _strm.avail_in = (uInt) length;
+
+        do {
+          _strm.next_out = (unsigned char*) buffer;
+          _strm.avail_out = (uInt) sizeof(buffer);
+
+          int res = ::deflate(&_strm, flush);
+
+          if (res == Z_STREAM_ERROR) {
+            return TRI_ERROR_INTERNAL;
+          }
+
+          out.appendText(buffer, sizeof(buffer) - _strm.avail_out);
+        }
+        while (_strm.avail_out == 0);
+
+        return TRI_ERROR_NO_ERROR;
+      }
+
+    private:
+
+      z_stream _strm;
+      bool _initialized;
+  };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stream compressing the parts produced by another stream
+////////////////////////////////////////////////////////////////////////////////
+
+  class DeflateStream : public HttpResponseStream {
+    public:
+
+      DeflateStream (HttpResponseStream* stream,
+                     Deflater* deflater)
+        : _stream(stream),
+          _deflater(deflater),
+          _raw(TRI_UNKNOWN_MEM_ZONE) {
+      }
+
+      ~DeflateStream () {
+        delete _deflater;
+        delete _stream;
+      }
+
+      bool next (StringBuffer& buffer, size_t size) override {
+        _raw.clear();
+        bool more = _stream->next(_raw, size);
+
+        int res = _deflater->compress(_raw.c_str(), _raw.length(), buffer, more ? Z_SYNC_FLUSH : Z_FINISH);
+
+        if (res != TRI_ERROR_NO_ERROR) {
+          THROW_ARANGO_EXCEPTION(res);
+        }
+
+        return more;
+      }
+
+    private:
+
+      HttpResponseStream* _stream;
+      Deflater* _deflater;
+      StringBuffer _raw;
+  };
+
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                             static public methods
 // -----------------------------------------------------------------------------
@@ -48,6 +173,12 @@ using namespace std;
 
 std::string const HttpResponse::BatchErrorHeader = "X-Arango-Errors";
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of bytes a streamed body is produced in at a time
+////////////////////////////////////////////////////////////////////////////////
+
+size_t const HttpResponse::StreamChunkSize = 256 * 1024;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief http response string
 ////////////////////////////////////////////////////////////////////////////////
@@ -205,6 +336,7 @@ HttpResponse::HttpResponseCode HttpResponse::responseCode (int code) {
 
   switch (code) {
     case TRI_ERROR_BAD_PARAMETER:
+    case TRI_ERROR_HTTP_BAD_PARAMETER:
     case TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD:
     case TRI_ERROR_ARANGO_DOCUMENT_KEY_UNEXPECTED:
     case TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID:
@@ -263,7 +395,8 @@ HttpResponse::HttpResponse (HttpResponseCode code,
     _headers(6),
     _body(TRI_UNKNOWN_MEM_ZONE),
     _bodySize(0),
-    _freeables() {
+    _freeables(),
+    _stream(nullptr) {
 
   _headers.insert("server", 6, "ArangoDB");
   _headers.insert("connection", 10, "Keep-Alive");
@@ -278,6 +411,8 @@ HttpResponse::~HttpResponse () {
   for (auto& it : _freeables) {
     delete[] it;
   }
+
+  delete _stream;
 }
 
 // -----------------------------------------------------------------------------
@@ -650,6 +785,7 @@ HttpResponse* HttpResponse::swap () {
   response->_headers.swap(&_headers);
   response->_body.swap(&_body);
   response->_freeables.swap(_freeables);
+  std::swap(response->_stream, _stream);
 
   bool isHeadResponse = response->_isHeadResponse;
   response->_isHeadResponse = _isHeadResponse;
@@ -821,6 +957,25 @@ void HttpResponse::headResponse (size_t size) {
   _bodySize = size;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief attaches a stream producing the remainder of the body
+////////////////////////////////////////////////////////////////////////////////
+
+void HttpResponse::setStream (HttpResponseStream* stream) {
+  delete _stream;
+  _stream = stream;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief steals the attached stream
+////////////////////////////////////////////////////////////////////////////////
+
+HttpResponseStream* HttpResponse::stealStream () {
+  HttpResponseStream* stream = _stream;
+  _stream = nullptr;
+  return stream;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief deflates the response body
 ///
@@ -838,6 +993,43 @@ int HttpResponse::deflate (size_t bufferSize) {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compresses the response body using the given zlib level
+////////////////////////////////////////////////////////////////////////////////
+
+int HttpResponse::compress (int level, bool gzip) {
+  std::unique_ptr<Deflater> deflater(new Deflater());
+
+  int res = deflater->init(level, gzip);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  StringBuffer compressed(TRI_UNKNOWN_MEM_ZONE);
+  res = deflater->compress(_body.c_str(), _body.length(), compressed, _stream == nullptr ? Z_FINISH : Z_SYNC_FLUSH);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  if (_stream == nullptr) {
+    if (compressed.length() >= _body.length()) {
+      return TRI_ERROR_NO_ERROR;
+    }
+  }
+  else {
+    _stream = new DeflateStream(_stream, deflater.release());
+  }
+
+  _body.swap(&compressed);
+
+  setHeader("content-encoding", strlen("content-encoding"), gzip ? "gzip" : "deflate");
+  setHeader("vary", strlen("vary"), "Accept-Encoding");
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
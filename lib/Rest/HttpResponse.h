@@ -36,12 +36,43 @@
 #include "Basics/Dictionary.h"
 #include "Basics/StringBuffer.h"
 
+namespace triagens {
+  namespace rest {
+
 // -----------------------------------------------------------------------------
-// --SECTION--                                                class HttpResponse
+// --SECTION--                                          class HttpResponseStream
 // -----------------------------------------------------------------------------
 
-namespace triagens {
-  namespace rest {
+////////////////////////////////////////////////////////////////////////////////
+/// @brief producer for the remainder of a streamed response body
+///
+/// The stream is attached to a response after the handler has produced the
+/// first part of the body. The communication task pulls the next part only
+/// when everything produced before has been written to the client, so a slow
+/// client will not make the server buffer the complete result. next() is
+/// called from the scheduler thread owning the connection.
+////////////////////////////////////////////////////////////////////////////////
+
+    class HttpResponseStream {
+      public:
+
+        virtual ~HttpResponseStream () {
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief appends the next part of the body to the buffer
+///
+/// The stream should stop producing once roughly the given number of bytes
+/// has been appended. Returns false once the body is complete. Throwing an
+/// exception aborts the response.
+////////////////////////////////////////////////////////////////////////////////
+
+        virtual bool next (basics::StringBuffer&, size_t) = 0;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                class HttpResponse
+// -----------------------------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief http response
@@ -354,6 +385,28 @@ namespace triagens {
 
         void headResponse (size_t);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief attaches a stream producing the remainder of the body
+///
+/// The response takes ownership of the stream.
+////////////////////////////////////////////////////////////////////////////////
+
+        void setStream (HttpResponseStream*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a stream is attached
+////////////////////////////////////////////////////////////////////////////////
+
+        bool hasStream () const {
+          return _stream != nullptr;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief steals the attached stream
+////////////////////////////////////////////////////////////////////////////////
+
+        HttpResponseStream* stealStream ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief deflates the response body
 ///
@@ -362,6 +415,17 @@ namespace triagens {
 
         int deflate (size_t = 16384);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compresses the response body using the given zlib level
+///
+/// the body is encoded using gzip if the flag is set, and deflate otherwise.
+/// An attached stream is wrapped so that the remainder of the body is
+/// compressed as it is produced. A complete body is left untouched if
+/// compressing would not make it smaller
+////////////////////////////////////////////////////////////////////////////////
+
+        int compress (int, bool);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
@@ -432,6 +496,12 @@ namespace triagens {
 
         std::vector<char const*> _freeables;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stream producing the remainder of the body
+////////////////////////////////////////////////////////////////////////////////
+
+        HttpResponseStream* _stream;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                             public static members
 // -----------------------------------------------------------------------------
@@ -443,6 +513,12 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         static std::string const BatchErrorHeader;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of bytes a streamed body is produced in at a time
+////////////////////////////////////////////////////////////////////////////////
+
+        static size_t const StreamChunkSize;
     };
   }
 }
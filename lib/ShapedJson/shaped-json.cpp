@@ -455,14 +455,30 @@ static bool FillShapeValueString (TRI_shaper_t* shaper, TRI_shape_value_t* dst,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief converts a json list into TRI_shape_value_t
+/// @brief frees the data of a list of TRI_shape_value_t, but not the list
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool FillShapeValueList (TRI_shaper_t* shaper,
-                                TRI_shape_value_t* dst,
-                                TRI_json_t const* json,
-                                size_t level,
-                                bool create) {
+static void FreeShapeValues (TRI_memory_zone_t* zone,
+                             TRI_shape_value_t* values,
+                             TRI_shape_value_t* end) {
+  for (TRI_shape_value_t* p = values;  p < end;  ++p) {
+    if (p->_value != nullptr) {
+      TRI_Free(zone, p->_value);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief combines list members into a TRI_shape_value_t
+///
+/// the member values are left untouched and must be freed by the caller
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ComposeShapeValueList (TRI_shaper_t* shaper,
+                                   TRI_shape_value_t* dst,
+                                   TRI_shape_value_t* values,
+                                   size_t n,
+                                   bool create) {
   TRI_shape_sid_t s;
   TRI_shape_sid_t l;
 
@@ -471,12 +487,7 @@ static bool FillShapeValueList (TRI_shaper_t* shaper,
 
   char* ptr;
 
-  // sanity checks
-  TRI_ASSERT(json->_type == TRI_JSON_ARRAY);
-
   // check for special case "empty list"
-  size_t const n = TRI_LengthArrayJson(json);
-
   if (n == 0) {
     dst->_type = TRI_SHAPE_LIST;
     dst->_sid = BasicShapes::TRI_SHAPE_SID_LIST;
@@ -492,42 +503,13 @@ static bool FillShapeValueList (TRI_shaper_t* shaper,
 
     return true;
   }
-  
-  // helper function to free shape values
-  auto freeShapeValues = [] (TRI_memory_zone_t* zone, TRI_shape_value_t* values, TRI_shape_value_t* end) {
-    TRI_shape_value_t* p = values;
-    TRI_shape_value_t* e = end;
-
-    for (;  p < e;  ++p) {
-      if (p->_value != nullptr) {
-        TRI_Free(zone, p->_value);
-      }
-    }
-
-    TRI_Free(zone, values);
-  };
-  
-
-  // convert into TRI_shape_value_t array
-  TRI_shape_value_t* values = static_cast<TRI_shape_value_t*>(TRI_Allocate(shaper->_memoryZone, sizeof(TRI_shape_value_t) * n, true));
-
-  if (values == nullptr) {
-    return false;
-  }
 
   uint64_t total = 0;
 
-  TRI_shape_value_t* p = values;
-
-  for (size_t i = 0;  i < n;  ++i, ++p) {
-    TRI_json_t const* el = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
-    bool ok = FillShapeValueJson(shaper, p, el, level + 1, create);
-
-    if (! ok) {
-      freeShapeValues(shaper->_memoryZone, values, p);
-      return false;
-    }
+  TRI_shape_value_t* p;
+  TRI_shape_value_t* const e = values + n; // end does not change
 
+  for (p = values;  p < e;  ++p) {
     total += p->_size;
   }
 
@@ -537,11 +519,8 @@ static bool FillShapeValueList (TRI_shaper_t* shaper,
 
   s = values[0]._sid;
   l = values[0]._size;
-  
-  p = values;
-  TRI_shape_value_t* const e = values + n; // end does not change
 
-  for (;  p < e;  ++p) {
+  for (p = values;  p < e;  ++p) {
     if (p->_sid != s) {
       hs = false;
       break;
@@ -557,7 +536,6 @@ static bool FillShapeValueList (TRI_shaper_t* shaper,
     TRI_homogeneous_sized_list_shape_t* shape = static_cast<TRI_homogeneous_sized_list_shape_t*>(TRI_Allocate(shaper->_memoryZone, sizeof(TRI_homogeneous_sized_list_shape_t), true));
 
     if (shape == nullptr) {
-      freeShapeValues(shaper->_memoryZone, values, e);
       return false;
     }
 
@@ -571,7 +549,6 @@ static bool FillShapeValueList (TRI_shaper_t* shaper,
     TRI_shape_t const* found = shaper->findShape(shaper, &shape->base, create);
 
     if (found == nullptr) {
-      freeShapeValues(shaper->_memoryZone, values, e);
       TRI_Free(shaper->_memoryZone, shape);
       return false;
     }
@@ -586,7 +563,6 @@ static bool FillShapeValueList (TRI_shaper_t* shaper,
     dst->_value = (ptr = static_cast<char*>(TRI_Allocate(shaper->_memoryZone, dst->_size, true)));
 
     if (dst->_value == nullptr) {
-      freeShapeValues(shaper->_memoryZone, values, e);
       return false;
     }
 
@@ -605,7 +581,6 @@ static bool FillShapeValueList (TRI_shaper_t* shaper,
     TRI_homogeneous_list_shape_t* shape = static_cast<TRI_homogeneous_list_shape_t*>(TRI_Allocate(shaper->_memoryZone, sizeof(TRI_homogeneous_list_shape_t), true));
 
     if (shape == nullptr) {
-      freeShapeValues(shaper->_memoryZone, values, e);
       return false;
     }
 
@@ -618,7 +593,6 @@ static bool FillShapeValueList (TRI_shaper_t* shaper,
     TRI_shape_t const* found = shaper->findShape(shaper, &shape->base, create);
 
     if (found == nullptr) {
-      freeShapeValues(shaper->_memoryZone, values, e);
       TRI_Free(shaper->_memoryZone, shape);
       return false;
     }
@@ -635,7 +609,6 @@ static bool FillShapeValueList (TRI_shaper_t* shaper,
     dst->_value = (ptr = static_cast<char*>(TRI_Allocate(shaper->_memoryZone, dst->_size, true)));
 
     if (dst->_value == nullptr) {
-      freeShapeValues(shaper->_memoryZone, values, e);
       return false;
     }
 
@@ -667,301 +640,1349 @@ static bool FillShapeValueList (TRI_shaper_t* shaper,
       + n * sizeof(TRI_shape_sid_t)
       + (n + 1) * sizeof(TRI_shape_size_t);
 
-    dst->_fixedSized = false;
-    dst->_size = offset + total;
-    dst->_value = (ptr = static_cast<char*>(TRI_Allocate(shaper->_memoryZone, dst->_size, true)));
+    dst->_fixedSized = false;
+    dst->_size = offset + total;
+    dst->_value = (ptr = static_cast<char*>(TRI_Allocate(shaper->_memoryZone, dst->_size, true)));
+
+    if (dst->_value == nullptr) {
+      return false;
+    }
+
+    // copy sub-objects into data space
+    * (TRI_shape_length_list_t*) ptr = (TRI_shape_length_list_t) n;
+    ptr += sizeof(TRI_shape_length_list_t);
+
+    TRI_shape_sid_t* sids = (TRI_shape_sid_t*) ptr;
+    ptr += n * sizeof(TRI_shape_sid_t);
+
+    offsets = (TRI_shape_size_t*) ptr;
+    ptr += (n + 1) * sizeof(TRI_shape_size_t);
+
+    for (p = values;  p < e;  ++p) {
+      *sids++ = p->_sid;
+
+      *offsets++ = offset;
+      offset += p->_size;
+
+      memcpy(ptr, p->_value, (size_t) p->_size);
+      ptr += p->_size;
+    }
+
+    *offsets = offset;
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a json list into TRI_shape_value_t
+////////////////////////////////////////////////////////////////////////////////
+
+static bool FillShapeValueList (TRI_shaper_t* shaper,
+                                TRI_shape_value_t* dst,
+                                TRI_json_t const* json,
+                                size_t level,
+                                bool create) {
+  // sanity checks
+  TRI_ASSERT(json->_type == TRI_JSON_ARRAY);
+
+  size_t const n = TRI_LengthArrayJson(json);
+
+  if (n == 0) {
+    return ComposeShapeValueList(shaper, dst, nullptr, 0, create);
+  }
+
+  // convert into TRI_shape_value_t array
+  TRI_shape_value_t* values = static_cast<TRI_shape_value_t*>(TRI_Allocate(shaper->_memoryZone, sizeof(TRI_shape_value_t) * n, true));
+
+  if (values == nullptr) {
+    return false;
+  }
+
+  TRI_shape_value_t* p = values;
+
+  for (size_t i = 0;  i < n;  ++i, ++p) {
+    TRI_json_t const* el = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+    bool ok = FillShapeValueJson(shaper, p, el, level + 1, create);
+
+    if (! ok) {
+      FreeShapeValues(shaper->_memoryZone, values, p);
+      TRI_Free(shaper->_memoryZone, values);
+      return false;
+    }
+  }
+
+  bool ok = ComposeShapeValueList(shaper, dst, values, n, create);
+
+  // free TRI_shape_value_t array
+  FreeShapeValues(shaper->_memoryZone, values, values + n);
+  TRI_Free(shaper->_memoryZone, values);
+
+  return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief combines the attribute values of an object into a TRI_shape_value_t
+///
+/// the attribute values must have their attribute identifiers set. they are
+/// sorted in place, but otherwise left untouched and must be freed by the
+/// caller
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ComposeShapeValueArray (TRI_shaper_t* shaper,
+                                    TRI_shape_value_t* dst,
+                                    TRI_shape_value_t* values,
+                                    size_t n,
+                                    bool create) {
+  TRI_shape_sid_t* sids;
+  TRI_shape_aid_t* aids;
+  TRI_shape_size_t* offsetsF;
+  TRI_shape_size_t* offsetsV;
+  TRI_shape_size_t offset;
+
+  char* ptr;
+
+  uint64_t total = 0;
+  size_t f = 0;
+  size_t v = 0;
+
+  TRI_shape_value_t* p;
+  TRI_shape_value_t* const e = values + n;
+
+  for (p = values;  p < e;  ++p) {
+    total += p->_size;
+
+    // count fixed and variable sized values
+    if (p->_fixedSized) {
+      ++f;
+    }
+    else {
+      ++v;
+    }
+  }
+
+  // add variable offset table size
+  total += (v + 1) * sizeof(TRI_shape_size_t);
+
+  // now sort the shape entries
+  if (n > 1) {
+    TRI_SortShapeValues(values, n);
+  }
+
+#ifdef DEBUG_JSON_SHAPER
+  printf("shape values\n------------\ntotal: %u, fixed: %u, variable: %u\n",
+         (unsigned int) n,
+         (unsigned int) f,
+         (unsigned int) v);
+  PrintShapeValues(values, n);
+  printf("\n");
+#endif
+
+  // generate shape structure
+  size_t byteSize =
+    sizeof(TRI_array_shape_t)
+    + n * sizeof(TRI_shape_sid_t)
+    + n * sizeof(TRI_shape_aid_t)
+    + (f + 1) * sizeof(TRI_shape_size_t);
+
+  TRI_array_shape_t* a = reinterpret_cast<TRI_array_shape_t*>(ptr = static_cast<char*>(TRI_Allocate(shaper->_memoryZone, byteSize, true)));
+
+  if (ptr == nullptr) {
+    return false;
+  }
+
+  a->base._type = TRI_SHAPE_ARRAY;
+  a->base._size = byteSize;
+  a->base._dataSize = (v == 0) ? total : TRI_SHAPE_SIZE_VARIABLE;
+
+  a->_fixedEntries = f;
+  a->_variableEntries = v;
+
+  ptr += sizeof(TRI_array_shape_t);
+
+  // array of shape identifiers
+  sids = (TRI_shape_sid_t*) ptr;
+  ptr += n * sizeof(TRI_shape_sid_t);
+
+  // array of attribute identifiers
+  aids = (TRI_shape_aid_t*) ptr;
+  ptr += n * sizeof(TRI_shape_aid_t);
+
+  // array of offsets for fixed part (within the shape)
+  offset = (v + 1) * sizeof(TRI_shape_size_t);
+  offsetsF = (TRI_shape_size_t*) ptr;
+
+  // fill destination (except sid)
+  dst->_type = TRI_SHAPE_ARRAY;
+
+  dst->_fixedSized = true;
+  dst->_size = total;
+  dst->_value = (ptr = static_cast<char*>(TRI_Allocate(shaper->_memoryZone, dst->_size, true)));
+
+  if (ptr == nullptr) {
+    TRI_Free(shaper->_memoryZone, a);
+    return false;
+  }
+
+  // array of offsets for variable part (within the value)
+  offsetsV = (TRI_shape_size_t*) ptr;
+  ptr += (v + 1) * sizeof(TRI_shape_size_t);
+
+  // and fill in attributes
+  for (p = values;  p < e;  ++p) {
+    *aids++ = p->_aid;
+    *sids++ = p->_sid;
+
+    memcpy(ptr, p->_value, (size_t) p->_size);
+    ptr += p->_size;
+
+    dst->_fixedSized &= p->_fixedSized;
+
+    if (p->_fixedSized) {
+      *offsetsF++ = offset;
+      offset += p->_size;
+      *offsetsF = offset;
+    }
+    else {
+      *offsetsV++ = offset;
+      offset += p->_size;
+      *offsetsV = offset;
+    }
+  }
+
+  // lookup this shape
+  TRI_shape_t const* found = shaper->findShape(shaper, &a->base, create);
+
+  if (found == nullptr) {
+    TRI_Free(shaper->_memoryZone, dst->_value);
+    dst->_value = nullptr;
+    TRI_Free(shaper->_memoryZone, a);
+    return false;
+  }
+
+  // and finally add the sid
+  dst->_sid = found->_sid;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a json array into TRI_shape_value_t
+////////////////////////////////////////////////////////////////////////////////
+
+static bool FillShapeValueArray (TRI_shaper_t* shaper,
+                                 TRI_shape_value_t* dst,
+                                 TRI_json_t const* json,
+                                 size_t level,
+                                 bool create) {
+  // sanity checks
+  TRI_ASSERT(json->_type == TRI_JSON_OBJECT);
+  TRI_ASSERT(TRI_LengthVector(&json->_value._objects) % 2 == 0);
+
+  // number of attributes
+  size_t n = TRI_LengthVector(&json->_value._objects) / 2;
+
+  // convert into TRI_shape_value_t array
+  TRI_shape_value_t* values = static_cast<TRI_shape_value_t*>(TRI_Allocate(shaper->_memoryZone, n * sizeof(TRI_shape_value_t), true));
+
+  if (values == nullptr) {
+    return false;
+  }
+
+  TRI_shape_value_t* p = values;
+
+  for (size_t i = 0;  i < n;  ++i, ++p) {
+    TRI_json_t const* key = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, 2 * i));
+    TRI_ASSERT(key != nullptr);
+    TRI_ASSERT(key->_type == TRI_JSON_STRING);
+
+    char const* k = key->_value._string.data;
+
+    if (k == nullptr ||
+        key->_value._string.length == 1) {
+      // empty attribute name
+      p--;
+      continue;
+    }
+
+    if (*k == '_' && level == 0) {
+      // on top level, strip reserved attributes before shaping
+      if (strcmp(k, "_key") == 0 ||
+          strcmp(k, "_rev") == 0 ||
+          strcmp(k, "_id") == 0 ||
+          strcmp(k, "_from") == 0 ||
+          strcmp(k, "_to") == 0) {
+        // found a reserved attribute - discard it
+        --p;
+        continue;
+      }
+    }
+
+    // first find an identifier for the name
+    p->_aid = shaper->findOrCreateAttributeByName(shaper, k);
+
+    // convert value
+    bool ok;
+    if (p->_aid == 0) {
+      ok = false;
+    }
+    else {
+      auto val = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, 2 * i + 1));
+      TRI_ASSERT(val != nullptr);
+
+      ok = FillShapeValueJson(shaper, p, val, level + 1, create);
+    }
+
+    if (! ok) {
+      FreeShapeValues(shaper->_memoryZone, values, p);
+      TRI_Free(shaper->_memoryZone, values);
+      return false;
+    }
+  }
+
+  // now adjust n because we might have excluded empty attributes
+  n = (size_t) (p - values);
+
+  bool ok = ComposeShapeValueArray(shaper, dst, values, n, create);
+
+  // free TRI_shape_value_t array
+  FreeShapeValues(shaper->_memoryZone, values, values + n);
+  TRI_Free(shaper->_memoryZone, values);
+
+  return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a json object into TRI_shape_value_t
+////////////////////////////////////////////////////////////////////////////////
+
+static bool FillShapeValueJson (TRI_shaper_t* shaper,
+                                TRI_shape_value_t* dst,
+                                TRI_json_t const* json,
+                                size_t level,
+                                bool create) {
+  switch (json->_type) {
+    case TRI_JSON_UNUSED:
+      return false;
+
+    case TRI_JSON_NULL:
+      return FillShapeValueNull(shaper, dst, json);
+
+    case TRI_JSON_BOOLEAN:
+      return FillShapeValueBoolean(shaper, dst, json);
+
+    case TRI_JSON_NUMBER:
+      return FillShapeValueNumber(shaper, dst, json);
+
+    case TRI_JSON_STRING:
+    case TRI_JSON_STRING_REFERENCE:
+      return FillShapeValueString(shaper, dst, json);
+
+    case TRI_JSON_OBJECT:
+      return FillShapeValueArray(shaper, dst, json, level, create);
+
+    case TRI_JSON_ARRAY:
+      return FillShapeValueList(shaper, dst, json, level, create);
+  }
+
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                            class ShapedJsonParser
+// -----------------------------------------------------------------------------
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts JSON text into TRI_shape_value_t
+///
+/// the parser accepts the same grammar, strings and numbers as the flex-based
+/// JSON parser, but does not go through a TRI_json_t tree. the text is first
+/// read into a flat list of tokens and validated completely. only then the
+/// tokens are shaped, so invalid input never registers attributes or shapes
+/// in the shaper. the values of an unfinished list or object are kept on a
+/// stack, unescaped strings and the data of the values live in a few large
+/// blocks owned by the parser
+////////////////////////////////////////////////////////////////////////////////
+
+  class ShapedJsonParser {
+
+    public:
+
+      ShapedJsonParser (TRI_shaper_t* shaper,
+                        char const* text,
+                        size_t length,
+                        bool create,
+                        bool checkDuplicates)
+        : _shaper(shaper),
+          _pos(text),
+          _end(text + length),
+          _create(create),
+          _checkDuplicates(checkDuplicates),
+          _res(TRI_ERROR_NO_ERROR),
+          _message(nullptr),
+          _blocks(),
+          _blockPos(nullptr),
+          _blockEnd(nullptr),
+          _tokens(),
+          _names(),
+          _values(),
+          _name(),
+          _key(),
+          _hasKey(false),
+          _badKey(false) {
+      }
+
+      ~ShapedJsonParser () {
+        for (auto it : _blocks) {
+          TRI_Free(TRI_UNKNOWN_MEM_ZONE, it);
+        }
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parses the text, which must contain a single JSON object. the
+/// data of the result is allocated in the shaper's memory zone
+///
+/// returns TRI_ERROR_HTTP_CORRUPTED_JSON if the text is not valid JSON or
+/// contains duplicate attribute names, TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID
+/// if it is valid JSON but not an object, TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD
+/// if the _key is not a non-empty string, and TRI_ERROR_ARANGO_SHAPER_FAILED
+/// if the object cannot be shaped
+////////////////////////////////////////////////////////////////////////////////
+
+      int parse (TRI_shape_value_t* dst) {
+        if (! parseDocument()) {
+          return _res;
+        }
+
+        // the text is valid, only now the shaper is used
+        size_t pos = 0;
+
+        if (! shapeValue(pos, 0)) {
+          return _res;
+        }
+
+        TRI_ASSERT(pos == _tokens.size());
+        TRI_ASSERT(_values.size() == 1);
+        *dst = _values.back();
+
+        return TRI_ERROR_NO_ERROR;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the value of the top-level _key attribute, empty if there is none
+////////////////////////////////////////////////////////////////////////////////
+
+      std::string const& key () const {
+        return _key;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the error message of a failed parse
+////////////////////////////////////////////////////////////////////////////////
+
+      char const* message () const {
+        return _message;
+      }
+
+    private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief token types
+////////////////////////////////////////////////////////////////////////////////
+
+      enum TokenType {
+        TOKEN_NULL,
+        TOKEN_FALSE,
+        TOKEN_TRUE,
+        TOKEN_NUMBER,
+        TOKEN_STRING,
+        TOKEN_LIST,
+        TOKEN_OBJECT
+      };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a token
+///
+/// lists and objects are followed by their members, _length is the number of
+/// members. each member of an object is a string token with its name followed
+/// by the tokens of its value. for strings, _length is the length of the
+/// string without a trailing '\0'
+////////////////////////////////////////////////////////////////////////////////
+
+      struct Token {
+        TokenType _type;
+        size_t _length;
+
+        union {
+          double _number;
+          char const* _string;
+        } _value;
+      };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief orders attribute names
+////////////////////////////////////////////////////////////////////////////////
+
+      static bool NameLess (std::pair<char const*, size_t> const& lhs,
+                            std::pair<char const*, size_t> const& rhs) {
+        int res = memcmp(lhs.first, rhs.first, (std::min)(lhs.second, rhs.second));
+
+        return res < 0 || (res == 0 && lhs.second < rhs.second);
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compares attribute names
+////////////////////////////////////////////////////////////////////////////////
+
+      static bool NameEqual (std::pair<char const*, size_t> const& lhs,
+                             std::pair<char const*, size_t> const& rhs) {
+        return lhs.second == rhs.second && memcmp(lhs.first, rhs.first, lhs.second) == 0;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief registers an error
+////////////////////////////////////////////////////////////////////////////////
+
+      bool fail (int res,
+                 char const* message) {
+        _res = res;
+        _message = message;
+        return false;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief registers a syntax error
+////////////////////////////////////////////////////////////////////////////////
+
+      bool fail (char const* message) {
+        return fail(TRI_ERROR_HTTP_CORRUPTED_JSON, message);
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief skips the whitespace accepted by the JSON parser
+////////////////////////////////////////////////////////////////////////////////
+
+      void skipWhitespace () {
+        while (_pos < _end &&
+               (*_pos == ' ' || *_pos == '\t' || *_pos == '\r' || *_pos == '\n')) {
+          ++_pos;
+        }
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief consumes a keyword, case-insensitively like the JSON parser
+////////////////////////////////////////////////////////////////////////////////
+
+      bool matchKeyword (char const* keyword,
+                         size_t length) {
+        if ((size_t) (_end - _pos) < length) {
+          return false;
+        }
+
+        for (size_t i = 0;  i < length;  ++i) {
+          if (tolower((unsigned char) _pos[i]) != keyword[i]) {
+            return false;
+          }
+        }
+
+        _pos += length;
+        return true;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief allocates memory from the current block. sizes are rounded up so
+/// that all values are suitably aligned
+////////////////////////////////////////////////////////////////////////////////
+
+      char* allocate (size_t size) {
+        size = (size + 7) & ~((size_t) 7);
+
+        if (size > (size_t) (_blockEnd - _blockPos)) {
+          // large values get a block of their own
+          size_t const blockSize = (size > BlockSize / 4) ? size : (size_t) BlockSize;
+          char* block = static_cast<char*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, blockSize, false));
+
+          if (block == nullptr) {
+            return nullptr;
+          }
+
+          _blocks.emplace_back(block);
+
+          if (blockSize == size) {
+            return block;
+          }
+
+          _blockPos = block;
+          _blockEnd = block + blockSize;
+        }
+
+        char* result = _blockPos;
+        _blockPos += size;
+
+        return result;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief appends a token
+////////////////////////////////////////////////////////////////////////////////
+
+      void addToken (TokenType type,
+                     size_t length) {
+        Token token;
+
+        token._type = type;
+        token._length = length;
+        token._value._string = nullptr;
+
+        _tokens.emplace_back(token);
+      }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                          tokenize
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads the complete text into tokens, without using the shaper
+////////////////////////////////////////////////////////////////////////////////
+
+      bool parseDocument () {
+        skipWhitespace();
+
+        if (_pos < _end && *_pos == '{') {
+          ++_pos;
+
+          if (! parseObject(0, _checkDuplicates)) {
+            return false;
+          }
+        }
+        else {
+          // tell valid JSON which is not an object apart from garbage
+          if (! parseValue(1, false)) {
+            return false;
+          }
+
+          skipWhitespace();
+
+          if (_pos < _end) {
+            return fail("expecting EOF");
+          }
+
+          return fail(TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID, "expecting object");
+        }
+
+        skipWhitespace();
+
+        if (_pos < _end) {
+          return fail("expecting EOF");
+        }
+
+        if (_badKey) {
+          return fail(TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD, "invalid document key");
+        }
+
+        return true;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parses a string. strings without escapes and non-ASCII characters
+/// are returned in place, all others are unescaped and normalized like in
+/// the JSON parser
+////////////////////////////////////////////////////////////////////////////////
+
+      bool parseString (char const*& data,
+                        size_t& length) {
+        TRI_ASSERT(*_pos == '"');
+
+        char const* start = ++_pos;
+        bool plain = true;
+
+        while (_pos < _end) {
+          unsigned char c = (unsigned char) *_pos;
+
+          if (c == '"') {
+            break;
+          }
+
+          if (c == '\\') {
+            if (_pos + 1 >= _end || _pos[1] == '\n' || _pos[1] == '\0') {
+              return fail("expected object, got unquoted string");
+            }
+
+            plain = false;
+            _pos += 2;
+            continue;
+          }
+
+          if (c == '\0') {
+            // the JSON parser stops at the first null byte
+            return fail("expected object, got unquoted string");
+          }
+
+          if (c < ' ' || c >= 0x80) {
+            plain = false;
+          }
+
+          ++_pos;
+        }
+
+        if (_pos >= _end) {
+          return fail("expected object, got unquoted string");
+        }
+
+        length = (size_t) (_pos - start);
+        ++_pos;
+
+        if (plain) {
+          data = start;
+          return true;
+        }
+
+        size_t outLength;
+        char* unescaped = TRI_UnescapeUtf8StringZ(TRI_UNKNOWN_MEM_ZONE, start, length, &outLength);
+
+        if (unescaped == nullptr) {
+          return fail(TRI_ERROR_OUT_OF_MEMORY, "out-of-memory");
+        }
+
+        char* ptr = allocate(outLength + 1);
+
+        if (ptr == nullptr) {
+          TRI_FreeString(TRI_UNKNOWN_MEM_ZONE, unescaped);
+          return fail(TRI_ERROR_OUT_OF_MEMORY, "out-of-memory");
+        }
+
+        memcpy(ptr, unescaped, outLength + 1);
+        TRI_FreeString(TRI_UNKNOWN_MEM_ZONE, unescaped);
+
+        data = ptr;
+        length = outLength;
+
+        return true;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parses a number
+////////////////////////////////////////////////////////////////////////////////
+
+      bool parseNumber () {
+        char const* start = _pos;
+
+        if (*_pos == '-' || *_pos == '+') {
+          ++_pos;
+        }
+
+        if (_pos >= _end || *_pos < '0' || *_pos > '9') {
+          return fail("expected object, got unquoted string");
+        }
+
+        if (*_pos == '0') {
+          ++_pos;
+        }
+        else {
+          while (_pos < _end && *_pos >= '0' && *_pos <= '9') {
+            ++_pos;
+          }
+        }
+
+        if (_pos + 1 < _end && *_pos == '.' && _pos[1] >= '0' && _pos[1] <= '9') {
+          _pos += 2;
+
+          while (_pos < _end && *_pos >= '0' && *_pos <= '9') {
+            ++_pos;
+          }
+        }
+
+        if (_pos < _end && (*_pos == 'e' || *_pos == 'E')) {
+          char const* p = _pos + 1;
+
+          if (p < _end && (*p == '-' || *p == '+')) {
+            ++p;
+          }
+
+          if (p < _end && *p >= '0' && *p <= '9') {
+            while (p < _end && *p >= '0' && *p <= '9') {
+              ++p;
+            }
+
+            _pos = p;
+          }
+        }
+
+        size_t const length = (size_t) (_pos - start);
+
+        if (length >= 512) {
+          return fail("number too big");
+        }
+
+        // strtod needs a null-terminated string
+        char buffer[512];
+        memcpy(buffer, start, length);
+        buffer[length] = '\0';
+
+        // need to reset errno because return value of 0 is not distinguishable from an error on Linux
+        errno = 0;
+
+        char* ep;
+        double d = strtod(buffer, &ep);
+
+        if (d == HUGE_VAL && errno == ERANGE) {
+          return fail("number too big");
+        }
+
+        if (d == 0 && errno == ERANGE) {
+          return fail("number too small");
+        }
+
+        if (ep != buffer + length) {
+          return fail("cannot parse number");
+        }
+
+        addToken(TOKEN_NUMBER, 0);
+        _tokens.back()._value._number = d;
+
+        return true;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parses a value
+////////////////////////////////////////////////////////////////////////////////
+
+      bool parseValue (size_t level,
+                       bool checkDuplicates) {
+        skipWhitespace();
+
+        if (_pos >= _end) {
+          return fail("expecting atom, got end-of-file");
+        }
+
+        switch (*_pos) {
+          case '{':
+            ++_pos;
+            return parseObject(level, checkDuplicates);
+
+          case '[':
+            ++_pos;
+            return parseList(level);
+
+          case '"': {
+            char const* data;
+            size_t length;
+
+            if (! parseString(data, length)) {
+              return false;
+            }
+
+            addToken(TOKEN_STRING, length);
+            _tokens.back()._value._string = data;
+
+            return true;
+          }
+
+          case '}':
+            return fail("expected object, got '}'");
+
+          case ']':
+            return fail("expected object, got ']'");
+
+          case ',':
+            return fail("expected object, got ','");
+
+          case ':':
+            return fail("expected object, got ':'");
+
+          case '-':
+          case '+':
+          case '0': case '1': case '2': case '3': case '4':
+          case '5': case '6': case '7': case '8': case '9':
+            return parseNumber();
+        }
+
+        if (matchKeyword("null", 4)) {
+          addToken(TOKEN_NULL, 0);
+          return true;
+        }
+
+        if (matchKeyword("true", 4)) {
+          addToken(TOKEN_TRUE, 0);
+          return true;
+        }
+
+        if (matchKeyword("false", 5)) {
+          addToken(TOKEN_FALSE, 0);
+          return true;
+        }
+
+        return fail("expected object, got unquoted string");
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parses the members of a list
+////////////////////////////////////////////////////////////////////////////////
+
+      bool parseList (size_t level) {
+        size_t const token = _tokens.size();
+        size_t n = 0;
+
+        addToken(TOKEN_LIST, 0);
+        skipWhitespace();
+
+        if (_pos < _end && *_pos == ']') {
+          ++_pos;
+        }
+        else {
+          while (true) {
+            // duplicate attribute names are not checked for inside lists
+            if (! parseValue(level + 1, false)) {
+              return false;
+            }
+
+            ++n;
+            skipWhitespace();
+
+            if (_pos >= _end) {
+              return fail("expecting a list element, got end-of-file");
+            }
+
+            if (*_pos == ']') {
+              ++_pos;
+              break;
+            }
+
+            if (*_pos != ',') {
+              return fail("expecting comma");
+            }
+
+            ++_pos;
+          }
+        }
+
+        _tokens[token]._length = n;
+        return true;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parses the attributes of an object
+///
+/// attributes with an empty name and, on the top level, the reserved
+/// attributes are not shaped and do not produce tokens. the value of the
+/// first top-level _key is remembered. as in the JSON code path, a _key value
+/// which is not a non-empty string is an error
+////////////////////////////////////////////////////////////////////////////////
+
+      bool parseObject (size_t level,
+                        bool checkDuplicates) {
+        size_t const token = _tokens.size();
+        size_t const names = _names.size();
+        size_t n = 0;
+        bool first = true;
+
+        addToken(TOKEN_OBJECT, 0);
+
+        while (true) {
+          skipWhitespace();
+
+          if (_pos >= _end) {
+            return fail("expecting a object attribute name or element, got end-of-file");
+          }
+
+          if (*_pos == '}') {
+            ++_pos;
+            break;
+          }
+
+          if (! first) {
+            if (*_pos != ',') {
+              return fail("expecting comma");
+            }
+
+            ++_pos;
+            skipWhitespace();
+          }
+
+          first = false;
+
+          if (_pos >= _end || *_pos != '"') {
+            return fail("expecting attribute name");
+          }
+
+          char const* name;
+          size_t nameLength;
+
+          if (! parseString(name, nameLength)) {
+            return false;
+          }
+
+          skipWhitespace();
+
+          if (_pos >= _end || *_pos != ':') {
+            return fail("expecting colon");
+          }
+
+          ++_pos;
+
+          if (checkDuplicates) {
+            _names.emplace_back(std::make_pair(name, nameLength));
+          }
+
+          bool shaped = (nameLength > 0);
+
+          if (shaped && level == 0 && *name == '_') {
+            std::string const attribute(name, nameLength);
+
+            if (attribute == "_key" && ! _hasKey) {
+              // a bad _key is reported only if the rest of the text is valid
+              _hasKey = true;
+              skipWhitespace();
+
+              if (_pos >= _end || *_pos != '"') {
+                _badKey = true;
+              }
+              else {
+                char const* data;
+                size_t length;
+
+                if (! parseString(data, length)) {
+                  return false;
+                }
+
+                if (length == 0) {
+                  _badKey = true;
+                }
+
+                _key.assign(data, length);
+                continue;
+              }
+            }
+
+            shaped = (attribute != "_key" &&
+                      attribute != "_rev" &&
+                      attribute != "_id" &&
+                      attribute != "_from" &&
+                      attribute != "_to");
+          }
+
+          if (! shaped) {
+            // empty or reserved attribute name, drop the tokens of the value
+            size_t const skip = _tokens.size();
+
+            if (! parseValue(level + 1, checkDuplicates)) {
+              return false;
+            }
+
+            _tokens.resize(skip);
+            continue;
+          }
+
+          addToken(TOKEN_STRING, nameLength);
+          _tokens.back()._value._string = name;
+
+          if (! parseValue(level + 1, checkDuplicates)) {
+            return false;
+          }
+
+          ++n;
+        }
+
+        if (checkDuplicates) {
+          if (_names.size() - names > 1) {
+            std::sort(_names.begin() + names, _names.end(), NameLess);
+
+            if (std::adjacent_find(_names.begin() + names, _names.end(), NameEqual) != _names.end()) {
+              return fail("duplicate attribute name");
+            }
+          }
+
+          _names.resize(names);
+        }
+
+        _tokens[token]._length = n;
+        return true;
+      }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                             shape
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pushes a composed list or object. except for the top-level value,
+/// its data are moved into the parser's blocks
+////////////////////////////////////////////////////////////////////////////////
+
+      bool pushComposed (TRI_shape_value_t& value,
+                         size_t level) {
+        if (level > 0) {
+          char* ptr = allocate((size_t) value._size);
+
+          if (ptr == nullptr) {
+            TRI_Free(_shaper->_memoryZone, value._value);
+            return fail(TRI_ERROR_OUT_OF_MEMORY, "out-of-memory");
+          }
+
+          memcpy(ptr, value._value, (size_t) value._size);
+          TRI_Free(_shaper->_memoryZone, value._value);
+          value._value = ptr;
+        }
+
+        _values.emplace_back(value);
+        return true;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pushes a null
+////////////////////////////////////////////////////////////////////////////////
+
+      bool pushNull () {
+        TRI_shape_value_t value;
+
+        value._aid = 0;
+        value._type = TRI_SHAPE_NULL;
+        value._sid = BasicShapes::TRI_SHAPE_SID_NULL;
+        value._fixedSized = true;
+        value._size = 0;
+        value._value = nullptr;
+
+        _values.emplace_back(value);
+        return true;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pushes a boolean
+////////////////////////////////////////////////////////////////////////////////
+
+      bool pushBoolean (bool b) {
+        TRI_shape_value_t value;
+
+        value._aid = 0;
+        value._type = TRI_SHAPE_BOOLEAN;
+        value._sid = BasicShapes::TRI_SHAPE_SID_BOOLEAN;
+        value._fixedSized = true;
+        value._size = sizeof(TRI_shape_boolean_t);
+        value._value = allocate(sizeof(TRI_shape_boolean_t));
 
-    if (dst->_value == nullptr) {
-      freeShapeValues(shaper->_memoryZone, values, e);
-      return false;
-    }
+        if (value._value == nullptr) {
+          return fail(TRI_ERROR_OUT_OF_MEMORY, "out-of-memory");
+        }
 
-    // copy sub-objects into data space
-    * (TRI_shape_length_list_t*) ptr = (TRI_shape_length_list_t) n;
-    ptr += sizeof(TRI_shape_length_list_t);
+        * (TRI_shape_boolean_t*) value._value = b ? 1 : 0;
 
-    TRI_shape_sid_t* sids = (TRI_shape_sid_t*) ptr;
-    ptr += n * sizeof(TRI_shape_sid_t);
+        _values.emplace_back(value);
+        return true;
+      }
 
-    offsets = (TRI_shape_size_t*) ptr;
-    ptr += (n + 1) * sizeof(TRI_shape_size_t);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pushes a number
+////////////////////////////////////////////////////////////////////////////////
 
-    for (p = values;  p < e;  ++p) {
-      *sids++ = p->_sid;
+      bool pushNumber (double d) {
+        TRI_shape_value_t value;
 
-      *offsets++ = offset;
-      offset += p->_size;
+        value._aid = 0;
+        value._type = TRI_SHAPE_NUMBER;
+        value._sid = BasicShapes::TRI_SHAPE_SID_NUMBER;
+        value._fixedSized = true;
+        value._size = sizeof(TRI_shape_number_t);
+        value._value = allocate(sizeof(TRI_shape_number_t));
 
-      memcpy(ptr, p->_value, (size_t) p->_size);
-      ptr += p->_size;
-    }
+        if (value._value == nullptr) {
+          return fail(TRI_ERROR_OUT_OF_MEMORY, "out-of-memory");
+        }
 
-    *offsets = offset;
-  }
+        * (TRI_shape_number_t*) value._value = d;
 
-  // free TRI_shape_value_t array
-  freeShapeValues(shaper->_memoryZone, values, e);
-  return true;
-}
+        _values.emplace_back(value);
+        return true;
+      }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief converts a json array into TRI_shape_value_t
+/// @brief pushes a string, the length does not include the trailing '\0'
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool FillShapeValueArray (TRI_shaper_t* shaper,
-                                 TRI_shape_value_t* dst,
-                                 TRI_json_t const* json,
-                                 size_t level,
-                                 bool create) {
-  TRI_shape_sid_t* sids;
-  TRI_shape_aid_t* aids;
-  TRI_shape_size_t* offsetsF;
-  TRI_shape_size_t* offsetsV;
-  TRI_shape_size_t offset;
-
-  char* ptr;
+      bool pushString (char const* data,
+                       size_t length) {
+        TRI_shape_value_t value;
+        char* ptr;
 
-  // sanity checks
-  TRI_ASSERT(json->_type == TRI_JSON_OBJECT);
-  TRI_ASSERT(TRI_LengthVector(&json->_value._objects) % 2 == 0);
+        value._aid = 0;
 
-  // number of attributes
-  size_t n = TRI_LengthVector(&json->_value._objects) / 2;
+        if (length + 1 <= TRI_SHAPE_SHORT_STRING_CUT) {
+          value._type = TRI_SHAPE_SHORT_STRING;
+          value._sid = BasicShapes::TRI_SHAPE_SID_SHORT_STRING;
+          value._fixedSized = true;
+          value._size = sizeof(TRI_shape_length_short_string_t) + TRI_SHAPE_SHORT_STRING_CUT;
+          value._value = (ptr = allocate((size_t) value._size));
 
-  // convert into TRI_shape_value_t array
-  TRI_shape_value_t* values = static_cast<TRI_shape_value_t*>(TRI_Allocate(shaper->_memoryZone, n * sizeof(TRI_shape_value_t), true));
+          if (ptr == nullptr) {
+            return fail(TRI_ERROR_OUT_OF_MEMORY, "out-of-memory");
+          }
 
-  if (values == nullptr) {
-    return false;
-  }
-  
-  
-  // helper function to free shape values
-  auto freeShapeValues = [] (TRI_memory_zone_t* zone, TRI_shape_value_t* values, TRI_shape_value_t* end) {
-    TRI_shape_value_t* p = values;
-    TRI_shape_value_t* e = end;
+          // must fill with 0's because the full length is used for comparisons
+          memset(ptr, 0, (size_t) value._size);
+          * (TRI_shape_length_short_string_t*) ptr = (TRI_shape_length_short_string_t) (length + 1);
+          memcpy(ptr + sizeof(TRI_shape_length_short_string_t), data, length);
+        }
+        else {
+          value._type = TRI_SHAPE_LONG_STRING;
+          value._sid = BasicShapes::TRI_SHAPE_SID_LONG_STRING;
+          value._fixedSized = false;
+          value._size = sizeof(TRI_shape_length_long_string_t) + length + 1;
+          value._value = (ptr = allocate((size_t) value._size));
+
+          if (ptr == nullptr) {
+            return fail(TRI_ERROR_OUT_OF_MEMORY, "out-of-memory");
+          }
+
+          * (TRI_shape_length_long_string_t*) ptr = (TRI_shape_length_long_string_t) (length + 1);
+          memcpy(ptr + sizeof(TRI_shape_length_long_string_t), data, length);
+          ptr[sizeof(TRI_shape_length_long_string_t) + length] = '\0';
+        }
 
-    for (;  p < e;  ++p) {
-      if (p->_value != nullptr) {
-        TRI_Free(zone, p->_value);
+        _values.emplace_back(value);
+        return true;
       }
-    }
 
-    TRI_Free(zone, values);
-  };
+////////////////////////////////////////////////////////////////////////////////
+/// @brief shapes the value starting at the given token and pushes it. the
+/// position is advanced behind the value
+////////////////////////////////////////////////////////////////////////////////
 
+      bool shapeValue (size_t& pos,
+                       size_t level) {
+        Token const& token = _tokens[pos++];
 
-  uint64_t total = 0;
-  size_t f = 0;
-  size_t v = 0;
+        switch (token._type) {
+          case TOKEN_NULL:
+            return pushNull();
 
-  TRI_shape_value_t* p = values;
+          case TOKEN_FALSE:
+            return pushBoolean(false);
 
-  for (size_t i = 0;  i < n;  ++i, ++p) {
-    TRI_json_t const* key = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, 2 * i));
-    TRI_ASSERT(key != nullptr);
-    TRI_ASSERT(key->_type == TRI_JSON_STRING);
+          case TOKEN_TRUE:
+            return pushBoolean(true);
 
-    char const* k = key->_value._string.data;
+          case TOKEN_NUMBER:
+            return pushNumber(token._value._number);
 
-    if (k == nullptr ||
-        key->_value._string.length == 1) {
-      // empty attribute name
-      p--;
-      continue;
-    }
+          case TOKEN_STRING:
+            return pushString(token._value._string, token._length);
 
-    if (*k == '_' && level == 0) {
-      // on top level, strip reserved attributes before shaping
-      if (strcmp(k, "_key") == 0 || 
-          strcmp(k, "_rev") == 0 ||
-          strcmp(k, "_id") == 0 ||
-          strcmp(k, "_from") == 0 ||
-          strcmp(k, "_to") == 0) {
-        // found a reserved attribute - discard it
-        --p;
-        continue;
-      }
-    }
+          case TOKEN_LIST: {
+            size_t const start = _values.size();
 
-    // first find an identifier for the name
-    p->_aid = shaper->findOrCreateAttributeByName(shaper, k);
+            for (size_t i = 0;  i < token._length;  ++i) {
+              if (! shapeValue(pos, level + 1)) {
+                return false;
+              }
+            }
 
-    // convert value
-    bool ok;
-    if (p->_aid == 0) {
-      ok = false;
-    }
-    else {
-      auto val = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, 2 * i + 1));
-      TRI_ASSERT(val != nullptr);
+            TRI_shape_value_t value;
+            value._aid = 0;
 
-      ok = FillShapeValueJson(shaper, p, val, level + 1, create);
-    }
+            bool ok = ComposeShapeValueList(_shaper, &value, _values.data() + start, _values.size() - start, _create);
+            _values.resize(start);
 
-    if (! ok) {
-      freeShapeValues(shaper->_memoryZone, values, p);
-      return false;
-    }
+            if (! ok) {
+              return fail(TRI_ERROR_ARANGO_SHAPER_FAILED, "cannot shape list");
+            }
 
-    total += p->_size;
+            return pushComposed(value, level);
+          }
 
-    // count fixed and variable sized values
-    if (p->_fixedSized) {
-      ++f;
-    }
-    else {
-      ++v;
-    }
-  }
+          case TOKEN_OBJECT: {
+            size_t const start = _values.size();
 
-  // add variable offset table size
-  total += (v + 1) * sizeof(TRI_shape_size_t);
+            for (size_t i = 0;  i < token._length;  ++i) {
+              Token const& name = _tokens[pos++];
+              TRI_ASSERT(name._type == TOKEN_STRING);
 
-  // now adjust n because we might have excluded empty attributes
-  n = f + v;
+              _name.assign(name._value._string, name._length);
 
-  // now sort the shape entries
-  if (n > 1) {
-    TRI_SortShapeValues(values, n);
-  }
+              TRI_shape_aid_t aid = _shaper->findOrCreateAttributeByName(_shaper, _name.c_str());
 
-#ifdef DEBUG_JSON_SHAPER
-  printf("shape values\n------------\ntotal: %u, fixed: %u, variable: %u\n",
-         (unsigned int) n,
-         (unsigned int) f,
-         (unsigned int) v);
-  PrintShapeValues(values, n);
-  printf("\n");
-#endif
+              if (aid == 0) {
+                return fail(TRI_ERROR_ARANGO_SHAPER_FAILED, "cannot create attribute");
+              }
 
-  // generate shape structure
-  size_t byteSize =
-    sizeof(TRI_array_shape_t)
-    + n * sizeof(TRI_shape_sid_t)
-    + n * sizeof(TRI_shape_aid_t)
-    + (f + 1) * sizeof(TRI_shape_size_t);
+              if (! shapeValue(pos, level + 1)) {
+                return false;
+              }
 
-  TRI_array_shape_t* a = reinterpret_cast<TRI_array_shape_t*>(ptr = static_cast<char*>(TRI_Allocate(shaper->_memoryZone, byteSize, true)));
+              _values.back()._aid = aid;
+            }
 
-  if (ptr == nullptr) {
-    freeShapeValues(shaper->_memoryZone, values, values + n);
-    return false;
-  }
+            TRI_shape_value_t value;
+            value._aid = 0;
 
-  a->base._type = TRI_SHAPE_ARRAY;
-  a->base._size = byteSize;
-  a->base._dataSize = (v == 0) ? total : TRI_SHAPE_SIZE_VARIABLE;
+            bool ok = ComposeShapeValueArray(_shaper, &value, _values.data() + start, _values.size() - start, _create);
+            _values.resize(start);
 
-  a->_fixedEntries = f;
-  a->_variableEntries = v;
+            if (! ok) {
+              return fail(TRI_ERROR_ARANGO_SHAPER_FAILED, "cannot shape object");
+            }
 
-  ptr += sizeof(TRI_array_shape_t);
+            return pushComposed(value, level);
+          }
+        }
 
-  // array of shape identifiers
-  sids = (TRI_shape_sid_t*) ptr;
-  ptr += n * sizeof(TRI_shape_sid_t);
+        return fail(TRI_ERROR_INTERNAL, "invalid token");
+      }
 
-  // array of attribute identifiers
-  aids = (TRI_shape_aid_t*) ptr;
-  ptr += n * sizeof(TRI_shape_aid_t);
+    private:
 
-  // array of offsets for fixed part (within the shape)
-  offset = (v + 1) * sizeof(TRI_shape_size_t);
-  offsetsF = (TRI_shape_size_t*) ptr;
+      static size_t const BlockSize = 16384;
 
-  // fill destination (except sid)
-  dst->_type = TRI_SHAPE_ARRAY;
+      TRI_shaper_t* _shaper;
 
-  dst->_fixedSized = true;
-  dst->_size = total;
-  dst->_value = (ptr = static_cast<char*>(TRI_Allocate(shaper->_memoryZone, dst->_size, true)));
+      char const* _pos;
 
-  if (ptr == nullptr) {
-    freeShapeValues(shaper->_memoryZone, values, values + n);
-    TRI_Free(shaper->_memoryZone, a);
-    return false;
-  }
+      char const* const _end;
 
-  // array of offsets for variable part (within the value)
-  offsetsV = (TRI_shape_size_t*) ptr;
-  ptr += (v + 1) * sizeof(TRI_shape_size_t);
+      bool const _create;
 
-  // and fill in attributes
-  TRI_shape_value_t* const e = values + n;
+      bool const _checkDuplicates;
 
-  for (p = values;  p < e;  ++p) {
-    *aids++ = p->_aid;
-    *sids++ = p->_sid;
+      int _res;
 
-    memcpy(ptr, p->_value, (size_t) p->_size);
-    ptr += p->_size;
+      char const* _message;
 
-    dst->_fixedSized &= p->_fixedSized;
+////////////////////////////////////////////////////////////////////////////////
+/// @brief blocks holding unescaped strings and the data of the values on the
+/// stack
+////////////////////////////////////////////////////////////////////////////////
 
-    if (p->_fixedSized) {
-      *offsetsF++ = offset;
-      offset += p->_size;
-      *offsetsF = offset;
-    }
-    else {
-      *offsetsV++ = offset;
-      offset += p->_size;
-      *offsetsV = offset;
-    }
-  }
+      std::vector<char*> _blocks;
 
-  // free TRI_shape_value_t array
-  freeShapeValues(shaper->_memoryZone, values, e);
+      char* _blockPos;
 
-  // lookup this shape
-  TRI_shape_t const* found = shaper->findShape(shaper, &a->base, create);
+      char* _blockEnd;
 
-  if (found == nullptr) {
-    TRI_Free(shaper->_memoryZone, dst->_value);
-    TRI_Free(shaper->_memoryZone, a);
-    return false;
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the tokens of the complete text
+////////////////////////////////////////////////////////////////////////////////
 
-  // and finally add the sid
-  dst->_sid = found->_sid;
-  return true;
-}
+      std::vector<Token> _tokens;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief converts a json object into TRI_shape_value_t
+/// @brief attribute names of all unfinished objects, for duplicate checks
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool FillShapeValueJson (TRI_shaper_t* shaper,
-                                TRI_shape_value_t* dst,
-                                TRI_json_t const* json,
-                                size_t level,
-                                bool create) {
-  switch (json->_type) {
-    case TRI_JSON_UNUSED:
-      return false;
+      std::vector<std::pair<char const*, size_t>> _names;
 
-    case TRI_JSON_NULL:
-      return FillShapeValueNull(shaper, dst, json);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stack of the values of all unfinished lists and objects
+////////////////////////////////////////////////////////////////////////////////
 
-    case TRI_JSON_BOOLEAN:
-      return FillShapeValueBoolean(shaper, dst, json);
+      std::vector<TRI_shape_value_t> _values;
 
-    case TRI_JSON_NUMBER:
-      return FillShapeValueNumber(shaper, dst, json);
+      std::string _name;
 
-    case TRI_JSON_STRING:
-    case TRI_JSON_STRING_REFERENCE:
-      return FillShapeValueString(shaper, dst, json);
+      std::string _key;
 
-    case TRI_JSON_OBJECT:
-      return FillShapeValueArray(shaper, dst, json, level, create);
+      bool _hasKey;
 
-    case TRI_JSON_ARRAY:
-      return FillShapeValueList(shaper, dst, json, level, create);
-  }
+      bool _badKey;
+  };
 
-  return false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2127,6 +3148,63 @@ TRI_shaped_json_t* TRI_ShapedJsonJson (TRI_shaper_t* shaper,
   return shaped;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts the text of a json object into a shaped json object
+///
+/// the text is shaped directly, without creating a TRI_json_t first. as in
+/// TRI_ShapedJsonJson, the reserved attributes on the top level are not
+/// shaped. the value of the _key attribute is returned in key, which is left
+/// empty if there is no _key attribute. duplicate attribute names are an
+/// error if checkDuplicates is set, otherwise they are shaped like in
+/// TRI_ShapedJsonJson.
+///
+/// the text is validated completely before the shaper is used. returns a
+/// nullptr if the text is not a json object with a non-empty string _key or
+/// cannot be shaped, the reason is returned in errorCode
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_shaped_json_t* TRI_ShapedJsonString (TRI_shaper_t* shaper,
+                                         char const* text,
+                                         size_t length,
+                                         bool create,
+                                         bool checkDuplicates,
+                                         std::string& key,
+                                         int* errorCode) {
+  ShapedJsonParser parser(shaper, text, length, create, checkDuplicates);
+  TRI_shape_value_t dst;
+
+  int res = parser.parse(&dst);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_TRACE("cannot shape json text: %s", parser.message());
+
+    if (errorCode != nullptr) {
+      *errorCode = res;
+    }
+    return nullptr;
+  }
+
+  // no need to prefill shaped with 0's as all attributes are set directly afterwards
+  TRI_shaped_json_t* shaped = static_cast<TRI_shaped_json_t*>(TRI_Allocate(shaper->_memoryZone, sizeof(TRI_shaped_json_t), false));
+
+  if (shaped == nullptr) {
+    TRI_Free(shaper->_memoryZone, dst._value);
+
+    if (errorCode != nullptr) {
+      *errorCode = TRI_ERROR_OUT_OF_MEMORY;
+    }
+    return nullptr;
+  }
+
+  shaped->_sid = dst._sid;
+  shaped->_data.length = (uint32_t) dst._size;
+  shaped->_data.data = dst._value;
+
+  key = parser.key();
+
+  return shaped;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief converts a shaped json object into a json object
 ////////////////////////////////////////////////////////////////////////////////
@@ -950,6 +950,18 @@ TRI_shaped_json_t* TRI_ShapedJsonJson (struct TRI_shaper_s*,
                                        TRI_json_t const*,
                                        bool);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts the text of a json object into a shaped json object
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_shaped_json_t* TRI_ShapedJsonString (struct TRI_shaper_s*,
+                                         char const*,
+                                         size_t,
+                                         bool,
+                                         bool,
+                                         std::string&,
+                                         int*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief converts a shaped json object into a json object
 ////////////////////////////////////////////////////////////////////////////////
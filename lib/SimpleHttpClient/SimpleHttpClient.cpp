@@ -748,6 +748,13 @@ namespace triagens {
 
         // last chunk length was 0, therefore we are finished
         if (_nextChunkedSize == 0) {
+          // body is compressed using deflate. inflate it
+          if (_result->isDeflated()) {
+            triagens::basics::StringBuffer inflated(TRI_UNKNOWN_MEM_ZONE);
+            _result->getBody().inflate(inflated, 16384);
+            _result->getBody().swap(&inflated);
+          }
+
           _result->setResultType(SimpleHttpResult::COMPLETE);
 
           _state = FINISHED;
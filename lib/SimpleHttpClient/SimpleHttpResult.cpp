@@ -173,6 +173,10 @@ namespace triagens {
               (value[5] == 't' || value[5] == 'T') &&
               (value[6] == 'e' || value[6] == 'E')) {
             _deflated = true;
+
+            // the body is inflated transparently, so the header must not be
+            // passed on with it
+            return;
           }
         }
       }
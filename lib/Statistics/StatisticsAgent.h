@@ -397,6 +397,28 @@ namespace triagens {
 
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sets the queue lane
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TRI_ENABLE_FIGURES
+
+#define RequestStatisticsAgentSetQueueLane(a, b)                                \
+  do {                                                                          \
+    if (TRI_ENABLE_STATISTICS) {                                                \
+      if ((a)->RequestStatisticsAgent::_statistics != nullptr) {                \
+        (a)->RequestStatisticsAgent::_statistics->_queueLane = (b);             \
+      }                                                                         \
+    }                                                                           \
+  }                                                                             \
+  while (0)
+
+#else
+
+#define RequestStatisticsAgentSetQueueLane(a, b) while (0)
+
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief sets the queue end
 ////////////////////////////////////////////////////////////////////////////////
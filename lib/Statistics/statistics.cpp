@@ -117,6 +117,10 @@ void TRI_ReleaseRequestStatistics (TRI_request_statistics_t* statistics) {
       if (statistics->_queueStart != 0.0 && statistics->_queueEnd != 0.0) {
         queueTime = statistics->_queueEnd - statistics->_queueStart;
         TRI_QueueTimeDistributionStatistics->addFigure(queueTime);
+
+        if (statistics->_queueLane < TRI_LaneQueueTimeDistributionStatistics.size()) {
+          TRI_LaneQueueTimeDistributionStatistics[statistics->_queueLane].addFigure(queueTime);
+        }
       }
 
       double ioTime = totalTime - requestTime - queueTime;
@@ -166,6 +170,23 @@ void TRI_FillRequestStatistics (StatisticsDistribution& totalTime,
   bytesReceived = *TRI_BytesReceivedDistributionStatistics;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief fills the current dispatcher queue lane statistics
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_FillQueueLaneStatistics (std::vector<int64_t>& depth,
+                                  std::vector<StatisticsDistribution>& queueTime) {
+  depth.clear();
+
+  for (size_t i = 0;  i < TRI_STATISTICS_QUEUE_LANES;  ++i) {
+    depth.push_back(TRI_LaneQueueDepthStatistics[i].load(std::memory_order_relaxed));
+  }
+
+  MUTEX_LOCKER(RequestListLock);
+
+  queueTime = TRI_LaneQueueTimeDistributionStatistics;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                           private connection statistics variables
 // -----------------------------------------------------------------------------
@@ -449,6 +470,18 @@ StatisticsDistribution* TRI_RequestTimeDistributionStatistics;
 
 StatisticsDistribution* TRI_QueueTimeDistributionStatistics;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief queue time distribution per dispatcher queue lane
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector<StatisticsDistribution> TRI_LaneQueueTimeDistributionStatistics;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of queued jobs per dispatcher queue lane
+////////////////////////////////////////////////////////////////////////////////
+
+std::atomic<int64_t> TRI_LaneQueueDepthStatistics[TRI_STATISTICS_QUEUE_LANES];
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief i/o distribution
 ////////////////////////////////////////////////////////////////////////////////
@@ -552,6 +585,13 @@ void TRI_InitialiseStatistics () {
   TRI_TotalTimeDistributionStatistics = new StatisticsDistribution(TRI_RequestTimeDistributionVectorStatistics);
   TRI_RequestTimeDistributionStatistics = new StatisticsDistribution(TRI_RequestTimeDistributionVectorStatistics);
   TRI_QueueTimeDistributionStatistics = new StatisticsDistribution(TRI_RequestTimeDistributionVectorStatistics);
+
+  TRI_LaneQueueTimeDistributionStatistics.clear();
+
+  for (size_t i = 0;  i < TRI_STATISTICS_QUEUE_LANES;  ++i) {
+    TRI_LaneQueueTimeDistributionStatistics.emplace_back(TRI_RequestTimeDistributionVectorStatistics);
+    TRI_LaneQueueDepthStatistics[i] = 0;
+  }
   TRI_IoTimeDistributionStatistics = new StatisticsDistribution(TRI_RequestTimeDistributionVectorStatistics);
   TRI_BytesSentDistributionStatistics = new StatisticsDistribution(TRI_BytesSentDistributionVectorStatistics);
   TRI_BytesReceivedDistributionStatistics = new StatisticsDistribution(TRI_BytesReceivedDistributionVectorStatistics);
@@ -34,6 +34,18 @@
 #include "Rest/HttpRequest.h"
 #include "Statistics/figures.h"
 
+#include <atomic>
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public constants
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of dispatcher queue lanes, one per job priority
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_STATISTICS_QUEUE_LANES (3)
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                      public types
 // -----------------------------------------------------------------------------
@@ -78,6 +90,8 @@ typedef struct TRI_request_statistics_s {
 
   triagens::rest::HttpRequest::HttpRequestType _requestType;
 
+  size_t _queueLane;
+
   bool _async;
   bool _tooLarge;
   bool _executeError;
@@ -137,6 +151,13 @@ void TRI_FillRequestStatistics (triagens::basics::StatisticsDistribution& totalT
                                 triagens::basics::StatisticsDistribution& bytesSent,
                                 triagens::basics::StatisticsDistribution& bytesReceived);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief fills the current dispatcher queue lane statistics
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_FillQueueLaneStatistics (std::vector<int64_t>& depth,
+                                  std::vector<triagens::basics::StatisticsDistribution>& queueTime);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                            public connection statistics functions
 // -----------------------------------------------------------------------------
@@ -243,6 +264,18 @@ extern triagens::basics::StatisticsDistribution* TRI_RequestTimeDistributionStat
 
 extern triagens::basics::StatisticsDistribution* TRI_QueueTimeDistributionStatistics;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief queue time distribution per dispatcher queue lane
+////////////////////////////////////////////////////////////////////////////////
+
+extern std::vector<triagens::basics::StatisticsDistribution> TRI_LaneQueueTimeDistributionStatistics;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of queued jobs per dispatcher queue lane
+////////////////////////////////////////////////////////////////////////////////
+
+extern std::atomic<int64_t> TRI_LaneQueueDepthStatistics[TRI_STATISTICS_QUEUE_LANES];
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief i/o distribution
 ////////////////////////////////////////////////////////////////////////////////
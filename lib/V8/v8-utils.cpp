@@ -3427,6 +3427,26 @@ static void JS_ClientStatistics (const v8::FunctionCallbackInfo<v8::Value>& args
   FillDistribution(isolate, result, TRI_V8_ASCII_STRING("bytesSent"),     bytesSent);
   FillDistribution(isolate, result, TRI_V8_ASCII_STRING("bytesReceived"), bytesReceived);
 
+  // dispatcher queue lanes, from highest to lowest priority
+  vector<int64_t> laneDepth;
+  vector<StatisticsDistribution> laneQueueTime;
+
+  TRI_FillQueueLaneStatistics(laneDepth, laneQueueTime);
+
+  v8::Handle<v8::Object> lanes = v8::Object::New(isolate);
+  char const* laneNames[] = { "high", "medium", "low" };
+
+  for (size_t i = 0;  i < laneDepth.size() && i < laneQueueTime.size() && i < sizeof(laneNames) / sizeof(laneNames[0]);  ++i) {
+    v8::Handle<v8::Object> lane = v8::Object::New(isolate);
+
+    lane->Set(TRI_V8_ASCII_STRING("depth"), v8::Number::New(isolate, (double) laneDepth[i]));
+    FillDistribution(isolate, lane, TRI_V8_ASCII_STRING("queueTime"), laneQueueTime[i]);
+
+    lanes->Set(TRI_V8_ASCII_STRING(laneNames[i]), lane);
+  }
+
+  result->Set(TRI_V8_ASCII_STRING("queueLanes"), lanes);
+
   TRI_V8_RETURN(result);
   TRI_V8_TRY_CATCH_END
 }